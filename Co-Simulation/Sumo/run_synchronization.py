@@ -33,6 +33,8 @@ try:
 except IndexError:
     pass
 
+import carla  # pylint: disable=wrong-import-position,import-error
+
 # ==================================================================================================
 # -- find traci module -----------------------------------------------------------------------------
 # ==================================================================================================
@@ -84,6 +86,10 @@ class SimulationSynchronization(object):
         self.sumo2carla_ids = {}  # Contains only actors controlled by sumo.
         self.carla2sumo_ids = {}  # Contains only actors controlled by carla.
 
+        # Wall-clock duration of the last sumo step, declared to carla as the compute
+        # budget of the concurrent window when initiating each frame.
+        self.sumo_step_seconds = 0.0
+
         BridgeHelper.blueprint_library = self.carla.world.get_blueprint_library()
         BridgeHelper.offset = self.sumo.get_net_offset()
 
@@ -95,12 +101,25 @@ class SimulationSynchronization(object):
 
     def tick(self):
         """
-        Tick to simulation synchronization
+        Tick to simulation synchronization.
+
+        The carla frame and the sumo step are computed concurrently: the frame is
+        initiated, sumo steps while it runs, and both simulators rendezvous before
+        exchanging states. Each simulator therefore sees the other's updates with one
+        step of delay.
         """
         # -----------------
-        # sumo-->carla sync
+        # concurrent stepping
         # -----------------
+        frame = self.carla.begin_tick(self.sumo_step_seconds)
+        sumo_step_start = time.time()
         self.sumo.tick()
+        self.sumo_step_seconds = time.time() - sumo_step_start
+        self.carla.end_tick(frame)
+
+        # -----------------
+        # sumo-->carla sync
+        # -----------------
 
         # Spawning new sumo actors in carla (i.e, not controlled by carla).
         sumo_spawned_actors = self.sumo.spawned_actors - set(self.carla2sumo_ids.values())
@@ -124,22 +143,25 @@ class SimulationSynchronization(object):
             if sumo_actor_id in self.sumo2carla_ids:
                 self.carla.destroy_actor(self.sumo2carla_ids.pop(sumo_actor_id))
 
-        # Updating sumo actors in carla.
+        # Updating sumo actors in carla, all vehicles in one client call.
+        vehicle_updates = []
         for sumo_actor_id in self.sumo2carla_ids:
             carla_actor_id = self.sumo2carla_ids[sumo_actor_id]
 
             sumo_actor = self.sumo.get_actor(sumo_actor_id)
-            carla_actor = self.carla.get_actor(carla_actor_id)
 
             carla_transform = BridgeHelper.get_carla_transform(sumo_actor.transform,
                                                                sumo_actor.extent)
             if self.sync_vehicle_lights:
+                carla_actor = self.carla.get_actor(carla_actor_id)
                 carla_lights = BridgeHelper.get_carla_lights_state(carla_actor.get_light_state(),
                                                                    sumo_actor.signals)
             else:
                 carla_lights = None
 
-            self.carla.synchronize_vehicle(carla_actor_id, carla_transform, carla_lights)
+            vehicle_updates.append((carla_actor_id, carla_transform, carla_lights))
+
+        self.carla.synchronize_vehicles(vehicle_updates)
 
         # Updates traffic lights in carla based on sumo information.
         if self.tls_manager == 'sumo':
@@ -153,8 +175,6 @@ class SimulationSynchronization(object):
         # -----------------
         # carla-->sumo sync
         # -----------------
-        self.carla.tick()
-
         # Spawning new carla actors (not controlled by sumo)
         carla_spawned_actors = self.carla.spawned_actors - set(self.sumo2carla_ids.values())
         for carla_actor_id in carla_spawned_actors:
@@ -173,22 +193,23 @@ class SimulationSynchronization(object):
             if carla_actor_id in self.carla2sumo_ids:
                 self.sumo.destroy_actor(self.carla2sumo_ids.pop(carla_actor_id))
 
-        # Updating carla actors in sumo.
+        # Updating carla actors in sumo; transforms and light states of all
+        # the carla-controlled vehicles arrive in one client call.
+        carla_states = self.carla.synchronize_vehicles([], query_ids=self.carla2sumo_ids.keys())
         for carla_actor_id in self.carla2sumo_ids:
             sumo_actor_id = self.carla2sumo_ids[carla_actor_id]
 
+            carla_state = carla_states.get(carla_actor_id)
+            if carla_state is None:
+                continue
             carla_actor = self.carla.get_actor(carla_actor_id)
             sumo_actor = self.sumo.get_actor(sumo_actor_id)
 
-            sumo_transform = BridgeHelper.get_sumo_transform(carla_actor.get_transform(),
+            sumo_transform = BridgeHelper.get_sumo_transform(carla_state.transform,
                                                              carla_actor.bounding_box.extent)
             if self.sync_vehicle_lights:
-                carla_lights = self.carla.get_actor_light_state(carla_actor_id)
-                if carla_lights is not None:
-                    sumo_lights = BridgeHelper.get_sumo_lights_state(sumo_actor.signals,
-                                                                     carla_lights)
-                else:
-                    sumo_lights = None
+                carla_lights = carla.VehicleLightState(carla_state.light_state)
+                sumo_lights = BridgeHelper.get_sumo_lights_state(sumo_actor.signals, carla_lights)
             else:
                 sumo_lights = None
 
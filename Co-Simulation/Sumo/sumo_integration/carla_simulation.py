@@ -146,6 +146,27 @@ class CarlaSimulation(object):
             vehicle.set_light_state(carla.VehicleLightState(lights))
         return True
 
+    def synchronize_vehicles(self, vehicle_updates, query_ids=None):
+        """
+        Updates a batch of vehicle states and reads back carla actor states in a single client
+        call, avoiding one rpc round trip per vehicle and per query.
+
+            :param vehicle_updates: list of (vehicle_id, transform, lights) tuples; lights may be
+                None to leave the light state untouched.
+            :param query_ids: ids of the carla actors whose state to read back.
+            :return: dictionary {actor_id: state} with the queried actors that are still alive;
+                each state carries transform, velocity and light_state.
+        """
+        updates = []
+        for vehicle_id, transform, lights in vehicle_updates:
+            if lights is None:
+                updates.append(carla.ActorTransformUpdate(vehicle_id, transform))
+            else:
+                updates.append(carla.ActorTransformUpdate(vehicle_id, transform, int(lights)))
+
+        states = self.client.exchange_actor_states(updates, list(query_ids or []))
+        return {state.actor_id: state for state in states}
+
     def synchronize_traffic_light(self, landmark_id, state):
         """
         Updates traffic light state.
@@ -167,8 +188,30 @@ class CarlaSimulation(object):
         Tick to carla simulation.
         """
         self.world.tick()
+        self._update_active_actors()
+
+    def begin_tick(self, compute_budget=0.0):
+        """
+        Initiates the next carla frame and returns immediately with its id, so the caller
+        can step another simulator concurrently. Complete the frame with end_tick.
 
-        # Update data structures for the current frame.
+            :param compute_budget: estimated time (in seconds) the caller will spend
+                computing before calling end_tick, used by the simulator to schedule the
+                concurrent window.
+        """
+        return self.world.begin_tick(compute_budget)
+
+    def end_tick(self, frame):
+        """
+        Blocks until the frame initiated by begin_tick completes.
+        """
+        self.world.end_tick(frame)
+        self._update_active_actors()
+
+    def _update_active_actors(self):
+        """
+        Update data structures for the current frame.
+        """
         current_actors = set(
             [vehicle.id for vehicle in self.world.get_actors().filter('vehicle.*')])
         self.spawned_actors = current_actors.difference(self._active_actors)
@@ -36,6 +36,17 @@ namespace detail {
       _list = new_list;
     }
 
+    /// Append a whole range paying for a single copy of the list, instead of
+    /// one copy per pushed element.
+    template <typename ContainerT>
+    void PushMany(const ContainerT &values) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto new_list = std::make_shared<ListT>(*Load());
+      new_list->reserve(new_list->size() + values.size());
+      new_list->insert(new_list->end(), values.begin(), values.end());
+      _list = new_list;
+    }
+
     void DeleteByIndex(size_t index) {
       std::lock_guard<std::mutex> lock(_mutex);
       auto new_list = std::make_shared<ListT>(*Load());
@@ -2,8 +2,54 @@
 
 #include "carla/BufferPool.h"
 
+#include <mutex>
+#include <unordered_set>
+
 namespace carla {
 
+  std::atomic_size_t BufferPool::_total_retained_count{0u};
+
+  std::atomic_size_t BufferPool::_total_retained_bytes{0u};
+
+  namespace {
+
+    /// Live pools of the process; constructed on first use so pools created
+    /// during static initialization are safe to register.
+    struct PoolRegistry {
+      std::mutex mutex;
+      std::unordered_set<BufferPool *> pools;
+    };
+
+    static PoolRegistry &GetPoolRegistry() {
+      static PoolRegistry registry;
+      return registry;
+    }
+
+  } // namespace
+
+  void BufferPool::RegisterPool(BufferPool &pool) {
+    auto &registry = GetPoolRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.pools.insert(&pool);
+  }
+
+  void BufferPool::DeregisterPool(BufferPool &pool) {
+    auto &registry = GetPoolRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.pools.erase(&pool);
+  }
+
+  std::vector<BufferPool::Stats> BufferPool::GetAllStats() {
+    auto &registry = GetPoolRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<Stats> result;
+    result.reserve(registry.pools.size());
+    for (const auto *pool : registry.pools) {
+      result.emplace_back(pool->GetStats());
+    }
+    return result;
+  }
+
   void Buffer::ReuseThisBuffer() {
     auto pool = _parent_pool.lock();
     if (pool != nullptr) {
@@ -13,10 +13,17 @@
 #include <boost/asio/buffer.hpp>
 
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <memory>
+#include <new>
 #include <type_traits>
 
+#ifdef _WIN32
+#include <malloc.h>
+#endif // _WIN32
+
 #ifdef LIBCARLA_INCLUDED_FROM_UE4
 #include "Containers/Array.h"
 #endif // LIBCARLA_INCLUDED_FROM_UE4
@@ -27,13 +34,22 @@ namespace carla {
 
   /// A piece of raw data.
   ///
-  /// Note that if more capacity is needed, a new memory block is allocated and
-  /// the old one is deleted. This means that by default the buffer can only
-  /// grow. To release the memory use `clear` or `pop`.
+  /// Payloads up to Buffer::inline_capacity bytes live in storage embedded in
+  /// the buffer itself, so the tiny control and event messages never touch
+  /// the allocator. Bigger payloads are heap-allocated; when more capacity is
+  /// needed the capacity at least doubles, a new memory block is allocated
+  /// and the old one is deleted. This means that by default the buffer can
+  /// only grow. To release the memory use `clear` or `pop`.
   ///
   /// This is a move-only type, meant to be cheap to pass by value. If the
-  /// buffer is retrieved from a BufferPool, the memory is automatically pushed
-  /// back to the pool on destruction.
+  /// buffer is retrieved from a BufferPool, the heap memory is automatically
+  /// pushed back to the pool on destruction.
+  ///
+  /// Heap memory is always aligned to Buffer::alignment bytes, so consumers
+  /// reading a payload that starts at a multiple of the alignment (see
+  /// sensor::RawData) can use aligned SIMD loads on it; the inline storage is
+  /// only aligned to alignof(std::max_align_t), which is irrelevant for
+  /// payloads this small.
   ///
   /// @warning Creating a buffer bigger than max_size() is undefined.
   class Buffer {
@@ -53,6 +69,28 @@ namespace carla {
 
     using const_iterator = const value_type *;
 
+    /// Every heap memory block held by a Buffer starts at an address that is
+    /// a multiple of this value, one cache line on current x86-64.
+    static constexpr size_t alignment = 64u;
+
+    /// Payloads of at most this many bytes are stored inside the buffer
+    /// object itself, without heap allocation.
+    static constexpr size_type inline_capacity = 64u;
+
+    /// Deleter matching the aligned allocation used by this buffer.
+    struct aligned_deleter {
+      void operator()(value_type *ptr) const noexcept {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif // _WIN32
+      }
+    };
+
+    /// Owning pointer to an aligned memory block, as handed out by pop().
+    using data_pointer = std::unique_ptr<value_type[], aligned_deleter>;
+
     /// @}
     // =========================================================================
     /// @name Construction and destruction
@@ -64,11 +102,10 @@ namespace carla {
     /// Create an empty buffer.
     Buffer() = default;
 
-    /// Create a buffer with @a size bytes allocated.
-    explicit Buffer(size_type size)
-      : _size(size),
-        _capacity(size),
-        _data(std::make_unique<value_type[]>(size)) {}
+    /// Create a buffer with @a size bytes available.
+    explicit Buffer(size_type size) {
+      reset(size);
+    }
 
     /// @copydoc Buffer(size_type)
     explicit Buffer(uint64_t size)
@@ -104,10 +141,18 @@ namespace carla {
       : _parent_pool(std::move(rhs._parent_pool)),
         _size(rhs._size),
         _capacity(rhs._capacity),
-        _data(rhs.pop()) {}
+        _data(std::move(rhs._data)) {
+      if ((_data == nullptr) && (_size > 0u)) {
+        std::memcpy(_inline, rhs._inline, _size);
+      }
+      rhs._size = 0u;
+      rhs._capacity = inline_capacity;
+    }
 
     ~Buffer() {
-      if (_capacity > 0u) {
+      // Only heap-backed buffers are worth returning to the pool, every
+      // fresh buffer comes with the inline storage anyway.
+      if (_data != nullptr) {
         ReuseThisBuffer();
       }
     }
@@ -126,7 +171,12 @@ namespace carla {
       _parent_pool = std::move(rhs._parent_pool);
       _size = rhs._size;
       _capacity = rhs._capacity;
-      _data = rhs.pop();
+      _data = std::move(rhs._data);
+      if ((_data == nullptr) && (_size > 0u)) {
+        std::memcpy(_inline, rhs._inline, _size);
+      }
+      rhs._size = 0u;
+      rhs._capacity = inline_capacity;
       return *this;
     }
 
@@ -140,24 +190,23 @@ namespace carla {
 
     /// Access the byte at position @a i.
     const value_type &operator[](size_t i) const {
-      return _data[i];
+      return data()[i];
     }
 
     /// Access the byte at position @a i.
     value_type &operator[](size_t i) {
-      return _data[i];
+      return data()[i];
     }
 
-    /// Direct access to the allocated memory or nullptr if no memory is
-    /// allocated.
+    /// Direct access to the storage backing this buffer, either the heap
+    /// block or the inline storage.
     const value_type *data() const noexcept {
-      return _data.get();
+      return _data != nullptr ? _data.get() : _inline;
     }
 
-    /// Direct access to the allocated memory or nullptr if no memory is
-    /// allocated.
+    /// @copydoc data()
     value_type *data() noexcept {
-      return _data.get();
+      return _data != nullptr ? _data.get() : _inline;
     }
 
     /// Make a boost::asio::buffer from this buffer.
@@ -212,7 +261,7 @@ namespace carla {
   public:
 
     const_iterator cbegin() const noexcept {
-      return _data.get();
+      return data();
     }
 
     const_iterator begin() const noexcept {
@@ -220,7 +269,7 @@ namespace carla {
     }
 
     iterator begin() noexcept {
-      return _data.get();
+      return data();
     }
 
     const_iterator cend() const noexcept {
@@ -244,13 +293,14 @@ namespace carla {
   public:
 
     /// Reset the size of this buffer. If the capacity is not enough, the
-    /// current memory is discarded and a new block of size @a size is
-    /// allocated.
+    /// current memory is discarded and a new block of at least @a size bytes
+    /// (at least doubling the capacity) is allocated.
     void reset(size_type size) {
       if (_capacity < size) {
-        log_debug("allocating buffer of", size, "bytes");
-        _data = std::make_unique<value_type[]>(size);
-        _capacity = size;
+        const auto new_capacity = GrowCapacity(size);
+        log_debug("allocating buffer of", new_capacity, "bytes");
+        _data = Allocate(new_capacity);
+        _capacity = new_capacity;
       }
       _size = size;
     }
@@ -263,30 +313,41 @@ namespace carla {
       reset(static_cast<size_type>(size));
     }
 
-    /// Resize the buffer, a new block of size @a size is
-    /// allocated if the capacity is not enough and the data is copied.
+    /// Resize the buffer, a new block is allocated if the capacity is not
+    /// enough and the data is copied.
     void resize(uint64_t size) {
       if(_capacity < size) {
-        std::unique_ptr<value_type[]> data = std::move(_data);
-        uint64_t old_size = size;
+        data_pointer data = std::move(_data);
+        const size_type old_size = _size;
+        const value_type *old_data = (data != nullptr) ? data.get() : _inline;
         reset(size);
-        copy_from(data.get(), static_cast<size_type>(old_size));
+        copy_from(old_data, old_size);
       }
       _size = static_cast<size_type>(size);
     }
 
-    /// Release the contents of this buffer and set its size and capacity to
-    /// zero.
-    std::unique_ptr<value_type[]> pop() noexcept {
+    /// Give away the memory held by this buffer, leaving it empty. If the
+    /// contents live in the inline storage they are copied to a fresh heap
+    /// block first.
+    data_pointer pop() {
+      data_pointer out;
+      if (_data != nullptr) {
+        out = std::move(_data);
+      } else if (_size > 0u) {
+        out = Allocate(_size);
+        std::memcpy(out.get(), _inline, _size);
+      }
       _size = 0u;
-      _capacity = 0u;
-      return std::move(_data);
+      _capacity = inline_capacity;
+      return out;
     }
 
-    /// Clear the contents of this buffer and set its size and capacity to zero.
-    /// Deletes allocated memory.
+    /// Clear the contents of this buffer and delete any heap memory held,
+    /// going back to the inline storage.
     void clear() noexcept {
-      pop();
+      _data = nullptr;
+      _size = 0u;
+      _capacity = inline_capacity;
     }
 
     /// @}
@@ -355,6 +416,32 @@ namespace carla {
 
   private:
 
+    /// Capacity to allocate to fit @a size bytes, at least doubling the
+    /// current capacity so repeatedly growing buffers do a logarithmic
+    /// number of allocations.
+    size_type GrowCapacity(size_type size) const noexcept {
+      const size_type doubled =
+          (_capacity > max_size() / 2u) ? max_size() : (2u * _capacity);
+      return size > doubled ? size : doubled;
+    }
+
+    /// Allocate @a size bytes aligned to Buffer::alignment.
+    static data_pointer Allocate(size_type size) {
+#ifdef _WIN32
+      auto *ptr = static_cast<value_type *>(_aligned_malloc(size, alignment));
+      if ((ptr == nullptr) && (size > 0u)) {
+        throw_exception(std::bad_alloc());
+      }
+#else
+      void *memory = nullptr;
+      if (posix_memalign(&memory, alignment, size) != 0) {
+        throw_exception(std::bad_alloc());
+      }
+      auto *ptr = static_cast<value_type *>(memory);
+#endif // _WIN32
+      return data_pointer(ptr);
+    }
+
     void ReuseThisBuffer();
 
     friend class BufferPool;
@@ -363,9 +450,13 @@ namespace carla {
 
     size_type _size = 0u;
 
-    size_type _capacity = 0u;
+    size_type _capacity = inline_capacity;
+
+    data_pointer _data = nullptr;
 
-    std::unique_ptr<value_type[]> _data = nullptr;
+    /// Storage for payloads of up to inline_capacity bytes; in use whenever
+    /// @a _data is null.
+    alignas(alignof(std::max_align_t)) value_type _inline[inline_capacity];
   };
 
 } // namespace carla
@@ -17,44 +17,238 @@
 #  pragma clang diagnostic pop
 #endif
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace carla {
 
   /// A pool of Buffer. Buffers popped from this pool automatically return to
   /// the pool on destruction so the allocated memory can be reused.
   ///
-  /// @warning Buffers adjust their size only by growing, they never shrink
-  /// unless explicitly cleared. The allocated memory is only deleted when this
-  /// pool is destroyed.
+  /// Buffers are kept in power-of-two size-class buckets so streams carrying
+  /// payloads of mixed sizes get the smallest fitting buffer back instead of
+  /// growing every pooled buffer to the largest payload ever seen. The
+  /// allocated memory is only deleted when the pool is trimmed or destroyed.
   class BufferPool : public std::enable_shared_from_this<BufferPool> {
   public:
 
-    BufferPool() = default;
+    /// Counters of one pool, a consistent-enough snapshot taken without
+    /// stopping the pool's users.
+    struct Stats {
+      /// Name given at construction, identifies the pool's owner.
+      std::string name;
+      /// Pops served from the pool.
+      uint64_t hits = 0u;
+      /// Pops that had to hand out a fresh, unpooled Buffer.
+      uint64_t misses = 0u;
+      /// Pooled buffers whose memory was released by Trim or destruction.
+      uint64_t discards = 0u;
+      /// Buffers currently retained.
+      size_t retained_count = 0u;
+      /// Bytes currently retained.
+      size_t retained_bytes = 0u;
+      /// Most bytes ever retained at once.
+      size_t peak_retained_bytes = 0u;
+    };
 
-    explicit BufferPool(size_t estimated_size) : _queue(estimated_size) {}
+    /// @a name identifies this pool in GetAllStats, e.g. the stream it
+    /// belongs to.
+    explicit BufferPool(std::string name = "unnamed")
+      : _name(std::move(name)) {
+      RegisterPool(*this);
+    }
+
+    ~BufferPool() {
+      // Stop showing up in the registry before tearing down the queues.
+      DeregisterPool(*this);
+      // Keep the process-wide totals in sync, the queues free the remaining
+      // buffers on destruction.
+      Buffer item;
+      for (auto &bucket : _buckets) {
+        while (bucket.try_dequeue(item)) {
+          OnDequeued(item);
+          ++_discards;
+          item.clear();
+        }
+      }
+    }
+
+    /// Pop a Buffer with capacity of at least @a size_hint bytes if one is
+    /// pooled, otherwise returns a fresh Buffer.
+    Buffer Pop(Buffer::size_type size_hint) {
+      Buffer item;
+      const auto first = GetBucketIndex(size_hint == 0u ? 1u : size_hint, true);
+      // Also look one size class up before giving up, a slightly bigger
+      // buffer beats a fresh allocation.
+      bool found = false;
+      for (auto i = first; (i < first + 2u) && (i < number_of_buckets); ++i) {
+        if (_buckets[i].try_dequeue(item)) {
+          OnDequeued(item);
+          found = true;
+          break;
+        }
+      }
+      if (found) {
+        ++_hits;
+      } else {
+        ++_misses;
+      }
+      SetParentPool(item);
+      return item;
+    }
 
-    /// Pop a Buffer from the queue, creates a new one if the queue is empty.
+    /// Pop a Buffer from the bucket that most recently received one, the
+    /// best guess for streams whose messages all have the same size.
     Buffer Pop() {
       Buffer item;
-      _queue.try_dequeue(item); // we don't care if it fails.
+      if (_buckets[_last_pushed_bucket].try_dequeue(item)) { // we don't care if it fails.
+        OnDequeued(item);
+        ++_hits;
+      } else {
+        ++_misses;
+      }
+      SetParentPool(item);
+      return item;
+    }
+
+    /// Total number of bytes currently retained by the pooled buffers.
+    size_t GetRetainedBytes() const {
+      return _retained_bytes;
+    }
+
+    /// Snapshot of this pool's counters.
+    Stats GetStats() const {
+      Stats stats;
+      stats.name = _name;
+      stats.hits = _hits;
+      stats.misses = _misses;
+      stats.discards = _discards;
+      stats.retained_count = _retained_count;
+      stats.retained_bytes = _retained_bytes;
+      stats.peak_retained_bytes = _peak_retained_bytes;
+      return stats;
+    }
+
+    /// Snapshot of the counters of every live pool of the process, the
+    /// go-to answer for "which pool grew".
+    static std::vector<Stats> GetAllStats();
+
+    /// Number of buffers currently retained by every pool of the process.
+    static size_t GetTotalRetainedCount() {
+      return _total_retained_count;
+    }
+
+    /// Bytes currently retained by every pool of the process.
+    static size_t GetTotalRetainedBytes() {
+      return _total_retained_bytes;
+    }
+
+    /// Delete every pooled buffer with capacity greater than @a max_capacity,
+    /// e.g. after a burst of unusually big payloads inflated the pool.
+    void Trim(Buffer::size_type max_capacity) {
+      Buffer item;
+      for (auto i = GetBucketIndex(max_capacity == 0u ? 1u : max_capacity, false);
+          i < number_of_buckets;
+          ++i) {
+        std::vector<Buffer> keep;
+        while (_buckets[i].try_dequeue(item)) {
+          OnDequeued(item);
+          if (item.capacity() <= max_capacity) {
+            // The bucket holding max_capacity itself may mix smaller buffers.
+            keep.emplace_back(std::move(item));
+          } else {
+            ++_discards;
+            item.clear(); // release the memory instead of returning it to the pool.
+          }
+        }
+        for (auto &kept : keep) {
+          Push(std::move(kept));
+        }
+      }
+    }
+
+  private:
+
+    friend class Buffer;
+
+    static constexpr size_t number_of_buckets = 8u * sizeof(Buffer::size_type);
+
+    /// Bucket @a i holds buffers with capacity in [2^i, 2^(i+1)). If
+    /// @a round_up, return instead the first bucket whose buffers all hold at
+    /// least @a capacity bytes.
+    static size_t GetBucketIndex(Buffer::size_type capacity, bool round_up) {
+      size_t index = 0u;
+      while (((Buffer::size_type(1u) << (index + 1u)) <= capacity) &&
+          (index + 1u < number_of_buckets)) {
+        ++index;
+      }
+      if (round_up && ((Buffer::size_type(1u) << index) < capacity)) {
+        ++index;
+      }
+      return index;
+    }
+
+    void SetParentPool(Buffer &item) {
 #if __cplusplus >= 201703L // C++17
       item._parent_pool = weak_from_this();
 #else
       item._parent_pool = shared_from_this();
 #endif
-      return item;
     }
 
-  private:
-
-    friend class Buffer;
+    void OnDequeued(const Buffer &item) {
+      _retained_bytes -= item.capacity();
+      --_retained_count;
+      _total_retained_bytes -= item.capacity();
+      --_total_retained_count;
+    }
 
     void Push(Buffer &&buffer) {
-      _queue.enqueue(std::move(buffer));
+      const auto index = GetBucketIndex(buffer.capacity(), false);
+      const auto bytes = _retained_bytes += buffer.capacity();
+      ++_retained_count;
+      _total_retained_bytes += buffer.capacity();
+      ++_total_retained_count;
+      // Racing pushes may each settle for a slightly stale peak, close
+      // enough for a high-water mark.
+      auto peak = _peak_retained_bytes.load(std::memory_order_relaxed);
+      while ((bytes > peak) &&
+          !_peak_retained_bytes.compare_exchange_weak(peak, bytes)) {
+      }
+      _last_pushed_bucket = index;
+      _buckets[index].enqueue(std::move(buffer));
     }
 
-    moodycamel::ConcurrentQueue<Buffer> _queue;
+    /// Registry of the live pools of the process, defined in Buffer.cpp.
+    static void RegisterPool(BufferPool &pool);
+
+    static void DeregisterPool(BufferPool &pool);
+
+    const std::string _name;
+
+    std::array<moodycamel::ConcurrentQueue<Buffer>, number_of_buckets> _buckets;
+
+    std::atomic_size_t _retained_bytes{0u};
+
+    std::atomic_size_t _retained_count{0u};
+
+    std::atomic_size_t _peak_retained_bytes{0u};
+
+    std::atomic<uint64_t> _hits{0u};
+
+    std::atomic<uint64_t> _misses{0u};
+
+    std::atomic<uint64_t> _discards{0u};
+
+    std::atomic_size_t _last_pushed_bucket{0u};
+
+    /// Process-wide totals, defined in Buffer.cpp.
+    static std::atomic_size_t _total_retained_count;
+
+    static std::atomic_size_t _total_retained_bytes;
   };
 
 } // namespace carla
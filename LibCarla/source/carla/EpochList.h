@@ -0,0 +1,240 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/AtomicSharedPtr.h"
+#include "carla/Debug.h"
+#include "carla/NonCopyable.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace carla {
+
+  /// An RCU-style linked list for read-mostly data, an alternative to
+  /// AtomicList when the list grows beyond a handful of entries.
+  ///
+  /// AtomicList copies the whole vector on every mutation; here Push appends
+  /// one node in O(1) and removal unlinks in place. Readers iterate a View
+  /// without taking the writers' mutex: the View pins the current
+  /// reclamation generation, and removed nodes are only deleted once every
+  /// generation that could still reach them has been released, so a reader
+  /// caught mid-iteration keeps dereferencing valid memory.
+  ///
+  /// @warning A View holds back reclamation of everything removed while it
+  /// is alive, keep it scoped to the iteration.
+  template <typename T>
+  class EpochList : private NonCopyable {
+
+    struct Node {
+      explicit Node(T v) : value(std::move(v)) {}
+      const T value;
+      std::atomic_bool alive{true};
+      std::atomic<Node *> next{nullptr};
+    };
+
+    /// Deleting a generation deletes the nodes retired with it; the "newer"
+    /// link makes an old reader transitively keep alive every batch retired
+    /// after it pinned, exactly the nodes it might still reach.
+    struct Generation {
+      std::vector<std::unique_ptr<Node>> retired;
+      std::shared_ptr<Generation> newer;
+    };
+
+  public:
+
+    /// A read-side snapshot, iterable with a range-based for. Nodes removed
+    /// before the View was taken are skipped; nodes removed while it is
+    /// alive may or may not be visited, as with any RCU read section.
+    class View {
+    public:
+
+      class const_iterator {
+      public:
+
+        const T &operator*() const {
+          return _node->value;
+        }
+
+        const T *operator->() const {
+          return &_node->value;
+        }
+
+        const_iterator &operator++() {
+          _node = SkipDead(_node->next.load(std::memory_order_acquire));
+          return *this;
+        }
+
+        bool operator!=(const const_iterator &rhs) const {
+          return _node != rhs._node;
+        }
+
+        bool operator==(const const_iterator &rhs) const {
+          return _node == rhs._node;
+        }
+
+      private:
+
+        friend class View;
+
+        explicit const_iterator(const Node *node) : _node(node) {}
+
+        const Node *_node;
+      };
+
+      const_iterator begin() const {
+        return const_iterator(SkipDead(_head));
+      }
+
+      const_iterator end() const {
+        return const_iterator(nullptr);
+      }
+
+      bool empty() const {
+        return begin() == end();
+      }
+
+    private:
+
+      friend class EpochList;
+
+      View(std::shared_ptr<const Generation> generation, const Node *head)
+        : _generation(std::move(generation)),
+          _head(head) {}
+
+      static const Node *SkipDead(const Node *node) {
+        while ((node != nullptr) && !node->alive.load(std::memory_order_acquire)) {
+          node = node->next.load(std::memory_order_acquire);
+        }
+        return node;
+      }
+
+      std::shared_ptr<const Generation> _generation;
+
+      const Node *_head;
+    };
+
+    EpochList() : _generation(std::make_shared<Generation>()) {}
+
+    ~EpochList() {
+      Clear();
+    }
+
+    /// Take a read-side snapshot of the list.
+    View Load() const {
+      // Pin the generation first; nodes unlinked afterwards are retired to
+      // it (or to a newer one) and outlive this View.
+      auto generation = _generation.load();
+      return View(std::move(generation), _head.load(std::memory_order_acquire));
+    }
+
+    /// Append @a value at the end of the list.
+    template <typename ValueT>
+    void Push(ValueT &&value) {
+      auto node = std::make_unique<Node>(T{std::forward<ValueT>(value)});
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_tail == nullptr) {
+        _head.store(node.get(), std::memory_order_release);
+      } else {
+        _tail->next.store(node.get(), std::memory_order_release);
+      }
+      _tail = node.release();
+      _size.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    /// Unlink every node comparing equal to @a value; the nodes are deleted
+    /// once the readers that could reach them are gone.
+    template <typename ValueT>
+    void DeleteByValue(const ValueT &value) {
+      std::vector<std::unique_ptr<Node>> retired;
+      std::lock_guard<std::mutex> lock(_mutex);
+      Node *prev = nullptr;
+      auto *node = _head.load(std::memory_order_relaxed);
+      while (node != nullptr) {
+        auto *next = node->next.load(std::memory_order_relaxed);
+        if (node->value == value) {
+          Unlink(prev, node, next);
+          retired.emplace_back(node);
+        } else {
+          prev = node;
+        }
+        node = next;
+      }
+      if (!retired.empty()) {
+        Retire(std::move(retired));
+      }
+    }
+
+    /// Unlink every node.
+    void Clear() {
+      std::vector<std::unique_ptr<Node>> retired;
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto *node = _head.load(std::memory_order_relaxed);
+      _head.store(nullptr, std::memory_order_release);
+      _tail = nullptr;
+      while (node != nullptr) {
+        node->alive.store(false, std::memory_order_release);
+        retired.emplace_back(node);
+        node = node->next.load(std::memory_order_relaxed);
+      }
+      _size.store(0u, std::memory_order_relaxed);
+      if (!retired.empty()) {
+        Retire(std::move(retired));
+      }
+    }
+
+    size_t Size() const {
+      return _size.load(std::memory_order_relaxed);
+    }
+
+    bool IsEmpty() const {
+      return Size() == 0u;
+    }
+
+  private:
+
+    /// @warning Must be called with the mutex held.
+    void Unlink(Node *prev, Node *node, Node *next) {
+      if (prev == nullptr) {
+        _head.store(next, std::memory_order_release);
+      } else {
+        prev->next.store(next, std::memory_order_release);
+      }
+      if (node == _tail) {
+        _tail = prev;
+      }
+      node->alive.store(false, std::memory_order_release);
+      _size.fetch_sub(1u, std::memory_order_relaxed);
+    }
+
+    /// @warning Must be called with the mutex held.
+    void Retire(std::vector<std::unique_ptr<Node>> nodes) {
+      auto new_generation = std::make_shared<Generation>();
+      auto old_generation = _generation.load();
+      DEBUG_ASSERT(old_generation != nullptr);
+      // Readers pinned to the old generation (or to an older one, through
+      // the "newer" chain) keep these nodes alive until they are done.
+      old_generation->retired = std::move(nodes);
+      old_generation->newer = new_generation;
+      _generation.store(std::move(new_generation));
+    }
+
+    AtomicSharedPtr<Generation> _generation;
+
+    std::atomic<Node *> _head{nullptr};
+
+    /// @warning Only accessed with the mutex held.
+    Node *_tail = nullptr;
+
+    std::atomic_size_t _size{0u};
+
+    std::mutex _mutex;
+  };
+
+} // namespace carla
@@ -11,6 +11,17 @@
 
 #include <boost/filesystem/operations.hpp>
 
+#ifdef _WIN32
+#  include <fstream>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include <utility>
+
 namespace carla {
 
   namespace fs = boost::filesystem;
@@ -51,4 +62,94 @@ namespace carla {
     return results;
   }
 
+  MappedFile::MappedFile(MappedFile &&rhs) noexcept
+    : _data(rhs._data),
+      _size(rhs._size),
+      _mapped(rhs._mapped),
+      _open(rhs._open),
+      _fallback(std::move(rhs._fallback)) {
+    rhs._data = nullptr;
+    rhs._size = 0u;
+    rhs._mapped = false;
+    rhs._open = false;
+  }
+
+  MappedFile &MappedFile::operator=(MappedFile &&rhs) noexcept {
+    if (this != &rhs) {
+      Close();
+      _data = rhs._data;
+      _size = rhs._size;
+      _mapped = rhs._mapped;
+      _open = rhs._open;
+      _fallback = std::move(rhs._fallback);
+      rhs._data = nullptr;
+      rhs._size = 0u;
+      rhs._mapped = false;
+      rhs._open = false;
+    }
+    return *this;
+  }
+
+  MappedFile::~MappedFile() {
+    Close();
+  }
+
+  bool MappedFile::Open(const std::string &filename) {
+    Close();
+#ifndef _WIN32
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat file_info;
+    if (::fstat(fd, &file_info) != 0) {
+      ::close(fd);
+      return false;
+    }
+    const auto size = static_cast<size_t>(file_info.st_size);
+    if (size > 0u) {
+      void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {
+        ::close(fd);
+        return false;
+      }
+      _data = static_cast<const uint8_t *>(mapping);
+      _size = size;
+      _mapped = true;
+    }
+    // The mapping keeps the file referenced on its own.
+    ::close(fd);
+#else
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+      return false;
+    }
+    _fallback.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(_fallback.data()),
+        static_cast<std::streamsize>(_fallback.size()));
+    if (!file) {
+      _fallback.clear();
+      return false;
+    }
+    _data = _fallback.data();
+    _size = _fallback.size();
+#endif
+    _open = true;
+    return true;
+  }
+
+  void MappedFile::Close() {
+#ifndef _WIN32
+    if (_mapped) {
+      ::munmap(const_cast<uint8_t *>(_data), _size);
+    }
+#endif
+    _data = nullptr;
+    _size = 0u;
+    _mapped = false;
+    _open = false;
+    _fallback.clear();
+  }
+
 } // namespace carla
@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include "carla/NonCopyable.h"
+
+#include <cstdint>
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -37,4 +41,91 @@ namespace carla {
         const std::string &wildcard_pattern);
   };
 
+  /// Read-only view of a whole file. Memory-mapped where the platform
+  /// supports it, so the contents are paged in on demand and never copied
+  /// to the heap; falls back to a regular read elsewhere.
+  class MappedFile : private NonCopyable {
+  public:
+
+    MappedFile() = default;
+
+    MappedFile(MappedFile &&rhs) noexcept;
+
+    MappedFile &operator=(MappedFile &&rhs) noexcept;
+
+    ~MappedFile();
+
+    /// View @a filename; returns false if the file cannot be opened.
+    bool Open(const std::string &filename);
+
+    void Close();
+
+    bool IsOpen() const {
+      return _open;
+    }
+
+    const uint8_t *data() const {
+      return _data;
+    }
+
+    size_t size() const {
+      return _size;
+    }
+
+  private:
+
+    const uint8_t *_data = nullptr;
+
+    size_t _size = 0u;
+
+    /// Distinguishes a real mapping from the heap fallback.
+    bool _mapped = false;
+
+    bool _open = false;
+
+    std::vector<uint8_t> _fallback;
+  };
+
+  /// Seekable read-only std::istream over a block of memory, typically a
+  /// MappedFile; the block must stay alive and unchanged while the stream
+  /// reads from it.
+  class MemoryStream final : private std::streambuf, public std::istream {
+  public:
+
+    MemoryStream(const void *data, size_t size)
+      : std::istream(this) {
+      auto begin = static_cast<char *>(const_cast<void *>(data));
+      setg(begin, begin, begin + size);
+    }
+
+    explicit MemoryStream(const MappedFile &file)
+      : MemoryStream(file.data(), file.size()) {}
+
+  private:
+
+    using pos_type = std::streambuf::pos_type;
+    using off_type = std::streambuf::off_type;
+
+    pos_type seekoff(
+        off_type off,
+        std::ios_base::seekdir dir,
+        std::ios_base::openmode which) override {
+      if ((which & std::ios_base::in) == 0) {
+        return pos_type(off_type(-1));
+      }
+      char *target =
+          (dir == std::ios_base::beg) ? eback() + off :
+          (dir == std::ios_base::cur) ? gptr() + off : egptr() + off;
+      if ((target < eback()) || (target > egptr())) {
+        return pos_type(off_type(-1));
+      }
+      setg(eback(), target, egptr());
+      return pos_type(target - eback());
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+      return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+  };
+
 } // namespace carla
@@ -0,0 +1,154 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/Logging.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+namespace carla {
+namespace logging {
+
+  /// Asynchronous logging sink: a bounded multi-producer single-consumer ring
+  /// buffer (Vyukov's bounded queue, the producer side is lock-free) drained
+  /// by a dedicated flush thread, so console I/O never runs under the calling
+  /// thread. When the ring is full the message is dropped and counted, the
+  /// flush thread reports the drops; losing a warning beats stalling a
+  /// sender.
+  ///
+  /// The instance is leaked on purpose and stopped through std::atexit:
+  /// joining the flush thread from a static destructor would turn any logging
+  /// from a later static destructor into use-after-free. Once stopped,
+  /// messages are written synchronously instead.
+  class AsyncLogSink {
+  public:
+
+    static AsyncLogSink &GetInstance() {
+      static AsyncLogSink &instance = *new AsyncLogSink();
+      return instance;
+    }
+
+    void Post(std::string &&message, bool is_error) {
+      if (_stopped.load(std::memory_order_acquire)) {
+        WriteNow(message, is_error);
+        return;
+      }
+      auto pos = _enqueue_pos.load(std::memory_order_relaxed);
+      for (;;) {
+        Slot &slot = _slots[pos & (ring_size - 1u)];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference =
+            static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (difference == 0) {
+          if (_enqueue_pos.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+            slot.message = std::move(message);
+            slot.is_error = is_error;
+            slot.sequence.store(pos + 1u, std::memory_order_release);
+            return;
+          }
+        } else if (difference < 0) {
+          // The consumer hasn't freed this slot yet, the ring is full.
+          _dropped.fetch_add(1u, std::memory_order_relaxed);
+          return;
+        } else {
+          pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+  private:
+
+    static constexpr size_t ring_size = 1024u; // must be a power of two.
+
+    struct Slot {
+      std::atomic<uint64_t> sequence{0u};
+      std::string message;
+      bool is_error = false;
+    };
+
+    AsyncLogSink() {
+      for (size_t i = 0u; i < ring_size; ++i) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+      }
+      _flusher = std::thread([this]() { FlushLoop(); });
+      std::atexit([]() { GetInstance().Stop(); });
+    }
+
+    static void WriteNow(const std::string &message, bool is_error) {
+      (is_error ? std::cerr : std::cout) << message << std::flush;
+    }
+
+    /// Pop and write every message currently in the ring; only called from
+    /// the flush thread and, after it has joined, from Stop.
+    bool Drain() {
+      bool any = false;
+      for (;;) {
+        Slot &slot = _slots[_dequeue_pos & (ring_size - 1u)];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != _dequeue_pos + 1u) {
+          break;
+        }
+        const auto message = std::move(slot.message);
+        const bool is_error = slot.is_error;
+        slot.message = std::string(); // moved-from, make the state explicit.
+        slot.sequence.store(_dequeue_pos + ring_size, std::memory_order_release);
+        ++_dequeue_pos;
+        (is_error ? std::cerr : std::cout) << message;
+        any = true;
+      }
+      const auto dropped = _dropped.exchange(0u, std::memory_order_relaxed);
+      if (dropped > 0u) {
+        std::cerr << "WARNING: logging backlog full: " << dropped << " message(s) dropped\n";
+        any = true;
+      }
+      if (any) {
+        std::cout.flush();
+        std::cerr.flush();
+      }
+      return any;
+    }
+
+    void FlushLoop() {
+      while (!_done.load(std::memory_order_acquire)) {
+        if (!Drain()) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      }
+    }
+
+    void Stop() {
+      _done.store(true, std::memory_order_release);
+      if (_flusher.joinable()) {
+        _flusher.join();
+      }
+      Drain();
+      _stopped.store(true, std::memory_order_release);
+    }
+
+    Slot _slots[ring_size];
+
+    std::atomic<uint64_t> _enqueue_pos{0u};
+
+    uint64_t _dequeue_pos = 0u;
+
+    std::atomic<uint64_t> _dropped{0u};
+
+    std::atomic_bool _done{false};
+
+    std::atomic_bool _stopped{false};
+
+    std::thread _flusher;
+  };
+
+  void post_to_sink(std::string &&message, bool is_error) {
+    AsyncLogSink::GetInstance().Post(std::move(message), is_error);
+  }
+
+} // namespace logging
+} // namespace carla
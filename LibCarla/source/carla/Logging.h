@@ -41,6 +41,8 @@
 // =============================================================================
 
 #include <iostream>
+#include <sstream>
+#include <string>
 
 namespace carla {
 
@@ -55,9 +57,30 @@ namespace logging {
     (void) expander{0, (void(out << ' ' << std::forward<Args>(args)), 0) ...};
   }
 
+  /// Hand @a message to the asynchronous logging sink; a dedicated thread
+  /// flushes it to stdout or stderr (@a is_error selects which). Never blocks
+  /// the caller, the message is dropped if the sink's ring buffer is full.
+  /// Defined in Logging.cpp.
+  void post_to_sink(std::string &&message, bool is_error);
+
+  /// Format the message up front on the calling thread, then queue it on the
+  /// asynchronous sink, so a burst of logging doesn't stall the caller on
+  /// console I/O. Define LIBCARLA_SYNCHRONOUS_LOGGING to write directly to
+  /// the stream instead.
+  template <typename ... Args>
+  static inline void write_async(bool is_error, Args && ... args) {
+#ifdef LIBCARLA_SYNCHRONOUS_LOGGING
+    write_to_stream(is_error ? std::cerr : std::cout, std::forward<Args>(args) ...);
+#else
+    std::ostringstream out;
+    write_to_stream(out, std::forward<Args>(args) ...);
+    post_to_sink(out.str(), is_error);
+#endif // LIBCARLA_SYNCHRONOUS_LOGGING
+  }
+
   template <typename ... Args>
   static inline void log(Args && ... args) {
-    logging::write_to_stream(std::cout, std::forward<Args>(args) ..., '\n');
+    logging::write_async(false, std::forward<Args>(args) ..., '\n');
   }
 
 } // namespace logging
@@ -66,7 +89,7 @@ namespace logging {
 
   template <typename ... Args>
   static inline void log_debug(Args && ... args) {
-    logging::write_to_stream(std::cout, "DEBUG:", std::forward<Args>(args) ..., '\n');
+    logging::write_async(false, "DEBUG:", std::forward<Args>(args) ..., '\n');
   }
 
 #else
@@ -80,7 +103,7 @@ namespace logging {
 
   template <typename ... Args>
   static inline void log_info(Args && ... args) {
-    logging::write_to_stream(std::cout, "INFO: ", std::forward<Args>(args) ..., '\n');
+    logging::write_async(false, "INFO: ", std::forward<Args>(args) ..., '\n');
   }
 
 #else
@@ -94,7 +117,7 @@ namespace logging {
 
   template <typename ... Args>
   static inline void log_warning(Args && ... args) {
-    logging::write_to_stream(std::cerr, "WARNING:", std::forward<Args>(args) ..., '\n');
+    logging::write_async(true, "WARNING:", std::forward<Args>(args) ..., '\n');
   }
 
 #else
@@ -108,7 +131,7 @@ namespace logging {
 
   template <typename ... Args>
   static inline void log_error(Args && ... args) {
-    logging::write_to_stream(std::cerr, "ERROR:", std::forward<Args>(args) ..., '\n');
+    logging::write_async(true, "ERROR:", std::forward<Args>(args) ..., '\n');
   }
 
 #else
@@ -122,7 +145,7 @@ namespace logging {
 
   template <typename ... Args>
   static inline void log_critical(Args && ... args) {
-    logging::write_to_stream(std::cerr, "CRITICAL:", std::forward<Args>(args) ..., '\n');
+    logging::write_async(true, "CRITICAL:", std::forward<Args>(args) ..., '\n');
   }
 
 #else
@@ -0,0 +1,97 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/Numa.h"
+
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+#  include <fstream>
+#  include <sstream>
+#  include <string>
+#endif // __linux__
+
+namespace carla {
+
+#ifdef __linux__
+
+  /// Parse a sysfs cpulist such as "0-15,32-47" into individual CPU ids.
+  static std::vector<size_t> ParseCpuList(const std::string &cpulist) {
+    std::vector<size_t> cpus;
+    std::istringstream stream(cpulist);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+      const auto dash = range.find('-');
+      try {
+        if (dash == std::string::npos) {
+          cpus.push_back(static_cast<size_t>(std::stoul(range)));
+        } else {
+          const auto first = std::stoul(range.substr(0u, dash));
+          const auto last = std::stoul(range.substr(dash + 1u));
+          for (auto cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<size_t>(cpu));
+          }
+        }
+      } catch (...) {
+        return {};
+      }
+    }
+    return cpus;
+  }
+
+  static std::vector<size_t> ReadNodeCpus(size_t node) {
+    std::ifstream file(
+        "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!file.is_open()) {
+      return {};
+    }
+    std::string cpulist;
+    std::getline(file, cpulist);
+    return ParseCpuList(cpulist);
+  }
+
+  size_t Numa::GetNodeCount() {
+    size_t count = 0u;
+    while (!ReadNodeCpus(count).empty()) {
+      ++count;
+    }
+    return count > 0u ? count : 1u;
+  }
+
+  std::vector<size_t> Numa::GetNodeCpus(size_t node) {
+    return ReadNodeCpus(node);
+  }
+
+  bool Numa::PinThisThreadToNode(size_t node) {
+    const auto cpus = ReadNodeCpus(node);
+    if (cpus.empty()) {
+      return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu : cpus) {
+      CPU_SET(cpu, &cpu_set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0;
+  }
+
+#else
+
+  size_t Numa::GetNodeCount() {
+    return 1u;
+  }
+
+  std::vector<size_t> Numa::GetNodeCpus(size_t) {
+    return {};
+  }
+
+  bool Numa::PinThisThreadToNode(size_t) {
+    return false;
+  }
+
+#endif // __linux__
+
+} // namespace carla
@@ -0,0 +1,39 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace carla {
+
+  /// Minimal view of the NUMA topology of the host, read from sysfs on
+  /// Linux. On other platforms, or when the topology cannot be read, the
+  /// host looks like a single node holding every CPU and pinning requests
+  /// become no-ops.
+  ///
+  /// Thread placement is enough to also get node-local memory in practice:
+  /// Linux places pages on the node of the thread that first touches them,
+  /// so buffers allocated and filled by a pinned worker (e.g. through the
+  /// BufferPool of a stream) end up local to its node.
+  class Numa {
+  public:
+
+    /// Number of NUMA nodes of the host, at least 1.
+    static size_t GetNodeCount();
+
+    /// CPUs belonging to @a node, empty if the node does not exist or the
+    /// topology is unknown.
+    static std::vector<size_t> GetNodeCpus(size_t node);
+
+    /// Restrict the calling thread to the CPUs of @a node. Returns false if
+    /// the node is unknown or the affinity could not be set, leaving the
+    /// affinity unchanged.
+    static bool PinThisThreadToNode(size_t node);
+  };
+
+} // namespace carla
@@ -7,15 +7,19 @@
 #pragma once
 
 #include "carla/Exception.h"
+#include "carla/StopWatch.h"
 #include "carla/Time.h"
 
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <exception>
 #include <map>
 #include <mutex>
+#include <thread>
 
 namespace carla {
 
@@ -43,6 +47,14 @@ namespace detail {
     /// @return empty optional if the timeout is met.
     boost::optional<T> WaitFor(time_duration timeout);
 
+    /// Busy-wait up to @a micros microseconds for the value before parking on
+    /// the condition variable, trading CPU for wakeup latency. The spin is
+    /// adaptive: it is skipped while recent waits have been resolving slower
+    /// than the budget. Zero (the default) always parks.
+    void SetSpinBudget(size_t micros) {
+      _spin_budget_micros = micros;
+    }
+
     /// Set the value and notify all waiting threads.
     template <typename T2>
     void SetValue(const T2 &value);
@@ -61,6 +73,16 @@ namespace detail {
 
     std::condition_variable _cv;
 
+    /// Incremented on every SetValue so spinning threads can poll for the
+    /// next value without taking the mutex.
+    std::atomic<uint64_t> _generation{0u};
+
+    std::atomic<uint64_t> _spin_budget_micros{0u};
+
+    /// Moving average of how long recent waits took, spinning is pointless
+    /// when this exceeds the budget.
+    std::atomic<uint64_t> _wait_estimate_micros{0u};
+
     struct mapped_type {
       bool should_wait;
       boost::variant<SharedException, T> value;
@@ -103,10 +125,37 @@ namespace detail {
 
   template <typename T>
   boost::optional<T> RecurrentSharedFuture<T>::WaitFor(time_duration timeout) {
+    const auto timeout_micros = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(timeout.to_chrono()).count());
+    const auto spin_budget = (std::min)(_spin_budget_micros.load(), timeout_micros);
+    StopWatch stop_watch;
     std::unique_lock<std::mutex> lock(_mutex);
     auto &r = _map[&detail::thread_tag];
     r.should_wait = true;
-    if (!_cv.wait_for(lock, timeout.to_chrono(), [&]() { return !r.should_wait; })) {
+    if ((spin_budget > 0u) && (_wait_estimate_micros.load() <= spin_budget)) {
+      // Spin phase: poll the generation counter outside the lock until the
+      // budget is exhausted or the next value arrives.
+      const auto generation = _generation.load();
+      lock.unlock();
+      size_t spins = 0u;
+      while ((_generation.load() == generation) &&
+             (stop_watch.GetElapsedTime<std::chrono::microseconds>() < spin_budget)) {
+        if ((++spins & 0x3ffu) == 0u) {
+          std::this_thread::yield();
+        }
+      }
+      lock.lock();
+    }
+    const auto spent = stop_watch.GetElapsedTime<std::chrono::microseconds>();
+    const auto remaining = (timeout_micros > spent) ? (timeout_micros - spent) : 0u;
+    const bool has_value = _cv.wait_for(
+        lock,
+        std::chrono::microseconds(remaining),
+        [&]() { return !r.should_wait; });
+    // Feed the moving average so the next wait knows whether spinning pays.
+    const auto elapsed = stop_watch.GetElapsedTime<std::chrono::microseconds>();
+    _wait_estimate_micros = (3u * _wait_estimate_micros.load() + elapsed) / 4u;
+    if (!has_value) {
       return {};
     }
     if (r.value.which() == 0) {
@@ -123,6 +172,7 @@ namespace detail {
       pair.second.should_wait = false;
       pair.second.value = value;
     }
+    ++_generation;
     _cv.notify_all();
   }
 
@@ -0,0 +1,256 @@
+// Copyright (c) 2019 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/ThreadGroup.h"
+#include "carla/Time.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace carla {
+
+  /// A work-stealing task executor with the same Post interface as
+  /// ThreadPool, for compute jobs that do not need an asio io_context.
+  ///
+  /// ThreadPool funnels every task through one io_context whose queue all
+  /// workers contend on. Here each worker owns a double-ended queue; it
+  /// pushes and pops work at the back, and only takes from the front of
+  /// another worker's queue when its own runs dry, so under load there is no
+  /// central queue to serialize on. Posts from outside the pool are spread
+  /// round-robin, or directed with an affinity hint to keep related tasks on
+  /// the same worker.
+  ///
+  /// Consumers needing asio sockets or strands (the streaming server and
+  /// client) must keep using ThreadPool, asio I/O objects require its
+  /// io_context.
+  class TaskExecutor : private NonCopyable {
+  public:
+
+    TaskExecutor() = default;
+
+    /// Stops the TaskExecutor and joins all its threads.
+    ~TaskExecutor() {
+      Stop();
+    }
+
+    /// Post a task to the executor.
+    template <typename FunctorT, typename ResultT = typename std::result_of<FunctorT()>::type>
+    std::future<ResultT> Post(FunctorT &&functor) {
+      return Post(std::forward<FunctorT>(functor), _next_queue++);
+    }
+
+    /// Post a task with an affinity hint: tasks posted with the same hint
+    /// land on the queue of the same worker (hint modulo workers), keeping
+    /// related tasks warm in one core's cache. The hint only selects the
+    /// initial queue, an idle worker may still steal the task.
+    template <typename FunctorT, typename ResultT = typename std::result_of<FunctorT()>::type>
+    std::future<ResultT> Post(FunctorT &&functor, size_t affinity_hint) {
+      auto task = std::packaged_task<ResultT()>(std::forward<FunctorT>(functor));
+      auto future = task.get_future();
+      Enqueue(Task(std::move(task)), affinity_hint);
+      return future;
+    }
+
+    /// Launch @a worker_threads threads running tasks asynchronously. The
+    /// first call fixes the number of queues; later calls add workers that
+    /// share the existing queues.
+    void AsyncRun(size_t worker_threads) {
+      size_t count = _queue_count.load(std::memory_order_acquire);
+      if (count == 0u) {
+        count = std::max(worker_threads, size_t(1u));
+        for (size_t i = 0u; i < count; ++i) {
+          _queues.emplace_back(std::make_unique<WorkerQueue>());
+        }
+        _queue_count.store(count, std::memory_order_release);
+      }
+      for (size_t i = 0u; i < worker_threads; ++i) {
+        _workers.CreateThread([this, index = i % count]() { RunWorker(index); });
+      }
+    }
+
+    /// @copydoc AsyncRun(size_t)
+    void AsyncRun() {
+      AsyncRun(std::thread::hardware_concurrency());
+    }
+
+    /// Run tasks in this thread, stealing from the workers' queues.
+    ///
+    /// @warning This function blocks until the TaskExecutor has been stopped.
+    void Run() {
+      RunUntil(std::chrono::steady_clock::time_point::max());
+    }
+
+    /// Run tasks in this thread for an specific @a duration.
+    void RunFor(time_duration duration) {
+      RunUntil(std::chrono::steady_clock::now() + duration.to_chrono());
+    }
+
+    /// Stop the TaskExecutor and join all its threads. Pending tasks are
+    /// abandoned, their futures report a broken promise.
+    void Stop() {
+      _done = true;
+      _inbox.wake_up.notify_all();
+      for (auto &queue : _queues) {
+        queue->wake_up.notify_all();
+      }
+      _workers.JoinAll();
+    }
+
+  private:
+
+    /// Type-erased move-only task; std::function cannot hold the move-only
+    /// packaged_task.
+    class Task {
+    public:
+
+      Task() = default;
+
+      template <typename FunctorT>
+      Task(FunctorT &&functor)
+        : _impl(std::make_unique<Impl<typename std::decay<FunctorT>::type>>(
+              std::forward<FunctorT>(functor))) {}
+
+      void operator()() {
+        _impl->Invoke();
+      }
+
+      explicit operator bool() const {
+        return _impl != nullptr;
+      }
+
+    private:
+
+      struct Base {
+        virtual ~Base() = default;
+        virtual void Invoke() = 0;
+      };
+
+      template <typename FunctorT>
+      struct Impl : Base {
+        Impl(FunctorT &&functor) : functor(std::move(functor)) {}
+        void Invoke() override {
+          functor();
+        }
+        FunctorT functor;
+      };
+
+      std::unique_ptr<Base> _impl;
+    };
+
+    struct WorkerQueue {
+      std::mutex mutex;
+      std::condition_variable wake_up;
+      std::deque<Task> tasks;
+    };
+
+    void Enqueue(Task &&task, size_t hint) {
+      const size_t count = _queue_count.load(std::memory_order_acquire);
+      // Before AsyncRun there are no worker queues yet, park the task in the
+      // inbox; the workers also steal from it.
+      WorkerQueue &queue = (count == 0u) ? _inbox : *_queues[hint % count];
+      {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.emplace_back(std::move(task));
+      }
+      queue.wake_up.notify_one();
+    }
+
+    /// The owner takes from the back, where it just pushed.
+    static bool TryPopBack(WorkerQueue &queue, Task &task) {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty()) {
+        return false;
+      }
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      return true;
+    }
+
+    /// Thieves take from the front, the oldest and coldest task.
+    static bool TrySteal(WorkerQueue &queue, Task &task) {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty()) {
+        return false;
+      }
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+
+    bool FindTask(WorkerQueue &own, size_t own_index, Task &task) {
+      if (TryPopBack(own, task)) {
+        return true;
+      }
+      const size_t count = _queue_count.load(std::memory_order_acquire);
+      for (size_t offset = 1u; offset < count; ++offset) {
+        if (TrySteal(*_queues[(own_index + offset) % count], task)) {
+          return true;
+        }
+      }
+      return TrySteal(_inbox, task);
+    }
+
+    void RunWorker(size_t index) {
+      WorkerQueue &own = *_queues[index];
+      while (!_done) {
+        Task task;
+        if (FindTask(own, index, task)) {
+          task();
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+          continue;
+        }
+        // The timeout bounds how long a newly idle worker takes to notice
+        // work sitting on a busy sibling's queue.
+        own.wake_up.wait_for(lock, std::chrono::milliseconds(2));
+      }
+    }
+
+    /// Steal-only loop for threads joining through Run/RunFor, they have no
+    /// queue of their own.
+    void RunUntil(std::chrono::steady_clock::time_point deadline) {
+      while (!_done && (std::chrono::steady_clock::now() < deadline)) {
+        Task task;
+        if (FindTask(_inbox, 0u, task)) {
+          task();
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(_inbox.mutex);
+        if (!_inbox.tasks.empty()) {
+          continue;
+        }
+        _inbox.wake_up.wait_for(lock, std::chrono::milliseconds(2));
+      }
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+
+    WorkerQueue _inbox;
+
+    std::atomic_size_t _queue_count{0u};
+
+    std::atomic_size_t _next_queue{0u};
+
+    std::atomic_bool _done{false};
+
+    ThreadGroup _workers;
+  };
+
+} // namespace carla
@@ -8,6 +8,7 @@
 
 #include "carla/MoveHandler.h"
 #include "carla/NonCopyable.h"
+#include "carla/Numa.h"
 #include "carla/ThreadGroup.h"
 #include "carla/Time.h"
 
@@ -17,6 +18,11 @@
 #include <thread>
 #include <type_traits>
 
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+#endif // __linux__
+
 namespace carla {
 
   /// A thread pool based on Boost.Asio's io context.
@@ -51,6 +57,30 @@ namespace carla {
       _workers.CreateThreads(worker_threads, [this]() { Run(); });
     }
 
+    /// Like AsyncRun(size_t), but pins the workers to consecutive CPUs
+    /// starting at @a first_cpu. Pinning is only implemented on Linux, on
+    /// other platforms this behaves as AsyncRun(size_t).
+    void AsyncRunPinned(size_t worker_threads, size_t first_cpu) {
+      for (size_t i = 0u; i < worker_threads; ++i) {
+        _workers.CreateThread([this, cpu = first_cpu + i]() {
+          PinThisThreadToCpu(cpu);
+          Run();
+        });
+      }
+    }
+
+    /// Like AsyncRun(size_t), but restricts the workers to the CPUs of NUMA
+    /// node @a node, see carla::Numa. Workers float within the node, so the
+    /// memory they allocate and first touch stays node-local without the
+    /// imbalance risk of per-CPU pinning. Falls back to AsyncRun(size_t)
+    /// when the topology is unknown.
+    void AsyncRunOnNode(size_t worker_threads, size_t node) {
+      _workers.CreateThreads(worker_threads, [this, node]() {
+        Numa::PinThisThreadToNode(node);
+        Run();
+      });
+    }
+
     /// @copydoc AsyncRun(size_t)
     void AsyncRun() {
       AsyncRun(std::thread::hardware_concurrency());
@@ -79,6 +109,17 @@ namespace carla {
 
   private:
 
+    static void PinThisThreadToCpu(size_t cpu) {
+#ifdef __linux__
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(cpu % std::thread::hardware_concurrency(), &cpu_set);
+      pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+#else
+      (void) cpu;
+#endif // __linux__
+    }
+
     boost::asio::io_context _io_context;
 
     boost::asio::io_context::work _work_to_do;
@@ -0,0 +1,41 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/WildcardPattern.h"
+
+#include "carla/StringUtil.h"
+
+namespace carla {
+
+  // Characters with a special meaning for StringUtil::Match; backslash
+  // counts because fnmatch treats it as an escape.
+  static constexpr const char WILDCARD_CHARACTERS[] = "*?[\\";
+
+  WildcardPattern::WildcardPattern(std::string pattern)
+    : _pattern(std::move(pattern)),
+      _kind(Kind::Generic) {
+    const auto pos = _pattern.find_first_of(WILDCARD_CHARACTERS);
+    if (pos == std::string::npos) {
+      _kind = Kind::Literal;
+      _prefix = _pattern;
+    } else if ((_pattern[pos] == '*') && (pos + 1u == _pattern.size())) {
+      _kind = Kind::Prefix;
+      _prefix = _pattern.substr(0u, pos);
+    }
+  }
+
+  bool WildcardPattern::Matches(const std::string &str) const {
+    switch (_kind) {
+      case Kind::Literal:
+        return str == _pattern;
+      case Kind::Prefix:
+        return str.compare(0u, _prefix.size(), _prefix) == 0;
+      default:
+        return StringUtil::Match(str, _pattern);
+    }
+  }
+
+} // namespace carla
@@ -0,0 +1,63 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <string>
+
+namespace carla {
+
+  /// A Unix shell-style wildcard pattern precompiled for repeated matching.
+  ///
+  /// The pattern is classified once at construction so the common cases, a
+  /// literal string and a "prefix*" query, are answered with plain string
+  /// comparisons instead of interpreting the wildcards against every
+  /// candidate.
+  class WildcardPattern {
+  public:
+
+    explicit WildcardPattern(std::string pattern);
+
+    const std::string &GetPattern() const {
+      return _pattern;
+    }
+
+    /// Whether the pattern contains no wildcards, i.e. it can only match a
+    /// string equal to it.
+    bool IsLiteral() const {
+      return _kind == Kind::Literal;
+    }
+
+    /// Whether the pattern is a fixed prefix followed by a single trailing
+    /// '*', i.e. it matches any string starting with GetPrefix().
+    bool IsPrefix() const {
+      return _kind == Kind::Prefix;
+    }
+
+    /// The whole pattern for a literal, the pattern minus the trailing '*'
+    /// for a prefix, empty otherwise.
+    const std::string &GetPrefix() const {
+      return _prefix;
+    }
+
+    bool Matches(const std::string &str) const;
+
+  private:
+
+    enum class Kind : uint8_t {
+      Literal,
+      Prefix,
+      Generic
+    };
+
+    std::string _pattern;
+
+    std::string _prefix;
+
+    Kind _kind;
+  };
+
+} // namespace carla
@@ -23,7 +23,7 @@ namespace client {
   public:
 
     explicit Actor(ActorInitializer init)
-      : LIBCARLA_INITIALIZE_LIFETIME_PROFILER(init.GetDisplayId()),
+      : LIBCARLA_INITIALIZE_LIFETIME_PROFILER("Actor", init.GetDisplayId()),
         Super(std::move(init)) {}
 
     virtual ~Actor() = default;
@@ -8,6 +8,7 @@
 
 #include "carla/Exception.h"
 #include "carla/StringUtil.h"
+#include "carla/WildcardPattern.h"
 
 #include <algorithm>
 
@@ -31,10 +32,14 @@ namespace client {
   }
 
   bool ActorBlueprint::MatchTags(const std::string &wildcard_pattern) const {
+    return MatchTags(WildcardPattern{wildcard_pattern});
+  }
+
+  bool ActorBlueprint::MatchTags(const WildcardPattern &pattern) const {
     return
-        StringUtil::Match(_id, wildcard_pattern) ||
+        pattern.Matches(_id) ||
         std::any_of(_tags.begin(), _tags.end(), [&](const auto &tag) {
-          return StringUtil::Match(tag, wildcard_pattern);
+          return pattern.Matches(tag);
         });
   }
 
@@ -49,17 +54,21 @@ namespace client {
 
   void ActorBlueprint::SetAttribute(const std::string &id, std::string value) {
     const_cast<ActorAttribute &>(GetAttribute(id)).Set(std::move(value));
+    _compiled_description.reset();
   }
 
-  rpc::ActorDescription ActorBlueprint::MakeActorDescription() const {
-    rpc::ActorDescription description;
-    description.uid = _uid;
-    description.id = _id;
-    description.attributes.reserve(_attributes.size());
-    for (const auto &attribute : *this) {
-      description.attributes.push_back(attribute);
+  const rpc::ActorDescription &ActorBlueprint::MakeActorDescription() const {
+    if (_compiled_description == nullptr) {
+      auto description = MakeShared<rpc::ActorDescription>();
+      description->uid = _uid;
+      description->id = _id;
+      description->attributes.reserve(_attributes.size());
+      for (const auto &attribute : *this) {
+        description->attributes.push_back(attribute);
+      }
+      _compiled_description = std::move(description);
     }
-    return description;
+    return *_compiled_description;
   }
 
 } // namespace client
@@ -8,6 +8,7 @@
 
 #include "carla/Debug.h"
 #include "carla/Iterator.h"
+#include "carla/Memory.h"
 #include "carla/client/ActorAttribute.h"
 #include "carla/rpc/ActorDefinition.h"
 #include "carla/rpc/ActorDescription.h"
@@ -17,6 +18,9 @@
 #include <unordered_set>
 
 namespace carla {
+
+  class WildcardPattern;
+
 namespace client {
 
   /// Contains all the necessary information for spawning an Actor.
@@ -59,6 +63,10 @@ namespace client {
     /// @a wildcard_pattern follows Unix shell-style wildcards.
     bool MatchTags(const std::string &wildcard_pattern) const;
 
+    /// Same as above with a pattern precompiled by the caller, use when
+    /// matching the same pattern against many blueprints.
+    bool MatchTags(const WildcardPattern &pattern) const;
+
     std::vector<std::string> GetTags() const {
       return {_tags.begin(), _tags.end()};
     }
@@ -105,7 +113,11 @@ namespace client {
 
   public:
 
-    rpc::ActorDescription MakeActorDescription() const;
+    /// Rpc description of the current configuration. Compiled on first use
+    /// and reused by every spawn of this blueprint until an attribute
+    /// changes, so fleets spawned from one blueprint share a single
+    /// description object instead of re-copying every attribute string.
+    const rpc::ActorDescription &MakeActorDescription() const;
 
     /// @}
 
@@ -118,6 +130,10 @@ namespace client {
     std::unordered_set<std::string> _tags;
 
     std::unordered_map<std::string, ActorAttribute> _attributes;
+
+    /// Shared between copies of the blueprint; SetAttribute drops only the
+    /// caller's reference.
+    mutable SharedPtr<const rpc::ActorDescription> _compiled_description;
   };
 
 } // namespace client
@@ -7,6 +7,7 @@
 #include "carla/client/BlueprintLibrary.h"
 
 #include "carla/Exception.h"
+#include "carla/WildcardPattern.h"
 
 #include <algorithm>
 #include <iterator>
@@ -20,14 +21,52 @@ namespace client {
     for (auto &definition : blueprints) {
       _blueprints.emplace(definition.id, ActorBlueprint{definition});
     }
+    BuildIndices();
+  }
+
+  void BlueprintLibrary::BuildIndices() {
+    auto add_prefixes = [this](const std::string &str, const key_type &key) {
+      for (auto pos = str.find('.'); pos != std::string::npos; pos = str.find('.', pos + 1u)) {
+        _prefix_index[str.substr(0u, pos + 1u)].push_back(key);
+      }
+    };
+    for (auto &pair : _blueprints) {
+      _exact_index[pair.second.GetId()].push_back(pair.first);
+      add_prefixes(pair.second.GetId(), pair.first);
+      for (auto &tag : pair.second.GetTags()) {
+        _exact_index[tag].push_back(pair.first);
+        add_prefixes(tag, pair.first);
+      }
+    }
   }
 
   SharedPtr<BlueprintLibrary> BlueprintLibrary::Filter(
       const std::string &wildcard_pattern) const {
+    WildcardPattern pattern{wildcard_pattern};
     map_type result;
-    for (auto &pair : _blueprints) {
-      if (pair.second.MatchTags(wildcard_pattern)) {
-        result.emplace(pair);
+    auto copy_indexed = [&](const index_type &index, const std::string &key) {
+      auto it = index.find(key);
+      if (it != index.end()) {
+        for (auto &id : it->second) {
+          result.emplace(id, _blueprints.at(id));
+        }
+      }
+    };
+    if (pattern.IsLiteral()) {
+      result.reserve(1u);
+      copy_indexed(_exact_index, pattern.GetPrefix());
+    } else if (pattern.IsPrefix() && pattern.GetPrefix().empty()) {
+      // "*" matches everything.
+      result = _blueprints;
+    } else if (pattern.IsPrefix() && (pattern.GetPrefix().back() == '.')) {
+      // Queries like "vehicle.*" resolve from the prefix index.
+      copy_indexed(_prefix_index, pattern.GetPrefix());
+    } else {
+      // The pattern needs a scan, but it is compiled only once.
+      for (auto &pair : _blueprints) {
+        if (pair.second.MatchTags(pattern)) {
+          result.emplace(pair);
+        }
       }
     }
     return SharedPtr<BlueprintLibrary>{new BlueprintLibrary(result)};
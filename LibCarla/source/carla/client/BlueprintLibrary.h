@@ -77,10 +77,26 @@ namespace client {
 
   private:
 
+    using index_type = std::unordered_map<std::string, std::vector<key_type>>;
+
     BlueprintLibrary(map_type blueprints)
-      : _blueprints(std::move(blueprints)) {}
+      : _blueprints(std::move(blueprints)) {
+      BuildIndices();
+    }
+
+    /// Build _exact_index and _prefix_index from _blueprints.
+    void BuildIndices();
 
     map_type _blueprints;
+
+    /// Id and tags of each blueprint, points back to the blueprint id;
+    /// resolves wildcard-free patterns without a scan.
+    index_type _exact_index;
+
+    /// Dot-terminated prefixes of the id and tags of each blueprint (e.g.
+    /// "vehicle." and "vehicle.tesla." for "vehicle.tesla.model3"); resolves
+    /// patterns of the form "vehicle.*" without a scan.
+    index_type _prefix_index;
   };
 
 } // namespace client
@@ -40,6 +40,18 @@ namespace client {
       return _simulator->GetNetworkingTimeout();
     }
 
+    /// Grow the pool of RPC connections to @a count lanes, letting calls
+    /// issued from different threads run concurrently instead of queueing on
+    /// a single socket. Each thread sticks to one lane, so its own calls
+    /// keep their order.
+    void SetRpcLanes(size_t count) const {
+      _simulator->SetRpcLanes(count);
+    }
+
+    size_t GetRpcLanes() const {
+      return _simulator->GetRpcLanes();
+    }
+
     /// Return the version string of this client API.
     std::string GetClientVersion() const {
       return _simulator->GetClientVersion();
@@ -58,6 +70,14 @@ namespace client {
       return World{_simulator->ReloadEpisode()};
     }
 
+    /// Reset the current world in place: destroy the actors spawned through
+    /// the API and start a fresh episode without reloading the map, keeping
+    /// navigation and tag data resident. Much faster than ReloadWorld when
+    /// the map does not change.
+    World ResetWorld(bool reset_settings = true, bool reset_weather = true) const {
+      return World{_simulator->ResetEpisode(reset_settings, reset_weather)};
+    }
+
     World LoadWorld(std::string map_name) const {
       return World{_simulator->LoadEpisode(std::move(map_name))};
     }
@@ -84,8 +104,58 @@ namespace client {
       return _simulator->GetCurrentEpisode();
     }
 
-    std::string StartRecorder(std::string name) {
-      return _simulator->StartRecorder(name);
+    /// Start recording trace events server-side into a ring buffer of
+    /// @a max_events events; retrieve them with GetTrace.
+    void StartTrace(uint64_t max_events = 1u << 20) {
+      _simulator->StartTrace(max_events);
+    }
+
+    void StopTrace(void) {
+      _simulator->StopTrace();
+    }
+
+    /// The server's captured trace events as a chrome://tracing JSON
+    /// document.
+    std::string GetTrace(void) {
+      return _simulator->GetTrace();
+    }
+
+    /// Live/peak/total counters of the server's profiled objects plus the
+    /// memory retained by its buffer pools, handy for spotting leaks on
+    /// long-running servers.
+    rpc::ObjectCensus GetObjectCensus() const {
+      return _simulator->GetObjectCensus();
+    }
+
+    /// Rolling breakdown of the server's frame time among the stages of its
+    /// main loop — physics flush, state broadcast, serialization, world
+    /// tick, and RPC draining — with mean and percentiles over the most
+    /// recent frames.
+    rpc::FrameStats GetFrameStats() const {
+      return _simulator->GetFrameStats();
+    }
+
+    /// Allocation counters — hits, misses, discards, retained bytes and
+    /// their high-water mark — of every buffer pool of the server process,
+    /// for tracking down which pool grows on long-running servers.
+    std::vector<rpc::BufferPoolStats> GetBufferPoolStats() const {
+      return _simulator->GetBufferPoolStats();
+    }
+
+    std::string StartRecorder(std::string name, std::string filter = "") {
+      return _simulator->StartRecorder(name, std::move(filter));
+    }
+
+    /// Start the recorder streaming its blocks to this client instead of
+    /// writing them on the simulator host; @a callback receives the raw
+    /// bytes of the recording in order, appending them to a file reproduces
+    /// the recorder file. @a name only serves as fallback file on the
+    /// server for blocks produced before this client is subscribed.
+    void StartRecorderStream(
+        std::string name,
+        std::function<void(Buffer)> callback,
+        std::string filter = "") {
+      _simulator->StartRecorderStream(std::move(name), std::move(filter), std::move(callback));
     }
 
     void StopRecorder(void) {
@@ -116,6 +186,25 @@ namespace client {
       _simulator->SetReplayerIgnoreHero(ignore_hero);
     }
 
+    double FastForwardReplayer(double time) {
+      return _simulator->FastForwardReplayer(time);
+    }
+
+    /// Hand the stream of sensor @a actor_id over to a secondary renderer
+    /// listening at @a host and @a port. Late subscribers are pointed at the
+    /// secondary; the returned token must be given to the secondary through
+    /// AdoptSensorStream so it publishes under the same stream id.
+    std::vector<uint8_t> RedirectSensorStream(ActorId actor_id, std::string host, uint16_t port) {
+      return _simulator->RedirectSensorStream(actor_id, std::move(host), port);
+    }
+
+    /// On a secondary renderer, attach sensor @a actor_id to the stream
+    /// identified by @a token, as returned by RedirectSensorStream on the
+    /// primary simulator.
+    void AdoptSensorStream(ActorId actor_id, std::vector<uint8_t> token) {
+      _simulator->AdoptSensorStream(actor_id, std::move(token));
+    }
+
     void ApplyBatch(
         std::vector<rpc::Command> commands,
         bool do_tick_cue = false) const {
@@ -128,6 +217,17 @@ namespace client {
       return _simulator->ApplyBatchSync(std::move(commands), do_tick_cue);
     }
 
+    /// The per-step exchange of a co-simulation bridge: apply a batch of
+    /// externally-driven actor transforms (and optionally light states) and
+    /// read back the transform, velocity and light state of the actors in
+    /// @a query_ids, all in one round trip. Entries whose actor no longer
+    /// exists are skipped on both halves.
+    std::vector<rpc::ActorSyncState> ExchangeActorStates(
+        const std::vector<rpc::ActorTransformUpdate> &updates,
+        const std::vector<ActorId> &query_ids) const {
+      return _simulator->ExchangeActorStates(updates, query_ids);
+    }
+
   private:
 
     std::shared_ptr<detail::Simulator> _simulator;
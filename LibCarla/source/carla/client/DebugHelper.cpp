@@ -7,6 +7,7 @@
 #include "carla/client/DebugHelper.h"
 
 #include "carla/client/detail/Simulator.h"
+#include "carla/rpc/Command.h"
 #include "carla/rpc/DebugShape.h"
 
 namespace carla {
@@ -81,5 +82,72 @@ namespace client {
     DrawShape(_episode, string, color, life_time, persistent_lines);
   }
 
+  void DebugHelper::DrawShapes(std::vector<Shape> shapes) {
+    rpc::Command::DrawDebugShapes command{std::move(shapes)};
+    _episode.Lock()->ApplyBatch({command}, false);
+  }
+
+  void DebugHelper::DrawShapes(uint32_t handle, std::vector<Shape> shapes) {
+    {
+      std::lock_guard<std::mutex> lock(_handles->mutex);
+      auto &last = _handles->batches[handle];
+      if (last == shapes) {
+        return;
+      }
+      last = shapes;
+    }
+    DrawShapes(std::move(shapes));
+  }
+
+  DebugHelper::Shape DebugHelper::MakePoint(
+      const geom::Location &location,
+      float size,
+      sensor::data::Color color,
+      float life_time,
+      bool persistent_lines) {
+    return Shape{Shape::Point{location, size}, color, life_time, persistent_lines};
+  }
+
+  DebugHelper::Shape DebugHelper::MakeLine(
+      const geom::Location &begin,
+      const geom::Location &end,
+      float thickness,
+      sensor::data::Color color,
+      float life_time,
+      bool persistent_lines) {
+    return Shape{Shape::Line{begin, end, thickness}, color, life_time, persistent_lines};
+  }
+
+  DebugHelper::Shape DebugHelper::MakeArrow(
+      const geom::Location &begin,
+      const geom::Location &end,
+      float thickness,
+      float arrow_size,
+      sensor::data::Color color,
+      float life_time,
+      bool persistent_lines) {
+    return Shape{Shape::Arrow{Shape::Line{begin, end, thickness}, arrow_size}, color, life_time, persistent_lines};
+  }
+
+  DebugHelper::Shape DebugHelper::MakeBox(
+      const geom::BoundingBox &box,
+      const geom::Rotation &rotation,
+      float thickness,
+      sensor::data::Color color,
+      float life_time,
+      bool persistent_lines) {
+    return Shape{Shape::Box{box, rotation, thickness}, color, life_time, persistent_lines};
+  }
+
+  DebugHelper::Shape DebugHelper::MakeString(
+      const geom::Location &location,
+      const std::string &text,
+      bool draw_shadow,
+      sensor::data::Color color,
+      float life_time,
+      bool persistent_lines) {
+    return Shape{Shape::String{location, text, draw_shadow}, color, life_time, persistent_lines};
+  }
+
 } // namespace client
 } // namespace carla
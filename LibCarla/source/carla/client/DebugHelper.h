@@ -10,8 +10,15 @@
 #include "carla/geom/BoundingBox.h"
 #include "carla/geom/Location.h"
 #include "carla/geom/Rotation.h"
+#include "carla/rpc/DebugShape.h"
 #include "carla/sensor/data/Color.h"
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace carla {
 namespace client {
 
@@ -20,6 +27,8 @@ namespace client {
 
     using Color = sensor::data::Color;
 
+    using Shape = rpc::DebugShape;
+
     explicit DebugHelper(detail::EpisodeProxy episode)
       : _episode(std::move(episode)) {}
 
@@ -63,9 +72,73 @@ namespace client {
         float life_time = -1.0f,
         bool persistent_lines = true);
 
+    /// @name Batched submission
+    ///
+    /// Build the shapes with the Make* helpers below and submit them all in
+    /// a single command instead of one round trip per shape.
+    /// @{
+
+    void DrawShapes(std::vector<Shape> shapes);
+
+    /// Like DrawShapes, but remembers the batch under @a handle and skips
+    /// the submission entirely when it is identical to the last batch drawn
+    /// with this handle. Only useful with persistent shapes, non-persistent
+    /// ones disappear without being resent.
+    void DrawShapes(uint32_t handle, std::vector<Shape> shapes);
+
+    static Shape MakePoint(
+        const geom::Location &location,
+        float size = 0.1f,
+        Color color = Color{255u, 0u, 0u},
+        float life_time = -1.0f,
+        bool persistent_lines = true);
+
+    static Shape MakeLine(
+        const geom::Location &begin,
+        const geom::Location &end,
+        float thickness = 0.1f,
+        Color color = Color{255u, 0u, 0u},
+        float life_time = -1.0f,
+        bool persistent_lines = true);
+
+    static Shape MakeArrow(
+        const geom::Location &begin,
+        const geom::Location &end,
+        float thickness = 0.1f,
+        float arrow_size = 0.1f,
+        Color color = Color{255u, 0u, 0u},
+        float life_time = -1.0f,
+        bool persistent_lines = true);
+
+    static Shape MakeBox(
+        const geom::BoundingBox &box,
+        const geom::Rotation &rotation,
+        float thickness = 0.1f,
+        Color color = Color{255u, 0u, 0u},
+        float life_time = -1.0f,
+        bool persistent_lines = true);
+
+    static Shape MakeString(
+        const geom::Location &location,
+        const std::string &text,
+        bool draw_shadow = false,
+        Color color = Color{255u, 0u, 0u},
+        float life_time = -1.0f,
+        bool persistent_lines = true);
+
+    /// @}
+
   private:
 
+    /// Last batch drawn per handle, shared by the copies of this helper.
+    struct HandleCache {
+      std::mutex mutex;
+      std::unordered_map<uint32_t, std::vector<Shape>> batches;
+    };
+
     detail::EpisodeProxy _episode;
+
+    std::shared_ptr<HandleCache> _handles = std::make_shared<HandleCache>();
   };
 
 } // namespace client
@@ -25,5 +25,9 @@ namespace client {
     return _bounding_box;
   }
 
+  std::vector<road::Junction::LaneConflict> Junction::GetLaneConflicts() const {
+    return _parent->GetMap().GetJunction(_id)->GetLaneConflicts();
+  }
+
 } // namespace client
 } // namespace carla
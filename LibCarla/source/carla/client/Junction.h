@@ -35,6 +35,11 @@ namespace client {
 
     geom::BoundingBox GetBoundingBox() const;
 
+    /// Lane pairs of this junction that geometrically cross, with the s
+    /// coordinate of the conflict point along each lane. Precomputed at
+    /// map build time.
+    std::vector<road::Junction::LaneConflict> GetLaneConflicts() const;
+
   private:
 
     friend class Map;
@@ -220,6 +220,7 @@ void LightManager::SetActive(LightId id, bool active) {
   LightState& state = const_cast<LightState&>(RetrieveLightState(id));
   state._active = active;
   _lights_changes[id] = state;
+  _lights_changed_fields[id] |= rpc::LightStateDelta::ActiveField;
   _dirty = true;
 }
 
@@ -228,6 +229,7 @@ void LightManager::SetColor(LightId id, Color color) {
   LightState& state = const_cast<LightState&>(RetrieveLightState(id));
   state._color = color;
   _lights_changes[id] = state;
+  _lights_changed_fields[id] |= rpc::LightStateDelta::ColorField;
   _dirty = true;
 }
 
@@ -236,6 +238,7 @@ void LightManager::SetIntensity(LightId id, float intensity) {
   LightState& state = const_cast<LightState&>(RetrieveLightState(id));
   state._intensity = intensity;
   _lights_changes[id] = state;
+  _lights_changed_fields[id] |= rpc::LightStateDelta::IntensityField;
   _dirty = true;
 }
 
@@ -244,6 +247,7 @@ void LightManager::SetLightState(LightId id, const LightState& new_state) {
   LightState& state = const_cast<LightState&>(RetrieveLightState(id));
   state = new_state;
   _lights_changes[id] = state;
+  _lights_changed_fields[id] = rpc::LightStateDelta::AllFields;
   _dirty = true;
 }
 
@@ -252,6 +256,7 @@ void LightManager::SetLightGroup(LightId id, LightGroup group) {
   LightState& state = const_cast<LightState&>(RetrieveLightState(id));
   state._group = group;
   _lights_changes[id] = state;
+  _lights_changed_fields[id] |= rpc::LightStateDelta::GroupField;
   _dirty = true;
 }
 
@@ -266,7 +271,8 @@ const LightState& LightManager::RetrieveLightState(LightId id) const {
 
 void LightManager::QueryLightsStateToServer() {
   std::lock_guard<std::mutex> lock(_mutex);
-  // Send blocking query
+  // Send blocking query, the server only returns the lights that changed
+  // since our last query (all of them the first time).
   std::vector<rpc::LightState> lights_snapshot = _episode.Lock()->QueryLightsStateToServer();
 
   // Update lights
@@ -291,35 +297,61 @@ void LightManager::UpdateServerLightsState(bool discard_client) {
   std::lock_guard<std::mutex> lock(_mutex);
 
   if(_dirty) {
-    std::vector<rpc::LightState> message;
+    std::vector<rpc::LightStateDelta> message;
+    message.reserve(_lights_changes.size());
     for(auto it : _lights_changes) {
       auto it_light = _lights.find(it.first);
       if(it_light != _lights.end()) {
-        rpc::LightState state(
-          it_light->second.GetLocation(),
-          it.second._intensity,
-          it.second._group,
-          rpc::Color(it.second._color.r, it.second._color.g, it.second._color.b),
-          it.second._active
-        );
-        state._id = it.first;
+        rpc::LightStateDelta delta;
+        delta._id = it.first;
+        delta._fields = GetChangedFields(it.first);
+        delta._intensity = it.second._intensity;
+        delta._group = static_cast<rpc::LightState::flag_type>(it.second._group);
+        delta._color = rpc::Color(it.second._color.r, it.second._color.g, it.second._color.b);
+        delta._active = it.second._active;
         // Add to command
-        message.push_back(state);
+        message.push_back(delta);
       }
     }
     _episode.Lock()->UpdateServerLightsState(message, discard_client);
 
     _lights_changes.clear();
+    _lights_changed_fields.clear();
     _dirty = false;
   }
 }
 
 void LightManager::ApplyChanges() {
   std::lock_guard<std::mutex> lock(_mutex);
+  // Re-apply the pending local changes on top of what the query brought in,
+  // field by field so untouched fields keep the server values. The changes
+  // stay pending, the next tick still has to send them.
   for(const auto& it : _lights_changes) {
-    SetLightState(it.first, it.second);
+    auto it_state = _lights_state.find(it.first);
+    if(it_state == _lights_state.end()) {
+      continue;
+    }
+    const auto fields = GetChangedFields(it.first);
+    if(fields & rpc::LightStateDelta::IntensityField) {
+      it_state->second._intensity = it.second._intensity;
+    }
+    if(fields & rpc::LightStateDelta::ColorField) {
+      it_state->second._color = it.second._color;
+    }
+    if(fields & rpc::LightStateDelta::GroupField) {
+      it_state->second._group = it.second._group;
+    }
+    if(fields & rpc::LightStateDelta::ActiveField) {
+      it_state->second._active = it.second._active;
+    }
   }
 }
 
+rpc::LightStateDelta::flag_type LightManager::GetChangedFields(LightId id) const {
+  auto it = _lights_changed_fields.find(id);
+  return it != _lights_changed_fields.end() ? it->second
+      : static_cast<rpc::LightStateDelta::flag_type>(rpc::LightStateDelta::AllFields);
+}
+
 } // namespace client
 } // namespace carla
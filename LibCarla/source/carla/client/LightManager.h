@@ -36,6 +36,7 @@ public:
   LightManager(const LightManager& other) : EnableSharedFromThis<LightManager>() {
     _lights_state = other._lights_state;
     _lights_changes = other._lights_changes;
+    _lights_changed_fields = other._lights_changed_fields;
     _lights = other._lights;
     _episode = other._episode;
     _on_tick_register_id = other._on_tick_register_id;
@@ -92,8 +93,13 @@ private:
   void UpdateServerLightsState(bool discard_client = false);
   void ApplyChanges();
 
+  /// Mask of the fields of @a id touched since the last update was sent,
+  /// AllFields when the light is not tracked. Callers must hold _mutex.
+  rpc::LightStateDelta::flag_type GetChangedFields(LightId id) const;
+
   std::unordered_map<LightId, LightState> _lights_state;
   std::unordered_map<LightId, LightState> _lights_changes;
+  std::unordered_map<LightId, rpc::LightStateDelta::flag_type> _lights_changed_fields;
   std::unordered_map<LightId, Light> _lights;
 
   detail::EpisodeProxy _episode;
@@ -6,23 +6,67 @@
 
 #include "carla/client/Map.h"
 
+#include "carla/FileSystem.h"
+#include "carla/Logging.h"
 #include "carla/client/Junction.h"
 #include "carla/client/Waypoint.h"
+#include "carla/client/detail/MapDataCache.h"
 #include "carla/opendrive/OpenDriveParser.h"
 #include "carla/road/Map.h"
+#include "carla/road/MapSerializer.h"
 #include "carla/road/RoadTypes.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <queue>
 #include <sstream>
 
 namespace carla {
 namespace client {
 
-  static auto MakeMap(const std::string &opendrive_contents) {
-    auto stream = std::istringstream(opendrive_contents);
-    auto map = opendrive::OpenDriveParser::Load(stream.str());
+  static road::Map MakeMap(const std::string &opendrive_contents) {
+    const auto hash = road::MapSerializer::Hash(opendrive_contents);
+    const auto cache_path = detail::MapDataCache::GetPath(hash, ".bin");
+
+    // Loading the cached binary form skips the XML parse and the map build,
+    // which dominate the start-up time of short-lived clients.
+    if (!cache_path.empty()) {
+      MappedFile file;
+      if (file.Open(cache_path)) {
+        try {
+          MemoryStream stream(file);
+          auto cached = road::MapSerializer::Deserialize(stream, hash);
+          if (cached.has_value()) {
+            return std::move(*cached);
+          }
+        } catch (const std::exception &e) {
+          log_warning("map cache: ignoring", cache_path, ":", e.what());
+        }
+      }
+    }
+
+    auto map = opendrive::OpenDriveParser::Load(opendrive_contents);
     if (!map.has_value()) {
       throw_exception(std::runtime_error("failed to generate map"));
     }
+
+    if (!cache_path.empty()) {
+      // Write to a temporary and rename so a concurrent client never sees a
+      // partially written cache file.
+      const auto tmp_path = cache_path + ".tmp";
+      std::ofstream file(tmp_path, std::ios_base::binary | std::ios_base::trunc);
+      if (file) {
+        road::MapSerializer::Serialize(*map, file, hash);
+        file.close();
+        if (!file || (std::rename(tmp_path.c_str(), cache_path.c_str()) != 0)) {
+          std::remove(tmp_path.c_str());
+        }
+      }
+    }
     return std::move(*map);
   }
 
@@ -79,7 +123,7 @@ namespace client {
     };
 
     TopologyList result;
-    auto topology = _map.GenerateTopology();
+    const auto &topology = GetQueryCache().topology;
     result.reserve(topology.size());
     for (const auto &pair : topology) {
       result.emplace_back(
@@ -99,6 +143,22 @@ namespace client {
     return result;
   }
 
+  std::vector<road::RoadId> Map::GetRoadIds() const {
+    return _map.GetRoadIds();
+  }
+
+  std::vector<SharedPtr<Waypoint>> Map::GenerateRoadWaypoints(
+      road::RoadId road_id,
+      double distance) const {
+    std::vector<SharedPtr<Waypoint>> result;
+    const auto waypoints = _map.GenerateRoadWaypoints(road_id, distance);
+    result.reserve(waypoints.size());
+    for (const auto &waypoint : waypoints) {
+      result.emplace_back(SharedPtr<Waypoint>(new Waypoint{shared_from_this(), waypoint}));
+    }
+    return result;
+  }
+
   std::vector<road::element::LaneMarking> Map::CalculateCrossedLanes(
   const geom::Location &origin,
   const geom::Location &destination) const {
@@ -132,40 +192,214 @@ namespace client {
     return result;
   }
 
-  std::vector<SharedPtr<Landmark>> Map::GetAllLandmarks() const {
-    std::vector<SharedPtr<Landmark>> result;
-    auto signal_references = _map.GetAllSignalReferences();
-    for(auto* signal_reference : signal_references) {
-      result.emplace_back(
-          new Landmark(nullptr, shared_from_this(), signal_reference, 0));
+  /// Bucket of a signal index, empty when the key is unknown.
+  static const std::vector<const road::element::RoadInfoSignal *> &FindBucket(
+      const std::unordered_map<std::string, std::vector<const road::element::RoadInfoSignal *>> &index,
+      const std::string &key) {
+    static const std::vector<const road::element::RoadInfoSignal *> empty;
+    auto it = index.find(key);
+    return it != index.end() ? it->second : empty;
+  }
+
+  template <typename T>
+  static ListView<const T *> MakeSpan(const std::vector<T> &v) {
+    return MakeListView(v.data(), v.data() + v.size());
+  }
+
+  const Map::QueryCache &Map::GetQueryCache() const {
+    std::lock_guard<std::mutex> lock(_cache_mutex);
+    if (_cache == nullptr) {
+      auto cache = std::make_unique<QueryCache>();
+      cache->all_signals = _map.GetAllSignalReferences();
+      for (auto *signal_reference : cache->all_signals) {
+        cache->signals_by_id[signal_reference->GetSignalId()].emplace_back(signal_reference);
+        cache->signals_by_type[signal_reference->GetSignal()->GetType()].emplace_back(signal_reference);
+      }
+      cache->topology = _map.GenerateTopology();
+
+      // Index the topology as a CSR lane graph so route queries walk
+      // contiguous arrays instead of re-deriving successors on demand.
+      std::unordered_map<road::element::Waypoint, uint32_t> index_of;
+      index_of.reserve(2u * cache->topology.size());
+      auto node_index = [&](const road::element::Waypoint &waypoint) {
+        auto it = index_of.find(waypoint);
+        if (it == index_of.end()) {
+          it = index_of.emplace(
+              waypoint,
+              static_cast<uint32_t>(cache->graph_nodes.size())).first;
+          cache->graph_nodes.emplace_back(waypoint);
+        }
+        return it->second;
+      };
+      for (const auto &edge : cache->topology) {
+        node_index(edge.first);
+        node_index(edge.second);
+      }
+      cache->graph_offsets.assign(cache->graph_nodes.size() + 1u, 0u);
+      for (const auto &edge : cache->topology) {
+        ++cache->graph_offsets[node_index(edge.first) + 1u];
+      }
+      for (auto i = 1u; i < cache->graph_offsets.size(); ++i) {
+        cache->graph_offsets[i] += cache->graph_offsets[i - 1u];
+      }
+      cache->graph_edges.resize(cache->topology.size());
+      cache->graph_costs.resize(cache->topology.size());
+      auto cursor = cache->graph_offsets;
+      for (const auto &edge : cache->topology) {
+        const auto slot = cursor[node_index(edge.first)]++;
+        cache->graph_edges[slot] = node_index(edge.second);
+        cache->graph_costs[slot] = static_cast<float>(
+            _map.ComputeTransform(edge.first).location.Distance(
+                _map.ComputeTransform(edge.second).location));
+      }
+
+      _cache = std::move(cache);
     }
-    return result;
+    return *_cache;
   }
 
-  std::vector<SharedPtr<Landmark>> Map::GetLandmarksFromId(std::string id) const {
-    std::vector<SharedPtr<Landmark>> result;
-    auto signal_references = _map.GetAllSignalReferences();
-    for(auto* signal_reference : signal_references) {
-      if(signal_reference->GetSignalId() == id) {
-        result.emplace_back(
-            new Landmark(nullptr, shared_from_this(), signal_reference, 0));
+  /// Graph node of the lane containing @a waypoint, negative when the lane
+  /// has no entry in the topology.
+  static int64_t FindLaneNode(
+      const std::vector<road::element::Waypoint> &nodes,
+      const road::element::Waypoint &waypoint) {
+    for (auto i = 0u; i < nodes.size(); ++i) {
+      const auto &node = nodes[i];
+      if ((node.road_id == waypoint.road_id) &&
+          (node.section_id == waypoint.section_id) &&
+          (node.lane_id == waypoint.lane_id)) {
+        return static_cast<int64_t>(i);
       }
     }
+    return -1;
+  }
+
+  std::vector<uint32_t> Map::FindShortestNodePath(
+      const geom::Location &origin,
+      const geom::Location &destination,
+      double &length) const {
+    length = -1.0;
+    const auto origin_waypoint = _map.GetClosestWaypointOnRoad(origin);
+    const auto destination_waypoint = _map.GetClosestWaypointOnRoad(destination);
+    if (!origin_waypoint.has_value() || !destination_waypoint.has_value()) {
+      return {};
+    }
+    const auto &cache = GetQueryCache();
+    const auto source = FindLaneNode(cache.graph_nodes, *origin_waypoint);
+    const auto target = FindLaneNode(cache.graph_nodes, *destination_waypoint);
+    if ((source < 0) || (target < 0)) {
+      return {};
+    }
+
+    // Dijkstra over the CSR adjacency.
+    constexpr auto unreached = std::numeric_limits<double>::infinity();
+    constexpr auto no_parent = std::numeric_limits<uint32_t>::max();
+    std::vector<double> distance(cache.graph_nodes.size(), unreached);
+    std::vector<uint32_t> parent(cache.graph_nodes.size(), no_parent);
+    using QueueEntry = std::pair<double, uint32_t>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    distance[static_cast<size_t>(source)] = 0.0;
+    queue.emplace(0.0, static_cast<uint32_t>(source));
+    while (!queue.empty()) {
+      const auto entry = queue.top();
+      queue.pop();
+      if (entry.second == static_cast<uint32_t>(target)) {
+        break;
+      }
+      if (entry.first > distance[entry.second]) {
+        continue; // stale queue entry
+      }
+      for (auto i = cache.graph_offsets[entry.second];
+          i < cache.graph_offsets[entry.second + 1u]; ++i) {
+        const auto next = cache.graph_edges[i];
+        const auto next_distance = entry.first + cache.graph_costs[i];
+        if (next_distance < distance[next]) {
+          distance[next] = next_distance;
+          parent[next] = entry.second;
+          queue.emplace(next_distance, next);
+        }
+      }
+    }
+
+    if (distance[static_cast<size_t>(target)] == unreached) {
+      return {};
+    }
+    length = distance[static_cast<size_t>(target)];
+    std::vector<uint32_t> path;
+    for (auto node = static_cast<uint32_t>(target);; node = parent[node]) {
+      path.emplace_back(node);
+      if (node == static_cast<uint32_t>(source)) {
+        break;
+      }
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+  }
+
+  std::vector<SharedPtr<Waypoint>> Map::GetShortestRoute(
+      const geom::Location &origin,
+      const geom::Location &destination) const {
+    double length = -1.0;
+    const auto path = FindShortestNodePath(origin, destination, length);
+    const auto &nodes = GetQueryCache().graph_nodes;
+    std::vector<SharedPtr<Waypoint>> result;
+    result.reserve(path.size());
+    for (const auto node : path) {
+      result.emplace_back(SharedPtr<Waypoint>(new Waypoint{shared_from_this(), nodes[node]}));
+    }
     return result;
   }
 
-  std::vector<SharedPtr<Landmark>> Map::GetAllLandmarksOfType(std::string type) const {
+  double Map::GetRouteDistance(
+      const geom::Location &origin,
+      const geom::Location &destination) const {
+    double length = -1.0;
+    FindShortestNodePath(origin, destination, length);
+    return length;
+  }
+
+  std::vector<SharedPtr<Landmark>> Map::MakeLandmarks(
+      const std::vector<const road::element::RoadInfoSignal *> &signals) const {
     std::vector<SharedPtr<Landmark>> result;
-    auto signal_references = _map.GetAllSignalReferences();
-    for(auto* signal_reference : signal_references) {
-      if(signal_reference->GetSignal()->GetType() == type) {
-        result.emplace_back(
-            new Landmark(nullptr, shared_from_this(), signal_reference, 0));
-      }
+    result.reserve(signals.size());
+    for (auto *signal_reference : signals) {
+      result.emplace_back(
+          new Landmark(nullptr, shared_from_this(), signal_reference, 0));
     }
     return result;
   }
 
+  std::vector<SharedPtr<Landmark>> Map::GetAllLandmarks() const {
+    return MakeLandmarks(GetQueryCache().all_signals);
+  }
+
+  std::vector<SharedPtr<Landmark>> Map::GetLandmarksFromId(std::string id) const {
+    return MakeLandmarks(FindBucket(GetQueryCache().signals_by_id, id));
+  }
+
+  std::vector<SharedPtr<Landmark>> Map::GetAllLandmarksOfType(std::string type) const {
+    return MakeLandmarks(FindBucket(GetQueryCache().signals_by_type, type));
+  }
+
+  ListView<const road::element::RoadInfoSignal * const *> Map::GetSignalReferences() const {
+    return MakeSpan(GetQueryCache().all_signals);
+  }
+
+  ListView<const road::element::RoadInfoSignal * const *> Map::GetSignalReferencesFromId(
+      const std::string &id) const {
+    return MakeSpan(FindBucket(GetQueryCache().signals_by_id, id));
+  }
+
+  ListView<const road::element::RoadInfoSignal * const *> Map::GetSignalReferencesOfType(
+      const std::string &type) const {
+    return MakeSpan(FindBucket(GetQueryCache().signals_by_type, type));
+  }
+
+  ListView<const std::pair<road::element::Waypoint, road::element::Waypoint> *>
+      Map::GetTopologyEdges() const {
+    return MakeSpan(GetQueryCache().topology);
+  }
+
   std::vector<SharedPtr<Landmark>>
       Map::GetLandmarkGroup(const Landmark &landmark) const {
     std::vector<SharedPtr<Landmark>> result;
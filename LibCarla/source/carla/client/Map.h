@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "carla/ListView.h"
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
 #include "carla/road/element/LaneMarking.h"
@@ -15,7 +16,12 @@
 #include "carla/rpc/MapInfo.h"
 #include "Landmark.h"
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace carla {
 namespace geom { class GeoLocation; }
@@ -67,6 +73,14 @@ namespace client {
 
     std::vector<SharedPtr<Waypoint>> GenerateWaypoints(double distance) const;
 
+    /// Ids of every road of the map, useful together with
+    /// GenerateRoadWaypoints to stream the waypoints road by road instead of
+    /// materializing the whole map at once.
+    std::vector<road::RoadId> GetRoadIds() const;
+
+    /// Waypoints of a single road separated by @a distance.
+    std::vector<SharedPtr<Waypoint>> GenerateRoadWaypoints(road::RoadId road_id, double distance) const;
+
     std::vector<road::element::LaneMarking> CalculateCrossedLanes(
         const geom::Location &origin,
         const geom::Location &destination) const;
@@ -94,11 +108,88 @@ namespace client {
     /// Returns all the landmarks in the same group including this one
     std::vector<SharedPtr<Landmark>> GetLandmarkGroup(const Landmark &landmark) const;
 
+    /// @name Cached road queries
+    ///
+    /// The map is immutable for the whole episode, so the signal references
+    /// and the topology are indexed once on first use and shared by every
+    /// query afterwards. The spans point into that shared storage and stay
+    /// valid as long as the map is alive.
+    /// @{
+
+    /// Span over every signal reference of the map.
+    ListView<const road::element::RoadInfoSignal * const *> GetSignalReferences() const;
+
+    /// Span over the signal references with OpenDRIVE id @a id.
+    ListView<const road::element::RoadInfoSignal * const *> GetSignalReferencesFromId(
+        const std::string &id) const;
+
+    /// Span over the signal references of type @a type.
+    ListView<const road::element::RoadInfoSignal * const *> GetSignalReferencesOfType(
+        const std::string &type) const;
+
+    /// Span over the topology edges of the map, pairs of road waypoints at
+    /// the entrance and exit of each drivable lane.
+    ListView<const std::pair<road::element::Waypoint, road::element::Waypoint> *>
+        GetTopologyEdges() const;
+
+    /// Shortest route over the lane graph from the lane of @a origin to the
+    /// lane of @a destination, as the sequence of lane-entry waypoints a
+    /// vehicle would traverse. Empty when either location cannot be
+    /// projected onto a drivable lane or no route exists.
+    std::vector<SharedPtr<Waypoint>> GetShortestRoute(
+        const geom::Location &origin,
+        const geom::Location &destination) const;
+
+    /// Length in meters of the route GetShortestRoute would return, or a
+    /// negative value when there is none.
+    double GetRouteDistance(
+        const geom::Location &origin,
+        const geom::Location &destination) const;
+
+    /// @}
+
   private:
 
+    /// Landmark and topology indexes built lazily on first use, the road map
+    /// never changes once loaded. Only road-layer data is cached here;
+    /// caching client objects would create an ownership cycle through their
+    /// parent map pointer.
+    struct QueryCache {
+      std::vector<const road::element::RoadInfoSignal *> all_signals;
+      std::unordered_map<std::string, std::vector<const road::element::RoadInfoSignal *>> signals_by_id;
+      std::unordered_map<std::string, std::vector<const road::element::RoadInfoSignal *>> signals_by_type;
+      std::vector<std::pair<road::element::Waypoint, road::element::Waypoint>> topology;
+
+      /// The topology as a lane graph in compressed sparse row form: the
+      /// targets of node i are graph_edges[graph_offsets[i],
+      /// graph_offsets[i + 1]), one per drivable successor lane, with the
+      /// matching edge length in graph_costs.
+      std::vector<road::element::Waypoint> graph_nodes;
+      std::vector<uint32_t> graph_offsets;
+      std::vector<uint32_t> graph_edges;
+      std::vector<float> graph_costs;
+    };
+
+    const QueryCache &GetQueryCache() const;
+
+    /// Dijkstra over the cached lane graph from the lane of @a origin to
+    /// the lane of @a destination; returns the node index sequence and
+    /// writes the route length to @a length, empty when unreachable.
+    std::vector<uint32_t> FindShortestNodePath(
+        const geom::Location &origin,
+        const geom::Location &destination,
+        double &length) const;
+
+    std::vector<SharedPtr<Landmark>> MakeLandmarks(
+        const std::vector<const road::element::RoadInfoSignal *> &signals) const;
+
     const rpc::MapInfo _description;
 
     const road::Map _map;
+
+    mutable std::mutex _cache_mutex;
+
+    mutable std::unique_ptr<const QueryCache> _cache;
   };
 
 } // namespace client
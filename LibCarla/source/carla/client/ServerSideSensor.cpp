@@ -34,6 +34,20 @@ namespace client {
 
   void ServerSideSensor::Listen(CallbackFunctionType callback) {
     log_debug(GetDisplayId(), ": subscribing to stream");
+    if (_queue_enabled) {
+      // route the measurements through the queue, the worker thread invokes
+      // the user callback so it cannot back up the streaming thread
+      _callback_queue = std::make_shared<detail::SensorCallbackQueue>(
+          std::move(callback),
+          _queue_policy,
+          _queue_depth);
+      auto queue = _callback_queue;
+      callback = [queue](SharedPtr<sensor::SensorData> data) {
+        queue->Push(std::move(data));
+      };
+    } else {
+      _callback_queue = nullptr;
+    }
     GetEpisode().Lock()->SubscribeToSensor(*this, std::move(callback));
     _is_listening = true;
   }
@@ -47,6 +61,12 @@ namespace client {
     }
     GetEpisode().Lock()->UnSubscribeFromSensor(*this);
     _is_listening = false;
+    if (_callback_queue != nullptr) {
+      // delivers what is already queued; pushes still in flight from the
+      // subscription are ignored
+      _callback_queue->Stop();
+      _callback_queue = nullptr;
+    }
   }
 
   bool ServerSideSensor::Destroy() {
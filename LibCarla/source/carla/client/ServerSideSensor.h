@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/client/Sensor.h"
+#include "carla/client/detail/SensorCallbackQueue.h"
 
 namespace carla {
 namespace client {
@@ -36,6 +37,23 @@ namespace client {
       return _is_listening;
     }
 
+    /// Deliver measurements to the callback through a queue with the given
+    /// @a policy instead of invoking it inline on the streaming thread, so a
+    /// slow callback no longer backs up the stream. Takes effect on the next
+    /// Listen; @a max_queue_depth only applies to drop_oldest and block.
+    void SetCallbackQueue(SensorQueuePolicy policy, size_t max_queue_depth = 1u) {
+      _queue_enabled = true;
+      _queue_policy = policy;
+      _queue_depth = max_queue_depth;
+    }
+
+    /// Overrun statistics of the callback queue, all zeros while no queue is
+    /// active, see detail::SensorCallbackQueue::Stats.
+    detail::SensorCallbackQueue::Stats GetCallbackQueueStats() const {
+      auto queue = _callback_queue;
+      return queue != nullptr ? queue->GetStats() : detail::SensorCallbackQueue::Stats();
+    }
+
     /// @copydoc Actor::Destroy()
     ///
     /// Additionally stop listening.
@@ -44,6 +62,17 @@ namespace client {
   private:
 
     bool _is_listening = false;
+
+    /// Whether Listen routes the callback through a SensorCallbackQueue.
+    bool _queue_enabled = false;
+
+    SensorQueuePolicy _queue_policy = SensorQueuePolicy::keep_latest;
+
+    size_t _queue_depth = 1u;
+
+    /// Alive while listening with a queue enabled; the stream subscription
+    /// shares ownership until the unsubscription takes effect.
+    std::shared_ptr<detail::SensorCallbackQueue> _callback_queue;
   };
 
 } // namespace client
@@ -62,6 +62,63 @@ namespace client {
     }
   }
 
+  void WalkerAIController::StartFleet(
+      const std::vector<SharedPtr<WalkerAIController>> &controllers,
+      const std::vector<geom::Location> &destinations,
+      const std::vector<float> &max_speeds) {
+    if (controllers.empty()) {
+      return;
+    }
+    controllers.front()->GetEpisode().Lock()->RegisterAIControllerFleet(
+        controllers,
+        destinations,
+        max_speeds);
+  }
+
+  void WalkerAIController::GoToLocations(
+      const std::vector<std::pair<SharedPtr<WalkerAIController>, geom::Location>> &requests) {
+    if (requests.empty()) {
+      return;
+    }
+    auto nav = requests.front().first->GetEpisode().Lock()->GetNavigation();
+    if (nav == nullptr) {
+      return;
+    }
+    std::vector<std::pair<ActorId, geom::Location>> targets;
+    targets.reserve(requests.size());
+    for (const auto &request : requests) {
+      auto walker = request.first->GetParent();
+      if (walker == nullptr) {
+        log_warning("NAV: Failed to set request to go to ", request.second.x, request.second.y, request.second.z, "(parent does not exist)");
+        continue;
+      }
+      targets.emplace_back(walker->GetId(), request.second);
+    }
+    nav->SetWalkerTargets(targets);
+  }
+
+  void WalkerAIController::SetMaxSpeeds(
+      const std::vector<std::pair<SharedPtr<WalkerAIController>, float>> &requests) {
+    if (requests.empty()) {
+      return;
+    }
+    auto nav = requests.front().first->GetEpisode().Lock()->GetNavigation();
+    if (nav == nullptr) {
+      return;
+    }
+    std::vector<std::pair<ActorId, float>> speeds;
+    speeds.reserve(requests.size());
+    for (const auto &request : requests) {
+      auto walker = request.first->GetParent();
+      if (walker == nullptr) {
+        log_warning("NAV: failed to set max speed (parent does not exist)");
+        continue;
+      }
+      speeds.emplace_back(walker->GetId(), request.second);
+    }
+    nav->SetWalkerMaxSpeeds(speeds);
+  }
+
   void WalkerAIController::SetMaxSpeed(const float max_speed) {
     auto nav = GetEpisode().Lock()->GetNavigation();
     if (nav != nullptr) {
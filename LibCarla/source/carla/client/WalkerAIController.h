@@ -29,6 +29,28 @@ namespace client {
     void GoToLocation(const carla::geom::Location &destination);
 
     void SetMaxSpeed(const float max_speed);
+
+    /// @name Fleet-level control
+    ///
+    /// Same operations as above but over many controllers in one call; the
+    /// crowd is locked and the walker list copied once for the whole fleet
+    /// instead of once per walker.
+    /// @{
+
+    /// Start all @a controllers; @a destinations and @a max_speeds run
+    /// parallel to them and may be empty to leave the walkers idle.
+    static void StartFleet(
+        const std::vector<SharedPtr<WalkerAIController>> &controllers,
+        const std::vector<geom::Location> &destinations = {},
+        const std::vector<float> &max_speeds = {});
+
+    static void GoToLocations(
+        const std::vector<std::pair<SharedPtr<WalkerAIController>, geom::Location>> &requests);
+
+    static void SetMaxSpeeds(
+        const std::vector<std::pair<SharedPtr<WalkerAIController>, float>> &requests);
+
+    /// @}
   };
 
 } // namespace client
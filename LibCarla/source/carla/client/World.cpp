@@ -42,6 +42,10 @@ namespace client {
     return _episode.Lock()->SetEpisodeSettings(settings);
   }
 
+  void World::ApplyStreamFilter(const rpc::EpisodeStreamFilter &filter) {
+    _episode.Lock()->ApplyEpisodeStreamFilter(filter);
+  }
+
   rpc::WeatherParameters World::GetWeather() const {
     return _episode.Lock()->GetWeatherParameters();
   }
@@ -50,6 +54,10 @@ namespace client {
     _episode.Lock()->SetWeatherParameters(weather);
   }
 
+  void World::SetWeatherAnimation(const std::vector<rpc::WeatherKeyFrame> &keyframes) {
+    _episode.Lock()->SetWeatherAnimation(keyframes);
+  }
+
   WorldSnapshot World::GetSnapshot() const {
     return _episode.Lock()->GetWorldSnapshot();
   }
@@ -68,12 +76,29 @@ namespace client {
                                   _episode.Lock()->GetAllTheActorsInTheEpisode()}};
   }
 
+  void World::SetActorListSubscription(bool enabled) {
+    _episode.Lock()->SetActorListSubscription(enabled);
+  }
+
   SharedPtr<ActorList> World::GetActors(const std::vector<ActorId> &actor_ids) const {
     return SharedPtr<ActorList>{new ActorList{
                                   _episode,
                                   _episode.Lock()->GetActorsById(actor_ids)}};
   }
 
+  std::vector<rpc::TrafficLightSnapshot> World::GetTrafficLightStates() const {
+    return _episode.Lock()->GetTrafficLightSnapshots();
+  }
+
+  void World::SetTrafficLightStates(
+      const std::vector<std::pair<ActorId, rpc::TrafficLightState>> &states) {
+    _episode.Lock()->SetTrafficLightStates(states);
+  }
+
+  void World::PrewarmActors(const std::vector<std::string> &blueprint_ids) {
+    _episode.Lock()->PrewarmActors(blueprint_ids);
+  }
+
   SharedPtr<Actor> World::SpawnActor(
       const ActorBlueprint &blueprint,
       const geom::Transform &transform,
@@ -94,10 +119,32 @@ namespace client {
     }
   }
 
+  void World::SetSnapshotHistoryDepth(size_t depth) {
+    _episode.Lock()->SetStateHistoryDepth(depth);
+  }
+
+  size_t World::GetSnapshotHistoryDepth() const {
+    return _episode.Lock()->GetStateHistoryDepth();
+  }
+
+  std::vector<WorldSnapshot> World::GetSnapshotHistory(size_t max_frames) const {
+    return _episode.Lock()->GetStateHistory(max_frames);
+  }
+
+  std::vector<std::pair<uint64_t, ActorSnapshot>> World::GetActorSnapshotHistory(
+      ActorId actor_id,
+      size_t max_frames) const {
+    return _episode.Lock()->GetActorStateHistory(actor_id, max_frames);
+  }
+
   WorldSnapshot World::WaitForTick(time_duration timeout) const {
     return _episode.Lock()->WaitForTick(timeout);
   }
 
+  void World::SetWaitForTickSpinBudget(size_t micros) {
+    _episode.Lock()->SetWaitForTickSpinBudget(micros);
+  }
+
   size_t World::OnTick(std::function<void(WorldSnapshot)> callback) {
     return _episode.Lock()->RegisterOnTickEvent(std::move(callback));
   }
@@ -106,10 +153,30 @@ namespace client {
     _episode.Lock()->RemoveOnTickEvent(callback_id);
   }
 
+  void World::SetConcurrentTickCallbacks(size_t worker_threads) {
+    _episode.Lock()->SetConcurrentOnTickCallbacks(worker_threads);
+  }
+
+  void World::SetTickCallbackDeadline(time_duration deadline) {
+    _episode.Lock()->SetOnTickCallbackDeadline(deadline);
+  }
+
+  uint64_t World::GetTickCallbackOverruns() const {
+    return _episode.Lock()->GetOnTickCallbackOverruns();
+  }
+
   uint64_t World::Tick(time_duration timeout) {
     return _episode.Lock()->Tick(timeout);
   }
 
+  uint64_t World::BeginTick(double compute_budget_seconds) {
+    return _episode.Lock()->BeginTick(compute_budget_seconds);
+  }
+
+  uint64_t World::EndTick(uint64_t frame, time_duration timeout) {
+    return _episode.Lock()->EndTick(frame, timeout);
+  }
+
   void World::SetPedestriansCrossFactor(float percentage) {
     _episode.Lock()->SetPedestriansCrossFactor(percentage);
   }
@@ -18,11 +18,17 @@
 #include "carla/rpc/Actor.h"
 #include "carla/rpc/AttachmentType.h"
 #include "carla/rpc/EpisodeSettings.h"
+#include "carla/rpc/EpisodeStreamFilter.h"
+#include "carla/rpc/TrafficLightSnapshot.h"
 #include "carla/rpc/VehiclePhysicsControl.h"
+#include "carla/rpc/WeatherKeyFrame.h"
 #include "carla/rpc/WeatherParameters.h"
 
 #include <boost/optional.hpp>
 
+#include <utility>
+#include <vector>
+
 namespace carla {
 namespace client {
 
@@ -71,12 +77,26 @@ namespace client {
     /// @return The id of the frame when the settings were applied.
     uint64_t ApplySettings(const rpc::EpisodeSettings &settings);
 
+    /// Restrict the state updates this client receives to the actors and
+    /// rate selected by @a filter, e.g. a monitoring client can ask for a
+    /// few vehicles at a fraction of the simulation rate. Other clients are
+    /// unaffected. An empty filter only divides the rate.
+    void ApplyStreamFilter(const rpc::EpisodeStreamFilter &filter);
+
     /// Retrieve the weather parameters currently active in the world.
     rpc::WeatherParameters GetWeather() const;
 
     /// Change the weather in the simulation.
     void SetWeather(const rpc::WeatherParameters &weather);
 
+    /// Submit a keyframed weather animation applied server-side: the server
+    /// interpolates the weather between consecutive keyframes every frame,
+    /// so animating the weather does not need a steady stream of SetWeather
+    /// calls. Keyframe times are in seconds of simulated time relative to
+    /// this call. An empty list, or a later call to SetWeather, cancels a
+    /// running animation.
+    void SetWeatherAnimation(const std::vector<rpc::WeatherKeyFrame> &keyframes);
+
     /// Return a snapshot of the world at this moment.
     WorldSnapshot GetSnapshot() const;
 
@@ -86,9 +106,30 @@ namespace client {
     /// Return a list with all the actors currently present in the world.
     SharedPtr<ActorList> GetActors() const;
 
+    /// Maintain the actor list incrementally from the spawn and destroy
+    /// events of the simulation state stream, so that GetActors returns a
+    /// cached snapshot without a round trip to the simulator while the actor
+    /// set is unchanged.
+    void SetActorListSubscription(bool enabled);
+
     /// Return a list with the actors requested by ActorId.
     SharedPtr<ActorList> GetActors(const std::vector<ActorId> &actor_ids) const;
 
+    /// Return the state, timing and group of every traffic light in the
+    /// world in a single round trip. Lights of the same junction share a
+    /// group id.
+    std::vector<rpc::TrafficLightSnapshot> GetTrafficLightStates() const;
+
+    /// Set the state of several traffic lights with one call, entries whose
+    /// actor no longer exists are skipped.
+    void SetTrafficLightStates(
+        const std::vector<std::pair<ActorId, rpc::TrafficLightState>> &states);
+
+    /// Preload on the server the assets of the given blueprint ids and seed
+    /// its actor pool with one instance of each, so the first spawn of every
+    /// model does not hitch on asset loading. Blocks until done.
+    void PrewarmActors(const std::vector<std::string> &blueprint_ids);
+
     /// Spawn an actor into the world based on the @a blueprint provided at @a
     /// transform. If a @a parent is provided, the actor is attached to
     /// @a parent.
@@ -106,9 +147,36 @@ namespace client {
         Actor *parent = nullptr,
         rpc::AttachmentType attachment_type = rpc::AttachmentType::Rigid) noexcept;
 
+    /// Keep the last @a depth world snapshots reachable client-side for
+    /// windowed queries, see GetSnapshotHistory. The ring is preallocated
+    /// and filled as state updates arrive; zero (the default) disables the
+    /// history and releases the retained snapshots.
+    void SetSnapshotHistoryDepth(size_t depth);
+
+    size_t GetSnapshotHistoryDepth() const;
+
+    /// The most recent snapshots retained by the history, oldest first, at
+    /// most @a max_frames entries (all of them when zero).
+    std::vector<WorldSnapshot> GetSnapshotHistory(size_t max_frames = 0u) const;
+
+    /// Per-frame snapshots of actor @a actor_id paired with their frame
+    /// number, oldest first, over the most recent @a max_frames frames of
+    /// the history (all of them when zero). Frames in which the actor is
+    /// absent are skipped.
+    std::vector<std::pair<uint64_t, ActorSnapshot>> GetActorSnapshotHistory(
+        ActorId actor_id,
+        size_t max_frames = 0u) const;
+
     /// Block calling thread until a world tick is received.
     WorldSnapshot WaitForTick(time_duration timeout) const;
 
+    /// Busy-wait up to @a micros microseconds for the tick before parking on
+    /// a condition variable, shaving scheduler wakeup latency off WaitForTick
+    /// when stepping synchronous mode at high rates. The spin is skipped
+    /// while ticks keep arriving slower than the budget. Zero (the default)
+    /// always parks.
+    void SetWaitForTickSpinBudget(size_t micros);
+
     /// Register a @a callback to be called every time a world tick is received.
     ///
     /// @return ID of the callback, use it to remove the callback.
@@ -117,12 +185,38 @@ namespace client {
     /// Remove a callback registered with OnTick.
     void RemoveOnTick(size_t callback_id);
 
+    /// Run the callbacks registered with OnTick on a pool of
+    /// @a worker_threads threads instead of sequentially on the streaming
+    /// thread. Invocations of each callback keep their order, but a slow
+    /// callback no longer delays snapshot delivery to the others. Zero
+    /// threads restores sequential delivery.
+    void SetConcurrentTickCallbacks(size_t worker_threads);
+
+    /// Count OnTick callback invocations taking longer than @a deadline,
+    /// see GetTickCallbackOverruns. A zero deadline disables the counting.
+    void SetTickCallbackDeadline(time_duration deadline);
+
+    /// Number of OnTick callback invocations that exceeded the deadline set
+    /// with SetTickCallbackDeadline.
+    uint64_t GetTickCallbackOverruns() const;
+
     /// Signal the simulator to continue to next tick (only has effect on
     /// synchronous mode).
     ///
     /// @return The id of the frame that this call started.
     uint64_t Tick(time_duration timeout);
 
+    /// Co-simulation stepping: signal the simulator to start the next frame
+    /// and return immediately with its id, so the caller can compute its
+    /// own simulation step concurrently and rendezvous with EndTick.
+    /// @a compute_budget_seconds declares for how long the caller expects
+    /// to compute before coming back, letting the simulator schedule the
+    /// concurrent window. Only has effect on synchronous mode.
+    uint64_t BeginTick(double compute_budget_seconds = 0.0);
+
+    /// Block until the frame previously initiated by BeginTick completes.
+    uint64_t EndTick(uint64_t frame, time_duration timeout);
+
     /// set the probability that an agent could cross the roads in its path following
     /// percentage of 0.0f means no pedestrian can cross roads
     /// percentage of 0.5f means 50% of all pedestrians can cross roads
@@ -50,6 +50,36 @@ namespace client {
       return _state->size();
     }
 
+    /// @name Bulk access to the snapshot storage
+    ///
+    /// Spans over the contiguous per-field arrays of the snapshot, indexed
+    /// consistently: entry @a i of every span belongs to the actor with id
+    /// GetIds()[i]. Much cheaper than one Find per actor when scanning the
+    /// whole snapshot every tick.
+    /// @{
+
+    auto GetIds() const {
+      return _state->GetActorIds();
+    }
+
+    auto GetTransforms() const {
+      return _state->GetTransforms();
+    }
+
+    auto GetVelocities() const {
+      return _state->GetVelocities();
+    }
+
+    auto GetAngularVelocities() const {
+      return _state->GetAngularVelocities();
+    }
+
+    auto GetAccelerations() const {
+      return _state->GetAccelerations();
+    }
+
+    /// @}
+
     /// Return a begin iterator to the list of ActorSnapshots.
     auto begin() const {
       return _state->begin();
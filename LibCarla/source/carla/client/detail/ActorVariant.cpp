@@ -6,7 +6,9 @@
 
 #include "carla/client/detail/ActorVariant.h"
 
+#include "carla/Logging.h"
 #include "carla/client/detail/ActorFactory.h"
+#include "carla/client/detail/Simulator.h"
 #include "carla/client/ActorList.h"
 
 namespace carla {
@@ -14,6 +16,21 @@ namespace client {
 namespace detail {
 
   void ActorVariant::MakeActor(EpisodeProxy episode) const {
+    if (_value.which() == 0u) {
+      // Id-only reference, pull the full description from the episode's
+      // actor cache; fall back to a bare description if the actor is
+      // already gone.
+      const auto id = boost::get<ActorId>(_value);
+      auto actor = episode.Lock()->GetActorById(id);
+      if (actor.has_value()) {
+        _value = std::move(*actor);
+      } else {
+        log_warning("actor", id, "not found in episode");
+        rpc::Actor bare;
+        bare.id = id;
+        _value = std::move(bare);
+      }
+    }
     _value = detail::ActorFactory::MakeActor(
         episode,
         boost::get<rpc::Actor>(std::move(_value)),
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/Debug.h"
+#include "carla/Exception.h"
 #include "carla/Memory.h"
 #include "carla/client/Actor.h"
 #include "carla/client/detail/EpisodeProxy.h"
@@ -14,6 +15,8 @@
 
 #include <boost/variant.hpp>
 
+#include <stdexcept>
+
 namespace carla {
 namespace client {
 namespace detail {
@@ -22,6 +25,11 @@ namespace detail {
   class ActorVariant {
   public:
 
+    /// Reference the actor by id only; the description is pulled from the
+    /// episode's actor cache the first time the actor is instantiated.
+    explicit ActorVariant(ActorId id)
+      : _value(id) {}
+
     ActorVariant(rpc::Actor actor)
       : _value(actor) {}
 
@@ -39,18 +47,28 @@ namespace detail {
     }
 
     SharedPtr<client::Actor> Get(EpisodeProxy episode) const {
-      if (_value.which() == 0u) {
+      if (_value.which() != 2u) {
         MakeActor(episode);
       }
-      DEBUG_ASSERT(_value.which() == 1u);
+      DEBUG_ASSERT(_value.which() == 2u);
       return boost::get<SharedPtr<client::Actor>>(_value);
     }
 
+    /// @note On an id-only reference that has not been instantiated yet this
+    /// returns a bare description holding just the id.
     const rpc::Actor &Serialize() const {
+      if (_value.which() == 0u) {
+        rpc::Actor actor;
+        actor.id = boost::get<ActorId>(_value);
+        _value = std::move(actor);
+      }
       return boost::apply_visitor(Visitor(), _value);
     }
 
     ActorId GetId() const {
+      if (_value.which() == 0u) {
+        return boost::get<ActorId>(_value);
+      }
       return Serialize().id;
     }
 
@@ -73,6 +91,11 @@ namespace detail {
   private:
 
     struct Visitor {
+      [[noreturn]] const rpc::Actor &operator()(ActorId) const {
+        // Serialize() materializes a description before visiting, ids
+        // never reach this point.
+        throw_exception(std::runtime_error("unexpected id-only actor"));
+      }
       const rpc::Actor &operator()(const rpc::Actor &actor) const {
         return actor;
       }
@@ -83,7 +106,7 @@ namespace detail {
 
     void MakeActor(EpisodeProxy episode) const;
 
-    mutable boost::variant<rpc::Actor, SharedPtr<client::Actor>> _value;
+    mutable boost::variant<ActorId, rpc::Actor, SharedPtr<client::Actor>> _value;
   };
 
 } // namespace detail
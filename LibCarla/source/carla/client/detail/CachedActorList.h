@@ -26,13 +26,17 @@ namespace detail {
   /// Keeps a list of actor descriptions to avoid requesting each time the
   /// descriptions to the server.
   ///
-  /// @todo Dead actors are never removed from the list.
+  /// @todo Dead actors are only removed from the list while the episode keeps
+  /// the actor-list subscription active.
   class CachedActorList : private MovableNonCopyable {
   public:
 
     /// Inserts an actor into the list.
     void Insert(rpc::Actor actor);
 
+    /// Remove the actor matching @a id from the list, if present.
+    void Remove(ActorId id);
+
     /// Inserts a @a range containing actors.
     template <typename RangeT>
     void InsertRange(RangeT range);
@@ -69,6 +73,11 @@ namespace detail {
     _actors.emplace(id, std::move(actor));
   }
 
+  inline void CachedActorList::Remove(ActorId id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _actors.erase(id);
+  }
+
   template <typename RangeT>
   inline void CachedActorList::InsertRange(RangeT range) {
     auto make_a_pair = [](rpc::Actor actor) {
@@ -6,11 +6,21 @@
 
 #pragma once
 
-#include "carla/AtomicList.h"
+#include "carla/AtomicSharedPtr.h"
+#include "carla/EpochList.h"
 #include "carla/NonCopyable.h"
+#include "carla/StopWatch.h"
+#include "carla/ThreadPool.h"
+#include "carla/Time.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/io_context_strand.hpp>
 
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace carla {
 namespace client {
@@ -23,9 +33,19 @@ namespace detail {
     using CallbackType = std::function<void(InputsT...)>;
 
     void Call(InputsT... args) const {
-      auto list = _list.Load();
-      for (auto &item : *list) {
-        item.callback(args...);
+      auto pool = _pool.load();
+      const auto list = _list.Load();
+      for (const auto &item : list) {
+        if (pool == nullptr) {
+          Invoke(_stats, item.callback, args...);
+        } else {
+          // Posting through the callback's strand keeps the invocations of
+          // one callback ordered while different callbacks run concurrently.
+          auto strand = GetStrand(item.id, *pool);
+          strand->post([stats = _stats, callback = item.callback, args...]() {
+            Invoke(stats, callback, args...);
+          });
+        }
       }
     }
 
@@ -38,14 +58,42 @@ namespace detail {
 
     void Remove(size_t id) {
       _list.DeleteByValue(id);
+      std::lock_guard<std::mutex> lock(_strand_mutex);
+      _strands.erase(id);
     }
 
     void Clear() {
       _list.Clear();
+      std::lock_guard<std::mutex> lock(_strand_mutex);
+      _strands.clear();
+    }
+
+    /// Run the callbacks of this list on @a pool from now on instead of on
+    /// the calling thread, so a slow callback does not delay the rest. A
+    /// null pool restores sequential in-caller execution.
+    void SetExecutor(std::shared_ptr<ThreadPool> pool) {
+      {
+        std::lock_guard<std::mutex> lock(_strand_mutex);
+        _strands.clear();
+      }
+      _pool = std::move(pool);
+    }
+
+    /// Count the invocations taking longer than @a deadline from now on,
+    /// see GetOverrunCount. A zero deadline disables the counting.
+    void SetDeadline(time_duration deadline) {
+      _stats->deadline_micros = 1000u * static_cast<uint64_t>(deadline.milliseconds());
+    }
+
+    /// Number of invocations that exceeded the deadline since it was set.
+    uint64_t GetOverrunCount() const {
+      return _stats->overruns;
     }
 
   private:
 
+    using Strand = boost::asio::io_context::strand;
+
     struct Item {
       size_t id;
       CallbackType callback;
@@ -63,9 +111,46 @@ namespace detail {
       }
     };
 
+    /// Shared by value with the posted tasks so they outlive this list.
+    struct Stats {
+      std::atomic<uint64_t> deadline_micros{0u};
+      std::atomic<uint64_t> overruns{0u};
+    };
+
+    static void Invoke(
+        const std::shared_ptr<Stats> &stats,
+        const CallbackType &callback,
+        InputsT... args) {
+      StopWatch stop_watch;
+      callback(args...);
+      stop_watch.Stop();
+      const auto deadline = stats->deadline_micros.load();
+      if ((deadline > 0u) &&
+          (stop_watch.GetElapsedTime<std::chrono::microseconds>() > deadline)) {
+        ++stats->overruns;
+      }
+    }
+
+    std::shared_ptr<Strand> GetStrand(size_t id, ThreadPool &pool) const {
+      std::lock_guard<std::mutex> lock(_strand_mutex);
+      auto &strand = _strands[id];
+      if (strand == nullptr) {
+        strand = std::make_shared<Strand>(pool.io_context());
+      }
+      return strand;
+    }
+
     std::atomic_size_t _counter{0u};
 
-    AtomicList<Item> _list;
+    EpochList<Item> _list;
+
+    AtomicSharedPtr<ThreadPool> _pool{nullptr};
+
+    std::shared_ptr<Stats> _stats = std::make_shared<Stats>();
+
+    mutable std::mutex _strand_mutex;
+
+    mutable std::unordered_map<size_t, std::shared_ptr<Strand>> _strands;
   };
 
 } // namespace detail
@@ -7,8 +7,13 @@
 #include "carla/client/detail/Client.h"
 
 #include "carla/Exception.h"
+#include "carla/Functional.h"
+#include "carla/Logging.h"
+#include "carla/TaskExecutor.h"
 #include "carla/Version.h"
 #include "carla/client/TimeoutException.h"
+#include "carla/client/detail/MapDataCache.h"
+#include "carla/road/MapSerializer.h"
 #include "carla/rpc/ActorDescription.h"
 #include "carla/rpc/BoneTransformData.h"
 #include "carla/rpc/Client.h"
@@ -18,11 +23,18 @@
 #include "carla/rpc/VehicleLightState.h"
 #include "carla/rpc/WalkerBoneControl.h"
 #include "carla/rpc/WalkerControl.h"
+#include "carla/sensor/s11n/SensorHeaderSerializer.h"
 #include "carla/streaming/Client.h"
 
 #include <rpc/rpc_error.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace carla {
 namespace client {
@@ -46,17 +58,71 @@ namespace detail {
 
     Pimpl(const std::string &host, uint16_t port, size_t worker_threads)
       : endpoint(host + ":" + std::to_string(port)),
+        host(host),
+        port(port),
         rpc_client(host, port),
         streaming_client(host) {
-      rpc_client.set_timeout(5000u);
+      rpc_client.set_timeout(timeout_milliseconds);
+      if (const char *lanes = std::getenv("CARLA_RPC_LANES")) {
+        const auto count = std::atoll(lanes);
+        if (count > 0) {
+          SetLaneCount(static_cast<size_t>(count));
+        }
+      }
+      // Messages of multiplexed sensor streams are routed by the sub-stream
+      // id the sensor layer stamps on each header.
+      streaming_client.SetSubStreamIdExtractor([](const Buffer &message) {
+        return sensor::s11n::SensorHeaderSerializer::Deserialize(message).stream_sub_id;
+      });
       streaming_client.AsyncRun(
           worker_threads > 0u ? worker_threads : std::thread::hardware_concurrency());
+      // Responses arrive in call order on the connection, one completion
+      // thread is enough to retire them.
+      completion_pool.AsyncRun(1u);
+    }
+
+    /// Grow the connection pool to @a count lanes (including the primary
+    /// one). Lanes are never removed, a thread could be mid-call on one.
+    void SetLaneCount(size_t count) {
+      std::lock_guard<std::mutex> lock(lanes_mutex);
+      while (extra_lanes.size() + 1u < count) {
+        auto lane = std::make_unique<rpc::Client>(host, port);
+        lane->set_timeout(timeout_milliseconds);
+        extra_lanes.push_back(std::move(lane));
+      }
+    }
+
+    size_t GetLaneCount() {
+      std::lock_guard<std::mutex> lock(lanes_mutex);
+      return extra_lanes.size() + 1u;
+    }
+
+    void SetTimeout(int64_t milliseconds) {
+      std::lock_guard<std::mutex> lock(lanes_mutex);
+      timeout_milliseconds = milliseconds;
+      rpc_client.set_timeout(milliseconds);
+      for (auto &lane : extra_lanes) {
+        lane->set_timeout(milliseconds);
+      }
+    }
+
+    /// The lane serving the calling thread. Each thread sticks to one
+    /// connection, so its calls keep their order; different threads spread
+    /// over the lanes and their independent calls no longer queue behind
+    /// each other on a single socket.
+    rpc::Client &GetLane() {
+      std::lock_guard<std::mutex> lock(lanes_mutex);
+      if (extra_lanes.empty()) {
+        return rpc_client;
+      }
+      const auto index = GetThisThreadIndex() % (extra_lanes.size() + 1u);
+      return (index == 0u) ? rpc_client : *extra_lanes[index - 1u];
     }
 
     template <typename ... Args>
     auto RawCall(const std::string &function, Args && ... args) {
       try {
-        return rpc_client.call(function, std::forward<Args>(args) ...);
+        return GetLane().call(function, std::forward<Args>(args) ...);
       } catch (const ::rpc::timeout &) {
         throw_exception(TimeoutException(endpoint, GetTimeout()));
       }
@@ -76,7 +142,27 @@ namespace detail {
     template <typename ... Args>
     void AsyncCall(const std::string &function, Args && ... args) {
       // Discard returned future.
-      rpc_client.async_call(function, std::forward<Args>(args) ...);
+      GetLane().async_call(function, std::forward<Args>(args) ...);
+    }
+
+    /// Fire the call immediately and hand back a future, the response is
+    /// unpacked on the completion pool so several calls can overlap their
+    /// round trips on the same connection.
+    template <typename T, typename ... Args>
+    std::future<T> CallAsync(const std::string &function, Args && ... args) {
+      auto object = GetLane().async_call_with_response(function, std::forward<Args>(args) ...);
+      return completion_pool.Post([this, object = std::move(object)]() mutable {
+        const auto timeout = GetTimeout();
+        if (object.wait_for(timeout.to_chrono()) != std::future_status::ready) {
+          throw_exception(TimeoutException(endpoint, timeout));
+        }
+        using R = typename carla::rpc::Response<T>;
+        auto response = object.get().template as<R>();
+        if (response.HasError()) {
+          throw_exception(std::runtime_error(response.GetError().What()));
+        }
+        return Get(response);
+      });
     }
 
     time_duration GetTimeout() const {
@@ -87,9 +173,32 @@ namespace detail {
 
     const std::string endpoint;
 
+    const std::string host;
+
+    const uint16_t port;
+
     rpc::Client rpc_client;
 
+    /// Additional RPC connections, see GetLane. Configured through
+    /// SetRpcLanes or the CARLA_RPC_LANES environment variable; empty by
+    /// default, keeping the single-connection behavior.
+    std::vector<std::unique_ptr<rpc::Client>> extra_lanes;
+
+    std::mutex lanes_mutex;
+
+    int64_t timeout_milliseconds = 5000;
+
     streaming::Client streaming_client;
+
+    TaskExecutor completion_pool;
+
+  private:
+
+    static size_t GetThisThreadIndex() {
+      static std::atomic_size_t counter{0u};
+      static thread_local const size_t index = counter.fetch_add(1u);
+      return index;
+    }
   };
 
   // ===========================================================================
@@ -121,7 +230,15 @@ namespace detail {
   Client::~Client() = default;
 
   void Client::SetTimeout(time_duration timeout) {
-    _pimpl->rpc_client.set_timeout(static_cast<int64_t>(timeout.milliseconds()));
+    _pimpl->SetTimeout(static_cast<int64_t>(timeout.milliseconds()));
+  }
+
+  void Client::SetRpcLanes(size_t count) {
+    _pimpl->SetLaneCount(count);
+  }
+
+  size_t Client::GetRpcLanes() const {
+    return _pimpl->GetLaneCount();
   }
 
   time_duration Client::GetTimeout() const {
@@ -145,6 +262,10 @@ namespace detail {
     _pimpl->CallAndWait<void>("load_new_episode", std::move(map_name));
   }
 
+  void Client::ResetEpisode(const bool reset_settings, const bool reset_weather) {
+    _pimpl->CallAndWait<void>("reset_episode", reset_settings, reset_weather);
+  }
+
   bool Client::CheckIntermediateEpisode() {
     return _pimpl->CallAndWait<bool>("check_intermediate_episode");
   }
@@ -159,7 +280,37 @@ namespace detail {
   }
 
   rpc::MapInfo Client::GetMapInfo() {
-    return _pimpl->CallAndWait<rpc::MapInfo>("get_map_info");
+    auto info = _pimpl->CallAndWait<rpc::MapInfo>("get_map_info");
+    // Large OpenDRIVE files are not inlined in the response, pull them in
+    // chunks so no single message carries the whole map.
+    if (info.open_drive_file.empty() && (info.open_drive_size > 0u)) {
+      // A local copy matching the server's content hash makes the download
+      // unnecessary; ReadOpenDrive re-checks the hash against the file.
+      if (info.open_drive_hash != 0u) {
+        auto cached = MapDataCache::ReadOpenDrive(info.open_drive_hash);
+        if (cached.has_value() && (cached->size() == info.open_drive_size)) {
+          info.open_drive_file = std::move(*cached);
+          return info;
+        }
+      }
+      info.open_drive_file.reserve(info.open_drive_size);
+      while (info.open_drive_file.size() < info.open_drive_size) {
+        auto chunk = _pimpl->CallAndWait<std::string>(
+            "get_map_data_chunk",
+            static_cast<uint64_t>(info.open_drive_file.size()));
+        if (chunk.empty()) {
+          throw_exception(std::runtime_error("received empty map data chunk"));
+        }
+        info.open_drive_file += chunk;
+      }
+      const auto hash = road::MapSerializer::Hash(info.open_drive_file);
+      if ((info.open_drive_hash != 0u) && (hash != info.open_drive_hash)) {
+        log_warning("OpenDRIVE content hash mismatch, not caching the download");
+      } else {
+        MapDataCache::WriteOpenDrive(hash, info.open_drive_file);
+      }
+    }
+    return info;
   }
 
   std::vector<uint8_t> Client::GetNavigationMesh() const {
@@ -178,10 +329,26 @@ namespace detail {
     return _pimpl->CallAndWait<carla::rpc::Actor>("get_spectator");
   }
 
+  std::vector<rpc::StreamStats> Client::GetSensorStreamStats() const {
+    return _pimpl->CallAndWait<std::vector<rpc::StreamStats>>("get_sensor_stream_stats");
+  }
+
+  std::vector<uint8_t> Client::RedirectSensorStream(rpc::ActorId id, std::string host, uint16_t port) {
+    return _pimpl->CallAndWait<std::vector<uint8_t>>("redirect_sensor_stream", id, std::move(host), port);
+  }
+
+  void Client::AdoptSensorStream(rpc::ActorId id, std::vector<uint8_t> token) {
+    _pimpl->CallAndWait<void>("adopt_sensor_stream", id, std::move(token));
+  }
+
   rpc::EpisodeSettings Client::GetEpisodeSettings() {
     return _pimpl->CallAndWait<rpc::EpisodeSettings>("get_episode_settings");
   }
 
+  std::future<rpc::EpisodeSettings> Client::GetEpisodeSettingsAsync() {
+    return _pimpl->CallAsync<rpc::EpisodeSettings>("get_episode_settings");
+  }
+
   uint64_t Client::SetEpisodeSettings(const rpc::EpisodeSettings &settings) {
     return _pimpl->CallAndWait<uint64_t>("set_episode_settings", settings);
   }
@@ -194,6 +361,10 @@ namespace detail {
     _pimpl->AsyncCall("set_weather_parameters", weather);
   }
 
+  void Client::SetWeatherAnimation(const std::vector<rpc::WeatherKeyFrame> &keyframes) {
+    _pimpl->AsyncCall("set_weather_animation", keyframes);
+  }
+
   std::vector<rpc::Actor> Client::GetActorsById(
       const std::vector<ActorId> &ids) {
     using return_t = std::vector<rpc::Actor>;
@@ -205,6 +376,11 @@ namespace detail {
     return _pimpl->CallAndWait<carla::rpc::VehiclePhysicsControl>("get_physics_control", vehicle);
   }
 
+  std::future<rpc::VehiclePhysicsControl> Client::GetVehiclePhysicsControlAsync(
+      rpc::ActorId vehicle) const {
+    return _pimpl->CallAsync<carla::rpc::VehiclePhysicsControl>("get_physics_control", vehicle);
+  }
+
   rpc::VehicleLightState Client::GetVehicleLightState(
       rpc::ActorId vehicle) const {
     return _pimpl->CallAndWait<carla::rpc::VehicleLightState>("get_vehicle_light_state", vehicle);
@@ -222,6 +398,10 @@ namespace detail {
     return _pimpl->AsyncCall("apply_vehicle_light_state", vehicle, light_state);
   }
 
+  void Client::PrewarmActors(const std::vector<std::string> &blueprint_ids) {
+    _pimpl->CallAndWait<void>("prewarm_actors", blueprint_ids);
+  }
+
   rpc::Actor Client::SpawnActor(
       const rpc::ActorDescription &description,
       const geom::Transform &transform) {
@@ -257,6 +437,15 @@ namespace detail {
     _pimpl->AsyncCall("set_actor_transform", actor, transform);
   }
 
+  std::vector<rpc::ActorSyncState> Client::ExchangeActorStates(
+      const std::vector<rpc::ActorTransformUpdate> &updates,
+      const std::vector<ActorId> &query_ids) {
+    return _pimpl->CallAndWait<std::vector<rpc::ActorSyncState>>(
+        "exchange_actor_states",
+        updates,
+        query_ids);
+  }
+
   void Client::SetActorVelocity(rpc::ActorId actor, const geom::Vector3D &vector) {
     _pimpl->AsyncCall("set_actor_velocity", actor, vector);
   }
@@ -320,8 +509,46 @@ namespace detail {
     return _pimpl->CallAndWait<return_t>("get_group_traffic_lights", traffic_light);
   }
 
-  std::string Client::StartRecorder(std::string name) {
-    return _pimpl->CallAndWait<std::string>("start_recorder", name);
+  std::vector<rpc::TrafficLightSnapshot> Client::GetTrafficLightSnapshots() const {
+    using return_t = std::vector<rpc::TrafficLightSnapshot>;
+    return _pimpl->CallAndWait<return_t>("get_traffic_light_states");
+  }
+
+  void Client::SetTrafficLightStates(
+      const std::vector<std::pair<rpc::ActorId, rpc::TrafficLightState>> &states) {
+    _pimpl->AsyncCall("set_traffic_light_states", states);
+  }
+
+  void Client::StartTrace(uint64_t max_events) {
+    _pimpl->AsyncCall("start_trace", max_events);
+  }
+
+  void Client::StopTrace() {
+    _pimpl->AsyncCall("stop_trace");
+  }
+
+  std::string Client::GetTrace() {
+    return _pimpl->CallAndWait<std::string>("get_trace");
+  }
+
+  rpc::ObjectCensus Client::GetObjectCensus() const {
+    return _pimpl->CallAndWait<rpc::ObjectCensus>("get_object_census");
+  }
+
+  rpc::FrameStats Client::GetFrameStats() const {
+    return _pimpl->CallAndWait<rpc::FrameStats>("get_frame_stats");
+  }
+
+  std::vector<rpc::BufferPoolStats> Client::GetBufferPoolStats() const {
+    return _pimpl->CallAndWait<std::vector<rpc::BufferPoolStats>>("get_buffer_pool_stats");
+  }
+
+  std::string Client::StartRecorder(std::string name, std::string filter) {
+    return _pimpl->CallAndWait<std::string>("start_recorder", name, filter);
+  }
+
+  streaming::Token Client::StartRecorderStream(std::string name, std::string filter) {
+    return _pimpl->CallAndWait<streaming::Token>("start_recorder_stream", name, filter);
   }
 
   void Client::StopRecorder() {
@@ -352,6 +579,10 @@ namespace detail {
     _pimpl->AsyncCall("set_replayer_ignore_hero", ignore_hero);
   }
 
+  double Client::FastForwardReplayer(double time) {
+    return _pimpl->CallAndWait<double>("fast_forward_replayer", time);
+  }
+
   void Client::SubscribeToStream(
       const streaming::Token &token,
       std::function<void(Buffer)> callback) {
@@ -362,6 +593,10 @@ namespace detail {
     _pimpl->streaming_client.UnSubscribe(token);
   }
 
+  streaming::Token Client::SubscribeToFilteredEpisodeState(const rpc::EpisodeStreamFilter &filter) {
+    return _pimpl->CallAndWait<streaming::Token>("subscribe_filtered_episode_state", filter);
+  }
+
   void Client::DrawDebugShape(const rpc::DebugShape &shape) {
     _pimpl->AsyncCall("draw_debug_shape", shape);
   }
@@ -370,10 +605,23 @@ namespace detail {
     _pimpl->AsyncCall("apply_batch", std::move(commands), do_tick_cue);
   }
 
+  static bool ContainsSpawnCommands(const std::vector<rpc::Command> &commands) {
+    auto is_spawn = Functional::MakeOverload(
+        [](const rpc::Command::SpawnActor &) { return true; },
+        [](const auto &) { return false; });
+    return std::any_of(commands.begin(), commands.end(), [&](const rpc::Command &command) {
+      return boost::apply_visitor(is_spawn, command.command);
+    });
+  }
+
   std::vector<rpc::CommandResponse> Client::ApplyBatchSync(
       std::vector<rpc::Command> commands,
       bool do_tick_cue) {
-    auto result = _pimpl->RawCall("apply_batch", std::move(commands), do_tick_cue);
+    // Spawn-heavy batches go through the deferred path: the server validates
+    // the blueprints off the game thread and commits the actors over several
+    // slices instead of blocking the world for the whole batch.
+    const auto endpoint = ContainsSpawnCommands(commands) ? "apply_batch_deferred" : "apply_batch";
+    auto result = _pimpl->RawCall(endpoint, std::move(commands), do_tick_cue);
     return result.as<std::vector<rpc::CommandResponse>>();
   }
 
@@ -381,12 +629,25 @@ namespace detail {
     return _pimpl->CallAndWait<uint64_t>("tick_cue");
   }
 
+  uint64_t Client::SendFusedTickCue() {
+    return _pimpl->CallAndWait<uint64_t>("tick_cue_fused");
+  }
+
+  uint64_t Client::SendTickCueWithDeadline(double deadline_budget_seconds) {
+    return _pimpl->CallAndWait<uint64_t>("tick_cue_deadline", deadline_budget_seconds);
+  }
+
   std::vector<rpc::LightState> Client::QueryLightsStateToServer() const {
     using return_t = std::vector<rpc::LightState>;
     return _pimpl->CallAndWait<return_t>("query_lights_state", _pimpl->endpoint);
   }
 
-  void Client::UpdateServerLightsState(std::vector<rpc::LightState>& lights, bool discard_client) const {
+  std::future<std::vector<rpc::LightState>> Client::QueryLightsStateToServerAsync() const {
+    using return_t = std::vector<rpc::LightState>;
+    return _pimpl->CallAsync<return_t>("query_lights_state", _pimpl->endpoint);
+  }
+
+  void Client::UpdateServerLightsState(std::vector<rpc::LightStateDelta>& lights, bool discard_client) const {
     _pimpl->AsyncCall("update_lights_state", _pimpl->endpoint, std::move(lights), discard_client);
   }
 
@@ -12,22 +12,32 @@
 #include "carla/geom/Transform.h"
 #include "carla/rpc/Actor.h"
 #include "carla/rpc/ActorDefinition.h"
+#include "carla/rpc/ActorSync.h"
 #include "carla/rpc/AttachmentType.h"
 #include "carla/rpc/Command.h"
 #include "carla/rpc/CommandResponse.h"
 #include "carla/rpc/EpisodeInfo.h"
 #include "carla/rpc/EpisodeSettings.h"
+#include "carla/rpc/BufferPoolStats.h"
+#include "carla/rpc/EpisodeStreamFilter.h"
+#include "carla/rpc/FrameStats.h"
 #include "carla/rpc/LightState.h"
 #include "carla/rpc/MapInfo.h"
+#include "carla/rpc/ObjectCensus.h"
+#include "carla/rpc/StreamStats.h"
+#include "carla/rpc/TrafficLightSnapshot.h"
 #include "carla/rpc/TrafficLightState.h"
 #include "carla/rpc/VehiclePhysicsControl.h"
 #include "carla/rpc/VehicleLightState.h"
+#include "carla/rpc/WeatherKeyFrame.h"
 #include "carla/rpc/WeatherParameters.h"
 #include "carla/rpc/OpendriveGenerationParameters.h"
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 // Forward declarations.
@@ -80,6 +90,15 @@ namespace detail {
 
     time_duration GetTimeout() const;
 
+    /// Grow the pool of RPC connections to @a count lanes. Calls of one
+    /// thread stick to one lane and keep their order; calls from different
+    /// threads spread over the lanes and run concurrently instead of
+    /// queueing on a single socket. Lanes are never removed. Defaults to 1,
+    /// also configurable through the CARLA_RPC_LANES environment variable.
+    void SetRpcLanes(size_t count);
+
+    size_t GetRpcLanes() const;
+
     const std::string GetEndpoint() const;
 
     std::string GetClientVersion();
@@ -88,6 +107,8 @@ namespace detail {
 
     void LoadEpisode(std::string map_name);
 
+    void ResetEpisode(bool reset_settings, bool reset_weather);
+
     bool CheckIntermediateEpisode();
 
     void CopyOpenDriveToServer(
@@ -105,18 +126,41 @@ namespace detail {
 
     rpc::Actor GetSpectator();
 
+    /// Per-stream pipeline timing collected on the server, see
+    /// rpc::StreamStats.
+    std::vector<rpc::StreamStats> GetSensorStreamStats() const;
+
+    /// Point the stream token of the given sensor at a secondary renderer
+    /// listening at @a host and @a port, returning the rewritten token.
+    std::vector<uint8_t> RedirectSensorStream(rpc::ActorId id, std::string host, uint16_t port);
+
+    /// Publish the stream identified by @a token from this simulator, under
+    /// the stream id assigned by the primary. Counterpart of
+    /// RedirectSensorStream, called on the secondary renderer.
+    void AdoptSensorStream(rpc::ActorId id, std::vector<uint8_t> token);
+
     rpc::EpisodeSettings GetEpisodeSettings();
 
+    /// Like GetEpisodeSettings, but the round trip overlaps with the caller;
+    /// the future throws on error or timeout when retrieved.
+    std::future<rpc::EpisodeSettings> GetEpisodeSettingsAsync();
+
     uint64_t SetEpisodeSettings(const rpc::EpisodeSettings &settings);
 
     rpc::WeatherParameters GetWeatherParameters();
 
     void SetWeatherParameters(const rpc::WeatherParameters &weather);
 
+    void SetWeatherAnimation(const std::vector<rpc::WeatherKeyFrame> &keyframes);
+
     std::vector<rpc::Actor> GetActorsById(const std::vector<ActorId> &ids);
 
     rpc::VehiclePhysicsControl GetVehiclePhysicsControl(rpc::ActorId vehicle) const;
 
+    /// @copydoc GetEpisodeSettingsAsync
+    std::future<rpc::VehiclePhysicsControl> GetVehiclePhysicsControlAsync(
+        rpc::ActorId vehicle) const;
+
     rpc::VehicleLightState GetVehicleLightState(rpc::ActorId vehicle) const;
 
     void ApplyPhysicsControlToVehicle(
@@ -127,6 +171,8 @@ namespace detail {
         rpc::ActorId vehicle,
         const rpc::VehicleLightState &light_state);
 
+    void PrewarmActors(const std::vector<std::string> &blueprint_ids);
+
     rpc::Actor SpawnActor(
         const rpc::ActorDescription &description,
         const geom::Transform &transform);
@@ -147,6 +193,14 @@ namespace detail {
         rpc::ActorId actor,
         const geom::Transform &transform);
 
+    /// Apply a batch of externally-driven actor transforms and read back
+    /// the states of @a query_ids, all in one round trip; the per-step
+    /// exchange of a co-simulation bridge. Entries whose actor no longer
+    /// exists are skipped on both halves.
+    std::vector<rpc::ActorSyncState> ExchangeActorStates(
+        const std::vector<rpc::ActorTransformUpdate> &updates,
+        const std::vector<ActorId> &query_ids);
+
     void SetActorVelocity(
         rpc::ActorId actor,
         const geom::Vector3D &vector);
@@ -206,7 +260,43 @@ namespace detail {
     std::vector<ActorId> GetGroupTrafficLights(
         rpc::ActorId traffic_light);
 
-    std::string StartRecorder(std::string name);
+    /// State, timing and group of every traffic light of the episode in a
+    /// single round trip.
+    std::vector<rpc::TrafficLightSnapshot> GetTrafficLightSnapshots() const;
+
+    /// Set the state of several traffic lights with one call, entries whose
+    /// actor no longer exists are skipped.
+    void SetTrafficLightStates(
+        const std::vector<std::pair<rpc::ActorId, rpc::TrafficLightState>> &states);
+
+    /// Start recording trace events server-side into a ring buffer of
+    /// @a max_events events, see profiler::TraceLog.
+    void StartTrace(uint64_t max_events);
+
+    void StopTrace();
+
+    /// The server's captured trace events as a chrome://tracing JSON
+    /// document.
+    std::string GetTrace();
+
+    /// Live/peak/total counters of the server's profiled objects plus the
+    /// memory retained by its buffer pools, see profiler::LifetimeCensus.
+    rpc::ObjectCensus GetObjectCensus() const;
+
+    /// Rolling breakdown of the server's frame time among the stages of its
+    /// main loop, see rpc::FrameStats.
+    rpc::FrameStats GetFrameStats() const;
+
+    /// Allocation counters of every buffer pool of the server process, see
+    /// rpc::BufferPoolStats.
+    std::vector<rpc::BufferPoolStats> GetBufferPoolStats() const;
+
+    std::string StartRecorder(std::string name, std::string filter);
+
+    /// Start the recorder publishing its blocks on a stream instead of
+    /// writing them on the simulator host, returns the token of that
+    /// stream. See Simulator::StartRecorderStream.
+    streaming::Token StartRecorderStream(std::string name, std::string filter);
 
     void StopRecorder();
 
@@ -222,12 +312,18 @@ namespace detail {
 
     void SetReplayerIgnoreHero(bool ignore_hero);
 
+    double FastForwardReplayer(double time);
+
     void SubscribeToStream(
         const streaming::Token &token,
         std::function<void(Buffer)> callback);
 
     void UnSubscribeFromStream(const streaming::Token &token);
 
+    /// Ask the server for an episode state stream restricted by @a filter,
+    /// returns the token of the new stream.
+    streaming::Token SubscribeToFilteredEpisodeState(const rpc::EpisodeStreamFilter &filter);
+
     void DrawDebugShape(const rpc::DebugShape &shape);
 
     void ApplyBatch(
@@ -240,10 +336,24 @@ namespace detail {
 
     uint64_t SendTickCue();
 
+    /// Same as SendTickCue but the server holds the response back until the
+    /// resulting frame's state broadcast is in flight, fusing the tick round
+    /// trip with the wait on the stream. Returns the frame broadcast.
+    uint64_t SendFusedTickCue();
+
+    /// Same as SendTickCue but declares that the caller expects to
+    /// rendezvous with the resulting frame no earlier than
+    /// @a deadline_budget_seconds from now, so the server can schedule the
+    /// concurrent window; returns as soon as the frame is initiated.
+    uint64_t SendTickCueWithDeadline(double deadline_budget_seconds);
+
     std::vector<rpc::LightState> QueryLightsStateToServer() const;
 
+    /// @copydoc GetEpisodeSettingsAsync
+    std::future<std::vector<rpc::LightState>> QueryLightsStateToServerAsync() const;
+
     void UpdateServerLightsState(
-        std::vector<rpc::LightState>& lights,
+        std::vector<rpc::LightStateDelta>& lights,
         bool discard_client = false) const;
 
   private:
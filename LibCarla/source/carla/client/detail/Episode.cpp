@@ -12,7 +12,9 @@
 #include "carla/sensor/Deserializer.h"
 #include "carla/trafficmanager/TrafficManager.h"
 
+#include <algorithm>
 #include <exception>
+#include <iterator>
 
 namespace carla {
 namespace client {
@@ -58,7 +60,21 @@ using namespace std::chrono_literals;
       if (self != nullptr) {
 
         auto data = sensor::Deserializer::Deserialize(std::move(buffer));
-        auto next = std::make_shared<const EpisodeState>(CastData(*data));
+        const auto &raw = CastData(*data);
+        std::shared_ptr<const EpisodeState> next;
+        if (raw.IsDeltaFrame()) {
+          auto base = self->_delta_base.load();
+          if ((base == nullptr) || (base->GetEpisodeId() != raw.GetEpisodeId())) {
+            // We cannot reconstruct a delta frame without a keyframe of this
+            // episode, skip frames until the next keyframe arrives.
+            return;
+          }
+          next = std::make_shared<const EpisodeState>(raw, *base);
+        } else {
+          auto keyframe = std::make_shared<const EpisodeState>(raw);
+          self->_delta_base = keyframe;
+          next = keyframe;
+        }
         auto prev = self->GetState();
 
         // TODO: Update how the map change is detected
@@ -87,6 +103,17 @@ using namespace std::chrono_literals;
             }
           } while (!self->_state.compare_exchange(&prev, next));
 
+          if (self->_subscribed_to_actor_list) {
+            self->RefreshActorCache(*prev, *next);
+          }
+
+          if (next->GetPhysicsControlRevision() != prev->GetPhysicsControlRevision()) {
+            std::lock_guard<std::mutex> lock(self->_physics_control_mutex);
+            self->_physics_control_cache.clear();
+          }
+
+          self->PushStateToHistory(next);
+
           if(UpdateLights) {
             self->_on_light_update_callbacks.Call(next);
           }
@@ -112,6 +139,15 @@ using namespace std::chrono_literals;
     });
   }
 
+  void Episode::ApplyStreamFilter(const rpc::EpisodeStreamFilter &filter) {
+    // Negotiate the filtered stream first so at most one state update is
+    // missed while the subscriptions are swapped.
+    const auto token = _client.SubscribeToFilteredEpisodeState(filter);
+    _client.UnSubscribeFromStream(_token);
+    _token = token;
+    Listen();
+  }
+
   boost::optional<rpc::Actor> Episode::GetActorById(ActorId id) {
     auto actor = _actors.GetActorById(id);
     if (!actor.has_value()) {
@@ -141,13 +177,133 @@ using namespace std::chrono_literals;
   }
 
   std::vector<rpc::Actor> Episode::GetActors() {
-    return GetActorsById_Impl(_client, _actors, GetState()->GetActorIds());
+    if (!_subscribed_to_actor_list) {
+      return GetActorsById_Impl(_client, _actors, GetState()->GetActorIds());
+    }
+    // Load the version before the state so a concurrent set change can only
+    // leave us with a snapshot tagged too old, never too new; a stale tag
+    // merely triggers a rebuild on the next call.
+    const auto version = _actor_set_version.load();
+    auto snapshot = _actor_list_snapshot.load();
+    if ((snapshot != nullptr) && (snapshot->version == version)) {
+      return snapshot->actors;
+    }
+    auto actors = GetActorsById_Impl(_client, _actors, GetState()->GetActorIds());
+    _actor_list_snapshot = std::make_shared<const ActorListSnapshot>(
+        ActorListSnapshot{version, actors});
+    return actors;
+  }
+
+  void Episode::RefreshActorCache(const EpisodeState &prev, const EpisodeState &next) {
+    auto prev_ids = prev.GetActorIds();
+    auto next_ids = next.GetActorIds();
+    // Keyframes are forced whenever the actor set changes, and delta frames
+    // keep the array order of their base, so an element-wise comparison
+    // catches the unchanged case cheaply.
+    if ((prev_ids.size() == next_ids.size()) &&
+        std::equal(std::begin(prev_ids), std::end(prev_ids), std::begin(next_ids))) {
+      return;
+    }
+    for (auto id : prev_ids) {
+      if (!next.ContainsActorSnapshot(id)) {
+        _actors.Remove(id);
+      }
+    }
+    ++_actor_set_version;
+  }
+
+  void Episode::SetStateHistoryDepth(size_t depth) {
+    std::lock_guard<std::mutex> lock(_state_history_mutex);
+    _state_history.clear();
+    _state_history.resize(depth);
+    _state_history_next = 0u;
+  }
+
+  void Episode::PushStateToHistory(std::shared_ptr<const EpisodeState> state) {
+    std::lock_guard<std::mutex> lock(_state_history_mutex);
+    if (_state_history.empty()) {
+      return;
+    }
+    _state_history[_state_history_next] = std::move(state);
+    _state_history_next = (_state_history_next + 1u) % _state_history.size();
+  }
+
+  std::vector<std::shared_ptr<const EpisodeState>> Episode::CopyStateHistory(
+      size_t max_frames) const {
+    std::vector<std::shared_ptr<const EpisodeState>> frames;
+    {
+      std::lock_guard<std::mutex> lock(_state_history_mutex);
+      const auto depth = _state_history.size();
+      frames.reserve(depth);
+      for (size_t i = 0u; i < depth; ++i) {
+        const auto &slot = _state_history[(_state_history_next + i) % depth];
+        if (slot != nullptr) {
+          frames.push_back(slot);
+        }
+      }
+    }
+    if ((max_frames > 0u) && (frames.size() > max_frames)) {
+      frames.erase(frames.begin(), frames.end() - static_cast<std::ptrdiff_t>(max_frames));
+    }
+    return frames;
+  }
+
+  std::vector<WorldSnapshot> Episode::GetStateHistory(size_t max_frames) const {
+    auto frames = CopyStateHistory(max_frames);
+    std::vector<WorldSnapshot> result;
+    result.reserve(frames.size());
+    for (auto &state : frames) {
+      result.emplace_back(std::move(state));
+    }
+    return result;
+  }
+
+  std::vector<std::pair<uint64_t, ActorSnapshot>> Episode::GetActorStateHistory(
+      ActorId id,
+      size_t max_frames) const {
+    auto frames = CopyStateHistory(max_frames);
+    std::vector<std::pair<uint64_t, ActorSnapshot>> result;
+    result.reserve(frames.size());
+    for (const auto &state : frames) {
+      auto snapshot = state->GetActorSnapshotIfPresent(id);
+      if (snapshot.has_value()) {
+        result.emplace_back(state->GetFrame(), std::move(*snapshot));
+      }
+    }
+    return result;
+  }
+
+  rpc::VehiclePhysicsControl Episode::GetVehiclePhysicsControl(ActorId vehicle_id) {
+    {
+      std::lock_guard<std::mutex> lock(_physics_control_mutex);
+      auto it = _physics_control_cache.find(vehicle_id);
+      if (it != _physics_control_cache.end()) {
+        return it->second;
+      }
+    }
+    auto control = _client.GetVehiclePhysicsControl(vehicle_id);
+    std::lock_guard<std::mutex> lock(_physics_control_mutex);
+    _physics_control_cache.emplace(vehicle_id, control);
+    return control;
   }
 
   void Episode::OnEpisodeStarted() {
     _actors.Clear();
+    _actor_list_snapshot.reset();
     _on_tick_callbacks.Clear();
     _navigation.reset();
+    {
+      std::lock_guard<std::mutex> lock(_physics_control_mutex);
+      _physics_control_cache.clear();
+    }
+    {
+      // Keep the configured depth but drop the frames of the old episode.
+      std::lock_guard<std::mutex> lock(_state_history_mutex);
+      for (auto &slot : _state_history) {
+        slot = nullptr;
+      }
+      _state_history_next = 0u;
+    }
     traffic_manager::TrafficManager::Release();
   }
 
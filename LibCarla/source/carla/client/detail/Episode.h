@@ -16,7 +16,13 @@
 #include "carla/client/detail/EpisodeState.h"
 #include "carla/client/detail/WalkerNavigation.h"
 #include "carla/rpc/EpisodeInfo.h"
+#include "carla/rpc/EpisodeStreamFilter.h"
+#include "carla/rpc/VehiclePhysicsControl.h"
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace carla {
@@ -41,6 +47,11 @@ namespace detail {
 
     void Listen();
 
+    /// Replace this client's episode state subscription with a stream
+    /// restricted by @a filter, see rpc::EpisodeStreamFilter. The server
+    /// keeps broadcasting the full stream to everyone else.
+    void ApplyStreamFilter(const rpc::EpisodeStreamFilter &filter);
+
     auto GetId() const {
       return GetState()->GetEpisodeId();
     }
@@ -67,10 +78,61 @@ namespace detail {
 
     std::vector<rpc::Actor> GetActors();
 
+    /// Keep the actor cache in sync with the spawn and destroy events of the
+    /// state stream, so GetActors returns a cached snapshot without a round
+    /// trip to the simulator while the actor set is unchanged.
+    void SetActorListSubscription(bool enabled) {
+      _subscribed_to_actor_list = enabled;
+      if (!enabled) {
+        _actor_list_snapshot.reset();
+      }
+    }
+
+    /// Physics control of @a vehicle_id, served from a local cache that the
+    /// server invalidates through the physics control revision of the state
+    /// stream; only cache misses round-trip to the simulator.
+    rpc::VehiclePhysicsControl GetVehiclePhysicsControl(ActorId vehicle_id);
+
+    /// Drop the cached physics control of @a vehicle_id, call when applying
+    /// a new control so a read in the same frame does not see the old one.
+    void InvalidatePhysicsControl(ActorId vehicle_id) {
+      std::lock_guard<std::mutex> lock(_physics_control_mutex);
+      _physics_control_cache.erase(vehicle_id);
+    }
+
+    /// Keep the last @a depth episode states reachable for windowed
+    /// queries, see GetStateHistory. The ring of slots is preallocated and
+    /// overwritten in place; zero (the default) disables the history and
+    /// releases the retained states.
+    void SetStateHistoryDepth(size_t depth);
+
+    size_t GetStateHistoryDepth() const {
+      std::lock_guard<std::mutex> lock(_state_history_mutex);
+      return _state_history.size();
+    }
+
+    /// The most recent states retained by the history ring, oldest first,
+    /// at most @a max_frames entries (all of them when zero).
+    std::vector<WorldSnapshot> GetStateHistory(size_t max_frames) const;
+
+    /// Per-frame snapshots of actor @a id paired with their frame number,
+    /// oldest first, over the most recent @a max_frames frames of the
+    /// history ring (all of them when zero). Frames in which the actor is
+    /// absent are skipped.
+    std::vector<std::pair<uint64_t, ActorSnapshot>> GetActorStateHistory(
+        ActorId id,
+        size_t max_frames) const;
+
     boost::optional<WorldSnapshot> WaitForState(time_duration timeout) {
       return _snapshot.WaitFor(timeout);
     }
 
+    /// Spin up to @a micros microseconds for the next state before parking,
+    /// see RecurrentSharedFuture::SetSpinBudget. Zero always parks.
+    void SetWaitForStateSpinBudget(size_t micros) {
+      _snapshot.SetSpinBudget(micros);
+    }
+
     size_t RegisterOnTickEvent(std::function<void(WorldSnapshot)> callback) {
       return _on_tick_callbacks.Push(std::move(callback));
     }
@@ -79,6 +141,31 @@ namespace detail {
       _on_tick_callbacks.Remove(id);
     }
 
+    /// Run the on-tick callbacks on a pool of @a worker_threads threads,
+    /// keeping the invocations of each callback ordered, so a slow callback
+    /// no longer delays snapshot delivery to the rest. Zero threads restores
+    /// sequential delivery on the streaming thread.
+    void SetConcurrentOnTickCallbacks(size_t worker_threads) {
+      if (worker_threads == 0u) {
+        _on_tick_callbacks.SetExecutor(nullptr);
+        return;
+      }
+      auto pool = std::make_shared<ThreadPool>();
+      pool->AsyncRun(worker_threads);
+      _on_tick_callbacks.SetExecutor(std::move(pool));
+    }
+
+    /// Count on-tick callback invocations taking longer than @a deadline,
+    /// zero disables the counting.
+    void SetOnTickCallbackDeadline(time_duration deadline) {
+      _on_tick_callbacks.SetDeadline(deadline);
+    }
+
+    /// Number of on-tick callback invocations that exceeded the deadline.
+    uint64_t GetOnTickCallbackOverruns() const {
+      return _on_tick_callbacks.GetOverrunCount();
+    }
+
     size_t RegisterOnMapChangeEvent(std::function<void(WorldSnapshot)> callback) {
       return _on_map_change_callbacks.Push(std::move(callback));
     }
@@ -108,22 +195,67 @@ namespace detail {
 
   private:
 
+    /// Actor list built at a given version of the actor set, see
+    /// _actor_set_version.
+    struct ActorListSnapshot {
+      uint64_t version;
+      std::vector<rpc::Actor> actors;
+    };
+
     Episode(Client &client, const rpc::EpisodeInfo &info);
 
     void OnEpisodeStarted();
 
     void OnEpisodeChanged();
 
+    /// Remove from the actor cache the actors no longer present in @a next,
+    /// and bump the actor set version if the set changed. Called from the
+    /// streaming thread while the actor-list subscription is active.
+    void RefreshActorCache(const EpisodeState &prev, const EpisodeState &next);
+
+    /// Store @a state into the history ring, no-op while the history is
+    /// disabled. Called from the streaming thread once per frame.
+    void PushStateToHistory(std::shared_ptr<const EpisodeState> state);
+
+    /// Copy of the retained frames, oldest first, at most @a max_frames of
+    /// the most recent ones (all of them when zero).
+    std::vector<std::shared_ptr<const EpisodeState>> CopyStateHistory(size_t max_frames) const;
+
     Client &_client;
 
     AtomicSharedPtr<const EpisodeState> _state;
 
+    /// Last keyframe received, delta frames are reconstructed against it.
+    AtomicSharedPtr<const EpisodeState> _delta_base;
+
     AtomicSharedPtr<WalkerNavigation> _navigation;
 
     std::string _pending_exceptions_msg;
 
     CachedActorList _actors;
 
+    std::atomic_bool _subscribed_to_actor_list{false};
+
+    /// Incremented (after _state is swapped) whenever the actor set changes,
+    /// invalidates _actor_list_snapshot.
+    std::atomic<uint64_t> _actor_set_version{0u};
+
+    AtomicSharedPtr<const ActorListSnapshot> _actor_list_snapshot;
+
+    std::mutex _physics_control_mutex;
+
+    /// Cleared when the server bumps the physics control revision.
+    std::unordered_map<ActorId, rpc::VehiclePhysicsControl> _physics_control_cache;
+
+    mutable std::mutex _state_history_mutex;
+
+    /// Ring of the most recent states with the oldest slot at
+    /// _state_history_next, written on the streaming thread; empty while
+    /// the history is disabled.
+    std::vector<std::shared_ptr<const EpisodeState>> _state_history;
+
+    size_t _state_history_next = 0u;
+
     CallbackList<WorldSnapshot> _on_tick_callbacks;
 
     CallbackList<WorldSnapshot> _on_map_change_callbacks;
@@ -132,7 +264,8 @@ namespace detail {
 
     RecurrentSharedFuture<WorldSnapshot> _snapshot;
 
-    const streaming::Token _token;
+    /// Replaced when a stream filter is applied, see ApplyStreamFilter.
+    streaming::Token _token;
 
     bool _pending_exceptions = false;
   };
@@ -6,6 +6,8 @@
 
 #include "carla/client/detail/EpisodeState.h"
 
+#include <cstring>
+
 namespace carla {
 namespace client {
 namespace detail {
@@ -17,21 +19,97 @@ namespace detail {
           state.GetGameTimeStamp(),
           state.GetDeltaSeconds(),
           state.GetPlatformTimeStamp()),
-      _simulation_state(state.GetSimulationState()) {
-    _actors.reserve(state.size());
+      _simulation_state(state.GetSimulationState()),
+      _physics_control_revision(state.GetPhysicsControlRevision()) {
+    _ids.reserve(state.size());
+    _transforms.reserve(state.size());
+    _velocities.reserve(state.size());
+    _angular_velocities.reserve(state.size());
+    _accelerations.reserve(state.size());
+    _states.reserve(state.size());
+    _index_by_id.reserve(state.size());
     for (auto &&actor : state) {
       DEBUG_ONLY(auto result = )
-      _actors.emplace(
-          actor.id,
-          ActorSnapshot{
-              actor.id,
-              actor.transform,
-              actor.velocity,
-              actor.angular_velocity,
-              actor.acceleration,
-              actor.state});
+      _index_by_id.emplace(actor.id, static_cast<uint32_t>(_ids.size()));
       DEBUG_ASSERT(result.second);
+      _ids.emplace_back(actor.id);
+      _transforms.emplace_back(actor.transform);
+      _velocities.emplace_back(actor.velocity);
+      _angular_velocities.emplace_back(actor.angular_velocity);
+      _accelerations.emplace_back(actor.acceleration);
+      _states.emplace_back(actor.state);
+    }
+  }
+
+  EpisodeState::EpisodeState(
+      const sensor::data::RawEpisodeState &state,
+      const EpisodeState &base)
+    : _episode_id(state.GetEpisodeId()),
+      _timestamp(
+          state.GetFrame(),
+          state.GetGameTimeStamp(),
+          state.GetDeltaSeconds(),
+          state.GetPlatformTimeStamp()),
+      _simulation_state(state.GetSimulationState()),
+      _physics_control_revision(state.GetPhysicsControlRevision()),
+      _ids(base._ids),
+      _transforms(base._transforms),
+      _velocities(base._velocities),
+      _angular_velocities(base._angular_velocities),
+      _accelerations(base._accelerations),
+      _states(base._states),
+      _index_by_id(base._index_by_id) {
+    using Serializer = sensor::s11n::EpisodeStateSerializer;
+    DEBUG_ASSERT(state.IsDeltaFrame());
+    DEBUG_ASSERT(base.GetEpisodeId() == _episode_id);
+    const auto *it = state.delta_begin();
+    auto read = [&it](auto &value) {
+      std::memcpy(&value, it, sizeof(value));
+      it += sizeof(value);
+    };
+    uint32_t entry_count = 0u;
+    read(entry_count);
+    for (auto i = 0u; i < entry_count; ++i) {
+      ActorId id = 0u;
+      read(id);
+      uint8_t mask = 0u;
+      read(mask);
+      // Keyframes are forced whenever the actor set changes, so the actor is
+      // present in the base state.
+      const auto index = GetOrInsertIndex(id);
+      if ((mask & Serializer::TransformField) != 0u) {
+        read(_transforms[index]);
+      }
+      if ((mask & Serializer::VelocityField) != 0u) {
+        read(_velocities[index]);
+      }
+      if ((mask & Serializer::AngularVelocityField) != 0u) {
+        read(_angular_velocities[index]);
+      }
+      if ((mask & Serializer::AccelerationField) != 0u) {
+        read(_accelerations[index]);
+      }
+      if ((mask & Serializer::TypeDependentField) != 0u) {
+        read(_states[index]);
+      }
+    }
+    DEBUG_ASSERT(it == state.delta_end());
+  }
+
+  size_t EpisodeState::GetOrInsertIndex(const ActorId id) {
+    auto it = _index_by_id.find(id);
+    if (it != _index_by_id.end()) {
+      return it->second;
     }
+    const auto index = _ids.size();
+    _index_by_id.emplace(id, static_cast<uint32_t>(index));
+    _ids.emplace_back(id);
+    _transforms.emplace_back();
+    _velocities.emplace_back();
+    _angular_velocities.emplace_back();
+    _accelerations.emplace_back();
+    _states.emplace_back();
+    return index;
   }
 
 } // namespace detail
@@ -6,7 +6,6 @@
 
 #pragma once
 
-#include "carla/Iterator.h"
 #include "carla/ListView.h"
 #include "carla/NonCopyable.h"
 #include "carla/client/ActorSnapshot.h"
@@ -17,12 +16,19 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace carla {
 namespace client {
 namespace detail {
 
   /// Represents the state of all the actors of an episode at a given frame.
+  ///
+  /// The state is stored as struct-of-arrays: ids, transforms, velocities,
+  /// angular velocities, accelerations, and type-dependent states each live
+  /// in a contiguous array indexed consistently, entry @a i of every array
+  /// belongs to the same actor. A compact id-to-index map resolves lookups,
+  /// and the arrays can be scanned directly through the span accessors.
   class EpisodeState
     : public std::enable_shared_from_this<EpisodeState>,
       private NonCopyable {
@@ -35,6 +41,12 @@ namespace detail {
 
     explicit EpisodeState(const sensor::data::RawEpisodeState &state);
 
+    /// Reconstruct the state of a delta frame by applying the changed fields
+    /// of @a state on top of the @a base keyframe.
+    explicit EpisodeState(
+        const sensor::data::RawEpisodeState &state,
+        const EpisodeState &base);
+
     auto GetEpisodeId() const {
       return _episode_id;
     }
@@ -51,6 +63,10 @@ namespace detail {
       return _simulation_state;
     }
 
+    uint64_t GetPhysicsControlRevision() const {
+      return _physics_control_revision;
+    }
+
     bool HasMapChanged() const {
       return (_simulation_state & SimulationState::MapChange) != SimulationState::None;
     }
@@ -60,56 +76,163 @@ namespace detail {
     }
 
     bool ContainsActorSnapshot(ActorId actor_id) const {
-      return _actors.find(actor_id) != _actors.end();
+      return _index_by_id.find(actor_id) != _index_by_id.end();
+    }
+
+    /// Index of @a id in the snapshot arrays, if present.
+    boost::optional<size_t> GetActorIndex(ActorId id) const {
+      boost::optional<size_t> index;
+      auto it = _index_by_id.find(id);
+      if (it != _index_by_id.end()) {
+        index = static_cast<size_t>(it->second);
+      }
+      return index;
     }
 
     ActorSnapshot GetActorSnapshot(ActorId id) const {
       ActorSnapshot state;
-      CopyActorSnapshotIfPresent(id, state);
+      auto it = _index_by_id.find(id);
+      if (it != _index_by_id.end()) {
+        state = MakeSnapshotAtIndex(it->second);
+      }
       return state;
     }
 
     boost::optional<ActorSnapshot> GetActorSnapshotIfPresent(ActorId id) const {
       boost::optional<ActorSnapshot> state;
-      CopyActorSnapshotIfPresent(id, state);
+      auto it = _index_by_id.find(id);
+      if (it != _index_by_id.end()) {
+        state = MakeSnapshotAtIndex(it->second);
+      }
       return state;
     }
 
     auto GetActorIds() const {
-      return MakeListView(
-          iterator::make_map_keys_const_iterator(_actors.begin()),
-          iterator::make_map_keys_const_iterator(_actors.end()));
+      return MakeSpan(_ids);
+    }
+
+    /// @name Spans over the struct-of-arrays storage
+    ///
+    /// Entry @a i of every span belongs to the actor with id
+    /// GetActorIds()[i], use GetActorIndex to resolve an id.
+    /// @{
+
+    auto GetTransforms() const {
+      return MakeSpan(_transforms);
     }
 
+    auto GetVelocities() const {
+      return MakeSpan(_velocities);
+    }
+
+    auto GetAngularVelocities() const {
+      return MakeSpan(_angular_velocities);
+    }
+
+    auto GetAccelerations() const {
+      return MakeSpan(_accelerations);
+    }
+
+    auto GetTypeDependentStates() const {
+      return MakeSpan(_states);
+    }
+
+    /// @}
+
     size_t size() const {
-      return _actors.size();
+      return _ids.size();
     }
 
-    auto begin() const {
-      return iterator::make_map_values_const_iterator(_actors.begin());
+    /// Iterates the snapshot building one ActorSnapshot per actor. Prefer
+    /// the span accessors on hot paths, they read the arrays in place.
+    class const_iterator {
+    public:
+
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = ActorSnapshot;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const ActorSnapshot *;
+      using reference = ActorSnapshot;
+
+      ActorSnapshot operator*() const {
+        return _state->MakeSnapshotAtIndex(_index);
+      }
+
+      const_iterator &operator++() {
+        ++_index;
+        return *this;
+      }
+
+      bool operator==(const const_iterator &rhs) const {
+        return _index == rhs._index;
+      }
+
+      bool operator!=(const const_iterator &rhs) const {
+        return !(*this == rhs);
+      }
+
+    private:
+
+      friend class EpisodeState;
+
+      const_iterator(const EpisodeState *state, size_t index)
+        : _state(state),
+          _index(index) {}
+
+      const EpisodeState *_state;
+
+      size_t _index;
+    };
+
+    const_iterator begin() const {
+      return const_iterator(this, 0u);
     }
 
-    auto end() const {
-      return iterator::make_map_values_const_iterator(_actors.end());
+    const_iterator end() const {
+      return const_iterator(this, _ids.size());
     }
 
   private:
 
     template <typename T>
-    void CopyActorSnapshotIfPresent(ActorId id, T &value) const {
-      auto it = _actors.find(id);
-      if (it != _actors.end()) {
-        value = it->second;
-      }
+    static ListView<const T *> MakeSpan(const std::vector<T> &v) {
+      return MakeListView(v.data(), v.data() + v.size());
+    }
+
+    ActorSnapshot MakeSnapshotAtIndex(size_t i) const {
+      return ActorSnapshot{
+          _ids[i],
+          _transforms[i],
+          _velocities[i],
+          _angular_velocities[i],
+          _accelerations[i],
+          _states[i]};
     }
 
+    /// Index of @a id, appending a default entry if the id is not present.
+    size_t GetOrInsertIndex(ActorId id);
+
     const uint64_t _episode_id;
 
     const Timestamp _timestamp;
 
     SimulationState _simulation_state;
 
-    std::unordered_map<ActorId, ActorSnapshot> _actors;
+    uint64_t _physics_control_revision = 0u;
+
+    std::vector<ActorId> _ids;
+
+    std::vector<geom::Transform> _transforms;
+
+    std::vector<geom::Vector3D> _velocities;
+
+    std::vector<geom::Vector3D> _angular_velocities;
+
+    std::vector<geom::Vector3D> _accelerations;
+
+    std::vector<sensor::data::ActorDynamicState::TypeDependentState> _states;
+
+    std::unordered_map<ActorId, uint32_t> _index_by_id;
   };
 
 } // namespace detail
@@ -0,0 +1,74 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/MapDataCache.h"
+
+#include "carla/FileSystem.h"
+#include "carla/road/MapSerializer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  std::string MapDataCache::GetPath(uint64_t hash, const std::string &extension) {
+    std::string dir;
+    if (const char *cache_dir = std::getenv("CARLA_MAP_CACHE_DIR")) {
+      dir = cache_dir;
+    } else if (const char *home = std::getenv("HOME")) {
+      dir = std::string(home) + "/.cache/carla";
+    }
+    if (dir.empty()) {
+      return {};
+    }
+    std::ostringstream path;
+    path << dir << "/map-" << std::hex << std::setw(16) << std::setfill('0') << hash << extension;
+    auto result = path.str();
+    FileSystem::ValidateFilePath(result);
+    return result;
+  }
+
+  boost::optional<std::string> MapDataCache::ReadOpenDrive(uint64_t hash) {
+    const auto path = GetPath(hash, ".xodr");
+    if (path.empty()) {
+      return {};
+    }
+    MappedFile file;
+    if (!file.Open(path)) {
+      return {};
+    }
+    std::string result(reinterpret_cast<const char *>(file.data()), file.size());
+    if (road::MapSerializer::Hash(result) != hash) {
+      return {};
+    }
+    return result;
+  }
+
+  void MapDataCache::WriteOpenDrive(uint64_t hash, const std::string &opendrive_contents) {
+    const auto path = GetPath(hash, ".xodr");
+    if (path.empty()) {
+      return;
+    }
+    const auto tmp_path = path + ".tmp";
+    std::ofstream file(tmp_path, std::ios_base::binary | std::ios_base::trunc);
+    if (!file) {
+      return;
+    }
+    file << opendrive_contents;
+    file.close();
+    if (!file || (std::rename(tmp_path.c_str(), path.c_str()) != 0)) {
+      std::remove(tmp_path.c_str());
+    }
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,47 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Local on-disk cache of map artifacts, keyed by the FNV-1a hash of the
+  /// OpenDRIVE contents (see road::MapSerializer::Hash). Two artifacts share
+  /// each key: the raw ".xodr" text, so repeat get_world() calls skip the
+  /// chunked download, and the binary ".bin" form of the built road map, so
+  /// they also skip the parse (written by client::Map).
+  ///
+  /// The cache directory is taken from CARLA_MAP_CACHE_DIR, falling back to
+  /// $HOME/.cache/carla. Setting CARLA_MAP_CACHE_DIR to an empty value
+  /// disables caching entirely.
+  class MapDataCache {
+  public:
+
+    /// Path of the cache entry for @a hash with @a extension (e.g. ".bin"),
+    /// creating the cache directory if needed. Empty if caching is disabled.
+    static std::string GetPath(uint64_t hash, const std::string &extension);
+
+    /// Cached OpenDRIVE contents for @a hash, empty if not cached or if the
+    /// file fails its hash re-check (e.g. a truncated write from a killed
+    /// process).
+    static boost::optional<std::string> ReadOpenDrive(uint64_t hash);
+
+    /// Store @a opendrive_contents under @a hash. Writes to a temporary and
+    /// renames, so concurrent readers never see a partial file. Failures are
+    /// silent, the cache is best effort.
+    static void WriteOpenDrive(uint64_t hash, const std::string &opendrive_contents);
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
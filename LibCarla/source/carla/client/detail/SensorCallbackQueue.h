@@ -0,0 +1,188 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace carla {
+namespace sensor { class SensorData; }
+namespace client {
+
+  /// What a sensor callback queue does with measurements when the user
+  /// callback cannot keep up with the stream rate, the client-side
+  /// counterpart of streaming::detail::QueuePolicy.
+  enum class SensorQueuePolicy : uint8_t {
+    /// Keep only the most recent pending measurement, older ones are
+    /// discarded.
+    keep_latest,
+
+    /// Queue up to the maximum depth, discarding the oldest measurement
+    /// when full.
+    drop_oldest,
+
+    /// Queue up to the maximum depth, the producer (streaming thread) waits
+    /// for room when full; the backpressure propagates to the stream, where
+    /// the server-side queue policy takes over.
+    block
+  };
+
+namespace detail {
+
+  /// Decouples a sensor's user callback from the deserialization path: Push
+  /// runs on the streaming thread and the callback on a dedicated worker,
+  /// with the configured policy deciding what happens when the callback
+  /// falls behind. Statistics are queryable at any time, see GetStats.
+  class SensorCallbackQueue : private NonCopyable {
+  public:
+
+    using CallbackType = std::function<void(SharedPtr<sensor::SensorData>)>;
+
+    /// Overrun statistics since the queue was created.
+    struct Stats {
+      /// Measurements pushed into the queue.
+      uint64_t received = 0u;
+      /// Callback invocations completed.
+      uint64_t delivered = 0u;
+      /// Measurements discarded by the policy.
+      uint64_t dropped = 0u;
+      /// Pushes that had to wait for room (block policy only).
+      uint64_t blocked = 0u;
+      /// Measurements currently pending.
+      size_t depth = 0u;
+      /// Most measurements ever pending at once.
+      size_t peak_depth = 0u;
+    };
+
+    SensorCallbackQueue(
+        CallbackType callback,
+        SensorQueuePolicy policy,
+        size_t max_depth)
+      : _callback(std::move(callback)),
+        _policy(policy),
+        _max_depth(std::max<size_t>(1u, max_depth)),
+        _worker(&SensorCallbackQueue::Run, this) {}
+
+    ~SensorCallbackQueue() {
+      Stop();
+    }
+
+    /// Called on the streaming thread. Never invokes the callback inline.
+    void Push(SharedPtr<sensor::SensorData> data) {
+      std::unique_lock<std::mutex> lock(_mutex);
+      if (_done) {
+        return;
+      }
+      ++_stats.received;
+      switch (_policy) {
+        case SensorQueuePolicy::keep_latest:
+          if (!_queue.empty()) {
+            _queue.back() = std::move(data);
+            ++_stats.dropped;
+          } else {
+            _queue.emplace_back(std::move(data));
+          }
+          break;
+        case SensorQueuePolicy::drop_oldest:
+          if (_queue.size() >= _max_depth) {
+            _queue.pop_front();
+            ++_stats.dropped;
+          }
+          _queue.emplace_back(std::move(data));
+          break;
+        case SensorQueuePolicy::block:
+          if (_queue.size() >= _max_depth) {
+            ++_stats.blocked;
+            _room.wait(lock, [this]() {
+              return _done || (_queue.size() < _max_depth);
+            });
+            if (_done) {
+              return;
+            }
+          }
+          _queue.emplace_back(std::move(data));
+          break;
+      }
+      _stats.peak_depth = std::max(_stats.peak_depth, _queue.size());
+      _ready.notify_one();
+    }
+
+    /// Stop the worker, delivering what is already queued, and join it.
+    /// Pushes arriving afterwards are ignored.
+    void Stop() {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _done = true;
+      }
+      _ready.notify_all();
+      _room.notify_all();
+      if (_worker.joinable()) {
+        _worker.join();
+      }
+    }
+
+    Stats GetStats() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      Stats stats = _stats;
+      stats.depth = _queue.size();
+      return stats;
+    }
+
+  private:
+
+    void Run() {
+      for (;;) {
+        SharedPtr<sensor::SensorData> data;
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          _ready.wait(lock, [this]() { return _done || !_queue.empty(); });
+          if (_queue.empty()) {
+            return; // stopped and drained
+          }
+          data = std::move(_queue.front());
+          _queue.pop_front();
+          _room.notify_one();
+        }
+        _callback(std::move(data));
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_stats.delivered;
+      }
+    }
+
+    CallbackType _callback;
+
+    const SensorQueuePolicy _policy;
+
+    const size_t _max_depth;
+
+    mutable std::mutex _mutex;
+
+    std::condition_variable _ready;
+
+    /// Signalled when the queue makes room, block policy only.
+    std::condition_variable _room;
+
+    std::deque<SharedPtr<sensor::SensorData>> _queue;
+
+    Stats _stats;
+
+    bool _done = false;
+
+    std::thread _worker;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -72,7 +72,9 @@ namespace detail {
       const uint16_t port,
       const size_t worker_threads,
       const bool enable_garbage_collection)
-    : LIBCARLA_INITIALIZE_LIFETIME_PROFILER("SimulatorClient("s + host + ":" + std::to_string(port) + ")"),
+    : LIBCARLA_INITIALIZE_LIFETIME_PROFILER(
+          "SimulatorClient",
+          "SimulatorClient("s + host + ":" + std::to_string(port) + ")"),
       _client(host, port, worker_threads),
       _light_manager(new LightManager()),
       _gc_policy(enable_garbage_collection ?
@@ -97,6 +99,23 @@ namespace detail {
     throw_exception(std::runtime_error("failed to connect to newly created map"));
   }
 
+  EpisodeProxy Simulator::ResetEpisode(const bool reset_settings, const bool reset_weather) {
+    const auto id = GetCurrentEpisode().GetId();
+    _client.ResetEpisode(reset_settings, reset_weather);
+    // The map does not change, so there is no intermediate episode to skip;
+    // just wait until the state stream reports the new episode id.
+    size_t number_of_attempts = _client.GetTimeout().milliseconds() / 10u;
+    for (auto i = 0u; i < number_of_attempts; ++i) {
+      using namespace std::literals::chrono_literals;
+      _episode->WaitForState(10ms);
+      auto episode = GetCurrentEpisode();
+      if (episode.GetId() != id) {
+        return episode;
+      }
+    }
+    throw_exception(std::runtime_error("failed to reset episode"));
+  }
+
   EpisodeProxy Simulator::LoadOpenDriveEpisode(
       std::string opendrive,
       const rpc::OpendriveGenerationParameters & params) {
@@ -144,7 +163,24 @@ namespace detail {
 
   uint64_t Simulator::Tick(time_duration timeout) {
     DEBUG_ASSERT(_episode != nullptr);
-    const auto frame = _client.SendTickCue();
+    // The fused cue is answered once the resulting frame's state broadcast
+    // is in flight, so the synchronization below resolves almost
+    // immediately instead of spinning through the whole simulated frame.
+    const auto frame = _client.SendFusedTickCue();
+    bool result = SynchronizeFrame(frame, *_episode, timeout);
+    if (!result) {
+      throw_exception(TimeoutException(_client.GetEndpoint(), timeout));
+    }
+    return frame;
+  }
+
+  uint64_t Simulator::BeginTick(double compute_budget_seconds) {
+    DEBUG_ASSERT(_episode != nullptr);
+    return _client.SendTickCueWithDeadline(compute_budget_seconds);
+  }
+
+  uint64_t Simulator::EndTick(uint64_t frame, time_duration timeout) {
+    DEBUG_ASSERT(_episode != nullptr);
     bool result = SynchronizeFrame(frame, *_episode, timeout);
     if (!result) {
       throw_exception(TimeoutException(_client.GetEndpoint(), timeout));
@@ -193,6 +229,38 @@ namespace detail {
     navigation->RegisterWalker(walker->GetId(), controller.GetId());
   }
 
+  void Simulator::RegisterAIControllerFleet(
+      const std::vector<SharedPtr<WalkerAIController>> &controllers,
+      const std::vector<geom::Location> &destinations,
+      const std::vector<float> &max_speeds) {
+    DEBUG_ASSERT(_episode != nullptr);
+    auto navigation = _episode->CreateNavigationIfMissing();
+    DEBUG_ASSERT(navigation != nullptr);
+    std::vector<WalkerNavigation::WalkerFleetEntry> fleet;
+    fleet.reserve(controllers.size());
+    for (size_t i = 0u; i < controllers.size(); ++i) {
+      const auto &controller = controllers[i];
+      DEBUG_ASSERT(controller != nullptr);
+      auto walker = controller->GetParent();
+      if (walker == nullptr) {
+        log_warning(controller->GetDisplayId(), ": not attached to walker, skipped");
+        continue;
+      }
+      WalkerNavigation::WalkerFleetEntry entry;
+      entry.walker = walker->GetId();
+      entry.controller = controller->GetId();
+      entry.location = walker->GetLocation();
+      if (i < destinations.size()) {
+        entry.destination = destinations[i];
+      }
+      if (i < max_speeds.size()) {
+        entry.max_speed = max_speeds[i];
+      }
+      fleet.emplace_back(std::move(entry));
+    }
+    navigation->RegisterWalkers(fleet);
+  }
+
   void Simulator::UnregisterAIController(const WalkerAIController &controller) {
     auto walker = controller.GetParent();
     if (walker == nullptr) {
@@ -25,6 +25,8 @@
 
 #include <boost/optional.hpp>
 
+#include <cstring>
+#include <future>
 #include <memory>
 
 namespace carla {
@@ -68,6 +70,10 @@ namespace detail {
 
     EpisodeProxy LoadEpisode(std::string map_name);
 
+    /// Reset the current episode in place, without reloading the map. Blocks
+    /// until the new episode is reported on the state stream.
+    EpisodeProxy ResetEpisode(bool reset_settings, bool reset_weather);
+
     EpisodeProxy LoadOpenDriveEpisode(
         std::string opendrive,
         const rpc::OpendriveGenerationParameters & params);
@@ -133,6 +139,15 @@ namespace detail {
       return _client.GetTimeout();
     }
 
+    /// @copydoc Client::SetRpcLanes
+    void SetRpcLanes(size_t count) {
+      _client.SetRpcLanes(count);
+    }
+
+    size_t GetRpcLanes() const {
+      return _client.GetRpcLanes();
+    }
+
     std::string GetClientVersion() {
       return _client.GetClientVersion();
     }
@@ -149,6 +164,15 @@ namespace detail {
 
     WorldSnapshot WaitForTick(time_duration timeout);
 
+    /// Spin up to @a micros microseconds for the next tick before parking on
+    /// the condition variable, shaving scheduler wakeup latency off
+    /// WaitForTick for clients stepping sync mode at high rates. Zero (the
+    /// default) always parks.
+    void SetWaitForTickSpinBudget(size_t micros) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->SetWaitForStateSpinBudget(micros);
+    }
+
     size_t RegisterOnTickEvent(std::function<void(WorldSnapshot)> callback) {
       DEBUG_ASSERT(_episode != nullptr);
       return _episode->RegisterOnTickEvent(std::move(callback));
@@ -159,8 +183,54 @@ namespace detail {
       _episode->RemoveOnTickEvent(id);
     }
 
+    void SetConcurrentOnTickCallbacks(size_t worker_threads) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->SetConcurrentOnTickCallbacks(worker_threads);
+    }
+
+    void SetOnTickCallbackDeadline(time_duration deadline) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->SetOnTickCallbackDeadline(deadline);
+    }
+
+    uint64_t GetOnTickCallbackOverruns() const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetOnTickCallbackOverruns();
+    }
+
+    void SetStateHistoryDepth(size_t depth) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->SetStateHistoryDepth(depth);
+    }
+
+    size_t GetStateHistoryDepth() const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetStateHistoryDepth();
+    }
+
+    std::vector<WorldSnapshot> GetStateHistory(size_t max_frames) const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetStateHistory(max_frames);
+    }
+
+    std::vector<std::pair<uint64_t, ActorSnapshot>> GetActorStateHistory(
+        ActorId id,
+        size_t max_frames) const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetActorStateHistory(id, max_frames);
+    }
+
     uint64_t Tick(time_duration timeout);
 
+    /// Initiate the next frame and return immediately with its number,
+    /// without waiting for it to complete; @a compute_budget_seconds
+    /// declares for how long the caller intends to compute concurrently
+    /// before rendezvousing with EndTick.
+    uint64_t BeginTick(double compute_budget_seconds);
+
+    /// Rendezvous with the frame previously initiated by BeginTick.
+    uint64_t EndTick(uint64_t frame, time_duration timeout);
+
     /// @}
     // =========================================================================
     /// @name Access to global objects in the episode
@@ -203,8 +273,22 @@ namespace detail {
       return _client.GetEpisodeSettings();
     }
 
+    /// Like GetEpisodeSettings, but the round trip overlaps with the caller;
+    /// the future throws on error or timeout when retrieved.
+    std::future<rpc::EpisodeSettings> GetEpisodeSettingsAsync() {
+      return _client.GetEpisodeSettingsAsync();
+    }
+
     uint64_t SetEpisodeSettings(const rpc::EpisodeSettings &settings);
 
+    /// Restrict the state stream this client receives to the actors and rate
+    /// selected by @a filter, see rpc::EpisodeStreamFilter. Other clients
+    /// keep receiving the full stream.
+    void ApplyEpisodeStreamFilter(const rpc::EpisodeStreamFilter &filter) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->ApplyStreamFilter(filter);
+    }
+
     rpc::WeatherParameters GetWeatherParameters() {
       return _client.GetWeatherParameters();
     }
@@ -213,8 +297,18 @@ namespace detail {
       _client.SetWeatherParameters(weather);
     }
 
+    void SetWeatherAnimation(const std::vector<rpc::WeatherKeyFrame> &keyframes) {
+      _client.SetWeatherAnimation(keyframes);
+    }
+
     rpc::VehiclePhysicsControl GetVehiclePhysicsControl(const Vehicle &vehicle) const {
-      return _client.GetVehiclePhysicsControl(vehicle.GetId());
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetVehiclePhysicsControl(vehicle.GetId());
+    }
+
+    /// @copydoc GetEpisodeSettingsAsync
+    std::future<rpc::VehiclePhysicsControl> GetVehiclePhysicsControlAsync(const Vehicle &vehicle) const {
+      return _client.GetVehiclePhysicsControlAsync(vehicle.GetId());
     }
 
     rpc::VehicleLightState GetVehicleLightState(const Vehicle &vehicle) const {
@@ -229,6 +323,14 @@ namespace detail {
 
     void RegisterAIController(const WalkerAIController &controller);
 
+    /// Register a whole fleet of walker AI controllers in one call.
+    /// @a destinations and @a max_speeds run parallel to @a controllers and
+    /// may be empty to leave the walkers idle at their spawn point.
+    void RegisterAIControllerFleet(
+        const std::vector<SharedPtr<WalkerAIController>> &controllers,
+        const std::vector<geom::Location> &destinations,
+        const std::vector<float> &max_speeds);
+
     void UnregisterAIController(const WalkerAIController &controller);
 
     boost::optional<geom::Location> GetRandomLocationFromNavigation();
@@ -260,6 +362,14 @@ namespace detail {
       return _episode->GetActors();
     }
 
+    /// Keep the actor cache in sync with the spawn and destroy events of the
+    /// state stream, so GetAllTheActorsInTheEpisode skips the round trip to
+    /// the simulator while the actor set is unchanged.
+    void SetActorListSubscription(bool enabled) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->SetActorListSubscription(enabled);
+    }
+
     /// Creates an actor instance out of a description of an existing actor.
     /// Note that this does not spawn an actor.
     ///
@@ -279,6 +389,10 @@ namespace detail {
     /// returned is provided with a custom deleter that calls Destroy() on the
     /// actor. If @gc is GarbageCollectionPolicy::Inherit, the default garbage
     /// collection policy is used.
+    void PrewarmActors(const std::vector<std::string> &blueprint_ids) {
+      _client.PrewarmActors(blueprint_ids);
+    }
+
     SharedPtr<Actor> SpawnActor(
         const ActorBlueprint &blueprint,
         const geom::Transform &transform,
@@ -337,6 +451,12 @@ namespace detail {
       _client.SetActorLocation(actor.GetId(), location);
     }
 
+    std::vector<rpc::ActorSyncState> ExchangeActorStates(
+        const std::vector<rpc::ActorTransformUpdate> &updates,
+        const std::vector<ActorId> &query_ids) {
+      return _client.ExchangeActorStates(updates, query_ids);
+    }
+
     void SetActorTransform(Actor &actor, const geom::Transform &transform) {
       _client.SetActorTransform(actor.GetId(), transform);
     }
@@ -372,6 +492,8 @@ namespace detail {
     }
 
     void ApplyPhysicsControlToVehicle(Vehicle &vehicle, const rpc::VehiclePhysicsControl &physicsControl) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->InvalidatePhysicsControl(vehicle.GetId());
       _client.ApplyPhysicsControlToVehicle(vehicle.GetId(), physicsControl);
     }
 
@@ -385,8 +507,58 @@ namespace detail {
     // =========================================================================
     /// @{
 
-    std::string StartRecorder(std::string name) {
-      return _client.StartRecorder(std::move(name));
+    void StartTrace(uint64_t max_events) {
+      _client.StartTrace(max_events);
+    }
+
+    void StopTrace(void) {
+      _client.StopTrace();
+    }
+
+    std::string GetTrace(void) {
+      return _client.GetTrace();
+    }
+
+    rpc::ObjectCensus GetObjectCensus() const {
+      return _client.GetObjectCensus();
+    }
+
+    rpc::FrameStats GetFrameStats() const {
+      return _client.GetFrameStats();
+    }
+
+    std::vector<rpc::BufferPoolStats> GetBufferPoolStats() const {
+      return _client.GetBufferPoolStats();
+    }
+
+    std::string StartRecorder(std::string name, std::string filter) {
+      return _client.StartRecorder(std::move(name), std::move(filter));
+    }
+
+    /// Start the recorder streaming its blocks to this client instead of
+    /// writing them on the simulator host; @a callback receives the info
+    /// header and then each compressed block, appending them to a file in
+    /// arrival order reproduces the recorder file. Blocks produced before
+    /// this client is subscribed fall back to the server-side file named
+    /// @a name. The subscription closes itself when the recording stops.
+    void StartRecorderStream(
+        std::string name,
+        std::string filter,
+        std::function<void(Buffer)> callback) {
+      const auto token = _client.StartRecorderStream(std::move(name), std::move(filter));
+      _client.SubscribeToStream(token, [this, token, callback=std::move(callback)](Buffer buffer) {
+        // a block header with both sizes zeroed marks the end of the
+        // recording, see CarlaRecorderFileWriter
+        uint32_t sizes[2u] = {1u, 1u};
+        if (buffer.size() == sizeof(sizes)) {
+          std::memcpy(sizes, buffer.data(), sizeof(sizes));
+        }
+        if ((sizes[0u] == 0u) && (sizes[1u] == 0u)) {
+          _client.UnSubscribeFromStream(token);
+          return;
+        }
+        callback(std::move(buffer));
+      });
     }
 
     void StopRecorder(void) {
@@ -417,6 +589,10 @@ namespace detail {
       _client.SetReplayerIgnoreHero(ignore_hero);
     }
 
+    double FastForwardReplayer(double time) {
+      return _client.FastForwardReplayer(time);
+    }
+
     /// @}
     // =========================================================================
     /// @name Operations with sensors
@@ -429,6 +605,14 @@ namespace detail {
 
     void UnSubscribeFromSensor(const Sensor &sensor);
 
+    std::vector<uint8_t> RedirectSensorStream(ActorId id, std::string host, uint16_t port) {
+      return _client.RedirectSensorStream(id, std::move(host), port);
+    }
+
+    void AdoptSensorStream(ActorId id, std::vector<uint8_t> token) {
+      _client.AdoptSensorStream(id, std::move(token));
+    }
+
     /// @}
     // =========================================================================
     /// @name Operations with traffic lights
@@ -459,6 +643,18 @@ namespace detail {
       return _client.GetGroupTrafficLights(trafficLight.GetId());
     }
 
+    /// State, timing and group of every traffic light of the episode in a
+    /// single round trip.
+    std::vector<rpc::TrafficLightSnapshot> GetTrafficLightSnapshots() const {
+      return _client.GetTrafficLightSnapshots();
+    }
+
+    /// Set the state of several traffic lights with one call.
+    void SetTrafficLightStates(
+        const std::vector<std::pair<rpc::ActorId, rpc::TrafficLightState>> &states) {
+      _client.SetTrafficLightStates(states);
+    }
+
     /// @}
     // =========================================================================
     /// @name Debug
@@ -497,8 +693,13 @@ namespace detail {
       return _client.QueryLightsStateToServer();
     }
 
+    /// @copydoc GetEpisodeSettingsAsync
+    std::future<std::vector<rpc::LightState>> QueryLightsStateToServerAsync() const {
+      return _client.QueryLightsStateToServerAsync();
+    }
+
     void UpdateServerLightsState(
-        std::vector<rpc::LightState>& lights,
+        std::vector<rpc::LightStateDelta>& lights,
         bool discard_client = false) const {
       _client.UpdateServerLightsState(lights, discard_client);
     }
@@ -14,15 +14,25 @@
 #include "carla/rpc/DebugShape.h"
 #include "carla/rpc/WalkerControl.h"
 
+#include <cmath>
 #include <sstream>
 
 namespace carla {
 namespace client {
 namespace detail {
 
+  /// squared displacement (in meters) a vehicle needs before its crowd
+  /// obstacle is refreshed
+  static const float VEHICLE_MOVED_EPSILON_SQUARED = 0.0001f;
+  /// yaw change (in degrees) a vehicle needs before its crowd obstacle is
+  /// refreshed
+  static const float VEHICLE_ROTATED_EPSILON = 0.1f;
+
   WalkerNavigation::WalkerNavigation(Client &client) : _client(client), _next_check_index(0) {
     // Here call the server to retrieve the navmesh data.
     _nav.Load(_client.GetNavigationMesh());
+    // a single worker steps the crowd off the tick path
+    _pool.AsyncRun(1u);
   }
 
   void WalkerNavigation::Tick(std::shared_ptr<Episode> episode) {
@@ -31,6 +41,31 @@ namespace detail {
       return;
     }
 
+    // send the transforms published by the last crowd step, all walkers in a
+    // single command
+    auto output = _output.load();
+    if ((output != nullptr) && (output->id != _last_output_sent) && !output->updates.empty()) {
+      _last_output_sent = output->id;
+      using Cmd = rpc::Command;
+      std::vector<Cmd> commands;
+      commands.emplace_back(Cmd::ApplyWalkerBatch{ output->updates });
+      _client.ApplyBatch(std::move(commands), false);
+    }
+
+    // step the crowd in the background; if the previous step is still
+    // running, let it catch up instead of queueing work behind it
+    bool expected = false;
+    if (_step_pending.compare_exchange_strong(expected, true)) {
+      _pool.Post([this, episode = std::move(episode)]() {
+        StepCrowd(episode);
+        _step_pending = false;
+      });
+    }
+  }
+
+  void WalkerNavigation::StepCrowd(std::shared_ptr<Episode> episode) {
+    auto walkers = _walkers.Load();
+
     // get current state
     std::shared_ptr<const EpisodeState> state = episode->GetState();
 
@@ -44,18 +79,19 @@ namespace detail {
     _nav.UpdateCrowd(*state);
 
     carla::geom::Transform trans;
-    using Cmd = rpc::Command;
-    std::vector<Cmd> commands;
-    commands.reserve(walkers->size());
+    auto output = std::make_shared<StepOutput>();
+    output->id = ++_step_count;
+    output->updates.reserve(walkers->size());
     for (auto handle : *walkers) {
       // get the transform of the walker
       if (_nav.GetWalkerTransform(handle.walker, trans)) {
         float speed = _nav.GetWalkerSpeed(handle.walker);
-        commands.emplace_back(Cmd::ApplyWalkerState{ handle.walker, trans, speed });
+        output->updates.emplace_back(handle.walker, trans, speed);
       }
     }
 
-    _client.ApplyBatch(std::move(commands), false);
+    // publish the back buffer, the next tick sends it
+    _output = output;
   }
 
   void WalkerNavigation::CheckIfWalkerExist(std::vector<WalkerHandle> walkers, const EpisodeState &state) {
@@ -80,24 +116,64 @@ namespace detail {
 
   // add/update/delete all vehicles in crowd
   void WalkerNavigation::UpdateVehiclesInCrowd(std::shared_ptr<Episode> episode, bool show_debug) {
-    std::vector<carla::nav::VehicleCollisionInfo> vehicles;
 
     // get current state
     std::shared_ptr<const EpisodeState> state = episode->GetState();
 
-    // get all vehicles from episode
-    for (auto &&actor : episode->GetActors()) {
-      // only vehicles
-      if (actor.description.id.rfind("vehicle.", 0) == 0) {
-        // get the snapshot
-        ActorSnapshot snapshot = state->GetActorSnapshot(actor.id);
-        // add to the vector
-        vehicles.emplace_back(carla::nav::VehicleCollisionInfo{actor.id, snapshot.transform, actor.bounding_box});
+    // collect the actors seen for the first time; a single batch lookup
+    // classifies them, so each actor pays the description check only once
+    std::vector<ActorId> unknown;
+    for (auto id : state->GetActorIds()) {
+      if (_vehicle_obstacles.find(id) == _vehicle_obstacles.end() &&
+          _not_vehicles.find(id) == _not_vehicles.end()) {
+        unknown.push_back(id);
       }
     }
+    if (!unknown.empty()) {
+      for (auto &&actor : episode->GetActorsById(unknown)) {
+        // only vehicles become obstacles
+        if (actor.description.id.rfind("vehicle.", 0) == 0) {
+          ActorSnapshot snapshot = state->GetActorSnapshot(actor.id);
+          carla::nav::VehicleCollisionInfo vehicle {actor.id, snapshot.transform, actor.bounding_box};
+          _nav.AddOrUpdateVehicle(vehicle);
+          _vehicle_obstacles[actor.id] = VehicleObstacle {snapshot.transform, actor.bounding_box};
+        } else {
+          _not_vehicles.insert(actor.id);
+        }
+      }
+    }
+
+    // refresh or remove the known obstacles; only vehicles that actually
+    // moved beyond the threshold touch their crowd agents
+    auto transforms = state->GetTransforms();
+    for (auto it = _vehicle_obstacles.begin(); it != _vehicle_obstacles.end(); ) {
+      auto index = state->GetActorIndex(it->first);
+      if (!index.has_value()) {
+        // gone from the state, remove its obstacle from the crowd
+        _nav.RemoveAgent(it->first);
+        it = _vehicle_obstacles.erase(it);
+        continue;
+      }
+      const geom::Transform &current = transforms.begin()[*index];
+      VehicleObstacle &obstacle = it->second;
+      const float dist_squared = (current.location - obstacle.transform.location).SquaredLength();
+      const float yaw_delta = std::abs(current.rotation.yaw - obstacle.transform.rotation.yaw);
+      if (dist_squared > VEHICLE_MOVED_EPSILON_SQUARED || yaw_delta > VEHICLE_ROTATED_EPSILON) {
+        carla::nav::VehicleCollisionInfo vehicle {it->first, current, obstacle.bounding_box};
+        _nav.AddOrUpdateVehicle(vehicle);
+        obstacle.transform = current;
+      }
+      ++it;
+    }
 
-    // update the vehicles found
-    _nav.UpdateVehicles(vehicles);
+    // forget destroyed actors, ids are never reused
+    for (auto it = _not_vehicles.begin(); it != _not_vehicles.end(); ) {
+      if (!state->ContainsActorSnapshot(*it)) {
+        it = _not_vehicles.erase(it);
+      } else {
+        ++it;
+      }
+    }
 
     // optional debug info
     if (show_debug) {
@@ -7,13 +7,22 @@
 #pragma once
 
 #include "carla/AtomicList.h"
+#include "carla/AtomicSharedPtr.h"
 #include "carla/nav/Navigation.h"
 #include "carla/NonCopyable.h"
+#include "carla/TaskExecutor.h"
 #include "carla/client/Timestamp.h"
 #include "carla/client/detail/EpisodeProxy.h"
 #include "carla/rpc/ActorId.h"
+#include "carla/rpc/Command.h"
 
+#include <boost/optional.hpp>
+
+#include <atomic>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace carla {
 namespace client {
@@ -59,6 +68,53 @@ namespace detail {
       _nav.AddWalker(walker_id, location);
     }
 
+    /// One entry of a walker fleet registration; destination and max speed
+    /// are applied only when present.
+    struct WalkerFleetEntry {
+      ActorId walker;
+      ActorId controller;
+      geom::Location location;
+      boost::optional<geom::Location> destination;
+      boost::optional<float> max_speed;
+    };
+
+    /// Register a whole fleet of walkers at once: a single copy of the
+    /// walker list covers all of them, and each walker is added to the crowd
+    /// with its destination and max speed already set.
+    void RegisterWalkers(const std::vector<WalkerFleetEntry> &fleet) {
+      std::vector<WalkerHandle> handles;
+      handles.reserve(fleet.size());
+      for (const auto &entry : fleet) {
+        handles.emplace_back(WalkerHandle{entry.walker, entry.controller});
+      }
+      _walkers.PushMany(handles);
+      for (const auto &entry : fleet) {
+        _nav.AddWalker(entry.walker, entry.location);
+        if (entry.destination) {
+          _nav.SetWalkerTarget(entry.walker, *entry.destination);
+        }
+        if (entry.max_speed) {
+          _nav.SetWalkerMaxSpeed(entry.walker, *entry.max_speed);
+        }
+      }
+    }
+
+    // set a new target point for a whole batch of walkers
+    void SetWalkerTargets(const std::vector<std::pair<ActorId, geom::Location>> &targets) {
+      for (const auto &target : targets) {
+        _nav.SetWalkerTarget(target.first, target.second);
+      }
+    }
+
+    // set a new max speed for a whole batch of walkers
+    void SetWalkerMaxSpeeds(const std::vector<std::pair<ActorId, float>> &speeds) {
+      for (const auto &speed : speeds) {
+        _nav.SetWalkerMaxSpeed(speed.first, speed.second);
+      }
+    }
+
+    /// Send out the transforms published by the last crowd step and schedule
+    /// the next step on the worker thread; never blocks on the crowd.
     void Tick(std::shared_ptr<Episode> episode);
 
     // Get Random location in nav mesh
@@ -100,10 +156,48 @@ namespace detail {
 
     AtomicList<WalkerHandle> _walkers;
 
+    /// walker transforms computed by one crowd step, waiting to be sent
+    struct StepOutput {
+      uint64_t id = 0u;
+      std::vector<rpc::Command::ApplyWalkerBatch::WalkerUpdate> updates;
+    };
+
+    /// last pose pushed to the crowd for one vehicle obstacle
+    struct VehicleObstacle {
+      geom::Transform transform;
+      geom::BoundingBox bounding_box;
+    };
+
+    /// vehicle obstacles currently registered in the crowd, maintained
+    /// incrementally from the state deltas; only touched from the worker
+    std::unordered_map<ActorId, VehicleObstacle> _vehicle_obstacles;
+
+    /// actors already classified as not being vehicles, so they are looked
+    /// up only once; only touched from the worker
+    std::unordered_set<ActorId> _not_vehicles;
+
     /// check a few walkers and if they don't exist then remove from the crowd
     void CheckIfWalkerExist(std::vector<WalkerHandle> walkers, const EpisodeState &state);
     /// add/update/delete all vehicles in crowd
     void UpdateVehiclesInCrowd(std::shared_ptr<Episode> episode, bool show_debug = false);
+    /// step the crowd on the worker thread and publish the resulting
+    /// transforms in @a _output
+    void StepCrowd(std::shared_ptr<Episode> episode);
+
+    /// double buffer between the worker and the tick: the worker publishes
+    /// here, the tick sends each buffer at most once
+    AtomicSharedPtr<const StepOutput> _output;
+
+    /// only touched from the tick
+    uint64_t _last_output_sent = 0u;
+
+    /// only touched from the worker
+    uint64_t _step_count = 0u;
+
+    std::atomic_bool _step_pending{false};
+
+    /// declared last so it joins the worker before the rest is destroyed
+    TaskExecutor _pool;
   };
 
 } // namespace detail
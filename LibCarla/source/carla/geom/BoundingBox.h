@@ -8,11 +8,15 @@
 
 #include "carla/Debug.h"
 #include "carla/MsgPack.h"
+#include "carla/geom/Math.h"
 #include "carla/geom/Transform.h"
 #include "carla/geom/Location.h"
 #include "carla/geom/Vector3D.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
 
 #ifdef LIBCARLA_INCLUDED_FROM_UE4
 #  include "Carla/Util/BoundingBox.h"
@@ -59,6 +63,93 @@ namespace geom {
                 point_in_bbox_space.z >= -extent.z && point_in_bbox_space.z <= extent.z;
     }
 
+    /**
+     * Batched version of Contains: tests @a count world-space points against
+     * this box, writing 1 or 0 per point to @a out_results. The inverse box
+     * transform is computed once for the whole batch instead of once per
+     * point, and the loop is kept vectorizable.
+     */
+    void ContainsPoints(
+        const Location *in_world_points,
+        size_t count,
+        uint8_t *out_results,
+        const Transform &in_bbox_to_world_transform) const {
+      const auto m = in_bbox_to_world_transform.GetRotationMatrix();
+      const auto &origin = in_bbox_to_world_transform.location;
+      for (size_t i = 0u; i < count; ++i) {
+        const float x = in_world_points[i].x - origin.x;
+        const float y = in_world_points[i].y - origin.y;
+        const float z = in_world_points[i].z - origin.z;
+        // Multiply by the transpose to take the point into box space.
+        const float bx = (x * m[0] + y * m[3] + z * m[6]) - location.x;
+        const float by = (x * m[1] + y * m[4] + z * m[7]) - location.y;
+        const float bz = (x * m[2] + y * m[5] + z * m[8]) - location.z;
+        out_results[i] =
+            (bx >= -extent.x) && (bx <= extent.x) &&
+            (by >= -extent.y) && (by <= extent.y) &&
+            (bz >= -extent.z) && (bz <= extent.z);
+      }
+    }
+
+    /**
+     * Batch culling kernel: for each of the @a count boxes, placed in the
+     * world by the matching entry of @a in_bbox_to_world_transforms, writes
+     * to @a out_results whether it intersects the sphere at @a center with
+     * radius @a radius. The test is exact on the oriented box: the center is
+     * taken to box space and clamped to the extents.
+     */
+    static void IntersectSphere(
+        const BoundingBox *boxes,
+        const Transform *in_bbox_to_world_transforms,
+        size_t count,
+        const Location &center,
+        float radius,
+        uint8_t *out_results) {
+      const float radius_squared = radius * radius;
+      for (size_t i = 0u; i < count; ++i) {
+        auto center_in_bbox_space = center;
+        in_bbox_to_world_transforms[i].InverseTransformPoint(center_in_bbox_space);
+        center_in_bbox_space -= boxes[i].location;
+        const float dx = std::max(std::abs(center_in_bbox_space.x) - boxes[i].extent.x, 0.0f);
+        const float dy = std::max(std::abs(center_in_bbox_space.y) - boxes[i].extent.y, 0.0f);
+        const float dz = std::max(std::abs(center_in_bbox_space.z) - boxes[i].extent.z, 0.0f);
+        out_results[i] = (dx * dx + dy * dy + dz * dz) <= radius_squared;
+      }
+    }
+
+    /**
+     * Batch culling kernel: for each of the @a count boxes, placed in the
+     * world by the matching entry of @a in_bbox_to_world_transforms, writes
+     * to @a out_results whether it may intersect the convex volume bounded
+     * by the @a plane_count planes (unit normal plus offset, a point p is
+     * inside the volume when Dot(normal, p) + offset >= 0 for every plane).
+     * Each box is reduced to its world-space bounding sphere, so the test is
+     * conservative: a box near an edge of the volume may be reported inside,
+     * never the opposite.
+     */
+    static void IntersectFrustum(
+        const BoundingBox *boxes,
+        const Transform *in_bbox_to_world_transforms,
+        size_t count,
+        const Vector3D *plane_normals,
+        const float *plane_offsets,
+        size_t plane_count,
+        uint8_t *out_results) {
+      for (size_t i = 0u; i < count; ++i) {
+        auto center = boxes[i].location;
+        in_bbox_to_world_transforms[i].TransformPoint(center);
+        const float radius = boxes[i].extent.Length();
+        uint8_t inside = 1u;
+        for (size_t p = 0u; p < plane_count; ++p) {
+          if (Math::Dot(plane_normals[p], center) + plane_offsets[p] < -radius) {
+            inside = 0u;
+            break;
+          }
+        }
+        out_results[i] = inside;
+      }
+    }
+
     /**
      *  Returns the positions of the 8 vertices of this BoundingBox in local space.
      */
@@ -9,6 +9,8 @@
 #include "carla/Debug.h"
 
 #include <array>
+#include <cstddef>
+#include <utility>
 
 namespace carla {
 namespace geom {
@@ -28,7 +30,7 @@ namespace geom {
 
     CubicPolynomial(const CubicPolynomial &) = default;
 
-    CubicPolynomial(
+    constexpr CubicPolynomial(
         const value_type &a,
         const value_type &b,
         const value_type &c,
@@ -36,7 +38,7 @@ namespace geom {
       : _v{ {a, b, c, d} },
         _s(0.0) {}
 
-    CubicPolynomial(
+    constexpr CubicPolynomial(
         const value_type &a,
         const value_type &b,
         const value_type &c,
@@ -102,17 +104,54 @@ namespace geom {
     // -- Evaluate methods -----------------------------------------------------
     // =========================================================================
 
-    /// Evaluates f(x) = a + bx + cx^2 + dx^3
-    value_type Evaluate(const value_type &x) const {
+    /// Evaluates f(x) = a + bx + cx^2 + dx^3 in Horner form.
+    constexpr value_type Evaluate(const value_type &x) const {
       // return _v[0] + _v[1] * (x) + _v[2] * (x * x) + _v[3] * (x * x * x);
       return _v[0] + x * (_v[1] + x * (_v[2] + x * _v[3]));
     }
 
     /// Evaluates the tangent using df/dx = b + 2cx + 3dx^2
-    value_type Tangent(const value_type &x) const {
+    constexpr value_type Tangent(const value_type &x) const {
       return _v[1] + x * (2 * _v[2] + x * 3 * _v[3]);
     }
 
+    /// Evaluates f(x) and df/dx in a single call, for the callers that need
+    /// both (elevation and spline sampling compute them separately today).
+    constexpr std::pair<value_type, value_type> EvaluateWithTangent(const value_type &x) const {
+      return std::pair<value_type, value_type>(
+          _v[0] + x * (_v[1] + x * (_v[2] + x * _v[3])),
+          _v[1] + x * (2 * _v[2] + x * 3 * _v[3]));
+    }
+
+    /// Evaluates f over @a count values of x, writing one result per input;
+    /// the coefficients are loaded once and the loop is vectorizable.
+    void EvaluateMany(const value_type *xs, size_t count, value_type *out) const {
+      const value_type a = _v[0];
+      const value_type b = _v[1];
+      const value_type c = _v[2];
+      const value_type d = _v[3];
+      for (size_t i = 0u; i < count; ++i) {
+        out[i] = a + xs[i] * (b + xs[i] * (c + xs[i] * d));
+      }
+    }
+
+    /// As EvaluateMany, but also writing the tangent of each value into
+    /// @a out_tangents.
+    void EvaluateManyWithTangent(
+        const value_type *xs,
+        size_t count,
+        value_type *out,
+        value_type *out_tangents) const {
+      const value_type a = _v[0];
+      const value_type b = _v[1];
+      const value_type c = _v[2];
+      const value_type d = _v[3];
+      for (size_t i = 0u; i < count; ++i) {
+        out[i] = a + xs[i] * (b + xs[i] * (c + xs[i] * d));
+        out_tangents[i] = b + xs[i] * (2 * c + xs[i] * 3 * d);
+      }
+    }
+
     // =========================================================================
     // -- Arithmetic operators -------------------------------------------------
     // =========================================================================
@@ -47,30 +47,30 @@ namespace geom {
     lat = 360.0 * std::atan(std::exp(my / (EARTH_RADIUS_EQUA * scale))) / Math::Pi<double>() - 90.0;
   }
 
-  /// Adds meters dx/dy to given lat/lon and returns new lat/lon.
-  static void LatLonAddMeters(
-      double lat_start,
-      double lon_start,
-      double dx,
-      double dy,
-      double &lat_end,
-      double &lon_end) {
-    double scale = LatToScale(lat_start);
-    double mx, my;
-    LatLonToMercator(lat_start, lon_start, scale, mx, my);
-    mx += dx;
-    my += dy;
-    MercatorToLatLon(mx, my, scale, lat_end, lon_end);
-  }
-
   GeoLocation GeoLocation::Transform(const Location &location) const {
-    GeoLocation result{0.0, 0.0, altitude + location.z};
-    LatLonAddMeters(
-        latitude, longitude,
-        location.x, -location.y,  // Invert y axis to have increasing latitudes northward
-        result.latitude, result.longitude);
+    GeoLocation result;
+    Transform(&location, 1u, &result);
     return result;
   }
 
+  void GeoLocation::Transform(
+      const Location *locations,
+      size_t count,
+      GeoLocation *results) const {
+    // The scale and the mercator projection of the geo-reference are the
+    // same for every point, so compute them once outside the loop.
+    const double scale = LatToScale(latitude);
+    double ref_mx, ref_my;
+    LatLonToMercator(latitude, longitude, scale, ref_mx, ref_my);
+    for (size_t i = 0u; i < count; ++i) {
+      const double mx = ref_mx + locations[i].x;
+      // Invert y axis to have increasing latitudes northward
+      const double my = ref_my - locations[i].y;
+      GeoLocation result{0.0, 0.0, altitude + locations[i].z};
+      MercatorToLatLon(mx, my, scale, result.latitude, result.longitude);
+      results[i] = result;
+    }
+  }
+
 } // namespace geom
 } // namespace carla
@@ -8,6 +8,8 @@
 
 #include "carla/MsgPack.h"
 
+#include <cstddef>
+
 namespace carla {
 namespace geom {
 
@@ -45,6 +47,12 @@ namespace geom {
     /// geo-reference.
     GeoLocation Transform(const Location &location) const;
 
+    /// Batched version of Transform: converts @a count locations in one
+    /// call, hoisting the projection of the geo-reference out of the
+    /// per-point loop, and writes one GeoLocation per input location into
+    /// @a results.
+    void Transform(const Location *locations, size_t count, GeoLocation *results) const;
+
     // =========================================================================
     // -- Comparison operators -------------------------------------------------
     // =========================================================================
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "carla/MsgPackAdaptors.h"
 #include "carla/geom/Vector3D.h"
 #include "carla/geom/Math.h"
 
@@ -91,3 +92,7 @@ namespace geom {
 
 } // namespace geom
 } // namespace carla
+
+static_assert(sizeof(carla::geom::Location) == sizeof(carla::geom::Vector3D), "unexpected Location layout");
+
+CARLA_MSGPACK_FLAT_VECTOR(carla::geom::Location)
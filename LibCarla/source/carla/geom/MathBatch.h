@@ -0,0 +1,146 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/geom/Math.h"
+#include "carla/geom/Transform.h"
+#include "carla/geom/Vector3D.h"
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace carla {
+namespace geom {
+
+  /// Batch companions of the scalar helpers in geom::Math and
+  /// geom::Transform. Each kernel applies one operation to a contiguous
+  /// array of points, hoisting the per-call setup (trigonometry, segment
+  /// lengths) out of the loop and keeping the loop body branch-light so
+  /// the compiler can vectorize it.
+  class MathBatch {
+  public:
+
+    /// Distances of @a count points to the segment (v, w). Writes one
+    /// (distance along segment, euclidean distance) pair per point,
+    /// equivalent to calling Math::DistanceSegmentToPoint per point.
+    static void DistanceSegmentToPoints(
+        const Vector3D *points,
+        size_t count,
+        const Vector3D &v,
+        const Vector3D &w,
+        std::pair<float, float> *results) {
+      const float l2 = Math::DistanceSquared2D(v, w);
+      if (l2 == 0.0f) {
+        for (size_t i = 0u; i < count; ++i) {
+          results[i] = std::make_pair(0.0f, Math::Distance2D(v, points[i]));
+        }
+        return;
+      }
+      const float l = std::sqrt(l2);
+      const Vector3D d = w - v;
+      for (size_t i = 0u; i < count; ++i) {
+        const float dot_p_w = Math::Dot2D(points[i] - v, d);
+        const float t = Math::Clamp(dot_p_w / l2);
+        const Vector3D projection = v + t * d;
+        results[i] = std::make_pair(t * l, Math::Distance2D(projection, points[i]));
+      }
+    }
+
+    /// Arc projections of @a count points. Writes one (distance along arc,
+    /// euclidean distance) pair per point, equivalent to calling
+    /// Math::DistanceArcToPoint per point but computing the axis flip, the
+    /// heading rotation and the arc end point only once.
+    static void DistanceArcToPoints(
+        const Vector3D *points,
+        size_t count,
+        const Vector3D &start_pos,
+        const float length,
+        const float heading,   // [radians]
+        const float curvature,
+        std::pair<float, float> *results) {
+      // Same axis inversion as the scalar version: the algorithm works for
+      // positive curvatures, so mirror the y axis (along with curvature and
+      // heading) when needed; distances are preserved.
+      const float y_sign = (curvature > 0.0f) ? 1.0f : -1.0f;
+      const float eff_heading = heading * y_sign;
+      const float eff_curvature = curvature * y_sign;
+      const float start_x = start_pos.x;
+      const float start_y = start_pos.y * y_sign;
+
+      const float cos_h = std::cos(-eff_heading);
+      const float sin_h = std::sin(-eff_heading);
+      const float radius = 1.0f / eff_curvature;
+      const Vector3D circ_center(0.0f, radius, 0.0f);
+      const float last_point_angle = length / radius;
+      constexpr float pi_half = Math::Pi<float>() / 2.0f;
+      const Vector3D end_pos(
+          radius * std::cos(last_point_angle - pi_half),
+          radius * std::sin(last_point_angle - pi_half) + circ_center.y,
+          0.0f);
+
+      for (size_t i = 0u; i < count; ++i) {
+        const float dx = points[i].x - start_x;
+        const float dy = points[i].y * y_sign - start_y;
+        const Vector3D rotated_p(dx * cos_h - dy * sin_h, dx * sin_h + dy * cos_h, 0.0f);
+        if (rotated_p == circ_center) {
+          results[i] = std::make_pair(0.0f, radius);
+          continue;
+        }
+        const Vector3D intersection =
+            ((rotated_p - circ_center).MakeUnitVector() * radius) + circ_center;
+        float angle = std::atan2(intersection.y - radius, intersection.x) + pi_half;
+        if (angle < 0.0f) {
+          angle += Math::Pi<float>() * 2.0f;
+        }
+        if (angle <= last_point_angle) {
+          results[i] = std::make_pair(
+              angle * radius,
+              Math::Distance2D(intersection, rotated_p));
+          continue;
+        }
+        const float start_dist = Math::Distance2D(Vector3D(), rotated_p);
+        const float end_dist = Math::Distance2D(end_pos, rotated_p);
+        results[i] = (start_dist < end_dist) ?
+            std::make_pair(0.0f, start_dist) :
+            std::make_pair(length, end_dist);
+      }
+    }
+
+    /// Applies @a transform to @a count points in place, computing the
+    /// rotation matrix once instead of once per point as
+    /// Transform::TransformPoint does.
+    static void TransformPoints(
+        const Transform &transform,
+        Vector3D *points,
+        size_t count) {
+      transform.TransformPoints(points, count);
+    }
+
+    /// Offsets @a count points laterally by @a width along the
+    /// perpendicular of their headings (left-handed system), writing
+    /// location + offset into @a left and location - offset into @a right;
+    /// used to trace path boundaries.
+    static void LateralOffsets(
+        const Vector3D *locations,
+        const Vector3D *headings,
+        size_t count,
+        const float width,
+        Vector3D *left,
+        Vector3D *right) {
+      for (size_t i = 0u; i < count; ++i) {
+        const Vector3D perpendicular(-headings[i].y, headings[i].x, headings[i].z);
+        const Vector3D scaled_perpendicular = perpendicular * width;
+        left[i] = locations[i] + scaled_perpendicular;
+        right[i] = locations[i] - scaled_perpendicular;
+      }
+    }
+
+  };
+
+} // namespace geom
+} // namespace carla
@@ -6,9 +6,11 @@
 
 #include <carla/geom/Mesh.h>
 
+#include <cstdint>
 #include <string>
 #include <sstream>
 #include <ios>
+#include <unordered_map>
 
 #include <carla/geom/Math.h>
 
@@ -36,6 +38,106 @@ namespace geom {
     return true;
   }
 
+  void Mesh::Reserve(size_t vertices_count, size_t indexes_count) {
+    _vertices.reserve(vertices_count);
+    _normals.reserve(vertices_count);
+    _indexes.reserve(indexes_count);
+    _uvs.reserve(vertices_count);
+  }
+
+  /// Hash of the spatial grid cell (x, y, z). Collisions between different
+  /// cells are harmless, they only add weld candidates that the distance
+  /// check discards.
+  static uint64_t CellHash(int64_t x, int64_t y, int64_t z) {
+    return static_cast<uint64_t>(x) * 73856093u ^
+        static_cast<uint64_t>(y) * 19349663u ^
+        static_cast<uint64_t>(z) * 83492791u;
+  }
+
+  size_t Mesh::Weld(float vertex_distance) {
+    if (_vertices.empty() || vertex_distance <= 0.0f) {
+      return 0u;
+    }
+    // Attribute arrays are only considered when they are complete, an
+    // inconsistent mesh is welded by position alone.
+    const bool has_normals = _normals.size() == _vertices.size();
+    const bool has_uvs = _uvs.size() == _vertices.size();
+    const float squared_distance = vertex_distance * vertex_distance;
+    const auto cell_of = [vertex_distance](float value) {
+      return static_cast<int64_t>(std::floor(value / vertex_distance));
+    };
+
+    // Cells are as wide as the weld distance so a matching vertex can only
+    // live in the cell of the query point or in one of its 26 neighbors.
+    std::unordered_map<uint64_t, std::vector<index_type>> grid;
+    grid.reserve(_vertices.size());
+    std::vector<vertex_type> welded_vertices;
+    welded_vertices.reserve(_vertices.size());
+    std::vector<normal_type> welded_normals;
+    std::vector<uv_type> welded_uvs;
+    std::vector<index_type> remap(_vertices.size());
+
+    for (size_t i = 0u; i < _vertices.size(); ++i) {
+      const vertex_type &vertex = _vertices[i];
+      const int64_t cx = cell_of(vertex.x);
+      const int64_t cy = cell_of(vertex.y);
+      const int64_t cz = cell_of(vertex.z);
+      bool merged = false;
+      for (int64_t dx = -1; dx <= 1 && !merged; ++dx) {
+        for (int64_t dy = -1; dy <= 1 && !merged; ++dy) {
+          for (int64_t dz = -1; dz <= 1 && !merged; ++dz) {
+            const auto cell = grid.find(CellHash(cx + dx, cy + dy, cz + dz));
+            if (cell == grid.end()) {
+              continue;
+            }
+            for (const index_type j : cell->second) {
+              if (Math::DistanceSquared(welded_vertices[j], vertex) > squared_distance) {
+                continue;
+              }
+              if (has_normals && !(welded_normals[j] == _normals[i])) {
+                continue;
+              }
+              if (has_uvs && !(welded_uvs[j] == _uvs[i])) {
+                continue;
+              }
+              remap[i] = j;
+              merged = true;
+              break;
+            }
+          }
+        }
+      }
+      if (!merged) {
+        remap[i] = welded_vertices.size();
+        grid[CellHash(cx, cy, cz)].push_back(remap[i]);
+        welded_vertices.push_back(vertex);
+        if (has_normals) {
+          welded_normals.push_back(_normals[i]);
+        }
+        if (has_uvs) {
+          welded_uvs.push_back(_uvs[i]);
+        }
+      }
+    }
+
+    const size_t removed = _vertices.size() - welded_vertices.size();
+    if (removed == 0u) {
+      return 0u;
+    }
+    for (auto &index : _indexes) {
+      // Indexes are 1-based (OBJ convention).
+      index = remap[index - 1u] + 1u;
+    }
+    _vertices = std::move(welded_vertices);
+    if (has_normals) {
+      _normals = std::move(welded_normals);
+    }
+    if (has_uvs) {
+      _uvs = std::move(welded_uvs);
+    }
+    return removed;
+  }
+
   // e.g:
   // 1   3   5   7
   // #---#---#---#
@@ -47,6 +149,8 @@ namespace geom {
       return;
     }
     DEBUG_ASSERT(vertices.size() >= 3);
+    Reserve(GetVerticesNum() + vertices.size(),
+        GetIndexesNum() + 3u * (vertices.size() - 2u));
     size_t i = GetVerticesNum() + 2;
     AddVertices(vertices);
     bool index_clockwise = true;
@@ -73,6 +177,8 @@ namespace geom {
   // 3   4   5
   void Mesh::AddTriangleFan(const std::vector<Mesh::vertex_type> &vertices) {
     DEBUG_ASSERT(vertices.size() >= 3);
+    Reserve(GetVerticesNum() + vertices.size(),
+        GetIndexesNum() + 3u * (vertices.size() - 2u));
     const size_t initial_index = GetVerticesNum() + 1;
     size_t i = GetVerticesNum() + 2;
     AddVertices(vertices);
@@ -72,6 +72,18 @@ namespace geom {
     // -- Mesh build methods ---------------------------------------------------
     // =========================================================================
 
+    /// Reserves room for @a vertices_count vertices (along with their
+    /// normals and UVs) and @a indexes_count indexes to avoid reallocations
+    /// while the mesh is being built.
+    void Reserve(size_t vertices_count, size_t indexes_count);
+
+    /// Welds together the vertices closer than @a vertex_distance using a
+    /// spatial hash grid, remapping the indexes to the surviving vertices.
+    /// Vertices are only merged if their normals and UVs match too, so
+    /// texture seams and hard edges are preserved.
+    /// @return the number of vertices removed.
+    size_t Weld(float vertex_distance);
+
     /// Adds a triangle strip to the mesh, vertex order is counterclockwise.
     void AddTriangleStrip(const std::vector<vertex_type> &vertices);
 
@@ -24,6 +24,7 @@ namespace geom {
     for (auto &&lane_section : road.GetLaneSections()) {
       out_mesh += *Generate(lane_section);
     }
+    out_mesh.Weld(road_param.vertex_weld_distance);
     return std::make_unique<Mesh>(out_mesh);
   }
 
@@ -342,6 +343,12 @@ namespace geom {
       }
     }
 
+    // Weld once the road and wall strips have been merged so the duplicated
+    // vertices along the shared lane edges collapse too
+    for (auto &mesh : mesh_uptr_list) {
+      mesh->Weld(road_param.vertex_weld_distance);
+    }
+
     return mesh_uptr_list;
   }
 
@@ -389,24 +396,29 @@ namespace geom {
   std::vector<VertexNeighbors> GetVertexNeighborhoodAndWeights(
       const MeshFactory::RoadParameters &road_param,
       std::vector<std::unique_ptr<Mesh>> &lane_meshes) {
-    // Build rtree for neighborhood queries
+    // Build rtree for neighborhood queries, packed construction from the
+    // complete vertex set
     using Rtree = geom::PointCloudRtree<VertexInfo>;
     using Point = Rtree::BPoint;
-    Rtree rtree;
+    std::vector<Rtree::TreeElement> rtree_elements;
     for (size_t lane_mesh_idx = 0; lane_mesh_idx < lane_meshes.size(); ++lane_mesh_idx) {
       auto& mesh = lane_meshes[lane_mesh_idx];
       for(size_t i = 0; i < mesh->GetVerticesNum(); ++i) {
         auto& vertex = mesh->GetVertices()[i];
         Point point(vertex.x, vertex.y, vertex.z);
         if (i < 2 || i >= mesh->GetVerticesNum() - 2) {
-          rtree.InsertElement({point, {&vertex, lane_mesh_idx, true}});
+          rtree_elements.push_back({point, {&vertex, lane_mesh_idx, true}});
         } else {
-          rtree.InsertElement({point, {&vertex, lane_mesh_idx, false}});
+          rtree_elements.push_back({point, {&vertex, lane_mesh_idx, false}});
         }
       }
     }
+    Rtree rtree;
+    rtree.BulkLoad(rtree_elements);
 
-    // Find neighbors for each vertex and compute their weight
+    // Find neighbors for each vertex and compute their weight, reusing the
+    // query buffer across the whole loop
+    Rtree::NearestQuery knn_query(rtree);
     std::vector<VertexNeighbors> vertices_neighborhoods;
     for (size_t lane_mesh_idx = 0; lane_mesh_idx < lane_meshes.size(); ++lane_mesh_idx) {
       auto& mesh = lane_meshes[lane_mesh_idx];
@@ -414,7 +426,7 @@ namespace geom {
         if (i > 2 && i < mesh->GetVerticesNum() - 2) {
           auto& vertex = mesh->GetVertices()[i];
           Point point(vertex.x, vertex.y, vertex.z);
-          auto closest_vertices = rtree.GetNearestNeighbours(point, 20);
+          const auto &closest_vertices = knn_query.Run(point, 20);
           VertexNeighbors vertex_neighborhood;
           vertex_neighborhood.vertex = &vertex;
           for(auto& close_vertex : closest_vertices) {
@@ -466,6 +478,9 @@ namespace geom {
       out_mesh += *mesh;
     }
 
+    // Weld after smoothing, smoothed neighbor vertices end up coincident
+    out_mesh.Weld(road_param.vertex_weld_distance);
+
     return std::make_unique<Mesh>(out_mesh);
   }
 
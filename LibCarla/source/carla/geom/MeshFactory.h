@@ -92,6 +92,9 @@ namespace geom {
       float max_road_len                = 50.0f;
       float extra_lane_width            =  1.0f;
       float wall_height                 =  0.6f;
+      // Vertices closer than this are welded together in the final meshes,
+      // removing the duplicates left by merging the per-lane strips:
+      float vertex_weld_distance        =  0.001f;
       // Road mesh smoothness:
       float max_weight_distance         =  5.0f;
       float same_lane_weight_multiplier =  2.0f;
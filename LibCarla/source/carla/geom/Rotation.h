@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/MsgPack.h"
+#include "carla/MsgPackAdaptors.h"
 #include "carla/geom/Math.h"
 #include "carla/geom/Vector3D.h"
 
@@ -142,3 +143,7 @@ namespace geom {
 
 } // namespace geom
 } // namespace carla
+
+static_assert(sizeof(carla::geom::Rotation) == 3u * sizeof(float), "unexpected Rotation layout");
+
+CARLA_MSGPACK_FLAT_VECTOR(carla::geom::Rotation)
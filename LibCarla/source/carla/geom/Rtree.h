@@ -11,6 +11,7 @@
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/point.hpp>
 #include <boost/geometry/index/rtree.hpp>
+#include <boost/iterator/function_output_iterator.hpp>
 
 namespace carla {
 namespace geom {
@@ -37,6 +38,13 @@ namespace geom {
       _rtree.insert(elements.begin(), elements.end());
     }
 
+    /// Build the tree from the complete set of elements using the packing
+    /// algorithm, which is faster than repeated insertion and produces a
+    /// better balanced tree. Replaces any previous content.
+    void BulkLoad(const std::vector<TreeElement> &elements) {
+      _rtree = RtreeT(elements.begin(), elements.end());
+    }
+
     /// Return nearest neighbors with a user defined filter.
     /// The filter reveices as an argument a TreeElement value and needs to
     /// return a bool to accept or reject the value
@@ -46,28 +54,99 @@ namespace geom {
     std::vector<TreeElement> GetNearestNeighboursWithFilter(const BPoint &point, Filter filter,
         size_t number_neighbours = 1) const {
       std::vector<TreeElement> query_result;
+      GetNearestNeighboursWithFilter(point, filter, number_neighbours, query_result);
+      return query_result;
+    }
+
+    /// Variant writing into @a query_result, which is cleared first; lets
+    /// callers in tight loops reuse the buffer across queries.
+    template <typename Filter>
+    void GetNearestNeighboursWithFilter(const BPoint &point, Filter filter,
+        size_t number_neighbours, std::vector<TreeElement> &query_result) const {
+      query_result.clear();
       auto nearest = boost::geometry::index::nearest(point, static_cast<unsigned int>(number_neighbours));
       auto satisfies = boost::geometry::index::satisfies(filter);
       // Using explicit operator&& to workaround Bullseye coverage issue
       // https://www.bullseye.com/help/trouble-logicalOverload.html.
       _rtree.query(operator&&(nearest, satisfies), std::back_inserter(query_result));
-      return query_result;
     }
 
     std::vector<TreeElement> GetNearestNeighbours(const BPoint &point, size_t number_neighbours = 1) const {
       std::vector<TreeElement> query_result;
+      GetNearestNeighbours(point, number_neighbours, query_result);
+      return query_result;
+    }
+
+    /// Variant writing into @a query_result, which is cleared first; lets
+    /// callers in tight loops reuse the buffer across queries.
+    void GetNearestNeighbours(const BPoint &point, size_t number_neighbours,
+        std::vector<TreeElement> &query_result) const {
+      query_result.clear();
       _rtree.query(boost::geometry::index::nearest(point, static_cast<unsigned int>(number_neighbours)),
       std::back_inserter(query_result));
-      return query_result;
     }
 
+    /// Visits the up to @a number_neighbours nearest elements accepted by
+    /// @a filter directly, avoiding the intermediate result vector
+    /// altogether.
+    template <typename Filter, typename Visitor>
+    void VisitNearestNeighboursWithFilter(const BPoint &point, Filter filter,
+        size_t number_neighbours, Visitor visitor) const {
+      auto nearest = boost::geometry::index::nearest(point, static_cast<unsigned int>(number_neighbours));
+      auto satisfies = boost::geometry::index::satisfies(filter);
+      // Same operator&& workaround as above.
+      _rtree.query(operator&&(nearest, satisfies), boost::make_function_output_iterator(visitor));
+    }
+
+    /// Reusable query state: owns the result buffer so query loops do not
+    /// pay one vector allocation per call.
+    class NearestQuery {
+    public:
+
+      explicit NearestQuery(const PointCloudRtree &rtree) : _rtree(rtree) {}
+
+      /// k-NN query for a single point; the returned reference is valid
+      /// until the next run.
+      const std::vector<TreeElement> &Run(const BPoint &point, size_t number_neighbours = 1) {
+        _rtree.GetNearestNeighbours(point, number_neighbours, _query_result);
+        return _query_result;
+      }
+
+      /// Filtered k-NN query reusing the same buffer.
+      template <typename Filter>
+      const std::vector<TreeElement> &RunWithFilter(const BPoint &point, Filter filter,
+          size_t number_neighbours = 1) {
+        _rtree.GetNearestNeighboursWithFilter(point, filter, number_neighbours, _query_result);
+        return _query_result;
+      }
+
+      /// Runs one k-NN query per point of the batch, writing the neighbors
+      /// of points[i] into results[i]; the batch storage and the per-point
+      /// vectors keep their capacity across runs.
+      void RunBatch(const BPoint *points, size_t count, size_t number_neighbours,
+          std::vector<std::vector<TreeElement>> &results) const {
+        results.resize(count);
+        for (size_t i = 0u; i < count; ++i) {
+          _rtree.GetNearestNeighbours(points[i], number_neighbours, results[i]);
+        }
+      }
+
+    private:
+
+      const PointCloudRtree &_rtree;
+
+      std::vector<TreeElement> _query_result;
+    };
+
     size_t GetTreeSize() const {
       return _rtree.size();
     }
 
   private:
 
-    boost::geometry::index::rtree<TreeElement, boost::geometry::index::linear<16>> _rtree;
+    using RtreeT = boost::geometry::index::rtree<TreeElement, boost::geometry::index::linear<16>>;
+
+    RtreeT _rtree;
 
   };
 
@@ -94,6 +173,13 @@ namespace geom {
       _rtree.insert(elements.begin(), elements.end());
     }
 
+    /// Build the tree from the complete set of elements using the packing
+    /// algorithm, which is faster than repeated insertion and produces a
+    /// better balanced tree. Replaces any previous content.
+    void BulkLoad(const std::vector<TreeElement> &elements) {
+      _rtree = RtreeT(elements.begin(), elements.end());
+    }
+
     /// Return nearest neighbors with a user defined filter.
     /// The filter reveices as an argument a TreeElement value and needs to
     /// return a bool to accept or reject the value
@@ -105,22 +191,95 @@ namespace geom {
         Filter filter,
         size_t number_neighbours = 1) const {
       std::vector<TreeElement> query_result;
+      GetNearestNeighboursWithFilter(geometry, filter, number_neighbours, query_result);
+      return query_result;
+    }
+
+    /// Variant writing into @a query_result, which is cleared first; lets
+    /// batched callers reuse the buffer across queries.
+    template <typename Geometry, typename Filter>
+    void GetNearestNeighboursWithFilter(
+        const Geometry &geometry,
+        Filter filter,
+        size_t number_neighbours,
+        std::vector<TreeElement> &query_result) const {
+      query_result.clear();
       _rtree.query(
           boost::geometry::index::nearest(geometry, static_cast<unsigned int>(number_neighbours)) &&
               boost::geometry::index::satisfies(filter),
           std::back_inserter(query_result));
-      return query_result;
     }
 
     template<typename Geometry>
     std::vector<TreeElement> GetNearestNeighbours(const Geometry &geometry, size_t number_neighbours = 1) const {
       std::vector<TreeElement> query_result;
+      GetNearestNeighbours(geometry, number_neighbours, query_result);
+      return query_result;
+    }
+
+    /// Variant writing into @a query_result, which is cleared first; lets
+    /// callers in tight loops reuse the buffer across queries.
+    template<typename Geometry>
+    void GetNearestNeighbours(const Geometry &geometry, size_t number_neighbours,
+        std::vector<TreeElement> &query_result) const {
+      query_result.clear();
       _rtree.query(
           boost::geometry::index::nearest(geometry, static_cast<unsigned int>(number_neighbours)),
           std::back_inserter(query_result));
-      return query_result;
     }
 
+    /// Visits the up to @a number_neighbours nearest elements directly,
+    /// avoiding the intermediate result vector altogether.
+    template<typename Geometry, typename Visitor>
+    void VisitNearestNeighbours(const Geometry &geometry, size_t number_neighbours,
+        Visitor visitor) const {
+      _rtree.query(
+          boost::geometry::index::nearest(geometry, static_cast<unsigned int>(number_neighbours)),
+          boost::make_function_output_iterator(visitor));
+    }
+
+    /// Reusable query state: owns the result buffer so query loops do not
+    /// pay one vector allocation per call.
+    class NearestQuery {
+    public:
+
+      explicit NearestQuery(const SegmentCloudRtree &rtree) : _rtree(rtree) {}
+
+      /// k-NN query for a single geometry; the returned reference is valid
+      /// until the next run.
+      template <typename Geometry>
+      const std::vector<TreeElement> &Run(const Geometry &geometry, size_t number_neighbours = 1) {
+        _rtree.GetNearestNeighbours(geometry, number_neighbours, _query_result);
+        return _query_result;
+      }
+
+      /// Filtered k-NN query reusing the same buffer.
+      template <typename Geometry, typename Filter>
+      const std::vector<TreeElement> &RunWithFilter(const Geometry &geometry, Filter filter,
+          size_t number_neighbours = 1) {
+        _rtree.GetNearestNeighboursWithFilter(geometry, filter, number_neighbours, _query_result);
+        return _query_result;
+      }
+
+      /// Runs one k-NN query per geometry of the batch, writing the
+      /// neighbors of geometries[i] into results[i]; the batch storage and
+      /// the per-geometry vectors keep their capacity across runs.
+      template <typename Geometry>
+      void RunBatch(const Geometry *geometries, size_t count, size_t number_neighbours,
+          std::vector<std::vector<TreeElement>> &results) const {
+        results.resize(count);
+        for (size_t i = 0u; i < count; ++i) {
+          _rtree.GetNearestNeighbours(geometries[i], number_neighbours, results[i]);
+        }
+      }
+
+    private:
+
+      const SegmentCloudRtree &_rtree;
+
+      std::vector<TreeElement> _query_result;
+    };
+
     /// Returns segments that intersec the specified geometry
     /// Warning: intersection between 3D segments is not implemented by boost
     template<typename Geometry>
@@ -138,7 +297,9 @@ namespace geom {
 
   private:
 
-    boost::geometry::index::rtree<TreeElement, boost::geometry::index::linear<16>> _rtree;
+    using RtreeT = boost::geometry::index::rtree<TreeElement, boost::geometry::index::linear<16>>;
+
+    RtreeT _rtree;
 
   };
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/MsgPack.h"
+#include "carla/MsgPackAdaptors.h"
 #include "carla/geom/Location.h"
 #include "carla/geom/Math.h"
 #include "carla/geom/Rotation.h"
@@ -15,6 +16,9 @@
 #include "Math/Transform.h"
 #endif // LIBCARLA_INCLUDED_FROM_UE4
 
+#include <array>
+#include <cstddef>
+
 namespace carla {
 namespace geom {
 
@@ -65,6 +69,39 @@ namespace geom {
       in_point = out_point;
     }
 
+    /// Row-major 3x3 rotation matrix of this transform, the same matrix
+    /// Rotation::RotateVector applies: Rz(yaw) * Ry(pitch) * Rx(roll).
+    /// Being orthonormal, its transpose is its inverse.
+    std::array<float, 9u> GetRotationMatrix() const {
+      const float cy = std::cos(Math::ToRadians(rotation.yaw));
+      const float sy = std::sin(Math::ToRadians(rotation.yaw));
+      const float cr = std::cos(Math::ToRadians(rotation.roll));
+      const float sr = std::sin(Math::ToRadians(rotation.roll));
+      const float cp = std::cos(Math::ToRadians(rotation.pitch));
+      const float sp = std::sin(Math::ToRadians(rotation.pitch));
+      return {{
+          cp * cy, cy * sp * sr - sy * cr, -cy * sp * cr - sy * sr,
+          cp * sy, sy * sp * sr + cy * cr, -sy * sp * cr + cy * sr,
+          sp, -cp * sr, cp * cr}};
+    }
+
+    /// Applies this transformation to @a count points in place; equivalent
+    /// to calling TransformPoint on each point, but the rotation matrix is
+    /// computed only once and the loop is kept vectorizable. Works for any
+    /// point type with x/y/z members (Vector3D, Location).
+    template <typename PointT>
+    void TransformPoints(PointT *in_points, size_t count) const {
+      const auto m = GetRotationMatrix();
+      for (size_t i = 0u; i < count; ++i) {
+        const float x = in_points[i].x;
+        const float y = in_points[i].y;
+        const float z = in_points[i].z;
+        in_points[i].x = (x * m[0] + y * m[1] + z * m[2]) + location.x;
+        in_points[i].y = (x * m[3] + y * m[4] + z * m[5]) + location.y;
+        in_points[i].z = (x * m[6] + y * m[7] + z * m[8]) + location.z;
+      }
+    }
+
     /// Applies the inverse of this transformation to @a in_point
     void InverseTransformPoint(Vector3D &in_point) const {
       auto out_point = in_point;
@@ -73,6 +110,21 @@ namespace geom {
       in_point = out_point;
     }
 
+    /// Batched version of InverseTransformPoint, see TransformPoints.
+    template <typename PointT>
+    void InverseTransformPoints(PointT *in_points, size_t count) const {
+      const auto m = GetRotationMatrix();
+      for (size_t i = 0u; i < count; ++i) {
+        const float x = in_points[i].x - location.x;
+        const float y = in_points[i].y - location.y;
+        const float z = in_points[i].z - location.z;
+        // Multiply by the transpose to rotate back.
+        in_points[i].x = x * m[0] + y * m[3] + z * m[6];
+        in_points[i].y = x * m[1] + y * m[4] + z * m[7];
+        in_points[i].z = x * m[2] + y * m[5] + z * m[8];
+      }
+    }
+
     // =========================================================================
     // -- Comparison operators -------------------------------------------------
     // =========================================================================
@@ -104,3 +156,7 @@ namespace geom {
 
 } // namespace geom
 } // namespace carla
+
+static_assert(sizeof(carla::geom::Transform) == 6u * sizeof(float), "unexpected Transform layout");
+
+CARLA_MSGPACK_FLAT_VECTOR(carla::geom::Transform)
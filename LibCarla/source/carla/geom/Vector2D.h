@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/MsgPack.h"
+#include "carla/MsgPackAdaptors.h"
 
 #include <cmath>
 #include <limits>
@@ -151,3 +152,7 @@ namespace geom {
 
 } // namespace geom
 } // namespace carla
+
+static_assert(sizeof(carla::geom::Vector2D) == 2u * sizeof(float), "unexpected Vector2D layout");
+
+CARLA_MSGPACK_FLAT_VECTOR(carla::geom::Vector2D)
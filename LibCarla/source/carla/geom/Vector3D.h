@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/MsgPack.h"
+#include "carla/MsgPackAdaptors.h"
 
 #include <cmath>
 #include <limits>
@@ -190,3 +191,9 @@ namespace geom {
 
 } // namespace geom
 } // namespace carla
+
+// The flat vector encoding freezes this layout on the wire, see
+// MsgPackAdaptors.h; make sure it never changes silently.
+static_assert(sizeof(carla::geom::Vector3D) == 3u * sizeof(float), "unexpected Vector3D layout");
+
+CARLA_MSGPACK_FLAT_VECTOR(carla::geom::Vector3D)
@@ -6,8 +6,15 @@
 
 #pragma once
 
+#include "carla/image/ColorConverter.h"
 #include "carla/image/ImageView.h"
 
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 namespace carla {
 namespace image {
 
@@ -23,10 +30,131 @@ namespace image {
     static void ConvertInPlace(
         MutableImageView &image_view,
         ColorConverter converter = ColorConverter()) {
-      using DstPixelT = typename MutableImageView::value_type;
-      CopyPixels(
-          ImageView::MakeColorConvertedView<MutableImageView, DstPixelT>(image_view, converter),
-          image_view);
+      if (!TryConvertInPlaceFast(image_view, converter)) {
+        using DstPixelT = typename MutableImageView::value_type;
+        CopyPixels(
+            ImageView::MakeColorConvertedView<MutableImageView, DstPixelT>(image_view, converter),
+            image_view);
+      }
+    }
+
+  private:
+
+    /// Whether rows of @a ViewT can be walked with a plain pixel pointer
+    /// and its pixels carry a red channel; the fast paths below require
+    /// both.
+    template <typename ViewT>
+    struct has_fast_path {
+      static constexpr bool value =
+          std::is_pointer<typename ViewT::x_iterator>::value &&
+          boost::gil::contains_color<
+              typename ViewT::value_type,
+              boost::gil::red_t>::value;
+    };
+
+    /// Call @a func(y) for every row, splitting the rows among the
+    /// available cores.
+    template <typename FuncT>
+    static void ForEachRowParallel(std::ptrdiff_t height, FuncT func) {
+      const size_t num_threads = std::min<size_t>(
+          std::max(1u, std::thread::hardware_concurrency()),
+          static_cast<size_t>(height));
+      if (num_threads < 2u) {
+        for (std::ptrdiff_t y = 0u; y < height; ++y) {
+          func(y);
+        }
+        return;
+      }
+      const auto rows_per_thread =
+          (static_cast<size_t>(height) + num_threads - 1u) / num_threads;
+      std::vector<std::thread> workers;
+      workers.reserve(num_threads);
+      for (size_t i = 0u; i < num_threads; ++i) {
+        workers.emplace_back([i, rows_per_thread, height, &func]() {
+          const auto begin = static_cast<std::ptrdiff_t>(i * rows_per_thread);
+          const auto end = std::min(
+              begin + static_cast<std::ptrdiff_t>(rows_per_thread),
+              height);
+          for (auto y = begin; y < end; ++y) {
+            func(y);
+          }
+        });
+      }
+      for (auto &worker : workers) {
+        worker.join();
+      }
+    }
+
+    /// Apply @a func to every pixel in place, rows in parallel.
+    template <typename MutableImageView, typename FuncT>
+    static void ApplyPerPixelParallel(MutableImageView &view, FuncT func) {
+      ForEachRowParallel(view.height(), [&view, func](std::ptrdiff_t y) {
+        auto *pixel = view.row_begin(y);
+        auto *const end = pixel + view.width();
+        for (; pixel != end; ++pixel) {
+          const auto src = *pixel;
+          func(src, *pixel);
+        }
+      });
+    }
+
+    /// Catch-all, converters and views without a dedicated fast path take
+    /// the generic boost::gil route.
+    template <typename ColorConverter, typename MutableImageView>
+    static bool TryConvertInPlaceFast(MutableImageView &, ColorConverter) {
+      return false;
+    }
+
+    /// The palette only depends on the red channel, so the whole
+    /// conversion collapses into a 256-entry lookup table built with the
+    /// original functor (hence bit-identical results).
+    template <typename MutableImageView>
+    static typename std::enable_if<has_fast_path<MutableImageView>::value, bool>::type
+    TryConvertInPlaceFast(
+        MutableImageView &view,
+        ColorConverter::CityScapesPalette converter) {
+      using namespace boost::gil;
+      using pixel_t = typename MutableImageView::value_type;
+      std::array<pixel_t, 256u> lut;
+      for (auto tag = 0u; tag < lut.size(); ++tag) {
+        pixel_t src;
+        static_fill(src, static_cast<uint8_t>(0u));
+        get_color(src, red_t()) = static_cast<uint8_t>(tag);
+        converter(src, lut[tag]);
+      }
+      ForEachRowParallel(view.height(), [&view, &lut](std::ptrdiff_t y) {
+        auto *pixel = view.row_begin(y);
+        auto *const end = pixel + view.width();
+        for (; pixel != end; ++pixel) {
+          *pixel = lut[get_color(*pixel, red_t())];
+        }
+      });
+      return true;
+    }
+
+    template <typename MutableImageView>
+    static typename std::enable_if<has_fast_path<MutableImageView>::value, bool>::type
+    TryConvertInPlaceFast(
+        MutableImageView &view,
+        ColorConverter::Depth converter) {
+      ApplyPerPixelParallel(view, converter);
+      return true;
+    }
+
+    /// Composes the same two per-pixel stages the lazy view pipeline runs,
+    /// just over contiguous rows and in parallel.
+    template <typename MutableImageView>
+    static typename std::enable_if<has_fast_path<MutableImageView>::value, bool>::type
+    TryConvertInPlaceFast(
+        MutableImageView &view,
+        ColorConverter::LogarithmicDepth) {
+      using pixel_t = typename MutableImageView::value_type;
+      ApplyPerPixelParallel(view, [](const pixel_t &src, pixel_t &dst) {
+        boost::gil::gray32f_pixel_t depth;
+        ColorConverter::Depth()(src, depth);
+        ColorConverter::LogarithmicLinear()(depth, dst);
+      });
+      return true;
     }
   };
 
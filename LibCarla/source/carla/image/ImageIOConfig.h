@@ -70,6 +70,8 @@
 #  pragma clang diagnostic pop
 #endif
 
+#include "carla/image/PNGEncoder.h"
+
 namespace carla {
 namespace image {
 namespace io {
@@ -118,8 +120,19 @@ namespace detail {
       boost::gil::read_and_convert_image(std::forward<Str>(in_filename), image, boost::gil::png_tag());
     }
 
+    /// Views the parallel encoder understands go through it on big enough
+    /// images; it declines small ones, which then take the libpng path.
     template <typename Str, typename ViewT>
-    static void write_view(Str &&out_filename, const ViewT &view) {
+    static typename std::enable_if<png_encoder::is_encodable<ViewT>::value>::type
+    write_view(Str &&out_filename, const ViewT &view) {
+      if (!png_encoder::WriteView(out_filename, view)) {
+        boost::gil::write_view(std::forward<Str>(out_filename), view, boost::gil::png_tag());
+      }
+    }
+
+    template <typename Str, typename ViewT>
+    static typename std::enable_if<!png_encoder::is_encodable<ViewT>::value>::type
+    write_view(Str &&out_filename, const ViewT &view) {
       boost::gil::write_view(std::forward<Str>(out_filename), view, boost::gil::png_tag());
     }
 
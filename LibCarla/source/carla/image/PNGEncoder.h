@@ -0,0 +1,287 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+#include "carla/image/BoostGil.h"
+
+// This header is included by ImageIOConfig.h once the PNG support macro has
+// been resolved; zlib is guaranteed to be present whenever libpng is.
+#if LIBCARLA_IMAGE_WITH_PNG_SUPPORT == true
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace carla {
+namespace image {
+namespace io {
+namespace detail {
+
+  /// Multi-threaded PNG encoder.
+  ///
+  /// The scanlines are split in contiguous row chunks that are filtered and
+  /// deflated concurrently, each chunk producing an independent piece of a
+  /// single zlib stream (non-final pieces are terminated with a full flush,
+  /// so their concatenation is a valid stream). Each piece is emitted as its
+  /// own IDAT chunk, which any compliant decoder concatenates back. This
+  /// keeps encoding time roughly inversely proportional to the number of
+  /// cores, instead of being bound to libpng's single-threaded writer.
+  class png_encoder {
+  public:
+
+    /// Whether @a ViewT can be encoded directly: 8-bit channels in a
+    /// semantic RGB or RGBA color space (any memory layout).
+    template <typename ViewT>
+    struct is_encodable {
+    private:
+
+      using color_space = typename boost::gil::color_space_type<ViewT>::type;
+      using channel = typename boost::gil::channel_type<ViewT>::type;
+
+    public:
+
+      static constexpr bool value =
+          std::is_same<channel, uint8_t>::value &&
+          (std::is_same<color_space, boost::gil::rgb_t>::value ||
+           std::is_same<color_space, boost::gil::rgba_t>::value);
+    };
+
+    /// Encode @a view into @a path using up to @a num_threads threads, all
+    /// the cores by default. Returns false without touching the file when
+    /// the image is too small to be worth splitting or only one core is
+    /// available; the caller should then fall back to libpng.
+    ///
+    /// @throw std::ios_base::failure if the file cannot be written.
+    template <typename ViewT>
+    static bool WriteView(
+        const std::string &path,
+        const ViewT &view,
+        size_t num_threads = 0u) {
+      static_assert(is_encodable<ViewT>::value, "view cannot be encoded");
+      constexpr unsigned num_channels =
+          boost::gil::num_channels<ViewT>::value;
+
+      if (num_threads == 0u) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+      }
+      const size_t width = static_cast<size_t>(view.width());
+      const size_t height = static_cast<size_t>(view.height());
+      constexpr size_t min_rows_per_chunk = 64u;
+      const size_t num_chunks = std::min(
+          num_threads,
+          height / min_rows_per_chunk);
+      if ((width == 0u) || (num_chunks < 2u)) {
+        return false;
+      }
+
+      // Filter and deflate each chunk of rows in its own thread.
+      const size_t rows_per_chunk = (height + num_chunks - 1u) / num_chunks;
+      std::vector<piece> pieces(num_chunks);
+      std::vector<std::thread> workers;
+      workers.reserve(num_chunks);
+      for (size_t i = 0u; i < num_chunks; ++i) {
+        workers.emplace_back([&view, &pieces, i, rows_per_chunk, height, width]() {
+          const size_t begin = i * rows_per_chunk;
+          const size_t end = std::min(begin + rows_per_chunk, height);
+          const size_t stride = 1u + width * num_channels;
+          std::vector<unsigned char> raw(stride * (end - begin));
+          auto *dst = raw.data();
+          for (size_t y = begin; y < end; ++y, dst += stride) {
+            fill_scanline(view, static_cast<std::ptrdiff_t>(y), dst);
+          }
+          compress(raw, end == height, pieces[i]);
+        });
+      }
+      for (auto &worker : workers) {
+        worker.join();
+      }
+
+      write_file(path, width, height, num_channels, pieces);
+      return true;
+    }
+
+  private:
+
+    /// An independently deflated range of scanlines.
+    struct piece {
+      std::vector<unsigned char> data;
+      uLong adler = 0u;
+      size_t raw_size = 0u;
+    };
+
+    template <typename PixelT>
+    static unsigned char *write_pixel(
+        unsigned char *dst,
+        const PixelT &pixel,
+        std::integral_constant<unsigned, 3u>) {
+      *dst++ = boost::gil::semantic_at_c<0>(pixel);
+      *dst++ = boost::gil::semantic_at_c<1>(pixel);
+      *dst++ = boost::gil::semantic_at_c<2>(pixel);
+      return dst;
+    }
+
+    template <typename PixelT>
+    static unsigned char *write_pixel(
+        unsigned char *dst,
+        const PixelT &pixel,
+        std::integral_constant<unsigned, 4u>) {
+      dst = write_pixel(dst, pixel, std::integral_constant<unsigned, 3u>());
+      *dst++ = boost::gil::semantic_at_c<3>(pixel);
+      return dst;
+    }
+
+    /// Write one filtered scanline of @a view (filter byte plus pixels in
+    /// semantic RGB(A) order, then the "Sub" filter applied in place).
+    template <typename ViewT>
+    static void fill_scanline(
+        const ViewT &view,
+        std::ptrdiff_t y,
+        unsigned char *dst) {
+      constexpr unsigned num_channels = boost::gil::num_channels<ViewT>::value;
+      const unsigned char *const row = dst;
+      *dst++ = 1u; // "Sub" filter.
+      auto it = view.row_begin(y);
+      for (std::ptrdiff_t x = 0u; x < view.width(); ++x, ++it) {
+        dst = write_pixel(dst, *it, std::integral_constant<unsigned, num_channels>());
+      }
+      // Sub filter: each byte becomes the difference with the byte one
+      // pixel to its left; applied backwards so it can run in place.
+      for (auto *cur = dst - 1u; cur > row + num_channels; --cur) {
+        *cur = static_cast<unsigned char>(*cur - *(cur - num_channels));
+      }
+    }
+
+    /// Deflate @a raw into @a out as a headerless piece of a zlib stream;
+    /// the final piece closes the stream, the others end at a byte boundary
+    /// with a full flush.
+    static void compress(
+        const std::vector<unsigned char> &raw,
+        bool is_final,
+        piece &out) {
+      z_stream strm;
+      std::memset(&strm, 0, sizeof(strm));
+      // Negative window bits select a raw deflate stream, the zlib header
+      // and the combined adler checksum are emitted by write_file.
+      if (deflateInit2(
+          &strm,
+          Z_DEFAULT_COMPRESSION,
+          Z_DEFLATED,
+          -15,
+          8,
+          Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw_exception(std::runtime_error("png_encoder: deflateInit2 failed"));
+      }
+      out.data.resize(deflateBound(&strm, raw.size()) + 16u);
+      strm.next_in = const_cast<Bytef *>(raw.data());
+      strm.avail_in = static_cast<uInt>(raw.size());
+      strm.next_out = out.data.data();
+      strm.avail_out = static_cast<uInt>(out.data.size());
+      const int result = deflate(&strm, is_final ? Z_FINISH : Z_FULL_FLUSH);
+      if (result != (is_final ? Z_STREAM_END : Z_OK)) {
+        deflateEnd(&strm);
+        throw_exception(std::runtime_error("png_encoder: deflate failed"));
+      }
+      out.data.resize(out.data.size() - strm.avail_out);
+      deflateEnd(&strm);
+      out.adler = adler32(adler32(0u, nullptr, 0u), raw.data(), static_cast<uInt>(raw.size()));
+      out.raw_size = raw.size();
+    }
+
+    static void append_big_endian(std::vector<unsigned char> &out, uint32_t value) {
+      out.push_back(static_cast<unsigned char>(value >> 24u));
+      out.push_back(static_cast<unsigned char>(value >> 16u));
+      out.push_back(static_cast<unsigned char>(value >> 8u));
+      out.push_back(static_cast<unsigned char>(value));
+    }
+
+    static void write_chunk(
+        std::ofstream &file,
+        const char (&type)[5],
+        const unsigned char *data,
+        size_t size) {
+      std::vector<unsigned char> header;
+      append_big_endian(header, static_cast<uint32_t>(size));
+      header.insert(header.end(), type, type + 4u);
+      file.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+      if (size > 0u) {
+        file.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+      }
+      uLong crc = crc32(0u, reinterpret_cast<const Bytef *>(type), 4u);
+      if (size > 0u) {
+        crc = crc32(crc, data, static_cast<uInt>(size));
+      }
+      std::vector<unsigned char> trailer;
+      append_big_endian(trailer, static_cast<uint32_t>(crc));
+      file.write(reinterpret_cast<const char *>(trailer.data()), static_cast<std::streamsize>(trailer.size()));
+    }
+
+    static void write_file(
+        const std::string &path,
+        size_t width,
+        size_t height,
+        unsigned num_channels,
+        std::vector<piece> &pieces) {
+      std::ofstream file(path, std::ios::binary | std::ios::trunc);
+      if (!file) {
+        throw_exception(std::ios_base::failure("png_encoder: unable to open " + path));
+      }
+
+      static const unsigned char signature[] = {0x89u, 'P', 'N', 'G', 0x0Du, 0x0Au, 0x1Au, 0x0Au};
+      file.write(reinterpret_cast<const char *>(signature), sizeof(signature));
+
+      std::vector<unsigned char> ihdr;
+      append_big_endian(ihdr, static_cast<uint32_t>(width));
+      append_big_endian(ihdr, static_cast<uint32_t>(height));
+      ihdr.push_back(8u); // Bit depth.
+      ihdr.push_back(num_channels == 4u ? 6u : 2u); // RGBA or RGB.
+      ihdr.push_back(0u); // Compression method.
+      ihdr.push_back(0u); // Filter method.
+      ihdr.push_back(0u); // No interlacing.
+      write_chunk(file, "IHDR", ihdr.data(), ihdr.size());
+
+      // The zlib header goes in front of the first piece and the checksum
+      // of the whole raw stream closes the last one.
+      static const unsigned char zlib_header[] = {0x78u, 0x01u};
+      pieces.front().data.insert(
+          pieces.front().data.begin(),
+          zlib_header,
+          zlib_header + sizeof(zlib_header));
+      uLong adler = pieces.front().adler;
+      for (auto i = 1u; i < pieces.size(); ++i) {
+        adler = adler32_combine(
+            adler,
+            pieces[i].adler,
+            static_cast<z_off_t>(pieces[i].raw_size));
+      }
+      append_big_endian(pieces.back().data, static_cast<uint32_t>(adler));
+
+      for (const auto &p : pieces) {
+        write_chunk(file, "IDAT", p.data.data(), p.data.size());
+      }
+      write_chunk(file, "IEND", nullptr, 0u);
+
+      if (!file) {
+        throw_exception(std::ios_base::failure("png_encoder: failed writing " + path));
+      }
+    }
+  };
+
+} // namespace detail
+} // namespace io
+} // namespace image
+} // namespace carla
+
+#endif // LIBCARLA_IMAGE_WITH_PNG_SUPPORT
@@ -13,9 +13,12 @@
 #include "carla/nav/WalkerManager.h"
 #include "carla/geom/Math.h"
 
+#include <algorithm>
 #include <iterator>
 #include <fstream>
 #include <mutex>
+#include <thread>
+#include <unordered_set>
 
 namespace carla {
 namespace nav {
@@ -33,6 +36,10 @@ namespace nav {
   static const int   MAX_POLYS = 256;
   static const int   MAX_AGENTS = 500;
   static const int   MAX_QUERY_SEARCH_NODES = 2048;
+  // number of crowd shards updated in parallel; kept fixed (instead of
+  // following the core count) so the agent-to-shard assignment is the same
+  // on every machine
+  static const int   CROWD_SHARD_COUNT = 4;
   static const float AGENT_HEIGHT = 1.8f;
   static const float AGENT_RADIUS = 0.3f;
 
@@ -43,6 +50,54 @@ namespace nav {
   static const float AREA_GRASS_COST =  1.0f;
   static const float AREA_ROAD_COST  = 10.0f;
 
+  // tile streaming: ring of tiles kept loaded around every crowd agent,
+  // and the budget for resident tile data; least recently used tiles
+  // beyond the budget are unloaded during the crowd update
+  static const int      TILE_LOAD_RADIUS = 1;
+  static const uint64_t TILE_MEMORY_BUDGET = 128u * 1024u * 1024u;
+
+#pragma pack(push, 1)
+  // serialized layout of dtMeshHeader and dtPoly inside a baked tile, for
+  // reading polygon data straight out of the binary without instantiating
+  // the tile; every field is four-byte aligned, matching Detour's writer
+  struct SerializedMeshHeader {
+    int magic;
+    int version;
+    int x;
+    int y;
+    int layer;
+    unsigned int user_id;
+    int poly_count;
+    int vert_count;
+    int max_link_count;
+    int detail_mesh_count;
+    int detail_vert_count;
+    int detail_tri_count;
+    int bv_node_count;
+    int off_mesh_con_count;
+    int off_mesh_base;
+    float walkable_height;
+    float walkable_radius;
+    float walkable_climb;
+    float bmin[3];
+    float bmax[3];
+    float bv_quant_factor;
+  };
+  struct SerializedPoly {
+    unsigned int first_link;
+    unsigned short verts[6];
+    unsigned short neis[6];
+    unsigned short flags;
+    unsigned char vert_count;
+    unsigned char area_and_type;
+  };
+#pragma pack(pop)
+
+  // pack a tile cell into a map key
+  static int64_t CellKey(int x, int y) {
+    return (static_cast<int64_t>(x) << 32) | static_cast<int64_t>(static_cast<uint32_t>(y));
+  }
+
   // return a random float
   static float frand() {
     return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
@@ -62,30 +117,52 @@ namespace nav {
     _walkers_blocked_position.clear();
     _yaw_walkers.clear();
     _binary_mesh.clear();
-    dtFreeCrowd(_crowd);
+    _vehicle_shard_indices.clear();
+    for (dtCrowd *crowd : _crowd_shards) {
+      dtFreeCrowd(crowd);
+    }
+    _crowd_shards.clear();
     dtFreeNavMeshQuery(_nav_query);
     dtFreeNavMesh(_nav_mesh);
   }
 
   // load navigation data
   bool Navigation::Load(const std::string &filename) {
-    std::ifstream f;
-    std::istream_iterator<uint8_t> start(f), end;
-
-    // read the whole file
-    f.open(filename, std::ios::binary);
-    if (!f.is_open()) {
+    // map the file instead of copying it to the heap; the mapping stays
+    // open so tile data is paged in straight from the file on demand
+    MappedFile file;
+    if (!file.Open(filename)) {
       return false;
     }
-    std::vector<uint8_t> content(start, end);
-    f.close();
-
-    // parse the content
-    return Load(std::move(content));
+    _mapped_mesh = std::move(file);
+    _binary_mesh.clear();
+    _binary_data = _mapped_mesh.data();
+    _binary_size = _mapped_mesh.size();
+    if (!LoadBinary()) {
+      _mapped_mesh.Close();
+      _binary_data = nullptr;
+      _binary_size = 0u;
+      return false;
+    }
+    return true;
   }
 
   // load navigation data from memory
   bool Navigation::Load(std::vector<uint8_t> content) {
+    _mapped_mesh.Close();
+    _binary_mesh = std::move(content);
+    _binary_data = _binary_mesh.data();
+    _binary_size = _binary_mesh.size();
+    if (!LoadBinary()) {
+      _binary_data = nullptr;
+      _binary_size = 0u;
+      return false;
+    }
+    return true;
+  }
+
+  // parse the navmesh binary currently viewed by _binary_data/_binary_size
+  bool Navigation::LoadBinary() {
     const int NAVMESHSET_MAGIC = 'M' << 24 | 'S' << 16 | 'E' << 8 | 'T'; // 'MSET';
     const int NAVMESHSET_VERSION = 1;
 #pragma pack(push, 1)
@@ -100,17 +177,26 @@ namespace nav {
       dtTileRef tile_ref;
       int data_size;
     };
+    // leading fields of dtMeshHeader, to peek the tile cell without
+    // instantiating the tile
+    struct NavMeshTileDataHeader {
+      int magic;
+      int version;
+      int x;
+      int y;
+      int layer;
+    };
 #pragma pack(pop)
 
     // check size for header
-    if (content.size() < sizeof(header)) {
+    if (_binary_size < sizeof(header)) {
       logging::log("Nav: failed loading binary");
       return false;
     }
 
     // read the file header
     unsigned long pos = 0;
-    memcpy(&header, &content[pos], sizeof(header));
+    memcpy(&header, &_binary_data[pos], sizeof(header));
     pos += sizeof(header);
 
     // check file magic and version
@@ -130,14 +216,20 @@ namespace nav {
       return false;
     }
 
-    // read the tiles data
+    // scan the tiles, recording where each one lives inside the binary;
+    // the tiles themselves are instantiated on demand around the agents
+    // instead of resident all at once
+    _tile_slots.clear();
+    _tiles_by_cell.clear();
+    _loaded_tile_bytes = 0u;
+    _tile_clock = 0u;
     for (int i = 0; i < header.num_tiles; ++i) {
       NavMeshTileHeader tile_header;
 
       // read the tile header
-      memcpy(&tile_header, &content[pos], sizeof(tile_header));
+      memcpy(&tile_header, &_binary_data[pos], sizeof(tile_header));
       pos += sizeof(tile_header);
-      if (pos >= content.size()) {
+      if (pos >= _binary_size) {
         dtFreeNavMesh(mesh);
         return false;
       }
@@ -147,26 +239,36 @@ namespace nav {
         break;
       }
 
-      // allocate the buffer
-      char *data = static_cast<char *>(dtAlloc(static_cast<size_t>(tile_header.data_size), DT_ALLOC_PERM));
-      if (!data) {
-        break;
+      // peek the tile cell from the start of the tile data
+      NavMeshTileDataHeader data_header;
+      if (pos + sizeof(data_header) > _binary_size) {
+        dtFreeNavMesh(mesh);
+        return false;
       }
+      memcpy(&data_header, &_binary_data[pos], sizeof(data_header));
+
+      // record the slot
+      NavMeshTileSlot slot;
+      slot.data_offset = pos;
+      slot.data_size = tile_header.data_size;
+      slot.x = data_header.x;
+      slot.y = data_header.y;
+      slot.file_ref = tile_header.tile_ref;
+      slot.loaded = false;
+      slot.last_used = 0u;
+      _tiles_by_cell[CellKey(slot.x, slot.y)].push_back(_tile_slots.size());
+      _tile_slots.push_back(slot);
 
-      // read the tile
-      memcpy(data, &content[pos], static_cast<size_t>(tile_header.data_size));
       pos += static_cast<unsigned long>(tile_header.data_size);
-      if (pos > content.size()) {
-        dtFree(data);
+      if (pos > _binary_size) {
         dtFreeNavMesh(mesh);
         return false;
       }
-
-      // add the tile data
-      mesh->addTile(reinterpret_cast<unsigned char *>(data), tile_header.data_size, DT_TILE_FREE_DATA,
-      tile_header.tile_ref, 0);
     }
 
+    // keep the grid parameters for mapping locations to tile cells
+    _navmesh_params = header.params;
+
     // exchange
     dtFreeNavMesh(_nav_mesh);
     _nav_mesh = mesh;
@@ -176,10 +278,11 @@ namespace nav {
     _nav_query = dtAllocNavMeshQuery();
     _nav_query->init(_nav_mesh, MAX_QUERY_SEARCH_NODES);
 
-    // copy
-    _binary_mesh = std::move(content);
     _ready = true;
 
+    // precompute the random-location sampler over the walkable polygons
+    BuildRandomLocationSampler();
+
     // create and init the crowd manager
     CreateCrowd();
 
@@ -193,62 +296,350 @@ namespace nav {
       return;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(_crowd_shards.empty());
+
+    // create and init each shard; every shard owns its own proximity grid
+    // and avoidance state, so they can be updated on separate threads
+    _crowd_shards.reserve(CROWD_SHARD_COUNT);
+    for (int shard = 0; shard < CROWD_SHARD_COUNT; ++shard) {
+      dtCrowd *crowd = dtAllocCrowd();
+      // these radius should be the maximum size of the vehicles (CarlaCola for Carla)
+      const float max_agent_radius = AGENT_RADIUS * 20;
+      if (!crowd->init(MAX_AGENTS, max_agent_radius, _nav_mesh)) {
+        logging::log("Nav: failed to create crowd");
+        dtFreeCrowd(crowd);
+        return;
+      }
+
+      // set different filters
+      // filter 0 can not walk on roads
+      crowd->getEditableFilter(0)->setIncludeFlags(CARLA_TYPE_WALKABLE);
+      crowd->getEditableFilter(0)->setExcludeFlags(CARLA_TYPE_ROAD);
+      crowd->getEditableFilter(0)->setAreaCost(CARLA_AREA_ROAD, AREA_ROAD_COST);
+      crowd->getEditableFilter(0)->setAreaCost(CARLA_AREA_GRASS, AREA_GRASS_COST);
+      // filter 1 can walk on roads
+      crowd->getEditableFilter(1)->setIncludeFlags(CARLA_TYPE_WALKABLE);
+      crowd->getEditableFilter(1)->setExcludeFlags(CARLA_TYPE_NONE);
+      crowd->getEditableFilter(1)->setAreaCost(CARLA_AREA_ROAD, AREA_ROAD_COST);
+      crowd->getEditableFilter(1)->setAreaCost(CARLA_AREA_GRASS, AREA_GRASS_COST);
+
+      // Setup local avoidance params to different qualities.
+      dtObstacleAvoidanceParams params;
+      // Use mostly default settings, copy from dtCrowd.
+      memcpy(&params, crowd->getObstacleAvoidanceParams(0), sizeof(dtObstacleAvoidanceParams));
+
+      // Low (11)
+      params.velBias = 0.5f;
+      params.adaptiveDivs = 5;
+      params.adaptiveRings = 2;
+      params.adaptiveDepth = 1;
+      crowd->setObstacleAvoidanceParams(0, &params);
+
+      // Medium (22)
+      params.velBias = 0.5f;
+      params.adaptiveDivs = 5;
+      params.adaptiveRings = 2;
+      params.adaptiveDepth = 2;
+      crowd->setObstacleAvoidanceParams(1, &params);
+
+      // Good (45)
+      params.velBias = 0.5f;
+      params.adaptiveDivs = 7;
+      params.adaptiveRings = 2;
+      params.adaptiveDepth = 3;
+      crowd->setObstacleAvoidanceParams(2, &params);
+
+      // High (66)
+      params.velBias = 0.5f;
+      params.adaptiveDivs = 7;
+      params.adaptiveRings = 3;
+      params.adaptiveDepth = 3;
+
+      crowd->setObstacleAvoidanceParams(3, &params);
+
+      _crowd_shards.push_back(crowd);
+    }
+  }
+
+  // resolve an agent handle to the crowd shard holding it
+  dtCrowd *Navigation::ShardOfAgent(int agent_handle) const {
+    return _crowd_shards[static_cast<size_t>(agent_handle / MAX_AGENTS)];
+  }
+
+  // resolve an agent handle to its local index inside the shard
+  int Navigation::ShardAgentIndex(int agent_handle) const {
+    return agent_handle % MAX_AGENTS;
+  }
+
+  // map a location (Unreal coordinates) to its tile cell
+  void Navigation::TileCellAt(const carla::geom::Location &location, int &tile_x, int &tile_y) const {
+    // the Recast ground plane is (x, z), which maps to Unreal (x, y)
+    tile_x = static_cast<int>(std::floor((location.x - _navmesh_params.orig[0]) / _navmesh_params.tileWidth));
+    tile_y = static_cast<int>(std::floor((location.y - _navmesh_params.orig[2]) / _navmesh_params.tileHeight));
+  }
+
+  // load all tile layers of a cell; the caller holds the mutex
+  void Navigation::LoadTileCell(int tile_x, int tile_y) {
+    auto it = _tiles_by_cell.find(CellKey(tile_x, tile_y));
+    if (it == _tiles_by_cell.end()) {
+      return;
+    }
+    for (size_t slot_index : it->second) {
+      NavMeshTileSlot &slot = _tile_slots[slot_index];
+      slot.last_used = ++_tile_clock;
+      if (slot.loaded) {
+        continue;
+      }
+      // copy the tile out of the binary; the navmesh frees the copy when
+      // the tile is unloaded
+      unsigned char *data = static_cast<unsigned char *>(dtAlloc(static_cast<size_t>(slot.data_size), DT_ALLOC_PERM));
+      if (!data) {
+        return;
+      }
+      memcpy(data, &_binary_data[slot.data_offset], static_cast<size_t>(slot.data_size));
+      if (dtStatusFailed(_nav_mesh->addTile(data, slot.data_size, DT_TILE_FREE_DATA, slot.file_ref, 0))) {
+        dtFree(data);
+        continue;
+      }
+      slot.loaded = true;
+      _loaded_tile_bytes += static_cast<uint64_t>(slot.data_size);
+    }
+  }
+
+  // load the ring of tiles around a location
+  void Navigation::EnsureTilesAround(const carla::geom::Location &location) {
+    if (_tile_slots.empty()) {
+      return;
+    }
+    int tile_x, tile_y;
+    TileCellAt(location, tile_x, tile_y);
+    // critical section, force single thread running this
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (int y = tile_y - TILE_LOAD_RADIUS; y <= tile_y + TILE_LOAD_RADIUS; ++y) {
+      for (int x = tile_x - TILE_LOAD_RADIUS; x <= tile_x + TILE_LOAD_RADIUS; ++x) {
+        LoadTileCell(x, y);
+      }
+    }
+  }
 
-    // create and init
-    _crowd = dtAllocCrowd();
-    // these radius should be the maximum size of the vehicles (CarlaCola for Carla)
-    const float max_agent_radius = AGENT_RADIUS * 20;
-    if (!_crowd->init(MAX_AGENTS, max_agent_radius, _nav_mesh)) {
-      logging::log("Nav: failed to create crowd");
+  // load the tiles along a segment, both endpoints included
+  void Navigation::EnsureTilesAlong(const carla::geom::Location &from, const carla::geom::Location &to) {
+    if (_tile_slots.empty()) {
       return;
     }
+    // sample the segment at half a tile, so no cell in between is skipped
+    const float step_size = 0.5f * std::min(_navmesh_params.tileWidth, _navmesh_params.tileHeight);
+    const float dx = to.x - from.x;
+    const float dy = to.y - from.y;
+    const float length = std::sqrt((dx * dx) + (dy * dy));
+    const int steps = std::max(1, static_cast<int>(std::ceil(length / step_size)));
+    for (int i = 0; i <= steps; ++i) {
+      const float fraction = static_cast<float>(i) / static_cast<float>(steps);
+      EnsureTilesAround(carla::geom::Location(from.x + (dx * fraction), from.y + (dy * fraction), from.z));
+    }
+  }
 
-    // set different filters
-    // filter 0 can not walk on roads
-    _crowd->getEditableFilter(0)->setIncludeFlags(CARLA_TYPE_WALKABLE);
-    _crowd->getEditableFilter(0)->setExcludeFlags(CARLA_TYPE_ROAD);
-    _crowd->getEditableFilter(0)->setAreaCost(CARLA_AREA_ROAD, AREA_ROAD_COST);
-    _crowd->getEditableFilter(0)->setAreaCost(CARLA_AREA_GRASS, AREA_GRASS_COST);
-    // filter 1 can walk on roads
-    _crowd->getEditableFilter(1)->setIncludeFlags(CARLA_TYPE_WALKABLE);
-    _crowd->getEditableFilter(1)->setExcludeFlags(CARLA_TYPE_NONE);
-    _crowd->getEditableFilter(1)->setAreaCost(CARLA_AREA_ROAD, AREA_ROAD_COST);
-    _crowd->getEditableFilter(1)->setAreaCost(CARLA_AREA_GRASS, AREA_GRASS_COST);
-
-    // Setup local avoidance params to different qualities.
-    dtObstacleAvoidanceParams params;
-    // Use mostly default settings, copy from dtCrowd.
-    memcpy(&params, _crowd->getObstacleAvoidanceParams(0), sizeof(dtObstacleAvoidanceParams));
-
-    // Low (11)
-    params.velBias = 0.5f;
-    params.adaptiveDivs = 5;
-    params.adaptiveRings = 2;
-    params.adaptiveDepth = 1;
-    _crowd->setObstacleAvoidanceParams(0, &params);
-
-    // Medium (22)
-    params.velBias = 0.5f;
-    params.adaptiveDivs = 5;
-    params.adaptiveRings = 2;
-    params.adaptiveDepth = 2;
-    _crowd->setObstacleAvoidanceParams(1, &params);
-
-    // Good (45)
-    params.velBias = 0.5f;
-    params.adaptiveDivs = 7;
-    params.adaptiveRings = 2;
-    params.adaptiveDepth = 3;
-    _crowd->setObstacleAvoidanceParams(2, &params);
-
-    // High (66)
-    params.velBias = 0.5f;
-    params.adaptiveDivs = 7;
-    params.adaptiveRings = 3;
-    params.adaptiveDepth = 3;
-
-    _crowd->setObstacleAvoidanceParams(3, &params);
+  // load tiles around all crowd agents and unload distant ones once over
+  // the memory budget
+  void Navigation::StreamTiles() {
+    if (_tile_slots.empty()) {
+      return;
+    }
+    // critical section, force single thread running this
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // collect the cells needed around every active agent
+    std::unordered_set<int64_t> needed;
+    for (dtCrowd *crowd : _crowd_shards) {
+      const int total_agents = crowd->getAgentCount();
+      for (int i = 0; i < total_agents; ++i) {
+        const dtCrowdAgent *agent = crowd->getAgent(i);
+        if (!agent->active) {
+          continue;
+        }
+        const int tile_x = static_cast<int>(std::floor((agent->npos[0] - _navmesh_params.orig[0]) / _navmesh_params.tileWidth));
+        const int tile_y = static_cast<int>(std::floor((agent->npos[2] - _navmesh_params.orig[2]) / _navmesh_params.tileHeight));
+        for (int y = tile_y - TILE_LOAD_RADIUS; y <= tile_y + TILE_LOAD_RADIUS; ++y) {
+          for (int x = tile_x - TILE_LOAD_RADIUS; x <= tile_x + TILE_LOAD_RADIUS; ++x) {
+            needed.insert(CellKey(x, y));
+          }
+        }
+      }
+    }
+
+    // load the cells that are missing
+    for (int64_t key : needed) {
+      LoadTileCell(static_cast<int>(key >> 32), static_cast<int>(static_cast<uint32_t>(key & 0xffffffff)));
+    }
+
+    // evict least recently used tiles until back under the budget, never
+    // touching the tiles needed this frame
+    if (_loaded_tile_bytes <= TILE_MEMORY_BUDGET) {
+      return;
+    }
+    std::vector<size_t> evictable;
+    for (size_t i = 0u; i < _tile_slots.size(); ++i) {
+      const NavMeshTileSlot &slot = _tile_slots[i];
+      if (slot.loaded && needed.find(CellKey(slot.x, slot.y)) == needed.end()) {
+        evictable.push_back(i);
+      }
+    }
+    std::sort(evictable.begin(), evictable.end(), [this](size_t a, size_t b) {
+      return _tile_slots[a].last_used < _tile_slots[b].last_used;
+    });
+    for (size_t slot_index : evictable) {
+      if (_loaded_tile_bytes <= TILE_MEMORY_BUDGET) {
+        break;
+      }
+      NavMeshTileSlot &slot = _tile_slots[slot_index];
+      // the tile copy is freed by the navmesh (DT_TILE_FREE_DATA)
+      _nav_mesh->removeTile(slot.file_ref, 0, 0);
+      slot.loaded = false;
+      _loaded_tile_bytes -= static_cast<uint64_t>(slot.data_size);
+    }
+  }
+
+  // build the alias-table sampler over the sidewalk polygons
+  void Navigation::BuildRandomLocationSampler() {
+    _sampler_polys.clear();
+
+    // collect every polygon matching the default random-location filter,
+    // weighted by its walkable surface
+    std::vector<double> weights;
+    double total_weight = 0.0;
+    for (const NavMeshTileSlot &slot : _tile_slots) {
+      SerializedMeshHeader mesh_header;
+      memcpy(&mesh_header, &_binary_data[slot.data_offset], sizeof(mesh_header));
+      const unsigned long verts_offset = slot.data_offset + sizeof(mesh_header);
+      const unsigned long polys_offset = verts_offset +
+          (static_cast<unsigned long>(mesh_header.vert_count) * 3u * sizeof(float));
+      for (int p = 0; p < mesh_header.poly_count; ++p) {
+        SerializedPoly poly;
+        memcpy(&poly, &_binary_data[polys_offset + (static_cast<unsigned long>(p) * sizeof(poly))], sizeof(poly));
+        // skip off-mesh connections and polygons outside the default filter
+        if ((poly.area_and_type >> 6) != 0u || (poly.flags & CARLA_TYPE_SIDEWALK) == 0u || poly.vert_count < 3u) {
+          continue;
+        }
+        // ground-plane area, as a fan of triangles
+        double area = 0.0;
+        float first[3], previous[3], current[3];
+        memcpy(first, &_binary_data[verts_offset + (static_cast<unsigned long>(poly.verts[0]) * 3u * sizeof(float))], sizeof(first));
+        memcpy(previous, &_binary_data[verts_offset + (static_cast<unsigned long>(poly.verts[1]) * 3u * sizeof(float))], sizeof(previous));
+        for (unsigned char v = 2u; v < poly.vert_count; ++v) {
+          memcpy(current, &_binary_data[verts_offset + (static_cast<unsigned long>(poly.verts[v]) * 3u * sizeof(float))], sizeof(current));
+          area += 0.5 * std::abs(
+              (static_cast<double>(previous[0]) - first[0]) * (static_cast<double>(current[2]) - first[2]) -
+              (static_cast<double>(current[0]) - first[0]) * (static_cast<double>(previous[2]) - first[2]));
+          memcpy(previous, current, sizeof(previous));
+        }
+        if (area <= 0.0) {
+          continue;
+        }
+        SamplerPoly sampler_poly;
+        sampler_poly.tile_offset = slot.data_offset;
+        sampler_poly.poly_index = p;
+        sampler_poly.probability = 1.0f;
+        sampler_poly.alias = static_cast<int>(_sampler_polys.size());
+        _sampler_polys.push_back(sampler_poly);
+        weights.push_back(area);
+        total_weight += area;
+      }
+    }
+    if (_sampler_polys.empty()) {
+      return;
+    }
+
+    // build the alias table (Vose's method), so a draw costs two random
+    // numbers regardless of the polygon count
+    const size_t count = _sampler_polys.size();
+    std::vector<double> scaled(count);
+    for (size_t i = 0u; i < count; ++i) {
+      scaled[i] = (weights[i] / total_weight) * static_cast<double>(count);
+    }
+    std::vector<size_t> small, large;
+    for (size_t i = 0u; i < count; ++i) {
+      (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+      const size_t s = small.back();
+      small.pop_back();
+      const size_t l = large.back();
+      large.pop_back();
+      _sampler_polys[s].probability = static_cast<float>(scaled[s]);
+      _sampler_polys[s].alias = static_cast<int>(l);
+      scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+      (scaled[l] < 1.0 ? small : large).push_back(l);
+    }
+    // the leftovers keep probability one and themselves as alias
+  }
+
+  // draw a random walkable location from the sampler
+  bool Navigation::SampleRandomLocation(carla::geom::Location &location) const {
+    if (_sampler_polys.empty()) {
+      return false;
+    }
+
+    // pick the polygon through the alias table
+    size_t index = std::min(
+        static_cast<size_t>(frand() * static_cast<float>(_sampler_polys.size())),
+        _sampler_polys.size() - 1u);
+    if (frand() >= _sampler_polys[index].probability) {
+      index = static_cast<size_t>(_sampler_polys[index].alias);
+    }
+    const SamplerPoly &sampler_poly = _sampler_polys[index];
+
+    // read the polygon vertices out of the binary
+    SerializedMeshHeader mesh_header;
+    memcpy(&mesh_header, &_binary_data[sampler_poly.tile_offset], sizeof(mesh_header));
+    const unsigned long verts_offset = sampler_poly.tile_offset + sizeof(mesh_header);
+    const unsigned long polys_offset = verts_offset +
+        (static_cast<unsigned long>(mesh_header.vert_count) * 3u * sizeof(float));
+    SerializedPoly poly;
+    memcpy(&poly, &_binary_data[polys_offset + (static_cast<unsigned long>(sampler_poly.poly_index) * sizeof(poly))], sizeof(poly));
+    float verts[6][3];
+    for (unsigned char v = 0u; v < poly.vert_count; ++v) {
+      memcpy(verts[v], &_binary_data[verts_offset + (static_cast<unsigned long>(poly.verts[v]) * 3u * sizeof(float))], sizeof(verts[v]));
+    }
+
+    // pick a triangle of the fan weighted by area
+    float areas[4];
+    float area_sum = 0.0f;
+    for (unsigned char v = 2u; v < poly.vert_count; ++v) {
+      areas[v - 2u] = 0.5f * std::abs(
+          ((verts[v - 1u][0] - verts[0][0]) * (verts[v][2] - verts[0][2])) -
+          ((verts[v][0] - verts[0][0]) * (verts[v - 1u][2] - verts[0][2])));
+      area_sum += areas[v - 2u];
+    }
+    unsigned char triangle = 2u;
+    float pick = frand() * area_sum;
+    for (unsigned char v = 2u; v < poly.vert_count; ++v) {
+      pick -= areas[v - 2u];
+      triangle = v;
+      if (pick <= 0.0f) {
+        break;
+      }
+    }
+
+    // uniform point inside the triangle
+    float u = frand();
+    float w = frand();
+    if (u + w > 1.0f) {
+      u = 1.0f - u;
+      w = 1.0f - w;
+    }
+    float point[3];
+    for (int axis = 0; axis < 3; ++axis) {
+      point[axis] = verts[0][axis] +
+          (u * (verts[triangle - 1u][axis] - verts[0][axis])) +
+          (w * (verts[triangle][axis] - verts[0][axis]));
+    }
+
+    // back to Unreal coordinates
+    location.x = point[0];
+    location.y = point[2];
+    location.z = point[1];
+
+    return true;
   }
 
   // return the path points to go from one position to another
@@ -275,6 +666,9 @@ namespace nav {
 
     DEBUG_ASSERT(_nav_query != nullptr);
 
+    // bring in the tiles along the requested corridor
+    EnsureTilesAlong(from, to);
+
     // point extension
     float poly_pick_ext[3];
     poly_pick_ext[0] = 2;
@@ -377,6 +771,9 @@ namespace nav {
 
     DEBUG_ASSERT(_nav_query != nullptr);
 
+    // bring in the tiles along the requested corridor
+    EnsureTilesAlong(from, to);
+
     // point extension
     float poly_pick_ext[3] = {2,4,2};
 
@@ -389,7 +786,8 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      filter = _crowd->getFilter(_crowd->getAgent(it->second)->params.queryFilterType);
+      dtCrowd *crowd = ShardOfAgent(it->second);
+      filter = crowd->getFilter(crowd->getAgent(ShardAgentIndex(it->second))->params.queryFilterType);
     }
 
     // set the points
@@ -466,7 +864,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowd_shards.empty());
 
     // set parameters
     memset(&params, 0, sizeof(params));
@@ -494,20 +892,26 @@ namespace nav {
     // from Unreal coordinates (subtract half height to move pivot from center
     // (unreal) to bottom (recast))
     float point_from[3] = { from.x, from.z - (AGENT_HEIGHT / 2.0f), from.y };
+    // make sure the tiles under the spawn point are resident
+    EnsureTilesAround(from);
+    // pick the shard from the actor id, so the assignment is stable and
+    // deterministic across runs
+    const int shard = static_cast<int>(id % static_cast<ActorId>(_crowd_shards.size()));
     // add walker
     int index;
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      index = _crowd->addAgent(point_from, &params);
+      index = _crowd_shards[static_cast<size_t>(shard)]->addAgent(point_from, &params);
       if (index == -1) {
         return false;
       }
     }
 
-    // save the id
-    _mapped_walkers_id[id] = index;
-    _mapped_by_index[index] = id;
+    // save the id, packing the shard into the agent handle
+    const int handle = (shard * MAX_AGENTS) + index;
+    _mapped_walkers_id[id] = handle;
+    _mapped_by_index[handle] = id;
 
     // init yaw
     _yaw_walkers[id] = 0.0f;
@@ -528,7 +932,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowd_shards.empty());
 
     // get the bounding box extension plus some space around
     float marge = 0.8f;
@@ -554,15 +958,19 @@ namespace nav {
     // check if this actor exists
     auto it = _mapped_vehicles_id.find(vehicle.id);
     if (it != _mapped_vehicles_id.end()) {
-      // get the index found
-      int index = it->second;
-      if (index != -1) {
+      // update the mirror copy kept in every shard
+      const std::vector<int> &shard_indices = _vehicle_shard_indices[vehicle.id];
+      for (size_t shard = 0u; shard < _crowd_shards.size(); ++shard) {
+        const int index = shard_indices[shard];
+        if (index == -1) {
+          continue;
+        }
         // get the agent
         dtCrowdAgent *agent;
         {
           // critical section, force single thread running this
           std::lock_guard<std::mutex> lock(_mutex);
-          agent = _crowd->getEditableAgent(index);
+          agent = _crowd_shards[shard]->getEditableAgent(index);
         }
         if (agent) {
           // update its position
@@ -583,8 +991,8 @@ namespace nav {
           agent->params.obb[10] = box_corner4.z;
           agent->params.obb[11] = box_corner4.y;
         }
-        return true;
       }
+      return true;
     }
 
     // set parameters
@@ -622,27 +1030,39 @@ namespace nav {
                             vehicle.transform.location.z,
                             vehicle.transform.location.y };
 
-    // add walker
-    int index;
-    {
-      // critical section, force single thread running this
-      std::lock_guard<std::mutex> lock(_mutex);
-      index = _crowd->addAgent(point_from, &params);
-      if (index == -1) {
-        logging::log("Vehicle agent not added to the crowd by some problem!");
-        return false;
-      }
+    // make sure the tiles under the vehicle are resident
+    EnsureTilesAround(vehicle.transform.location);
 
-      // mark as valid
-      dtCrowdAgent *agent = _crowd->getEditableAgent(index);
-      if (agent) {
-        agent->state = DT_CROWDAGENT_STATE_WALKING;
+    // add a mirror copy of the vehicle to every shard, so the walkers of
+    // each shard keep avoiding it
+    std::vector<int> shard_indices(_crowd_shards.size(), -1);
+    for (size_t shard = 0u; shard < _crowd_shards.size(); ++shard) {
+      int index;
+      {
+        // critical section, force single thread running this
+        std::lock_guard<std::mutex> lock(_mutex);
+        index = _crowd_shards[shard]->addAgent(point_from, &params);
+        if (index == -1) {
+          logging::log("Vehicle agent not added to the crowd by some problem!");
+          continue;
+        }
+
+        // mark as valid
+        dtCrowdAgent *agent = _crowd_shards[shard]->getEditableAgent(index);
+        if (agent) {
+          agent->state = DT_CROWDAGENT_STATE_WALKING;
+        }
       }
+      shard_indices[shard] = index;
+      _mapped_by_index[(static_cast<int>(shard) * MAX_AGENTS) + index] = vehicle.id;
+    }
+    if (shard_indices[0] == -1) {
+      return false;
     }
 
-    // save the id
-    _mapped_vehicles_id[vehicle.id] = index;
-    _mapped_by_index[index] = vehicle.id;
+    // save the id; the handle kept in the id mapping is the shard 0 copy
+    _mapped_vehicles_id[vehicle.id] = shard_indices[0];
+    _vehicle_shard_indices[vehicle.id] = std::move(shard_indices);
 
     return true;
   }
@@ -655,7 +1075,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowd_shards.empty());
 
     // get the internal walker index
     auto it = _mapped_walkers_id.find(id);
@@ -664,7 +1084,7 @@ namespace nav {
       {
         // critical section, force single thread running this
         std::lock_guard<std::mutex> lock(_mutex);
-        _crowd->removeAgent(it->second);
+        ShardOfAgent(it->second)->removeAgent(ShardAgentIndex(it->second));
       }
       _walker_manager.RemoveWalker(id);
       // remove from mapping
@@ -677,15 +1097,23 @@ namespace nav {
     // get the internal vehicle index
     it = _mapped_vehicles_id.find(id);
     if (it != _mapped_vehicles_id.end()) {
-      // remove from crowd
-      {
-        // critical section, force single thread running this
-        std::lock_guard<std::mutex> lock(_mutex);
-        _crowd->removeAgent(it->second);
+      // remove the mirror copy from every shard
+      const std::vector<int> &shard_indices = _vehicle_shard_indices[id];
+      for (size_t shard = 0u; shard < _crowd_shards.size(); ++shard) {
+        const int index = shard_indices[shard];
+        if (index == -1) {
+          continue;
+        }
+        {
+          // critical section, force single thread running this
+          std::lock_guard<std::mutex> lock(_mutex);
+          _crowd_shards[shard]->removeAgent(index);
+        }
+        _mapped_by_index.erase((static_cast<int>(shard) * MAX_AGENTS) + index);
       }
       // remove from mapping
       _mapped_vehicles_id.erase(it);
-      _mapped_by_index.erase(it->second);
+      _vehicle_shard_indices.erase(id);
 
       return true;
     }
@@ -727,7 +1155,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowd_shards.empty());
 
     // get the internal index
     auto it = _mapped_walkers_id.find(id);
@@ -739,7 +1167,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      dtCrowdAgent *agent = _crowd->getEditableAgent(it->second);
+      dtCrowdAgent *agent = ShardOfAgent(it->second)->getEditableAgent(ShardAgentIndex(it->second));
       if (agent) {
         agent->params.maxSpeed = max_speed;
         return true;
@@ -791,13 +1219,16 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowd_shards.empty());
     DEBUG_ASSERT(_nav_query != nullptr);
 
     if (index == -1) {
       return false;
     }
 
+    // make sure the tiles around the target are resident
+    EnsureTilesAround(to);
+
     // set target position
     float point_to[3] = { to.x, to.z, to.y };
     float nearest[3];
@@ -805,14 +1236,15 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      const dtQueryFilter *filter = _crowd->getFilter(0);
+      dtCrowd *crowd = ShardOfAgent(index);
+      const dtQueryFilter *filter = crowd->getFilter(0);
       dtPolyRef target_ref;
-      _nav_query->findNearestPoly(point_to, _crowd->getQueryHalfExtents(), filter, &target_ref, nearest);
+      _nav_query->findNearestPoly(point_to, crowd->getQueryHalfExtents(), filter, &target_ref, nearest);
       if (!target_ref) {
         return false;
       }
 
-      res = _crowd->requestMoveTarget(index, target_ref, point_to);
+      res = crowd->requestMoveTarget(ShardAgentIndex(index), target_ref, point_to);
     }
 
     return res;
@@ -826,14 +1258,30 @@ namespace nav {
       return;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowd_shards.empty());
 
-    // update crowd agents
+    // update crowd agents, one worker per shard; the shards are
+    // independent (each has its own proximity grid and avoidance state,
+    // and the navmesh is read-only here), so they can step concurrently
     _delta_seconds = state.GetTimestamp().delta_seconds;
+
+    // load the tiles around the agents and unload distant ones over budget
+    StreamTiles();
     {
-      // critical section, force single thread running this
+      // critical section, the workers are the only threads touching the crowds
       std::lock_guard<std::mutex> lock(_mutex);
-      _crowd->update(static_cast<float>(_delta_seconds), nullptr);
+      const float dt = static_cast<float>(_delta_seconds);
+      std::vector<std::thread> workers;
+      workers.reserve(_crowd_shards.size() - 1u);
+      for (size_t shard = 1u; shard < _crowd_shards.size(); ++shard) {
+        workers.emplace_back([this, shard, dt]() {
+          _crowd_shards[shard]->update(dt, nullptr);
+        });
+      }
+      _crowd_shards[0]->update(dt, nullptr);
+      for (std::thread &worker : workers) {
+        worker.join();
+      }
     }
 
     // update the walkers route
@@ -842,59 +1290,64 @@ namespace nav {
     // update the time to check for blocked agents
     _time_to_unblock += _delta_seconds;
 
-    // check all active agents
+    // check all active agents, shard by shard
     int total_unblocked = 0;
-    int total_agents;
-    {
-      // critical section, force single thread running this
-      std::lock_guard<std::mutex> lock(_mutex);
-      total_agents = _crowd->getAgentCount();
-    }
-    const dtCrowdAgent *ag;
-    for (int i = 0; i < total_agents; ++i) {
+    for (size_t shard = 0u; shard < _crowd_shards.size(); ++shard) {
+      int total_agents;
       {
         // critical section, force single thread running this
         std::lock_guard<std::mutex> lock(_mutex);
-        ag = _crowd->getAgent(i);
-      }
-      if (!ag->active || ag->paused) {
-        continue;
+        total_agents = _crowd_shards[shard]->getAgentCount();
       }
+      const dtCrowdAgent *ag;
+      for (int i = 0; i < total_agents; ++i) {
+        {
+          // critical section, force single thread running this
+          std::lock_guard<std::mutex> lock(_mutex);
+          ag = _crowd_shards[shard]->getAgent(i);
+        }
+        if (!ag->active || ag->paused) {
+          continue;
+        }
 
-      // check only pedestrians not paused, and no vehicles
-      if (!ag->params.useObb && !ag->paused) {
-        bool reset_target_pos = false;
-        bool use_same_filter = false;
-
-        // check for unblocking actors
-        if (_time_to_unblock >= AGENT_UNBLOCK_TIME) {
-          // get the distance moved by each actor
-          carla::geom::Vector3D previous = _walkers_blocked_position[i];
-          carla::geom::Vector3D current = carla::geom::Vector3D(ag->npos[0], ag->npos[1], ag->npos[2]);
-          carla::geom::Vector3D distance = current - previous;
-          float d = distance.SquaredLength();
-          if (d < AGENT_UNBLOCK_DISTANCE_SQUARED) {
-            ++total_unblocked;
-            reset_target_pos = true;
-            use_same_filter = true;
-          }
-          // update with current position
-          _walkers_blocked_position[i] = current;
-
-          // check to assign a new target position
-          if (reset_target_pos) {
-            // set if the agent can cross roads or not
-            if (!use_same_filter) {
-              if (frand() <= _probability_crossing) {
-                SetAgentFilter(i, 1);
-              } else {
-                SetAgentFilter(i, 0);
+        // the agent handle packs the shard and the local index
+        const int handle = (static_cast<int>(shard) * MAX_AGENTS) + i;
+
+        // check only pedestrians not paused, and no vehicles
+        if (!ag->params.useObb && !ag->paused) {
+          bool reset_target_pos = false;
+          bool use_same_filter = false;
+
+          // check for unblocking actors
+          if (_time_to_unblock >= AGENT_UNBLOCK_TIME) {
+            // get the distance moved by each actor
+            carla::geom::Vector3D previous = _walkers_blocked_position[handle];
+            carla::geom::Vector3D current = carla::geom::Vector3D(ag->npos[0], ag->npos[1], ag->npos[2]);
+            carla::geom::Vector3D distance = current - previous;
+            float d = distance.SquaredLength();
+            if (d < AGENT_UNBLOCK_DISTANCE_SQUARED) {
+              ++total_unblocked;
+              reset_target_pos = true;
+              use_same_filter = true;
+            }
+            // update with current position
+            _walkers_blocked_position[handle] = current;
+
+            // check to assign a new target position
+            if (reset_target_pos) {
+              // set if the agent can cross roads or not
+              if (!use_same_filter) {
+                if (frand() <= _probability_crossing) {
+                  SetAgentFilter(handle, 1);
+                } else {
+                  SetAgentFilter(handle, 0);
+                }
               }
+              // set a new random target
+              carla::geom::Location location;
+              GetRandomLocation(location, nullptr);
+              _walker_manager.SetWalkerRoute(_mapped_by_index[handle], location);
             }
-            // set a new random target
-            carla::geom::Location location;
-            GetRandomLocation(location, nullptr);
-            _walker_manager.SetWalkerRoute(_mapped_by_index[i], location);
           }
         }
       }
@@ -914,7 +1367,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowd_shards.empty());
 
     // get the internal index
     auto it = _mapped_walkers_id.find(id);
@@ -933,7 +1386,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getAgent(index);
+      agent = ShardOfAgent(index)->getAgent(ShardAgentIndex(index));
     }
 
     if (!agent->active) {
@@ -978,7 +1431,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowd_shards.empty());
 
     // get the internal index
     auto it = _mapped_walkers_id.find(id);
@@ -997,7 +1450,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getAgent(index);
+      agent = ShardOfAgent(index)->getAgent(ShardAgentIndex(index));
     }
 
     if (!agent->active) {
@@ -1012,6 +1465,39 @@ namespace nav {
     return true;
   }
 
+  void Navigation::GetWalkerPositions(const std::vector<ActorId> &ids, std::vector<carla::geom::Location> &locations) {
+
+    locations.resize(ids.size());
+
+    // check if all is ready
+    if (!_ready) {
+      return;
+    }
+
+    DEBUG_ASSERT(!_crowd_shards.empty());
+
+    // critical section, force single thread running this
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (size_t i = 0u; i < ids.size(); ++i) {
+      // get the internal index
+      auto it = _mapped_walkers_id.find(ids[i]);
+      if (it == _mapped_walkers_id.end() || it->second == -1) {
+        continue;
+      }
+
+      // get the walker
+      const dtCrowdAgent *agent = ShardOfAgent(it->second)->getAgent(ShardAgentIndex(it->second));
+      if (!agent->active) {
+        continue;
+      }
+
+      // set its position in Unreal coordinates
+      locations[i].x = agent->npos[0];
+      locations[i].y = agent->npos[2];
+      locations[i].z = agent->npos[1];
+    }
+  }
+
   float Navigation::GetWalkerSpeed(ActorId id) {
 
     // check if all is ready
@@ -1019,7 +1505,7 @@ namespace nav {
       return 0.0f;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowd_shards.empty());
 
     // get the internal index
     auto it = _mapped_walkers_id.find(id);
@@ -1038,7 +1524,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getAgent(index);
+      agent = ShardOfAgent(index)->getAgent(ShardAgentIndex(index));
     }
 
     return sqrt(agent->vel[0] * agent->vel[0] + agent->vel[1] * agent->vel[1] + agent->vel[2] *
@@ -1046,7 +1532,7 @@ namespace nav {
   }
 
   // get a random location for navigation
-  bool Navigation::GetRandomLocation(carla::geom::Location &location, dtQueryFilter * filter) const {
+  bool Navigation::GetRandomLocation(carla::geom::Location &location, dtQueryFilter * filter) {
 
     // check if all is ready
     if (!_ready) {
@@ -1055,6 +1541,23 @@ namespace nav {
 
     DEBUG_ASSERT(_nav_query != nullptr);
 
+    // fast path: without a custom filter, draw from the precomputed
+    // sampler, which takes no lock and needs no resident tiles
+    if (filter == nullptr && SampleRandomLocation(location)) {
+      return true;
+    }
+
+    // the random query only sees resident tiles, so bring in a randomly
+    // chosen tile first to keep whole-map coverage
+    if (!_tile_slots.empty()) {
+      const size_t slot_index = std::min(
+          static_cast<size_t>(frand() * static_cast<float>(_tile_slots.size())),
+          _tile_slots.size() - 1u);
+      // critical section, force single thread running this
+      std::lock_guard<std::mutex> lock(_mutex);
+      LoadTileCell(_tile_slots[slot_index].x, _tile_slots[slot_index].y);
+    }
+
     // filter
     dtQueryFilter filter2;
     if (filter == nullptr) {
@@ -1094,7 +1597,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getEditableAgent(agent_index);
+      agent = ShardOfAgent(agent_index)->getEditableAgent(ShardAgentIndex(agent_index));
     }
     agent->params.queryFilterType = static_cast<unsigned char>(filter_index);
   }
@@ -1115,7 +1618,7 @@ namespace nav {
       return;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowd_shards.empty());
 
     // get the internal index
     auto it = _mapped_walkers_id.find(id);
@@ -1134,7 +1637,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getEditableAgent(index);
+      agent = ShardOfAgent(index)->getEditableAgent(ShardAgentIndex(index));
     }
 
     // mark
@@ -1156,11 +1659,37 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      result = _crowd->hasVehicleNear(it->second, distance * distance, dir, false);
+      dtCrowd *crowd = ShardOfAgent(it->second);
+      result = crowd->hasVehicleNear(ShardAgentIndex(it->second), distance * distance, dir, false);
     }
     return result;
   }
 
+  void Navigation::HasVehiclesNear(const std::vector<ActorId> &ids, float distance,
+  const std::vector<carla::geom::Location> &directions, std::vector<uint8_t> &results) {
+    DEBUG_ASSERT(ids.size() == directions.size());
+    results.assign(ids.size(), 0u);
+
+    // critical section, force single thread running this
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (size_t i = 0u; i < ids.size(); ++i) {
+      // get the internal index (walker or vehicle)
+      auto it = _mapped_walkers_id.find(ids[i]);
+      if (it == _mapped_walkers_id.end()) {
+        it = _mapped_vehicles_id.find(ids[i]);
+        if (it == _mapped_vehicles_id.end()) {
+          continue;
+        }
+      }
+
+      float dir[3] = { directions[i].x, directions[i].z, directions[i].y };
+      dtCrowd *crowd = ShardOfAgent(it->second);
+      if (crowd->hasVehicleNear(ShardAgentIndex(it->second), distance * distance, dir, false)) {
+        results[i] = 1u;
+      }
+    }
+  }
+
   /// make agent look at some location
   bool Navigation::SetWalkerLookAt(ActorId id, carla::geom::Location location) {
     // get the internal index (walker or vehicle)
@@ -1176,7 +1705,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getEditableAgent(it->second);
+      agent = ShardOfAgent(it->second)->getEditableAgent(ShardAgentIndex(it->second));
     }
 
     // get the position
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/AtomicList.h"
+#include "carla/FileSystem.h"
 #include "carla/client/detail/EpisodeState.h"
 #include "carla/geom/BoundingBox.h"
 #include "carla/geom/Location.h"
@@ -61,7 +62,8 @@ namespace nav {
     Navigation();
     ~Navigation();
 
-    /// load navigation data
+    /// load navigation data, mapping the file so tile data is paged in on
+    /// demand instead of copied to the heap upfront
     bool Load(const std::string &filename);
     /// load navigation data from memory
     bool Load(std::vector<uint8_t> content);
@@ -92,39 +94,99 @@ namespace nav {
     bool GetWalkerTransform(ActorId id, carla::geom::Transform &trans);
     /// get the walker current location
     bool GetWalkerPosition(ActorId id, carla::geom::Location &location);
+    /// get the current location of several walkers taking the lock only once
+    void GetWalkerPositions(const std::vector<ActorId> &ids, std::vector<carla::geom::Location> &locations);
     /// get the walker current transform
     float GetWalkerSpeed(ActorId id);
     /// update all walkers in crowd
     void UpdateCrowd(const client::detail::EpisodeState &state);
     /// get a random location for navigation
-    bool GetRandomLocation(carla::geom::Location &location, dtQueryFilter * filter = nullptr) const;
+    bool GetRandomLocation(carla::geom::Location &location, dtQueryFilter * filter = nullptr);
     /// set the probability that an agent could cross the roads in its path following
     void SetPedestriansCrossFactor(float percentage);
     /// set an agent as paused for the crowd
     void PauseAgent(ActorId id, bool pause);
     /// return if the agent has a vehicle near (as neighbour)
     bool HasVehicleNear(ActorId id, float distance, carla::geom::Location direction);
+    /// check several agents for a near vehicle taking the lock only once
+    void HasVehiclesNear(const std::vector<ActorId> &ids, float distance,
+    const std::vector<carla::geom::Location> &directions, std::vector<uint8_t> &results);
     /// make agent look at some location
     bool SetWalkerLookAt(ActorId id, carla::geom::Location location);
 
-    dtCrowd *GetCrowd() { return _crowd; };
+    /// return the first crowd shard, for debug drawing only; walkers are
+    /// spread over all shards
+    dtCrowd *GetCrowd() { return _crowd_shards.empty() ? nullptr : _crowd_shards[0]; };
 
     /// return the last delta seconds
     double GetDeltaSeconds() { return _delta_seconds; };
 
   private:
 
+    /// one tile of the navmesh binary, loadable on demand
+    struct NavMeshTileSlot {
+      /// offset of the tile data inside the binary
+      unsigned long data_offset;
+      int data_size;
+      /// tile cell in the navmesh grid
+      int x;
+      int y;
+      /// tile reference assigned by the baking, reused on every load so
+      /// polygon references stay stable across load/unload cycles
+      dtTileRef file_ref;
+      bool loaded;
+      /// logical time of last use, for least-recently-used eviction
+      uint64_t last_used;
+    };
+
+    /// parse the navmesh binary pointed by _binary_data/_binary_size
+    bool LoadBinary();
+
     bool _ready { false };
+    /// navmesh binary when it comes from memory (the server)
     std::vector<uint8_t> _binary_mesh;
+    /// navmesh binary when it comes from a file, mapped read-only
+    MappedFile _mapped_mesh;
+    /// view over whichever of the two holds the current navmesh
+    const uint8_t *_binary_data { nullptr };
+    size_t _binary_size { 0u };
     double _delta_seconds { 0.0 };
+    /// per-tile slots of the navmesh binary, loaded on demand
+    std::vector<NavMeshTileSlot> _tile_slots;
+    /// slot indices by tile cell (several layers can share a cell)
+    std::unordered_map<int64_t, std::vector<size_t>> _tiles_by_cell;
+    /// navmesh grid parameters, for mapping locations to tile cells
+    dtNavMeshParams _navmesh_params {};
+    /// bytes of tile data currently resident
+    uint64_t _loaded_tile_bytes { 0u };
+    /// logical clock driving least-recently-used tile eviction
+    uint64_t _tile_clock { 0u };
+
+    /// one entry of the precomputed random-location sampler
+    struct SamplerPoly {
+      /// offset of the owning tile data inside the binary
+      unsigned long tile_offset;
+      /// index of the polygon inside the tile
+      int poly_index;
+      /// alias-method probability table
+      float probability;
+      int alias;
+    };
+    /// alias-table sampler over the default walkable polygons, built once
+    /// at navmesh load; sampling reads only immutable data, so it takes
+    /// no lock and needs no resident tiles
+    std::vector<SamplerPoly> _sampler_polys;
     /// meshes
     dtNavMesh *_nav_mesh { nullptr };
     dtNavMeshQuery *_nav_query { nullptr };
-    /// crowd
-    dtCrowd *_crowd { nullptr };
-    /// mapping Id
+    /// crowd shards, each with its own proximity grid; agents are updated
+    /// in parallel, one worker per shard
+    std::vector<dtCrowd *> _crowd_shards;
+    /// mapping Id to agent handle (shard and local index packed together)
     std::unordered_map<ActorId, int> _mapped_walkers_id;
     std::unordered_map<ActorId, int> _mapped_vehicles_id;
+    /// local index of each vehicle's mirror copy in every shard
+    std::unordered_map<ActorId, std::vector<int>> _vehicle_shard_indices;
     // mapping by index also
     std::unordered_map<int, ActorId> _mapped_by_index;
     /// store walkers yaw angle from previous tick
@@ -142,6 +204,25 @@ namespace nav {
 
     /// assign a filter index to an agent
     void SetAgentFilter(int agent_index, int filter_index);
+    /// resolve an agent handle to the crowd shard holding it
+    dtCrowd *ShardOfAgent(int agent_handle) const;
+    /// resolve an agent handle to its local index inside the shard
+    int ShardAgentIndex(int agent_handle) const;
+    /// map a location (Unreal coordinates) to its tile cell
+    void TileCellAt(const carla::geom::Location &location, int &tile_x, int &tile_y) const;
+    /// load all tile layers of a cell; the caller holds the mutex
+    void LoadTileCell(int tile_x, int tile_y);
+    /// load the ring of tiles around a location
+    void EnsureTilesAround(const carla::geom::Location &location);
+    /// load the tiles along a segment, both endpoints included
+    void EnsureTilesAlong(const carla::geom::Location &from, const carla::geom::Location &to);
+    /// load tiles around all crowd agents and unload distant ones once
+    /// over the memory budget
+    void StreamTiles();
+    /// build the alias-table sampler over the sidewalk polygons
+    void BuildRandomLocationSampler();
+    /// draw a random walkable location from the sampler
+    bool SampleRandomLocation(carla::geom::Location &location) const;
   };
 
 } // namespace nav
@@ -45,7 +45,8 @@ namespace nav {
     /// visitor class
     class WalkerEventVisitor {
         public:
-            WalkerEventVisitor(WalkerManager *manager, ActorId id, double delta) : _manager(manager), _id(id), _delta(delta) {};
+            WalkerEventVisitor(WalkerManager *manager, ActorId id, double delta, bool has_vehicle_near = false) :
+            _manager(manager), _id(id), _delta(delta), _has_vehicle_near(has_vehicle_near) {};
             EventResult operator()(WalkerEventIgnore &event);
             EventResult operator()(WalkerEventWait &event);
             EventResult operator()(WalkerEventStopAndCheck &event);
@@ -53,6 +54,9 @@ namespace nav {
             WalkerManager *_manager { nullptr };
             ActorId _id { 0 };
             double _delta { 0 };
+            /// batched vehicle-near answer, resolved by the manager for all
+            /// the stopped walkers at once before visiting the events
+            bool _has_vehicle_near { false };
     };
 
 } // namespace nav
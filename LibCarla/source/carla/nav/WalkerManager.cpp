@@ -42,54 +42,99 @@ namespace nav {
 	// update all routes
     bool WalkerManager::Update(double delta) {
 
-        // check all walkers
+        // partition the walkers by state, so each pass below runs over a
+        // contiguous array and the per-walker queries can be batched
+        _walking.clear();
+        _in_event.clear();
+        _stopped.clear();
         for (auto &it : _walkers) {
-
-            // get the elements
-            WalkerInfo &info = it.second;
-
-            // in function of the state
-            switch (info.state) {
+            switch (it.second.state) {
                 case WALKER_IDLE:
                     break;
-
                 case WALKER_WALKING:
-                    {
-                        // get the target point
-                        carla::geom::Location &target = info.route[info.currentIndex].location;
-                        // get current position
-                        carla::geom::Location current;
-                        _nav->GetWalkerPosition(it.first, current);
-                        // check distance to the target point
-                        carla::geom::Vector3D dist(target.x - current.x, target.z - current.z, target.y - current.y);
-                        if (dist.SquaredLength() <= 4) {
-                            info.state = WALKER_IN_EVENT;
-                            _nav->PauseAgent(it.first, true);
-                        }
-                    }
+                    _walking.push_back(it.first);
                     break;
-
                 case WALKER_IN_EVENT:
-                    switch (ExecuteEvent(it.first, it.second, delta)) {
-                        case EventResult::Continue:
-                            break;
-                        case EventResult::End:
-                            // next point in route
-                            SetWalkerNextPoint(it.first);
-                            break;
-                        case EventResult::TimeOut:
-                            // unblock changing the route
-                            SetWalkerRoute(it.first);
-                            break;
-                    }
+                    _in_event.push_back(it.first);
                     break;
-
                 case WALKER_STOP:
-                    info.state = WALKER_IDLE;
+                    _stopped.push_back(it.first);
+                    break;
+            }
+        }
+
+        // get the position of every walking and in-event walker in a single
+        // query, taking the crowd lock only once
+        _query_ids.assign(_walking.begin(), _walking.end());
+        _query_ids.insert(_query_ids.end(), _in_event.begin(), _in_event.end());
+        _nav->GetWalkerPositions(_query_ids, _positions);
+
+        // walking walkers: check the distance to their target point
+        for (size_t i = 0u; i < _walking.size(); ++i) {
+            WalkerInfo &info = _walkers[_walking[i]];
+            // get the target point
+            carla::geom::Location &target = info.route[info.currentIndex].location;
+            // get current position
+            carla::geom::Location &current = _positions[i];
+            // check distance to the target point
+            carla::geom::Vector3D dist(target.x - current.x, target.z - current.z, target.y - current.y);
+            if (dist.SquaredLength() <= 4) {
+                info.state = WALKER_IN_EVENT;
+                _nav->PauseAgent(_walking[i], true);
+            }
+        }
+
+        // walkers stopped at a road: resolve all the vehicle-near checks in
+        // a single pass over the crowd before visiting the events
+        _check_ids.clear();
+        _check_directions.clear();
+        for (size_t i = 0u; i < _in_event.size(); ++i) {
+            WalkerInfo &info = _walkers[_in_event[i]];
+            WalkerEventStopAndCheck *event = boost::get<WalkerEventStopAndCheck>(&info.route[info.currentIndex].event);
+            // events about to time out skip their check anyway
+            if (event == nullptr || event->time - delta <= 0.0)
+                continue;
+            // calculate the direction to look for vehicles
+            carla::geom::Location &current = _positions[_walking.size() + i];
+            carla::geom::Location crosswalkEnd;
+            GetWalkerCrosswalkEnd(_in_event[i], crosswalkEnd);
+            carla::geom::Location direction;
+            direction.x = crosswalkEnd.x - current.x;
+            direction.y = crosswalkEnd.y - current.y;
+            direction.z = crosswalkEnd.z - current.z;
+            _check_ids.push_back(_in_event[i]);
+            _check_directions.push_back(direction);
+        }
+        _nav->HasVehiclesNear(_check_ids, 6.0f, _check_directions, _check_results);
+
+        // in-event walkers: run the event with the batched answers
+        size_t check_cursor = 0;
+        for (size_t i = 0u; i < _in_event.size(); ++i) {
+            ActorId id = _in_event[i];
+            bool has_vehicle_near = false;
+            if (check_cursor < _check_ids.size() && _check_ids[check_cursor] == id) {
+                has_vehicle_near = (_check_results[check_cursor] != 0u);
+                ++check_cursor;
+            }
+            switch (ExecuteEvent(id, _walkers[id], delta, has_vehicle_near)) {
+                case EventResult::Continue:
+                    break;
+                case EventResult::End:
+                    // next point in route
+                    SetWalkerNextPoint(id);
+                    break;
+                case EventResult::TimeOut:
+                    // unblock changing the route
+                    SetWalkerRoute(id);
                     break;
             }
         }
 
+        // stopped walkers go back to idle
+        for (ActorId id : _stopped) {
+            _walkers[id].state = WALKER_IDLE;
+        }
+
         return true;
     }
 
@@ -247,12 +292,12 @@ namespace nav {
         return false;
     }
 
-    EventResult WalkerManager::ExecuteEvent(ActorId id, WalkerInfo &info, double delta) {
+    EventResult WalkerManager::ExecuteEvent(ActorId id, WalkerInfo &info, double delta, bool has_vehicle_near) {
         // go to the event
         WalkerRoutePoint &rp = info.route[info.currentIndex];
 
         // build the visitor structure
-        WalkerEventVisitor visitor(this, id, delta);
+        WalkerEventVisitor visitor(this, id, delta, has_vehicle_near);
         // run the event
         return boost::apply_visitor(visitor, rp.event);
     }
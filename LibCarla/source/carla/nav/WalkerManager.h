@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include "carla/NonCopyable.h"
 
 #include "carla/geom/Location.h"
@@ -76,10 +79,22 @@ namespace nav {
 
     private:
 
-    EventResult ExecuteEvent(ActorId id, WalkerInfo &info, double delta);
+    EventResult ExecuteEvent(ActorId id, WalkerInfo &info, double delta, bool has_vehicle_near);
 
     std::unordered_map<ActorId, WalkerInfo> _walkers;
     Navigation *_nav { nullptr };
+
+    /// per-tick scratch arrays with the walkers partitioned by state
+    std::vector<ActorId> _walking;
+    std::vector<ActorId> _in_event;
+    std::vector<ActorId> _stopped;
+    /// per-tick batch of position queries (walking plus in-event walkers)
+    std::vector<ActorId> _query_ids;
+    std::vector<carla::geom::Location> _positions;
+    /// per-tick batch of vehicle-near queries for walkers stopped at a road
+    std::vector<ActorId> _check_ids;
+    std::vector<carla::geom::Location> _check_directions;
+    std::vector<uint8_t> _check_results;
   };
 
 } // namespace nav
@@ -21,6 +21,11 @@
 
 #include <pugixml/pugixml.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace carla {
 namespace opendrive {
 
@@ -38,9 +43,48 @@ namespace opendrive {
     parser::GeoReferenceParser::Parse(xml, map_builder);
     parser::RoadParser::Parse(xml, map_builder);
     parser::JunctionParser::Parse(xml, map_builder);
-    parser::GeometryParser::Parse(xml, map_builder);
-    parser::LaneParser::Parse(xml, map_builder);
-    parser::ProfilesParser::Parse(xml, map_builder);
+
+    // Geometry, lane, and profile extraction are independent per road, so
+    // instead of three more passes over the document do a single pass over
+    // the <road> elements and spread the roads over a pool of workers. The
+    // remaining parsers mutate shared builder state in an order-dependent
+    // way and stay sequential.
+    std::vector<pugi::xml_node> road_nodes;
+    for (pugi::xml_node node_road : xml.child("OpenDRIVE").children("road")) {
+      road_nodes.emplace_back(node_road);
+    }
+
+    auto parse_road = [&map_builder, &road_nodes](size_t index) {
+      parser::GeometryParser::ParseRoad(road_nodes[index], map_builder);
+      parser::LaneParser::ParseRoad(road_nodes[index], map_builder);
+      parser::ProfilesParser::ParseRoad(road_nodes[index], map_builder);
+    };
+
+    const size_t num_workers = std::min<size_t>(
+        std::max(1u, std::thread::hardware_concurrency()),
+        road_nodes.size());
+    if (num_workers < 2u) {
+      for (size_t i = 0u; i < road_nodes.size(); ++i) {
+        parse_road(i);
+      }
+    } else {
+      std::atomic<size_t> next_road(0u);
+      std::vector<std::thread> workers;
+      workers.reserve(num_workers);
+      for (size_t i = 0u; i < num_workers; ++i) {
+        workers.emplace_back([&]() {
+          for (auto index = next_road.fetch_add(1u);
+              index < road_nodes.size();
+              index = next_road.fetch_add(1u)) {
+            parse_road(index);
+          }
+        });
+      }
+      for (auto &worker : workers) {
+        worker.join();
+      }
+    }
+
     parser::TrafficGroupParser::Parse(xml, map_builder);
     parser::SignalParser::Parse(xml, map_builder);
     parser::ObjectParser::Parse(xml, map_builder);
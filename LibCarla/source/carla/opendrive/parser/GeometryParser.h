@@ -8,6 +8,7 @@
 
 namespace pugi {
   class xml_document;
+  class xml_node;
 } // namespace pugi
 
 namespace carla {
@@ -26,6 +27,12 @@ namespace parser {
         const pugi::xml_document &xml,
         carla::road::MapBuilder &map_builder);
 
+    /// Parse the plan view of a single `<road>` element. Independent per
+    /// road, so it can run concurrently for different roads.
+    static void ParseRoad(
+        const pugi::xml_node &node_road,
+        carla::road::MapBuilder &map_builder);
+
   };
 
 } // namespace parser
@@ -287,13 +287,15 @@ namespace parser {
      */
 
     // map_builder calls
+    map_builder.ReserveRoads(roads.size());
     for (auto const r : roads) {
       carla::road::Road *road = map_builder.AddRoad(r.id,
           r.name,
           r.length,
           r.junction_id,
           r.predecessor,
-          r.successor);
+          r.successor,
+          r.sections.size());
 
       // type speed
       for (auto const s : r.speed) {
@@ -308,7 +310,7 @@ namespace parser {
       // lane sections
       road::SectionId i = 0;
       for (auto const s : r.sections) {
-        carla::road::LaneSection *section = map_builder.AddRoadSection(road, i++, s.s);
+        carla::road::LaneSection *section = map_builder.AddRoadSection(road, i++, s.s, s.lanes.size());
 
         // lanes
         for (auto const l : s.lanes) {
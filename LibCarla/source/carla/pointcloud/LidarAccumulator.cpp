@@ -0,0 +1,70 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/pointcloud/LidarAccumulator.h"
+
+#include "carla/Exception.h"
+
+#include <stdexcept>
+
+namespace carla {
+namespace pointcloud {
+
+  LidarAccumulator::LidarAccumulator(size_t max_sweeps)
+    : _max_sweeps(max_sweeps) {
+    if (max_sweeps == 0u) {
+      throw_exception(std::invalid_argument("LidarAccumulator: max_sweeps cannot be zero"));
+    }
+    _sweeps.reserve(max_sweeps);
+  }
+
+  void LidarAccumulator::Add(const sensor::data::LidarMeasurement &measurement) {
+    // The batch transform runs outside the lock, only the ring update
+    // needs it.
+    auto points = measurement.GetPointsInWorld();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_sweeps.size() < _max_sweeps) {
+      _total_points += points.size();
+      _sweeps.emplace_back(std::move(points));
+    } else {
+      _total_points += points.size() - _sweeps[_next].size();
+      _sweeps[_next] = std::move(points);
+    }
+    _next = (_next + 1u) % _max_sweeps;
+  }
+
+  void LidarAccumulator::Clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _sweeps.clear();
+    _next = 0u;
+    _total_points = 0u;
+  }
+
+  size_t LidarAccumulator::GetSweepCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _sweeps.size();
+  }
+
+  size_t LidarAccumulator::GetPointCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _total_points;
+  }
+
+  std::vector<rpc::Location> LidarAccumulator::GetPoints() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<rpc::Location> result;
+    result.reserve(_total_points);
+    // Once the ring is full _next is also the oldest slot.
+    const auto first = _sweeps.size() < _max_sweeps ? 0u : _next;
+    for (auto i = 0u; i < _sweeps.size(); ++i) {
+      const auto &sweep = _sweeps[(first + i) % _sweeps.size()];
+      result.insert(result.end(), sweep.begin(), sweep.end());
+    }
+    return result;
+  }
+
+} // namespace pointcloud
+} // namespace carla
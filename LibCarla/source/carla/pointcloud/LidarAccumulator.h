@@ -0,0 +1,61 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/rpc/Location.h"
+#include "carla/sensor/data/LidarMeasurement.h"
+
+#include <mutex>
+#include <vector>
+
+namespace carla {
+namespace pointcloud {
+
+  /// Ring of the last N lidar sweeps transformed to world space.
+  ///
+  /// Each sweep added is transformed with the sensor transform of its own
+  /// measurement, so sweeps captured from a moving sensor accumulate into a
+  /// consistent world-frame cloud. When the ring is full the oldest sweep
+  /// is dropped. Thread-safe, it can be fed straight from the sensor
+  /// callback.
+  class LidarAccumulator {
+  public:
+
+    explicit LidarAccumulator(size_t max_sweeps);
+
+    /// Transform the points of @a measurement to world space and store them
+    /// as the newest sweep, dropping the oldest one if the ring is full.
+    void Add(const sensor::data::LidarMeasurement &measurement);
+
+    /// Drop every stored sweep.
+    void Clear();
+
+    /// Number of sweeps currently stored.
+    size_t GetSweepCount() const;
+
+    /// Total number of points over all stored sweeps.
+    size_t GetPointCount() const;
+
+    /// Copy every stored sweep, oldest first, into one contiguous array.
+    std::vector<rpc::Location> GetPoints() const;
+
+  private:
+
+    mutable std::mutex _mutex;
+
+    const size_t _max_sweeps;
+
+    /// Index of the slot the next sweep goes into.
+    size_t _next = 0u;
+
+    size_t _total_points = 0u;
+
+    std::vector<std::vector<rpc::Location>> _sweeps;
+  };
+
+} // namespace pointcloud
+} // namespace carla
@@ -11,10 +11,15 @@
 namespace carla {
 namespace pointcloud {
 
-  void PointCloudIO::WriteHeader(std::ostream &out, size_t number_of_points) {
+  void PointCloudIO::WriteHeader(
+      std::ostream &out,
+      size_t number_of_points,
+      Format format) {
     out << "ply\n"
-           "format ascii 1.0\n"
-           "element vertex " << std::to_string(number_of_points) << "\n"
+        << (format == Format::Ascii ?
+               "format ascii 1.0\n" :
+               "format binary_little_endian 1.0\n")
+        << "element vertex " << std::to_string(number_of_points) << "\n"
            "property float32 x\n"
            "property float32 y\n"
            "property float32 z\n"
@@ -22,7 +27,9 @@ namespace pointcloud {
            // "property uchar diffuse_green\n"
            // "property uchar diffuse_blue\n"
            "end_header\n";
-    out << std::fixed << std::setprecision(4u);
+    if (format == Format::Ascii) {
+      out << std::fixed << std::setprecision(4u);
+    }
   }
 
 } // namespace pointcloud
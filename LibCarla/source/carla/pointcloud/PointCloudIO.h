@@ -10,6 +10,7 @@
 
 #include <fstream>
 #include <iterator>
+#include <type_traits>
 
 namespace carla {
 namespace pointcloud {
@@ -17,26 +18,70 @@ namespace pointcloud {
   class PointCloudIO {
   public:
 
+    /// Supported PLY flavors.
+    enum class Format {
+      Ascii,
+      /// @warning Assumes a little-endian host, which covers every
+      /// platform we build for.
+      BinaryLittleEndian
+    };
+
     template <typename PointIt>
-    static void Dump(std::ostream &out, PointIt begin, PointIt end) {
+    static void Dump(
+        std::ostream &out,
+        PointIt begin,
+        PointIt end,
+        Format format = Format::BinaryLittleEndian) {
       DEBUG_ASSERT(std::distance(begin, end) >= 0);
-      WriteHeader(out, static_cast<size_t>(std::distance(begin, end)));
-      for (; begin != end; ++begin) {
-        out << begin->x << ' ' << begin->y << ' ' << begin->z << '\n';
+      WriteHeader(out, static_cast<size_t>(std::distance(begin, end)), format);
+      if (format == Format::Ascii) {
+        for (; begin != end; ++begin) {
+          out << begin->x << ' ' << begin->y << ' ' << begin->z << '\n';
+        }
+      } else {
+        WriteBinaryPoints(out, begin, end);
       }
     }
 
     template <typename PointIt>
-    static std::string SaveToDisk(std::string path, PointIt begin, PointIt end) {
+    static std::string SaveToDisk(
+        std::string path,
+        PointIt begin,
+        PointIt end,
+        Format format = Format::BinaryLittleEndian) {
       FileSystem::ValidateFilePath(path, ".ply");
-      std::ofstream out(path);
-      Dump(out, begin, end);
+      std::ofstream out(path, std::ios::binary);
+      Dump(out, begin, end, format);
       return path;
     }
 
   private:
 
-    static void WriteHeader(std::ostream &out, size_t number_of_points);
+    /// Contiguous points (the sensor data arrays) go out in one bulk
+    /// write.
+    template <typename PointT>
+    static void WriteBinaryPoints(
+        std::ostream &out,
+        const PointT *begin,
+        const PointT *end) {
+      static_assert(
+          sizeof(PointT) == 3u * sizeof(float),
+          "Invalid point layout.");
+      out.write(
+          reinterpret_cast<const char *>(begin),
+          std::distance(begin, end) *
+              static_cast<std::streamsize>(sizeof(PointT)));
+    }
+
+    template <typename PointIt>
+    static void WriteBinaryPoints(std::ostream &out, PointIt begin, PointIt end) {
+      for (; begin != end; ++begin) {
+        const float point[3u] = {begin->x, begin->y, begin->z};
+        out.write(reinterpret_cast<const char *>(point), sizeof(point));
+      }
+    }
+
+    static void WriteHeader(std::ostream &out, size_t number_of_points, Format format);
   };
 
 } // namespace pointcloud
@@ -4,16 +4,11 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
-#ifndef LIBCARLA_ENABLE_LIFETIME_PROFILER
-#  define LIBCARLA_ENABLE_LIFETIME_PROFILER
-#endif // LIBCARLA_ENABLE_LIFETIME_PROFILER
-
 #include "carla/Debug.h"
 #include "carla/Logging.h"
 #include "carla/profiler/LifetimeProfiled.h"
 
-#include <mutex>
-#include <unordered_map>
+#include <algorithm>
 
 namespace carla {
 namespace profiler {
@@ -23,6 +18,51 @@ namespace profiler {
     logging::write_to_stream(std::cerr, "LIFETIME:", std::forward<Args>(args) ..., '\n');
   }
 
+  // ===========================================================================
+  // -- LifetimeCensus ---------------------------------------------------------
+  // ===========================================================================
+
+  LifetimeCensus &LifetimeCensus::GetInstance() {
+    static LifetimeCensus instance;
+    return instance;
+  }
+
+  void LifetimeCensus::Increment(const char *type_name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto &entry = _entries[type_name];
+    ++entry.live;
+    ++entry.total;
+    entry.peak = std::max(entry.peak, entry.live);
+  }
+
+  void LifetimeCensus::Decrement(const char *type_name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(type_name);
+    DEBUG_ASSERT(it != _entries.end());
+    if ((it != _entries.end()) && (it->second.live > 0u)) {
+      --it->second.live;
+    }
+  }
+
+  std::vector<LifetimeCensus::Entry> LifetimeCensus::GetEntries() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<Entry> result;
+    result.reserve(_entries.size());
+    for (const auto &item : _entries) {
+      auto entry = item.second;
+      entry.type_name = item.first;
+      result.emplace_back(std::move(entry));
+    }
+    std::sort(result.begin(), result.end(), [](const Entry &lhs, const Entry &rhs) {
+      return lhs.type_name < rhs.type_name;
+    });
+    return result;
+  }
+
+  // ===========================================================================
+  // -- Per-object leak-checking registry --------------------------------------
+  // ===========================================================================
+
   class LifetimeProfiler {
   public:
 
@@ -64,12 +104,24 @@ namespace profiler {
 
   static LifetimeProfiler PROFILER;
 
-  LifetimeProfiled::LifetimeProfiled(std::string display_name) {
+  LifetimeProfiled::LifetimeProfiled(const char *type_name)
+    : _type_name(type_name),
+      _registered(false) {
+    LifetimeCensus::GetInstance().Increment(_type_name);
+  }
+
+  LifetimeProfiled::LifetimeProfiled(const char *type_name, std::string display_name)
+    : _type_name(type_name),
+      _registered(true) {
+    LifetimeCensus::GetInstance().Increment(_type_name);
     PROFILER.Register(this, std::move(display_name));
   }
 
   LifetimeProfiled::~LifetimeProfiled() {
-    PROFILER.Deregister(this);
+    LifetimeCensus::GetInstance().Decrement(_type_name);
+    if (_registered) {
+      PROFILER.Deregister(this);
+    }
   }
 
 } // namespace profiler
@@ -6,34 +6,75 @@
 
 #pragma once
 
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace carla {
 namespace profiler {
 
-  class LifetimeProfiled {
-  protected:
+  /// Always-on census of the lifetime-profiled objects: live, peak, and
+  /// total-created counters per profiled type, queryable at runtime (the
+  /// server exposes it through the get_object_census RPC function). Unlike
+  /// the per-object registry behind LIBCARLA_ENABLE_LIFETIME_PROFILER, the
+  /// census only bumps a handful of counters per construction, so it stays
+  /// enabled in every build.
+  class LifetimeCensus {
+  public:
 
-#ifndef LIBCARLA_ENABLE_LIFETIME_PROFILER
+    struct Entry {
+      std::string type_name;
+      uint64_t live = 0u;
+      uint64_t peak = 0u;
+      uint64_t total = 0u;
+    };
 
-    LifetimeProfiled() = default;
+    static LifetimeCensus &GetInstance();
 
-#else
+    void Increment(const char *type_name);
+
+    void Decrement(const char *type_name);
+
+    /// Counters of every profiled type, sorted by type name.
+    std::vector<Entry> GetEntries() const;
+
+  private:
+
+    mutable std::mutex _mutex;
 
-    LifetimeProfiled(std::string display_name);
+    std::unordered_map<std::string, Entry> _entries;
+  };
+
+  class LifetimeProfiled {
+  protected:
+
+    /// Count this object in the census under @a type_name, which must be a
+    /// string literal.
+    explicit LifetimeProfiled(const char *type_name);
+
+    /// Additionally track this particular instance in the leak-checking
+    /// registry; only called when LIBCARLA_ENABLE_LIFETIME_PROFILER is
+    /// defined.
+    LifetimeProfiled(const char *type_name, std::string display_name);
 
   public:
 
     ~LifetimeProfiled();
 
-#endif // LIBCARLA_ENABLE_LIFETIME_PROFILER
+  private:
+
+    const char *_type_name;
+
+    const bool _registered;
   };
 
 } // namespace profiler
 } // namespace carla
 
 #ifndef LIBCARLA_ENABLE_LIFETIME_PROFILER
-#  define LIBCARLA_INITIALIZE_LIFETIME_PROFILER(display_name) ::carla::profiler::LifetimeProfiled()
+#  define LIBCARLA_INITIALIZE_LIFETIME_PROFILER(type_name, display_name) ::carla::profiler::LifetimeProfiled(type_name)
 #else
-#  define LIBCARLA_INITIALIZE_LIFETIME_PROFILER(display_name) ::carla::profiler::LifetimeProfiled(display_name)
+#  define LIBCARLA_INITIALIZE_LIFETIME_PROFILER(type_name, display_name) ::carla::profiler::LifetimeProfiled(type_name, display_name)
 #endif // LIBCARLA_ENABLE_LIFETIME_PROFILER
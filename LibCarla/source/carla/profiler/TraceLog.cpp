@@ -0,0 +1,94 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/profiler/TraceLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+namespace carla {
+namespace profiler {
+
+  /// Small sequential ids read better in the trace viewer than the opaque
+  /// values of std::thread::id.
+  static uint32_t GetCurrentThreadId() {
+    static std::atomic<uint32_t> next_thread_id{0u};
+    static thread_local const uint32_t this_thread_id = ++next_thread_id;
+    return this_thread_id;
+  }
+
+  TraceLog &TraceLog::GetInstance() {
+    static TraceLog instance;
+    return instance;
+  }
+
+  uint64_t TraceLog::NowMicroseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  void TraceLog::Start(uint64_t max_events) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _enabled.store(false, std::memory_order_relaxed);
+    std::atomic_store(&_ring, std::make_shared<Ring>(std::max<uint64_t>(max_events, 1u)));
+    _enabled.store(true, std::memory_order_release);
+  }
+
+  void TraceLog::Stop() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _enabled.store(false, std::memory_order_relaxed);
+  }
+
+  void TraceLog::PushEvent(const char *name, uint64_t begin_us, uint64_t end_us) {
+    auto ring = std::atomic_load(&_ring);
+    if ((ring == nullptr) || !IsEnabled()) {
+      return;
+    }
+    const auto slot = ring->next.fetch_add(1u, std::memory_order_relaxed) % ring->events.size();
+    auto &event = ring->events[slot];
+    event.name = name;
+    event.begin_us = begin_us;
+    event.end_us = end_us;
+    event.thread_id = GetCurrentThreadId();
+  }
+
+  std::string TraceLog::ExportToJson() const {
+    auto ring = std::atomic_load(&_ring);
+    std::vector<Event> events;
+    if (ring != nullptr) {
+      // Copy the completed slots; on a wrapped ring every slot holds an
+      // event, otherwise only the first next ones do.
+      const auto total = ring->next.load(std::memory_order_relaxed);
+      events.reserve(std::min<uint64_t>(total, ring->events.size()));
+      for (const auto &event : ring->events) {
+        if (event.name != nullptr) {
+          events.emplace_back(event);
+        }
+      }
+      std::sort(events.begin(), events.end(), [](const Event &lhs, const Event &rhs) {
+        return lhs.begin_us < rhs.begin_us;
+      });
+    }
+    // Complete ("X") events of the chrome trace event format; names are
+    // macro-stringified identifiers, no JSON escaping needed.
+    std::ostringstream out;
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto &event : events) {
+      out << (first ? "" : ",")
+          << "{\"name\":\"" << event.name
+          << "\",\"cat\":\"carla\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread_id
+          << ",\"ts\":" << event.begin_us
+          << ",\"dur\":" << (event.end_us - event.begin_us) << "}";
+      first = false;
+    }
+    out << "]}";
+    return out.str();
+  }
+
+} // namespace profiler
+} // namespace carla
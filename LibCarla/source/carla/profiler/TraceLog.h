@@ -0,0 +1,116 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+/// Always-available event tracing. Unlike the profiler's post-mortem
+/// aggregates (Profiler.h) or the cycle histograms (Tracer.h), CARLA_TRACE_EVENT
+/// records individual scoped events with begin/end timestamps and thread ids
+/// into a fixed-size ring buffer, exportable as chrome://tracing JSON while
+/// the process runs. Recording is off by default; a disabled probe costs a
+/// single relaxed atomic load, so the macros need no compile-time switch.
+
+#include "carla/NonCopyable.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace profiler {
+
+  /// Global ring buffer of scoped trace events.
+  ///
+  /// Writers claim a slot with an atomic increment and fill it in place, so
+  /// pushing an event never blocks; like the cycle histograms, the exporter
+  /// takes a consistent-enough snapshot rather than a strictly synchronized
+  /// one, a wrapped slot being overwritten during the export can yield a
+  /// single garbled event in the output.
+  class TraceLog : private NonCopyable {
+  public:
+
+    static TraceLog &GetInstance();
+
+    /// Start recording into a ring of @a max_events events, dropping
+    /// whatever a previous run had captured. Once the ring is full the
+    /// newest events overwrite the oldest.
+    void Start(uint64_t max_events);
+
+    void Stop();
+
+    bool IsEnabled() const {
+      return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /// The captured events as a chrome://tracing JSON document (load it at
+    /// chrome://tracing or https://ui.perfetto.dev). Recording continues
+    /// while exporting.
+    std::string ExportToJson() const;
+
+    /// @warning @a name must be a string literal, the pointer is stored.
+    void PushEvent(const char *name, uint64_t begin_us, uint64_t end_us);
+
+    /// Microseconds of the monotonic clock the event timestamps are on.
+    static uint64_t NowMicroseconds();
+
+  private:
+
+    struct Event {
+      const char *name = nullptr;
+      uint64_t begin_us = 0u;
+      uint64_t end_us = 0u;
+      uint32_t thread_id = 0u;
+    };
+
+    struct Ring {
+      explicit Ring(size_t size) : events(size) {}
+      std::vector<Event> events;
+      std::atomic<uint64_t> next{0u};
+    };
+
+    TraceLog() = default;
+
+    /// Accessed with std::atomic_load so Start can swap the ring while
+    /// probes are in flight.
+    std::shared_ptr<Ring> _ring;
+
+    std::atomic<bool> _enabled{false};
+
+    /// Serializes Start and Stop.
+    std::mutex _mutex;
+  };
+
+  /// Records the lifetime of the enclosing scope as one trace event; does
+  /// nothing when recording is disabled.
+  class ScopedTraceEvent : private NonCopyable {
+  public:
+
+    explicit ScopedTraceEvent(const char *name)
+      : _name(TraceLog::GetInstance().IsEnabled() ? name : nullptr),
+        _begin_us(_name != nullptr ? TraceLog::NowMicroseconds() : 0u) {}
+
+    ~ScopedTraceEvent() {
+      if (_name != nullptr) {
+        TraceLog::GetInstance().PushEvent(_name, _begin_us, TraceLog::NowMicroseconds());
+      }
+    }
+
+  private:
+
+    const char *_name;
+
+    const uint64_t _begin_us;
+  };
+
+} // namespace profiler
+} // namespace carla
+
+#define CARLA_TRACE_EVENT(context, trace_name) \
+    ::carla::profiler::ScopedTraceEvent carla_trace_event_ ## context ## _ ## trace_name( \
+        #context "." #trace_name);
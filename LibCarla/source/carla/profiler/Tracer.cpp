@@ -0,0 +1,102 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#ifndef LIBCARLA_ENABLE_TRACING
+#  define LIBCARLA_ENABLE_TRACING
+#endif // LIBCARLA_ENABLE_TRACING
+
+#include "carla/profiler/Tracer.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace carla {
+namespace profiler {
+namespace detail {
+
+  /// Histograms are stored in a std::list so references handed out to the
+  /// probes stay valid forever; entries are never removed.
+  class TraceRegistryImpl {
+  public:
+
+    struct Entry {
+      const char *name;
+      CycleHistogram histogram;
+    };
+
+    CycleHistogram &GetHistogram(const char *name) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _entries.emplace_back();
+      _entries.back().name = name;
+      return _entries.back().histogram;
+    }
+
+    std::vector<TraceRegistry::Stats> GetStats() const {
+      std::map<std::string, TraceRegistry::Stats> aggregated;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto &entry : _entries) {
+          auto &stats = aggregated[entry.name];
+          stats.name = entry.name;
+          stats.count += entry.histogram.GetCount();
+          for (size_t i = 0u; i < CycleHistogram::number_of_buckets; ++i) {
+            stats.buckets[i] += entry.histogram.GetBucket(i);
+          }
+        }
+      }
+      std::vector<TraceRegistry::Stats> result;
+      result.reserve(aggregated.size());
+      for (auto &pair : aggregated) {
+        result.emplace_back(std::move(pair.second));
+      }
+      return result;
+    }
+
+  private:
+
+    mutable std::mutex _mutex;
+
+    std::list<Entry> _entries;
+  };
+
+  TraceRegistry &TraceRegistry::GetInstance() {
+    static TraceRegistry instance;
+    return instance;
+  }
+
+  static TraceRegistryImpl &GetImpl() {
+    static TraceRegistryImpl impl;
+    return impl;
+  }
+
+  CycleHistogram &TraceRegistry::GetHistogram(const char *name) {
+    return GetImpl().GetHistogram(name);
+  }
+
+  std::vector<TraceRegistry::Stats> TraceRegistry::GetStats() const {
+    return GetImpl().GetStats();
+  }
+
+  uint64_t TraceRegistry::GetTicksPerSecond() {
+    static const uint64_t ticks_per_second = []() {
+      using namespace std::chrono;
+      const auto time_begin = steady_clock::now();
+      const auto ticks_begin = ReadCycleCounter();
+      std::this_thread::sleep_for(milliseconds(10));
+      const auto ticks = ReadCycleCounter() - ticks_begin;
+      const auto nanos = static_cast<uint64_t>(
+          duration_cast<nanoseconds>(steady_clock::now() - time_begin).count());
+      return (ticks * 1000000000u) / std::max<uint64_t>(nanos, 1u);
+    }();
+    return ticks_per_second;
+  }
+
+} // namespace detail
+} // namespace profiler
+} // namespace carla
@@ -0,0 +1,143 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+/// Permanent low-overhead instrumentation for per-message hot paths, where
+/// the 20-40ns of a steady_clock call (see StopWatch) is already too much.
+/// CARLA_TRACE_SCOPE reads the CPU cycle counter on scope entry and exit and
+/// accumulates the elapsed cycles into a lock-free per-thread power-of-two
+/// histogram, queryable at runtime through TraceRegistry. The probes compile
+/// out unless LIBCARLA_ENABLE_TRACING is defined, like the profiler's.
+
+#ifndef LIBCARLA_ENABLE_TRACING
+#  define CARLA_TRACE_SCOPE(context, trace_name)
+#else
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace carla {
+namespace profiler {
+namespace detail {
+
+  /// Read the processor's timestamp counter; falls back to steady_clock
+  /// nanoseconds where no cycle counter is available. Raw ticks are only
+  /// comparable within one process run, use
+  /// TraceRegistry::GetTicksPerSecond to convert them to time.
+  static inline uint64_t ReadCycleCounter() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t virtual_timer;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(virtual_timer));
+    return virtual_timer;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+  }
+
+  /// Counts elapsed-cycle samples in power-of-two buckets, bucket i holding
+  /// the samples in [2^i, 2^(i+1)). Each instance has a single writer (the
+  /// thread that created it), so Annotate needs no read-modify-write, just
+  /// relaxed stores; readers take a consistent-enough snapshot with relaxed
+  /// loads.
+  class CycleHistogram {
+  public:
+
+    static constexpr size_t number_of_buckets = 8u * sizeof(uint64_t);
+
+    void Annotate(uint64_t elapsed_cycles) {
+      size_t bucket = 0u;
+      while ((elapsed_cycles >>= 1u) != 0u) {
+        ++bucket;
+      }
+      Bump(_buckets[bucket]);
+      Bump(_count);
+    }
+
+    uint64_t GetCount() const {
+      return _count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetBucket(size_t i) const {
+      return _buckets[i].load(std::memory_order_relaxed);
+    }
+
+  private:
+
+    static void Bump(std::atomic<uint64_t> &counter) {
+      counter.store(counter.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> _buckets[number_of_buckets] = {};
+
+    std::atomic<uint64_t> _count{0u};
+  };
+
+  /// Owns every histogram ever created so snapshots never race with thread
+  /// exit; the per-thread probe caches its histogram in a thread_local
+  /// reference, the registry mutex is only taken on first use and on query.
+  class TraceRegistry {
+  public:
+
+    struct Stats {
+      std::string name;
+      uint64_t count = 0u;
+      uint64_t buckets[CycleHistogram::number_of_buckets] = {};
+    };
+
+    static TraceRegistry &GetInstance();
+
+    /// Get the calling thread's histogram for @a name, creating it if needed.
+    CycleHistogram &GetHistogram(const char *name);
+
+    /// Per-probe counts and bucket totals, aggregated over threads.
+    std::vector<Stats> GetStats() const;
+
+    /// Cycle counter frequency, calibrated against steady_clock on first call.
+    static uint64_t GetTicksPerSecond();
+  };
+
+  class ScopedCycleTimer {
+  public:
+
+    explicit ScopedCycleTimer(CycleHistogram &histogram)
+      : _histogram(histogram),
+        _start(ReadCycleCounter()) {}
+
+    ~ScopedCycleTimer() {
+      _histogram.Annotate(ReadCycleCounter() - _start);
+    }
+
+  private:
+
+    CycleHistogram &_histogram;
+
+    const uint64_t _start;
+  };
+
+} // namespace detail
+} // namespace profiler
+} // namespace carla
+
+#define CARLA_TRACE_SCOPE(context, trace_name) \
+    static thread_local ::carla::profiler::detail::CycleHistogram &carla_trace_ ## context ## _ ## trace_name ## _histogram = \
+        ::carla::profiler::detail::TraceRegistry::GetInstance().GetHistogram(#context "." #trace_name); \
+    ::carla::profiler::detail::ScopedCycleTimer carla_trace_ ## context ## _ ## trace_name ## _scoped_timer( \
+        carla_trace_ ## context ## _ ## trace_name ## _histogram);
+
+#endif // LIBCARLA_ENABLE_TRACING
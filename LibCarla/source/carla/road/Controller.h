@@ -51,6 +51,7 @@ namespace road {
   private:
 
     friend MapBuilder;
+    friend class MapSerializer;
 
     ContId _id;
     std::string _name;
@@ -0,0 +1,162 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  /// A map-like container stored as a single sorted vector of key-value
+  /// pairs. Lookups are binary searches over contiguous memory instead of
+  /// pointer-chasing through tree nodes, and iteration is a linear scan.
+  /// Duplicate keys are allowed and keep their insertion order, like a
+  /// multimap.
+  ///
+  /// Inserting can reallocate the storage and shifts every element after the
+  /// insertion point, so code that keeps pointers into the map (the map
+  /// builder does, for roads and lanes) must Reserve the final element count
+  /// upfront; the map is built once at load time and read-only afterwards.
+  template <typename KeyT, typename ValueT>
+  class FlatMap : private MovableNonCopyable {
+  public:
+
+    using key_type = KeyT;
+    using mapped_type = ValueT;
+    using value_type = std::pair<KeyT, ValueT>;
+    using container_type = std::vector<value_type>;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+    using reverse_iterator = typename container_type::reverse_iterator;
+    using const_reverse_iterator = typename container_type::const_reverse_iterator;
+
+    /// Make room for @a count extra elements without invalidating pointers
+    /// into the map on subsequent insertions.
+    void Reserve(size_t count) {
+      _container.reserve(_container.size() + count);
+    }
+
+    /// Construct a value from @a args under @a key, keeping the container
+    /// sorted; an equal key is inserted after the existing ones. Returns an
+    /// iterator to the new element.
+    template <typename... ArgsT>
+    iterator Emplace(const KeyT &key, ArgsT &&... args) {
+      auto position = std::upper_bound(_container.begin(), _container.end(), key, LessThanKey());
+      return _container.emplace(
+          position,
+          std::piecewise_construct,
+          std::forward_as_tuple(key),
+          std::forward_as_tuple(std::forward<ArgsT>(args)...));
+    }
+
+    iterator find(const KeyT &key) {
+      auto it = lower_bound(key);
+      return ((it != end()) && !(key < it->first)) ? it : end();
+    }
+
+    const_iterator find(const KeyT &key) const {
+      auto it = lower_bound(key);
+      return ((it != end()) && !(key < it->first)) ? it : end();
+    }
+
+    iterator lower_bound(const KeyT &key) {
+      return std::lower_bound(_container.begin(), _container.end(), key, LessThanKey());
+    }
+
+    const_iterator lower_bound(const KeyT &key) const {
+      return std::lower_bound(_container.begin(), _container.end(), key, LessThanKey());
+    }
+
+    iterator upper_bound(const KeyT &key) {
+      return std::upper_bound(_container.begin(), _container.end(), key, LessThanKey());
+    }
+
+    const_iterator upper_bound(const KeyT &key) const {
+      return std::upper_bound(_container.begin(), _container.end(), key, LessThanKey());
+    }
+
+    ValueT &at(const KeyT &key) {
+      auto it = find(key);
+      if (it == end()) {
+        throw std::out_of_range("key not found in FlatMap");
+      }
+      return it->second;
+    }
+
+    const ValueT &at(const KeyT &key) const {
+      auto it = find(key);
+      if (it == end()) {
+        throw std::out_of_range("key not found in FlatMap");
+      }
+      return it->second;
+    }
+
+    iterator begin() {
+      return _container.begin();
+    }
+
+    const_iterator begin() const {
+      return _container.begin();
+    }
+
+    iterator end() {
+      return _container.end();
+    }
+
+    const_iterator end() const {
+      return _container.end();
+    }
+
+    reverse_iterator rbegin() {
+      return _container.rbegin();
+    }
+
+    const_reverse_iterator rbegin() const {
+      return _container.rbegin();
+    }
+
+    reverse_iterator rend() {
+      return _container.rend();
+    }
+
+    const_reverse_iterator rend() const {
+      return _container.rend();
+    }
+
+    size_t size() const {
+      return _container.size();
+    }
+
+    bool empty() const {
+      return _container.empty();
+    }
+
+  private:
+
+    /// Heterogeneous comparator so the binary searches compare keys against
+    /// stored pairs without materializing a pair.
+    struct LessThanKey {
+      bool operator()(const value_type &element, const KeyT &key) const {
+        return element.first < key;
+      }
+      bool operator()(const KeyT &key, const value_type &element) const {
+        return key < element.first;
+      }
+    };
+
+    container_type _container;
+  };
+
+} // road
+} // carla
@@ -11,6 +11,9 @@
 #include "carla/road/element/RoadInfo.h"
 #include "carla/road/element/RoadInfoIterator.h"
 
+#include <algorithm>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -23,15 +26,20 @@ namespace road {
     InformationSet() = default;
 
     InformationSet(std::vector<std::unique_ptr<element::RoadInfo>> &&vec)
-      : _road_set(std::move(vec)) {}
+      : _road_set(std::move(vec)) {
+      BuildTypedIndex();
+    }
 
     /// Return all infos given a type from the start of the road
     template <typename T>
     std::vector<const T *> GetInfos() const {
       std::vector<const T *> vec;
-      auto it = element::MakeRoadInfoIterator<T>(_road_set.GetAll());
-      for (; !it.IsAtEnd(); ++it) {
-        vec.emplace_back(&*it);
+      const auto *bucket = FindBucket<T>();
+      if (bucket != nullptr) {
+        vec.reserve(bucket->size());
+        for (const auto &entry : *bucket) {
+          vec.emplace_back(static_cast<const T *>(entry.info));
+        }
       }
       return vec;
     }
@@ -40,25 +48,38 @@ namespace road {
     /// the start of the road
     template <typename T>
     const T *GetInfo(const double s) const {
-      auto it = element::MakeRoadInfoIterator<T>(_road_set.GetReverseSubset(s));
-      return it.IsAtEnd() ? nullptr : &*it;
+      const auto *bucket = FindBucket<T>();
+      if (bucket == nullptr) {
+        return nullptr;
+      }
+      // last entry starting at or before s
+      auto it = std::upper_bound(bucket->begin(), bucket->end(), s, LessThanEntry());
+      if (it == bucket->begin()) {
+        return nullptr;
+      }
+      return static_cast<const T *>(std::prev(it)->info);
     }
 
     /// Return all infos given a type in a given range of the road
     template <typename T>
     std::vector<const T *> GetInfos(const double min_s, const double max_s) const {
       std::vector<const T *> vec;
-      if(min_s < max_s) {
-        auto it = element::MakeRoadInfoIterator<T>(
-            _road_set.GetSubsetInRange(min_s, max_s)); //reverse
-        for (; !it.IsAtEnd(); ++it) {
-          vec.emplace_back(&*it);
+      const auto *bucket = FindBucket<T>();
+      if (bucket == nullptr) {
+        return vec;
+      }
+      if (min_s < max_s) {
+        auto low = std::lower_bound(bucket->begin(), bucket->end(), min_s, EntryLessThan());
+        auto up = std::upper_bound(low, bucket->end(), max_s, LessThanEntry());
+        for (auto it = low; it != up; ++it) {
+          vec.emplace_back(static_cast<const T *>(it->info));
         }
       } else {
-        auto it = element::MakeRoadInfoIterator<T>(
-            _road_set.GetReverseSubsetInRange(max_s, min_s)); //reverse
-        for (; !it.IsAtEnd(); ++it) {
-          vec.emplace_back(&*it);
+        auto low = std::lower_bound(bucket->begin(), bucket->end(), max_s, EntryLessThan());
+        auto up = std::upper_bound(low, bucket->end(), min_s, LessThanEntry());
+        for (auto it = up; it != low;) {
+          --it;
+          vec.emplace_back(static_cast<const T *>(it->info));
         }
       }
       return vec;
@@ -66,7 +87,46 @@ namespace road {
 
   private:
 
+    friend class MapSerializer;
+
+    /// Entry of the per-type flat index, kept sorted by s so lookups along
+    /// the driving path are a binary search over contiguous data instead of
+    /// a typed scan over the polymorphic set.
+    struct IndexEntry {
+      double s;
+      const element::RoadInfo *info;
+    };
+
+    struct EntryLessThan {
+      bool operator()(const IndexEntry &entry, double value) const {
+        return entry.s < value;
+      }
+    };
+
+    struct LessThanEntry {
+      bool operator()(double value, const IndexEntry &entry) const {
+        return value < entry.s;
+      }
+    };
+
+    /// Bucket the infos by concrete type; _road_set is already sorted by s,
+    /// so every bucket inherits that order.
+    void BuildTypedIndex() {
+      for (const auto &info : _road_set.GetAll()) {
+        _by_type[std::type_index(typeid(*info))].emplace_back(
+            IndexEntry{info->GetDistance(), info.get()});
+      }
+    }
+
+    template <typename T>
+    const std::vector<IndexEntry> *FindBucket() const {
+      auto it = _by_type.find(std::type_index(typeid(T)));
+      return it == _by_type.end() ? nullptr : &it->second;
+    }
+
     RoadElementSet<std::unique_ptr<element::RoadInfo>> _road_set;
+
+    std::unordered_map<std::type_index, std::vector<IndexEntry>> _by_type;
   };
 
 } // road
@@ -45,6 +45,18 @@ namespace road {
           lane_links() {}
     };
 
+    /// Geometric crossing between two connecting lanes of the junction,
+    /// precomputed at map build time. The s values locate the conflict
+    /// point along each lane's center line.
+    struct LaneConflict {
+      RoadId road_id;
+      LaneId lane_id;
+      double s;
+      RoadId other_road_id;
+      LaneId other_lane_id;
+      double other_s;
+    };
+
     Junction(const JuncId id, const std::string name)
       : _id(id),
         _name(name),
@@ -82,9 +94,30 @@ namespace road {
       return _road_conflicts.at(road_id);
     }
 
+    const std::vector<LaneConflict> &GetLaneConflicts() const {
+      return _lane_conflicts;
+    }
+
+    /// Conflicts involving the given lane, normalized so the queried lane
+    /// is the first member of every returned entry.
+    std::vector<LaneConflict> GetConflictsOfLane(RoadId road_id, LaneId lane_id) const {
+      std::vector<LaneConflict> result;
+      for (const auto &conflict : _lane_conflicts) {
+        if ((conflict.road_id == road_id) && (conflict.lane_id == lane_id)) {
+          result.emplace_back(conflict);
+        } else if ((conflict.other_road_id == road_id) && (conflict.other_lane_id == lane_id)) {
+          result.emplace_back(LaneConflict{
+              conflict.other_road_id, conflict.other_lane_id, conflict.other_s,
+              conflict.road_id, conflict.lane_id, conflict.s});
+        }
+      }
+      return result;
+    }
+
   private:
 
     friend MapBuilder;
+    friend class MapSerializer;
 
     JuncId _id;
 
@@ -97,6 +130,8 @@ namespace road {
     std::unordered_map<RoadId, std::unordered_set<RoadId>>
         _road_conflicts;
 
+    std::vector<LaneConflict> _lane_conflicts;
+
     carla::geom::BoundingBox _bounding_box;
   };
 
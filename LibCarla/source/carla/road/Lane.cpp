@@ -111,8 +111,9 @@ namespace road {
       auto info = lane.second.template GetInfo<element::RoadInfoLaneWidth>(s);
       RELEASE_ASSERT(info != nullptr);
       const auto current_polynomial = info->GetPolynomial();
-      auto current_dist = current_polynomial.Evaluate(s);
-      auto current_tang = current_polynomial.Tangent(s);
+      const auto evaluation = current_polynomial.EvaluateWithTangent(s);
+      auto current_dist = evaluation.first;
+      auto current_tang = evaluation.second;
       if (lane.first != lane_id) {
         dist += negative_lane_id ? current_dist : -current_dist;
         tangent += negative_lane_id ? current_tang : -current_tang;
@@ -136,7 +137,7 @@ namespace road {
 
     const auto *lane_section = GetLaneSection();
     DEBUG_ASSERT(lane_section != nullptr);
-    const std::map<LaneId, Lane> &lanes = lane_section->GetLanes();
+    const auto &lanes = lane_section->GetLanes();
 
     // check that lane_id exists on the current s
     RELEASE_ASSERT(!lanes.empty());
@@ -208,7 +209,7 @@ namespace road {
 
     const auto *lane_section = GetLaneSection();
     DEBUG_ASSERT(lane_section != nullptr);
-    const std::map<LaneId, Lane> &lanes = lane_section->GetLanes();
+    const auto &lanes = lane_section->GetLanes();
 
     // check that lane_id exists on the current s
     RELEASE_ASSERT(!lanes.empty());
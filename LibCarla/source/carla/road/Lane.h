@@ -122,6 +122,7 @@ namespace road {
   private:
 
     friend MapBuilder;
+    friend class MapSerializer;
 
     LaneSection *_lane_section = nullptr;
 
@@ -44,11 +44,11 @@ namespace road {
     return nullptr;
   }
 
-  std::map<LaneId, Lane> &LaneSection::GetLanes() {
+  FlatMap<LaneId, Lane> &LaneSection::GetLanes() {
     return _lanes;
   }
 
-  const std::map<LaneId, Lane> &LaneSection::GetLanes() const {
+  const FlatMap<LaneId, Lane> &LaneSection::GetLanes() const {
     return _lanes;
   }
 
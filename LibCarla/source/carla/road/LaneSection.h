@@ -8,11 +8,11 @@
 
 #include "carla/geom/CubicPolynomial.h"
 #include "carla/NonCopyable.h"
+#include "carla/road/FlatMap.h"
 #include "carla/road/Lane.h"
 #include "carla/road/RoadElementSet.h"
 #include "carla/road/RoadTypes.h"
 
-#include <map>
 #include <vector>
 
 namespace carla {
@@ -42,23 +42,26 @@ namespace road {
 
     SectionId GetId() const;
 
-    std::map<LaneId, Lane> &GetLanes();
+    FlatMap<LaneId, Lane> &GetLanes();
 
-    const std::map<LaneId, Lane> &GetLanes() const;
+    const FlatMap<LaneId, Lane> &GetLanes() const;
 
     std::vector<Lane *> GetLanesOfType(Lane::LaneType type);
 
   private:
 
     friend MapBuilder;
+    friend class MapSerializer;
 
-    const SectionId _id = 0u;
+    // Not const so lane sections stay move-assignable, as required by their
+    // flat vector storage; never written after construction.
+    SectionId _id = 0u;
 
-    const double _s = 0.0;
+    double _s = 0.0;
 
     Road *_road = nullptr;
 
-    std::map<LaneId, Lane> _lanes;
+    FlatMap<LaneId, Lane> _lanes;
 
     geom::CubicPolynomial _lane_offset;
   };
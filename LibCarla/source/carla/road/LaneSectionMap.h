@@ -6,35 +6,42 @@
 
 #pragma once
 
-#include "carla/NonCopyable.h"
+#include "carla/road/FlatMap.h"
 #include "carla/road/LaneSection.h"
 
-#include <map>
 #include <unordered_map>
 
 namespace carla {
 namespace road {
 
-  class LaneSectionMap
-    : private std::multimap<double, LaneSection>,
-      private MovableNonCopyable {
-    using Super = std::multimap<double, LaneSection>;
+  /// The lane sections of a road laid out flat, sorted by start distance.
+  /// The id lookup keeps vector indices rather than pointers so it survives
+  /// both reallocation during construction and moves of the whole map.
+  class LaneSectionMap : private FlatMap<double, LaneSection> {
+    using Super = FlatMap<double, LaneSection>;
   public:
 
     LaneSection &Emplace(SectionId id, double s) {
-      LaneSection &result = Super::emplace(s, LaneSection{id, s})->second;
-      _by_id.emplace(result.GetId(), &result);
-      return result;
+      auto it = Super::Emplace(s, id, s);
+      const auto index = static_cast<size_t>(std::distance(Super::begin(), it));
+      if (index + 1u != Super::size()) {
+        // Inserted before existing sections, their indices shifted.
+        RebuildIndex();
+      } else {
+        _by_id.emplace(it->second.GetId(), index);
+      }
+      return it->second;
     }
 
     LaneSection &GetById(SectionId id) {
-      return *_by_id.at(id);
+      return (Super::begin() + static_cast<ptrdiff_t>(_by_id.at(id)))->second;
     }
 
     const LaneSection &GetById(SectionId id) const {
-      return *_by_id.at(id);
+      return (Super::begin() + static_cast<ptrdiff_t>(_by_id.at(id)))->second;
     }
 
+    using Super::Reserve;
     using Super::find;
     using Super::upper_bound;
     using Super::lower_bound;
@@ -44,9 +51,20 @@ namespace road {
     using Super::end;
     using Super::rend;
 
+    using Super::size;
+    using Super::empty;
+
   private:
 
-    std::unordered_map<SectionId, LaneSection *> _by_id;
+    void RebuildIndex() {
+      _by_id.clear();
+      size_t index = 0u;
+      for (auto it = Super::begin(); it != Super::end(); ++it, ++index) {
+        _by_id.emplace(it->second.GetId(), index);
+      }
+    }
+
+    std::unordered_map<SectionId, size_t> _by_id;
   };
 
 } // road
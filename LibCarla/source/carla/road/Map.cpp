@@ -7,6 +7,7 @@
 #include "carla/road/Map.h"
 #include "carla/Exception.h"
 #include "carla/geom/Math.h"
+#include "carla/geom/MathBatch.h"
 #include "carla/geom/MeshFactory.h"
 #include "carla/road/element/LaneCrossingCalculator.h"
 #include "carla/road/element/RoadInfoCrosswalk.h"
@@ -17,6 +18,12 @@
 #include "carla/road/element/RoadInfoMarkRecord.h"
 #include "carla/road/element/RoadInfoSignal.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <numeric>
+#include <thread>
+#include <tuple>
 #include <vector>
 #include <unordered_map>
 #include <stdexcept>
@@ -34,6 +41,49 @@ namespace road {
   // -- Static local methods ---------------------------------------------------
   // ===========================================================================
 
+  /// Run @a work(index) for every index in [0, @a count) on a pool of
+  /// workers sized to the hardware.
+  template <typename FuncT>
+  static void ParallelForEachIndex(size_t count, FuncT &&work) {
+    const size_t num_workers = std::min<size_t>(
+        std::max(1u, std::thread::hardware_concurrency()), count);
+    if (num_workers < 2u) {
+      for (size_t i = 0u; i < count; ++i) {
+        work(i);
+      }
+      return;
+    }
+    std::atomic<size_t> next(0u);
+    std::vector<std::thread> workers;
+    workers.reserve(num_workers);
+    for (size_t i = 0u; i < num_workers; ++i) {
+      workers.emplace_back([&]() {
+        for (auto index = next.fetch_add(1u); index < count; index = next.fetch_add(1u)) {
+          work(index);
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  /// Concatenate @a chunks into a single vector, reserving the final size up
+  /// front.
+  template <typename T>
+  static std::vector<T> ConcatChunks(const std::vector<std::vector<T>> &chunks) {
+    size_t total = 0u;
+    for (const auto &chunk : chunks) {
+      total += chunk.size();
+    }
+    std::vector<T> result;
+    result.reserve(total);
+    for (const auto &chunk : chunks) {
+      result.insert(result.end(), chunk.begin(), chunk.end());
+    }
+    return result;
+  }
+
   template <typename T>
   static std::vector<T> ConcatVectors(std::vector<T> dst, std::vector<T> src) {
     if (src.size() > dst.size()) {
@@ -156,12 +206,21 @@ namespace road {
   boost::optional<Waypoint> Map::GetClosestWaypointOnRoad(
       const geom::Location &pos,
       uint32_t lane_type) const {
-    std::vector<Rtree::TreeElement> query_result =
-        _rtree.GetNearestNeighboursWithFilter(Rtree::BPoint(pos.x, pos.y, pos.z),
+    std::vector<Rtree::TreeElement> query_result;
+    return GetClosestWaypointOnRoad(pos, lane_type, query_result);
+  }
+
+  boost::optional<Waypoint> Map::GetClosestWaypointOnRoad(
+      const geom::Location &pos,
+      uint32_t lane_type,
+      std::vector<Rtree::TreeElement> &query_result) const {
+    _rtree.GetNearestNeighboursWithFilter(Rtree::BPoint(pos.x, pos.y, pos.z),
         [&](Rtree::TreeElement const &element) {
           const Lane &lane = GetLane(element.second.first);
           return (lane_type & static_cast<uint32_t>(lane.GetType())) > 0;
-        });
+        },
+        1u,
+        query_result);
 
     if (query_result.size() == 0) {
       return boost::optional<Waypoint>{};
@@ -200,6 +259,40 @@ namespace road {
     }
   }
 
+  /// Interleave the lower 16 bits of @a value with zeroes.
+  static uint32_t SpreadBits16(uint32_t value) {
+    value &= 0xFFFFu;
+    value = (value | (value << 8)) & 0x00FF00FFu;
+    value = (value | (value << 4)) & 0x0F0F0F0Fu;
+    value = (value | (value << 2)) & 0x33333333u;
+    value = (value | (value << 1)) & 0x55555555u;
+    return value;
+  }
+
+  /// Z-order key of a location at one meter resolution, used to sort batched
+  /// queries so consecutive ones touch nearby R-tree nodes.
+  static uint32_t MortonKey(const geom::Location &pos) {
+    const auto x = static_cast<uint32_t>(static_cast<int32_t>(pos.x) + 0x8000);
+    const auto y = static_cast<uint32_t>(static_cast<int32_t>(pos.y) + 0x8000);
+    return SpreadBits16(x) | (SpreadBits16(y) << 1);
+  }
+
+  void Map::GetClosestWaypoints(
+      const geom::Location *locations,
+      size_t count,
+      boost::optional<Waypoint> *results,
+      uint32_t lane_type) const {
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), static_cast<size_t>(0u));
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+      return MortonKey(locations[lhs]) < MortonKey(locations[rhs]);
+    });
+    std::vector<Rtree::TreeElement> query_result;
+    for (const auto index : order) {
+      results[index] = GetClosestWaypointOnRoad(locations[index], lane_type, query_result);
+    }
+  }
+
   boost::optional<Waypoint> Map::GetWaypoint(
       const geom::Location &pos,
       uint32_t lane_type) const {
@@ -265,6 +358,15 @@ namespace road {
     return GetLane(waypoint).ComputeTransform(waypoint.s);
   }
 
+  void Map::ComputeTransforms(
+      const Waypoint *waypoints,
+      size_t count,
+      geom::Transform *results) const {
+    for (size_t i = 0u; i < count; ++i) {
+      results[i] = ComputeTransform(waypoints[i]);
+    }
+  }
+
   // ===========================================================================
   // -- Map: Road information --------------------------------------------------
   // ===========================================================================
@@ -437,7 +539,10 @@ namespace road {
           pivot.location = v;
           pivot.rotation.yaw -= geom::Math::ToDegrees<float>(static_cast<float>(crosswalk->GetHeading()));
 
-          // calculate all the corners
+          // calculate all the corners, transforming them in one batch so the
+          // rotation matrix of the pivot is only computed once
+          std::vector<geom::Vector3D> corners;
+          corners.reserve(crosswalk->GetPoints().size());
           for (auto corner : crosswalk->GetPoints()) {
             geom::Vector3D v2(
                 static_cast<float>(corner.u),
@@ -449,8 +554,11 @@ namespace road {
             } else {
               v2.x += 1.0f;
             }
-            pivot.TransformPoint(v2);
-            result.push_back(v2);
+            corners.emplace_back(v2);
+          }
+          geom::MathBatch::TransformPoints(pivot, corners.data(), corners.size());
+          for (const auto &corner : corners) {
+            result.push_back(corner);
           }
         }
       }
@@ -588,10 +696,24 @@ namespace road {
 
   std::vector<Waypoint> Map::GenerateWaypoints(const double distance) const {
     RELEASE_ASSERT(distance > 0.0);
+    const auto road_ids = GetRoadIds();
+    // generate the per-road chunks concurrently, keeping the road iteration
+    // order of the serial version
+    std::vector<std::vector<Waypoint>> chunks(road_ids.size());
+    ParallelForEachIndex(road_ids.size(), [&](size_t index) {
+      chunks[index] = GenerateRoadWaypoints(road_ids[index], distance);
+    });
+    return ConcatChunks(chunks);
+  }
+
+  std::vector<Waypoint> Map::GenerateRoadWaypoints(
+      RoadId road_id,
+      double approx_distance) const {
+    RELEASE_ASSERT(approx_distance > 0.0);
     std::vector<Waypoint> result;
-    for (const auto &pair : _data.GetRoads()) {
-      const auto &road = pair.second;
-      for (double s = EPSILON; s < (road.GetLength() - EPSILON); s += distance) {
+    if (_data.GetRoads().count(road_id)) {
+      const auto &road = _data.GetRoads().at(road_id);
+      for (double s = EPSILON; s < (road.GetLength() - EPSILON); s += approx_distance) {
         ForEachDrivableLaneAt(road, s, [&](auto &&waypoint) {
           result.emplace_back(waypoint);
         });
@@ -663,9 +785,20 @@ namespace road {
   }
 
   std::vector<std::pair<Waypoint, Waypoint>> Map::GenerateTopology() const {
+    const auto road_ids = GetRoadIds();
+    // generate the per-road chunks concurrently, keeping the road iteration
+    // order of the serial version
+    std::vector<std::vector<std::pair<Waypoint, Waypoint>>> chunks(road_ids.size());
+    ParallelForEachIndex(road_ids.size(), [&](size_t index) {
+      chunks[index] = GenerateRoadTopology(road_ids[index]);
+    });
+    return ConcatChunks(chunks);
+  }
+
+  std::vector<std::pair<Waypoint, Waypoint>> Map::GenerateRoadTopology(RoadId road_id) const {
     std::vector<std::pair<Waypoint, Waypoint>> result;
-    for (const auto &pair : _data.GetRoads()) {
-      const auto &road = pair.second;
+    if (_data.GetRoads().count(road_id)) {
+      const auto &road = _data.GetRoads().at(road_id);
       ForEachDrivableLane(road, [&](auto &&waypoint) {
         for (auto &&successor : GetSuccessors(waypoint)) {
           result.push_back({waypoint, successor});
@@ -762,6 +895,92 @@ namespace road {
     return conflicts;
   }
 
+  std::vector<Junction::LaneConflict> Map::ComputeJunctionLaneConflicts(JuncId id) const {
+
+    const float epsilon = 0.0001f; // small delta in the road (set to 0.1
+                                     // millimeters to prevent numeric errors)
+    const Junction *junction = GetJunction(id);
+    // lane pair key, normalized so each pair is recorded once; keeps the
+    // crossing with the smallest segment distance seen so far
+    std::map<std::tuple<RoadId, LaneId, RoadId, LaneId>,
+        std::pair<double, Junction::LaneConflict>> closest;
+
+    // 2d typedefs
+    typedef boost::geometry::model::point
+        <float, 2, boost::geometry::cs::cartesian> Point2d;
+    typedef boost::geometry::model::segment<Point2d> Segment2d;
+    typedef boost::geometry::model::box<Rtree::BPoint> Box;
+
+    // box range
+    auto bbox_pos = junction->GetBoundingBox().location;
+    auto bbox_ext = junction->GetBoundingBox().extent;
+    auto min_corner = geom::Vector3D(
+        bbox_pos.x - bbox_ext.x,
+        bbox_pos.y - bbox_ext.y,
+        bbox_pos.z - bbox_ext.z - epsilon);
+    auto max_corner = geom::Vector3D(
+        bbox_pos.x + bbox_ext.x,
+        bbox_pos.y + bbox_ext.y,
+        bbox_pos.z + bbox_ext.z + epsilon);
+    Box box({min_corner.x, min_corner.y, min_corner.z},
+        {max_corner.x, max_corner.y, max_corner.z});
+    auto segments = _rtree.GetIntersections(box);
+
+    for (size_t i = 0; i < segments.size(); ++i){
+      auto &segment1 = segments[i];
+      auto waypoint1 = segment1.second.first;
+      JuncId junc_id1 = _data.GetRoad(waypoint1.road_id).GetJunctionId();
+      // only segments in the junction
+      if(junc_id1 != id){
+        continue;
+      }
+      Segment2d seg1{{segment1.first.first.get<0>(), segment1.first.first.get<1>()},
+          {segment1.first.second.get<0>(), segment1.first.second.get<1>()}};
+      for (size_t j = i + 1; j < segments.size(); ++j){
+        auto &segment2 = segments[j];
+        auto waypoint2 = segment2.second.first;
+        JuncId junc_id2 = _data.GetRoad(waypoint2.road_id).GetJunctionId();
+        // only segments in the junction
+        if(junc_id2 != id){
+          continue;
+        }
+        // discard same road
+        if(waypoint1.road_id == waypoint2.road_id){
+          continue;
+        }
+        Segment2d seg2{{segment2.first.first.get<0>(), segment2.first.first.get<1>()},
+            {segment2.first.second.get<0>(), segment2.first.second.get<1>()}};
+
+        double distance = boost::geometry::distance(seg1, seg2);
+        // better to set distance to lanewidth
+        if(distance > 2.0){
+          continue;
+        }
+        auto first = waypoint1;
+        auto second = waypoint2;
+        if (std::tie(second.road_id, second.lane_id) <
+            std::tie(first.road_id, first.lane_id)) {
+          std::swap(first, second);
+        }
+        const auto key = std::make_tuple(
+            first.road_id, first.lane_id, second.road_id, second.lane_id);
+        auto it = closest.find(key);
+        if (it == closest.end() || distance < it->second.first) {
+          closest[key] = {distance, Junction::LaneConflict{
+              first.road_id, first.lane_id, first.s,
+              second.road_id, second.lane_id, second.s}};
+        }
+      }
+    }
+
+    std::vector<Junction::LaneConflict> result;
+    result.reserve(closest.size());
+    for (const auto &pair : closest) {
+      result.emplace_back(pair.second.second);
+    }
+    return result;
+  }
+
   const Lane &Map::GetLane(Waypoint waypoint) const {
     return _data.GetRoad(waypoint.road_id).GetLaneById(waypoint.section_id, waypoint.lane_id);
   }
@@ -918,8 +1137,9 @@ namespace road {
         }
       }
     }
-    // Add segments to Rtree
-    _rtree.InsertElements(rtree_elements);
+    // Build the Rtree from the complete segment set, packed construction is
+    // faster and yields a better balanced tree than repeated insertion
+    _rtree.BulkLoad(rtree_elements);
   }
 
   Junction* Map::GetJunction(JuncId id) {
@@ -935,24 +1155,53 @@ namespace road {
       const float extra_width,
       const  bool smooth_junctions) const {
     RELEASE_ASSERT(distance > 0.0);
+    const auto cache_key = std::make_tuple(distance, extra_width, smooth_junctions);
+    {
+      std::lock_guard<std::mutex> lock(_mesh_cache->mutex);
+      const auto it = _mesh_cache->meshes.find(cache_key);
+      if (it != _mesh_cache->meshes.end()) {
+        return it->second;
+      }
+    }
     geom::MeshFactory mesh_factory;
     geom::Mesh out_mesh;
 
     mesh_factory.road_param.resolution = static_cast<float>(distance);
     mesh_factory.road_param.extra_lane_width = extra_width;
 
-    // Generate roads outside junctions
+    // Generate roads outside junctions, one worker per road, merging the
+    // per-worker meshes afterwards in deterministic order
+    std::vector<const Road *> roads;
+    roads.reserve(_data.GetRoads().size());
     for (auto &&pair : _data.GetRoads()) {
-      const auto &road = pair.second;
-      if (road.IsJunction()) {
-        continue;
+      if (!pair.second.IsJunction()) {
+        roads.emplace_back(&pair.second);
       }
-      out_mesh += *mesh_factory.Generate(road);
+    }
+    std::vector<std::unique_ptr<geom::Mesh>> road_meshes(roads.size());
+    ParallelForEachIndex(roads.size(), [&](size_t index) {
+      road_meshes[index] = mesh_factory.Generate(*roads[index]);
+    });
+    size_t total_vertices = 0u;
+    size_t total_indexes = 0u;
+    for (const auto &road_mesh : road_meshes) {
+      total_vertices += road_mesh->GetVerticesNum();
+      total_indexes += road_mesh->GetIndexesNum();
+    }
+    out_mesh.Reserve(total_vertices, total_indexes);
+    for (const auto &road_mesh : road_meshes) {
+      out_mesh += *road_mesh;
     }
 
-    // Generate roads within junctions and smooth them
+    // Generate roads within junctions and smooth them, one worker per junction
+    std::vector<const Junction *> junctions;
+    junctions.reserve(_data.GetJunctions().size());
     for (const auto &junc_pair : _data.GetJunctions()) {
-      const auto &junction = junc_pair.second;
+      junctions.emplace_back(&junc_pair.second);
+    }
+    std::vector<std::unique_ptr<geom::Mesh>> junction_meshes(junctions.size());
+    ParallelForEachIndex(junctions.size(), [&](size_t index) {
+      const auto &junction = *junctions[index];
       std::vector<std::unique_ptr<geom::Mesh>> lane_meshes;
       for(const auto &connection_pair : junction.GetConnections()) {
         const auto &connection = connection_pair.second;
@@ -964,17 +1213,21 @@ namespace road {
         }
       }
       if(smooth_junctions) {
-        out_mesh += *mesh_factory.MergeAndSmooth(lane_meshes);
+        junction_meshes[index] = mesh_factory.MergeAndSmooth(lane_meshes);
       } else {
-        geom::Mesh junction_mesh;
+        auto junction_mesh = std::make_unique<geom::Mesh>();
         for(auto& lane : lane_meshes) {
-          junction_mesh += *lane;
+          *junction_mesh += *lane;
         }
-        out_mesh += junction_mesh;
+        junction_meshes[index] = std::move(junction_mesh);
       }
+    });
+    for (const auto &junction_mesh : junction_meshes) {
+      out_mesh += *junction_mesh;
     }
 
-    return out_mesh;
+    std::lock_guard<std::mutex> lock(_mesh_cache->mutex);
+    return _mesh_cache->meshes.emplace(cache_key, std::move(out_mesh)).first->second;
   }
 
   std::vector<std::unique_ptr<geom::Mesh>> Map::GenerateChunkedMesh(
@@ -985,29 +1238,54 @@ namespace road {
     RELEASE_ASSERT(distance > 0.0);
     RELEASE_ASSERT(extra_width >= 0.0);
     RELEASE_ASSERT(max_road_len > 0.0);
+    const auto cache_key = std::make_tuple(distance, max_road_len, extra_width, smooth_junctions);
+    {
+      std::lock_guard<std::mutex> lock(_mesh_cache->mutex);
+      const auto it = _mesh_cache->chunked_meshes.find(cache_key);
+      if (it != _mesh_cache->chunked_meshes.end()) {
+        std::vector<std::unique_ptr<geom::Mesh>> cached_list;
+        cached_list.reserve(it->second.size());
+        for (const auto &mesh : it->second) {
+          cached_list.push_back(std::make_unique<geom::Mesh>(mesh));
+        }
+        return cached_list;
+      }
+    }
     geom::MeshFactory mesh_factory;
     mesh_factory.road_param.resolution = static_cast<float>(distance);
     mesh_factory.road_param.max_road_len = max_road_len;
     mesh_factory.road_param.extra_lane_width = extra_width;
     std::vector<std::unique_ptr<geom::Mesh>> out_mesh_list;
 
-    std::unordered_map<JuncId, geom::Mesh> junction_map;
+    // Generate roads outside junctions, one worker per road, concatenating
+    // the per-road chunk lists afterwards in deterministic order
+    std::vector<const Road *> roads;
+    roads.reserve(_data.GetRoads().size());
     for (auto &&pair : _data.GetRoads()) {
-      const auto &road = pair.second;
-      if (!road.IsJunction()) {
-        std::vector<std::unique_ptr<geom::Mesh>> road_mesh_list =
-            mesh_factory.GenerateAllWithMaxLen(road);
-
-        out_mesh_list.insert(
-            out_mesh_list.end(),
-            std::make_move_iterator(road_mesh_list.begin()),
-            std::make_move_iterator(road_mesh_list.end()));
+      if (!pair.second.IsJunction()) {
+        roads.emplace_back(&pair.second);
       }
     }
+    std::vector<std::vector<std::unique_ptr<geom::Mesh>>> road_mesh_lists(roads.size());
+    ParallelForEachIndex(roads.size(), [&](size_t index) {
+      road_mesh_lists[index] = mesh_factory.GenerateAllWithMaxLen(*roads[index]);
+    });
+    for (auto &road_mesh_list : road_mesh_lists) {
+      out_mesh_list.insert(
+          out_mesh_list.end(),
+          std::make_move_iterator(road_mesh_list.begin()),
+          std::make_move_iterator(road_mesh_list.end()));
+    }
 
-    // Generate roads within junctions and smooth them
+    // Generate roads within junctions and smooth them, one worker per junction
+    std::vector<const Junction *> junctions;
+    junctions.reserve(_data.GetJunctions().size());
     for (const auto &junc_pair : _data.GetJunctions()) {
-      const auto &junction = junc_pair.second;
+      junctions.emplace_back(&junc_pair.second);
+    }
+    std::vector<std::unique_ptr<geom::Mesh>> junction_meshes(junctions.size());
+    ParallelForEachIndex(junctions.size(), [&](size_t index) {
+      const auto &junction = *junctions[index];
       std::vector<std::unique_ptr<geom::Mesh>> lane_meshes;
       std::vector<std::unique_ptr<geom::Mesh>> sidewalk_lane_meshes;
       for(const auto &connection_pair : junction.GetConnections()) {
@@ -1029,7 +1307,7 @@ namespace road {
         for(auto& lane : sidewalk_lane_meshes) {
           *merged_mesh += *lane;
         }
-        out_mesh_list.push_back(std::move(merged_mesh));
+        junction_meshes[index] = std::move(merged_mesh);
       } else {
         std::unique_ptr<geom::Mesh> junction_mesh = std::make_unique<geom::Mesh>();
         for(auto& lane : lane_meshes) {
@@ -1038,10 +1316,23 @@ namespace road {
         for(auto& lane : sidewalk_lane_meshes) {
           *junction_mesh += *lane;
         }
-        out_mesh_list.push_back(std::move(junction_mesh));
+        junction_meshes[index] = std::move(junction_mesh);
       }
+    });
+    for (auto &junction_mesh : junction_meshes) {
+      out_mesh_list.push_back(std::move(junction_mesh));
     }
 
+    {
+      std::lock_guard<std::mutex> lock(_mesh_cache->mutex);
+      auto &cached = _mesh_cache->chunked_meshes[cache_key];
+      if (cached.empty()) {
+        cached.reserve(out_mesh_list.size());
+        for (const auto &mesh : out_mesh_list) {
+          cached.push_back(*mesh);
+        }
+      }
+    }
     return out_mesh_list;
   }
 
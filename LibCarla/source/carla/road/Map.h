@@ -18,6 +18,10 @@
 
 #include <boost/optional.hpp>
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
 #include <vector>
 
 namespace carla {
@@ -52,6 +56,17 @@ namespace road {
         const geom::Location &location,
         uint32_t lane_type = static_cast<uint32_t>(Lane::LaneType::Driving)) const;
 
+    /// Batched version of GetClosestWaypointOnRoad. Resolves @a count
+    /// locations in one call, processing them in an order sorted for R-tree
+    /// locality and reusing the query machinery across queries. Results are
+    /// written to the caller-provided @a results storage, one per input
+    /// location, in input order.
+    void GetClosestWaypoints(
+        const geom::Location *locations,
+        size_t count,
+        boost::optional<element::Waypoint> *results,
+        uint32_t lane_type = static_cast<uint32_t>(Lane::LaneType::Driving)) const;
+
     boost::optional<element::Waypoint> GetWaypoint(
         const geom::Location &location,
         uint32_t lane_type = static_cast<uint32_t>(Lane::LaneType::Driving)) const;
@@ -63,6 +78,13 @@ namespace road {
 
     geom::Transform ComputeTransform(Waypoint waypoint) const;
 
+    /// Batched version of ComputeTransform writing one transform per input
+    /// waypoint into the caller-provided @a results storage.
+    void ComputeTransforms(
+        const Waypoint *waypoints,
+        size_t count,
+        geom::Transform *results) const;
+
     /// ========================================================================
     /// -- Road information ----------------------------------------------------
     /// ========================================================================
@@ -127,8 +149,13 @@ namespace road {
     boost::optional<Waypoint> GetLeft(Waypoint waypoint) const;
 
     /// Generate all the waypoints in @a map separated by @a approx_distance.
+    /// The per-road chunks are generated concurrently, one worker per road.
     std::vector<Waypoint> GenerateWaypoints(double approx_distance) const;
 
+    /// Generate the waypoints of a single road separated by @a
+    /// approx_distance, useful to stream the map road by road.
+    std::vector<Waypoint> GenerateRoadWaypoints(RoadId road_id, double approx_distance) const;
+
     /// Generate waypoints on each @a lane at the start of each @a road
     std::vector<Waypoint> GenerateWaypointsOnRoadEntries(Lane::LaneType lane_type = Lane::LaneType::Driving) const;
 
@@ -136,9 +163,13 @@ namespace road {
     std::vector<Waypoint> GenerateWaypointsInRoad(RoadId road_id, Lane::LaneType lane_type = Lane::LaneType::Driving) const;
 
     /// Generate the minimum set of waypoints that define the topology of @a
-    /// map. The waypoints are placed at the entrance of each lane.
+    /// map. The waypoints are placed at the entrance of each lane. The
+    /// per-road chunks are generated concurrently, one worker per road.
     std::vector<std::pair<Waypoint, Waypoint>> GenerateTopology() const;
 
+    /// Generate the topology edges that start in the given road.
+    std::vector<std::pair<Waypoint, Waypoint>> GenerateRoadTopology(RoadId road_id) const;
+
     /// Generate waypoints of the junction
     std::vector<std::pair<Waypoint, Waypoint>> GetJunctionWaypoints(JuncId id, Lane::LaneType lane_type) const;
 
@@ -149,6 +180,11 @@ namespace road {
     std::unordered_map<road::RoadId, std::unordered_set<road::RoadId>>
         ComputeJunctionConflicts(JuncId id) const;
 
+    /// Lane-level refinement of ComputeJunctionConflicts: every pair of
+    /// connecting lanes of the junction that geometrically cross, with the
+    /// s coordinate of the conflict point along each lane.
+    std::vector<Junction::LaneConflict> ComputeJunctionLaneConflicts(JuncId id) const;
+
     /// Buids a mesh based on the OpenDRIVE
     geom::Mesh GenerateMesh(
         const double distance,
@@ -174,6 +210,17 @@ namespace road {
       return _data.GetControllers();
     }
 
+    /// Ids of every road of the map, useful to consume the per-road
+    /// generators road by road.
+    std::vector<RoadId> GetRoadIds() const {
+      std::vector<RoadId> result;
+      result.reserve(_data.GetRoads().size());
+      for (const auto &pair : _data.GetRoads()) {
+        result.emplace_back(pair.first);
+      }
+      return result;
+    }
+
 #ifdef LIBCARLA_WITH_GTEST
     MapData &GetMap() {
       return _data;
@@ -183,6 +230,7 @@ namespace road {
 private:
 
     friend MapBuilder;
+    friend class MapSerializer;
     MapData _data;
 
     using Rtree = geom::SegmentCloudRtree<Waypoint>;
@@ -190,6 +238,24 @@ private:
 
     void CreateRtree();
 
+    /// Generated meshes are static per map but expensive to build, so they
+    /// are memoized keyed by the generation parameters; the owning map
+    /// instance stands in for the map hash part of the key. Held through a
+    /// pointer to keep the map movable.
+    struct MeshCache {
+      std::mutex mutex;
+      std::map<std::tuple<double, float, bool>, geom::Mesh> meshes;
+      std::map<std::tuple<double, float, float, bool>, std::vector<geom::Mesh>> chunked_meshes;
+    };
+    mutable std::unique_ptr<MeshCache> _mesh_cache = std::make_unique<MeshCache>();
+
+    /// GetClosestWaypointOnRoad variant reusing @a query_result as scratch
+    /// storage, so batched callers do not pay an allocation per query.
+    boost::optional<element::Waypoint> GetClosestWaypointOnRoad(
+        const geom::Location &location,
+        uint32_t lane_type,
+        std::vector<Rtree::TreeElement> &query_result) const;
+
     /// Helper Functions for constructing the rtree element list
     void AddElementToRtree(
         std::vector<Rtree::TreeElement> &rtree_elements,
@@ -27,6 +27,7 @@
 
 #include <iterator>
 #include <memory>
+#include <mutex>
 
 using namespace carla::road::element;
 
@@ -77,6 +78,7 @@ namespace road {
       const double d) {
     DEBUG_ASSERT(road != nullptr);
     auto elevation = std::make_unique<RoadInfoElevation>(s, a, b, c, d);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_road_info_container[road].emplace_back(std::move(elevation));
   }
 
@@ -104,6 +106,7 @@ namespace road {
       const double s,
       const std::string restriction) {
     DEBUG_ASSERT(lane != nullptr);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneAccess>(s, restriction));
   }
 
@@ -115,6 +118,7 @@ namespace road {
       const double c,
       const double d) {
     DEBUG_ASSERT(lane != nullptr);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneBorder>(s, a, b, c, d));
   }
 
@@ -124,6 +128,7 @@ namespace road {
       const double inner,
       const double outer) {
     DEBUG_ASSERT(lane != nullptr);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneHeight>(s, inner, outer));
   }
 
@@ -134,6 +139,7 @@ namespace road {
       const double friction,
       const double roughness) {
     DEBUG_ASSERT(lane != nullptr);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneMaterial>(s, surface, friction,
         roughness));
   }
@@ -143,6 +149,7 @@ namespace road {
       const double s,
       const std::string value) {
     DEBUG_ASSERT(lane != nullptr);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneRule>(s, value));
   }
 
@@ -154,6 +161,7 @@ namespace road {
       const double left,
       const double right) {
     DEBUG_ASSERT(lane != nullptr);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneVisibility>(s, forward, back,
         left, right));
   }
@@ -166,6 +174,7 @@ namespace road {
       const double c,
       const double d) {
     DEBUG_ASSERT(lane != nullptr);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneWidth>(s, a, b, c, d));
   }
 
@@ -196,6 +205,7 @@ namespace road {
     } else {
       lc = RoadInfoMarkRecord::LaneChange::None;
     }
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoMarkRecord>(s, road_mark_id, type,
         weight, color,
         material, width, lc, height, type_name, type_width));
@@ -211,6 +221,7 @@ namespace road {
       const std::string rule,
       const double width) {
     DEBUG_ASSERT(lane != nullptr);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     auto it = MakeRoadInfoIterator<RoadInfoMarkRecord>(_temp_lane_info_container[lane]);
     for (; !it.IsAtEnd(); ++it) {
       if (it->GetRoadMarkId() == road_mark_id) {
@@ -228,6 +239,7 @@ namespace road {
       const double max,
       const std::string /*unit*/) {
     DEBUG_ASSERT(lane != nullptr);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoSpeed>(s, max));
   }
 
@@ -311,13 +323,18 @@ namespace road {
     }
 
     // build road objects
+    void MapBuilder::ReserveRoads(const size_t count) {
+      _map_data._roads.reserve(count);
+    }
+
     carla::road::Road *MapBuilder::AddRoad(
         const RoadId road_id,
         const std::string name,
         const double length,
         const JuncId junction_id,
         const RoadId predecessor,
-        const RoadId successor)
+        const RoadId successor,
+        const size_t section_count)
     {
 
       // add it
@@ -333,16 +350,22 @@ namespace road {
       road->_successor = successor;
       road->_predecessor = predecessor;
 
+      // pointers into the flat section storage must survive the insertions
+      // that follow
+      road->_lane_sections.Reserve(section_count);
+
       return road;
   }
 
   carla::road::LaneSection *MapBuilder::AddRoadSection(
       Road *road,
       const SectionId id,
-      const double s) {
+      const double s,
+      const size_t lane_count) {
     DEBUG_ASSERT(road != nullptr);
     carla::road::LaneSection &sec = road->_lane_sections.Emplace(id, s);
     sec._road = road;
+    sec._lanes.Reserve(lane_count);
     return &sec;
   }
 
@@ -356,7 +379,7 @@ namespace road {
     DEBUG_ASSERT(section != nullptr);
 
     // add the lane
-    auto *lane = &((section->_lanes.emplace(lane_id, Lane()).first)->second);
+    auto *lane = &(section->_lanes.Emplace(lane_id)->second);
 
     // set lane data
     lane->_id = lane_id;
@@ -384,6 +407,7 @@ namespace road {
         hdg,
         location);
 
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_road_info_container[road].emplace_back(std::unique_ptr<RoadInfo>(new RoadInfoGeometry(s,
         std::move(line_geometry))));
   }
@@ -426,6 +450,7 @@ namespace road {
         location,
         curvature);
 
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_road_info_container[road].emplace_back(std::unique_ptr<RoadInfo>(new RoadInfoGeometry(s,
         std::move(arc_geometry))));
   }
@@ -450,6 +475,7 @@ namespace road {
         curvStart,
         curvEnd);
 
+      std::lock_guard<std::mutex> lock(_temp_info_mutex);
       _temp_road_info_container[road].emplace_back(std::unique_ptr<RoadInfo>(new RoadInfoGeometry(s,
         std::move(spiral_geometry))));
   }
@@ -477,6 +503,9 @@ namespace road {
         b,
         c,
         d);
+    // the expensive spline precomputation already ran in the geometry
+    // constructor above, outside the lock
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_road_info_container[road].emplace_back(std::unique_ptr<RoadInfo>(new RoadInfoGeometry(s,
         std::move(poly3_geometry))));
   }
@@ -520,6 +549,7 @@ namespace road {
         cV,
         dV,
         arcLength);
+    std::lock_guard<std::mutex> lock(_temp_info_mutex);
     _temp_road_info_container[road].emplace_back(std::unique_ptr<RoadInfo>(new RoadInfoGeometry(s,
         std::move(parampoly3_geometry))));
   }
@@ -887,7 +917,13 @@ void MapBuilder::CreateController(
   void MapBuilder::ComputeJunctionRoadConflicts(Map &map) {
     for (auto &junctionpair : map._data.GetJunctions()) {
       auto& junction = junctionpair.second;
-      junction._road_conflicts = (map.ComputeJunctionConflicts(junction.GetId()));
+      junction._lane_conflicts = map.ComputeJunctionLaneConflicts(junction.GetId());
+      // the road-level matrix is a projection of the lane-level one, so
+      // derive it instead of scanning the rtree a second time
+      for (const auto &conflict : junction._lane_conflicts) {
+        junction._road_conflicts[conflict.road_id].insert(conflict.other_road_id);
+        junction._road_conflicts[conflict.other_road_id].insert(conflict.road_id);
+      }
     }
   }
 
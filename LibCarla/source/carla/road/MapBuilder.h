@@ -13,6 +13,7 @@
 #include <boost/optional.hpp>
 
 #include <map>
+#include <mutex>
 
 namespace carla {
 namespace road {
@@ -23,18 +24,29 @@ namespace road {
     boost::optional<Map> Build();
 
     // called from road parser
+
+    /// Make room for @a count roads upfront so the road map does not rehash
+    /// while the parser fills it in.
+    void ReserveRoads(const size_t count);
+
+    /// @a section_count reserves the lane section storage upfront; sections
+    /// are stored flat and pointers handed out by AddRoadSection must stay
+    /// valid while more sections are added.
     carla::road::Road *AddRoad(
         const RoadId road_id,
         const std::string name,
         const double length,
         const JuncId junction_id,
         const RoadId predecessor,
-        const RoadId successor);
+        const RoadId successor,
+        const size_t section_count);
 
+    /// @a lane_count reserves the lane storage upfront, see AddRoad.
     carla::road::LaneSection *AddRoadSection(
         carla::road::Road *road,
         const SectionId id,
-        const double s);
+        const double s,
+        const size_t lane_count);
 
     carla::road::Lane *AddRoadSectionLane(
         carla::road::LaneSection *section,
@@ -345,6 +357,8 @@ namespace road {
 
   private:
 
+    friend class MapSerializer;
+
     MapData _map_data;
 
     /// Create the pointers between RoadSegments based on the ids.
@@ -385,6 +399,10 @@ namespace road {
         RoadId road_id,
         LaneId lane_id);
 
+    /// Guards the temporary info containers below; the geometry, lane and
+    /// profile parsers fill them concurrently, one worker per road.
+    std::mutex _temp_info_mutex;
+
     /// Map to temporary store all the road and lane infos until the map is
     /// built, so they can be added all together.
     std::unordered_map<Road *, std::vector<std::unique_ptr<element::RoadInfo>>>
@@ -0,0 +1,912 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/MapSerializer.h"
+
+#include "carla/Exception.h"
+#include "carla/road/MapBuilder.h"
+#include "carla/road/element/RoadInfoCrosswalk.h"
+#include "carla/road/element/RoadInfoElevation.h"
+#include "carla/road/element/RoadInfoGeometry.h"
+#include "carla/road/element/RoadInfoLaneAccess.h"
+#include "carla/road/element/RoadInfoLaneBorder.h"
+#include "carla/road/element/RoadInfoLaneHeight.h"
+#include "carla/road/element/RoadInfoLaneMaterial.h"
+#include "carla/road/element/RoadInfoLaneOffset.h"
+#include "carla/road/element/RoadInfoLaneRule.h"
+#include "carla/road/element/RoadInfoLaneVisibility.h"
+#include "carla/road/element/RoadInfoLaneWidth.h"
+#include "carla/road/element/RoadInfoMarkRecord.h"
+#include "carla/road/element/RoadInfoMarkTypeLine.h"
+#include "carla/road/element/RoadInfoSignal.h"
+#include "carla/road/element/RoadInfoSpeed.h"
+
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+
+namespace carla {
+namespace road {
+
+  using namespace element;
+
+  // ===========================================================================
+  // -- Primitive readers and writers ------------------------------------------
+  // ===========================================================================
+
+  // The cache is a local artifact keyed by content hash, not an interchange
+  // format, so everything is written in the host's native representation.
+
+  namespace {
+
+    constexpr uint32_t SERIALIZER_MAGIC = 0x4f44524du; // "ODRM"
+
+    constexpr uint32_t SERIALIZER_VERSION = 2u;
+
+    /// Refuse to allocate absurd amounts on a corrupt or truncated file.
+    constexpr uint32_t MAX_ELEMENT_COUNT = 0x10000000u;
+
+    template <typename T>
+    static void WriteValue(std::ostream &out, const T &value) {
+      static_assert(
+          std::is_arithmetic<T>::value || std::is_enum<T>::value,
+          "only scalar types can be written directly");
+      out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    static T ReadValue(std::istream &in) {
+      T value{};
+      in.read(reinterpret_cast<char *>(&value), sizeof(value));
+      return value;
+    }
+
+    static void WriteCount(std::ostream &out, size_t count) {
+      WriteValue(out, static_cast<uint32_t>(count));
+    }
+
+    static uint32_t ReadCount(std::istream &in) {
+      const auto count = ReadValue<uint32_t>(in);
+      if (count > MAX_ELEMENT_COUNT) {
+        in.setstate(std::ios_base::failbit);
+        return 0u;
+      }
+      return count;
+    }
+
+    static void WriteString(std::ostream &out, const std::string &str) {
+      WriteCount(out, str.size());
+      out.write(str.data(), static_cast<std::streamsize>(str.size()));
+    }
+
+    static std::string ReadString(std::istream &in) {
+      std::string str(ReadCount(in), '\0');
+      if (in) {
+        in.read(&str[0], static_cast<std::streamsize>(str.size()));
+      }
+      return str;
+    }
+
+    static void WriteLocation(std::ostream &out, const geom::Location &location) {
+      WriteValue(out, location.x);
+      WriteValue(out, location.y);
+      WriteValue(out, location.z);
+    }
+
+    static geom::Location ReadLocation(std::istream &in) {
+      const auto x = ReadValue<float>(in);
+      const auto y = ReadValue<float>(in);
+      const auto z = ReadValue<float>(in);
+      return geom::Location(x, y, z);
+    }
+
+    static void WriteVector3D(std::ostream &out, const geom::Vector3D &vector) {
+      WriteValue(out, vector.x);
+      WriteValue(out, vector.y);
+      WriteValue(out, vector.z);
+    }
+
+    static geom::Vector3D ReadVector3D(std::istream &in) {
+      const auto x = ReadValue<float>(in);
+      const auto y = ReadValue<float>(in);
+      const auto z = ReadValue<float>(in);
+      return geom::Vector3D(x, y, z);
+    }
+
+    static void WriteTransform(std::ostream &out, const geom::Transform &transform) {
+      WriteLocation(out, transform.location);
+      WriteValue(out, transform.rotation.pitch);
+      WriteValue(out, transform.rotation.yaw);
+      WriteValue(out, transform.rotation.roll);
+    }
+
+    static geom::Transform ReadTransform(std::istream &in) {
+      const auto location = ReadLocation(in);
+      const auto pitch = ReadValue<float>(in);
+      const auto yaw = ReadValue<float>(in);
+      const auto roll = ReadValue<float>(in);
+      return geom::Transform(location, geom::Rotation(pitch, yaw, roll));
+    }
+
+    /// The five-argument CubicPolynomial constructor re-centers the
+    /// coefficients around s, so write back the Taylor expansion at s; feeding
+    /// it to that same constructor (or Set) reproduces the stored polynomial.
+    static void WriteRecenteredPolynomial(std::ostream &out, const geom::CubicPolynomial &poly) {
+      const auto s = poly.GetS();
+      WriteValue(out, poly.Evaluate(s));
+      WriteValue(out, poly.Tangent(s));
+      WriteValue(out, poly.GetC() + 3.0 * poly.GetD() * s);
+      WriteValue(out, poly.GetD());
+    }
+
+    // =========================================================================
+    // -- Geometry ---------------------------------------------------------------
+    // =========================================================================
+
+    static void WriteGeometry(std::ostream &out, const Geometry &geometry) {
+      WriteValue(out, static_cast<uint8_t>(geometry.GetType()));
+      WriteValue(out, geometry.GetStartOffset());
+      WriteValue(out, geometry.GetLength());
+      WriteValue(out, geometry.GetHeading());
+      WriteLocation(out, geometry.GetStartPosition());
+      switch (geometry.GetType()) {
+        case GeometryType::LINE:
+          break;
+        case GeometryType::ARC: {
+          const auto &arc = static_cast<const GeometryArc &>(geometry);
+          WriteValue(out, arc.GetCurvature());
+          break;
+        }
+        case GeometryType::SPIRAL: {
+          const auto &spiral = static_cast<const GeometrySpiral &>(geometry);
+          WriteValue(out, spiral.GetCurveStart());
+          WriteValue(out, spiral.GetCurveEnd());
+          break;
+        }
+        case GeometryType::POLY3: {
+          const auto &poly = static_cast<const GeometryPoly3 &>(geometry);
+          WriteValue(out, poly.Geta());
+          WriteValue(out, poly.Getb());
+          WriteValue(out, poly.Getc());
+          WriteValue(out, poly.Getd());
+          break;
+        }
+        case GeometryType::POLY3PARAM: {
+          const auto &poly = static_cast<const GeometryParamPoly3 &>(geometry);
+          WriteValue(out, poly.GetaU());
+          WriteValue(out, poly.GetbU());
+          WriteValue(out, poly.GetcU());
+          WriteValue(out, poly.GetdU());
+          WriteValue(out, poly.GetaV());
+          WriteValue(out, poly.GetbV());
+          WriteValue(out, poly.GetcV());
+          WriteValue(out, poly.GetdV());
+          WriteValue(out, poly.IsArcLength());
+          break;
+        }
+      }
+    }
+
+    static std::unique_ptr<Geometry> ReadGeometry(std::istream &in) {
+      const auto type = static_cast<GeometryType>(ReadValue<uint8_t>(in));
+      const auto start_offset = ReadValue<double>(in);
+      const auto length = ReadValue<double>(in);
+      const auto heading = ReadValue<double>(in);
+      const auto start_pos = ReadLocation(in);
+      switch (type) {
+        case GeometryType::LINE:
+          return std::make_unique<GeometryLine>(start_offset, length, heading, start_pos);
+        case GeometryType::ARC: {
+          const auto curvature = ReadValue<double>(in);
+          return std::make_unique<GeometryArc>(start_offset, length, heading, start_pos, curvature);
+        }
+        case GeometryType::SPIRAL: {
+          const auto curve_start = ReadValue<double>(in);
+          const auto curve_end = ReadValue<double>(in);
+          return std::make_unique<GeometrySpiral>(
+              start_offset, length, heading, start_pos, curve_start, curve_end);
+        }
+        case GeometryType::POLY3: {
+          const auto a = ReadValue<double>(in);
+          const auto b = ReadValue<double>(in);
+          const auto c = ReadValue<double>(in);
+          const auto d = ReadValue<double>(in);
+          return std::make_unique<GeometryPoly3>(
+              start_offset, length, heading, start_pos, a, b, c, d);
+        }
+        case GeometryType::POLY3PARAM: {
+          const auto aU = ReadValue<double>(in);
+          const auto bU = ReadValue<double>(in);
+          const auto cU = ReadValue<double>(in);
+          const auto dU = ReadValue<double>(in);
+          const auto aV = ReadValue<double>(in);
+          const auto bV = ReadValue<double>(in);
+          const auto cV = ReadValue<double>(in);
+          const auto dV = ReadValue<double>(in);
+          const auto arc_length = ReadValue<bool>(in);
+          return std::make_unique<GeometryParamPoly3>(
+              start_offset, length, heading, start_pos,
+              aU, bU, cU, dU, aV, bV, cV, dV, arc_length);
+        }
+      }
+      in.setstate(std::ios_base::failbit);
+      return nullptr;
+    }
+
+    /// Discriminator for the polymorphic RoadInfo entries; append only, the
+    /// values are part of the on-disk format.
+    enum class InfoTag : uint8_t {
+      Elevation,
+      Geometry,
+      LaneAccess,
+      LaneBorder,
+      LaneHeight,
+      LaneMaterial,
+      LaneOffset,
+      LaneRule,
+      LaneVisibility,
+      LaneWidth,
+      MarkRecord,
+      MarkTypeLine,
+      Speed,
+      Crosswalk,
+      Signal
+    };
+
+  } // namespace
+
+  // ===========================================================================
+  // -- MapSerializer::Access --------------------------------------------------
+  // ===========================================================================
+
+  /// Nested so it shares the friendship the road classes grant MapSerializer.
+  class MapSerializer::Access {
+  public:
+
+    static void WriteInfo(std::ostream &out, const RoadInfo &info) {
+      const auto write_header = [&out, &info](InfoTag tag) {
+        WriteValue(out, tag);
+        WriteValue(out, info.GetDistance());
+      };
+      if (auto *elevation = dynamic_cast<const RoadInfoElevation *>(&info)) {
+        write_header(InfoTag::Elevation);
+        WriteRecenteredPolynomial(out, elevation->GetPolynomial());
+      } else if (auto *geometry = dynamic_cast<const RoadInfoGeometry *>(&info)) {
+        write_header(InfoTag::Geometry);
+        WriteGeometry(out, geometry->GetGeometry());
+      } else if (auto *access = dynamic_cast<const RoadInfoLaneAccess *>(&info)) {
+        write_header(InfoTag::LaneAccess);
+        WriteString(out, access->GetRestriction());
+      } else if (auto *border = dynamic_cast<const RoadInfoLaneBorder *>(&info)) {
+        write_header(InfoTag::LaneBorder);
+        WriteRecenteredPolynomial(out, border->GetPolynomial());
+      } else if (auto *height = dynamic_cast<const RoadInfoLaneHeight *>(&info)) {
+        write_header(InfoTag::LaneHeight);
+        WriteValue(out, height->GetInner());
+        WriteValue(out, height->GetOuter());
+      } else if (auto *material = dynamic_cast<const RoadInfoLaneMaterial *>(&info)) {
+        write_header(InfoTag::LaneMaterial);
+        WriteString(out, material->GetSurface());
+        WriteValue(out, material->GetFriction());
+        WriteValue(out, material->GetRoughness());
+      } else if (auto *offset = dynamic_cast<const RoadInfoLaneOffset *>(&info)) {
+        write_header(InfoTag::LaneOffset);
+        WriteRecenteredPolynomial(out, offset->GetPolynomial());
+      } else if (auto *rule = dynamic_cast<const RoadInfoLaneRule *>(&info)) {
+        write_header(InfoTag::LaneRule);
+        WriteString(out, rule->GetValue());
+      } else if (auto *visibility = dynamic_cast<const RoadInfoLaneVisibility *>(&info)) {
+        write_header(InfoTag::LaneVisibility);
+        WriteValue(out, visibility->GetForward());
+        WriteValue(out, visibility->GetBack());
+        WriteValue(out, visibility->GetLeft());
+        WriteValue(out, visibility->GetRight());
+      } else if (auto *width = dynamic_cast<const RoadInfoLaneWidth *>(&info)) {
+        write_header(InfoTag::LaneWidth);
+        WriteRecenteredPolynomial(out, width->GetPolynomial());
+      } else if (auto *mark = dynamic_cast<const RoadInfoMarkRecord *>(&info)) {
+        write_header(InfoTag::MarkRecord);
+        WriteValue(out, mark->GetRoadMarkId());
+        WriteString(out, mark->GetType());
+        WriteString(out, mark->GetWeight());
+        WriteString(out, mark->GetColor());
+        WriteString(out, mark->GetMaterial());
+        WriteValue(out, mark->GetWidth());
+        WriteValue(out, mark->GetLaneChange());
+        WriteValue(out, mark->GetHeight());
+        WriteString(out, mark->GetTypeName());
+        WriteValue(out, mark->GetTypeWidth());
+        const auto &lines = mark->GetLines();
+        WriteCount(out, lines.size());
+        for (const auto &line : lines) {
+          WriteMarkTypeLine(out, *line);
+        }
+      } else if (auto *line = dynamic_cast<const RoadInfoMarkTypeLine *>(&info)) {
+        write_header(InfoTag::MarkTypeLine);
+        WriteMarkTypeLine(out, *line);
+      } else if (auto *speed = dynamic_cast<const RoadInfoSpeed *>(&info)) {
+        write_header(InfoTag::Speed);
+        WriteValue(out, speed->GetSpeed());
+      } else if (auto *crosswalk = dynamic_cast<const RoadInfoCrosswalk *>(&info)) {
+        write_header(InfoTag::Crosswalk);
+        WriteString(out, crosswalk->GetName());
+        WriteValue(out, crosswalk->GetT());
+        WriteValue(out, crosswalk->GetZOffset());
+        WriteValue(out, crosswalk->GetHeading());
+        WriteValue(out, crosswalk->GetPitch());
+        WriteValue(out, crosswalk->GetRoll());
+        WriteString(out, crosswalk->GetOrientation());
+        WriteValue(out, crosswalk->GetWidth());
+        WriteValue(out, crosswalk->GetLength());
+        const auto &points = crosswalk->GetPoints();
+        WriteCount(out, points.size());
+        for (const auto &point : points) {
+          WriteValue(out, point.u);
+          WriteValue(out, point.v);
+          WriteValue(out, point.z);
+        }
+      } else if (auto *signal_ref = dynamic_cast<const RoadInfoSignal *>(&info)) {
+        write_header(InfoTag::Signal);
+        WriteString(out, signal_ref->_signal_id);
+        WriteValue(out, signal_ref->_road_id);
+        WriteValue(out, signal_ref->_s);
+        WriteValue(out, signal_ref->_t);
+        WriteString(out, signal_ref->_orientation);
+        WriteCount(out, signal_ref->_validities.size());
+        for (const auto &validity : signal_ref->_validities) {
+          WriteValue(out, validity._from_lane);
+          WriteValue(out, validity._to_lane);
+        }
+      } else {
+        throw_exception(std::runtime_error("MapSerializer: unknown RoadInfo type"));
+      }
+    }
+
+    static void WriteMarkTypeLine(std::ostream &out, const RoadInfoMarkTypeLine &line) {
+      WriteValue(out, line.GetDistance());
+      WriteValue(out, line.GetRoadMarkId());
+      WriteValue(out, line.GetLength());
+      WriteValue(out, line.GetSpace());
+      WriteValue(out, line.GetTOffset());
+      WriteString(out, line.GetRule());
+      WriteValue(out, line.GetWidth());
+    }
+
+    static std::unique_ptr<RoadInfoMarkTypeLine> ReadMarkTypeLine(std::istream &in) {
+      const auto s = ReadValue<double>(in);
+      const auto road_mark_id = ReadValue<int>(in);
+      const auto length = ReadValue<double>(in);
+      const auto space = ReadValue<double>(in);
+      const auto t_offset = ReadValue<double>(in);
+      auto rule = ReadString(in);
+      const auto width = ReadValue<double>(in);
+      return std::make_unique<RoadInfoMarkTypeLine>(
+          s, road_mark_id, length, space, t_offset, std::move(rule), width);
+    }
+
+    static std::unique_ptr<RoadInfo> ReadInfo(
+        std::istream &in,
+        std::vector<RoadInfoSignal *> &signal_references) {
+      const auto tag = static_cast<InfoTag>(ReadValue<uint8_t>(in));
+      const auto s = ReadValue<double>(in);
+      switch (tag) {
+        case InfoTag::Elevation: {
+          const auto a = ReadValue<double>(in);
+          const auto b = ReadValue<double>(in);
+          const auto c = ReadValue<double>(in);
+          const auto d = ReadValue<double>(in);
+          return std::make_unique<RoadInfoElevation>(s, a, b, c, d);
+        }
+        case InfoTag::Geometry: {
+          auto geometry = ReadGeometry(in);
+          if (geometry == nullptr) {
+            return nullptr;
+          }
+          return std::make_unique<RoadInfoGeometry>(s, std::move(geometry));
+        }
+        case InfoTag::LaneAccess:
+          return std::make_unique<RoadInfoLaneAccess>(s, ReadString(in));
+        case InfoTag::LaneBorder: {
+          const auto a = ReadValue<double>(in);
+          const auto b = ReadValue<double>(in);
+          const auto c = ReadValue<double>(in);
+          const auto d = ReadValue<double>(in);
+          return std::make_unique<RoadInfoLaneBorder>(s, a, b, c, d);
+        }
+        case InfoTag::LaneHeight: {
+          const auto inner = ReadValue<double>(in);
+          const auto outer = ReadValue<double>(in);
+          return std::make_unique<RoadInfoLaneHeight>(s, inner, outer);
+        }
+        case InfoTag::LaneMaterial: {
+          auto surface = ReadString(in);
+          const auto friction = ReadValue<double>(in);
+          const auto roughness = ReadValue<double>(in);
+          return std::make_unique<RoadInfoLaneMaterial>(
+              s, std::move(surface), friction, roughness);
+        }
+        case InfoTag::LaneOffset: {
+          const auto a = ReadValue<double>(in);
+          const auto b = ReadValue<double>(in);
+          const auto c = ReadValue<double>(in);
+          const auto d = ReadValue<double>(in);
+          return std::make_unique<RoadInfoLaneOffset>(s, a, b, c, d);
+        }
+        case InfoTag::LaneRule:
+          return std::make_unique<RoadInfoLaneRule>(s, ReadString(in));
+        case InfoTag::LaneVisibility: {
+          const auto forward = ReadValue<double>(in);
+          const auto back = ReadValue<double>(in);
+          const auto left = ReadValue<double>(in);
+          const auto right = ReadValue<double>(in);
+          return std::make_unique<RoadInfoLaneVisibility>(s, forward, back, left, right);
+        }
+        case InfoTag::LaneWidth: {
+          const auto a = ReadValue<double>(in);
+          const auto b = ReadValue<double>(in);
+          const auto c = ReadValue<double>(in);
+          const auto d = ReadValue<double>(in);
+          return std::make_unique<RoadInfoLaneWidth>(s, a, b, c, d);
+        }
+        case InfoTag::MarkRecord: {
+          const auto road_mark_id = ReadValue<int>(in);
+          auto type = ReadString(in);
+          auto weight = ReadString(in);
+          auto color = ReadString(in);
+          auto material = ReadString(in);
+          const auto width = ReadValue<double>(in);
+          const auto lane_change = ReadValue<RoadInfoMarkRecord::LaneChange>(in);
+          const auto height = ReadValue<double>(in);
+          auto type_name = ReadString(in);
+          const auto type_width = ReadValue<double>(in);
+          auto mark = std::make_unique<RoadInfoMarkRecord>(
+              s, road_mark_id, std::move(type), std::move(weight), std::move(color),
+              std::move(material), width, lane_change, height, std::move(type_name),
+              type_width);
+          const auto line_count = ReadCount(in);
+          for (auto i = 0u; in && (i < line_count); ++i) {
+            mark->GetLines().emplace_back(ReadMarkTypeLine(in));
+          }
+          return std::move(mark);
+        }
+        case InfoTag::MarkTypeLine:
+          return ReadMarkTypeLine(in);
+        case InfoTag::Speed:
+          return std::make_unique<RoadInfoSpeed>(s, ReadValue<double>(in));
+        case InfoTag::Crosswalk: {
+          auto name = ReadString(in);
+          const auto t = ReadValue<double>(in);
+          const auto z_offset = ReadValue<double>(in);
+          const auto hdg = ReadValue<double>(in);
+          const auto pitch = ReadValue<double>(in);
+          const auto roll = ReadValue<double>(in);
+          auto orientation = ReadString(in);
+          const auto width = ReadValue<double>(in);
+          const auto length = ReadValue<double>(in);
+          const auto point_count = ReadCount(in);
+          std::vector<CrosswalkPoint> points;
+          points.reserve(point_count);
+          for (auto i = 0u; in && (i < point_count); ++i) {
+            const auto u = ReadValue<double>(in);
+            const auto v = ReadValue<double>(in);
+            const auto z = ReadValue<double>(in);
+            points.emplace_back(u, v, z);
+          }
+          return std::make_unique<RoadInfoCrosswalk>(
+              s, std::move(name), t, z_offset, hdg, pitch, roll,
+              std::move(orientation), width, length, std::move(points));
+        }
+        case InfoTag::Signal: {
+          auto signal_id = ReadString(in);
+          const auto road_id = ReadValue<RoadId>(in);
+          const auto signal_s = ReadValue<double>(in);
+          const auto signal_t = ReadValue<double>(in);
+          auto orientation = ReadString(in);
+          auto signal_ref = std::make_unique<RoadInfoSignal>(
+              std::move(signal_id), road_id, signal_s, signal_t, std::move(orientation));
+          const auto validity_count = ReadCount(in);
+          for (auto i = 0u; in && (i < validity_count); ++i) {
+            const auto from_lane = ReadValue<LaneId>(in);
+            const auto to_lane = ReadValue<LaneId>(in);
+            signal_ref->_validities.emplace_back(from_lane, to_lane);
+          }
+          // The Signal pointer is resolved once the signals are read.
+          signal_references.emplace_back(signal_ref.get());
+          return std::move(signal_ref);
+        }
+      }
+      in.setstate(std::ios_base::failbit);
+      return nullptr;
+    }
+
+    static void WriteInfoSet(std::ostream &out, const InformationSet &info) {
+      const auto &all = info._road_set.GetAll();
+      WriteCount(out, all.size());
+      for (const auto &item : all) {
+        WriteInfo(out, *item);
+      }
+    }
+
+    static InformationSet ReadInfoSet(
+        std::istream &in,
+        std::vector<RoadInfoSignal *> &signal_references) {
+      const auto count = ReadCount(in);
+      std::vector<std::unique_ptr<RoadInfo>> infos;
+      infos.reserve(count);
+      for (auto i = 0u; in && (i < count); ++i) {
+        auto info = ReadInfo(in, signal_references);
+        if (info == nullptr) {
+          break;
+        }
+        infos.emplace_back(std::move(info));
+      }
+      return InformationSet(std::move(infos));
+    }
+
+    static void WriteRoad(std::ostream &out, const Road &road) {
+      WriteValue(out, road._id);
+      WriteString(out, road._name);
+      WriteValue(out, road._length);
+      WriteValue(out, road._is_junction);
+      WriteValue(out, road._junction_id);
+      WriteValue(out, road._successor);
+      WriteValue(out, road._predecessor);
+      WriteInfoSet(out, road._info);
+      WriteCount(out, static_cast<size_t>(
+          std::distance(road._lane_sections.begin(), road._lane_sections.end())));
+      for (const auto &pair : road._lane_sections) {
+        const auto &section = pair.second;
+        WriteValue(out, section._id);
+        WriteValue(out, section._s);
+        WriteRecenteredPolynomial(out, section._lane_offset);
+        WriteValue(out, section._lane_offset.GetS());
+        WriteCount(out, section._lanes.size());
+        for (const auto &lane_pair : section._lanes) {
+          const auto &lane = lane_pair.second;
+          WriteValue(out, lane._id);
+          WriteValue(out, lane._type);
+          WriteValue(out, lane._level);
+          WriteValue(out, lane._successor);
+          WriteValue(out, lane._predecessor);
+          WriteInfoSet(out, lane._info);
+        }
+      }
+    }
+
+    static void ReadRoad(
+        std::istream &in,
+        MapData &data,
+        std::vector<RoadInfoSignal *> &signal_references) {
+      const auto id = ReadValue<RoadId>(in);
+      auto &road = data._roads[id];
+      road._map_data = &data;
+      road._id = id;
+      road._name = ReadString(in);
+      road._length = ReadValue<double>(in);
+      road._is_junction = ReadValue<bool>(in);
+      road._junction_id = ReadValue<JuncId>(in);
+      road._successor = ReadValue<RoadId>(in);
+      road._predecessor = ReadValue<RoadId>(in);
+      road._info = ReadInfoSet(in, signal_references);
+      const auto section_count = ReadCount(in);
+      road._lane_sections.Reserve(section_count);
+      for (auto i = 0u; in && (i < section_count); ++i) {
+        const auto section_id = ReadValue<SectionId>(in);
+        const auto s = ReadValue<double>(in);
+        auto &section = road._lane_sections.Emplace(section_id, s);
+        section._road = &road;
+        const auto a = ReadValue<double>(in);
+        const auto b = ReadValue<double>(in);
+        const auto c = ReadValue<double>(in);
+        const auto d = ReadValue<double>(in);
+        const auto offset_s = ReadValue<double>(in);
+        section._lane_offset.Set(a, b, c, d, offset_s);
+        const auto lane_count = ReadCount(in);
+        section._lanes.Reserve(lane_count);
+        for (auto j = 0u; in && (j < lane_count); ++j) {
+          const auto lane_id = ReadValue<LaneId>(in);
+          auto &lane = section._lanes.Emplace(lane_id)->second;
+          lane._lane_section = &section;
+          lane._id = lane_id;
+          lane._type = ReadValue<Lane::LaneType>(in);
+          lane._level = ReadValue<bool>(in);
+          lane._successor = ReadValue<LaneId>(in);
+          lane._predecessor = ReadValue<LaneId>(in);
+          lane._info = ReadInfoSet(in, signal_references);
+        }
+      }
+    }
+
+    static void WriteJunction(std::ostream &out, const Junction &junction) {
+      WriteValue(out, junction._id);
+      WriteString(out, junction._name);
+      WriteCount(out, junction._connections.size());
+      for (const auto &pair : junction._connections) {
+        const auto &connection = pair.second;
+        WriteValue(out, connection.id);
+        WriteValue(out, connection.incoming_road);
+        WriteValue(out, connection.connecting_road);
+        WriteCount(out, connection.lane_links.size());
+        for (const auto &link : connection.lane_links) {
+          WriteValue(out, link.from);
+          WriteValue(out, link.to);
+        }
+      }
+      WriteCount(out, junction._controllers.size());
+      for (const auto &controller : junction._controllers) {
+        WriteString(out, controller);
+      }
+      WriteCount(out, junction._road_conflicts.size());
+      for (const auto &pair : junction._road_conflicts) {
+        WriteValue(out, pair.first);
+        WriteCount(out, pair.second.size());
+        for (const auto conflict : pair.second) {
+          WriteValue(out, conflict);
+        }
+      }
+      WriteCount(out, junction._lane_conflicts.size());
+      for (const auto &conflict : junction._lane_conflicts) {
+        WriteValue(out, conflict.road_id);
+        WriteValue(out, conflict.lane_id);
+        WriteValue(out, conflict.s);
+        WriteValue(out, conflict.other_road_id);
+        WriteValue(out, conflict.other_lane_id);
+        WriteValue(out, conflict.other_s);
+      }
+      WriteLocation(out, junction._bounding_box.location);
+      WriteVector3D(out, junction._bounding_box.extent);
+    }
+
+    static void ReadJunction(std::istream &in, MapData &data) {
+      const auto id = ReadValue<JuncId>(in);
+      auto name = ReadString(in);
+      auto &junction = data._junctions.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(id),
+          std::forward_as_tuple(id, std::move(name))).first->second;
+      const auto connection_count = ReadCount(in);
+      for (auto i = 0u; in && (i < connection_count); ++i) {
+        const auto connection_id = ReadValue<ConId>(in);
+        const auto incoming_road = ReadValue<RoadId>(in);
+        const auto connecting_road = ReadValue<RoadId>(in);
+        auto &connection = junction._connections.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(connection_id),
+            std::forward_as_tuple(connection_id, incoming_road, connecting_road)).first->second;
+        const auto link_count = ReadCount(in);
+        for (auto j = 0u; in && (j < link_count); ++j) {
+          const auto from = ReadValue<LaneId>(in);
+          const auto to = ReadValue<LaneId>(in);
+          connection.AddLaneLink(from, to);
+        }
+      }
+      const auto controller_count = ReadCount(in);
+      for (auto i = 0u; in && (i < controller_count); ++i) {
+        junction._controllers.insert(ReadString(in));
+      }
+      const auto conflict_count = ReadCount(in);
+      for (auto i = 0u; in && (i < conflict_count); ++i) {
+        const auto road_id = ReadValue<RoadId>(in);
+        auto &conflicts = junction._road_conflicts[road_id];
+        const auto road_conflict_count = ReadCount(in);
+        for (auto j = 0u; in && (j < road_conflict_count); ++j) {
+          conflicts.insert(ReadValue<RoadId>(in));
+        }
+      }
+      const auto lane_conflict_count = ReadCount(in);
+      junction._lane_conflicts.reserve(lane_conflict_count);
+      for (auto i = 0u; in && (i < lane_conflict_count); ++i) {
+        Junction::LaneConflict conflict;
+        conflict.road_id = ReadValue<RoadId>(in);
+        conflict.lane_id = ReadValue<LaneId>(in);
+        conflict.s = ReadValue<double>(in);
+        conflict.other_road_id = ReadValue<RoadId>(in);
+        conflict.other_lane_id = ReadValue<LaneId>(in);
+        conflict.other_s = ReadValue<double>(in);
+        junction._lane_conflicts.emplace_back(conflict);
+      }
+      const auto location = ReadLocation(in);
+      const auto extent = ReadVector3D(in);
+      junction._bounding_box = geom::BoundingBox(location, extent);
+    }
+
+    static void WriteSignal(std::ostream &out, const Signal &signal) {
+      WriteValue(out, signal._road_id);
+      WriteString(out, signal._signal_id);
+      WriteValue(out, signal._s);
+      WriteValue(out, signal._t);
+      WriteString(out, signal._name);
+      WriteString(out, signal._dynamic);
+      WriteString(out, signal._orientation);
+      WriteValue(out, signal._zOffset);
+      WriteString(out, signal._country);
+      WriteString(out, signal._type);
+      WriteString(out, signal._subtype);
+      WriteValue(out, signal._value);
+      WriteString(out, signal._unit);
+      WriteValue(out, signal._height);
+      WriteValue(out, signal._width);
+      WriteString(out, signal._text);
+      WriteValue(out, signal._hOffset);
+      WriteValue(out, signal._pitch);
+      WriteValue(out, signal._roll);
+      WriteCount(out, signal._dependencies.size());
+      for (const auto &dependency : signal._dependencies) {
+        WriteString(out, dependency._dependency_id);
+        WriteString(out, dependency._type);
+      }
+      WriteTransform(out, signal._transform);
+      WriteCount(out, signal._controllers.size());
+      for (const auto &controller : signal._controllers) {
+        WriteString(out, controller);
+      }
+    }
+
+    static void ReadSignal(std::istream &in, MapData &data) {
+      const auto road_id = ReadValue<RoadId>(in);
+      auto signal_id = ReadString(in);
+      const auto s = ReadValue<double>(in);
+      const auto t = ReadValue<double>(in);
+      auto name = ReadString(in);
+      auto dynamic = ReadString(in);
+      auto orientation = ReadString(in);
+      const auto z_offset = ReadValue<double>(in);
+      auto country = ReadString(in);
+      auto type = ReadString(in);
+      auto subtype = ReadString(in);
+      const auto value = ReadValue<double>(in);
+      auto unit = ReadString(in);
+      const auto height = ReadValue<double>(in);
+      const auto width = ReadValue<double>(in);
+      auto text = ReadString(in);
+      const auto h_offset = ReadValue<double>(in);
+      const auto pitch = ReadValue<double>(in);
+      const auto roll = ReadValue<double>(in);
+      auto signal = std::make_unique<Signal>(
+          road_id, signal_id, s, t, std::move(name), std::move(dynamic),
+          std::move(orientation), z_offset, std::move(country), std::move(type),
+          std::move(subtype), value, std::move(unit), height, width,
+          std::move(text), h_offset, pitch, roll);
+      const auto dependency_count = ReadCount(in);
+      for (auto i = 0u; in && (i < dependency_count); ++i) {
+        auto dependency_id = ReadString(in);
+        auto dependency_type = ReadString(in);
+        signal->_dependencies.emplace_back(
+            std::move(dependency_id), std::move(dependency_type));
+      }
+      signal->_transform = ReadTransform(in);
+      const auto controller_count = ReadCount(in);
+      for (auto i = 0u; in && (i < controller_count); ++i) {
+        signal->_controllers.insert(ReadString(in));
+      }
+      data._signals.emplace(std::move(signal_id), std::move(signal));
+    }
+
+    static void WriteController(std::ostream &out, const Controller &controller) {
+      WriteString(out, controller._id);
+      WriteString(out, controller._name);
+      WriteValue(out, controller._sequence);
+      WriteCount(out, controller._junctions.size());
+      for (const auto &junction : controller._junctions) {
+        WriteValue(out, junction);
+      }
+      WriteCount(out, controller._signals.size());
+      for (const auto &signal : controller._signals) {
+        WriteString(out, signal);
+      }
+    }
+
+    static void ReadController(std::istream &in, MapData &data) {
+      auto id = ReadString(in);
+      auto name = ReadString(in);
+      const auto sequence = ReadValue<uint32_t>(in);
+      auto controller = std::make_unique<Controller>(id, std::move(name), sequence);
+      const auto junction_count = ReadCount(in);
+      for (auto i = 0u; in && (i < junction_count); ++i) {
+        controller->_junctions.insert(ReadValue<JuncId>(in));
+      }
+      const auto signal_count = ReadCount(in);
+      for (auto i = 0u; in && (i < signal_count); ++i) {
+        controller->_signals.insert(ReadString(in));
+      }
+      data._controllers.emplace(std::move(id), std::move(controller));
+    }
+  };
+
+  // ===========================================================================
+  // -- MapSerializer ----------------------------------------------------------
+  // ===========================================================================
+
+  uint64_t MapSerializer::Hash(const std::string &opendrive_contents) {
+    // FNV-1a, 64 bit.
+    uint64_t hash = 0xcbf29ce484222325u;
+    for (const auto character : opendrive_contents) {
+      hash ^= static_cast<unsigned char>(character);
+      hash *= 0x100000001b3u;
+    }
+    return hash;
+  }
+
+  void MapSerializer::Serialize(const Map &map, std::ostream &out, uint64_t content_hash) {
+    WriteValue(out, SERIALIZER_MAGIC);
+    WriteValue(out, SERIALIZER_VERSION);
+    WriteValue(out, content_hash);
+    const auto &data = map._data;
+    WriteValue(out, data._geo_reference.latitude);
+    WriteValue(out, data._geo_reference.longitude);
+    WriteValue(out, data._geo_reference.altitude);
+    WriteCount(out, data._roads.size());
+    for (const auto &pair : data._roads) {
+      Access::WriteRoad(out, pair.second);
+    }
+    WriteCount(out, data._junctions.size());
+    for (const auto &pair : data._junctions) {
+      Access::WriteJunction(out, pair.second);
+    }
+    WriteCount(out, data._signals.size());
+    for (const auto &pair : data._signals) {
+      Access::WriteSignal(out, *pair.second);
+    }
+    WriteCount(out, data._controllers.size());
+    for (const auto &pair : data._controllers) {
+      Access::WriteController(out, *pair.second);
+    }
+  }
+
+  boost::optional<Map> MapSerializer::Deserialize(std::istream &in, uint64_t expected_hash) {
+    if ((ReadValue<uint32_t>(in) != SERIALIZER_MAGIC) ||
+        (ReadValue<uint32_t>(in) != SERIALIZER_VERSION) ||
+        (ReadValue<uint64_t>(in) != expected_hash) ||
+        !in) {
+      return boost::none;
+    }
+
+    // The builder is only used as the owner of the MapData under construction
+    // so CreatePointersBetweenRoadSegments can relink the lane and road
+    // pointers the same way Build does.
+    MapBuilder builder;
+    MapData &data = builder._map_data;
+    std::vector<RoadInfoSignal *> signal_references;
+
+    data._geo_reference.latitude = ReadValue<double>(in);
+    data._geo_reference.longitude = ReadValue<double>(in);
+    data._geo_reference.altitude = ReadValue<double>(in);
+    const auto road_count = ReadCount(in);
+    builder.ReserveRoads(road_count);
+    for (auto i = 0u; in && (i < road_count); ++i) {
+      Access::ReadRoad(in, data, signal_references);
+    }
+    const auto junction_count = ReadCount(in);
+    for (auto i = 0u; in && (i < junction_count); ++i) {
+      Access::ReadJunction(in, data);
+    }
+    const auto signal_count = ReadCount(in);
+    for (auto i = 0u; in && (i < signal_count); ++i) {
+      Access::ReadSignal(in, data);
+    }
+    const auto controller_count = ReadCount(in);
+    for (auto i = 0u; in && (i < controller_count); ++i) {
+      Access::ReadController(in, data);
+    }
+    if (!in) {
+      return boost::none;
+    }
+
+    for (auto *signal_ref : signal_references) {
+      const auto it = data._signals.find(signal_ref->_signal_id);
+      if (it == data._signals.end()) {
+        return boost::none;
+      }
+      signal_ref->_signal = it->second.get();
+    }
+
+    builder.CreatePointersBetweenRoadSegments();
+    return Map(std::move(builder._map_data));
+  }
+
+} // namespace road
+} // namespace carla
@@ -0,0 +1,49 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/road/Map.h"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace carla {
+namespace road {
+
+  /// Versioned binary serialization of a fully built road::Map, used to cache
+  /// the result of parsing an OpenDRIVE file so subsequent clients of the same
+  /// map can skip the XML parse and the MapBuilder solve steps.
+  ///
+  /// The serialized data covers everything MapBuilder::Build() produces,
+  /// including signal transforms, junction bounding boxes, and junction road
+  /// conflicts. Derived acceleration structures (the waypoint R-tree and the
+  /// geometry splines) are recomputed on load.
+  class MapSerializer {
+  public:
+
+    /// FNV-1a hash of the OpenDRIVE contents, used to key the cache so a
+    /// stale file is never loaded for a different map.
+    static uint64_t Hash(const std::string &opendrive_contents);
+
+    /// Write @a map to @a out, stamped with @a content_hash.
+    static void Serialize(const Map &map, std::ostream &out, uint64_t content_hash);
+
+    /// Rebuild a map from @a in. Returns empty if the data was written by a
+    /// different library version, hashes to something other than
+    /// @a expected_hash, or is truncated.
+    static boost::optional<Map> Deserialize(std::istream &in, uint64_t expected_hash);
+
+  private:
+
+    class Access;
+  };
+
+} // namespace road
+} // namespace carla
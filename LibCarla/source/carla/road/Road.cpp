@@ -193,8 +193,9 @@ namespace road {
 
     // Apply road's elevation record
     const auto elevation_info = GetElevationOn(s);
-    p.location.z = static_cast<float>(elevation_info.Evaluate(s));
-    p.pitch = elevation_info.Tangent(s);
+    const auto elevation = elevation_info.EvaluateWithTangent(s);
+    p.location.z = static_cast<float>(elevation.first);
+    p.pitch = elevation.second;
 
     return p;
   }
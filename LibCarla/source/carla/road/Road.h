@@ -176,6 +176,7 @@ namespace road {
   private:
 
     friend MapBuilder;
+    friend class MapSerializer;
 
     MapData *_map_data { nullptr };
 
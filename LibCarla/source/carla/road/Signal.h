@@ -179,6 +179,7 @@ namespace road {
 
   private:
     friend MapBuilder;
+    friend class MapSerializer;
 
     RoadId _road_id;
 
@@ -66,7 +66,7 @@ namespace element {
     static_cast<float>(y * cos_a + x * sin_a));
   }
 
-  DirectedPoint GeometrySpiral::PosFromDist(double dist) const {
+  DirectedPoint GeometrySpiral::PosFromDistExact(double dist) const {
     dist = geom::Math::Clamp(dist, 0.0, _length);
     DEBUG_ASSERT(_length > 0.0);
     DirectedPoint p(_start_position, _heading);
@@ -99,6 +99,69 @@ namespace element {
     return p;
   }
 
+  void GeometrySpiral::PreComputeSamples() {
+    const double approx_delta_s = 0.5; // interval between samples [meters]
+    constexpr size_t max_samples = 4096u;
+    if (!(_length > 0.0)) {
+      return;
+    }
+    const size_t num_samples = std::min<size_t>(
+        static_cast<size_t>(std::ceil(_length / approx_delta_s)) + 1u,
+        max_samples);
+    if (num_samples < 2u) {
+      return;
+    }
+    _samples.reserve(num_samples);
+    const double delta_s = _length / static_cast<double>(num_samples - 1u);
+    for (size_t i = 0u; i < num_samples; ++i) {
+      const auto point = PosFromDistExact(static_cast<double>(i) * delta_s);
+      Sample sample;
+      sample.x = static_cast<double>(point.location.x);
+      sample.y = static_cast<double>(point.location.y);
+      sample.dx = std::cos(point.tangent);
+      sample.dy = std::sin(point.tangent);
+      _samples.emplace_back(sample);
+    }
+  }
+
+  DirectedPoint GeometrySpiral::PosFromDist(double dist) const {
+    dist = geom::Math::Clamp(dist, 0.0, _length);
+    DEBUG_ASSERT(_length > 0.0);
+    if (_samples.size() < 2u) {
+      return PosFromDistExact(dist);
+    }
+
+    const double delta_s = _length / static_cast<double>(_samples.size() - 1u);
+    const size_t index = std::min(
+        static_cast<size_t>(dist / delta_s),
+        _samples.size() - 2u);
+    const Sample &begin = _samples[index];
+    const Sample &end = _samples[index + 1u];
+
+    // Cubic Hermite interpolation between the two samples enclosing dist; the
+    // curve is arc-length parameterized, so the unit tangents are the exact
+    // position derivatives.
+    const double h = (dist - static_cast<double>(index) * delta_s) / delta_s;
+    const double h2 = h * h;
+    const double h3 = h2 * h;
+    const double c0 = 2.0 * h3 - 3.0 * h2 + 1.0;
+    const double c1 = h3 - 2.0 * h2 + h;
+    const double c2 = -2.0 * h3 + 3.0 * h2;
+    const double c3 = h3 - h2;
+
+    DirectedPoint p(_start_position, _heading);
+    p.location.x = static_cast<float>(
+        c0 * begin.x + c1 * delta_s * begin.dx + c2 * end.x + c3 * delta_s * end.dx);
+    p.location.y = static_cast<float>(
+        c0 * begin.y + c1 * delta_s * begin.dy + c2 * end.y + c3 * delta_s * end.dy);
+
+    // The tangent angle of a clothoid is exactly quadratic in arc length.
+    const double curve_dot = (_curve_end - _curve_start) / _length;
+    p.tangent = _heading + _curve_start * dist + 0.5 * curve_dot * dist * dist;
+
+    return p;
+  }
+
   /// @todo
   std::pair<float, float> GeometrySpiral::DistanceTo(const geom::Location &location) const {
     // Not analytic, discretize and find nearest point
@@ -107,8 +170,12 @@ namespace element {
   }
 
   DirectedPoint GeometryPoly3::PosFromDist(double dist) const {
-    auto result = _rtree.GetNearestNeighbours(
-        Rtree::BPoint(static_cast<float>(dist))).front();
+    // Single nearest segment, visited directly to avoid allocating a result
+    // vector on every waypoint query.
+    Rtree::TreeElement result;
+    _rtree.VisitNearestNeighbours(
+        Rtree::BPoint(static_cast<float>(dist)), 1u,
+        [&result](const Rtree::TreeElement &element) { result = element; });
 
     auto &val1 = result.second.first;
     auto &val2 = result.second.second;
@@ -136,22 +203,26 @@ namespace element {
     double current_s = 0;
     double current_u = 0;
     double last_u = 0;
-    double last_v = _poly.Evaluate(current_u);
+    const auto first_eval = _poly.EvaluateWithTangent(current_u);
+    double last_v = first_eval.first;
     double last_s = 0;
-    RtreeValue last_val{last_u, last_v, last_s, _poly.Tangent(current_u)};
+    RtreeValue last_val{last_u, last_v, last_s, first_eval.second};
+    std::vector<Rtree::TreeElement> rtree_elements;
     while (current_s < _length + delta_u) {
       current_u += delta_u;
-      double current_v = _poly.Evaluate(current_u);
+      const auto current_eval = _poly.EvaluateWithTangent(current_u);
+      double current_v = current_eval.first;
       double du = current_u - last_u;
       double dv = current_v - last_v;
       double ds = sqrt(du * du + dv * dv);
       current_s += ds;
-      double current_t = _poly.Tangent(current_u);
+      double current_t = current_eval.second;
       RtreeValue current_val{current_u, current_v, current_s, current_t};
 
       Rtree::BPoint p1(static_cast<float>(last_s));
       Rtree::BPoint p2(static_cast<float>(current_s));
-      _rtree.InsertElement(Rtree::BSegment(p1, p2), last_val, current_val);
+      rtree_elements.emplace_back(
+          Rtree::BSegment(p1, p2), std::make_pair(last_val, current_val));
 
       last_u = current_u;
       last_v = current_v;
@@ -159,11 +230,16 @@ namespace element {
       last_val = current_val;
 
     }
+    _rtree.BulkLoad(rtree_elements);
   }
 
   DirectedPoint GeometryParamPoly3::PosFromDist(double dist) const {
-    auto result = _rtree.GetNearestNeighbours(
-        Rtree::BPoint(static_cast<float>(dist))).front();
+    // Single nearest segment, visited directly to avoid allocating a result
+    // vector on every waypoint query.
+    Rtree::TreeElement result;
+    _rtree.VisitNearestNeighbours(
+        Rtree::BPoint(static_cast<float>(dist)), 1u,
+        [&result](const Rtree::TreeElement &element) { result = element; });
 
     auto &val1 = result.second.first;
     auto &val2 = result.second.second;
@@ -194,25 +270,31 @@ namespace element {
     }
     double param_p = 0;
     double current_s = 0;
-    double last_u = _polyU.Evaluate(param_p);
-    double last_v = _polyV.Evaluate(param_p);
+    const auto first_u = _polyU.EvaluateWithTangent(param_p);
+    const auto first_v = _polyV.EvaluateWithTangent(param_p);
+    double last_u = first_u.first;
+    double last_v = first_v.first;
     double last_s = 0;
     RtreeValue last_val{
         last_u,
         last_v,
         last_s,
-        _polyU.Tangent(param_p),
-        _polyV.Tangent(param_p) };
+        first_u.second,
+        first_v.second };
+    std::vector<Rtree::TreeElement> rtree_elements;
+    rtree_elements.reserve(number_intervals);
     for(size_t i = 0; i < number_intervals; ++i) {
       param_p += delta_p;
-      double current_u = _polyU.Evaluate(param_p);
-      double current_v = _polyV.Evaluate(param_p);
+      const auto eval_u = _polyU.EvaluateWithTangent(param_p);
+      const auto eval_v = _polyV.EvaluateWithTangent(param_p);
+      double current_u = eval_u.first;
+      double current_v = eval_v.first;
       double du = current_u - last_u;
       double dv = current_v - last_v;
       double ds = sqrt(du * du + dv * dv);
       current_s += ds;
-      double current_t_u = _polyU.Tangent(param_p);
-      double current_t_v = _polyV.Tangent(param_p);
+      double current_t_u = eval_u.second;
+      double current_t_v = eval_v.second;
       RtreeValue current_val{
           current_u,
           current_v,
@@ -222,7 +304,8 @@ namespace element {
 
       Rtree::BPoint p1(static_cast<float>(last_s));
       Rtree::BPoint p2(static_cast<float>(current_s));
-      _rtree.InsertElement(Rtree::BSegment(p1, p2), last_val, current_val);
+      rtree_elements.emplace_back(
+          Rtree::BSegment(p1, p2), std::make_pair(last_val, current_val));
 
       last_u = current_u;
       last_v = current_v;
@@ -233,6 +316,7 @@ namespace element {
         break;
       }
     }
+    _rtree.BulkLoad(rtree_elements);
   }
 } // namespace element
 } // namespace road
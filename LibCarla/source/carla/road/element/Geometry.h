@@ -62,7 +62,7 @@ namespace element {
       return _heading;
     }
 
-    const geom::Location &GetStartPosition() {
+    const geom::Location &GetStartPosition() const {
       return _start_position;
     }
 
@@ -173,13 +173,15 @@ namespace element {
         double curv_e)
       : Geometry(GeometryType::SPIRAL, start_offset, length, heading, start_pos),
         _curve_start(curv_s),
-        _curve_end(curv_e) {}
+        _curve_end(curv_e) {
+      PreComputeSamples();
+    }
 
-    double GetCurveStart() {
+    double GetCurveStart() const {
       return _curve_start;
     }
 
-    double GetCurveEnd() {
+    double GetCurveEnd() const {
       return _curve_end;
     }
 
@@ -189,8 +191,25 @@ namespace element {
 
   private:
 
+    /// Evaluate the clothoid through the Fresnel integrals of odrSpiral.
+    DirectedPoint PosFromDistExact(double dist) const;
+
+    void PreComputeSamples();
+
     double _curve_start;
     double _curve_end;
+
+    /// Position and unit tangent of the clothoid sampled uniformly in arc
+    /// length, interpolated with a cubic Hermite at query time so PosFromDist
+    /// does not hit the Fresnel integrals on every call. Empty tables fall
+    /// back to exact evaluation.
+    struct Sample {
+      double x = 0.0;
+      double y = 0.0;
+      double dx = 0.0;
+      double dy = 0.0;
+    };
+    std::vector<Sample> _samples;
   };
 
   class GeometryPoly3 final : public Geometry {
@@ -309,6 +328,10 @@ namespace element {
       return _dV;
     }
 
+    bool IsArcLength() const {
+      return _arcLength;
+    }
+
     DirectedPoint PosFromDist(double dist) const override;
 
     std::pair<float, float> DistanceTo(const geom::Location &) const override;
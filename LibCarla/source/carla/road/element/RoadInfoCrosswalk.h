@@ -51,6 +51,7 @@ namespace element {
     }
 
     double GetS() const { return GetDistance(); };
+    const std::string &GetName() const { return _name; };
     double GetT() const { return _t; };
     double GetWidth() const { return _width; };
     double GetLength() const { return _length; };
@@ -31,8 +31,9 @@ namespace element {
 
     /// @todo unused? you can use the polynomial directly.
     double Evaluate(const double dist, double &out_tan) const {
-      out_tan = _elevation.Tangent(dist);
-      return _elevation.Evaluate(dist);
+      const auto evaluation = _elevation.EvaluateWithTangent(dist);
+      out_tan = evaluation.second;
+      return evaluation.first;
     }
 
     const geom::CubicPolynomial &GetPolynomial() const {
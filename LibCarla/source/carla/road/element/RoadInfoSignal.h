@@ -11,6 +11,9 @@
 
 namespace carla {
 namespace road {
+
+  class MapSerializer;
+
 namespace element {
 
   class RoadInfoSignal final : public RoadInfo {
@@ -88,6 +91,7 @@ namespace element {
 
   private:
     friend MapBuilder;
+    friend MapSerializer;
 
     SignId _signal_id;
 
@@ -0,0 +1,72 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+#include "carla/geom/Transform.h"
+#include "carla/geom/Vector3D.h"
+#include "carla/rpc/ActorId.h"
+#include "carla/rpc/VehicleLightState.h"
+
+namespace carla {
+namespace rpc {
+
+  /// One externally-driven actor's update within a co-simulation step, the
+  /// ingest half of the exchange_actor_states RPC. The light state is only
+  /// applied when @a has_light_state is set.
+  class ActorTransformUpdate {
+  public:
+
+    ActorTransformUpdate() = default;
+
+    ActorTransformUpdate(ActorId id, const geom::Transform &in_transform)
+      : actor(id),
+        transform(in_transform) {}
+
+    ActorTransformUpdate(
+        ActorId id,
+        const geom::Transform &in_transform,
+        VehicleLightState::flag_type in_light_state)
+      : actor(id),
+        transform(in_transform),
+        has_light_state(true),
+        light_state(in_light_state) {}
+
+    ActorId actor = 0u;
+
+    geom::Transform transform;
+
+    bool has_light_state = false;
+
+    VehicleLightState::flag_type light_state = 0u;
+
+    MSGPACK_DEFINE_ARRAY(actor, transform, has_light_state, light_state);
+  };
+
+  /// State of one CARLA-side actor as returned by exchange_actor_states,
+  /// the read-back half of a co-simulation step. Queried actors that no
+  /// longer exist are simply absent from the response.
+  class ActorSyncState {
+  public:
+
+    ActorSyncState() = default;
+
+    ActorId actor = 0u;
+
+    geom::Transform transform;
+
+    /// Velocity in m/s.
+    geom::Vector3D velocity;
+
+    /// Zero for actors that are not vehicles.
+    VehicleLightState::flag_type light_state = 0u;
+
+    MSGPACK_DEFINE_ARRAY(actor, transform, velocity, light_state);
+  };
+
+} // namespace rpc
+} // namespace carla
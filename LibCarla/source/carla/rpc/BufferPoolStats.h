@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/BufferPool.h"
+#include "carla/MsgPack.h"
+
+#include <cstdint>
+#include <string>
+
+namespace carla {
+namespace rpc {
+
+  /// Allocation counters of one buffer pool, queryable at runtime through
+  /// the get_buffer_pool_stats RPC; one entry per live pool of the server
+  /// process.
+  class BufferPoolStats {
+  public:
+
+    BufferPoolStats() = default;
+
+    BufferPoolStats(const BufferPool::Stats &stats)
+      : name(stats.name),
+        hits(stats.hits),
+        misses(stats.misses),
+        discards(stats.discards),
+        retained_count(stats.retained_count),
+        retained_bytes(stats.retained_bytes),
+        peak_retained_bytes(stats.peak_retained_bytes) {}
+
+    /// Identifies the pool's owner, e.g. the stream it belongs to.
+    std::string name;
+
+    /// Pops served from the pool.
+    uint64_t hits = 0u;
+
+    /// Pops that had to hand out a fresh, unpooled buffer.
+    uint64_t misses = 0u;
+
+    /// Pooled buffers whose memory was released by trimming or destruction.
+    uint64_t discards = 0u;
+
+    /// Buffers currently retained.
+    uint64_t retained_count = 0u;
+
+    /// Bytes currently retained.
+    uint64_t retained_bytes = 0u;
+
+    /// Most bytes ever retained at once.
+    uint64_t peak_retained_bytes = 0u;
+
+    MSGPACK_DEFINE_ARRAY(
+        name,
+        hits,
+        misses,
+        discards,
+        retained_count,
+        retained_bytes,
+        peak_retained_bytes);
+  };
+
+} // namespace rpc
+} // namespace carla
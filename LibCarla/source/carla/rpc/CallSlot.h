@@ -0,0 +1,204 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+
+#if defined(__clang__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wold-style-cast"
+#endif
+#include "moodycamel/ConcurrentQueue.h"
+#if defined(__clang__)
+#  pragma clang diagnostic pop
+#endif
+
+#include <boost/optional.hpp>
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace carla {
+namespace rpc {
+namespace detail {
+
+  /// Shared machinery of CallSlot, see below.
+  class CallSlotBase : private NonCopyable {
+  public:
+
+    /// Mark the call as never going to run, e.g. because its task was
+    /// discarded at shutdown without being executed; wakes up the waiter with
+    /// an error instead of blocking it forever. Does nothing if the call
+    /// already completed.
+    void Abandon() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_done) {
+        return;
+      }
+      _exception = std::make_exception_ptr(
+          std::runtime_error("synchronous call abandoned before running"));
+      _done = true;
+      _cv.notify_one();
+    }
+
+  protected:
+
+    std::mutex _mutex;
+
+    std::condition_variable _cv;
+
+    bool _done = false;
+
+    std::exception_ptr _exception;
+  };
+
+  /// Completion slot of one in-flight synchronous call: the worker thread
+  /// that received the call waits on the slot while another thread runs the
+  /// handler and publishes its result (or exception) into it.
+  ///
+  /// Slots are recycled through a CallSlotPool, following the pattern
+  /// BufferPool establishes for sensor buffers, so the shared-state
+  /// allocations of a fresh promise/future pair are paid once instead of on
+  /// every call.
+  template <typename R>
+  class CallSlot : public CallSlotBase {
+  public:
+
+    template <typename FunctorT, typename... Args>
+    void Execute(const FunctorT &functor, const Args &... args) {
+      try {
+        auto result = functor(args...);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _result = std::move(result);
+        _done = true;
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _exception = std::current_exception();
+        _done = true;
+      }
+      _cv.notify_one();
+    }
+
+    /// Block until the call completes, then return its result or rethrow its
+    /// exception. Call at most once per call.
+    R Wait() {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait(lock, [this]() { return _done; });
+      if (_exception != nullptr) {
+        std::rethrow_exception(_exception);
+      }
+      return std::move(*_result);
+    }
+
+    void Reset() {
+      _done = false;
+      _result = boost::none;
+      _exception = nullptr;
+    }
+
+  private:
+
+    boost::optional<R> _result;
+  };
+
+  template <>
+  class CallSlot<void> : public CallSlotBase {
+  public:
+
+    template <typename FunctorT, typename... Args>
+    void Execute(const FunctorT &functor, const Args &... args) {
+      try {
+        functor(args...);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _done = true;
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _exception = std::current_exception();
+        _done = true;
+      }
+      _cv.notify_one();
+    }
+
+    void Wait() {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait(lock, [this]() { return _done; });
+      if (_exception != nullptr) {
+        std::rethrow_exception(_exception);
+      }
+    }
+
+    void Reset() {
+      _done = false;
+      _exception = nullptr;
+    }
+  };
+
+  /// Owns a CallSlot reference from the moment its task is posted until the
+  /// task is destroyed; abandoning the slot on destruction guarantees the
+  /// waiter wakes up even if the task is discarded without running.
+  template <typename R>
+  class CompletionGuard : private MovableNonCopyable {
+  public:
+
+    explicit CompletionGuard(std::shared_ptr<CallSlot<R>> slot)
+      : _slot(std::move(slot)) {}
+
+    CompletionGuard(CompletionGuard &&) = default;
+
+    ~CompletionGuard() {
+      if (_slot != nullptr) {
+        _slot->Abandon();
+      }
+    }
+
+    CallSlot<R> *operator->() const {
+      return _slot.get();
+    }
+
+  private:
+
+    std::shared_ptr<CallSlot<R>> _slot;
+  };
+
+  /// A pool of CallSlot. Slots popped from this pool automatically return to
+  /// the pool once both the waiter and the task released them.
+  template <typename R>
+  class CallSlotPool
+    : public std::enable_shared_from_this<CallSlotPool<R>>,
+      private NonCopyable {
+  public:
+
+    using SlotPtr = std::shared_ptr<CallSlot<R>>;
+
+    /// Pop a recycled slot, allocating a fresh one while the pool warms up.
+    SlotPtr Pop() {
+      std::unique_ptr<CallSlot<R>> slot;
+      if (!_slots.try_dequeue(slot)) {
+        slot.reset(new CallSlot<R>());
+      }
+      slot->Reset();
+      std::weak_ptr<CallSlotPool> weak = this->shared_from_this();
+      return SlotPtr(slot.release(), [weak](CallSlot<R> *raw) {
+        std::unique_ptr<CallSlot<R>> owned(raw);
+        auto self = weak.lock();
+        if (self != nullptr) {
+          self->_slots.enqueue(std::move(owned));
+        }
+      });
+    }
+
+  private:
+
+    moodycamel::ConcurrentQueue<std::unique_ptr<CallSlot<R>>> _slots;
+  };
+
+} // namespace detail
+} // namespace rpc
+} // namespace carla
@@ -38,6 +38,13 @@ namespace rpc {
       _client.async_call(function, Metadata::MakeAsync(), std::forward<Args>(args)...);
     }
 
+    /// Like call, but returns a future with the response instead of blocking,
+    /// so several calls can be kept in flight on the same connection.
+    template <typename... Args>
+    auto async_call_with_response(const std::string &function, Args &&... args) {
+      return _client.async_call(function, Metadata::MakeSync(), std::forward<Args>(args)...);
+    }
+
   private:
 
     ::rpc::client _client;
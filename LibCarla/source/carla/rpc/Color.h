@@ -32,6 +32,14 @@ namespace rpc {
 
     Color &operator=(const Color &) = default;
 
+    bool operator==(const Color &rhs) const {
+      return (r == rhs.r) && (g == rhs.g) && (b == rhs.b);
+    }
+
+    bool operator!=(const Color &rhs) const {
+      return !(*this == rhs);
+    }
+
 #ifdef LIBCARLA_INCLUDED_FROM_UE4
 
     Color(const FColor &color)
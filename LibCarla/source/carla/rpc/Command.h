@@ -11,7 +11,9 @@
 #include "carla/geom/Transform.h"
 #include "carla/rpc/ActorDescription.h"
 #include "carla/rpc/ActorId.h"
+#include "carla/rpc/DebugShape.h"
 #include "carla/rpc/VehicleControl.h"
+#include "carla/rpc/WalkerBoneControl.h"
 #include "carla/rpc/WalkerControl.h"
 
 #include <boost/variant.hpp>
@@ -168,6 +170,39 @@ namespace rpc {
       MSGPACK_DEFINE_ARRAY(actor, enabled);
     };
 
+    /// Draw a whole batch of debug shapes with a single command instead of
+    /// one round trip per shape.
+    struct DrawDebugShapes : CommandBase<DrawDebugShapes> {
+      DrawDebugShapes() = default;
+      DrawDebugShapes(std::vector<DebugShape> shapes)
+        : shapes(std::move(shapes)) {}
+      std::vector<DebugShape> shapes;
+      MSGPACK_DEFINE_ARRAY(shapes);
+    };
+
+    /// Update a whole crowd of walkers with a single command instead of one
+    /// per walker. The bone control of an entry is applied only when it
+    /// carries bone transforms; updates referencing dead walkers are skipped.
+    struct ApplyWalkerBatch : CommandBase<ApplyWalkerBatch> {
+      struct WalkerUpdate {
+        WalkerUpdate() = default;
+        WalkerUpdate(ActorId id, const geom::Transform &transform, float speed)
+          : walker(id),
+            transform(transform),
+            speed(speed) {}
+        ActorId walker = 0u;
+        geom::Transform transform;
+        float speed = 0.0f;
+        WalkerBoneControl bones;
+        MSGPACK_DEFINE_ARRAY(walker, transform, speed, bones);
+      };
+      ApplyWalkerBatch() = default;
+      ApplyWalkerBatch(std::vector<WalkerUpdate> updates)
+        : updates(std::move(updates)) {}
+      std::vector<WalkerUpdate> updates;
+      MSGPACK_DEFINE_ARRAY(updates);
+    };
+
     using CommandType = boost::variant<
         SpawnActor,
         DestroyActor,
@@ -180,7 +215,36 @@ namespace rpc {
         ApplyImpulse,
         ApplyAngularImpulse,
         SetSimulatePhysics,
-        SetAutopilot>;
+        SetAutopilot,
+        DrawDebugShapes,
+        ApplyWalkerBatch>;
+
+    /// @name Intra-batch references
+    ///
+    /// A command may use the actor spawned by an earlier command of the same
+    /// batch: pass FromBatchIndex(i) wherever an ActorId is expected (the
+    /// actor field or a SpawnActor parent) and the server substitutes the
+    /// result id of command @a i before dispatching. This makes dependent
+    /// sequences like spawn-attach-configure a single round trip. References
+    /// to later or failed commands are left unresolved, so the referencing
+    /// command fails with an actor-not-found error.
+    /// @{
+
+    static constexpr ActorId BatchIndexTag = 0x80000000u;
+
+    static ActorId FromBatchIndex(size_t index) {
+      return BatchIndexTag | static_cast<ActorId>(index);
+    }
+
+    static bool IsBatchIndex(ActorId id) {
+      return (id & BatchIndexTag) != 0u;
+    }
+
+    static size_t GetBatchIndex(ActorId id) {
+      return static_cast<size_t>(id & ~BatchIndexTag);
+    }
+
+    /// @}
 
     CommandType command;
 
@@ -0,0 +1,94 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/Exception.h"
+#include "carla/MsgPack.h"
+#include "carla/rpc/Command.h"
+
+#include <memory>
+
+namespace carla {
+namespace rpc {
+
+  /// A batch of commands still in msgpack form, decoded one command at a
+  /// time on demand instead of being materialized as a
+  /// std::vector<Command> up front.
+  ///
+  /// On the wire this is the same msgpack array std::vector<Command>
+  /// serializes to, so senders are unaffected; a server handler taking a
+  /// CommandBatch only pays for copying the raw msgpack tree into an owned
+  /// zone (no strings, vectors, or variants are built), and the receiver
+  /// decodes each command straight into reusable storage right before
+  /// applying it, see DecodeInto.
+  class CommandBatch {
+  public:
+
+    CommandBatch() = default;
+
+    explicit CommandBatch(std::shared_ptr<clmdep_msgpack::object_handle> handle)
+      : _handle(std::move(handle)) {}
+
+    /// Number of commands in the batch.
+    size_t size() const {
+      return _handle != nullptr ? _handle->get().via.array.size : 0u;
+    }
+
+    bool empty() const {
+      return size() == 0u;
+    }
+
+    /// Decode the command at @a index into @a command, reusing whatever
+    /// storage it already holds.
+    ///
+    /// @pre index < size().
+    void DecodeInto(size_t index, Command &command) const {
+      DEBUG_ASSERT(index < size());
+      _handle->get().via.array.ptr[index].convert(command);
+    }
+
+  private:
+
+    /// Owns the copied msgpack tree and its zone, so the batch stays valid
+    /// after the rpc call that delivered it returns.
+    std::shared_ptr<clmdep_msgpack::object_handle> _handle;
+  };
+
+} // namespace rpc
+} // namespace carla
+
+namespace clmdep_msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+  // ===========================================================================
+  // -- Adaptor for carla::rpc::CommandBatch -----------------------------------
+  // ===========================================================================
+
+  template <>
+  struct convert<carla::rpc::CommandBatch> {
+    const clmdep_msgpack::object &operator()(
+        const clmdep_msgpack::object &o,
+        carla::rpc::CommandBatch &v) const {
+      if (o.type != clmdep_msgpack::type::ARRAY) {
+        ::carla::throw_exception(clmdep_msgpack::type_error());
+      }
+      // Copy the raw object tree into a zone of its own; the original is
+      // only guaranteed to live for the duration of the rpc dispatch.
+      auto zone = clmdep_msgpack::unique_ptr<clmdep_msgpack::zone>(
+          new clmdep_msgpack::zone());
+      clmdep_msgpack::object copy(o, *zone);
+      v = carla::rpc::CommandBatch(
+          std::make_shared<clmdep_msgpack::object_handle>(copy, std::move(zone)));
+      return o;
+    }
+  };
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE
+} // namespace clmdep_msgpack
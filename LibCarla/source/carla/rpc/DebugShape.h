@@ -24,6 +24,9 @@ namespace rpc {
     struct Point {
       geom::Location location;
       float size;
+      bool operator==(const Point &rhs) const {
+        return (location == rhs.location) && (size == rhs.size);
+      }
       MSGPACK_DEFINE_ARRAY(location, size);
     };
 
@@ -31,12 +34,18 @@ namespace rpc {
       geom::Location begin;
       geom::Location end;
       float thickness;
+      bool operator==(const Line &rhs) const {
+        return (begin == rhs.begin) && (end == rhs.end) && (thickness == rhs.thickness);
+      }
       MSGPACK_DEFINE_ARRAY(begin, end, thickness);
     };
 
     struct Arrow {
       Line line;
       float arrow_size;
+      bool operator==(const Arrow &rhs) const {
+        return (line == rhs.line) && (arrow_size == rhs.arrow_size);
+      }
       MSGPACK_DEFINE_ARRAY(line, arrow_size);
     };
 
@@ -44,6 +53,9 @@ namespace rpc {
       geom::BoundingBox box;
       geom::Rotation rotation;
       float thickness;
+      bool operator==(const Box &rhs) const {
+        return (box == rhs.box) && (rotation == rhs.rotation) && (thickness == rhs.thickness);
+      }
       MSGPACK_DEFINE_ARRAY(box, rotation, thickness);
     };
 
@@ -51,6 +63,9 @@ namespace rpc {
       geom::Location location;
       std::string text;
       bool draw_shadow;
+      bool operator==(const String &rhs) const {
+        return (location == rhs.location) && (text == rhs.text) && (draw_shadow == rhs.draw_shadow);
+      }
       MSGPACK_DEFINE_ARRAY(location, text, draw_shadow);
     };
 
@@ -62,6 +77,13 @@ namespace rpc {
 
     bool persistent_lines = true;
 
+    bool operator==(const DebugShape &rhs) const {
+      return (primitive == rhs.primitive) &&
+             (color == rhs.color) &&
+             (life_time == rhs.life_time) &&
+             (persistent_lines == rhs.persistent_lines);
+    }
+
     MSGPACK_DEFINE_ARRAY(primitive, color, life_time, persistent_lines);
   };
 
@@ -25,7 +25,13 @@ namespace rpc {
 
     streaming::Token token;
 
-    MSGPACK_DEFINE_ARRAY(id, token);
+    /// Slot of this episode on a host running several episodes, and the
+    /// namespace its stream ids are allocated under, see
+    /// streaming::detail::Dispatcher::SetStreamIdNamespace. Zero on
+    /// single-episode hosts.
+    uint8_t episode_slot = 0u;
+
+    MSGPACK_DEFINE_ARRAY(id, token, episode_slot);
   };
 
 } // namespace rpc
@@ -0,0 +1,52 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+#include "carla/rpc/ActorId.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace rpc {
+
+  /// Filtered view of the episode state stream negotiated by a client.
+  ///
+  /// The server keeps broadcasting the full stream to regular subscribers; a
+  /// client sending a filter gets its own stream carrying only the actors it
+  /// asked for, at a fraction of the simulation rate. An actor is included
+  /// when its id is in @a actor_ids, or when it is within @a radius meters of
+  /// @a reference_actor; an empty filter only divides the rate.
+  class EpisodeStreamFilter {
+  public:
+
+    /// Ids of the actors the client is always interested in.
+    std::vector<ActorId> actor_ids;
+
+    /// Also include every actor within @a radius of this one, zero disables
+    /// the spatial filter. The reference actor itself is always included.
+    ActorId reference_actor = 0u;
+
+    /// Radius in meters around @a reference_actor.
+    float radius = 0.0f;
+
+    /// Send every n-th simulation tick, e.g. 12 turns a 60Hz simulation into
+    /// a 5Hz stream. Zero behaves as one.
+    uint32_t rate_divisor = 1u;
+
+    /// Whether any actor selection is active, as opposed to only dividing
+    /// the rate.
+    bool IsSelective() const {
+      return !actor_ids.empty() || (reference_actor != 0u);
+    }
+
+    MSGPACK_DEFINE_ARRAY(actor_ids, reference_actor, radius, rate_divisor);
+  };
+
+} // namespace rpc
+} // namespace carla
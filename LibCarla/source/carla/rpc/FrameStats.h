@@ -0,0 +1,62 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace rpc {
+
+  /// Timing of one section of the server's frame loop, in milliseconds.
+  /// Percentiles are rolling, computed over the most recent frames.
+  class FrameSectionStats {
+  public:
+
+    FrameSectionStats() = default;
+
+    std::string name;
+
+    double last_ms = 0.0;
+
+    double mean_ms = 0.0;
+
+    double p50_ms = 0.0;
+
+    double p90_ms = 0.0;
+
+    double p99_ms = 0.0;
+
+    MSGPACK_DEFINE_ARRAY(name, last_ms, mean_ms, p50_ms, p90_ms, p99_ms);
+  };
+
+  /// Breakdown of the server's frame time among the stages of its main
+  /// loop, queryable at runtime through the get_frame_stats RPC. Section
+  /// names are stable identifiers, e.g. "frame_total", "world_tick",
+  /// "rpc_drain"; the sections other than "frame_total" overlap with it,
+  /// not with each other.
+  class FrameStats {
+  public:
+
+    FrameStats() = default;
+
+    /// Frames recorded since the server started.
+    uint64_t frame_count = 0u;
+
+    /// Number of recent frames the rolling statistics cover.
+    uint64_t window_size = 0u;
+
+    std::vector<FrameSectionStats> sections;
+
+    MSGPACK_DEFINE_ARRAY(frame_count, window_size, sections);
+  };
+
+} // namespace rpc
+} // namespace carla
@@ -53,5 +53,36 @@ public:
 
 };
 
+/// Update of a single light carrying only the fields that changed.
+///
+/// Only the fields flagged in @a _fields are meaningful, the server keeps the
+/// previous value of the rest. The location never travels, it is fixed per
+/// light.
+class LightStateDelta {
+public:
+
+  using flag_type = LightState::flag_type;
+
+  enum Field : flag_type {
+    IntensityField = 0x01,
+    ColorField     = 0x02,
+    GroupField     = 0x04,
+    ActiveField    = 0x08,
+    AllFields      = 0x0F
+  };
+
+  LightStateDelta() {}
+
+  LightId _id = 0u;
+  flag_type _fields = 0u;
+  float _intensity = 0.0f;
+  flag_type _group = static_cast<flag_type>(LightState::LightGroup::None);
+  Color _color;
+  bool _active = false;
+
+  MSGPACK_DEFINE_ARRAY(_id, _fields, _intensity, _group, _color, _active);
+
+};
+
 } // namespace rpc
 } // namespace carla
@@ -24,7 +24,17 @@ namespace rpc {
 
     std::vector<geom::Transform> recommended_spawn_points;
 
-    MSGPACK_DEFINE_ARRAY(name, open_drive_file, recommended_spawn_points);
+    /// Size in bytes of the OpenDRIVE file when the server delivers it in
+    /// chunks instead of inlining it in @a open_drive_file; see the
+    /// get_map_data_chunk RPC function.
+    uint64_t open_drive_size = 0u;
+
+    /// FNV-1a hash of the OpenDRIVE contents (see road::MapSerializer::Hash),
+    /// so a client holding a cached copy can skip the download entirely.
+    /// Zero when the server does not provide it.
+    uint64_t open_drive_hash = 0u;
+
+    MSGPACK_DEFINE_ARRAY(name, open_drive_file, recommended_spawn_points, open_drive_size, open_drive_hash);
   };
 
 } // namespace rpc
@@ -0,0 +1,54 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace rpc {
+
+  /// Lifetime counters of one profiled object type, see
+  /// profiler::LifetimeCensus.
+  class ObjectCounter {
+  public:
+
+    std::string type_name;
+
+    /// Objects of this type currently alive.
+    uint64_t live = 0u;
+
+    /// Highest number of simultaneously alive objects seen so far.
+    uint64_t peak = 0u;
+
+    /// Objects created since the process started.
+    uint64_t total = 0u;
+
+    MSGPACK_DEFINE_ARRAY(type_name, live, peak, total);
+  };
+
+  /// Census of the server's profiled objects plus the memory retained by the
+  /// buffer pools, see the get_object_census RPC function.
+  class ObjectCensus {
+  public:
+
+    std::vector<ObjectCounter> counters;
+
+    /// Buffers currently sitting in the pools waiting for reuse.
+    uint64_t pooled_buffer_count = 0u;
+
+    /// Bytes retained by those buffers.
+    uint64_t pooled_buffer_bytes = 0u;
+
+    MSGPACK_DEFINE_ARRAY(counters, pooled_buffer_count, pooled_buffer_bytes);
+  };
+
+} // namespace rpc
+} // namespace carla
@@ -8,6 +8,7 @@
 
 #include "carla/MoveHandler.h"
 #include "carla/Time.h"
+#include "carla/rpc/CallSlot.h"
 #include "carla/rpc/Metadata.h"
 #include "carla/rpc/Response.h"
 
@@ -15,7 +16,7 @@
 
 #include <rpc/server.h>
 
-#include <future>
+#include <memory>
 
 namespace carla {
 namespace rpc {
@@ -32,7 +33,10 @@ namespace rpc {
   ///
   /// Functions that are bind using `BindAsync` will run asynchronously in the
   /// worker threads. Functions that are bind using `BindSync` will run within
-  /// `SyncRunFor` function.
+  /// `SyncRunFor` function. Functions that are bind using `BindRead` also run
+  /// in the worker threads, concurrently with each other and with the game
+  /// thread; they must be read-only and access only data that is immutable or
+  /// published atomically, e.g. a per-frame snapshot.
   class Server {
   public:
 
@@ -45,6 +49,9 @@ namespace rpc {
     template <typename FunctorT>
     void BindAsync(const std::string &name, FunctorT &&functor);
 
+    template <typename FunctorT>
+    void BindRead(const std::string &name, FunctorT &&functor);
+
     void AsyncRun(size_t worker_threads) {
       _server.async_run(worker_threads);
     }
@@ -101,19 +108,22 @@ namespace detail {
     /// game thread).
     template <typename FuncT>
     static auto WrapSyncCall(boost::asio::io_context &io, FuncT &&functor) {
-      return [&io, functor=std::forward<FuncT>(functor)](Metadata metadata, Args... args) -> R {
-        auto task = std::packaged_task<R()>([functor=std::move(functor), args...]() {
-          return functor(args...);
-        });
+      auto pool = std::make_shared<CallSlotPool<R>>();
+      return [&io, pool, functor=std::forward<FuncT>(functor)](Metadata metadata, Args... args) -> R {
         if (metadata.IsResponseIgnored()) {
-          // Post task and ignore result.
-          io.post(MoveHandler(task));
+          // Post the task and ignore the result, no completion slot needed.
+          io.post([&functor, args...]() { functor(args...); });
           return R();
         } else {
-          // Post task and wait for result.
-          auto result = task.get_future();
-          io.post(MoveHandler(task));
-          return result.get();
+          // Post the task and wait for the result on a recycled completion
+          // slot; CompletionGuard wakes us up with an error if the task is
+          // dropped without running, e.g. at shutdown.
+          auto slot = pool->Pop();
+          io.post(MoveHandler(
+              [guard = CompletionGuard<R>(slot), &functor, args...]() {
+                guard->Execute(functor, args...);
+              }));
+          return slot->Wait();
         }
       };
     }
@@ -158,5 +168,12 @@ namespace detail {
         Wrapper::WrapAsyncCall(std::forward<FunctorT>(functor)));
   }
 
+  template <typename FunctorT>
+  inline void Server::BindRead(const std::string &name, FunctorT &&functor) {
+    // Read-only handlers never touch the game thread, dispatching them is the
+    // same as an asynchronous call; the classification lives at the bind site.
+    BindAsync(name, std::forward<FunctorT>(functor));
+  }
+
 } // namespace rpc
 } // namespace carla
@@ -0,0 +1,74 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+#include "carla/streaming/detail/StreamStats.h"
+
+#include <cstdint>
+
+namespace carla {
+namespace rpc {
+
+  /// Latency statistics of one stage of a sensor stream's pipeline, in
+  /// milliseconds. The percentile is computed over the most recent samples.
+  class StreamStageStats {
+  public:
+
+    StreamStageStats() = default;
+
+    StreamStageStats(const streaming::detail::StreamStageStats &stats)
+      : average_ms(stats.average_ms),
+        p99_ms(stats.p99_ms),
+        maximum_ms(stats.maximum_ms),
+        count(stats.count) {}
+
+    double average_ms = 0.0;
+
+    double p99_ms = 0.0;
+
+    double maximum_ms = 0.0;
+
+    uint64_t count = 0u;
+
+    MSGPACK_DEFINE_ARRAY(average_ms, p99_ms, maximum_ms, count);
+  };
+
+  /// Pipeline timing of one sensor stream, queryable at runtime through the
+  /// get_sensor_stream_stats RPC.
+  class StreamStats {
+  public:
+
+    StreamStats() = default;
+
+    StreamStats(const streaming::detail::StreamPipelineStats &stats)
+      : stream_id(stats.stream_id),
+        capture(stats.stages[static_cast<size_t>(streaming::detail::StreamStage::capture)]),
+        serialize(stats.stages[static_cast<size_t>(streaming::detail::StreamStage::serialize)]),
+        enqueue(stats.stages[static_cast<size_t>(streaming::detail::StreamStage::enqueue)]),
+        send(stats.stages[static_cast<size_t>(streaming::detail::StreamStage::send)]) {}
+
+    uint32_t stream_id = 0u;
+
+    /// Stream creation to serialization start, covers render and pixel copy
+    /// for camera sensors.
+    StreamStageStats capture;
+
+    /// Sensor data to wire format.
+    StreamStageStats serialize;
+
+    /// Message build, compression, and hand-off to the session queues.
+    StreamStageStats enqueue;
+
+    /// Session queue to socket write completion.
+    StreamStageStats send;
+
+    MSGPACK_DEFINE_ARRAY(stream_id, capture, serialize, enqueue, send);
+  };
+
+} // namespace rpc
+} // namespace carla
@@ -0,0 +1,56 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+#include "carla/rpc/ActorId.h"
+#include "carla/rpc/TrafficLightState.h"
+
+namespace carla {
+namespace rpc {
+
+  /// State and timing of one traffic light, retrieved for every light of the
+  /// episode in a single round trip.
+  class TrafficLightSnapshot {
+  public:
+
+    TrafficLightSnapshot() = default;
+
+    ActorId id = 0u;
+
+    TrafficLightState state = TrafficLightState::Unknown;
+
+    float green_time = 0.0f;
+
+    float yellow_time = 0.0f;
+
+    float red_time = 0.0f;
+
+    float elapsed_time = 0.0f;
+
+    bool frozen = false;
+
+    uint32_t pole_index = 0u;
+
+    /// Lights of the same junction share a group id, the topology does not
+    /// need to be queried light by light.
+    uint32_t group_id = 0u;
+
+    MSGPACK_DEFINE_ARRAY(
+        id,
+        state,
+        green_time,
+        yellow_time,
+        red_time,
+        elapsed_time,
+        frozen,
+        pole_index,
+        group_id);
+  };
+
+} // namespace rpc
+} // namespace carla
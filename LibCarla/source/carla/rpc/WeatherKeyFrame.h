@@ -0,0 +1,38 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+#include "carla/rpc/WeatherParameters.h"
+
+namespace carla {
+namespace rpc {
+
+  /// One keyframe of a weather animation, applied server-side: the server
+  /// interpolates the weather between consecutive keyframes every frame
+  /// instead of the client sending discrete weather updates.
+  class WeatherKeyFrame {
+  public:
+
+    WeatherKeyFrame() = default;
+
+    WeatherKeyFrame(double in_time, WeatherParameters in_parameters)
+      : time(in_time),
+        parameters(std::move(in_parameters)) {}
+
+    /// Time of the keyframe in seconds of simulated time, relative to the
+    /// moment the animation is submitted.
+    double time = 0.0;
+
+    /// Weather to reach at @a time.
+    WeatherParameters parameters;
+
+    MSGPACK_DEFINE_ARRAY(time, parameters);
+  };
+
+} // namespace rpc
+} // namespace carla
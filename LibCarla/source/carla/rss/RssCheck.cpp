@@ -23,6 +23,7 @@
 #include <ad/rss/map/RssSceneCreator.hpp>
 #include <ad/rss/state/RssStateOperation.hpp>
 #include <chrono>
+#include <future>
 #include <tuple>
 
 #include "carla/client/Map.h"
@@ -168,6 +169,7 @@ const ::carla::rss::VisualizationMode &RssCheck::GetVisualizationMode() const {
 void RssCheck::DropRoute() {
   _logger->debug("Dropping Route:: {}", _carla_rss_state.ego_route);
   _carla_rss_state.ego_route = ::ad::map::route::FullRoute();
+  _carla_rss_state.route_match_valid = false;
 }
 
 bool RssCheck::CheckObjects(carla::client::Timestamp const &timestamp,
@@ -326,6 +328,29 @@ bool RssCheck::CheckObjects(carla::client::Timestamp const &timestamp,
 void RssCheck::UpdateRoute(CarlaRssState &carla_rss_state) {
   _logger->debug("Update route start: {}", carla_rss_state.ego_route);
 
+  // the lanes the ego vehicle center is currently matched to; a change
+  // means a lane change (or a map matching jump) and invalidates the
+  // cached route match
+  ::ad::map::lane::LaneIdSet ego_matched_lanes;
+  for (auto const &position :
+       carla_rss_state.ego_match_object.mapMatchedBoundingBox
+           .referencePointPositions[int32_t(::ad::map::match::ObjectReferencePoints::Center)]) {
+    ego_matched_lanes.insert(position.lanePoint.paraPoint.laneId);
+  }
+
+  if (carla_rss_state.route_match_valid && _routing_targets_to_append.empty() &&
+      (ego_matched_lanes == carla_rss_state.ego_matched_lanes)) {
+    auto const travelled_distance = ::ad::map::point::distance(
+        carla_rss_state.last_route_update_position, carla_rss_state.ego_match_object.enuPosition.centerPoint);
+    // the route reaches 50m ahead of the last full update, so while on the
+    // same lanes and within a fraction of that, shortening and extending it
+    // again would reproduce the same route
+    if (travelled_distance < ::ad::physics::Distance(10.)) {
+      _logger->debug("Update route: reusing cached route match");
+      return;
+    }
+  }
+
   // remove the parts of the route already taken, try to prepend route sections
   // (i.e. when driving backwards)
   // try to ensure that the back of the vehicle is still within the route to
@@ -441,6 +466,10 @@ void RssCheck::UpdateRoute(CarlaRssState &carla_rss_state) {
     }
   }
 
+  carla_rss_state.ego_matched_lanes = std::move(ego_matched_lanes);
+  carla_rss_state.last_route_update_position = carla_rss_state.ego_match_object.enuPosition.centerPoint;
+  carla_rss_state.route_match_valid = true;
+
   _logger->debug("Update route result: {}", carla_rss_state.ego_route);
 }
 
@@ -584,24 +613,35 @@ EgoDynamicsOnRoute RssCheck::CalculateEgoDynamicsOnRoute(carla::client::Timestam
       }
     }
 
-    ::ad::map::match::AdMapMatching traffic_light_map_matching;
     bool found_relevant_traffic_light = false;
     for (const auto &traffic_light : traffic_lights) {
       auto traffic_light_state = traffic_light->GetState();
-      carla::geom::BoundingBox trigger_bounding_box = traffic_light->GetTriggerVolume();
-
-      auto traffic_light_transform = traffic_light->GetTransform();
-      auto trigger_box_location = trigger_bounding_box.location;
-      traffic_light_transform.TransformPoint(trigger_box_location);
 
-      ::ad::map::point::ENUPoint trigger_box_position;
-      trigger_box_position.x = ::ad::map::point::ENUCoordinate(trigger_box_location.x);
-      trigger_box_position.y = ::ad::map::point::ENUCoordinate(-1 * trigger_box_location.y);
-      trigger_box_position.z = ::ad::map::point::ENUCoordinate(0.);
-
-      _logger->trace("traffic light[{}] Position: {}", traffic_light->GetId(), trigger_box_position);
-      auto traffic_light_map_matched_positions = traffic_light_map_matching.getMapMatchedPositions(
-          trigger_box_position, ::ad::physics::Distance(0.25), ::ad::physics::Probability(0.1));
+      // the trigger boxes are static, so the map matching result of each
+      // traffic light is calculated only once and cached
+      auto cached_match = _traffic_light_match_cache.find(traffic_light->GetId());
+      if (cached_match == _traffic_light_match_cache.end()) {
+        carla::geom::BoundingBox trigger_bounding_box = traffic_light->GetTriggerVolume();
+
+        auto traffic_light_transform = traffic_light->GetTransform();
+        auto trigger_box_location = trigger_bounding_box.location;
+        traffic_light_transform.TransformPoint(trigger_box_location);
+
+        ::ad::map::point::ENUPoint trigger_box_position;
+        trigger_box_position.x = ::ad::map::point::ENUCoordinate(trigger_box_location.x);
+        trigger_box_position.y = ::ad::map::point::ENUCoordinate(-1 * trigger_box_location.y);
+        trigger_box_position.z = ::ad::map::point::ENUCoordinate(0.);
+
+        _logger->trace("traffic light[{}] Position: {}", traffic_light->GetId(), trigger_box_position);
+        ::ad::map::match::AdMapMatching traffic_light_map_matching;
+        cached_match = _traffic_light_match_cache
+                           .emplace(traffic_light->GetId(),
+                                    traffic_light_map_matching.getMapMatchedPositions(
+                                        trigger_box_position, ::ad::physics::Distance(0.25),
+                                        ::ad::physics::Probability(0.1)))
+                           .first;
+      }
+      auto const &traffic_light_map_matched_positions = cached_match->second;
 
       _logger->trace("traffic light[{}] Map Matched Position: {}", traffic_light->GetId(),
                      traffic_light_map_matched_positions);
@@ -719,9 +759,24 @@ void RssCheck::CreateWorldModel(carla::client::Timestamp const &timestamp, carla
       other_vehicles.begin(), other_vehicles.end(),
       RssObjectChecker(*this, scene_creation, carla_ego_vehicle, carla_rss_state, green_traffic_lights));
 #else
-  for (auto const vehicle : other_vehicles) {
-    auto checker = RssObjectChecker(*this, scene_creation, carla_ego_vehicle, carla_rss_state, green_traffic_lights);
-    checker(vehicle);
+  // the scene creation is internally synchronized and the checker only
+  // reads shared state, so the situations of independent objects can be
+  // evaluated in parallel worker tasks like the TBB path does
+  auto const checker =
+      RssObjectChecker(*this, scene_creation, carla_ego_vehicle, carla_rss_state, green_traffic_lights);
+  if (other_vehicles.size() > 1u) {
+    std::vector<std::future<void>> object_tasks;
+    object_tasks.reserve(other_vehicles.size());
+    for (auto const &vehicle : other_vehicles) {
+      object_tasks.push_back(std::async(std::launch::async, [&checker, vehicle]() { checker(vehicle); }));
+    }
+    for (auto &object_task : object_tasks) {
+      object_task.get();
+    }
+  } else {
+    for (auto const &vehicle : other_vehicles) {
+      checker(vehicle);
+    }
   }
 #endif
 
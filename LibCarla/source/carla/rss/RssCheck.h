@@ -7,6 +7,7 @@
 
 #include <spdlog/spdlog.h>
 #include <ad/map/landmark/LandmarkIdSet.hpp>
+#include <ad/map/lane/Types.hpp>
 #include <ad/map/match/Object.hpp>
 #include <ad/map/route/FullRoute.hpp>
 #include <ad/rss/core/RssCheck.hpp>
@@ -17,6 +18,7 @@
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include "carla/client/ActorList.h"
 #include "carla/client/Vehicle.h"
 #include "carla/road/Map.h"
@@ -211,6 +213,17 @@ private:
     /// @brief the ego route
     ::ad::map::route::FullRoute ego_route;
 
+    /// @brief the lanes the ego vehicle center was matched to at the last
+    /// full route update; a change means a lane change and invalidates the
+    /// cached route match
+    ::ad::map::lane::LaneIdSet ego_matched_lanes;
+
+    /// @brief the ego position at the last full route update
+    ::ad::map::point::ENUPoint last_route_update_position;
+
+    /// @brief flag indicating if the cached route match is usable
+    bool route_match_valid{false};
+
     /// @brief the ego dynamics on the route
     EgoDynamicsOnRoute ego_dynamics_on_route;
 
@@ -278,6 +291,12 @@ private:
       std::vector<SharedPtr<carla::client::TrafficLight>> const &traffic_lights,
       ::ad::map::route::FullRoute const &route) const;
 
+  /// @brief the map matched positions of the traffic light trigger boxes;
+  /// the trigger boxes are static, so each traffic light is matched only
+  /// once instead of every frame
+  mutable std::unordered_map<carla::ActorId, ::ad::map::match::MapMatchedPositionConfidenceList>
+      _traffic_light_match_cache;
+
   /// @brief Create the RSS world model
   void CreateWorldModel(carla::client::Timestamp const &timestamp, carla::client::ActorList const &actors,
                         carla::client::Vehicle const &carla_ego_vehicle, CarlaRssState &carla_rss_state) const;
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/Buffer.h"
+#include "carla/Debug.h"
 #include "carla/Memory.h"
 #include "carla/sensor/CompileTimeTypeMap.h"
 #include "carla/sensor/RawData.h"
@@ -42,31 +43,48 @@ namespace sensor {
     /// serializer that generated the Buffer.
     static interpreted_type Deserialize(Buffer &&data);
 
+    /// Wrap @a data without interpreting its payload. Gives access to the
+    /// sensor header and is the entry point of the DeserializeView fast
+    /// path.
+    static RawData MakeRawData(Buffer &&data) {
+      return RawData{std::move(data)};
+    }
+
+    /// Non-owning fast path for messages whose sensor type the caller
+    /// already knows: skips the type-id dispatch and returns the view type
+    /// defined by the serializer registered for @a Sensor, pointing into @a
+    /// data instead of boxing a copy into a SharedPtr. @a data acts as the
+    /// caller-provided storage and must be kept alive while the view is in
+    /// use. Only available for serializers defining a DeserializeView.
+    template <typename Sensor>
+    static auto DeserializeView(const RawData &data) {
+      using Serializer = typename Super::template get<Sensor *>::type;
+      DEBUG_ASSERT(data.GetSensorTypeId() == (Super::template get<Sensor *>::index));
+      return Serializer::DeserializeView(data);
+    }
+
   private:
 
-    template <size_t Index, typename Data>
-    static interpreted_type Deserialize_impl(Data &&data) {
+    template <size_t Index>
+    static interpreted_type Deserialize_impl(RawData &&data) {
       using Serializer = typename Super::template get_by_index<Index>::type;
-      return Serializer::Deserialize(std::forward<Data>(data));
+      return Serializer::Deserialize(std::move(data));
     }
 
-    template <typename Data, size_t... Is>
-    static interpreted_type Deserialize_impl(size_t i, Data &&data, std::index_sequence<Is...>) {
-      // This function is equivalent to creating a switch statement with a case
-      // for each element in the map, the compiler should be able to optimize it
-      // into a jump table. See https://stackoverflow.com/a/46282159/5308925.
-      interpreted_type result;
-      std::initializer_list<int> ({
-          (i == Is ? (result = Deserialize_impl<Is>(std::forward<Data>(data))), 0 : 0)...
-      });
-      return result;
+    template <size_t... Is>
+    static interpreted_type Deserialize_impl(size_t i, RawData &&data, std::index_sequence<Is...>) {
+      // Jump table built at compile time from the type map, one entry per
+      // registered serializer, so dispatching on the type id is a single
+      // indexed call instead of a chain of comparisons.
+      using deserializer_type = interpreted_type (*)(RawData &&);
+      static constexpr deserializer_type jump_table[] = { &Deserialize_impl<Is>... };
+      return i < Super::size() ? jump_table[i](std::move(data)) : interpreted_type{};
     }
 
-    template <typename Data>
-    static interpreted_type Deserialize(size_t index, Data &&data) {
+    static interpreted_type Deserialize(size_t index, RawData &&data) {
       return Deserialize_impl(
           index,
-          std::forward<Data>(data),
+          std::move(data),
           std::make_index_sequence<Super::size()>());
     }
   };
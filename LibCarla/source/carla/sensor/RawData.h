@@ -15,6 +15,11 @@
 namespace carla {
 namespace sensor {
 
+namespace s11n {
+  class DVSEventArraySerializer;
+  class LidarSerializer;
+} // namespace s11n
+
   /// Wrapper around the raw data generated by a sensor plus some useful
   /// meta-information.
   class RawData {
@@ -47,7 +52,9 @@ namespace sensor {
      return GetHeader().sensor_transform;
     }
 
-    /// Begin iterator to the data generated by the sensor.
+    /// Begin iterator to the data generated by the sensor. The returned
+    /// address is always a multiple of Buffer::alignment, so SIMD kernels can
+    /// use aligned loads on the payload.
     auto begin() noexcept {
      return _buffer.begin() + HeaderSerializer::header_offset;
     }
@@ -89,6 +96,10 @@ namespace sensor {
     template <typename... Items>
     friend class CompositeSerializer;
 
+    // These rewrite the buffer when undoing their wire format on arrival.
+    friend class s11n::DVSEventArraySerializer;
+    friend class s11n::LidarSerializer;
+
     RawData(Buffer &&buffer) : _buffer(std::move(buffer)) {}
 
     Buffer _buffer;
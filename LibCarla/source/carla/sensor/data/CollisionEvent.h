@@ -27,8 +27,8 @@ namespace data {
 
     explicit CollisionEvent(const RawData &data)
       : Super(data),
-        _self_actor(Serializer::DeserializeRawData(data).self_actor),
-        _other_actor(Serializer::DeserializeRawData(data).other_actor),
+        _self_actor(Serializer::DeserializeRawData(data).self_actor_id),
+        _other_actor(MakeOtherActor(Serializer::DeserializeRawData(data))),
         _normal_impulse(Serializer::DeserializeRawData(data).normal_impulse) {}
 
   public:
@@ -50,6 +50,19 @@ namespace data {
 
   private:
 
+    /// The other actor travels as an id resolvable from the episode cache;
+    /// unregistered level geometry has no id, fabricate the same fake actor
+    /// the server used to ship whole.
+    static client::detail::ActorVariant MakeOtherActor(Serializer::Data data) {
+      if (data.other_actor_id != 0u) {
+        return client::detail::ActorVariant(data.other_actor_id);
+      }
+      rpc::Actor actor;
+      actor.id = 0u;
+      actor.description.id = std::move(data.other_actor_type);
+      return client::detail::ActorVariant(std::move(actor));
+    }
+
     client::detail::ActorVariant _self_actor;
 
     client::detail::ActorVariant _other_actor;
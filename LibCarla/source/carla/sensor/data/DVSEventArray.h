@@ -114,6 +114,31 @@ namespace data {
       return array;
     }
 
+    /// The four event fields as one contiguous plane each
+    struct Planes {
+      std::vector<std::uint16_t> x;
+      std::vector<std::uint16_t> y;
+      std::vector<std::int64_t> t;
+      std::vector<short> pol;
+    };
+
+    /// Get all four planes in a single pass over the events, instead of one
+    /// pass per plane with the ToArray accessors above
+    Planes ToPlanes() const {
+      Planes planes;
+      planes.x.reserve(size());
+      planes.y.reserve(size());
+      planes.t.reserve(size());
+      planes.pol.reserve(size());
+      for (const auto &event : *this) {
+        planes.x.push_back(event.x);
+        planes.y.push_back(event.y);
+        planes.t.push_back(event.t);
+        planes.pol.push_back(2*static_cast<short>(event.pol) - 1);
+      }
+      return planes;
+    }
+
   };
 
 } // namespace data
@@ -10,6 +10,8 @@
 
 #include "carla/sensor/s11n/GnssSerializer.h"
 
+#include <vector>
+
 namespace carla {
 namespace sensor {
 namespace data {
@@ -25,13 +27,9 @@ namespace data {
 
     friend Serializer;
 
-    explicit GnssMeasurement(const RawData &&data)
-      : Super(data){
-
-      geom::GeoLocation gnss_data = Serializer::DeserializeRawData(data);
-      _geo_location = gnss_data;
-
-    }
+    GnssMeasurement(const RawData &data, const Serializer::Sample &sample)
+      : Super(data),
+        _geo_location(sample.geo_location) {}
 
   public:
 
@@ -57,6 +55,51 @@ namespace data {
 
   };
 
+  /// A batch of GNSS samples accumulated at the sensor and flushed as a
+  /// single message. Each sample keeps the simulation time it was taken at,
+  /// the header timestamp corresponds to the flushing tick.
+  class GnssMeasurementArray : public SensorData {
+
+    using Super = SensorData;
+
+  protected:
+
+    using Serializer = s11n::GnssSerializer;
+
+    friend Serializer;
+
+    GnssMeasurementArray(const RawData &data, std::vector<Serializer::Sample> samples)
+      : Super(data),
+        _samples(std::move(samples)) {}
+
+  public:
+
+    using Sample = Serializer::Sample;
+
+    using const_iterator = std::vector<Sample>::const_iterator;
+
+    size_t size() const {
+      return _samples.size();
+    }
+
+    const Sample &operator[](size_t pos) const {
+      return _samples[pos];
+    }
+
+    const_iterator begin() const {
+      return _samples.begin();
+    }
+
+    const_iterator end() const {
+      return _samples.end();
+    }
+
+  private:
+
+    std::vector<Sample> _samples;
+
+  };
+
 } // namespace data
 } // namespace sensor
 } // namespace carla
@@ -10,6 +10,8 @@
 #include "carla/sensor/s11n/IMUSerializer.h"
 #include "carla/sensor/SensorData.h"
 
+#include <vector>
+
 namespace carla {
 namespace sensor {
 namespace data {
@@ -23,11 +25,11 @@ namespace data {
 
     friend Serializer;
 
-    explicit IMUMeasurement(const RawData &data)
+    IMUMeasurement(const RawData &data, const Serializer::Sample &sample)
       : Super(data),
-        _accelerometer(Serializer::DeserializeRawData(data).accelerometer),
-        _gyroscope(Serializer::DeserializeRawData(data).gyroscope),
-        _compass(Serializer::DeserializeRawData(data).compass) {}
+        _accelerometer(sample.measurement.accelerometer),
+        _gyroscope(sample.measurement.gyroscope),
+        _compass(sample.measurement.compass) {}
 
   public:
 
@@ -51,6 +53,50 @@ namespace data {
 
   };
 
+  /// A batch of IMU samples accumulated at the sensor and flushed as a
+  /// single message. Each sample keeps the simulation time it was taken at,
+  /// the header timestamp corresponds to the flushing tick.
+  class IMUMeasurementArray : public SensorData {
+  protected:
+
+    using Super = SensorData;
+
+    using Serializer = s11n::IMUSerializer;
+
+    friend Serializer;
+
+    IMUMeasurementArray(const RawData &data, std::vector<Serializer::Sample> samples)
+      : Super(data),
+        _samples(std::move(samples)) {}
+
+  public:
+
+    using Sample = Serializer::Sample;
+
+    using const_iterator = std::vector<Sample>::const_iterator;
+
+    size_t size() const {
+      return _samples.size();
+    }
+
+    const Sample &operator[](size_t pos) const {
+      return _samples[pos];
+    }
+
+    const_iterator begin() const {
+      return _samples.begin();
+    }
+
+    const_iterator end() const {
+      return _samples.end();
+    }
+
+  private:
+
+    std::vector<Sample> _samples;
+
+  };
+
 } // namespace data
 } // namespace sensor
 } // namespace carla
@@ -53,6 +53,30 @@ namespace data {
     auto GetFOVAngle() const {
       return GetHeader().fov_angle;
     }
+
+    /// Column within the full frame where this image starts. Zero unless a
+    /// region of interest was set on the camera.
+    auto GetROIOffsetX() const {
+      return GetHeader().roi_offset_x;
+    }
+
+    /// Row within the full frame where this image starts. Zero unless a
+    /// region of interest was set on the camera.
+    auto GetROIOffsetY() const {
+      return GetHeader().roi_offset_y;
+    }
+
+    /// Width in pixels of the full frame rendered by the camera, regardless
+    /// of the region of interest shipped.
+    auto GetFullWidth() const {
+      return GetHeader().full_width;
+    }
+
+    /// Height in pixels of the full frame rendered by the camera, regardless
+    /// of the region of interest shipped.
+    auto GetFullHeight() const {
+      return GetHeader().full_height;
+    }
   };
 
 } // namespace data
@@ -11,6 +11,10 @@
 #include "carla/sensor/data/Array.h"
 #include "carla/sensor/s11n/LidarSerializer.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 namespace carla {
 namespace sensor {
 namespace data {
@@ -28,7 +32,7 @@ namespace data {
 
     explicit LidarMeasurement(RawData data)
       : Super(std::move(data)) {
-      Super::SetOffset(Serializer::GetHeaderOffset(Super::GetRawData()));
+      Super::SetOffset(Serializer::GetPointOffset(Super::GetRawData()));
     }
 
   private:
@@ -55,6 +59,197 @@ namespace data {
     auto GetPointCount(size_t channel) const {
       return GetHeader().GetPointCount(channel);
     }
+
+    /// Return a copy of the point cloud transformed to world space, applying
+    /// the sensor transform to the whole array in one batch.
+    std::vector<rpc::Location> GetPointsInWorld() const {
+      std::vector<rpc::Location> points(Super::begin(), Super::end());
+      Super::GetSensorTransform().TransformPoints(points.data(), points.size());
+      return points;
+    }
+
+    /// Index of this angular sector inside its revolution; zero unless the
+    /// sensor is streaming sectors, see the @a sector_count attribute of the
+    /// lidar blueprint.
+    auto GetSectorIndex() const {
+      return GetHeader().GetSectorIndex();
+    }
+
+    /// Number of fixed angular sectors per revolution; one for a classic
+    /// full-revolution measurement.
+    auto GetSectorCount() const {
+      return GetHeader().GetSectorCount();
+    }
+
+    /// Id of the revolution this sector belongs to.
+    auto GetRevolution() const {
+      return GetHeader().GetRevolution();
+    }
+
+    /// Whether the measurement carries the semantic tag of each point, see
+    /// the @a semantic attribute of the lidar blueprint.
+    bool HasSemanticTags() const {
+      return GetHeader().HasSemanticTags();
+    }
+
+    /// Semantic tag of each point in point order, or nullptr when the
+    /// measurement does not carry tags.
+    const uint8_t *GetSemanticTags() const {
+      return HasSemanticTags() ?
+          GetRawData().begin() + Serializer::GetHeaderOffset(GetRawData()) :
+          nullptr;
+    }
+
+    /// Return the points whose semantic tag has its bit set in @a tag_mask,
+    /// i.e. pass `~((1 << Road) | (1 << Sidewalk))` to drop road and sidewalk
+    /// returns in a single pass over the array. Returns every point when the
+    /// measurement carries no tags.
+    std::vector<rpc::Location> FilterByTagMask(uint32_t tag_mask) const {
+      const auto *tags = GetSemanticTags();
+      if (tags == nullptr) {
+        return {Super::begin(), Super::end()};
+      }
+      std::vector<rpc::Location> points;
+      points.reserve(Super::size());
+      for (auto i = 0u; i < Super::size(); ++i) {
+        if ((tags[i] < 32u) && ((tag_mask & (1u << tags[i])) != 0u)) {
+          points.emplace_back(Super::operator[](i));
+        }
+      }
+      return points;
+    }
+  };
+
+  /// Reassembles the sector measurements of a sector streaming lidar back
+  /// into full revolutions, for consumers that want classic whole frames.
+  ///
+  /// Feed every incoming measurement; when Feed returns true GetPoints holds
+  /// the points of the completed revolution sorted by channel, like a
+  /// full-revolution measurement would. Measurements that are already whole
+  /// (sector count one) complete immediately.
+  class LidarFrameAssembler {
+  public:
+
+    /// Add @a sector to the revolution under assembly, return whether it
+    /// completed it. A sector of a newer revolution discards any partially
+    /// assembled one.
+    bool Feed(const LidarMeasurement &sector) {
+      if (sector.GetSectorCount() <= 1u) {
+        AssembleWhole(sector);
+        return true;
+      }
+      if ((_channels.size() != sector.GetChannelCount()) ||
+          (_revolution != sector.GetRevolution()) ||
+          (_pending.size() != sector.GetSectorCount())) {
+        Restart(sector);
+      }
+      if (!_pending[sector.GetSectorIndex()]) {
+        // duplicate sector, e.g. after a reconnection; keep the first copy
+        return false;
+      }
+      AppendSector(sector);
+      _pending[sector.GetSectorIndex()] = false;
+      if (std::any_of(_pending.begin(), _pending.end(), [](bool b) { return b; })) {
+        return false;
+      }
+      Flatten();
+      return true;
+    }
+
+    /// Points of the last completed revolution, sorted by channel.
+    const std::vector<rpc::Location> &GetPoints() const {
+      return _points;
+    }
+
+    /// Semantic tags of the last completed revolution, in point order; empty
+    /// when the sensor does not stream tags.
+    const std::vector<uint8_t> &GetSemanticTags() const {
+      return _tags;
+    }
+
+    /// Number of points of each channel in the last completed revolution.
+    const std::vector<uint32_t> &GetPointCounts() const {
+      return _counts;
+    }
+
+    uint32_t GetRevolution() const {
+      return _revolution;
+    }
+
+  private:
+
+    void Restart(const LidarMeasurement &sector) {
+      _revolution = sector.GetRevolution();
+      _channels.assign(sector.GetChannelCount(), {});
+      _channel_tags.assign(sector.GetChannelCount(), {});
+      _pending.assign(sector.GetSectorCount(), true);
+    }
+
+    void AppendSector(const LidarMeasurement &sector) {
+      const auto *tags = sector.GetSemanticTags();
+      auto it = sector.begin();
+      size_t offset = 0u;
+      for (auto channel = 0u; channel < sector.GetChannelCount(); ++channel) {
+        const auto count = sector.GetPointCount(channel);
+        _channels[channel].insert(_channels[channel].end(), it, it + count);
+        if (tags != nullptr) {
+          _channel_tags[channel].insert(
+              _channel_tags[channel].end(),
+              tags + offset,
+              tags + offset + count);
+        }
+        it += count;
+        offset += count;
+      }
+    }
+
+    /// Concatenate the per-channel buffers into the frame arrays.
+    void Flatten() {
+      _points.clear();
+      _tags.clear();
+      _counts.clear();
+      for (auto channel = 0u; channel < _channels.size(); ++channel) {
+        _counts.emplace_back(static_cast<uint32_t>(_channels[channel].size()));
+        _points.insert(_points.end(), _channels[channel].begin(), _channels[channel].end());
+        _tags.insert(_tags.end(), _channel_tags[channel].begin(), _channel_tags[channel].end());
+        _channels[channel].clear();
+        _channel_tags[channel].clear();
+      }
+      std::fill(_pending.begin(), _pending.end(), true);
+      ++_revolution;
+    }
+
+    void AssembleWhole(const LidarMeasurement &frame) {
+      _revolution = frame.GetRevolution();
+      _points.assign(frame.begin(), frame.end());
+      _counts.clear();
+      for (auto channel = 0u; channel < frame.GetChannelCount(); ++channel) {
+        _counts.emplace_back(frame.GetPointCount(channel));
+      }
+      const auto *tags = frame.GetSemanticTags();
+      if (tags != nullptr) {
+        _tags.assign(tags, tags + frame.size());
+      } else {
+        _tags.clear();
+      }
+    }
+
+    uint32_t _revolution = 0u;
+
+    /// Points of the revolution under assembly, split by channel so sectors
+    /// can arrive without breaking the by-channel sorting of the frame.
+    std::vector<std::vector<rpc::Location>> _channels;
+
+    std::vector<std::vector<uint8_t>> _channel_tags;
+
+    /// Sectors of the current revolution not yet received.
+    std::vector<bool> _pending;
+
+    std::vector<rpc::Location> _points;
+
+    std::vector<uint8_t> _tags;
+
+    std::vector<uint32_t> _counts;
   };
 
 } // namespace data
@@ -25,10 +25,20 @@ namespace data {
     friend Serializer;
 
     explicit RawEpisodeState(RawData data)
-      : Super(Serializer::header_offset, std::move(data)) {}
+      : Super(GetOffset(data), std::move(data)) {}
 
   private:
 
+    /// Delta frames don't carry an array of ActorDynamicState, leave the
+    /// array view empty and expose the payload through delta_begin/delta_end.
+    static size_t GetOffset(const RawData &data) {
+      const auto &header = Serializer::DeserializeHeader(data);
+      if ((header.simulation_state & Serializer::DeltaFrame) != 0) {
+        return data.size();
+      }
+      return Serializer::header_offset;
+    }
+
     auto GetHeader() const {
       return Serializer::DeserializeHeader(Super::GetRawData());
     }
@@ -62,6 +72,31 @@ namespace data {
       return GetHeader().simulation_state;
     }
 
+    /// Revision of the vehicle physics controls at this frame, see
+    /// Serializer::Header.
+    uint64_t GetPhysicsControlRevision() const {
+      return GetHeader().physics_control_revision;
+    }
+
+    /// Whether this frame carries changed fields relative to the last
+    /// keyframe instead of the full state of every actor.
+    bool IsDeltaFrame() const {
+      return (GetSimulationState() & Serializer::DeltaFrame) != 0;
+    }
+
+    /// Begin of the delta payload, see Serializer::ActorFieldMask. Only valid
+    /// on delta frames.
+    const unsigned char *delta_begin() const {
+      DEBUG_ASSERT(IsDeltaFrame());
+      return Super::GetRawData().begin() + Serializer::header_offset;
+    }
+
+    /// Past-the-end of the delta payload. Only valid on delta frames.
+    const unsigned char *delta_end() const {
+      DEBUG_ASSERT(IsDeltaFrame());
+      return Super::GetRawData().end();
+    }
+
   };
 
 } // namespace data
@@ -9,10 +9,13 @@
 #include "carla/Buffer.h"
 #include "carla/Debug.h"
 #include "carla/Memory.h"
-#include "carla/rpc/Actor.h"
+#include "carla/MsgPack.h"
+#include "carla/rpc/ActorId.h"
 #include "carla/geom/Vector3D.h"
 #include "carla/sensor/RawData.h"
 
+#include <string>
+
 namespace carla {
 namespace sensor {
 
@@ -20,19 +23,26 @@ namespace sensor {
 
 namespace s11n {
 
-  /// Serializes the current state of the whole episode.
+  /// Serializes collision events. Actors travel as ids only, the client
+  /// resolves them against its episode cache; unregistered level geometry
+  /// ships its semantic type instead, since it has no id to resolve.
   class CollisionEventSerializer {
   public:
 
     struct Data {
 
-      rpc::Actor self_actor;
+      rpc::ActorId self_actor_id;
+
+      /// Zero when the other actor is not registered in the episode.
+      rpc::ActorId other_actor_id;
 
-      rpc::Actor other_actor;
+      /// Semantic type of the other actor, e.g. "static.road"; only set
+      /// when @a other_actor_id is zero.
+      std::string other_actor_type;
 
       geom::Vector3D normal_impulse;
 
-      MSGPACK_DEFINE_ARRAY(self_actor, other_actor, normal_impulse)
+      MSGPACK_DEFINE_ARRAY(self_actor_id, other_actor_id, other_actor_type, normal_impulse)
     };
 
     constexpr static auto header_offset = 0u;
@@ -44,10 +54,15 @@ namespace s11n {
     template <typename SensorT>
     static Buffer Serialize(
         const SensorT &,
-        rpc::Actor self_actor,
-        rpc::Actor other_actor,
+        rpc::ActorId self_actor_id,
+        rpc::ActorId other_actor_id,
+        std::string other_actor_type,
         geom::Vector3D normal_impulse) {
-      return MsgPack::Pack(Data{self_actor, other_actor, normal_impulse});
+      return MsgPack::Pack(Data{
+          self_actor_id,
+          other_actor_id,
+          std::move(other_actor_type),
+          normal_impulse});
     }
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
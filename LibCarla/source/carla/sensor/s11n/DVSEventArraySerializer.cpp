@@ -12,8 +12,78 @@ namespace carla {
 namespace sensor {
 namespace s11n {
 
+  /// The SoA payload consists of the timestamp of the first event followed by
+  /// one plane per event field, each plane contiguous
+  ///
+  ///    {
+  ///      t base (int64),
+  ///      t delta vs base (int32) x N,
+  ///      x (uint16) x N,
+  ///      y (uint16) x N,
+  ///      polarity (uint8) x N,
+  ///    }
+  void DVSEventArraySerializer::SerializeSoA(const DVSEventArray &events, unsigned char *it) {
+    const auto count = events.size();
+    const int64_t t_base = events.empty() ? 0ll : events.front().t;
+    std::memcpy(it, &t_base, sizeof(t_base));
+    it += sizeof(t_base);
+    auto *t_plane = reinterpret_cast<int32_t *>(it);
+    auto *x_plane = reinterpret_cast<uint16_t *>(it + count * sizeof(int32_t));
+    auto *y_plane = x_plane + count;
+    auto *pol_plane = reinterpret_cast<uint8_t *>(y_plane + count);
+    for (auto i = 0u; i < count; ++i) {
+      const auto &e = events[i];
+      t_plane[i] = static_cast<int32_t>(e.t - t_base);
+      x_plane[i] = e.x;
+      y_plane[i] = e.y;
+      pol_plane[i] = e.pol ? 1u : 0u;
+    }
+  }
+
+  RawData DVSEventArraySerializer::TransposeToAoS(RawData &&data) {
+    using SensorHeader = SensorHeaderSerializer;
+    constexpr auto event_size =
+        2u * sizeof(uint16_t) + sizeof(int32_t) + sizeof(uint8_t);
+    static_assert(event_size == sizeof(data::DVSEvent) - sizeof(int64_t) + sizeof(int32_t),
+        "SoA plane sizes out of sync with data::DVSEvent");
+    const auto count = (data.size() - header_offset - sizeof(int64_t)) / event_size;
+    const auto *it = data.begin() + header_offset;
+    int64_t t_base = 0;
+    std::memcpy(&t_base, it, sizeof(t_base));
+    it += sizeof(t_base);
+    const auto *t_plane = reinterpret_cast<const int32_t *>(it);
+    const auto *x_plane = reinterpret_cast<const uint16_t *>(it + count * sizeof(int32_t));
+    const auto *y_plane = x_plane + count;
+    const auto *pol_plane = reinterpret_cast<const uint8_t *>(y_plane + count);
+    Buffer transposed(
+        SensorHeader::header_offset +
+        header_offset +
+        count * sizeof(data::DVSEvent));
+    std::memcpy(
+        transposed.data(),
+        data._buffer.data(),
+        SensorHeader::header_offset + header_offset);
+    auto *events = reinterpret_cast<data::DVSEvent *>(
+        transposed.data() + SensorHeader::header_offset + header_offset);
+    for (auto i = 0u; i < count; ++i) {
+      events[i] = data::DVSEvent(
+          x_plane[i],
+          y_plane[i],
+          t_base + t_plane[i],
+          pol_plane[i] != 0u);
+    }
+    // Clear the flag, from here on the events are an array of structs.
+    auto *header = reinterpret_cast<DVSHeader *>(transposed.data() + SensorHeader::header_offset);
+    header->flags &= ~soa_flag;
+    return RawData{std::move(transposed)};
+  }
+
   SharedPtr<SensorData> DVSEventArraySerializer::Deserialize(RawData &&data) {
 
+    if ((DeserializeHeader(data).flags & soa_flag) != 0u) {
+      data = TransposeToAoS(std::move(data));
+    }
+
     auto events_array = SharedPtr<data::DVSEventArray>(new data::DVSEventArray{std::move(data)});
 
     return events_array;
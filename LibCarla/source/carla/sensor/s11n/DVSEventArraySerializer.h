@@ -29,9 +29,14 @@ namespace s11n {
       uint32_t width;
       uint32_t height;
       float fov_angle;
+      uint32_t flags;
     };
 #pragma pack(pop)
 
+    /// Flag marking the events as struct-of-arrays planes with delta-encoded
+    /// timestamps instead of an array of data::DVSEvent.
+    constexpr static uint32_t soa_flag = 0x1u;
+
     constexpr static auto header_offset = sizeof(DVSHeader);
     using DVSEventArray = std::vector<data::DVSEvent>;
 
@@ -43,19 +48,37 @@ namespace s11n {
     static Buffer Serialize(const Sensor &sensor, const DVSEventArray &events, Buffer &&output);
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
+
+  private:
+
+    static void SerializeSoA(const DVSEventArray &events, unsigned char *it);
+
+    /// Rebuild @a data transposing the planes back into an array of
+    /// data::DVSEvent, so consumers are unaffected by the wire layout.
+    static RawData TransposeToAoS(RawData &&data);
   };
 
   template <typename Sensor>
   inline Buffer DVSEventArraySerializer::Serialize(const Sensor &sensor, const DVSEventArray &events, Buffer &&output) {
     DEBUG_ASSERT(events.size() > sizeof(DVSHeader));
+    const bool use_soa = sensor.UsesSoAWireFormat();
     DVSHeader header = {
       sensor.GetImageWidth(),
       sensor.GetImageHeight(),
       sensor.GetFOVAngle(),
+      use_soa ? soa_flag : 0u,
     };
 
-    /// Reset the output buffer
-    output.reset(sizeof(DVSHeader) + (events.size() * sizeof(data::DVSEvent)));
+    /// Reset the output buffer. Delta-encoding the timestamps makes the SoA
+    /// layout 9 bytes per event instead of 13, and its planes compress much
+    /// better.
+    constexpr size_t soa_event_size =
+        2u * sizeof(uint16_t) + sizeof(int32_t) + sizeof(uint8_t);
+    output.reset(
+        sizeof(DVSHeader) +
+        (use_soa ?
+            sizeof(int64_t) + events.size() * soa_event_size :
+            events.size() * sizeof(data::DVSEvent)));
 
     /// Pointer to data in buffer
     unsigned char *it = output.data();
@@ -64,6 +87,11 @@ namespace s11n {
     std::memcpy(it, reinterpret_cast<const void *>(&header), sizeof(header));
     it += sizeof(DVSHeader);
 
+    if (use_soa) {
+      SerializeSoA(events, it);
+      return std::move(output);
+    }
+
     /// Copy the events into the output buffer
     for (auto e : events) {
       std::memcpy(it, reinterpret_cast<const void *>(&e), sizeof(data::DVSEvent));
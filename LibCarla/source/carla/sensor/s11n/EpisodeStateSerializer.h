@@ -30,7 +30,31 @@ namespace s11n {
     enum SimulationState {
       None               = (0x0 << 0),
       MapChange          = (0x1 << 0),
-      PendingLightUpdate = (0x1 << 1)
+      PendingLightUpdate = (0x1 << 1),
+      DeltaFrame         = (0x1 << 2)
+    };
+
+    /// Field masks for the entries of a delta frame.
+    ///
+    /// A delta frame carries, instead of the array of ActorDynamicState, the
+    /// number of entries (uint32) followed by one entry per actor whose state
+    /// changed since the last keyframe
+    ///
+    ///    {
+    ///      actor id,
+    ///      changed-field mask (uint8),
+    ///      changed fields, in mask order
+    ///    }
+    ///
+    /// Actors not present are unchanged since the keyframe. Deltas are always
+    /// relative to the last keyframe, not to the previous frame, so a client
+    /// can reconstruct the state even if intermediate frames were dropped.
+    enum ActorFieldMask : uint8_t {
+      TransformField       = (0x1 << 0),
+      VelocityField        = (0x1 << 1),
+      AngularVelocityField = (0x1 << 2),
+      AccelerationField    = (0x1 << 3),
+      TypeDependentField   = (0x1 << 4)
     };
 
 #pragma pack(push, 1)
@@ -39,6 +63,9 @@ namespace s11n {
       double platform_timestamp;
       float delta_seconds;
       SimulationState simulation_state = SimulationState::None;
+      /// Bumped by the server whenever a vehicle physics control changes,
+      /// lets clients invalidate cached controls without polling.
+      uint64_t physics_control_revision = 0u;
     };
 #pragma pack(pop)
 
@@ -13,7 +13,11 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> GnssSerializer::Deserialize(RawData &&data) {
-    return SharedPtr<SensorData>(new data::GnssMeasurement(std::move(data)));
+    auto samples = DeserializeRawData(data);
+    if (samples.size() == 1u) {
+      return SharedPtr<SensorData>(new data::GnssMeasurement(data, samples.front()));
+    }
+    return SharedPtr<SensorData>(new data::GnssMeasurementArray(data, std::move(samples)));
   }
 
 } // namespace s11n
@@ -13,6 +13,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <vector>
 
 namespace carla {
 namespace sensor {
@@ -24,16 +25,31 @@ namespace s11n {
   class GnssSerializer {
   public:
 
-    static geom::GeoLocation DeserializeRawData(const RawData &message) {
-      return MsgPack::UnPack<geom::GeoLocation>(message.begin(), message.size());
+    /// One sample of a message, tagged with the simulation time it was
+    /// taken at. Sensors in batching mode accumulate several of these and
+    /// flush them as a single message, the header timestamp corresponds to
+    /// the flushing tick.
+    struct Sample {
+
+      double timestamp;
+
+      geom::GeoLocation geo_location;
+
+      MSGPACK_DEFINE_ARRAY(timestamp, geo_location)
+    };
+
+    static std::vector<Sample> DeserializeRawData(const RawData &message) {
+      return MsgPack::UnPack<std::vector<Sample>>(message.begin(), message.size());
     }
 
+    /// Messages always travel as an array of samples, of size one unless
+    /// the sensor is batching.
     template <typename SensorT>
     static Buffer Serialize(
         const SensorT &,
-        const geom::GeoLocation &geo_location
+        const std::vector<Sample> &samples
         ) {
-      return MsgPack::Pack(geo_location);
+      return MsgPack::Pack(samples);
     }
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
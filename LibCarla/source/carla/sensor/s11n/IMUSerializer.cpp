@@ -12,7 +12,11 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> IMUSerializer::Deserialize(RawData &&data) {
-    return SharedPtr<SensorData>(new data::IMUMeasurement(std::move(data)));
+    auto samples = DeserializeRawData(data);
+    if (samples.size() == 1u) {
+      return SharedPtr<SensorData>(new data::IMUMeasurement(data, samples.front()));
+    }
+    return SharedPtr<SensorData>(new data::IMUMeasurementArray(data, std::move(samples)));
   }
 
 } // namespace s11n
@@ -10,6 +10,8 @@
 #include "carla/Memory.h"
 #include "carla/sensor/RawData.h"
 
+#include <vector>
+
 namespace carla {
 namespace sensor {
 
@@ -32,15 +34,35 @@ namespace s11n {
       MSGPACK_DEFINE_ARRAY(accelerometer, gyroscope, compass)
     };
 
+    /// One sample of a message, tagged with the simulation time it was
+    /// taken at. Sensors in batching mode accumulate several of these and
+    /// flush them as a single message, the header timestamp corresponds to
+    /// the flushing tick.
+    struct Sample {
+
+      double timestamp;
+
+      Data measurement;
+
+      MSGPACK_DEFINE_ARRAY(timestamp, measurement)
+    };
+
+    /// Messages always travel as an array of samples, of size one unless
+    /// the sensor is batching.
     template <typename SensorT>
     static Buffer Serialize(
       const SensorT &sensor,
-      const geom::Vector3D &accelerometer,
-      const geom::Vector3D &gyroscope,
-      const float compass);
+      const std::vector<Sample> &samples);
+
+    static std::vector<Sample> DeserializeRawData(const RawData &message) {
+      return MsgPack::UnPack<std::vector<Sample>>(message.begin(), message.size());
+    }
 
-    static Data DeserializeRawData(const RawData &message) {
-      return MsgPack::UnPack<Data>(message.begin(), message.size());
+    /// Fast path matching the view API of the other high-rate serializers;
+    /// the measurement is a handful of floats per sample, so they are
+    /// returned by value.
+    static std::vector<Sample> DeserializeView(const RawData &data) {
+      return DeserializeRawData(data);
     }
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
@@ -49,10 +71,8 @@ namespace s11n {
   template <typename SensorT>
   inline Buffer IMUSerializer::Serialize(
       const SensorT &,
-      const geom::Vector3D &accelerometer,
-      const geom::Vector3D &gyroscope,
-      const float compass) {
-    return MsgPack::Pack(Data{accelerometer, gyroscope, compass});
+      const std::vector<Sample> &samples) {
+    return MsgPack::Pack(samples);
   }
 
 } // namespace s11n
@@ -8,6 +8,8 @@
 
 #include "carla/Memory.h"
 #include "carla/sensor/RawData.h"
+#include "carla/sensor/data/Color.h"
+#include "carla/sensor/s11n/SensorHeaderSerializer.h"
 
 #include <cstdint>
 #include <cstring>
@@ -25,18 +27,84 @@ namespace s11n {
 
 #pragma pack(push, 1)
     struct ImageHeader {
+      /// Width in pixels of the image shipped in this message. When a
+      /// region of interest is set on the camera this is the width of the
+      /// cropped region, not of the full frame.
       uint32_t width;
+      /// Height in pixels of the image shipped in this message.
       uint32_t height;
       float fov_angle;
+      /// Column within the full frame where the shipped region starts.
+      uint32_t roi_offset_x;
+      /// Row within the full frame where the shipped region starts.
+      uint32_t roi_offset_y;
+      /// Width in pixels of the full frame rendered by the camera.
+      uint32_t full_width;
+      /// Height in pixels of the full frame rendered by the camera.
+      uint32_t full_height;
+      /// Zeroed padding keeping the pixel data on a Buffer::alignment
+      /// boundary, so image kernels can use aligned SIMD loads.
+      uint8_t padding[36u];
     };
 #pragma pack(pop)
 
     constexpr static auto header_offset = sizeof(ImageHeader);
 
+    static_assert(
+        (SensorHeaderSerializer::header_offset + header_offset) % Buffer::alignment == 0u,
+        "pixel data must start on an aligned boundary");
+
     static const ImageHeader &DeserializeHeader(const RawData &data) {
       return *reinterpret_cast<const ImageHeader *>(data.begin());
     }
 
+    /// Non-owning view of an image measurement, pointing into the buffer it
+    /// was created from. Creating it allocates nothing; unlike Deserialize,
+    /// the alpha channel travels as rendered instead of being forced to
+    /// opaque.
+    class View {
+    public:
+
+      const ImageHeader &GetHeader() const {
+        return *_header;
+      }
+
+      const data::Color *begin() const {
+        return _begin;
+      }
+
+      const data::Color *end() const {
+        return _end;
+      }
+
+      size_t size() const {
+        return static_cast<size_t>(_end - _begin);
+      }
+
+    private:
+
+      friend class ImageSerializer;
+
+      View(const ImageHeader *header, const data::Color *begin, const data::Color *end)
+        : _header(header), _begin(begin), _end(end) {}
+
+      const ImageHeader *_header;
+
+      const data::Color *_begin;
+
+      const data::Color *_end;
+    };
+
+    /// Fast path for high-rate consumers: view the pixels in place instead
+    /// of boxing them into a SensorData. @a data must be kept alive while
+    /// the view is in use.
+    static View DeserializeView(const RawData &data) {
+      return View{
+          &DeserializeHeader(data),
+          reinterpret_cast<const data::Color *>(data.begin() + header_offset),
+          reinterpret_cast<const data::Color *>(data.end())};
+    }
+
     template <typename Sensor>
     static Buffer Serialize(const Sensor &sensor, Buffer &&bitmap);
 
@@ -47,9 +115,13 @@ namespace s11n {
   inline Buffer ImageSerializer::Serialize(const Sensor &sensor, Buffer &&bitmap) {
     DEBUG_ASSERT(bitmap.size() > sizeof(ImageHeader));
     ImageHeader header = {
+      sensor.GetROIWidth(),
+      sensor.GetROIHeight(),
+      sensor.GetFOVAngle(),
+      sensor.GetROIOffsetX(),
+      sensor.GetROIOffsetY(),
       sensor.GetImageWidth(),
-      sensor.GetImageHeight(),
-      sensor.GetFOVAngle()
+      sensor.GetImageHeight()
     };
     std::memcpy(bitmap.data(), reinterpret_cast<const void *>(&header), sizeof(header));
     return std::move(bitmap);
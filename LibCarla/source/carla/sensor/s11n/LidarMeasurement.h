@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "carla/Buffer.h"
 #include "carla/rpc/Location.h"
 
 #include <cstdint>
@@ -23,9 +24,14 @@ namespace s11n {
   ///    {
   ///      Horizontal angle (float),
   ///      Channel count,
+  ///      Flags,
+  ///      Sector index,
+  ///      Sector count,
+  ///      Revolution id,
   ///      Point count of channel 0,
   ///      ...
   ///      Point count of channel n,
+  ///      Zeroed padding up to the next multiple of Buffer::alignment bytes,
   ///    }
   ///
   /// The points are stored in an array of floats
@@ -36,6 +42,15 @@ namespace s11n {
   ///      Xn, Yn, Zn,
   ///    }
   ///
+  /// or, if the quantized flag is set, in an array of int16_t's with the same
+  /// layout holding centimeters relative to the sensor. The serializer
+  /// dequantizes on arrival, so this only changes the wire format.
+  ///
+  /// If the semantic flag is set, an array of uint8_t's with the semantic tag
+  /// of each point (in the same order as the points, padded with zeroes up to
+  /// the next multiple of Buffer::alignment bytes) is inserted between the
+  /// header and the point array.
+  ///
   /// @warning WritePoint should be called sequentially in the order in which
   /// the points are going to be stored, i.e., starting at channel zero and
   /// increasing steadily.
@@ -48,14 +63,36 @@ namespace s11n {
     enum Index : size_t {
       HorizontalAngle,
       ChannelCount,
+      Flags,
+      SectorIndex,
+      SectorCount,
+      Revolution,
       SIZE
     };
 
   public:
 
+    /// Flag marking the points as 16-bit fixed point instead of floats.
+    static constexpr uint32_t quantized_flag = 0x1u;
+
+    /// Units per meter of the fixed-point format, i.e. centimeter resolution.
+    static constexpr float quantization_scale = 100.0f;
+
+    /// Flag marking the presence of a per-point semantic tag array.
+    static constexpr uint32_t semantic_flag = 0x2u;
+
+    /// Number of uint32_t's in the header of a measurement with @a
+    /// channel_count channels, including the zeroed padding that keeps the
+    /// point array on a Buffer::alignment boundary.
+    static constexpr size_t PaddedHeaderSize(uint32_t channel_count) {
+      return RoundUp(Index::SIZE + channel_count, Buffer::alignment / sizeof(uint32_t));
+    }
+
     explicit LidarMeasurement(uint32_t ChannelCount = 0u)
-      : _header(Index::SIZE + ChannelCount, 0u) {
+      : _header(PaddedHeaderSize(ChannelCount), 0u) {
       _header[Index::ChannelCount] = ChannelCount;
+      // A full-revolution measurement is its own single sector.
+      _header[Index::SectorCount] = 1u;
     }
 
     LidarMeasurement &operator=(LidarMeasurement &&) = default;
@@ -72,25 +109,96 @@ namespace s11n {
       return _header[Index::ChannelCount];
     }
 
+    /// Send the points as 16-bit fixed point, halving the bandwidth of the
+    /// stream at the cost of centimeter resolution.
+    void SetQuantized(bool quantized) {
+      if (quantized) {
+        _header[Index::Flags] |= quantized_flag;
+      } else {
+        _header[Index::Flags] &= ~quantized_flag;
+      }
+    }
+
+    bool IsQuantized() const {
+      return (_header[Index::Flags] & quantized_flag) != 0u;
+    }
+
+    /// Attach the semantic tag of each point to the measurement, one uint8_t
+    /// per point in point order.
+    void SetSemantic(bool semantic) {
+      if (semantic) {
+        _header[Index::Flags] |= semantic_flag;
+      } else {
+        _header[Index::Flags] &= ~semantic_flag;
+      }
+    }
+
+    bool HasSemanticTags() const {
+      return (_header[Index::Flags] & semantic_flag) != 0u;
+    }
+
+    /// Mark the measurement as sector @a index out of @a count fixed angular
+    /// sectors of revolution @a revolution. Sector streaming sensors ship
+    /// each sector as soon as its angular range completes instead of
+    /// accumulating a full turn.
+    void SetSector(uint32_t index, uint32_t count, uint32_t revolution) {
+      DEBUG_ASSERT(index < count);
+      _header[Index::SectorIndex] = index;
+      _header[Index::SectorCount] = count;
+      _header[Index::Revolution] = revolution;
+    }
+
+    uint32_t GetSectorIndex() const {
+      return _header[Index::SectorIndex];
+    }
+
+    uint32_t GetSectorCount() const {
+      return _header[Index::SectorCount];
+    }
+
+    uint32_t GetRevolution() const {
+      return _header[Index::Revolution];
+    }
+
+    /// Number of bytes of the tag array of a measurement with @a point_count
+    /// points, including the zeroed padding that keeps the point array on a
+    /// Buffer::alignment boundary.
+    static constexpr size_t PaddedTagArraySize(size_t point_count) {
+      return RoundUp(point_count, Buffer::alignment);
+    }
+
     void Reset(uint32_t total_point_count) {
       std::memset(_header.data() + Index::SIZE, 0, sizeof(uint32_t) * GetChannelCount());
       _points.clear();
       _points.reserve(3u * total_point_count);
+      _tags.clear();
+      if (HasSemanticTags()) {
+        _tags.reserve(total_point_count);
+      }
     }
 
-    void WritePoint(uint32_t channel, rpc::Location point) {
+    void WritePoint(uint32_t channel, rpc::Location point, uint8_t tag = 0u) {
       DEBUG_ASSERT(GetChannelCount() > channel);
       _header[Index::SIZE + channel] += 1u;
       _points.emplace_back(point.x);
       _points.emplace_back(point.y);
       _points.emplace_back(point.z);
+      if (HasSemanticTags()) {
+        _tags.emplace_back(tag);
+      }
     }
 
   private:
 
+    static constexpr size_t RoundUp(size_t value, size_t multiple) {
+      return ((value + multiple - 1u) / multiple) * multiple;
+    }
+
     std::vector<uint32_t> _header;
 
     std::vector<float> _points;
+
+    std::vector<uint8_t> _tags;
   };
 
 } // namespace s11n
@@ -8,11 +8,42 @@
 
 #include "carla/sensor/data/LidarMeasurement.h"
 
+#include <cstring>
+
 namespace carla {
 namespace sensor {
 namespace s11n {
 
+  RawData LidarSerializer::Dequantize(RawData &&data) {
+    using SensorHeader = SensorHeaderSerializer;
+    const auto point_offset = GetPointOffset(data);
+    const auto *src = reinterpret_cast<const int16_t *>(data.begin() + point_offset);
+    const auto component_count = (data.size() - point_offset) / sizeof(int16_t);
+    Buffer expanded(
+        SensorHeader::header_offset +
+        point_offset +
+        component_count * sizeof(float));
+    // Sensor header, lidar header, and semantic tags are unaffected by the
+    // quantization.
+    std::memcpy(
+        expanded.data(),
+        data._buffer.data(),
+        SensorHeader::header_offset + point_offset);
+    auto *dst = reinterpret_cast<float *>(
+        expanded.data() + SensorHeader::header_offset + point_offset);
+    for (auto i = 0u; i < component_count; ++i) {
+      dst[i] = static_cast<float>(src[i]) / LidarMeasurement::quantization_scale;
+    }
+    // Clear the flag, from here on the measurement holds plain floats.
+    auto *header = reinterpret_cast<uint32_t *>(expanded.data() + SensorHeader::header_offset);
+    header[LidarMeasurement::Index::Flags] &= ~LidarMeasurement::quantized_flag;
+    return RawData{std::move(expanded)};
+  }
+
   SharedPtr<SensorData> LidarSerializer::Deserialize(RawData &&data) {
+    if (DeserializeHeader(data).IsQuantized()) {
+      data = Dequantize(std::move(data));
+    }
     return SharedPtr<data::LidarMeasurement>(
         new data::LidarMeasurement{std::move(data)});
   }
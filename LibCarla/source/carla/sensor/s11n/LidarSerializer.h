@@ -11,6 +11,9 @@
 #include "carla/sensor/RawData.h"
 #include "carla/sensor/s11n/LidarMeasurement.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace carla {
 namespace sensor {
 
@@ -40,6 +43,43 @@ namespace s11n {
       return _begin[Index::SIZE + channel];
     }
 
+    /// Whether the points travel as 16-bit fixed point instead of floats.
+    bool IsQuantized() const {
+      return (_begin[Index::Flags] & LidarMeasurement::quantized_flag) != 0u;
+    }
+
+    /// Whether the measurement carries a semantic tag per point.
+    bool HasSemanticTags() const {
+      return (_begin[Index::Flags] & LidarMeasurement::semantic_flag) != 0u;
+    }
+
+    /// Index of this angular sector inside its revolution; zero unless the
+    /// sensor is streaming sectors.
+    uint32_t GetSectorIndex() const {
+      return _begin[Index::SectorIndex];
+    }
+
+    /// Number of fixed angular sectors per revolution; one for a classic
+    /// full-revolution measurement.
+    uint32_t GetSectorCount() const {
+      return _begin[Index::SectorCount];
+    }
+
+    /// Id of the revolution this sector belongs to, for reassembly.
+    uint32_t GetRevolution() const {
+      return _begin[Index::Revolution];
+    }
+
+    /// Total number of points, i.e. the sum of the point counts of every
+    /// channel.
+    size_t GetTotalPointCount() const {
+      size_t total = 0u;
+      for (auto channel = 0u; channel < GetChannelCount(); ++channel) {
+        total += GetPointCount(channel);
+      }
+      return total;
+    }
+
   private:
 
     friend class LidarSerializer;
@@ -65,7 +105,81 @@ namespace s11n {
 
     static size_t GetHeaderOffset(const RawData &data) {
       auto View = DeserializeHeader(data);
-      return sizeof(uint32_t) * (View.GetChannelCount() + LidarMeasurement::Index::SIZE);
+      return sizeof(uint32_t) * LidarMeasurement::PaddedHeaderSize(View.GetChannelCount());
+    }
+
+    /// Offset of the point array, i.e. the header plus the semantic tag
+    /// array when present.
+    static size_t GetPointOffset(const RawData &data) {
+      auto View = DeserializeHeader(data);
+      auto offset = sizeof(uint32_t) * LidarMeasurement::PaddedHeaderSize(View.GetChannelCount());
+      if (View.HasSemanticTags()) {
+        offset += LidarMeasurement::PaddedTagArraySize(View.GetTotalPointCount());
+      }
+      return offset;
+    }
+
+    /// Non-owning view of a lidar measurement, pointing into the buffer it
+    /// was created from.
+    class View {
+    public:
+
+      LidarHeaderView GetHeader() const {
+        return _header;
+      }
+
+      const rpc::Location *begin() const {
+        return _begin;
+      }
+
+      const rpc::Location *end() const {
+        return _end;
+      }
+
+      size_t size() const {
+        return static_cast<size_t>(_end - _begin);
+      }
+
+      /// Semantic tag of each point in point order, or nullptr when the
+      /// measurement does not carry tags.
+      const uint8_t *GetSemanticTags() const {
+        return _tags;
+      }
+
+    private:
+
+      friend class LidarSerializer;
+
+      View(
+          LidarHeaderView header,
+          const rpc::Location *begin,
+          const rpc::Location *end,
+          const uint8_t *tags)
+        : _header(header), _begin(begin), _end(end), _tags(tags) {}
+
+      LidarHeaderView _header;
+
+      const rpc::Location *_begin;
+
+      const rpc::Location *_end;
+
+      const uint8_t *_tags;
+    };
+
+    /// Fast path for high-rate consumers: view the points in place instead
+    /// of boxing them into a SensorData. @a data must be kept alive while
+    /// the view is in use.
+    ///
+    /// @warning Quantized streams cannot be viewed in place, use Deserialize
+    /// for those.
+    static View DeserializeView(const RawData &data) {
+      auto header = DeserializeHeader(data);
+      DEBUG_ASSERT(!header.IsQuantized());
+      return View{
+          header,
+          reinterpret_cast<const rpc::Location *>(data.begin() + GetPointOffset(data)),
+          reinterpret_cast<const rpc::Location *>(data.end()),
+          header.HasSemanticTags() ? data.begin() + GetHeaderOffset(data) : nullptr};
     }
 
     template <typename Sensor>
@@ -75,6 +189,19 @@ namespace s11n {
         Buffer &&output);
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
+
+  private:
+
+    static int16_t QuantizeComponent(float value) {
+      auto scaled = value * LidarMeasurement::quantization_scale;
+      scaled = std::max(-32768.0f, std::min(32767.0f, scaled));
+      return static_cast<int16_t>(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+    }
+
+    /// Rebuild @a data replacing the fixed-point points by floats and
+    /// clearing the quantized flag, so the resulting measurement is
+    /// indistinguishable from a non-quantized one.
+    static RawData Dequantize(RawData &&data);
   };
 
   // ===========================================================================
@@ -86,8 +213,29 @@ namespace s11n {
       const Sensor &,
       const LidarMeasurement &measurement,
       Buffer &&output) {
-    std::array<boost::asio::const_buffer, 2u> seq = {
+    // Zero-padded so the point array stays on an alignment boundary; empty
+    // when the measurement carries no tags.
+    std::vector<uint8_t> tags;
+    if (measurement.HasSemanticTags()) {
+      tags.resize(LidarMeasurement::PaddedTagArraySize(measurement._tags.size()), 0u);
+      std::copy(measurement._tags.begin(), measurement._tags.end(), tags.begin());
+    }
+    if (measurement.IsQuantized()) {
+      std::vector<int16_t> quantized;
+      quantized.reserve(measurement._points.size());
+      for (auto component : measurement._points) {
+        quantized.emplace_back(QuantizeComponent(component));
+      }
+      std::array<boost::asio::const_buffer, 3u> seq = {
+          boost::asio::buffer(measurement._header),
+          boost::asio::buffer(tags),
+          boost::asio::buffer(quantized)};
+      output.copy_from(seq);
+      return std::move(output);
+    }
+    std::array<boost::asio::const_buffer, 3u> seq = {
         boost::asio::buffer(measurement._header),
+        boost::asio::buffer(tags),
         boost::asio::buffer(measurement._points)};
     output.copy_from(seq);
     return std::move(output);
@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include "carla/Buffer.h"
+
+#include <algorithm>
 #include <cstdint>
-#include <vector>
-#include <cstdio>
+#include <cstring>
 
 namespace carla {
 namespace sensor {
@@ -21,6 +23,9 @@ namespace s11n {
     float depth;    // m
   };
 
+  /// Accumulates the detections of a frame directly into a Buffer, usually
+  /// one popped from the stream's BufferPool, so the serializer can hand the
+  /// buffer over without an extra copy.
   class RadarData {
     static_assert(sizeof(float) == sizeof(uint32_t), "Invalid float size");
     static_assert(sizeof(float) * 4 == sizeof(RadarDetection), "Invalid RadarDetection size");
@@ -35,37 +40,52 @@ namespace s11n {
 
     RadarData &operator=(RadarData &&) = default;
 
-    /// Set a new resolution for the RadarData.
-    /// Allocates / Deallocates space in memory if needed.
-    ///
-    /// @warning This is expensive, not to be called each tick!
+    /// Set the initial per-frame reserve, in detections. After the first
+    /// frame the reserve follows the detection count of the previous frame.
     void SetResolution(uint32_t resolution) {
-      // Remove the capacity of the vector to zero
-      _detections.clear();
-      _detections.shrink_to_fit();
-      // Set the new vector's capacity
-      _detections.reserve(resolution);
+      _reserve = resolution;
     }
 
     /// Returns the number of current detections.
     size_t GetDetectionCount() const {
-      return _detections.size();
+      return _count;
+    }
+
+    /// Number of detections the next frame's buffer is reserved for, based
+    /// on the detection count of the last non-empty frame.
+    size_t GetReserve() const {
+      return _reserve;
     }
 
-    /// Deletes the current detections.
-    /// It doesn't change the resolution nor the allocated memory.
-    void Reset() {
-      _detections.clear();
+    /// Adopt @a buffer as the destination for this frame's detections and
+    /// delete the previous ones. The buffer is sized from the reserve,
+    /// detections beyond it grow it geometrically.
+    void Reset(Buffer &&buffer) {
+      if (_count > 0u) {
+        _reserve = _count;
+      }
+      _buffer = std::move(buffer);
+      _buffer.reset(static_cast<Buffer::size_type>(_reserve * detection_size));
+      _count = 0u;
     }
 
     /// Adds a new detection.
     void WriteDetection(RadarDetection detection) {
-      _detections.push_back(detection);
+      const size_t offset = _count * detection_size;
+      if (offset + detection_size > _buffer.size()) {
+        _buffer.resize((std::max)(2u * _buffer.size(), static_cast<Buffer::size_type>(detection_size)));
+      }
+      std::memcpy(_buffer.data() + offset, &detection, detection_size);
+      ++_count;
     }
 
   private:
 
-    std::vector<RadarDetection> _detections;
+    Buffer _buffer;
+
+    size_t _count = 0u;
+
+    size_t _reserve = 0u;
   };
 
 } // namespace s11n
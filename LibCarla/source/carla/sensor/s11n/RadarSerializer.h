@@ -31,8 +31,7 @@ namespace s11n {
     template <typename Sensor>
     static Buffer Serialize(
         const Sensor &sensor,
-        const RadarData &measurement,
-        Buffer &&output);
+        RadarData &&measurement);
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
   };
@@ -40,10 +39,12 @@ namespace s11n {
   template <typename Sensor>
   inline Buffer RadarSerializer::Serialize(
       const Sensor &,
-      const RadarData &measurement,
-      Buffer &&output) {
-    output.copy_from(measurement._detections);
-    return std::move(output);
+      RadarData &&measurement) {
+    // The detections were already written into the measurement's buffer,
+    // trim it to the detections actually produced and hand it over.
+    auto buffer = std::move(measurement._buffer);
+    buffer.resize(measurement._count * RadarData::detection_size);
+    return buffer;
   }
 
 } // namespace s11n
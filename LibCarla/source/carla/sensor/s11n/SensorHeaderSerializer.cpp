@@ -13,11 +13,11 @@ namespace sensor {
 namespace s11n {
 
   static_assert(
-      SensorHeaderSerializer::header_offset == 3u * 8u + 6u * 4u,
+      SensorHeaderSerializer::header_offset == 64u,
       "Header size missmatch");
 
   static Buffer PopBufferFromPool() {
-    static auto pool = std::make_shared<BufferPool>();
+    static auto pool = std::make_shared<BufferPool>("sensor headers");
     return pool->Pop();
   }
 
@@ -25,12 +25,14 @@ namespace s11n {
       const uint64_t index,
       const uint64_t frame,
       double timestamp,
-      const rpc::Transform transform) {
-    Header h;
+      const rpc::Transform transform,
+      const uint64_t stream_sub_id) {
+    Header h = {};
     h.sensor_type = index;
     h.frame = frame;
     h.timestamp = timestamp;
     h.sensor_transform = transform;
+    h.stream_sub_id = stream_sub_id;
     auto buffer = PopBufferFromPool();
     buffer.copy_from(reinterpret_cast<const unsigned char *>(&h), sizeof(h));
     return buffer;
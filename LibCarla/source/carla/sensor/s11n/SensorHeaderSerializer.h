@@ -23,16 +23,29 @@ namespace s11n {
       uint64_t frame;
       double timestamp;
       rpc::Transform sensor_transform;
+      /// Sub-stream id the sensor wrote this measurement under, zero unless
+      /// its stream is part of a multiplexed group; the client routes the
+      /// measurement to the right subscriber by it, see
+      /// streaming::detail::Dispatcher::MakeMultiplexedStream.
+      uint64_t stream_sub_id;
+      /// Zeroed padding keeping the serializer-specific data that follows
+      /// this header on a Buffer::alignment boundary.
+      uint8_t padding[8u];
     };
 #pragma pack(pop)
 
     constexpr static auto header_offset = sizeof(Header);
 
+    static_assert(
+        header_offset % Buffer::alignment == 0u,
+        "sensor data must start on an aligned boundary");
+
     static Buffer Serialize(
         uint64_t index,
         uint64_t frame,
         double timestamp,
-        rpc::Transform transform);
+        rpc::Transform transform,
+        uint64_t stream_sub_id = 0u);
 
     static const Header &Deserialize(const Buffer &message) {
       return *reinterpret_cast<const Header *>(message.data());
@@ -33,6 +33,11 @@ namespace streaming {
       _service.Stop();
     }
 
+    /// @copydoc low_level::Client::SetSubStreamIdExtractor()
+    void SetSubStreamIdExtractor(std::function<uint64_t(const Buffer &)> extractor) {
+      _client.SetSubStreamIdExtractor(std::move(extractor));
+    }
+
     /// @warning cannot subscribe twice to the same stream (even if it's a
     /// MultiStream).
     template <typename Functor>
@@ -6,12 +6,16 @@
 
 #pragma once
 
+#include "carla/Numa.h"
 #include "carla/ThreadPool.h"
 #include "carla/streaming/detail/tcp/Server.h"
 #include "carla/streaming/low_level/Server.h"
 
 #include <boost/asio/io_context.hpp>
 
+#include <memory>
+#include <vector>
+
 namespace carla {
 namespace streaming {
 
@@ -48,29 +52,148 @@ namespace streaming {
       _server.SetTimeout(timeout);
     }
 
+    /// Publish streams created from now on through a shared-memory ring
+    /// instead of TCP, skipping the loopback copies when the client runs on
+    /// the same host.
+    ///
+    /// @warning Clients on other hosts cannot subscribe to these streams.
+    void EnableSharedMemory() {
+      _server.EnableSharedMemory();
+    }
+
+    /// Enable the UDP transport, opening a datagram socket on the same port
+    /// as the stream server. Streams created with MakeUdpStream or
+    /// MakeUdpMultiStream publish over it.
+    void EnableUdp() {
+      auto udp_server = std::make_shared<detail::udp::Server>(
+          _pool.io_context(),
+          boost::asio::ip::udp::endpoint(
+              boost::asio::ip::udp::v4(),
+              GetLocalEndpoint().port()));
+      udp_server->Listen();
+      _server.SetUdpServer(std::move(udp_server));
+    }
+
+    /// @copydoc detail::Dispatcher::SetStreamIdNamespace()
+    void SetStreamIdNamespace(uint8_t ns) {
+      _server.SetStreamIdNamespace(ns);
+    }
+
     Stream MakeStream() {
       return _server.MakeStream();
     }
 
+    /// @copydoc detail::Dispatcher::MakeStream(detail::stream_id_type)
+    boost::optional<Stream> MakeStream(detail::stream_id_type stream_id) {
+      return _server.MakeStream(stream_id);
+    }
+
+    /// @copydoc detail::Dispatcher::MakeMultiplexedStream()
+    Stream MakeMultiplexedStream() {
+      return _server.MakeMultiplexedStream();
+    }
+
+    /// @copydoc detail::Dispatcher::MakeMultiplexedStream(const carla::streaming::Stream &)
+    Stream MakeMultiplexedStream(const Stream &group) {
+      return _server.MakeMultiplexedStream(group);
+    }
+
     MultiStream MakeMultiStream() {
       return _server.MakeMultiStream();
     }
 
+    /// Like MakeStream, but messages travel as unreliable datagrams: they can
+    /// be lost or reordered, and each message must fit a single datagram. Use
+    /// for high-rate low-value telemetry where freshness beats completeness.
+    /// Requires EnableUdp().
+    Stream MakeUdpStream() {
+      return _server.MakeUdpStream();
+    }
+
+    /// @copydoc MakeUdpStream()
+    MultiStream MakeUdpMultiStream() {
+      return _server.MakeUdpMultiStream();
+    }
+
+    /// @copydoc detail::Dispatcher::CountStreams()
+    detail::Dispatcher::MapStats CountStreams() {
+      return _server.CountStreams();
+    }
+
+    /// Shard the sessions across @a number_of_shards io_contexts with one
+    /// worker thread each, so heavy streams don't contend on a single
+    /// reactor. If @a pin_threads, each shard worker is pinned to a CPU
+    /// (Linux only). Must be called before any client connects.
+    void EnableSharding(size_t number_of_shards, bool pin_threads = false) {
+      DEBUG_ASSERT(number_of_shards > 0u);
+      _pin_shard_threads = pin_threads;
+      _shards.clear();
+      std::vector<boost::asio::io_context *> contexts;
+      for (size_t i = 0u; i < number_of_shards; ++i) {
+        _shards.emplace_back(std::make_unique<ThreadPool>());
+        contexts.emplace_back(&_shards.back()->io_context());
+      }
+      _server.SetSessionShards(std::move(contexts));
+    }
+
+    /// Place every worker of this server (main pool and shards) on NUMA node
+    /// @a node, so stream buffers are first-touched, and thus allocated, on
+    /// the same node as the NIC they are sent from. Shard pinning, if
+    /// enabled, picks CPUs of that node. Must be called before Run or
+    /// AsyncRun; no-op if the topology is unknown, see carla::Numa.
+    void SetNumaNode(size_t node) {
+      _numa_node = static_cast<int64_t>(node);
+    }
+
     void Run() {
+      LaunchShards();
+      if (_numa_node >= 0) {
+        Numa::PinThisThreadToNode(static_cast<size_t>(_numa_node));
+      }
       _pool.Run();
     }
 
     void AsyncRun(size_t worker_threads) {
-      _pool.AsyncRun(worker_threads);
+      LaunchShards();
+      if (_numa_node >= 0) {
+        _pool.AsyncRunOnNode(worker_threads, static_cast<size_t>(_numa_node));
+      } else {
+        _pool.AsyncRun(worker_threads);
+      }
     }
 
   private:
 
+    void LaunchShards() {
+      const auto node_cpus = (_numa_node >= 0)
+          ? Numa::GetNodeCpus(static_cast<size_t>(_numa_node))
+          : std::vector<size_t>();
+      size_t cpu = 0u;
+      for (auto &shard : _shards) {
+        if (_pin_shard_threads) {
+          const auto next = cpu++;
+          shard->AsyncRunPinned(
+              1u, node_cpus.empty() ? next : node_cpus[next % node_cpus.size()]);
+        } else if (_numa_node >= 0) {
+          shard->AsyncRunOnNode(1u, static_cast<size_t>(_numa_node));
+        } else {
+          shard->AsyncRun(1u);
+        }
+      }
+    }
+
     // The order of these two arguments is very important.
 
     ThreadPool _pool;
 
     underlying_server _server;
+
+    std::vector<std::unique_ptr<ThreadPool>> _shards;
+
+    bool _pin_shard_threads = false;
+
+    /// NUMA node the workers are placed on, negative when unset.
+    int64_t _numa_node = -1;
   };
 
 } // namespace streaming
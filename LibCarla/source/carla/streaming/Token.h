@@ -17,7 +17,7 @@ namespace streaming {
   class Token {
   public:
 
-    std::array<unsigned char, 24u> data;
+    std::array<unsigned char, 26u> data;
 
     MSGPACK_DEFINE_ARRAY(data);
   };
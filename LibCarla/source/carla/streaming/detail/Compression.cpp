@@ -0,0 +1,98 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/Compression.h"
+
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(LIBCARLA_STREAMING_WITH_ZLIB_SUPPORT) && LIBCARLA_STREAMING_WITH_ZLIB_SUPPORT
+#  include <zlib.h>
+#  define LIBCARLA_HAS_ZLIB
+#endif
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  bool compression_is_supported() {
+#ifdef LIBCARLA_HAS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+  }
+
+#ifdef LIBCARLA_HAS_ZLIB
+
+  static int GetCompressionLevel(CompressionType type) {
+    return type == CompressionType::high ? 6 : 1;
+  }
+
+  Buffer Compress(const Buffer &input, const CompressionType type) {
+    if (type == CompressionType::none || input.empty()) {
+      return Buffer();
+    }
+    const uint64_t uncompressed_size = input.size();
+    uLongf compressed_size = ::compressBound(static_cast<uLong>(uncompressed_size));
+    Buffer output(static_cast<uint64_t>(compressed_size) + sizeof(uncompressed_size));
+    const int result = ::compress2(
+        reinterpret_cast<Bytef *>(output.data() + sizeof(uncompressed_size)),
+        &compressed_size,
+        reinterpret_cast<const Bytef *>(input.data()),
+        static_cast<uLong>(uncompressed_size),
+        GetCompressionLevel(type));
+    if (result != Z_OK) {
+      log_warning("compression failed with code", result, ": sending uncompressed");
+      return Buffer();
+    }
+    if (compressed_size + sizeof(uncompressed_size) >= uncompressed_size) {
+      // Incompressible payload, not worth the client-side inflate.
+      return Buffer();
+    }
+    std::memcpy(output.data(), &uncompressed_size, sizeof(uncompressed_size));
+    output.resize(static_cast<uint64_t>(compressed_size) + sizeof(uncompressed_size));
+    return output;
+  }
+
+  Buffer Decompress(Buffer &&input) {
+    uint64_t uncompressed_size = 0u;
+    if (input.size() < sizeof(uncompressed_size)) {
+      throw_exception(std::runtime_error("corrupted compressed message"));
+    }
+    std::memcpy(&uncompressed_size, input.data(), sizeof(uncompressed_size));
+    Buffer output(uncompressed_size);
+    uLongf actual_size = static_cast<uLongf>(uncompressed_size);
+    const int result = ::uncompress(
+        reinterpret_cast<Bytef *>(output.data()),
+        &actual_size,
+        reinterpret_cast<const Bytef *>(input.data() + sizeof(uncompressed_size)),
+        static_cast<uLong>(input.size() - sizeof(uncompressed_size)));
+    if ((result != Z_OK) || (actual_size != uncompressed_size)) {
+      throw_exception(std::runtime_error("failed to decompress message"));
+    }
+    return output;
+  }
+
+#else // LIBCARLA_HAS_ZLIB
+
+  Buffer Compress(const Buffer &, CompressionType) {
+    return Buffer();
+  }
+
+  Buffer Decompress(Buffer &&) {
+    throw_exception(std::runtime_error(
+        "received a compressed message but this build has no compression support"));
+  }
+
+#endif // LIBCARLA_HAS_ZLIB
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -0,0 +1,50 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+
+#include <cstdint>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  /// Per-stream compression mode. Compressed messages are flagged in the
+  /// message size prefix so the receiving end detects them without any
+  /// handshake.
+  enum class CompressionType : uint8_t {
+    none = 0u,
+
+    /// Fastest setting, meant for big payloads sent at sensor rate (images,
+    /// lidar).
+    fast,
+
+    /// Higher ratio at a higher CPU cost, meant for bandwidth-bound remote
+    /// deployments.
+    high
+  };
+
+  /// Whether this build has compression support, if false Compress is a
+  /// pass-through.
+  bool compression_is_supported();
+
+  /// Compress @a input into a buffer popped from the pool of @a output. The
+  /// uncompressed size is prepended so the receiving end can allocate the
+  /// exact amount. Returns an empty buffer if @a input is incompressible or
+  /// compression is unsupported, in which case @a input should be sent as is.
+  Buffer Compress(const Buffer &input, CompressionType type);
+
+  /// Decompress a buffer generated by Compress.
+  ///
+  /// @throw std::runtime_error if this build lacks compression support or the
+  /// buffer is corrupted.
+  Buffer Decompress(Buffer &&input);
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -8,8 +8,10 @@
 
 #include "carla/Exception.h"
 #include "carla/Logging.h"
+#include "carla/profiler/Tracer.h"
 #include "carla/streaming/detail/MultiStreamState.h"
 #include "carla/streaming/detail/StreamState.h"
+#include "carla/streaming/detail/udp/Server.h"
 
 #include <exception>
 
@@ -17,80 +19,217 @@ namespace carla {
 namespace streaming {
 namespace detail {
 
-  template <typename StreamStateT, typename StreamMapT>
-  static auto MakeStreamState(const token_type &cached_token, StreamMapT &stream_map) {
-    auto ptr = std::make_shared<StreamStateT>(cached_token);
-    auto result = stream_map.emplace(std::make_pair(cached_token.get_stream_id(), ptr));
-    if (!result.second) {
-      throw_exception(std::runtime_error("failed to create stream!"));
-    }
-    return ptr;
-  }
+  constexpr size_t Dispatcher::number_of_shards;
 
   Dispatcher::~Dispatcher() {
     // Disconnect all the sessions from their streams, this should kill any
     // session remaining since at this point the io_context should be already
     // stopped.
-    for (auto &pair : _stream_map) {
+    for (auto &shard : _shards) {
+      for (auto &pair : shard.streams) {
 #ifndef LIBCARLA_NO_EXCEPTIONS
-      try {
+        try {
 #endif // LIBCARLA_NO_EXCEPTIONS
-        auto stream_state = pair.second.lock();
-        if (stream_state != nullptr) {
-          stream_state->ClearSessions();
-        }
+          auto stream_state = pair.second.lock();
+          if (stream_state != nullptr) {
+            stream_state->ClearSessions();
+          }
 #ifndef LIBCARLA_NO_EXCEPTIONS
-      } catch (const std::exception &e) {
-        log_error("failed to clear sessions:", e.what());
-      }
+        } catch (const std::exception &e) {
+          log_error("failed to clear sessions:", e.what());
+        }
 #endif // LIBCARLA_NO_EXCEPTIONS
+      }
     }
   }
 
-  carla::streaming::Stream Dispatcher::MakeStream() {
+  std::shared_ptr<StreamStateBase> Dispatcher::FindStreamState(stream_id_type stream_id) {
+    auto &shard = GetShard(stream_id);
+    std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+    auto search = shard.streams.find(stream_id);
+    if (search != shard.streams.end()) {
+      return search->second.lock();
+    }
+    return nullptr;
+  }
+
+  bool Dispatcher::InsertStreamState(const std::shared_ptr<StreamStateBase> &state) {
+    const auto stream_id = state->get_stream_id();
+    auto &shard = GetShard(stream_id);
+    std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+    auto search = shard.streams.find(stream_id);
+    if (search != shard.streams.end()) {
+      if (!search->second.expired()) {
+        return false;
+      }
+      shard.streams.erase(search);
+    }
+    shard.streams.emplace(stream_id, state);
+    return true;
+  }
+
+  template <typename StreamStateT>
+  std::shared_ptr<StreamStateT> Dispatcher::MakeStreamState(const token_type &token) {
+    auto ptr = std::make_shared<StreamStateT>(token);
+    if (!InsertStreamState(ptr)) {
+      throw_exception(std::runtime_error("failed to create stream!"));
+    }
+    return ptr;
+  }
+
+  void Dispatcher::EnableSharedMemory() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cached_token._token.protocol = token_data::protocol::shm;
+  }
+
+  void Dispatcher::SetStreamIdNamespace(uint8_t ns) {
+    DEBUG_ASSERT(ns <= stream_id_namespace_max);
     std::lock_guard<std::mutex> lock(_mutex);
-    ++_cached_token._token.stream_id; // id zero only happens in overflow.
-    return MakeStreamState<StreamState>(_cached_token, _stream_map);
+    _stream_id_namespace = ns;
+  }
+
+  stream_id_type Dispatcher::MakeNextStreamId() {
+    auto &next = _next_stream_ids[_stream_id_namespace];
+    next = (next + 1u) & stream_id_namespace_id_mask;
+    if (next == 0u) {
+      ++next; // id zero only happens in overflow.
+    }
+    return (static_cast<stream_id_type>(_stream_id_namespace) << stream_id_namespace_shift) | next;
+  }
+
+  carla::streaming::Stream Dispatcher::MakeStream() {
+    token_type token;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      token = _cached_token;
+      token._token.stream_id = MakeNextStreamId();
+    }
+    return MakeStreamState<StreamState>(token);
+  }
+
+  boost::optional<carla::streaming::Stream> Dispatcher::MakeStream(stream_id_type stream_id) {
+    token_type token;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      token = _cached_token;
+    }
+    token._token.stream_id = stream_id;
+    auto ptr = std::make_shared<StreamState>(token);
+    if (!InsertStreamState(ptr)) {
+      log_error("stream id", stream_id, "already in use on this server");
+      return boost::none;
+    }
+    return carla::streaming::Stream(ptr);
+  }
+
+  carla::streaming::Stream Dispatcher::MakeMultiplexedStream() {
+    auto stream = MakeStream();
+    stream._token._token.sub_stream_id = stream._shared_state->MakeNextSubStreamId();
+    return stream;
+  }
+
+  carla::streaming::Stream Dispatcher::MakeMultiplexedStream(const carla::streaming::Stream &group) {
+    // a plain stream cannot join a group retroactively, tokens already
+    // handed out would receive the whole group unfiltered
+    DEBUG_ASSERT(group._token.is_multiplexed());
+    auto stream = group;
+    stream._token._token.sub_stream_id = stream._shared_state->MakeNextSubStreamId();
+    return stream;
   }
 
   carla::streaming::MultiStream Dispatcher::MakeMultiStream() {
+    token_type token;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      token = _cached_token;
+      token._token.stream_id = MakeNextStreamId();
+    }
+    return MakeStreamState<MultiStreamState>(token);
+  }
+
+  void Dispatcher::SetUdpServer(std::shared_ptr<udp::Server> udp_server) {
     std::lock_guard<std::mutex> lock(_mutex);
-    ++_cached_token._token.stream_id; // id zero only happens in overflow.
-    return MakeStreamState<MultiStreamState>(_cached_token, _stream_map);
+    _udp_server = std::move(udp_server);
+  }
+
+  carla::streaming::Stream Dispatcher::MakeUdpStream() {
+    token_type token;
+    std::shared_ptr<udp::Server> udp_server;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_udp_server == nullptr) {
+        throw_exception(std::runtime_error("UDP transport not enabled on this server"));
+      }
+      udp_server = _udp_server;
+      token = _cached_token;
+      token._token.stream_id = MakeNextStreamId();
+    }
+    token._token.protocol = token_data::protocol::udp;
+    auto ptr = MakeStreamState<StreamState>(token);
+    ptr->SetUdpServer(std::move(udp_server));
+    return ptr;
+  }
+
+  carla::streaming::MultiStream Dispatcher::MakeUdpMultiStream() {
+    token_type token;
+    std::shared_ptr<udp::Server> udp_server;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_udp_server == nullptr) {
+        throw_exception(std::runtime_error("UDP transport not enabled on this server"));
+      }
+      udp_server = _udp_server;
+      token = _cached_token;
+      token._token.stream_id = MakeNextStreamId();
+    }
+    token._token.protocol = token_data::protocol::udp;
+    auto ptr = MakeStreamState<MultiStreamState>(token);
+    ptr->SetUdpServer(std::move(udp_server));
+    return ptr;
   }
 
   bool Dispatcher::RegisterSession(std::shared_ptr<Session> session) {
+    CARLA_TRACE_SCOPE(streaming, DispatcherRegisterSession);
     DEBUG_ASSERT(session != nullptr);
-    std::lock_guard<std::mutex> lock(_mutex);
-    auto search = _stream_map.find(session->get_stream_id());
-    if (search != _stream_map.end()) {
-      auto stream_state = search->second.lock();
-      if (stream_state != nullptr) {
-        stream_state->ConnectSession(std::move(session));
-        return true;
-      }
+    // Reader lock only; the stream state handles its own synchronization.
+    auto stream_state = FindStreamState(session->get_stream_id());
+    if (stream_state != nullptr) {
+      stream_state->ConnectSession(std::move(session));
+      return true;
     }
     log_error("Invalid session: no stream available with id", session->get_stream_id());
     return false;
   }
 
-  void Dispatcher::DeregisterSession(std::shared_ptr<Session> session) {
-    DEBUG_ASSERT(session != nullptr);
-    std::lock_guard<std::mutex> lock(_mutex);
-    ClearExpiredStreams();
-    auto search = _stream_map.find(session->get_stream_id());
-    if (search != _stream_map.end()) {
-      auto stream_state = search->second.lock();
-      if (stream_state != nullptr) {
-        stream_state->DisconnectSession(session);
+  Dispatcher::MapStats Dispatcher::CountStreams() {
+    MapStats stats;
+    for (auto &shard : _shards) {
+      std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+      stats.map_entries += shard.streams.size();
+      for (auto &pair : shard.streams) {
+        if (!pair.second.expired()) {
+          ++stats.alive_streams;
+        }
       }
     }
+    return stats;
   }
 
-  void Dispatcher::ClearExpiredStreams() {
-    for (auto it = _stream_map.begin(); it != _stream_map.end(); ) {
+  void Dispatcher::DeregisterSession(std::shared_ptr<Session> session) {
+    DEBUG_ASSERT(session != nullptr);
+    const auto stream_id = session->get_stream_id();
+    auto stream_state = FindStreamState(stream_id);
+    if (stream_state != nullptr) {
+      stream_state->DisconnectSession(std::move(session));
+      return;
+    }
+    // The stream is gone, prune whatever expired in its shard so the maps do
+    // not accumulate dead entries across episodes.
+    auto &shard = GetShard(stream_id);
+    std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+    for (auto it = shard.streams.begin(); it != shard.streams.end(); ) {
       if (it->second.expired()) {
-        it = _stream_map.erase(it);
+        it = shard.streams.erase(it);
       } else {
         ++it;
       }
@@ -11,8 +11,12 @@
 #include "carla/streaming/detail/Session.h"
 #include "carla/streaming/detail/Token.h"
 
+#include <boost/optional.hpp>
+
+#include <array>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace carla {
@@ -21,6 +25,10 @@ namespace detail {
 
   class StreamStateBase;
 
+namespace udp {
+  class Server;
+} // namespace udp
+
   /// Keeps the mapping between streams and sessions.
   class Dispatcher {
   public:
@@ -31,27 +39,124 @@ namespace detail {
 
     ~Dispatcher();
 
+    /// Mark the tokens of streams created from now on as shared-memory
+    /// streams. Payloads will be published on a shared-memory ring instead of
+    /// being sent through the sessions.
+    ///
+    /// @warning Only clients running on the same host can subscribe to
+    /// shared-memory streams.
+    void EnableSharedMemory();
+
+    /// Allocate the ids of streams created from now on under namespace
+    /// @a ns, see stream_id_namespace_shift. Each namespace keeps its own id
+    /// counter, so stream sources configured with different namespaces
+    /// (e.g. concurrent episodes in one process) never hand out colliding
+    /// tokens. Namespace zero, the default, preserves the original id
+    /// sequence.
+    void SetStreamIdNamespace(uint8_t ns);
+
     carla::streaming::Stream MakeStream();
 
+    /// Open a stream under an id assigned by another server. Used by
+    /// secondary renderers to publish a sensor stream whose token was handed
+    /// out by a primary simulator.
+    ///
+    /// Returns empty if a stream with this id is still alive on this server.
+    boost::optional<carla::streaming::Stream> MakeStream(stream_id_type stream_id);
+
     carla::streaming::MultiStream MakeMultiStream();
 
+    /// Open a stream that multiplexes its messages over a shared session
+    /// instead of owning one: every stream made with the overload below
+    /// joins this stream's group. Streams of a group share a single session
+    /// (one connection and queue) per subscribed client, but each has its
+    /// own token; the producer stamps each message with its sub-stream id
+    /// so the subscribing end can demultiplex, see
+    /// low_level::Client::SetSubStreamIdExtractor.
+    ///
+    /// @warning A client subscribed to any stream of a group receives the
+    /// messages of the whole group on the wire, the filtering happens
+    /// client-side.
+    carla::streaming::Stream MakeMultiplexedStream();
+
+    /// Open a stream in @a group's multiplexed group, sharing its session.
+    carla::streaming::Stream MakeMultiplexedStream(const carla::streaming::Stream &group);
+
+    /// Install the datagram transport used by UDP streams.
+    void SetUdpServer(std::shared_ptr<udp::Server> udp_server);
+
+    /// Like MakeStream, but the stream publishes over unreliable datagrams.
+    /// Requires a udp::Server to be installed.
+    carla::streaming::Stream MakeUdpStream();
+
+    /// @copydoc MakeUdpStream()
+    carla::streaming::MultiStream MakeUdpMultiStream();
+
     bool RegisterSession(std::shared_ptr<Session> session);
 
     void DeregisterSession(std::shared_ptr<Session> session);
 
-  private:
+    /// Occupancy of the stream map, for soak monitoring.
+    struct MapStats {
+      /// Streams still alive.
+      size_t alive_streams = 0u;
+      /// Map entries, alive plus expired ones not yet pruned.
+      size_t map_entries = 0u;
+    };
 
-    void ClearExpiredStreams();
+    MapStats CountStreams();
+
+  private:
 
-    // We use a mutex here, but we assume that sessions and streams won't be
-    // created too often.
+    /// Streams are partitioned by id across independently locked shards, and
+    /// lookups take only a shared (reader) lock on their shard: session
+    /// (dis)connections outnumber stream creation by far, and a sensor
+    /// connect burst at episode start fans out across the shards instead of
+    /// serializing on a single lock. The stream states themselves are
+    /// thread-safe, no lock is held while connecting a session to one.
+    struct Shard {
+      std::shared_timed_mutex mutex;
+      std::unordered_map<
+          stream_id_type,
+          std::weak_ptr<StreamStateBase>> streams;
+    };
+
+    static constexpr size_t number_of_shards = 16u;
+
+    Shard &GetShard(stream_id_type stream_id) {
+      return _shards[stream_id % number_of_shards];
+    }
+
+    /// Look up the state of an alive stream, holding its shard's reader lock
+    /// only for the duration of the lookup. Returns nullptr if the stream
+    /// does not exist or already expired.
+    std::shared_ptr<StreamStateBase> FindStreamState(stream_id_type stream_id);
+
+    /// Insert @a state under its writer lock, displacing an expired entry
+    /// with the same id if there is one. Returns false if the id is taken by
+    /// an alive stream.
+    bool InsertStreamState(const std::shared_ptr<StreamStateBase> &state);
+
+    template <typename StreamStateT>
+    std::shared_ptr<StreamStateT> MakeStreamState(const token_type &token);
+
+    /// Next id of the active namespace. Call with _mutex held.
+    stream_id_type MakeNextStreamId();
+
+    // Guards the token (and its embedded stream id counter) and the UDP
+    // server, not the stream map; stream creation is rare.
     std::mutex _mutex;
 
     token_type _cached_token;
 
-    std::unordered_map<
-        stream_id_type,
-        std::weak_ptr<StreamStateBase>> _stream_map;
+    uint8_t _stream_id_namespace = 0u;
+
+    /// Id counter of each namespace used so far, see MakeNextStreamId.
+    std::unordered_map<uint8_t, stream_id_type> _next_stream_ids;
+
+    std::shared_ptr<udp::Server> _udp_server;
+
+    std::array<Shard, number_of_shards> _shards;
   };
 
 } // namespace detail
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include "carla/EpochList.h"
 #include "carla/streaming/detail/StreamStateBase.h"
 
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -17,7 +20,12 @@ namespace detail {
 
   /// A stream state that can hold any number of sessions.
   ///
-  /// @todo Lacking some optimization.
+  /// The session list is an RCU-style EpochList, so writing does not
+  /// serialize the fan-out under a lock and (dis)connection storms append or
+  /// unlink a single node instead of copying the whole list: each session
+  /// receives a reference to the same shared message and queues it
+  /// independently on its own strand, and a slow subscriber only ever stalls
+  /// its own queue.
   class MultiStreamState final : public StreamStateBase {
   public:
 
@@ -25,12 +33,47 @@ namespace detail {
 
     template <typename... Buffers>
     void Write(Buffers &&... buffers) {
-      auto message = Session::MakeMessage(std::move(buffers)...);
-      std::lock_guard<std::mutex> lock(_mutex);
-      for (auto &session : _sessions) {
-        if (session != nullptr) {
-          session->Write(message);
-        }
+      auto message = MakeMessage(std::move(buffers)...);
+      if (IsSharedMemoryStream()) {
+        WriteToSharedMemory(message);
+        return;
+      }
+      if (IsUdpStream()) {
+        WriteToUdp(message);
+        return;
+      }
+      PushToReplay(message);
+      const auto sessions = _sessions.Load();
+      for (const auto &session : sessions) {
+        session->Write(message);
+      }
+    }
+
+    void SetQueuePolicy(QueuePolicy policy, size_t max_queue_depth) final {
+      StreamStateBase::SetQueuePolicy(policy, max_queue_depth);
+      const auto sessions = _sessions.Load();
+      for (const auto &session : sessions) {
+        ConfigureSession(*session);
+      }
+    }
+
+    void SetCoalescing(size_t max_bytes, size_t max_delay_us) final {
+      StreamStateBase::SetCoalescing(max_bytes, max_delay_us);
+      const auto sessions = _sessions.Load();
+      for (const auto &session : sessions) {
+        ConfigureSession(*session);
+      }
+    }
+
+    bool AreClientsListening() const final {
+      return !_sessions.IsEmpty();
+    }
+
+    void SetReplayDepth(size_t depth) final {
+      StreamStateBase::SetReplayDepth(depth);
+      std::lock_guard<std::mutex> lock(_replay_mutex);
+      while (_replay.size() > depth) {
+        _replay.pop_front();
       }
     }
 
@@ -38,26 +81,61 @@ namespace detail {
 
     void ConnectSession(std::shared_ptr<Session> session) final {
       DEBUG_ASSERT(session != nullptr);
-      std::lock_guard<std::mutex> lock(_mutex);
-      _sessions.emplace_back(std::move(session));
+      ConfigureSession(*session);
+      if (session->IsResume()) {
+        // Replay the retained messages the client has not seen yet before
+        // exposing the session to live writes. A message published in the
+        // instant between the copy below and the push is skipped for this
+        // session, same as a marginally longer outage; the stream resumes
+        // with the next one.
+        const auto last_sequence = session->GetResumeSequence();
+        std::vector<Session::shared_message_type> missed;
+        {
+          std::lock_guard<std::mutex> lock(_replay_mutex);
+          for (const auto &message : _replay) {
+            if (message->GetSequence() > last_sequence) {
+              missed.push_back(message);
+            }
+          }
+        }
+        for (auto &message : missed) {
+          session->Write(std::move(message));
+        }
+      }
+      _sessions.Push(std::move(session));
     }
 
     void DisconnectSession(std::shared_ptr<Session> session) final {
-      std::lock_guard<std::mutex> lock(_mutex);
       DEBUG_ASSERT(session != nullptr);
-      _sessions.erase(
-          std::remove(_sessions.begin(), _sessions.end(), session),
-          _sessions.end());
+      _sessions.DeleteByValue(session);
     }
 
     void ClearSessions() final {
-      std::lock_guard<std::mutex> lock(_mutex);
-      _sessions.clear();
+      _sessions.Clear();
     }
 
-    std::mutex _mutex;
+    /// Retain @a message for session resumption, dropping the oldest entry
+    /// when the ring is full. No-op while retention is disabled. One short
+    /// lock per write; the fan-out to the sessions stays lock-free.
+    void PushToReplay(const Session::shared_message_type &message) {
+      const auto depth = GetReplayDepth();
+      if (depth == 0u) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(_replay_mutex);
+      _replay.push_back(message);
+      while (_replay.size() > depth) {
+        _replay.pop_front();
+      }
+    }
+
+    EpochList<std::shared_ptr<Session>> _sessions;
+
+    std::mutex _replay_mutex;
 
-    std::vector<std::shared_ptr<Session>> _sessions;
+    /// Messages retained for resumption, oldest first; capped at the replay
+    /// depth of the stream.
+    std::deque<Session::shared_message_type> _replay;
   };
 
 } // namespace detail
@@ -9,6 +9,9 @@
 #include "carla/Buffer.h"
 #include "carla/Debug.h"
 #include "carla/streaming/Token.h"
+#include "carla/streaming/detail/Compression.h"
+#include "carla/streaming/detail/Token.h"
+#include "carla/streaming/detail/Types.h"
 
 #include <memory>
 
@@ -33,7 +36,22 @@ namespace detail {
     /// Token associated with this stream. This token can be used by a client to
     /// subscribe to this stream.
     Token token() const {
-      return _shared_state->token();
+      return _token;
+    }
+
+    /// Id identifying this stream on the server, used to key its entry in
+    /// the stream stats registry.
+    detail::stream_id_type get_stream_id() const {
+      return _token.get_stream_id();
+    }
+
+    /// Sub-stream id of this stream within its multiplexed group, zero for
+    /// streams that own their session exclusively. Streams of one group
+    /// share the underlying state and session; the producer stamps this id
+    /// on each message so clients can demultiplex, see
+    /// Dispatcher::MakeMultiplexedStream.
+    uint16_t get_sub_stream_id() const {
+      return _token.get_sub_stream_id();
     }
 
     /// Pull a buffer from the buffer pool associated to this stream. Discarded
@@ -46,6 +64,46 @@ namespace detail {
       return _shared_state->MakeBuffer();
     }
 
+    /// Compress the messages flushed down this stream from now on. Subscribed
+    /// clients detect compressed messages on the wire, no renegotiation is
+    /// needed.
+    void SetCompression(CompressionType type) {
+      _shared_state->SetCompression(type);
+    }
+
+    /// Set what to do with outgoing messages when a subscribed client cannot
+    /// keep up with the stream rate, see detail::QueuePolicy.
+    void SetQueuePolicy(QueuePolicy policy, size_t max_queue_depth = 1u) {
+      _shared_state->SetQueuePolicy(policy, max_queue_depth);
+    }
+
+    /// Retain the last @a depth messages so a client whose session dropped
+    /// can resume the stream without losing them; each message is retained
+    /// until @a depth newer ones have been written. Zero (the default)
+    /// disables retention, dropped clients resume with the next message.
+    void SetReplayDepth(size_t depth) {
+      _shared_state->SetReplayDepth(depth);
+    }
+
+    /// Coalesce small messages into gathered writes bounded by @a max_bytes
+    /// and @a max_delay_us, trading a bounded delay for fewer syscalls and
+    /// packets, see tcp::ServerSession::SetCoalescing. A zero @a max_delay_us
+    /// (the default) disables coalescing.
+    void SetCoalescing(size_t max_bytes, size_t max_delay_us) {
+      _shared_state->SetCoalescing(max_bytes, max_delay_us);
+    }
+
+    /// Whether any client is currently subscribed to this stream.
+    bool AreClientsListening() const {
+      return _shared_state->AreClientsListening();
+    }
+
+    /// Whether a message written now would reach a client rather than being
+    /// discarded, see StreamStateBase::IsReadyForNextMessage.
+    bool IsReadyForNextMessage() const {
+      return _shared_state->IsReadyForNextMessage();
+    }
+
     /// Flush @a buffers down the stream. No copies are made.
     template <typename... Buffers>
     void Write(Buffers &&... buffers) {
@@ -66,11 +124,16 @@ namespace detail {
     friend class detail::Dispatcher;
 
     Stream(std::shared_ptr<StreamStateT> state)
-      : _shared_state(std::move(state)) {
+      : _shared_state(std::move(state)),
+        _token(_shared_state->token()) {
       DEBUG_ASSERT(_shared_state != nullptr);
     }
 
     std::shared_ptr<StreamStateT> _shared_state;
+
+    /// Copy of the state's token, except that multiplexed streams sharing
+    /// one state each carry their own sub-stream id here.
+    token_type _token;
   };
 
 } // namespace detail
@@ -21,16 +21,45 @@ namespace detail {
 
     template <typename... Buffers>
     void Write(Buffers &&... buffers) {
+      if (IsSharedMemoryStream()) {
+        WriteToSharedMemory(MakeMessage(std::move(buffers)...));
+        return;
+      }
+      if (IsUdpStream()) {
+        WriteToUdp(MakeMessage(std::move(buffers)...));
+        return;
+      }
+      auto session = _session.load();
+      if (session != nullptr) {
+        session->Write(MakeMessage(std::move(buffers)...));
+      }
+    }
+
+    void SetQueuePolicy(QueuePolicy policy, size_t max_queue_depth) final {
+      StreamStateBase::SetQueuePolicy(policy, max_queue_depth);
       auto session = _session.load();
       if (session != nullptr) {
-        session->Write(std::move(buffers)...);
+        ConfigureSession(*session);
       }
     }
 
+    void SetCoalescing(size_t max_bytes, size_t max_delay_us) final {
+      StreamStateBase::SetCoalescing(max_bytes, max_delay_us);
+      auto session = _session.load();
+      if (session != nullptr) {
+        ConfigureSession(*session);
+      }
+    }
+
+    bool AreClientsListening() const final {
+      return _session.load() != nullptr;
+    }
+
   private:
 
     void ConnectSession(std::shared_ptr<Session> session) final {
       DEBUG_ASSERT(session != nullptr);
+      ConfigureSession(*session);
       _session = std::move(session);
     }
 
@@ -7,6 +7,11 @@
 #include "carla/streaming/detail/StreamStateBase.h"
 
 #include "carla/BufferPool.h"
+#include "carla/Debug.h"
+#include "carla/streaming/detail/shm/SharedMemoryRing.h"
+#include "carla/streaming/detail/udp/Server.h"
+
+#include <cstring>
 
 namespace carla {
 namespace streaming {
@@ -14,10 +19,43 @@ namespace detail {
 
   StreamStateBase::StreamStateBase(const token_type &token)
     : _token(token),
-      _buffer_pool(std::make_shared<BufferPool>()) {}
+      _buffer_pool(std::make_shared<BufferPool>(
+          "stream " + std::to_string(token.get_stream_id()))) {
+    if (token.protocol_is_shm()) {
+      _shm_writer = std::make_unique<shm::RingWriter>(
+          shm::MakeRingName(token.get_port(), token.get_stream_id()));
+    }
+  }
 
   StreamStateBase::~StreamStateBase() = default;
 
+  void StreamStateBase::WriteToSharedMemory(const Session::shared_message_type &message) {
+    DEBUG_ASSERT(_shm_writer != nullptr);
+    if (!_shm_writer->HasReaders()) {
+      return;
+    }
+    auto *dst = _shm_writer->BeginWrite(message->size());
+    if (dst == nullptr) {
+      return;
+    }
+    // Skip the leading size prefix, ring slots carry their own size.
+    bool first = true;
+    for (const auto &view : message->GetBufferSequence()) {
+      if (first) {
+        first = false;
+        continue;
+      }
+      std::memcpy(dst, view.data(), view.size());
+      dst += view.size();
+    }
+    _shm_writer->Commit();
+  }
+
+  void StreamStateBase::WriteToUdp(const Session::shared_message_type &message) {
+    DEBUG_ASSERT(_udp_server != nullptr);
+    _udp_server->Write(_token.get_stream_id(), message);
+  }
+
   Buffer StreamStateBase::MakeBuffer() {
     return _buffer_pool->Pop();
   }
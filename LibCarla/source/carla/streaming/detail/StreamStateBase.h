@@ -7,9 +7,13 @@
 #pragma once
 
 #include "carla/NonCopyable.h"
+#include "carla/TypeTraits.h"
+#include "carla/streaming/detail/Compression.h"
 #include "carla/streaming/detail/Session.h"
 #include "carla/streaming/detail/Token.h"
 
+#include <atomic>
+#include <cstring>
 #include <memory>
 
 namespace carla {
@@ -19,6 +23,14 @@ namespace carla {
 namespace streaming {
 namespace detail {
 
+namespace shm {
+  class RingWriter;
+} // namespace shm
+
+namespace udp {
+  class Server;
+} // namespace udp
+
   /// Shared state among all the copies of a stream. Provides access to the
   /// underlying server session(s) if active.
   class StreamStateBase : private NonCopyable {
@@ -32,19 +44,200 @@ namespace detail {
       return _token;
     }
 
+    stream_id_type get_stream_id() const {
+      return _token.get_stream_id();
+    }
+
+    /// Claim the next free sub-stream id of this stream, used by the
+    /// Dispatcher when multiplexing several streams over this stream's
+    /// session, see Dispatcher::MakeMultiplexedStream.
+    uint16_t MakeNextSubStreamId() {
+      return static_cast<uint16_t>(_next_sub_stream_id.fetch_add(1u) + 1u);
+    }
+
     Buffer MakeBuffer();
 
+    /// Compress the messages of this stream from now on. Messages are flagged
+    /// on the wire so the subscribing end decompresses them transparently, no
+    /// renegotiation is needed.
+    void SetCompression(CompressionType type) {
+      _compression = type;
+    }
+
+    /// Set what the sessions of this stream do with outgoing messages when
+    /// their client cannot keep up, see QueuePolicy. Applies to current and
+    /// future sessions.
+    virtual void SetQueuePolicy(QueuePolicy policy, size_t max_queue_depth) {
+      _queue_policy = policy;
+      _max_queue_depth = max_queue_depth;
+    }
+
+    /// Retain the last @a depth messages of this stream so a client whose
+    /// session dropped can resume without losing them, see the resume
+    /// handshake in tcp::Client. Zero disables retention; only TCP streams
+    /// replay.
+    virtual void SetReplayDepth(size_t depth) {
+      _replay_depth = depth;
+    }
+
+    /// Coalesce the small messages of this stream's sessions into gathered
+    /// writes bounded by @a max_bytes and @a max_delay_us, see
+    /// tcp::ServerSession::SetCoalescing. Applies to current and future
+    /// sessions; a zero delay (the default) disables coalescing.
+    virtual void SetCoalescing(size_t max_bytes, size_t max_delay_us) {
+      _coalesce_max_bytes = max_bytes;
+      _coalesce_max_delay_us = max_delay_us;
+    }
+
+    /// Install the datagram transport this stream publishes on. Set by the
+    /// Dispatcher on UDP streams only.
+    void SetUdpServer(std::shared_ptr<udp::Server> udp_server) {
+      _udp_server = std::move(udp_server);
+    }
+
+    /// Whether any client is currently subscribed to this stream.
+    virtual bool AreClientsListening() const = 0;
+
+    /// Whether a message written now would reach a client rather than being
+    /// discarded: a client is subscribed and, under QueuePolicy::keep_latest,
+    /// no earlier message is still parked in a session queue waiting behind
+    /// an in-flight write. Shared-memory and UDP streams do not track their
+    /// subscribers and always report ready.
+    bool IsReadyForNextMessage() const {
+      if (IsSharedMemoryStream() || IsUdpStream()) {
+        return true;
+      }
+      return AreClientsListening() &&
+          ((_queue_policy != QueuePolicy::keep_latest) ||
+           (_queued_messages->load(std::memory_order_relaxed) == 0u));
+    }
+
     virtual void ConnectSession(std::shared_ptr<Session> session) = 0;
 
     virtual void DisconnectSession(std::shared_ptr<Session> session) = 0;
 
     virtual void ClearSessions() = 0;
 
+  protected:
+
+    /// Apply the stream configuration to a newly connected session.
+    void ConfigureSession(Session &session) const {
+      session.SetQueuePolicy(_queue_policy, _max_queue_depth);
+      session.SetQueuedMessageCounter(_queued_messages);
+      session.SetCoalescing(_coalesce_max_bytes, _coalesce_max_delay_us);
+    }
+
+    QueuePolicy GetQueuePolicy() const {
+      return _queue_policy;
+    }
+
+    size_t GetMaxQueueDepth() const {
+      return _max_queue_depth;
+    }
+
+    size_t GetReplayDepth() const {
+      return _replay_depth;
+    }
+
+    /// Whether this stream publishes on a shared-memory ring instead of its
+    /// sessions.
+    bool IsSharedMemoryStream() const {
+      return _shm_writer != nullptr;
+    }
+
+    /// Publish @a message on the shared-memory ring. The size prefix of the
+    /// message is skipped, the ring slots carry their own size.
+    void WriteToSharedMemory(const Session::shared_message_type &message);
+
+    /// Whether this stream publishes over unreliable datagrams.
+    bool IsUdpStream() const {
+      return _udp_server != nullptr;
+    }
+
+    /// Publish @a message as a datagram to every subscriber of this stream.
+    void WriteToUdp(const Session::shared_message_type &message);
+
+    /// Serialize @a buffers into a single message applying the compression
+    /// mode of this stream, stamped with the next sequence number of the
+    /// stream. Falls back to an uncompressed message when the payload is
+    /// incompressible.
+    template <typename... Buffers>
+    Session::shared_message_type MakeMessage(Buffers &&... buffers) {
+      static_assert(
+          are_same<Buffer, Buffers...>::value,
+          "This function only accepts arguments of type Buffer.");
+      auto message = MakeMessageImpl(std::move(buffers)...);
+      message->SetSequence(
+          _next_sequence.fetch_add(1u, std::memory_order_relaxed) + 1u);
+      return message;
+    }
+
   private:
 
+    template <typename... Buffers>
+    std::shared_ptr<Session::message_type> MakeMessageImpl(Buffers &&... buffers) {
+      if (_compression != CompressionType::none) {
+        auto concatenated = ConcatenateBuffers(std::move(buffers)...);
+        auto compressed = Compress(concatenated, _compression);
+        if (!compressed.empty()) {
+          auto message = std::make_shared<Session::message_type>(std::move(compressed));
+          message->MarkAsCompressed();
+          return message;
+        }
+        return std::make_shared<Session::message_type>(std::move(concatenated));
+      }
+      return std::make_shared<Session::message_type>(std::move(buffers)...);
+    }
+
+    template <typename... Buffers>
+    static Buffer ConcatenateBuffers(Buffers &&... buffers) {
+      uint64_t total = 0u;
+      std::initializer_list<uint64_t> sizes = {buffers.size()...};
+      for (auto size : sizes) {
+        total += size;
+      }
+      Buffer result(total);
+      auto *dst = result.data();
+      auto copy_one = [&dst](const Buffer &buffer) {
+        std::memcpy(dst, buffer.data(), buffer.size());
+        dst += buffer.size();
+      };
+      std::initializer_list<int> expander = {(copy_one(buffers), 0)...};
+      (void) expander;
+      return result;
+    }
+
     const token_type _token;
 
     const std::shared_ptr<BufferPool> _buffer_pool;
+
+    std::unique_ptr<shm::RingWriter> _shm_writer;
+
+    std::shared_ptr<udp::Server> _udp_server;
+
+    CompressionType _compression = CompressionType::none;
+
+    QueuePolicy _queue_policy = QueuePolicy::keep_latest;
+
+    size_t _max_queue_depth = 1u;
+
+    size_t _replay_depth = 0u;
+
+    size_t _coalesce_max_bytes = 0u;
+
+    size_t _coalesce_max_delay_us = 0u;
+
+    /// Sequence stamped on the messages of this stream, see MakeMessage.
+    std::atomic<uint64_t> _next_sequence{0u};
+
+    /// Sub-stream ids handed out so far, see MakeNextSubStreamId.
+    std::atomic<uint16_t> _next_sub_stream_id{0u};
+
+    /// Shared with the sessions of this stream, counts the messages parked
+    /// in their queues behind an in-flight write. Shared so it can outlive
+    /// this state, sessions close asynchronously.
+    const std::shared_ptr<std::atomic_size_t> _queued_messages =
+        std::make_shared<std::atomic_size_t>(0u);
   };
 
 } // namespace detail
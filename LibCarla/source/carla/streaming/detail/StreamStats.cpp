@@ -0,0 +1,66 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/StreamStats.h"
+
+#include <algorithm>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  StreamStatsRegistry &StreamStatsRegistry::GetInstance() {
+    static StreamStatsRegistry instance;
+    return instance;
+  }
+
+  void StreamStatsRegistry::Annotate(
+      const stream_id_type stream_id,
+      const StreamStage stage,
+      const double milliseconds) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto &record = _records[stream_id].stages[static_cast<size_t>(stage)];
+    record.samples[record.count % RING_SIZE] = milliseconds;
+    ++record.count;
+    record.total_ms += milliseconds;
+    record.maximum_ms = std::max(record.maximum_ms, milliseconds);
+  }
+
+  std::vector<StreamPipelineStats> StreamStatsRegistry::GetStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<StreamPipelineStats> result;
+    result.reserve(_records.size());
+    for (auto &item : _records) {
+      StreamPipelineStats stats;
+      stats.stream_id = item.first;
+      for (auto i = 0u; i < stats.stages.size(); ++i) {
+        stats.stages[i] = MakeSnapshot(item.second.stages[i]);
+      }
+      result.emplace_back(stats);
+    }
+    return result;
+  }
+
+  StreamStageStats StreamStatsRegistry::MakeSnapshot(const StageRecord &record) {
+    StreamStageStats stats;
+    stats.count = record.count;
+    if (record.count == 0u) {
+      return stats;
+    }
+    stats.average_ms = record.total_ms / static_cast<double>(record.count);
+    stats.maximum_ms = record.maximum_ms;
+    const auto size = static_cast<size_t>(
+        std::min(record.count, static_cast<uint64_t>(RING_SIZE)));
+    std::vector<double> samples(record.samples.begin(), record.samples.begin() + size);
+    auto nth = samples.begin() + ((99u * (size - 1u)) / 100u);
+    std::nth_element(samples.begin(), nth, samples.end());
+    stats.p99_ms = *nth;
+    return stats;
+  }
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -0,0 +1,90 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/streaming/detail/Types.h"
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  /// Stages of the sensor data pipeline that are timed per stream.
+  enum class StreamStage : size_t {
+    capture = 0u,   ///< Stream creation to serialization start, covers render
+                    ///< and pixel copy for camera sensors.
+    serialize = 1u, ///< Sensor data to wire format.
+    enqueue = 2u,   ///< Message build, compression, and hand-off to the
+                    ///< session queues.
+    send = 3u,      ///< Session queue to socket write completion.
+    SIZE = 4u
+  };
+
+  /// Snapshot of the latency statistics of one pipeline stage, milliseconds.
+  struct StreamStageStats {
+    double average_ms = 0.0;
+    double p99_ms = 0.0;
+    double maximum_ms = 0.0;
+    uint64_t count = 0u;
+  };
+
+  /// Snapshot of the pipeline timing of one stream.
+  struct StreamPipelineStats {
+    stream_id_type stream_id = 0u;
+    std::array<StreamStageStats, static_cast<size_t>(StreamStage::SIZE)> stages;
+  };
+
+  /// Process-wide registry of per-stream pipeline timing. Unlike the
+  /// profiler, which only prints on exit, this registry is always on and can
+  /// be queried at runtime; annotating a stage is a locked write into a
+  /// fixed-size ring of samples, the percentile is computed at query time.
+  class StreamStatsRegistry : private NonCopyable {
+  public:
+
+    static StreamStatsRegistry &GetInstance();
+
+    /// Record that @a stage of stream @a stream_id took @a milliseconds.
+    void Annotate(stream_id_type stream_id, StreamStage stage, double milliseconds);
+
+    /// Snapshot of every stream annotated since the registry was created.
+    std::vector<StreamPipelineStats> GetStats() const;
+
+  private:
+
+    StreamStatsRegistry() = default;
+
+    /// Samples kept per stage for the percentile, newer samples overwrite
+    /// the oldest ones.
+    static constexpr size_t RING_SIZE = 256u;
+
+    struct StageRecord {
+      std::array<double, RING_SIZE> samples;
+      uint64_t count = 0u;
+      double total_ms = 0.0;
+      double maximum_ms = 0.0;
+    };
+
+    struct StreamRecord {
+      std::array<StageRecord, static_cast<size_t>(StreamStage::SIZE)> stages;
+    };
+
+    static StreamStageStats MakeSnapshot(const StageRecord &record);
+
+    mutable std::mutex _mutex;
+
+    std::unordered_map<stream_id_type, StreamRecord> _records;
+  };
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
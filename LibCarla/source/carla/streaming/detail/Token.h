@@ -29,7 +29,8 @@ namespace detail {
     enum class protocol : uint8_t {
       not_set,
       tcp,
-      udp
+      udp,
+      shm
     } protocol = protocol::not_set;
 
     enum class address : uint8_t {
@@ -42,6 +43,10 @@ namespace detail {
       boost::asio::ip::address_v4::bytes_type v4;
       boost::asio::ip::address_v6::bytes_type v6;
     } address;
+
+    /// Sub-stream within a multiplexed group, zero for streams that own
+    /// their session exclusively, see Dispatcher::MakeMultiplexedStream.
+    uint16_t sub_stream_id = 0u;
   };
 
 #pragma pack(pop)
@@ -49,12 +54,13 @@ namespace detail {
   static_assert(
       sizeof(token_data) == sizeof(Token::data),
       "Size shouldn't be more than"
-      "  v6 address  : 128"
-      "  + state     :  16"
-      "  + port      :  16"
-      "  + stream id :  32"
-      "  -----------------"
-      "                192");
+      "  v6 address      : 128"
+      "  + state         :  16"
+      "  + port          :  16"
+      "  + stream id     :  32"
+      "  + sub-stream id :  16"
+      "  ---------------------"
+      "                    208");
 
   /// Serializes a stream endpoint. Contains all the necessary information for a
   /// client to subscribe to a stream.
@@ -112,12 +118,27 @@ namespace detail {
       return _token.stream_id;
     }
 
+    /// Sub-stream id within a multiplexed group, zero for streams that own
+    /// their session exclusively. Streams of one group share the stream id
+    /// (thus the session) and differ only in this field.
+    auto get_sub_stream_id() const {
+      return _token.sub_stream_id;
+    }
+
+    bool is_multiplexed() const {
+      return _token.sub_stream_id != 0u;
+    }
+
     bool has_address() const {
       return _token.address_type != token_data::address::not_set;
     }
 
     void set_address(const boost::asio::ip::address &addr);
 
+    void set_port(uint16_t port) {
+      _token.port = port;
+    }
+
     boost::asio::ip::address get_address() const;
 
     auto get_port() const {
@@ -146,6 +167,10 @@ namespace detail {
       return _token.protocol == token_data::protocol::tcp;
     }
 
+    bool protocol_is_shm() const {
+      return _token.protocol == token_data::protocol::shm;
+    }
+
     template <typename Protocol>
     bool has_same_protocol(const boost::asio::ip::basic_endpoint<Protocol> &) const {
       return _token.protocol == get_protocol<Protocol>();
@@ -19,6 +19,43 @@ namespace detail {
 
   using message_size_type = uint32_t;
 
+  /// Top bit of the stream id sent on the TCP subscription handshake, set
+  /// when the client is resuming a previous session; the sequence number of
+  /// the last message it received follows the id on the wire, and the
+  /// server replays the retained messages published after it, see
+  /// MultiStreamState::SetReplayDepth.
+  static constexpr stream_id_type stream_id_resume_flag =
+      1u << (8u * sizeof(stream_id_type) - 1u);
+
+  /// Stream ids are partitioned in namespaces so independent stream sources
+  /// in one process (concurrent episodes, or a primary simulator and its
+  /// secondary renderers) can allocate ids without colliding: the namespace
+  /// occupies the bits right below the resume flag and each namespace counts
+  /// its own ids, see Dispatcher::SetStreamIdNamespace.
+  static constexpr stream_id_type stream_id_namespace_shift = 24u;
+
+  /// Highest usable namespace, the bit above it carries the resume flag.
+  static constexpr stream_id_type stream_id_namespace_max = 0x7Fu;
+
+  /// Per-namespace portion of a stream id.
+  static constexpr stream_id_type stream_id_namespace_id_mask =
+      (1u << stream_id_namespace_shift) - 1u;
+
+  /// What a session does with outgoing messages when the client cannot keep
+  /// up with the stream rate.
+  enum class QueuePolicy : uint8_t {
+    /// Keep only the most recent message, older pending ones are discarded
+    /// (default). Best for sensors where a fresh frame always supersedes a
+    /// stale one.
+    keep_latest,
+
+    /// Queue up to a maximum depth, discarding the oldest message when full.
+    drop_oldest,
+
+    /// Never discard, the queue grows as needed.
+    block
+  };
+
   static_assert(
       std::is_same<message_size_type, Buffer::size_type>::value,
       "uint type mismatch!");
@@ -0,0 +1,95 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/shm/Client.h"
+
+#include "carla/BufferPool.h"
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+#include "carla/streaming/detail/shm/SharedMemoryRing.h"
+
+#include <exception>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  /// How often the reader polls the ring for a fresh message. At sensor rates
+  /// this is well below a frame period while keeping an idle subscriber cheap.
+  static constexpr long POLL_PERIOD_MILLISECONDS = 1;
+
+  Client::Client(
+      boost::asio::io_context &io_context,
+      const token_type &token,
+      callback_function_type callback)
+    : _token(token),
+      _callback(std::move(callback)),
+      _poll_timer(io_context),
+      _buffer_pool(std::make_shared<BufferPool>(
+          "shm client stream " + std::to_string(token.get_stream_id()))) {
+    if (!_token.protocol_is_shm()) {
+      throw_exception(std::invalid_argument("invalid token, only shared-memory tokens supported"));
+    }
+  }
+
+  Client::~Client() = default;
+
+  void Client::Connect() {
+    auto self = shared_from_this();
+    _poll_timer.get_executor().context().post([this, self]() {
+      if (_done) {
+        return;
+      }
+      try {
+        _reader = std::make_unique<RingReader>(
+            MakeRingName(_token.get_port(), _token.get_stream_id()));
+      } catch (const std::exception &e) {
+        log_error("shm client: failed to map stream", _token.get_stream_id(), ":", e.what());
+        // The writer may not have created the ring yet, retry shortly.
+        _poll_timer.expires_from_now(boost::posix_time::milliseconds(100));
+        _poll_timer.async_wait([this, self](boost::system::error_code ec) {
+          if (!ec && !_done) {
+            Connect();
+          }
+        });
+        return;
+      }
+      log_debug("shm client: subscribed to stream", _token.get_stream_id());
+      Poll();
+    });
+  }
+
+  void Client::Poll() {
+    if (_done) {
+      return;
+    }
+    auto buffer = _buffer_pool->Pop();
+    if (_reader->TryRead(buffer)) {
+      _callback(std::move(buffer));
+    }
+    auto self = shared_from_this();
+    _poll_timer.expires_from_now(boost::posix_time::milliseconds(POLL_PERIOD_MILLISECONDS));
+    _poll_timer.async_wait([this, self](boost::system::error_code ec) {
+      if (!ec) {
+        Poll();
+      }
+    });
+  }
+
+  void Client::Stop() {
+    _done = true;
+    auto self = shared_from_this();
+    _poll_timer.get_executor().context().post([this, self]() {
+      _poll_timer.cancel();
+      _reader = nullptr;
+    });
+  }
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
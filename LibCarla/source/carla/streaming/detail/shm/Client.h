@@ -0,0 +1,79 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+#include "carla/streaming/detail/Token.h"
+#include "carla/streaming/detail/Types.h"
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace carla {
+
+  class BufferPool;
+
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  class RingReader;
+
+  /// A client that subscribes to a single shared-memory stream. Mirrors the
+  /// interface of tcp::Client so low_level::Client can use either one
+  /// depending on the protocol carried by the token.
+  ///
+  /// @warning This client should be stopped before releasing the shared
+  /// pointer or won't be destroyed.
+  class Client
+    : public std::enable_shared_from_this<Client>,
+      private NonCopyable {
+  public:
+
+    using callback_function_type = std::function<void (Buffer)>;
+
+    Client(
+        boost::asio::io_context &io_context,
+        const token_type &token,
+        callback_function_type callback);
+
+    ~Client();
+
+    void Connect();
+
+    stream_id_type GetStreamId() const {
+      return _token.get_stream_id();
+    }
+
+    void Stop();
+
+  private:
+
+    void Poll();
+
+    const token_type _token;
+
+    callback_function_type _callback;
+
+    boost::asio::deadline_timer _poll_timer;
+
+    std::unique_ptr<RingReader> _reader;
+
+    std::shared_ptr<BufferPool> _buffer_pool;
+
+    std::atomic_bool _done{false};
+  };
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
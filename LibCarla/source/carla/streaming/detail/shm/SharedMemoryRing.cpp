@@ -0,0 +1,256 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/shm/SharedMemoryRing.h"
+
+#include "carla/Debug.h"
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif // _WIN32
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  std::string MakeRingName(uint16_t port, stream_id_type stream_id) {
+    return std::string("/carla.stream.")
+        + std::to_string(port) + "."
+        + std::to_string(stream_id);
+  }
+
+#ifndef _WIN32
+
+  static uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1u) & ~(alignment - 1u);
+  }
+
+  // ===========================================================================
+  // -- RingWriter -------------------------------------------------------------
+  // ===========================================================================
+
+  RingWriter::RingWriter(
+      const std::string &name,
+      const uint64_t slot_size,
+      const uint32_t number_of_slots)
+    : _name(name),
+      _slot_stride(AlignUp(sizeof(SlotHeader) + slot_size, 64u)) {
+    const int fd = ::shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+      throw_exception(std::runtime_error(
+          "unable to create shared-memory object '" + _name + "'"));
+    }
+    _mapped_size = AlignUp(sizeof(RingHeader), 64u) + _slot_stride * number_of_slots;
+    if (::ftruncate(fd, static_cast<off_t>(_mapped_size)) != 0) {
+      ::close(fd);
+      ::shm_unlink(_name.c_str());
+      throw_exception(std::runtime_error(
+          "unable to resize shared-memory object '" + _name + "'"));
+    }
+    _mapped = ::mmap(nullptr, _mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (_mapped == MAP_FAILED) {
+      ::shm_unlink(_name.c_str());
+      throw_exception(std::runtime_error(
+          "unable to map shared-memory object '" + _name + "'"));
+    }
+    _header = new (_mapped) RingHeader();
+    _header->number_of_slots = number_of_slots;
+    _header->slot_size = slot_size;
+    for (uint32_t i = 0u; i < number_of_slots; ++i) {
+      new (reinterpret_cast<unsigned char *>(_mapped)
+          + AlignUp(sizeof(RingHeader), 64u)
+          + _slot_stride * i) SlotHeader();
+    }
+    // Publish the magic last so readers never see a half-initialized ring.
+    std::atomic_thread_fence(std::memory_order_release);
+    _header->magic = RingHeader::expected_magic;
+    log_debug("shm ring", _name, "created:", number_of_slots, "slots of", slot_size, "bytes");
+  }
+
+  RingWriter::~RingWriter() {
+    if (_mapped != nullptr) {
+      ::munmap(_mapped, _mapped_size);
+      ::shm_unlink(_name.c_str());
+    }
+  }
+
+  SlotHeader &RingWriter::GetSlot(const uint64_t sequence) const {
+    const auto index = sequence % _header->number_of_slots;
+    return *reinterpret_cast<SlotHeader *>(
+        reinterpret_cast<unsigned char *>(_mapped)
+        + AlignUp(sizeof(RingHeader), 64u)
+        + _slot_stride * index);
+  }
+
+  bool RingWriter::HasReaders() const {
+    return _header->number_of_readers.load(std::memory_order_relaxed) > 0u;
+  }
+
+  unsigned char *RingWriter::BeginWrite(const uint64_t size) {
+    if (size > _header->slot_size) {
+      log_warning("shm ring", _name, ": message of", size, "bytes exceeds slot size, dropped");
+      return nullptr;
+    }
+    auto &slot = GetSlot(_next_sequence);
+    // Odd value marks the slot as being written.
+    slot.sequence.store(2u * _next_sequence - 1u, std::memory_order_release);
+    slot.size = size;
+    return reinterpret_cast<unsigned char *>(&slot) + sizeof(SlotHeader);
+  }
+
+  void RingWriter::Commit() {
+    auto &slot = GetSlot(_next_sequence);
+    slot.sequence.store(2u * _next_sequence, std::memory_order_release);
+    _header->head.store(_next_sequence, std::memory_order_release);
+    ++_next_sequence;
+  }
+
+  bool RingWriter::Write(const unsigned char *data, const uint64_t size) {
+    auto *dst = BeginWrite(size);
+    if (dst == nullptr) {
+      return false;
+    }
+    std::memcpy(dst, data, size);
+    Commit();
+    return true;
+  }
+
+  // ===========================================================================
+  // -- RingReader -------------------------------------------------------------
+  // ===========================================================================
+
+  RingReader::RingReader(const std::string &name)
+    : _name(name) {
+    const int fd = ::shm_open(_name.c_str(), O_RDWR, 0644);
+    if (fd < 0) {
+      throw_exception(std::runtime_error(
+          "unable to open shared-memory object '" + _name + "'"));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      ::close(fd);
+      throw_exception(std::runtime_error(
+          "unable to stat shared-memory object '" + _name + "'"));
+    }
+    _mapped_size = static_cast<uint64_t>(info.st_size);
+    _mapped = ::mmap(nullptr, _mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (_mapped == MAP_FAILED) {
+      throw_exception(std::runtime_error(
+          "unable to map shared-memory object '" + _name + "'"));
+    }
+    _header = reinterpret_cast<RingHeader *>(_mapped);
+    if (_header->magic != RingHeader::expected_magic) {
+      ::munmap(_mapped, _mapped_size);
+      _mapped = nullptr;
+      throw_exception(std::runtime_error(
+          "shared-memory object '" + _name + "' is not a stream ring"));
+    }
+    _slot_stride = AlignUp(sizeof(SlotHeader) + _header->slot_size, 64u);
+    _header->number_of_readers.fetch_add(1u, std::memory_order_relaxed);
+  }
+
+  RingReader::~RingReader() {
+    if (_mapped != nullptr) {
+      _header->number_of_readers.fetch_sub(1u, std::memory_order_relaxed);
+      ::munmap(_mapped, _mapped_size);
+    }
+  }
+
+  SlotHeader &RingReader::GetSlot(const uint64_t sequence) const {
+    const auto index = sequence % _header->number_of_slots;
+    return *reinterpret_cast<SlotHeader *>(
+        reinterpret_cast<unsigned char *>(_mapped)
+        + AlignUp(sizeof(RingHeader), 64u)
+        + _slot_stride * index);
+  }
+
+  bool RingReader::TryRead(Buffer &buffer) {
+    const auto head = _header->head.load(std::memory_order_acquire);
+    if (head <= _last_sequence) {
+      return false;
+    }
+    auto &slot = GetSlot(head);
+    const auto sequence_before = slot.sequence.load(std::memory_order_acquire);
+    if (sequence_before != 2u * head) {
+      // The writer is overwriting this slot right now, try again next poll.
+      return false;
+    }
+    const auto size = slot.size;
+    buffer.reset(size);
+    std::memcpy(
+        buffer.data(),
+        reinterpret_cast<const unsigned char *>(&slot) + sizeof(SlotHeader),
+        size);
+    // Validate the seqlock after the copy, the writer may have lapped us.
+    const auto sequence_after = slot.sequence.load(std::memory_order_acquire);
+    if (sequence_after != sequence_before) {
+      return false;
+    }
+    _last_sequence = head;
+    return true;
+  }
+
+#else // _WIN32
+
+  RingWriter::RingWriter(const std::string &name, uint64_t, uint32_t)
+    : _name(name) {
+    throw_exception(std::runtime_error(
+        "shared-memory streaming is not available on this platform"));
+  }
+
+  RingWriter::~RingWriter() = default;
+
+  SlotHeader &RingWriter::GetSlot(uint64_t) const {
+    throw_exception(std::runtime_error("shared-memory streaming is not available on this platform"));
+  }
+
+  bool RingWriter::HasReaders() const {
+    return false;
+  }
+
+  unsigned char *RingWriter::BeginWrite(uint64_t) {
+    return nullptr;
+  }
+
+  void RingWriter::Commit() {}
+
+  bool RingWriter::Write(const unsigned char *, uint64_t) {
+    return false;
+  }
+
+  RingReader::RingReader(const std::string &name)
+    : _name(name) {
+    throw_exception(std::runtime_error(
+        "shared-memory streaming is not available on this platform"));
+  }
+
+  RingReader::~RingReader() = default;
+
+  SlotHeader &RingReader::GetSlot(uint64_t) const {
+    throw_exception(std::runtime_error("shared-memory streaming is not available on this platform"));
+  }
+
+  bool RingReader::TryRead(Buffer &) {
+    return false;
+  }
+
+#endif // _WIN32
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
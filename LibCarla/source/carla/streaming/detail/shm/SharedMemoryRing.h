@@ -0,0 +1,140 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+#include "carla/streaming/detail/Types.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  /// Shared layout of a shared-memory stream ring. A single writer publishes
+  /// messages into a fixed number of slots; any number of readers poll the
+  /// head sequence and copy out the most recent slot. Sequences only grow, so
+  /// a reader can always detect that it was overrun by the writer and retry.
+#pragma pack(push, 8)
+  struct RingHeader {
+    static constexpr uint32_t expected_magic = 0x43415348u; // "CASH"
+
+    uint32_t magic = 0u;
+
+    uint32_t number_of_slots = 0u;
+
+    uint64_t slot_size = 0u;
+
+    /// Sequence number of the last published message, zero if none.
+    std::atomic<uint64_t> head{0u};
+
+    /// Number of readers currently mapping this ring, the writer may skip
+    /// serialization work while this is zero.
+    std::atomic<uint32_t> number_of_readers{0u};
+  };
+
+  struct SlotHeader {
+    /// Sequence stamped twice, before and after the payload copy (seqlock),
+    /// an odd value marks a slot being written.
+    std::atomic<uint64_t> sequence{0u};
+
+    uint64_t size = 0u;
+  };
+#pragma pack(pop)
+
+  /// Name of the shared-memory object associated with a stream, derived from
+  /// the values carried by the stream token so both ends agree on it.
+  std::string MakeRingName(uint16_t port, stream_id_type stream_id);
+
+  /// Writer end of a shared-memory stream ring. Creates and owns the
+  /// underlying shared-memory object.
+  ///
+  /// @warning Only available on POSIX platforms.
+  class RingWriter : private NonCopyable {
+  public:
+
+    /// Default payload capacity of each slot, pages are only committed as they
+    /// are touched so over-provisioning is cheap.
+    static constexpr uint64_t default_slot_size = 32u * 1024u * 1024u;
+
+    static constexpr uint32_t default_number_of_slots = 4u;
+
+    RingWriter(
+        const std::string &name,
+        uint64_t slot_size = default_slot_size,
+        uint32_t number_of_slots = default_number_of_slots);
+
+    ~RingWriter();
+
+    bool HasReaders() const;
+
+    /// Copy @a size bytes from @a data into the next slot and publish it.
+    /// Returns false if the message does not fit in a slot.
+    bool Write(const unsigned char *data, uint64_t size);
+
+    /// Begin writing the next message in place; returns a pointer to the slot
+    /// payload or nullptr if @a size does not fit. Must be paired with
+    /// Commit().
+    unsigned char *BeginWrite(uint64_t size);
+
+    void Commit();
+
+  private:
+
+    SlotHeader &GetSlot(uint64_t sequence) const;
+
+    std::string _name;
+
+    uint64_t _slot_stride = 0u;
+
+    uint64_t _mapped_size = 0u;
+
+    void *_mapped = nullptr;
+
+    RingHeader *_header = nullptr;
+
+    uint64_t _next_sequence = 1u;
+  };
+
+  /// Reader end of a shared-memory stream ring. Maps an existing
+  /// shared-memory object created by a RingWriter.
+  class RingReader : private NonCopyable {
+  public:
+
+    explicit RingReader(const std::string &name);
+
+    ~RingReader();
+
+    /// Copy the latest published message into @a buffer if it is newer than
+    /// the last one read. Returns true if a new message was retrieved.
+    bool TryRead(Buffer &buffer);
+
+  private:
+
+    SlotHeader &GetSlot(uint64_t sequence) const;
+
+    std::string _name;
+
+    uint64_t _slot_stride = 0u;
+
+    uint64_t _mapped_size = 0u;
+
+    void *_mapped = nullptr;
+
+    RingHeader *_header = nullptr;
+
+    uint64_t _last_sequence = 0u;
+  };
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
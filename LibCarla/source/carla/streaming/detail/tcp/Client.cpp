@@ -11,11 +11,14 @@
 #include "carla/Exception.h"
 #include "carla/Logging.h"
 #include "carla/Time.h"
+#include "carla/streaming/detail/Compression.h"
+#include "carla/streaming/detail/tcp/Message.h"
 
 #include <boost/asio/connect.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
 
+#include <array>
 #include <exception>
 
 namespace carla {
@@ -28,34 +31,53 @@ namespace tcp {
   // ===========================================================================
 
   /// Helper for reading incoming TCP messages. Allocates the whole message in
-  /// a single buffer.
+  /// a single buffer popped from the pool once the size prefix is known, so
+  /// the pool can hand back the best fitting pooled buffer.
   class IncomingMessage {
   public:
 
-    explicit IncomingMessage(Buffer &&buffer) : _message(std::move(buffer)) {}
+    explicit IncomingMessage(std::shared_ptr<BufferPool> buffer_pool)
+      : _buffer_pool(std::move(buffer_pool)) {}
 
-    boost::asio::mutable_buffer size_as_buffer() {
-      return boost::asio::buffer(&_size, sizeof(_size));
+    /// The header is the sequence number of the message followed by its
+    /// size prefix.
+    std::array<boost::asio::mutable_buffer, 2u> header_as_buffers() {
+      return {
+          boost::asio::buffer(&_sequence, sizeof(_sequence)),
+          boost::asio::buffer(&_size, sizeof(_size))};
+    }
+
+    auto sequence() const {
+      return _sequence;
     }
 
     boost::asio::mutable_buffer buffer() {
-      DEBUG_ASSERT(_size > 0u);
-      _message.reset(_size);
+      DEBUG_ASSERT(size() > 0u);
+      _message = _buffer_pool->Pop(size());
+      _message.reset(size());
       return _message.buffer();
     }
 
     auto size() const {
-      return _size;
+      return _size & ~Message::compressed_flag;
+    }
+
+    bool compressed() const {
+      return (_size & Message::compressed_flag) != 0u;
     }
 
     auto pop() {
-      return std::move(_message);
+      return compressed() ? Decompress(std::move(_message)) : std::move(_message);
     }
 
   private:
 
+    uint64_t _sequence = 0u;
+
     message_size_type _size = 0u;
 
+    std::shared_ptr<BufferPool> _buffer_pool;
+
     Buffer _message;
   };
 
@@ -68,13 +90,16 @@ namespace tcp {
       const token_type &token,
       callback_function_type callback)
     : LIBCARLA_INITIALIZE_LIFETIME_PROFILER(
+          "tcp client",
           std::string("tcp client ") + std::to_string(token.get_stream_id())),
       _token(token),
       _callback(std::move(callback)),
       _socket(io_context),
       _strand(io_context),
+      _callback_strand(io_context),
       _connection_timer(io_context),
-      _buffer_pool(std::make_shared<BufferPool>()) {
+      _buffer_pool(std::make_shared<BufferPool>(
+          "tcp client stream " + std::to_string(token.get_stream_id()))) {
     if (!_token.protocol_is_tcp()) {
       throw_exception(std::invalid_argument("invalid token, only TCP tokens supported"));
     }
@@ -105,23 +130,37 @@ namespace tcp {
             return;
           }
           log_debug("streaming client: connected to", ep);
-          // Send the stream id to subscribe to the stream.
-          const auto &stream_id = _token.get_stream_id();
+          // Send the stream id to subscribe to the stream; once at least
+          // one message has been received, flag the subscription as a
+          // resume and append the last received sequence so the server
+          // re-attaches the stream state and replays the messages missed
+          // during the drop.
+          const auto stream_id = _token.get_stream_id();
+          const bool resume = (_last_sequence > 0u);
+          _resume_id = resume ? (stream_id | stream_id_resume_flag) : stream_id;
+          _resume_sequence = _last_sequence;
           log_debug("streaming client: sending stream id", stream_id);
-          boost::asio::async_write(
-              _socket,
-              boost::asio::buffer(&stream_id, sizeof(stream_id)),
-              _strand.wrap([=](error_code ec, size_t DEBUG_ONLY(bytes)) {
-            if (!ec) {
-              DEBUG_ASSERT_EQ(bytes, sizeof(stream_id));
+          auto handle_sent = _strand.wrap([=](error_code write_ec, size_t DEBUG_ONLY(bytes)) {
+            if (!write_ec) {
               // If succeeded start reading data.
               ReadData();
             } else {
               // Else try again.
-              log_info("streaming client: failed to send stream id:", ec.message());
+              log_info("streaming client: failed to send stream id:", write_ec.message());
               Connect();
             }
-          }));
+          });
+          if (resume) {
+            const std::array<boost::asio::const_buffer, 2u> handshake = {
+                boost::asio::buffer(&_resume_id, sizeof(_resume_id)),
+                boost::asio::buffer(&_resume_sequence, sizeof(_resume_sequence))};
+            boost::asio::async_write(_socket, handshake, std::move(handle_sent));
+          } else {
+            boost::asio::async_write(
+                _socket,
+                boost::asio::buffer(&_resume_id, sizeof(_resume_id)),
+                std::move(handle_sent));
+          }
         } else {
           log_info("streaming client: connection failed:", ec.message());
           Reconnect();
@@ -163,17 +202,30 @@ namespace tcp {
 
       log_debug("streaming client: Client::ReadData");
 
-      auto message = std::make_shared<IncomingMessage>(_buffer_pool->Pop());
+      // The pooled buffer ends up inside the SensorData handed to the user,
+      // its memory returns to this pool when the measurement is destroyed.
+      auto message = std::make_shared<IncomingMessage>(_buffer_pool);
 
       auto handle_read_data = [this, self, message](boost::system::error_code ec, size_t DEBUG_ONLY(bytes)) {
         DEBUG_ONLY(log_debug("streaming client: Client::ReadData.handle_read_data", bytes, "bytes"));
         if (!ec) {
           DEBUG_ASSERT_EQ(bytes, message->size());
           DEBUG_ASSERT_NE(bytes, 0u);
+          if (message->sequence() <= _last_sequence) {
+            // A resumed session replays conservatively, this message was
+            // already delivered before the drop; skip it.
+            log_debug("streaming client: skipping replayed message", message->sequence());
+            ReadData();
+            return;
+          }
+          _last_sequence = message->sequence();
           // Move the buffer to the callback function and start reading the next
-          // piece of data.
+          // piece of data. The callback strand keeps deliveries of this
+          // stream ordered while leaving other streams free to run in
+          // parallel; deserialization happens inside the callback, so it
+          // scales across worker threads too.
           log_debug("streaming client: success reading data, calling the callback");
-          _strand.context().post([self, message]() { self->_callback(message->pop()); });
+          _callback_strand.post([self, message]() { self->_callback(message->pop()); });
           ReadData();
         } else {
           // As usual, if anything fails start over from the very top.
@@ -187,7 +239,7 @@ namespace tcp {
           size_t DEBUG_ONLY(bytes)) {
         DEBUG_ONLY(log_debug("streaming client: Client::ReadData.handle_read_header", bytes, "bytes"));
         if (!ec && (message->size() > 0u)) {
-          DEBUG_ASSERT_EQ(bytes, sizeof(message_size_type));
+          DEBUG_ASSERT_EQ(bytes, sizeof(uint64_t) + sizeof(message_size_type));
           if (_done) {
             return;
           }
@@ -205,10 +257,10 @@ namespace tcp {
         }
       };
 
-      // Read the size of the buffer that is coming.
+      // Read the sequence and the size of the buffer that is coming.
       boost::asio::async_read(
           _socket,
-          message->size_as_buffer(),
+          message->header_as_buffers(),
           _strand.wrap(handle_read_header));
     });
   }
@@ -72,10 +72,28 @@ namespace tcp {
 
     boost::asio::io_context::strand _strand;
 
+    /// Callbacks are dispatched behind their own strand so messages of this
+    /// stream are delivered in order and never concurrently, while messages
+    /// of different streams are free to run on any worker thread. Reading
+    /// continues on @a _strand while a callback runs.
+    boost::asio::io_context::strand _callback_strand;
+
     boost::asio::deadline_timer _connection_timer;
 
     std::shared_ptr<BufferPool> _buffer_pool;
 
+    /// Sequence number of the last message delivered to the callback, sent
+    /// back to the server on reconnection so the session resumes where it
+    /// left off. Zero until the first message arrives; while zero,
+    /// reconnections subscribe from scratch. Accessed within @a _strand.
+    uint64_t _last_sequence = 0u;
+
+    /// Stable storage for the resume handshake while its asynchronous write
+    /// is in flight.
+    stream_id_type _resume_id = 0u;
+
+    uint64_t _resume_sequence = 0u;
+
     std::atomic_bool _done{false};
   };
 
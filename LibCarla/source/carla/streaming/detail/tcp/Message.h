@@ -39,6 +39,12 @@ namespace tcp {
       return MaxNumberOfBuffers;
     }
 
+    /// Top bit of the size prefix, set when the message payload is
+    /// compressed. This halves the maximum message size, still plenty for
+    /// sensor data.
+    static constexpr message_size_type compressed_flag =
+        1u << (8u * sizeof(message_size_type) - 1u);
+
   private:
 
     MessageTmpl(size_t) {}
@@ -63,13 +69,35 @@ namespace tcp {
 
     /// Size in bytes of the message excluding the header.
     auto size() const noexcept {
-      return _total_size;
+      return _total_size & ~compressed_flag;
     }
 
     bool empty() const noexcept {
       return size() == 0u;
     }
 
+    /// Flag this message as carrying a compressed payload, the flag travels
+    /// in the size prefix.
+    void MarkAsCompressed() noexcept {
+      _total_size |= compressed_flag;
+    }
+
+    bool IsCompressed() const noexcept {
+      return (_total_size & compressed_flag) != 0u;
+    }
+
+    /// Sequence number of this message within its stream, assigned when the
+    /// message is built and sent as a prefix of the TCP framing so clients
+    /// can resume an interrupted session, see ServerSession::WriteNow. Zero
+    /// until assigned.
+    void SetSequence(uint64_t sequence) noexcept {
+      _sequence = sequence;
+    }
+
+    uint64_t GetSequence() const noexcept {
+      return _sequence;
+    }
+
     auto GetBufferSequence() const {
       auto begin = _buffer_views.begin();
       return MakeListView(begin, begin + _number_of_buffers + 1u);
@@ -81,14 +109,18 @@ namespace tcp {
 
     message_size_type _total_size = 0u;
 
+    uint64_t _sequence = 0u;
+
     std::array<Buffer, MaxNumberOfBuffers> _buffers;
 
     std::array<boost::asio::const_buffer, MaxNumberOfBuffers + 1u> _buffer_views;
   };
 
-  /// A TCP message containing a maximum of 2 buffers. This is optimized for a
-  /// header and body sort of messages.
-  using Message = MessageTmpl<2u>;
+  /// A TCP message containing a maximum of 4 buffers. This fits a header and
+  /// body sort of message, and leaves room for sensors that gather several
+  /// chunks (e.g. a measurement header plus per-channel blocks) into a single
+  /// scatter-gather write without concatenating them first.
+  using Message = MessageTmpl<4u>;
 
 } // namespace tcp
 } // namespace detail
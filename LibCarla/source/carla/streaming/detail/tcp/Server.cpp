@@ -20,16 +20,45 @@ namespace tcp {
       _acceptor(_io_context, std::move(ep)),
       _timeout(time_duration::seconds(10u)) {}
 
+  boost::asio::io_context &Server::GetSessionContext(
+      std::shared_ptr<std::atomic_size_t> &counter) {
+    counter = nullptr;
+    if (_shards.empty()) {
+      return _io_context;
+    }
+    auto *best = &_shards.front();
+    for (auto &shard : _shards) {
+      if (*shard.session_count < *best->session_count) {
+        best = &shard;
+      }
+    }
+    counter = best->session_count;
+    return *best->context;
+  }
+
   void Server::OpenSession(
       time_duration timeout,
       ServerSession::callback_function_type on_opened,
       ServerSession::callback_function_type on_closed) {
     using boost::system::error_code;
 
-    auto session = std::make_shared<ServerSession>(_io_context, timeout);
+    std::shared_ptr<std::atomic_size_t> counter;
+    auto &session_context = GetSessionContext(counter);
+    auto session = std::make_shared<ServerSession>(session_context, timeout);
+
+    if (counter != nullptr) {
+      // Keep the shard load balanced, counting the session until it closes.
+      on_closed = [on_closed = std::move(on_closed), counter](auto session_ptr) {
+        --(*counter);
+        on_closed(std::move(session_ptr));
+      };
+    }
 
-    auto handle_query = [on_opened, on_closed, session](const error_code &ec) {
+    auto handle_query = [on_opened, on_closed, session, counter](const error_code &ec) {
       if (!ec) {
+        if (counter != nullptr) {
+          ++(*counter);
+        }
         session->Open(std::move(on_opened), std::move(on_closed));
       } else {
         log_error("tcp accept error:", ec.message());
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "carla/Debug.h"
 #include "carla/NonCopyable.h"
 #include "carla/Time.h"
 #include "carla/streaming/detail/tcp/ServerSession.h"
@@ -14,6 +15,8 @@
 #include <boost/asio/ip/tcp.hpp>
 
 #include <atomic>
+#include <memory>
+#include <vector>
 
 namespace carla {
 namespace streaming {
@@ -40,6 +43,19 @@ namespace tcp {
       _timeout = timeout;
     }
 
+    /// Shard the sessions across the given io_contexts instead of running
+    /// them all on the acceptor's context. Each new session is assigned to
+    /// the shard with the fewest open sessions.
+    ///
+    /// @warning Must be called before Listen.
+    void SetSessionShards(std::vector<boost::asio::io_context *> contexts) {
+      _shards.clear();
+      for (auto *context : contexts) {
+        DEBUG_ASSERT(context != nullptr);
+        _shards.emplace_back(Shard{context, std::make_shared<std::atomic_size_t>(0u)});
+      }
+    }
+
     /// Start listening for connections. On each new connection, @a
     /// on_session_opened is called, and @a on_session_closed when the session
     /// is closed.
@@ -55,6 +71,15 @@ namespace tcp {
 
   private:
 
+    struct Shard {
+      boost::asio::io_context *context;
+      std::shared_ptr<std::atomic_size_t> session_count;
+    };
+
+    /// Pick the io_context for a new session, together with the session
+    /// counter of its shard (null when not sharding).
+    boost::asio::io_context &GetSessionContext(std::shared_ptr<std::atomic_size_t> &counter);
+
     void OpenSession(
         time_duration timeout,
         ServerSession::callback_function_type on_session_opened,
@@ -65,6 +90,8 @@ namespace tcp {
     boost::asio::ip::tcp::acceptor _acceptor;
 
     std::atomic<time_duration> _timeout;
+
+    std::vector<Shard> _shards;
   };
 
 } // namespace tcp
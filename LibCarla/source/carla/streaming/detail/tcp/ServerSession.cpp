@@ -8,11 +8,16 @@
 
 #include "carla/Debug.h"
 #include "carla/Logging.h"
+#include "carla/profiler/TraceLog.h"
+#include "carla/profiler/Tracer.h"
+#include "carla/streaming/detail/StreamStats.h"
 
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <vector>
 
 namespace carla {
 namespace streaming {
@@ -25,12 +30,14 @@ namespace tcp {
       boost::asio::io_context &io_context,
       const time_duration timeout)
     : LIBCARLA_INITIALIZE_LIFETIME_PROFILER(
+          "tcp server session",
           std::string("tcp server session ") + std::to_string(SESSION_COUNTER)),
       _session_id(SESSION_COUNTER++),
       _socket(io_context),
       _timeout(timeout),
       _deadline(io_context),
-      _strand(io_context) {}
+      _strand(io_context),
+      _coalesce_timer(io_context) {}
 
   void ServerSession::Open(
       callback_function_type on_opened,
@@ -46,6 +53,28 @@ namespace tcp {
           size_t DEBUG_ONLY(bytes_received)) {
         if (!ec) {
           DEBUG_ASSERT_EQ(bytes_received, sizeof(_stream_id));
+          if ((_stream_id & stream_id_resume_flag) != 0u) {
+            // The client is resuming a previous session: the sequence
+            // number of the last message it received follows the id.
+            _stream_id &= ~stream_id_resume_flag;
+            _is_resume = true;
+            boost::asio::async_read(
+                _socket,
+                boost::asio::buffer(&_resume_sequence, sizeof(_resume_sequence)),
+                _strand.wrap([this, self, callback](
+                    const boost::system::error_code &resume_ec,
+                    size_t DEBUG_ONLY(resume_bytes)) {
+              if (!resume_ec) {
+                DEBUG_ASSERT_EQ(resume_bytes, sizeof(_resume_sequence));
+                log_debug("session", _session_id, "for stream", _stream_id, " resumed after", _resume_sequence);
+                _strand.context().post([=]() { callback(self); });
+              } else {
+                log_error("session", _session_id, ": error retrieving resume sequence :", resume_ec.message());
+                CloseNow();
+              }
+            }));
+            return;
+          }
           log_debug("session", _session_id, "for stream", _stream_id, " started");
           _strand.context().post([=]() { callback(self); });
         } else {
@@ -63,39 +92,192 @@ namespace tcp {
     });
   }
 
+  void ServerSession::SetQueuePolicy(const QueuePolicy policy, const size_t max_queue_depth) {
+    _strand.post([=, self=shared_from_this()]() {
+      _queue_policy = policy;
+      _max_queue_depth = std::max<size_t>(1u, max_queue_depth);
+    });
+  }
+
+  void ServerSession::SetQueuedMessageCounter(std::shared_ptr<std::atomic_size_t> counter) {
+    _strand.post([=, self=shared_from_this()]() mutable {
+      _queued_counter = std::move(counter);
+    });
+  }
+
+  void ServerSession::SetCoalescing(const size_t max_bytes, const size_t max_delay_us) {
+    _strand.post([=, self=shared_from_this()]() {
+      _coalesce_max_bytes = max_bytes;
+      _coalesce_max_delay_us = max_delay_us;
+      if ((_coalesce_max_delay_us == 0u) && !_coalescing_messages.empty()) {
+        FlushCoalesced();
+      }
+    });
+  }
+
+  void ServerSession::AdjustQueuedCounter(const int64_t delta) {
+    DEBUG_ASSERT(_strand.running_in_this_thread());
+    if ((_queued_counter == nullptr) || (delta == 0)) {
+      return;
+    }
+    if (delta > 0) {
+      _queued_counter->fetch_add(static_cast<size_t>(delta), std::memory_order_relaxed);
+    } else {
+      _queued_counter->fetch_sub(static_cast<size_t>(-delta), std::memory_order_relaxed);
+    }
+  }
+
   void ServerSession::Write(std::shared_ptr<const Message> message) {
+    CARLA_TRACE_SCOPE(streaming, ServerSessionWrite);
+    CARLA_TRACE_EVENT(streaming, ServerSessionWrite);
     DEBUG_ASSERT(message != nullptr);
     DEBUG_ASSERT(!message->empty());
     auto self = shared_from_this();
-    _strand.post([=]() {
+    PendingMessage pending{std::move(message), StopWatch()};
+    _strand.post([=]() mutable {
       if (!_socket.is_open()) {
         return;
       }
       if (_is_writing) {
-        log_debug("session", _session_id, ": connection too slow: message discarded");
+        switch (_queue_policy) {
+          case QueuePolicy::keep_latest:
+            if (!_pending_messages.empty()) {
+              log_debug("session", _session_id, ": connection too slow: message discarded");
+            }
+            AdjustQueuedCounter(1 - static_cast<int64_t>(_pending_messages.size()));
+            _pending_messages.clear();
+            _pending_messages.emplace_back(std::move(pending));
+            break;
+          case QueuePolicy::drop_oldest:
+            AdjustQueuedCounter(1);
+            _pending_messages.emplace_back(std::move(pending));
+            while (_pending_messages.size() > _max_queue_depth) {
+              log_debug("session", _session_id, ": connection too slow: oldest message discarded");
+              AdjustQueuedCounter(-1);
+              _pending_messages.pop_front();
+            }
+            break;
+          case QueuePolicy::block:
+            AdjustQueuedCounter(1);
+            _pending_messages.emplace_back(std::move(pending));
+            break;
+        }
+        return;
+      }
+      if (_coalesce_max_delay_us > 0u) {
+        // park it in the open coalescing window instead of paying a write
+        // per message, the window closes on the byte cap or the timer
+        _coalescing_bytes += pending.message->size();
+        _coalescing_messages.emplace_back(std::move(pending));
+        if ((_coalesce_max_bytes > 0u) && (_coalescing_bytes >= _coalesce_max_bytes)) {
+          FlushCoalesced();
+          return;
+        }
+        if (!_coalesce_timer_armed) {
+          _coalesce_timer_armed = true;
+          _coalesce_timer.expires_from_now(
+              boost::posix_time::microseconds(static_cast<long>(_coalesce_max_delay_us)));
+          _coalesce_timer.async_wait(_strand.wrap(
+              [this, self](const boost::system::error_code &timer_ec) {
+                _coalesce_timer_armed = false;
+                if (!timer_ec) {
+                  FlushCoalesced();
+                }
+              }));
+        }
         return;
       }
       _is_writing = true;
+      std::vector<PendingMessage> batch;
+      batch.emplace_back(std::move(pending));
+      WriteNow(std::move(batch));
+    });
+  }
 
-      auto handle_sent = [this, self, message](const boost::system::error_code &ec, size_t DEBUG_ONLY(bytes)) {
+  void ServerSession::FlushCoalesced() {
+    DEBUG_ASSERT(_strand.running_in_this_thread());
+    if (_is_writing || _coalescing_messages.empty()) {
+      return;
+    }
+    _is_writing = true;
+    _coalescing_bytes = 0u;
+    auto batch = std::move(_coalescing_messages);
+    _coalescing_messages.clear();
+    WriteNow(std::move(batch));
+  }
+
+  void ServerSession::WriteNow(std::vector<PendingMessage> batch) {
+    DEBUG_ASSERT(_strand.running_in_this_thread());
+    DEBUG_ASSERT(!batch.empty());
+    auto self = shared_from_this();
+
+    // Prefix each message with its sequence number so the client can track
+    // what it has received and resume the session after a drop. A batch
+    // travels as one gathered write, but each message keeps its own framing
+    // on the wire, the receiving end cannot tell the difference.
+    _writing_sequences.clear();
+    _writing_sequences.reserve(batch.size());
+    size_t expected_bytes = 0u;
+    for (const auto &pending : batch) {
+      _writing_sequences.push_back(pending.message->GetSequence());
+      expected_bytes += sizeof(uint64_t) + sizeof(message_size_type) + pending.message->size();
+    }
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.reserve(batch.size() * (batch.front().message->max_size() + 1u));
+    for (auto i = 0u; i < batch.size(); ++i) {
+      buffers.emplace_back(&_writing_sequences[i], sizeof(uint64_t));
+      for (const auto &view : batch[i].message->GetBufferSequence()) {
+        buffers.emplace_back(view);
+      }
+    }
+
+    auto handle_sent = [this, self, batch = std::move(batch), expected_bytes](
+        const boost::system::error_code &ec,
+        size_t DEBUG_ONLY(bytes)) {
+      if (ec) {
         _is_writing = false;
-        if (ec) {
-          log_info("session", _session_id, ": error sending data :", ec.message());
-          CloseNow();
-        } else {
-          DEBUG_ONLY(log_debug("session", _session_id, ": successfully sent", bytes, "bytes"));
-          DEBUG_ASSERT_EQ(bytes, sizeof(message_size_type) + message->size());
-        }
-      };
+        AdjustQueuedCounter(-static_cast<int64_t>(_pending_messages.size()));
+        _pending_messages.clear();
+        log_info("session", _session_id, ": error sending data :", ec.message());
+        CloseNow();
+        return;
+      }
+      DEBUG_ONLY(log_debug("session", _session_id, ": successfully sent", bytes, "bytes"));
+      DEBUG_ASSERT_EQ(bytes, expected_bytes);
+      (void) expected_bytes;
+      for (const auto &pending : batch) {
+        StreamStatsRegistry::GetInstance().Annotate(
+            _stream_id,
+            StreamStage::send,
+            1e-3 * static_cast<double>(pending.stop_watch.GetElapsedTime<std::chrono::microseconds>()));
+      }
+      if (!_pending_messages.empty()) {
+        // drain what queued up behind this write; with coalescing enabled
+        // the whole backlog (up to the byte cap) goes out in one write
+        std::vector<PendingMessage> next;
+        size_t next_bytes = 0u;
+        do {
+          next_bytes += _pending_messages.front().message->size();
+          next.emplace_back(std::move(_pending_messages.front()));
+          _pending_messages.pop_front();
+          AdjustQueuedCounter(-1);
+        } while (
+            (_coalesce_max_delay_us > 0u) &&
+            !_pending_messages.empty() &&
+            ((_coalesce_max_bytes == 0u) || (next_bytes < _coalesce_max_bytes)));
+        WriteNow(std::move(next));
+      } else {
+        _is_writing = false;
+      }
+    };
 
-      log_debug("session", _session_id, ": sending message of", message->size(), "bytes");
+    log_debug("session", _session_id, ": sending", _writing_sequences.size(), "message(s)");
 
-      _deadline.expires_from_now(_timeout);
-      boost::asio::async_write(
-          _socket,
-          message->GetBufferSequence(),
-          _strand.wrap(handle_sent));
-    });
+    _deadline.expires_from_now(_timeout);
+    boost::asio::async_write(
+        _socket,
+        buffers,
+        _strand.wrap(handle_sent));
   }
 
   void ServerSession::Close() {
@@ -119,6 +301,12 @@ namespace tcp {
 
   void ServerSession::CloseNow() {
     DEBUG_ASSERT(_strand.running_in_this_thread());
+    // Messages still parked here will never be written, give them back to
+    // the counter so the producer side does not see a phantom backlog.
+    AdjustQueuedCounter(-static_cast<int64_t>(_pending_messages.size()));
+    _pending_messages.clear();
+    _coalescing_messages.clear();
+    _coalesce_timer.cancel();
     _deadline.cancel();
     if (_socket.is_open()) {
       _socket.close();
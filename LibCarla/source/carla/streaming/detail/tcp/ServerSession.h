@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/NonCopyable.h"
+#include "carla/StopWatch.h"
 #include "carla/Time.h"
 #include "carla/TypeTraits.h"
 #include "carla/profiler/LifetimeProfiled.h"
@@ -18,8 +19,11 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/strand.hpp>
 
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace carla {
 namespace streaming {
@@ -37,6 +41,8 @@ namespace tcp {
 
     using socket_type = boost::asio::ip::tcp::socket;
     using callback_function_type = std::function<void(std::shared_ptr<ServerSession>)>;
+    using message_type = Message;
+    using shared_message_type = std::shared_ptr<const Message>;
 
     explicit ServerSession(
         boost::asio::io_context &io_context,
@@ -54,6 +60,20 @@ namespace tcp {
       return _stream_id;
     }
 
+    /// Whether the client opened this session to resume a previous one, see
+    /// GetResumeSequence.
+    /// @warning Only meaningful after the session is opened.
+    bool IsResume() const {
+      return _is_resume;
+    }
+
+    /// Sequence number of the last message the resuming client received;
+    /// the stream replays the retained messages published after it.
+    /// @warning Only meaningful after the session is opened.
+    uint64_t GetResumeSequence() const {
+      return _resume_sequence;
+    }
+
     template <typename... Buffers>
     static auto MakeMessage(Buffers &&... buffers) {
       static_assert(
@@ -62,6 +82,23 @@ namespace tcp {
       return std::make_shared<const Message>(std::move(buffers)...);
     }
 
+    /// Set what to do with outgoing messages when the client cannot keep up.
+    /// @a max_queue_depth is only meaningful for QueuePolicy::drop_oldest.
+    void SetQueuePolicy(QueuePolicy policy, size_t max_queue_depth);
+
+    /// Install @a counter as the shared count of messages parked in this
+    /// session's queue behind an in-flight write. The producer side can poll
+    /// it to skip generating messages a keep-latest queue would discard.
+    void SetQueuedMessageCounter(std::shared_ptr<std::atomic_size_t> counter);
+
+    /// Coalesce small messages: gather messages for up to @a max_delay_us
+    /// microseconds, flushing early once @a max_bytes accumulate (zero
+    /// disables the byte trigger), and send them with a single gathered
+    /// write, trading a bounded delay for fewer syscalls and packets. Each
+    /// message keeps its own framing on the wire, subscribing clients need
+    /// no change. A zero @a max_delay_us (the default) disables coalescing.
+    void SetCoalescing(size_t max_bytes, size_t max_delay_us);
+
     /// Writes some data to the socket.
     void Write(std::shared_ptr<const Message> message);
 
@@ -76,6 +113,29 @@ namespace tcp {
 
   private:
 
+    /// A message waiting to be written, tagged with the time it entered the
+    /// session so the queue-to-socket latency can be annotated on the
+    /// stream stats registry.
+    struct PendingMessage {
+      std::shared_ptr<const Message> message;
+      StopWatch stop_watch;
+    };
+
+    /// Start the asynchronous gathered write of @a batch, chaining to the
+    /// pending queue once it completes.
+    /// @warning Must be called from within the strand.
+    void WriteNow(std::vector<PendingMessage> batch);
+
+    /// Send the messages parked in the coalescing buffer with one gathered
+    /// write. No-op while a write is already in flight, the buffer drains
+    /// with the pending queue when it completes.
+    /// @warning Must be called from within the strand.
+    void FlushCoalesced();
+
+    /// Add @a delta to the queued message counter, if one is installed.
+    /// @warning Must be called from within the strand.
+    void AdjustQueuedCounter(int64_t delta);
+
     void StartTimer();
 
     void CloseNow();
@@ -86,6 +146,14 @@ namespace tcp {
 
     stream_id_type _stream_id = 0u;
 
+    bool _is_resume = false;
+
+    uint64_t _resume_sequence = 0u;
+
+    /// Sequences of the in-flight batch, kept alive here while the gather
+    /// write that prefixes them to their messages is pending.
+    std::vector<uint64_t> _writing_sequences;
+
     socket_type _socket;
 
     time_duration _timeout;
@@ -97,6 +165,29 @@ namespace tcp {
     callback_function_type _on_closed;
 
     bool _is_writing = false;
+
+    QueuePolicy _queue_policy = QueuePolicy::keep_latest;
+
+    size_t _max_queue_depth = 1u;
+
+    std::deque<PendingMessage> _pending_messages;
+
+    std::shared_ptr<std::atomic_size_t> _queued_counter;
+
+    size_t _coalesce_max_bytes = 0u;
+
+    size_t _coalesce_max_delay_us = 0u;
+
+    boost::asio::deadline_timer _coalesce_timer;
+
+    bool _coalesce_timer_armed = false;
+
+    /// Messages parked while a coalescing window is open, see
+    /// SetCoalescing. Unlike _pending_messages they are never discarded by
+    /// the queue policy, a coalesced message is merely delayed.
+    std::vector<PendingMessage> _coalescing_messages;
+
+    size_t _coalescing_bytes = 0u;
   };
 
 } // namespace tcp
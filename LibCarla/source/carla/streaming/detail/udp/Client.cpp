@@ -0,0 +1,118 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/udp/Client.h"
+
+#include "carla/BufferPool.h"
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+#include "carla/streaming/detail/udp/Server.h"
+
+#include <exception>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace udp {
+
+  /// How often the subscription is refreshed, must stay well below the
+  /// server-side subscription timeout.
+  static constexpr long KEEP_ALIVE_PERIOD_SECONDS = 1;
+
+  Client::Client(
+      boost::asio::io_context &io_context,
+      const token_type &token,
+      callback_function_type callback)
+    : _token(token),
+      _callback(std::move(callback)),
+      _socket(io_context),
+      _strand(io_context),
+      _keep_alive_timer(io_context),
+      _buffer_pool(std::make_shared<BufferPool>(
+          "udp client stream " + std::to_string(token.get_stream_id()))) {
+    if (!_token.protocol_is_udp()) {
+      throw_exception(std::invalid_argument("invalid token, only UDP tokens supported"));
+    }
+  }
+
+  Client::~Client() = default;
+
+  void Client::Connect() {
+    auto self = shared_from_this();
+    _strand.post([this, self]() {
+      if (_done) {
+        return;
+      }
+      DEBUG_ASSERT(_token.is_valid());
+      const auto ep = _token.to_udp_endpoint();
+      boost::system::error_code ec;
+      _socket.connect(ep, ec);
+      if (ec) {
+        log_error("udp client: connection failed:", ec.message());
+        return;
+      }
+      log_debug("udp client: subscribing to stream", _token.get_stream_id(), "at", ep);
+      SendSubscription();
+      ReadData();
+    });
+  }
+
+  void Client::SendSubscription() {
+    if (_done) {
+      return;
+    }
+    const auto &stream_id = _token.get_stream_id();
+    boost::system::error_code ec;
+    _socket.send(boost::asio::buffer(&stream_id, sizeof(stream_id)), 0u, ec);
+    if (ec) {
+      log_debug("udp client: error sending subscription:", ec.message());
+    }
+    auto self = shared_from_this();
+    _keep_alive_timer.expires_from_now(boost::posix_time::seconds(KEEP_ALIVE_PERIOD_SECONDS));
+    _keep_alive_timer.async_wait([this, self](boost::system::error_code timer_ec) {
+      if (!timer_ec) {
+        SendSubscription();
+      }
+    });
+  }
+
+  void Client::ReadData() {
+    if (_done) {
+      return;
+    }
+    auto self = shared_from_this();
+    auto buffer = std::make_shared<Buffer>(_buffer_pool->Pop(Server::max_datagram_size));
+    buffer->reset(static_cast<Buffer::size_type>(Server::max_datagram_size));
+    _socket.async_receive(
+        buffer->buffer(),
+        [this, self, buffer](boost::system::error_code ec, size_t bytes) {
+          if (ec) {
+            if (!_done) {
+              log_debug("udp client: error receiving datagram:", ec.message());
+            }
+            return;
+          }
+          buffer->resize(bytes);
+          _callback(std::move(*buffer));
+          ReadData();
+        });
+  }
+
+  void Client::Stop() {
+    _done = true;
+    auto self = shared_from_this();
+    _strand.post([this, self]() {
+      _keep_alive_timer.cancel();
+      if (_socket.is_open()) {
+        _socket.close();
+      }
+    });
+  }
+
+} // namespace udp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
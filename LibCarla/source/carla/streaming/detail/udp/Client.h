@@ -0,0 +1,85 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+#include "carla/streaming/detail/Token.h"
+#include "carla/streaming/detail/Types.h"
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace carla {
+
+  class BufferPool;
+
+namespace streaming {
+namespace detail {
+namespace udp {
+
+  /// A client that subscribes to a single datagram stream. Mirrors the
+  /// interface of tcp::Client so low_level::Client can use either one
+  /// depending on the protocol carried by the token.
+  ///
+  /// @warning Datagrams may be lost or arrive out of order, use only for
+  /// streams where freshness beats completeness.
+  class Client
+    : public std::enable_shared_from_this<Client>,
+      private NonCopyable {
+  public:
+
+    using callback_function_type = std::function<void (Buffer)>;
+
+    Client(
+        boost::asio::io_context &io_context,
+        const token_type &token,
+        callback_function_type callback);
+
+    ~Client();
+
+    void Connect();
+
+    stream_id_type GetStreamId() const {
+      return _token.get_stream_id();
+    }
+
+    void Stop();
+
+  private:
+
+    /// (Re)send the subscription datagram, keeping the subscription alive
+    /// server-side.
+    void SendSubscription();
+
+    void ReadData();
+
+    const token_type _token;
+
+    callback_function_type _callback;
+
+    boost::asio::ip::udp::socket _socket;
+
+    boost::asio::io_context::strand _strand;
+
+    boost::asio::deadline_timer _keep_alive_timer;
+
+    std::shared_ptr<BufferPool> _buffer_pool;
+
+    std::atomic_bool _done{false};
+  };
+
+} // namespace udp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/udp/Server.h"
+
+#include "carla/Logging.h"
+
+#include <boost/asio/buffer.hpp>
+
+#include <algorithm>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace udp {
+
+  /// Subscribers that haven't refreshed their subscription for this long are
+  /// dropped on the next write.
+  static constexpr auto SUBSCRIPTION_TIMEOUT = std::chrono::seconds(10);
+
+  Server::Server(boost::asio::io_context &io_context, endpoint ep)
+    : _socket(io_context, std::move(ep)) {}
+
+  void Server::Listen() {
+    ReadSubscription();
+  }
+
+  void Server::ReadSubscription() {
+    auto self = shared_from_this();
+    _socket.async_receive_from(
+        boost::asio::buffer(&_incoming_stream_id, sizeof(_incoming_stream_id)),
+        _incoming_endpoint,
+        [this, self](boost::system::error_code ec, size_t bytes) {
+          if (ec) {
+            log_debug("udp server: error receiving subscription:", ec.message());
+            return;
+          }
+          if (bytes == sizeof(_incoming_stream_id)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto &subscribers = _subscribers[_incoming_stream_id];
+            auto it = std::find_if(
+                subscribers.begin(),
+                subscribers.end(),
+                [this](const Subscriber &subscriber) {
+                  return subscriber.ep == _incoming_endpoint;
+                });
+            if (it == subscribers.end()) {
+              log_debug("udp server: new subscriber for stream", _incoming_stream_id);
+              subscribers.emplace_back(Subscriber{_incoming_endpoint, clock::now()});
+            } else {
+              it->last_seen = clock::now();
+            }
+          }
+          ReadSubscription();
+        });
+  }
+
+  void Server::Write(
+      const stream_id_type stream_id,
+      const Session::shared_message_type &message) {
+    if (message->size() > max_datagram_size) {
+      log_warning("udp server: message of", message->size(), "bytes doesn't fit a datagram, discarded");
+      return;
+    }
+    // Skip the leading size prefix, datagrams delimit themselves.
+    std::vector<boost::asio::const_buffer> views;
+    bool first = true;
+    for (const auto &view : message->GetBufferSequence()) {
+      if (first) {
+        first = false;
+        continue;
+      }
+      views.emplace_back(view);
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _subscribers.find(stream_id);
+    if (it == _subscribers.end()) {
+      return;
+    }
+    const auto now = clock::now();
+    auto &subscribers = it->second;
+    subscribers.erase(
+        std::remove_if(
+            subscribers.begin(),
+            subscribers.end(),
+            [now](const Subscriber &subscriber) {
+              return (now - subscriber.last_seen) > SUBSCRIPTION_TIMEOUT;
+            }),
+        subscribers.end());
+    auto self = shared_from_this();
+    for (const auto &subscriber : subscribers) {
+      _socket.async_send_to(
+          views,
+          subscriber.ep,
+          [self, message](boost::system::error_code ec, size_t) {
+            if (ec) {
+              log_debug("udp server: error sending datagram:", ec.message());
+            }
+          });
+    }
+  }
+
+} // namespace udp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -0,0 +1,75 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/streaming/detail/Session.h"
+#include "carla/streaming/detail/Types.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace udp {
+
+  /// Unreliable datagram transport for streams whose consumers care about
+  /// freshness, not completeness (IMU, GNSS, collision events). A client
+  /// subscribes by sending the stream id as a datagram and keeps the
+  /// subscription alive by repeating it; stale subscribers are purged. Each
+  /// message must fit in a single datagram.
+  class Server
+    : public std::enable_shared_from_this<Server>,
+      private NonCopyable {
+  public:
+
+    using endpoint = boost::asio::ip::udp::endpoint;
+
+    /// Maximum payload carried by one datagram.
+    static constexpr size_t max_datagram_size = 65000u;
+
+    Server(boost::asio::io_context &io_context, endpoint ep);
+
+    /// Start receiving subscription datagrams.
+    void Listen();
+
+    /// Send @a message to every subscriber of @a stream_id. The leading size
+    /// prefix is skipped, datagrams delimit themselves.
+    void Write(stream_id_type stream_id, const Session::shared_message_type &message);
+
+  private:
+
+    using clock = std::chrono::steady_clock;
+
+    struct Subscriber {
+      endpoint ep;
+      clock::time_point last_seen;
+    };
+
+    void ReadSubscription();
+
+    boost::asio::ip::udp::socket _socket;
+
+    stream_id_type _incoming_stream_id = 0u;
+
+    endpoint _incoming_endpoint;
+
+    std::mutex _mutex;
+
+    std::unordered_map<stream_id_type, std::vector<Subscriber>> _subscribers;
+  };
+
+} // namespace udp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
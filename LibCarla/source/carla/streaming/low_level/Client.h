@@ -6,12 +6,17 @@
 
 #pragma once
 
+#include "carla/Buffer.h"
 #include "carla/streaming/detail/Token.h"
+#include "carla/streaming/detail/shm/Client.h"
 #include "carla/streaming/detail/tcp/Client.h"
+#include "carla/streaming/detail/udp/Client.h"
 
 #include <boost/asio/io_context.hpp>
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace carla {
@@ -44,6 +49,20 @@ namespace low_level {
       for (auto &pair : _clients) {
         pair.second->Stop();
       }
+      for (auto &pair : _shm_clients) {
+        pair.second->Stop();
+      }
+      for (auto &pair : _udp_clients) {
+        pair.second->Stop();
+      }
+    }
+
+    /// Install @a extractor to read the sub-stream id the producer stamped
+    /// on each message of a multiplexed group, required before subscribing
+    /// to a multiplexed stream. The sensor layer installs one reading its
+    /// data header, see carla::sensor::s11n::SensorHeaderSerializer.
+    void SetSubStreamIdExtractor(std::function<uint64_t(const Buffer &)> extractor) {
+      _extract_sub_stream_id = std::move(extractor);
     }
 
     /// @warning cannot subscribe twice to the same stream (even if it's a
@@ -53,33 +72,168 @@ namespace low_level {
         boost::asio::io_context &io_context,
         token_type token,
         Functor &&callback) {
-      DEBUG_ASSERT_EQ(_clients.find(token.get_stream_id()), _clients.end());
-      if (!token.has_address()) {
-        token.set_address(_fallback_address);
+      if (token.is_multiplexed()) {
+        SubscribeToSubStream(io_context, token, std::forward<Functor>(callback));
+        return;
       }
-      auto client = std::make_shared<underlying_client>(
-          io_context,
-          token,
-          std::forward<Functor>(callback));
-      client->Connect();
-      _clients.emplace(token.get_stream_id(), std::move(client));
+      ConnectToStream(io_context, token, std::forward<Functor>(callback));
     }
 
     void UnSubscribe(token_type token) {
+      if (token.is_multiplexed() && !RemoveSubStreamCallback(token)) {
+        // other sub-streams of the group are still subscribed, keep the
+        // shared connection alive
+        return;
+      }
       auto it = _clients.find(token.get_stream_id());
       if (it != _clients.end()) {
         it->second->Stop();
         _clients.erase(it);
+        return;
+      }
+      auto shm_it = _shm_clients.find(token.get_stream_id());
+      if (shm_it != _shm_clients.end()) {
+        shm_it->second->Stop();
+        _shm_clients.erase(shm_it);
+        return;
+      }
+      auto udp_it = _udp_clients.find(token.get_stream_id());
+      if (udp_it != _udp_clients.end()) {
+        udp_it->second->Stop();
+        _udp_clients.erase(udp_it);
       }
     }
 
   private:
 
+    /// Callbacks of the subscribed sub-streams of one multiplexed group,
+    /// routed by the sub-stream id extracted from each incoming message.
+    /// The mutex guards the callback map against (un)subscriptions racing
+    /// the io-context threads.
+    struct SubStreamDemux {
+      std::mutex mutex;
+      std::unordered_map<uint64_t, std::function<void(Buffer)>> callbacks;
+    };
+
+    /// Register @a callback for @a token's sub-stream, opening the shared
+    /// connection of its group on the first subscription.
+    template <typename Functor>
+    void SubscribeToSubStream(
+        boost::asio::io_context &io_context,
+        const token_type &token,
+        Functor &&callback) {
+      DEBUG_ASSERT(_extract_sub_stream_id != nullptr);
+      auto it = _demuxes.find(token.get_stream_id());
+      if (it == _demuxes.end()) {
+        auto demux = std::make_shared<SubStreamDemux>();
+        it = _demuxes.emplace(token.get_stream_id(), demux).first;
+        // the connection callback only holds a weak reference, the demux
+        // dies with the last unsubscription even if the connection lingers
+        std::weak_ptr<SubStreamDemux> weak_demux = demux;
+        ConnectToStream(io_context, token,
+            [weak_demux, extract = _extract_sub_stream_id](Buffer message) {
+              auto pinned = weak_demux.lock();
+              if (pinned == nullptr) {
+                return;
+              }
+              const auto sub_stream_id = extract(message);
+              std::function<void(Buffer)> sub_callback;
+              {
+                std::lock_guard<std::mutex> lock(pinned->mutex);
+                auto search = pinned->callbacks.find(sub_stream_id);
+                if (search != pinned->callbacks.end()) {
+                  sub_callback = search->second;
+                }
+              }
+              // messages of sub-streams nobody subscribed to are dropped
+              if (sub_callback) {
+                sub_callback(std::move(message));
+              }
+            });
+      }
+      std::lock_guard<std::mutex> lock(it->second->mutex);
+      DEBUG_ASSERT_EQ(
+          it->second->callbacks.find(token.get_sub_stream_id()),
+          it->second->callbacks.end());
+      it->second->callbacks[token.get_sub_stream_id()] =
+          std::function<void(Buffer)>(std::forward<Functor>(callback));
+    }
+
+    /// Drop @a token's sub-stream callback. Returns true if it was the last
+    /// one of its group, i.e. the shared connection should be closed.
+    bool RemoveSubStreamCallback(const token_type &token) {
+      auto it = _demuxes.find(token.get_stream_id());
+      if (it == _demuxes.end()) {
+        return false;
+      }
+      bool last;
+      {
+        std::lock_guard<std::mutex> lock(it->second->mutex);
+        it->second->callbacks.erase(token.get_sub_stream_id());
+        last = it->second->callbacks.empty();
+      }
+      if (last) {
+        _demuxes.erase(it);
+      }
+      return last;
+    }
+
+    /// Open the connection of @a token's stream, delivering every incoming
+    /// message to @a callback.
+    template <typename Functor>
+    void ConnectToStream(
+        boost::asio::io_context &io_context,
+        token_type token,
+        Functor &&callback) {
+      DEBUG_ASSERT_EQ(_clients.find(token.get_stream_id()), _clients.end());
+      if (token.protocol_is_shm()) {
+        auto client = std::make_shared<detail::shm::Client>(
+            io_context,
+            token,
+            std::forward<Functor>(callback));
+        client->Connect();
+        _shm_clients.emplace(token.get_stream_id(), std::move(client));
+        return;
+      }
+      if (!token.has_address()) {
+        token.set_address(_fallback_address);
+      }
+      if (token.protocol_is_udp()) {
+        auto client = std::make_shared<detail::udp::Client>(
+            io_context,
+            token,
+            std::forward<Functor>(callback));
+        client->Connect();
+        _udp_clients.emplace(token.get_stream_id(), std::move(client));
+        return;
+      }
+      auto client = std::make_shared<underlying_client>(
+          io_context,
+          token,
+          std::forward<Functor>(callback));
+      client->Connect();
+      _clients.emplace(token.get_stream_id(), std::move(client));
+    }
+
     boost::asio::ip::address _fallback_address;
 
+    std::function<uint64_t(const Buffer &)> _extract_sub_stream_id;
+
+    std::unordered_map<
+        detail::stream_id_type,
+        std::shared_ptr<SubStreamDemux>> _demuxes;
+
     std::unordered_map<
         detail::stream_id_type,
         std::shared_ptr<underlying_client>> _clients;
+
+    std::unordered_map<
+        detail::stream_id_type,
+        std::shared_ptr<detail::shm::Client>> _shm_clients;
+
+    std::unordered_map<
+        detail::stream_id_type,
+        std::shared_ptr<detail::udp::Client>> _udp_clients;
   };
 
 } // namespace low_level
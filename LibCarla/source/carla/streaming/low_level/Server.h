@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/streaming/detail/Dispatcher.h"
+#include "carla/streaming/detail/udp/Server.h"
 #include "carla/streaming/Stream.h"
 
 #include <boost/asio/io_context.hpp>
@@ -60,14 +61,64 @@ namespace low_level {
       _server.SetTimeout(timeout);
     }
 
+    /// @copydoc detail::Dispatcher::EnableSharedMemory()
+    void EnableSharedMemory() {
+      _dispatcher.EnableSharedMemory();
+    }
+
+    /// @copydoc detail::tcp::Server::SetSessionShards()
+    void SetSessionShards(std::vector<boost::asio::io_context *> contexts) {
+      _server.SetSessionShards(std::move(contexts));
+    }
+
+    /// @copydoc detail::Dispatcher::SetUdpServer()
+    void SetUdpServer(std::shared_ptr<detail::udp::Server> udp_server) {
+      _dispatcher.SetUdpServer(std::move(udp_server));
+    }
+
+    /// @copydoc detail::Dispatcher::MakeUdpStream()
+    Stream MakeUdpStream() {
+      return _dispatcher.MakeUdpStream();
+    }
+
+    /// @copydoc detail::Dispatcher::MakeUdpMultiStream()
+    MultiStream MakeUdpMultiStream() {
+      return _dispatcher.MakeUdpMultiStream();
+    }
+
+    /// @copydoc detail::Dispatcher::SetStreamIdNamespace()
+    void SetStreamIdNamespace(uint8_t ns) {
+      _dispatcher.SetStreamIdNamespace(ns);
+    }
+
     Stream MakeStream() {
       return _dispatcher.MakeStream();
     }
 
+    /// @copydoc detail::Dispatcher::MakeStream(detail::stream_id_type)
+    boost::optional<Stream> MakeStream(detail::stream_id_type stream_id) {
+      return _dispatcher.MakeStream(stream_id);
+    }
+
+    /// @copydoc detail::Dispatcher::MakeMultiplexedStream()
+    Stream MakeMultiplexedStream() {
+      return _dispatcher.MakeMultiplexedStream();
+    }
+
+    /// @copydoc detail::Dispatcher::MakeMultiplexedStream(const carla::streaming::Stream &)
+    Stream MakeMultiplexedStream(const Stream &group) {
+      return _dispatcher.MakeMultiplexedStream(group);
+    }
+
     MultiStream MakeMultiStream() {
       return _dispatcher.MakeMultiStream();
     }
 
+    /// @copydoc detail::Dispatcher::CountStreams()
+    detail::Dispatcher::MapStats CountStreams() {
+      return _dispatcher.CountStreams();
+    }
+
   private:
 
     void StartServer() {
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -20,33 +22,65 @@ namespace traffic_manager {
   using ActorPtr = carla::SharedPtr<cc::Actor>;
   using ActorId = carla::ActorId;
 
+  /// Set of registered actors with copy-on-write semantics. Registration
+  /// changes serialize on a mutex and swap in fresh immutable snapshots;
+  /// readers grab the current snapshot atomically and never take the lock.
   class AtomicActorSet {
 
   private:
 
+    /// Mutex serializing registration changes.
     std::mutex modification_mutex;
+    /// Authoritative store, only touched while holding the mutex.
     std::unordered_map<ActorId, ActorPtr> actor_set;
-    int state_counter;
+    /// Immutable snapshot of the actor set, swapped atomically on change.
+    std::shared_ptr<const std::unordered_map<ActorId, ActorPtr>> set_snapshot;
+    /// Immutable snapshot of the actor list, swapped atomically on change.
+    std::shared_ptr<const std::vector<ActorPtr>> list_snapshot;
+    std::atomic<int> state_counter;
+
+    /// Rebuilds both snapshots from the authoritative store; must be
+    /// called while holding the mutex.
+    void RefreshSnapshots() {
+
+      auto updated_set = std::make_shared<std::unordered_map<ActorId, ActorPtr>>(actor_set);
+      auto updated_list = std::make_shared<std::vector<ActorPtr>>();
+      updated_list->reserve(actor_set.size());
+      for (auto it = actor_set.begin(); it != actor_set.end(); ++it) {
+        updated_list->push_back(it->second);
+      }
+      std::atomic_store(&set_snapshot,
+                        std::shared_ptr<const std::unordered_map<ActorId, ActorPtr>>(std::move(updated_set)));
+      std::atomic_store(&list_snapshot,
+                        std::shared_ptr<const std::vector<ActorPtr>>(std::move(updated_list)));
+      ++state_counter;
+    }
 
   public:
 
-    AtomicActorSet(): state_counter(0) {}
+    AtomicActorSet()
+      : set_snapshot(std::make_shared<std::unordered_map<ActorId, ActorPtr>>()),
+        list_snapshot(std::make_shared<std::vector<ActorPtr>>()),
+        state_counter(0) {}
 
-    std::vector<ActorPtr> GetList() {
+    /// Returns a stable, immutable snapshot of the actor list; stage loops
+    /// can hold on to it for a whole frame without copying.
+    std::shared_ptr<const std::vector<ActorPtr>> GetListSnapshot() const {
 
-      std::lock_guard<std::mutex> lock(modification_mutex);
-      std::vector<ActorPtr> actor_list;
-      for (auto it = actor_set.begin(); it != actor_set.end(); ++it) {
-        actor_list.push_back(it->second);
-      }
-      return actor_list;
+      return std::atomic_load(&list_snapshot);
     }
 
-    std::vector<ActorId> GetIDList() {
+    std::vector<ActorPtr> GetList() const {
 
-      std::lock_guard<std::mutex> lock(modification_mutex);
+      return *std::atomic_load(&list_snapshot);
+    }
+
+    std::vector<ActorId> GetIDList() const {
+
+      const auto current_snapshot = std::atomic_load(&set_snapshot);
       std::vector<ActorId> actor_list;
-      for (auto it = actor_set.begin(); it != actor_set.end(); ++it) {
+      actor_list.reserve(current_snapshot->size());
+      for (auto it = current_snapshot->begin(); it != current_snapshot->end(); ++it) {
         actor_list.push_back(it->first);
       }
       return actor_list;
@@ -58,7 +92,7 @@ namespace traffic_manager {
       for (auto &actor: actor_list) {
         actor_set.insert({actor->GetId(), actor});
       }
-      ++state_counter;
+      RefreshSnapshots();
     }
 
     void Remove(std::vector<ActorPtr> actor_list) {
@@ -67,7 +101,7 @@ namespace traffic_manager {
       for (auto& actor: actor_list) {
         actor_set.erase(actor->GetId());
       }
-      ++state_counter;
+      RefreshSnapshots();
     }
 
     void Destroy(ActorPtr actor) {
@@ -75,25 +109,23 @@ namespace traffic_manager {
       std::lock_guard<std::mutex> lock(modification_mutex);
       actor_set.erase(actor->GetId());
       actor->Destroy();
-      ++state_counter;
+      RefreshSnapshots();
     }
 
-    int GetState() {
+    int GetState() const {
 
-      std::lock_guard<std::mutex> lock(modification_mutex);
-      return state_counter;
+      return state_counter.load();
     }
 
-    bool Contains(ActorId id) {
+    bool Contains(ActorId id) const {
 
-      std::lock_guard<std::mutex> lock(modification_mutex);
-      return actor_set.find(id) != actor_set.end();
+      const auto current_snapshot = std::atomic_load(&set_snapshot);
+      return current_snapshot->find(id) != current_snapshot->end();
     }
 
-    size_t Size() {
+    size_t Size() const {
 
-      std::lock_guard<std::mutex> lock(modification_mutex);
-      return actor_set.size();
+      return std::atomic_load(&set_snapshot)->size();
     }
 
   };
@@ -6,46 +6,59 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
 namespace carla {
 namespace traffic_manager {
 
+  /// Map with copy-on-write semantics. Writers serialize on a mutex and
+  /// swap in a fresh immutable snapshot; readers grab the current snapshot
+  /// atomically and never take the lock, so per-frame stage loops don't
+  /// contend with registration changes.
   template <typename Key, typename Value>
   class AtomicMap {
 
     private:
 
+    /// Mutex serializing modifications.
     std::mutex map_mutex;
-    std::unordered_map<Key, Value> map;
+    /// Immutable snapshot of the map, swapped atomically on modification.
+    std::shared_ptr<const std::unordered_map<Key, Value>> snapshot;
 
     public:
 
-    AtomicMap() {}
+    AtomicMap() : snapshot(std::make_shared<std::unordered_map<Key, Value>>()) {}
 
     void AddEntry(const std::pair<Key, Value> &entry) {
 
       std::lock_guard<std::mutex> lock(map_mutex);
-      map.insert(entry);
+      auto updated_map = std::make_shared<std::unordered_map<Key, Value>>(*snapshot);
+      (*updated_map)[entry.first] = entry.second;
+      std::atomic_store(&snapshot,
+                        std::shared_ptr<const std::unordered_map<Key, Value>>(std::move(updated_map)));
     }
 
-    bool Contains(const Key &key) {
+    bool Contains(const Key &key) const {
 
-      std::lock_guard<std::mutex> lock(map_mutex);
-      return map.find(key) != map.end();
+      const auto current_snapshot = std::atomic_load(&snapshot);
+      return current_snapshot->find(key) != current_snapshot->end();
     }
 
-    Value &GetValue(const Key &key) {
+    Value GetValue(const Key &key) const {
 
-      std::lock_guard<std::mutex> lock(map_mutex);
-      return map.at(key);
+      const auto current_snapshot = std::atomic_load(&snapshot);
+      return current_snapshot->at(key);
     }
 
     void RemoveEntry(const Key &key) {
 
       std::lock_guard<std::mutex> lock(map_mutex);
-      map.erase(key);
+      auto updated_map = std::make_shared<std::unordered_map<Key, Value>>(*snapshot);
+      updated_map->erase(key);
+      std::atomic_store(&snapshot,
+                        std::shared_ptr<const std::unordered_map<Key, Value>>(std::move(updated_map)));
     }
 
   };
@@ -38,11 +38,23 @@ void BatchControlStage::Action() {
     }
     const carla::ActorId actor_id = element.actor->GetId();
 
+    // Reduced-rate LOD hold; re-apply the last control so far-away
+    // vehicles keep their current motion between full updates.
+    if (element.lod_hold) {
+      const auto last_control = last_applied_control.find(actor_id);
+      if (last_control != last_applied_control.end()) {
+        vehicle_control = last_control->second;
+      }
+      commands->at(i) = carla::rpc::Command::ApplyVehicleControl(actor_id, vehicle_control);
+      continue;
+    }
+
     // Apply actuation from controller if physics enabled.
     if (element.physics_enabled) {
       vehicle_control.throttle = element.throttle;
       vehicle_control.brake = element.brake;
       vehicle_control.steer = element.steer;
+      last_applied_control[actor_id] = vehicle_control;
 
       commands->at(i) = carla::rpc::Command::ApplyVehicleControl(actor_id, vehicle_control);
     }
@@ -87,11 +99,22 @@ void BatchControlStage::DataSender() {
   messenger->Pop();
   bool synch_mode = parameters.GetSynchronousMode();
 
+  CommandSink sink;
+  {
+    std::lock_guard<std::mutex> sink_lock(command_sink_mutex);
+    sink = command_sink;
+  }
+
   // Asynchronous mode.
   if (!synch_mode) {
-    // Apply batch command through an asynchronous RPC call.
     if (commands != nullptr) {
-      episode_proxy_bcs.Lock()->ApplyBatch(*commands.get(), false);
+      if (sink) {
+        // Direct in-process hand-off, no serialization involved.
+        sink(*commands.get());
+      } else {
+        // Apply batch command through an asynchronous RPC call.
+        episode_proxy_bcs.Lock()->ApplyBatch(*commands.get(), false);
+      }
     }
     // Applying an infinitesimal sleep statement for providing a system cancellation point.
     std::this_thread::sleep_for(1us);
@@ -103,9 +126,15 @@ void BatchControlStage::DataSender() {
     while (!run_step.load()) {
       step_execution_notifier.wait_for(lock, 1ms, [this]() {return run_step.load();});
     }
-    // Apply batch command in synchronous RPC call.
     if (commands != nullptr) {
-      episode_proxy_bcs.Lock()->ApplyBatchSync(*commands.get(), true);
+      if (sink) {
+        // Direct in-process hand-off; runs inside the step window so the
+        // frame semantics match the RPC path.
+        sink(*commands.get());
+      } else {
+        // Apply batch command in synchronous RPC call.
+        episode_proxy_bcs.Lock()->ApplyBatchSync(*commands.get(), true);
+      }
     }
     // Set flag to false, unblock RunStep() call and release mutex lock.
     run_step.store(false);
@@ -115,6 +144,12 @@ void BatchControlStage::DataSender() {
 }
 
 
+void BatchControlStage::SetCommandSink(CommandSink sink) {
+
+  std::lock_guard<std::mutex> sink_lock(command_sink_mutex);
+  command_sink = std::move(sink);
+}
+
 bool BatchControlStage::RunStep() {
 
   bool synch_mode = parameters.GetSynchronousMode();
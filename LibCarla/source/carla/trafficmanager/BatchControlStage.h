@@ -8,8 +8,10 @@
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 
 #include "carla/client/detail/EpisodeProxy.h"
 #include "carla/client/detail/Simulator.h"
@@ -27,6 +29,11 @@ namespace traffic_manager {
 
 using namespace std::literals::chrono_literals;
 
+/// Signature of a direct in-process consumer for per-frame control
+/// batches. The referenced batch is only valid for the duration of the
+/// call; consumers must copy anything they keep.
+using CommandSink = std::function<void(const std::vector<carla::rpc::Command> &)>;
+
 /// This class receives actuation signals (throttle, brake, steer)
 /// from Motion Planner Stage class and communicates these signals to
 /// the simulator in batches to control vehicles' movement.
@@ -44,8 +51,16 @@ private:
   std::shared_ptr<std::vector<carla::rpc::Command>> commands;
   /// Number of vehicles registered with the traffic manager.
   uint64_t number_of_vehicles;
+  /// Last control applied per vehicle, re-applied on reduced-rate LOD
+  /// hold frames.
+  std::unordered_map<carla::ActorId, carla::rpc::VehicleControl> last_applied_control;
   /// Parameter object for changing synchronous behaviour.
   Parameters &parameters;
+  /// Optional direct in-process consumer for the command batch; when
+  /// installed, batches bypass RPC serialization entirely.
+  CommandSink command_sink;
+  /// Mutex guarding installation of the command sink.
+  std::mutex command_sink_mutex;
   /// Step runner flag.
   std::atomic<bool> run_step {false};
   /// Mutex for progressing synchronous execution.
@@ -70,6 +85,10 @@ public:
   void DataSender() override;
 
   bool RunStep();
+
+  /// Installs a direct in-process consumer for the per-frame command
+  /// batch, replacing submission through the RPC client.
+  void SetCommandSink(CommandSink sink);
 };
 
 } // namespace traffic_manager
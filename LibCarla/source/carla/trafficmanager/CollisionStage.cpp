@@ -6,6 +6,8 @@
 
 #include "CollisionStage.h"
 
+#include "carla/trafficmanager/StageParallelism.h"
+
 #define MAX(__a, __b) ((__a) > (__b) ? (__a) : (__b))
 
 namespace carla {
@@ -61,14 +63,58 @@ namespace CollisionStageConstants {
     vehicle_cache.clear();
     const auto current_planner_frame = frame_selector ? planner_frame_a : planner_frame_b;
 
-    // Looping over registered actors.
-    for (uint64_t i = 0u; i < number_of_vehicles && localization_frame != nullptr; ++i) {
+    if (localization_frame == nullptr) {
+      return;
+    }
 
-      LocalizationToCollisionData &data = localization_frame->at(i);
+    ++dice_frame_counter;
+
+    // Broad phase: conservative axis-aligned boxes around the extended path
+    // geometry of every registered vehicle. Candidate pairs whose boxes do
+    // not overlap are rejected in NegotiateCollision before any boundary or
+    // polygon work is done for them.
+    vehicle_path_boxes.assign(number_of_vehicles, {0.0f, 0.0f, 0.0f, 0.0f});
+    for (uint64_t i = 0u; i < number_of_vehicles; ++i) {
+
+      const LocalizationToCollisionData &data = localization_frame->at(i);
       if (!data.actor->IsAlive()) {
         continue;
       }
 
+      const cg::Location location = data.actor->GetLocation();
+      const auto vehicle = boost::static_pointer_cast<cc::Vehicle>(data.actor);
+      const cg::Vector3D extent = vehicle->GetBoundingBox().extent;
+      float bbox_extension = GetBoundingBoxExtention(data.actor->GetId(), data.velocity,
+                                                     data.actor->GetTransform().GetForwardVector());
+      bbox_extension = MAX(bbox_extension, parameters.GetDistanceToLeadingVehicle(data.actor));
+      // Box reach covers the geodesic boundary: path extension plus the
+      // vehicle's own footprint on either side.
+      const float reach = bbox_extension + 2.0f * extent.x * SQUARE_ROOT_OF_TWO + extent.y;
+      vehicle_path_boxes.at(i) = {location.x - reach, location.y - reach,
+                                  location.x + reach, location.y + reach};
+    }
+
+    // Looping over registered actors; each vehicle only reads the frame
+    // snapshot and writes its own output slot, the shared geometry caches
+    // have their own mutex, so the loop is partitioned over the stage
+    // workers.
+    ParallelForEachIndex(number_of_vehicles, [&](uint64_t i) {
+
+      LocalizationToCollisionData &data = localization_frame->at(i);
+      if (!data.actor->IsAlive()) {
+        return;
+      }
+
+      // Reduced-rate LOD hold; the planner reuses its previous actuation
+      // for this vehicle, so no fresh hazard information is needed.
+      if (data.lod_hold) {
+        CollisionToPlannerData &message = current_planner_frame->at(i);
+        message.hazard = false;
+        message.distance_to_other_vehicle = std::numeric_limits<float>::infinity();
+        message.other_vehicle_velocity = cg::Vector3D();
+        return;
+      }
+
       const Actor ego_actor = data.actor;
       const ActorId ego_actor_id = ego_actor->GetId();
       const cg::Location ego_location = ego_actor->GetLocation();
@@ -122,8 +168,18 @@ namespace CollisionStageConstants {
                     || negotiation_result.first)
                 {
 
-                  if ((other_actor_type[0] == 'v' && parameters.GetPercentageIgnoreVehicles(ego_actor) <= (rand() % 101)) ||
-                      (other_actor_type[0] == 'w' && parameters.GetPercentageIgnoreWalkers(ego_actor) <= (rand() % 101)))
+                  // The draw is keyed by the other actor's id so decisions
+                  // for different candidates stay independent within a frame.
+                  const int ignore_vehicles_dice = deterministic_mode
+                      ? RollDeterministicDice(random_seed, ego_actor_id, dice_frame_counter,
+                                              DICE_STREAM_IGNORE_VEHICLES, other_actor_id)
+                      : RollPercentageDice();
+                  const int ignore_walkers_dice = deterministic_mode
+                      ? RollDeterministicDice(random_seed, ego_actor_id, dice_frame_counter,
+                                              DICE_STREAM_IGNORE_WALKERS, other_actor_id)
+                      : RollPercentageDice();
+                  if ((other_actor_type[0] == 'v' && parameters.GetPercentageIgnoreVehicles(ego_actor) <= ignore_vehicles_dice) ||
+                      (other_actor_type[0] == 'w' && parameters.GetPercentageIgnoreWalkers(ego_actor) <= ignore_walkers_dice))
                   {
                     collision_hazard = true;
                     available_distance_margin = negotiation_result.second;
@@ -143,13 +199,16 @@ namespace CollisionStageConstants {
       message.hazard = collision_hazard;
       message.distance_to_other_vehicle = available_distance_margin;
       message.other_vehicle_velocity = obstacle_velocity;
-    }
+    });
   }
 
   void CollisionStage::DataReceiver() {
 
     localization_frame = localization_messenger->Peek();
 
+    deterministic_mode = parameters.GetDeterministicMode();
+    random_seed = parameters.GetRandomSeed();
+
     if (localization_frame != nullptr) {
 
       // Connecting actor ids to their position indices on data arrays.
@@ -174,8 +233,16 @@ namespace CollisionStageConstants {
       }
     }
 
-    // Cleaning geodesic boundaries from the last iteration.
-    geodesic_boundaries.clear();
+    // Dropping cached boundaries of vehicles that left the simulation.
+    // Remaining entries invalidate incrementally through their validity
+    // keys inside GetGeodesicBoundary.
+    for (auto entry = geodesic_boundary_cache.begin(); entry != geodesic_boundary_cache.end();) {
+      if (vehicle_id_to_index.find(entry->first) == vehicle_id_to_index.end()) {
+        entry = geodesic_boundary_cache.erase(entry);
+      } else {
+        ++entry;
+      }
+    }
 
   }
 
@@ -203,6 +270,14 @@ namespace CollisionStageConstants {
     bool hazard = false;
     float available_distance_margin = std::numeric_limits<float>::infinity();
 
+    // Broad-phase rejection; clearly separated vehicles need no boundary
+    // or polygon computation at all.
+    if (!PathBoxesOverlap(reference_vehicle_id, other_vehicle_id)) {
+      std::lock_guard<std::mutex> map_lock(collision_lock_mutex);
+      collision_locks.erase(reference_vehicle_id);
+      return {hazard, available_distance_margin};
+    }
+
     // Ego and other vehicle heading.
     const cg::Vector3D reference_heading = reference_vehicle->GetTransform().GetForwardVector();
     // Vector from ego position to position of the other vehicle.
@@ -277,6 +352,7 @@ namespace CollisionStageConstants {
         // This enables us to smoothly approach the lead vehicle.
 
         // When possible collision found, check if an entry for collision lock present.
+        std::lock_guard<std::mutex> map_lock(collision_lock_mutex);
         if (collision_locks.find(reference_vehicle_id) != collision_locks.end()) {
           CollisionLock &lock = collision_locks.at(reference_vehicle_id);
           // Check if the same vehicle is under lock.
@@ -302,13 +378,30 @@ namespace CollisionStageConstants {
     }
 
     // If no collision hazard detected, then flush collision lock held by the vehicle.
-    if (!hazard && collision_locks.find(reference_vehicle_id) != collision_locks.end()) {
+    if (!hazard) {
+      std::lock_guard<std::mutex> map_lock(collision_lock_mutex);
       collision_locks.erase(reference_vehicle_id);
     }
 
     return {hazard, available_distance_margin};
   }
 
+  bool CollisionStage::PathBoxesOverlap(const ActorId id_a, const ActorId id_b) const {
+
+    const auto index_a = vehicle_id_to_index.find(id_a);
+    const auto index_b = vehicle_id_to_index.find(id_b);
+    // Only registered vehicles have path boxes; let all other pairings
+    // through to the full geometry checks.
+    if (index_a == vehicle_id_to_index.end() || index_b == vehicle_id_to_index.end()) {
+      return true;
+    }
+
+    const PathAABB &box_a = vehicle_path_boxes.at(index_a->second);
+    const PathAABB &box_b = vehicle_path_boxes.at(index_b->second);
+    return !(box_a.maximum_x < box_b.minimum_x || box_b.maximum_x < box_a.minimum_x ||
+             box_a.maximum_y < box_b.minimum_y || box_b.maximum_y < box_a.minimum_y);
+  }
+
   traffic_manager::Polygon CollisionStage::GetPolygon(const LocationList &boundary) {
 
     traffic_manager::Polygon boundary_polygon;
@@ -325,12 +418,6 @@ namespace CollisionStageConstants {
 
     const ActorId actor_id = actor->GetId();
 
-    if (geodesic_boundaries.find(actor_id) != geodesic_boundaries.end()) {
-      return geodesic_boundaries.at(actor_id);
-    }
-
-    const LocationList bbox = GetBoundary(actor, vehicle_location, velocity);
-
     if (vehicle_id_to_index.find(actor_id) != vehicle_id_to_index.end()) {
 
       float bbox_extension = GetBoundingBoxExtention(actor_id, velocity, actor->GetTransform().GetForwardVector());
@@ -342,8 +429,28 @@ namespace CollisionStageConstants {
 
       const auto &waypoint_buffer =  localization_frame->at(vehicle_id_to_index.at(actor_id)).buffer;
 
-      LocationList left_boundary;
-      LocationList right_boundary;
+      // The boundary only depends on the anchoring waypoint, the speed band
+      // and the boundary extension, so a cached boundary stays valid across
+      // frames while those keys hold; this mostly pays off in dense traffic
+      // where many vehicles are stationary.
+      const uint64_t anchor_waypoint_id = waypoint_buffer.front()->GetId();
+      const float speed_bucket = std::floor(velocity.Length() * 3.6f / 10.0f);
+
+      {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto entry = geodesic_boundary_cache.find(actor_id);
+        if (entry != geodesic_boundary_cache.end() &&
+            entry->second.anchor_waypoint_id == anchor_waypoint_id &&
+            entry->second.speed_bucket == speed_bucket &&
+            std::abs(entry->second.bbox_extension - bbox_extension) < 0.1f) {
+          return entry->second.boundary;
+        }
+      }
+
+      const LocationList bbox = GetBoundary(actor, vehicle_location, velocity);
+
+      std::vector<cg::Vector3D> boundary_locations;
+      std::vector<cg::Vector3D> boundary_headings;
       const auto vehicle = boost::static_pointer_cast<cc::Vehicle>(actor);
       const float width = vehicle->GetBoundingBox().extent.y;
       const float length_squared = std::pow(vehicle->GetBoundingBox().extent.x*2, 2.0f);
@@ -374,13 +481,8 @@ namespace CollisionStageConstants {
             || cg::Math::Dot(boundary_end->GetForwardVector(), current_point->GetForwardVector()) < COS_10_DEGREES
             || reached_distance) {
 
-          const cg::Vector3D heading_vector = current_point->GetForwardVector();
-          const cg::Location location = current_point->GetLocation();
-          cg::Vector3D perpendicular_vector = cg::Vector3D(-heading_vector.y, heading_vector.x, heading_vector.z);
-          // Direction determined for the left-handed system.
-          const cg::Vector3D scaled_perpendicular = perpendicular_vector * width;
-          left_boundary.push_back(location + cg::Location(scaled_perpendicular));
-          right_boundary.push_back(location + cg::Location(-1.0f * scaled_perpendicular));
+          boundary_locations.push_back(current_point->GetLocation());
+          boundary_headings.push_back(current_point->GetForwardVector());
 
           boundary_end = current_point;
         }
@@ -388,6 +490,21 @@ namespace CollisionStageConstants {
         current_point = waypoint_buffer.at(j);
       }
 
+      // Offset the selected points laterally in one batch; direction
+      // determined for the left-handed system.
+      std::vector<cg::Vector3D> left_offsets(boundary_locations.size());
+      std::vector<cg::Vector3D> right_offsets(boundary_locations.size());
+      cg::MathBatch::LateralOffsets(
+          boundary_locations.data(), boundary_headings.data(),
+          boundary_locations.size(), width,
+          left_offsets.data(), right_offsets.data());
+      LocationList left_boundary;
+      LocationList right_boundary;
+      for (uint64_t j = 0u; j < boundary_locations.size(); ++j) {
+        left_boundary.push_back(cg::Location(left_offsets.at(j)));
+        right_boundary.push_back(cg::Location(right_offsets.at(j)));
+      }
+
       // Connecting the geodesic path boundary with the vehicle bounding box.
       LocationList geodesic_boundary;
       // Reversing right boundary to construct clockwise (left-hand system)
@@ -400,12 +517,15 @@ namespace CollisionStageConstants {
       geodesic_boundary.insert(geodesic_boundary.end(), bbox.begin(), bbox.end());
       geodesic_boundary.insert(geodesic_boundary.end(), left_boundary.begin(), left_boundary.end());
 
-      geodesic_boundaries.insert({actor->GetId(), geodesic_boundary});
+      std::lock_guard<std::mutex> lock(cache_mutex);
+      geodesic_boundary_cache[actor_id] = {anchor_waypoint_id, speed_bucket,
+                                           bbox_extension, geodesic_boundary};
       return geodesic_boundary;
     } else {
 
-      geodesic_boundaries.insert({actor->GetId(), bbox});
-      return bbox;
+      // Unregistered actors and walkers; the boundary is just the bounding
+      // box anchored at the current location, cheap enough to rebuild.
+      return GetBoundary(actor, vehicle_location, velocity);
     }
 
   }
@@ -422,6 +542,7 @@ namespace CollisionStageConstants {
     float slope = (BOUNDARY_EXTENSION_MAXIMUM - BOUNDARY_EXTENSION_MINIMUM) / ARBITRARY_MAX_SPEED;
     bbox_extension = slope * velocity + BOUNDARY_EXTENSION_MINIMUM;
     // If a valid collision lock present, change boundary length to maintain lock.
+    std::lock_guard<std::mutex> map_lock(collision_lock_mutex);
     if (collision_locks.find(actor_id) != collision_locks.end())
     {
       CollisionLock &lock = collision_locks.at(actor_id);
@@ -535,13 +656,16 @@ GeometryComparisonCache CollisionStage:: GetGeometryBetweenActors(const Actor &r
                               : std::to_string(other_vehicle->GetId()) +"|"+ std::to_string(reference_vehicle->GetId());
    GeometryComparisonCache mCache{-1,-1,-1,-1};
 
-  if (vehicle_cache.find(actor_id_key) != vehicle_cache.end()) {
-    mCache = vehicle_cache.at(actor_id_key);
-    double mref_veh_other = mCache.reference_vehicle_to_other_geodesic;
-    mCache.reference_vehicle_to_other_geodesic = mCache.other_vehicle_to_reference_geodesic;
-    mCache.other_vehicle_to_reference_geodesic = mref_veh_other;
-    return mCache;
-   }
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (vehicle_cache.find(actor_id_key) != vehicle_cache.end()) {
+      mCache = vehicle_cache.at(actor_id_key);
+      double mref_veh_other = mCache.reference_vehicle_to_other_geodesic;
+      mCache.reference_vehicle_to_other_geodesic = mCache.other_vehicle_to_reference_geodesic;
+      mCache.other_vehicle_to_reference_geodesic = mref_veh_other;
+      return mCache;
+    }
+  }
 
   const Polygon reference_geodesic_polygon = GetPolygon(GetGeodesicBoundary(reference_vehicle, reference_location, reference_velocity));
   const Polygon other_geodesic_polygon = GetPolygon(GetGeodesicBoundary(other_vehicle, other_location, other_velocity));
@@ -558,7 +682,10 @@ GeometryComparisonCache CollisionStage:: GetGeometryBetweenActors(const Actor &r
                                         inter_geodesic_distance,
                                         inter_bbox_distance};
 
-  vehicle_cache.insert({actor_id_key, mRetCache});
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    vehicle_cache.insert({actor_id_key, mRetCache});
+  }
 
   return mRetCache;
   }
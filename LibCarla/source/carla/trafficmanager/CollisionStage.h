@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <cmath>
 #include <deque>
+#include <mutex>
 #include <stdlib.h>
 #include <string>
 #include <tuple>
@@ -26,6 +27,7 @@
 #include "carla/client/World.h"
 #include "carla/geom/Location.h"
 #include "carla/geom/Math.h"
+#include "carla/geom/MathBatch.h"
 #include "carla/geom/Vector3D.h"
 #include "carla/Logging.h"
 #include "carla/rpc/ActorId.h"
@@ -69,6 +71,26 @@ namespace traffic_manager {
     double initial_lock_distance;
   };
 
+  /// Structure to hold a conservative axis-aligned box around a vehicle's
+  /// extended path geometry, used for broad-phase pair rejection.
+  struct PathAABB {
+
+    float minimum_x;
+    float minimum_y;
+    float maximum_x;
+    float maximum_y;
+  };
+
+  /// Structure to hold a cached geodesic boundary along with the keys
+  /// it remains valid for.
+  struct GeodesicBoundaryEntry {
+
+    uint64_t anchor_waypoint_id;
+    float speed_bucket;
+    float bbox_extension;
+    LocationList boundary;
+  };
+
 /// This class is the thread executable for the collision detection stage
 /// and is responsible for checking possible collisions with other
 /// cars along the vehicle's trajectory.
@@ -99,10 +121,25 @@ private:
   chr::time_point<chr::system_clock, chr::nanoseconds> last_world_actors_pass_instance;
   /// Number of vehicles registered with the traffic manager.
   uint64_t number_of_vehicles;
-  /// Structure to hold the geodesic boundaries during one iteration.
-  std::unordered_map<ActorId, LocationList> geodesic_boundaries;
+  /// Switch indicating deterministic mode.
+  bool deterministic_mode {false};
+  /// Seed for the per-actor random streams in deterministic mode.
+  uint64_t random_seed {0u};
+  /// Frame counter advancing the per-actor random streams.
+  uint64_t dice_frame_counter {0u};
+  /// Persistent cache of geodesic boundaries; entries invalidate
+  /// incrementally when their anchor waypoint, speed bucket or boundary
+  /// extension changes.
+  std::unordered_map<ActorId, GeodesicBoundaryEntry> geodesic_boundary_cache;
+  /// Conservative path boxes for all registered vehicles, rebuilt at the
+  /// start of every cycle and used for broad-phase pair rejection.
+  std::vector<PathAABB> vehicle_path_boxes;
   /// Structure to keep track of collision locking.
   std::unordered_map<ActorId, CollisionLock> collision_locks;
+  /// Mutex guarding the shared geometry caches during parallel processing.
+  std::mutex cache_mutex;
+  /// Mutex guarding the collision lock map during parallel processing.
+  std::mutex collision_lock_mutex;
   /// Snippet profiler for measuring execution time.
   SnippetProfiler snippet_profiler;
 
@@ -126,6 +163,10 @@ private:
                                               const cg::Vector3D reference_velocity,
                                               const cg::Vector3D other_velocity);
 
+    /// Broad-phase check; returns false only when both actors are
+    /// registered vehicles whose conservative path boxes do not overlap.
+    bool PathBoxesOverlap(const ActorId id_a, const ActorId id_b) const;
+
     /// Method to calculate the speed dependent bounding box extention for a vehicle.
     float GetBoundingBoxExtention(const ActorId actor_id,
                                   const cg::Vector3D velocity_vector,
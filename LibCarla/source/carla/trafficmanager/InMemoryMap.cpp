@@ -16,6 +16,10 @@ namespace MapConstants {
   static const float PED_GRID_SIZE = 10.0f;
   static const float MAX_GEODESIC_GRID_LENGTH = 20.0f;
   static const float TOPOLOGY_DISTANCE = 0.1f;
+  static const float TARGET_WAYPOINTS_PER_CELL = 64.0f;
+  static const float MINIMUM_CELL_SIZE = 2.0f;
+  static const float MAXIMUM_CELL_SIZE = 16.0f;
+  static const float VICINITY_SEARCH_RADIUS = 6.0f;
 } // namespace MapConstants
 
   namespace cg = carla::geom;
@@ -115,10 +119,16 @@ namespace MapConstants {
     }
 
     // 2. Consuming the raw dense topology from cc::Map into SimpleWaypoints.
+    // All nodes live in one contiguous arena; the exact reserve keeps their
+    // addresses stable, and handles are non-owning aliases into the arena,
+    // so no per-node allocations or control blocks are made.
     SegmentMap segment_map;
     auto raw_dense_topology = _world_map->GenerateWaypoints(TOPOLOGY_DISTANCE);
+    waypoint_arena.reserve(raw_dense_topology.size());
     for (auto &waypoint_ptr: raw_dense_topology) {
-      segment_map[GetSegmentId(waypoint_ptr)].emplace_back(std::make_shared<SimpleWaypoint>(waypoint_ptr));
+      waypoint_arena.emplace_back(waypoint_ptr);
+      segment_map[GetSegmentId(waypoint_ptr)].emplace_back(
+          SimpleWaypointPtr(SimpleWaypointPtr(), &waypoint_arena.back()));
     }
 
     // 3. Processing waypoints.
@@ -164,6 +174,11 @@ namespace MapConstants {
 
       // Adding simple waypoints to processed dense topology.
       for (auto swp: segment_waypoints) {
+        // Resolving the static road facts once; junction membership and
+        // junction ids never change after this, so per-frame stage queries
+        // become plain field reads.
+        swp->CacheStaticAttributes();
+
         // Checking whether the waypoint is a real junction.
         auto road_id = swp->GetWaypoint()->GetRoadId();
         if (swp->GetWaypoint()->IsJunction() && !is_real_junction.count(road_id)) {
@@ -180,12 +195,6 @@ namespace MapConstants {
     for (auto &simple_waypoint: dense_topology) {
       if (simple_waypoint != nullptr) {
         const cg::Location loc = simple_waypoint->GetLocation();
-        const std::string grid_key = MakeGridKey(MakeGridId(loc.x, loc.y, true));
-        if (waypoint_grid.find(grid_key) == waypoint_grid.end()) {
-          waypoint_grid.insert({grid_key, {simple_waypoint}});
-        } else {
-          waypoint_grid.at(grid_key).insert(simple_waypoint);
-        }
         const std::string ped_grid_key = MakeGridKey(MakeGridId(loc.x, loc.y, false));
         if (ped_waypoint_grid.find(ped_grid_key) == ped_waypoint_grid.end()) {
           ped_waypoint_grid.insert({ped_grid_key, {simple_waypoint}});
@@ -195,6 +204,9 @@ namespace MapConstants {
       }
     }
 
+    // Building the spatial hash for nearest-waypoint queries.
+    BuildSpatialHash();
+
     // Placing inter-segment connections.
     for (auto &segment : segment_map) {
       SegmentId segment_id = segment.first;
@@ -231,6 +243,18 @@ namespace MapConstants {
       }
     }
 
+    // Compacting per-waypoint adjacency lists into one pooled allocation
+    // with span-based access; the layout is final at this point. The pool
+    // is reserved to its exact size first so the spans stay valid.
+    uint64_t edge_count = 0u;
+    for (auto &swp: dense_topology) {
+      edge_count += swp->GetNextWaypoint().size() + swp->GetPreviousWaypoint().size();
+    }
+    adjacency_pool.reserve(edge_count);
+    for (auto &swp: dense_topology) {
+      swp->CompactAdjacency(adjacency_pool);
+    }
+
     MakeGeodesiGridCenters();
   }
 
@@ -247,36 +271,112 @@ namespace MapConstants {
     return std::to_string(grid_key.first) + "#" + std::to_string(grid_key.second);
   }
 
-  SimpleWaypointPtr InMemoryMap::GetWaypointInVicinity(cg::Location location) {
+  void InMemoryMap::BuildSpatialHash() {
 
-    const std::pair<int, int> grid_ids = MakeGridId(location.x, location.y, true);
-    SimpleWaypointPtr closest_waypoint = nullptr;
-    float closest_distance = INFINITE_DISTANCE;
+    if (dense_topology.empty()) {
+      return;
+    }
 
-    // Search all surrounding grids for closest waypoint.
-    for (int i = -1; i <= 1; ++i) {
-      for (int j = -1; j <= 1; ++j) {
+    // Measuring the extent of the map to size cells from waypoint density.
+    float minimum_x = INFINITE_DISTANCE, minimum_y = INFINITE_DISTANCE;
+    float maximum_x = -INFINITE_DISTANCE, maximum_y = -INFINITE_DISTANCE;
+    for (auto &simple_waypoint: dense_topology) {
+      const cg::Location loc = simple_waypoint->GetLocation();
+      minimum_x = std::min(minimum_x, loc.x);
+      minimum_y = std::min(minimum_y, loc.y);
+      maximum_x = std::max(maximum_x, loc.x);
+      maximum_y = std::max(maximum_y, loc.y);
+    }
 
-        const std::string grid_key = MakeGridKey({grid_ids.first + i, grid_ids.second + j});
-        if (waypoint_grid.find(grid_key) != waypoint_grid.end()) {
+    // Choosing a cell size targeting a bounded number of waypoints per
+    // occupied cell, clamped to keep ring scans cheap on sparse maps.
+    const float map_area = std::max((maximum_x - minimum_x) * (maximum_y - minimum_y), 1.0f);
+    const float density = static_cast<float>(dense_topology.size()) / map_area;
+    spatial_hash_cell_size = std::sqrt(TARGET_WAYPOINTS_PER_CELL / std::max(density, 0.001f));
+    spatial_hash_cell_size = std::min(std::max(spatial_hash_cell_size, MINIMUM_CELL_SIZE), MAXIMUM_CELL_SIZE);
 
-          const auto &waypoint_set = waypoint_grid.at(grid_key);
-          if (closest_waypoint == nullptr) {
-            closest_waypoint = *waypoint_set.begin();
-          }
+    minimum_cell_x = static_cast<int>(std::floor(minimum_x / spatial_hash_cell_size));
+    maximum_cell_x = static_cast<int>(std::floor(maximum_x / spatial_hash_cell_size));
+    minimum_cell_y = static_cast<int>(std::floor(minimum_y / spatial_hash_cell_size));
+    maximum_cell_y = static_cast<int>(std::floor(maximum_y / spatial_hash_cell_size));
 
-          for (auto &simple_waypoint: waypoint_set) {
+    for (auto &simple_waypoint: dense_topology) {
+      const cg::Location loc = simple_waypoint->GetLocation();
+      const int cell_x = static_cast<int>(std::floor(loc.x / spatial_hash_cell_size));
+      const int cell_y = static_cast<int>(std::floor(loc.y / spatial_hash_cell_size));
+      spatial_hash_grid[MakeSpatialHashKey(cell_x, cell_y)].push_back(simple_waypoint);
+    }
+  }
 
-            if (simple_waypoint->DistanceSquared(location) < std::pow(closest_distance, 2)) {
-              closest_waypoint = simple_waypoint;
-              closest_distance = simple_waypoint->DistanceSquared(location);
-            }
+  int64_t InMemoryMap::MakeSpatialHashKey(int cell_x, int cell_y) {
+    return static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(cell_x)) << 32)
+                                | static_cast<uint64_t>(static_cast<uint32_t>(cell_y)));
+  }
+
+  void InMemoryMap::ScanSpatialHashRing(int centre_x, int centre_y, int ring, const cg::Location &location,
+                                        SimpleWaypointPtr &closest_waypoint,
+                                        float &closest_distance_squared) const {
+
+    auto scan_cell = [&](int cell_x, int cell_y) {
+      auto cell = spatial_hash_grid.find(MakeSpatialHashKey(cell_x, cell_y));
+      if (cell != spatial_hash_grid.end()) {
+        for (auto &simple_waypoint: cell->second) {
+          const float distance_squared = simple_waypoint->DistanceSquared(location);
+          if (distance_squared < closest_distance_squared) {
+            closest_distance_squared = distance_squared;
+            closest_waypoint = simple_waypoint;
           }
         }
       }
+    };
+
+    if (ring == 0) {
+      scan_cell(centre_x, centre_y);
+      return;
     }
 
-    // Return the closest waypoint in the surrounding grids
+    // Scanning only the cells on the perimeter of the ring.
+    for (int i = -ring; i <= ring; ++i) {
+      scan_cell(centre_x + i, centre_y - ring);
+      scan_cell(centre_x + i, centre_y + ring);
+    }
+    for (int j = -ring + 1; j <= ring - 1; ++j) {
+      scan_cell(centre_x - ring, centre_y + j);
+      scan_cell(centre_x + ring, centre_y + j);
+    }
+  }
+
+  SimpleWaypointPtr InMemoryMap::GetNearestWaypointInRadius(const cg::Location &location, float radius) const {
+
+    if (spatial_hash_grid.empty()) {
+      return nullptr;
+    }
+
+    const int centre_x = static_cast<int>(std::floor(location.x / spatial_hash_cell_size));
+    const int centre_y = static_cast<int>(std::floor(location.y / spatial_hash_cell_size));
+    const int maximum_ring = static_cast<int>(std::ceil(radius / spatial_hash_cell_size));
+
+    SimpleWaypointPtr closest_waypoint = nullptr;
+    float closest_distance_squared = radius * radius;
+
+    for (int ring = 0; ring <= maximum_ring; ++ring) {
+      // Cells on ring r are at least (r-1) cell lengths away; once the
+      // closest candidate beats that bound, farther rings cannot win.
+      if (closest_waypoint != nullptr &&
+          std::pow(static_cast<float>(ring - 1) * spatial_hash_cell_size, 2.0f) > closest_distance_squared) {
+        break;
+      }
+      ScanSpatialHashRing(centre_x, centre_y, ring, location, closest_waypoint, closest_distance_squared);
+    }
+
+    return closest_waypoint;
+  }
+
+  SimpleWaypointPtr InMemoryMap::GetWaypointInVicinity(cg::Location location) {
+
+    SimpleWaypointPtr closest_waypoint = GetNearestWaypointInRadius(location, VICINITY_SEARCH_RADIUS);
+
+    // Return the closest waypoint in the vicinity
     // only if it is in the same horizontal plane as the requested location.
     if (closest_waypoint != nullptr && std::abs(closest_waypoint->GetLocation().z - location.z) > 1.0) {
       closest_waypoint = nullptr;
@@ -319,15 +419,29 @@ namespace MapConstants {
 
   SimpleWaypointPtr InMemoryMap::GetWaypoint(const cg::Location &location) const {
 
-    SimpleWaypointPtr closest_waypoint;
-    float min_distance = INFINITE_DISTANCE;
-    for (auto &simple_waypoint : dense_topology) {
-      const float current_distance = simple_waypoint->DistanceSquared(location);
-      if (current_distance < min_distance) {
-        min_distance = current_distance;
-        closest_waypoint = simple_waypoint;
+    if (spatial_hash_grid.empty()) {
+      return nullptr;
+    }
+
+    const int centre_x = static_cast<int>(std::floor(location.x / spatial_hash_cell_size));
+    const int centre_y = static_cast<int>(std::floor(location.y / spatial_hash_cell_size));
+
+    // Expanding the ring search until the whole grid is covered; some
+    // waypoint always exists, so the search terminates early in practice.
+    const int maximum_ring = std::max({std::abs(centre_x - minimum_cell_x), std::abs(maximum_cell_x - centre_x),
+                                       std::abs(centre_y - minimum_cell_y), std::abs(maximum_cell_y - centre_y)});
+
+    SimpleWaypointPtr closest_waypoint = nullptr;
+    float closest_distance_squared = INFINITE_DISTANCE;
+
+    for (int ring = 0; ring <= maximum_ring; ++ring) {
+      if (closest_waypoint != nullptr &&
+          std::pow(static_cast<float>(ring - 1) * spatial_hash_cell_size, 2.0f) > closest_distance_squared) {
+        break;
       }
+      ScanSpatialHashRing(centre_x, centre_y, ring, location, closest_waypoint, closest_distance_squared);
     }
+
     return closest_waypoint;
   }
 
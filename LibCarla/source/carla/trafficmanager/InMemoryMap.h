@@ -52,13 +52,28 @@ namespace crd = carla::road;
 
     /// Object to hold the world map received by the constructor.
     WorldMap _world_map;
+    /// Contiguous arena holding every SimpleWaypoint of the dense topology.
+    /// Handles across the traffic manager are thin non-owning aliases into
+    /// this arena, so the map must outlive its consumers; the stages are
+    /// destroyed before the map in TrafficManagerLocal.
+    std::vector<SimpleWaypoint> waypoint_arena;
+    /// Pooled adjacency storage referenced by per-waypoint spans.
+    std::vector<SimpleWaypointPtr> adjacency_pool;
     /// Structure to hold all custom waypoint objects after interpolation of
     /// sparse topology.
     NodeList dense_topology;
-    /// Grid localization map for all waypoints in the system.
-    WaypointGrid waypoint_grid;
     /// Larger localization map for all waypoints to be used for localizing pedestrians.
     WaypointGrid ped_waypoint_grid;
+    /// Uniform spatial hash over all waypoints, used for nearest-waypoint
+    /// queries; cell size is derived from waypoint density during setup.
+    std::unordered_map<int64_t, std::vector<SimpleWaypointPtr>> spatial_hash_grid;
+    /// Cell edge length of the spatial hash in meters.
+    float spatial_hash_cell_size = 0.0f;
+    /// Cell index extents of the spatial hash.
+    int minimum_cell_x = 0;
+    int maximum_cell_x = 0;
+    int minimum_cell_y = 0;
+    int maximum_cell_y = 0;
     /// Geodesic grid topology.
     std::unordered_map<GeoGridId, cg::Location> geodesic_grid_center;
 
@@ -84,6 +99,10 @@ namespace crd = carla::road;
     SimpleWaypointPtr GetWaypointInVicinity(cg::Location location);
     SimpleWaypointPtr GetPedWaypoint(cg::Location location);
 
+    /// This method returns the closest waypoint within the given radius of
+    /// the location, or nullptr if no waypoint is that close.
+    SimpleWaypointPtr GetNearestWaypointInRadius(const cg::Location &location, float radius) const;
+
     /// This method returns the full list of discrete samples of the map in the
     /// local cache.
     NodeList GetDenseTopology() const;
@@ -99,6 +118,18 @@ namespace crd = carla::road;
     /// Method to generate map key for waypoint_grid.
     std::string MakeGridKey(std::pair<int, int> gird_id);
 
+    /// Method to build the spatial hash over the dense topology, sizing
+    /// cells from waypoint density.
+    void BuildSpatialHash();
+
+    /// Method to generate the packed cell key for the spatial hash.
+    static int64_t MakeSpatialHashKey(int cell_x, int cell_y);
+
+    /// Method to scan the cells at a given ring distance around a centre
+    /// cell and update the closest waypoint found so far.
+    void ScanSpatialHashRing(int centre_x, int centre_y, int ring, const cg::Location &location,
+                             SimpleWaypointPtr &closest_waypoint, float &closest_distance_squared) const;
+
     /// This method is used to find and place lane change links.
     void FindAndLinkLaneChange(SimpleWaypointPtr reference_waypoint);
 
@@ -7,6 +7,8 @@
 #include "carla/trafficmanager/LocalizationStage.h"
 #include "carla/client/DebugHelper.h"
 
+#include "carla/trafficmanager/StageParallelism.h"
+
 namespace carla {
 namespace traffic_manager {
 
@@ -31,6 +33,7 @@ namespace LocalizationConstants {
   static const float MAX_COLLISION_RADIUS = 100.0f;
   static const float POSITION_WINDOW_SIZE = 2.1f;
   static const float HYBRID_MODE_DT = 0.05f;
+  static const uint64_t LOD_UPDATE_INTERVAL = 4u;
 } // namespace LocalizationConstants
 
   using namespace LocalizationConstants;
@@ -90,28 +93,92 @@ namespace LocalizationConstants {
     // Selecting current timestamp from the world snapshot.
     current_timestamp = episode_proxy_ls.Lock()->GetWorldSnapshot().GetTimestamp();
 
-    // Looping over registered actors.
-    for (uint64_t i = 0u; i < actor_list.size(); ++i) {
+    const uint64_t number_of_actors = actor_list.size();
 
-      const Actor vehicle = actor_list.at(i);
-      const ActorId actor_id = vehicle->GetId();
-      const cg::Location vehicle_location = vehicle->GetLocation();
-      const cg::Vector3D vehicle_velocity_vector = GetVelocity(actor_id);
-      const float vehicle_velocity = vehicle_velocity_vector.Length();
+    // Initialization pass; inserting per-actor map entries serially
+    // so the parallel passes below never modify map topology.
+    for (uint64_t i = 0u; i < number_of_actors; ++i) {
+
+      const ActorId actor_id = actor_list.at(i)->GetId();
 
       // Initializing idle times.
       if (idle_time.find(actor_id) == idle_time.end() && current_timestamp.elapsed_seconds != 0) {
         idle_time[actor_id] = current_timestamp.elapsed_seconds;
       }
+      if (buffer_list->find(actor_id) == buffer_list->end()) {
+        buffer_list->insert({actor_id, Buffer()});
+      }
+      if (approached.find(actor_id) == approached.end()) {
+        approached.insert({actor_id, false});
+      }
+      if (final_safe_points.find(actor_id) == final_safe_points.end()) {
+        final_safe_points.insert({actor_id, nullptr});
+      }
+    }
+
+    // Distance LOD scheduling; vehicles far from every hero actor get a
+    // full update only once every LOD_UPDATE_INTERVAL frames, staggered by
+    // actor id. A vehicle only holds when its output slots still carry its
+    // own previous data, so newly registered vehicles and freshly allocated
+    // frames always take the full update path.
+    lod_hold_flags.assign(number_of_actors, 0u);
+    if (distance_lod_mode && !hero_actors.empty()) {
+
+      std::vector<cg::Location> hero_locations;
+      for (auto &hero_actor_info: hero_actors) {
+        hero_locations.push_back(hero_actor_info.second->GetLocation());
+      }
+      const float lod_radius_square = std::pow(distance_lod_radius, 2.0f);
+
+      for (uint64_t i = 0u; i < number_of_actors; ++i) {
+
+        const Actor &vehicle = actor_list.at(i);
+        const ActorId actor_id = vehicle->GetId();
+        if ((actor_id + lod_frame_counter) % LOD_UPDATE_INTERVAL == 0u) {
+          continue;
+        }
+
+        const cg::Location vehicle_location = vehicle->GetLocation();
+        bool near_hero_actor = false;
+        for (const cg::Location &hero_location: hero_locations) {
+          if (cg::Math::DistanceSquared(vehicle_location, hero_location) < lod_radius_square) {
+            near_hero_actor = true;
+            break;
+          }
+        }
+
+        const LocalizationToCollisionData &collision_slot = current_collision_frame->at(i);
+        const bool previous_data_valid = collision_slot.actor != nullptr &&
+                                         collision_slot.actor->GetId() == actor_id &&
+                                         !collision_slot.buffer.empty();
+        if (!near_hero_actor && previous_data_valid) {
+          lod_hold_flags.at(i) = 1u;
+        }
+      }
+    }
+    ++lod_frame_counter;
+    ++dice_frame_counter;
+
+    // First pass, maintenance of waypoint buffers; every vehicle only
+    // touches its own buffer here and the traffic tracker has its own
+    // mutex, so the pass is partitioned over the stage workers.
+    ParallelForEachIndex(number_of_actors, [&](uint64_t i) {
+
+      // Reduced-rate hold; the buffer keeps its previous contents and is
+      // caught up on the next full update.
+      if (lod_hold_flags.at(i) == 1u) {
+        return;
+      }
+
+      const Actor vehicle = actor_list.at(i);
+      const ActorId actor_id = vehicle->GetId();
+      const cg::Location vehicle_location = vehicle->GetLocation();
+      const float vehicle_velocity = GetVelocity(actor_id).Length();
 
       // Speed dependent waypoint horizon length.
       const float horizon_square = std::min(std::pow(vehicle_velocity * HORIZON_RATE + MINIMUM_HORIZON_LENGTH, 2.0f),
                                             std::pow(MAXIMUM_HORIZON_LENGTH, 2.0f));
 
-      if (buffer_list->find(actor_id) == buffer_list->end()) {
-        buffer_list->insert({actor_id, Buffer()});
-      }
-
       Buffer &waypoint_buffer = buffer_list->at(actor_id);
 
       // Clear buffer if vehicle is too far from the first waypoint in the buffer.
@@ -150,6 +217,21 @@ namespace LocalizationConstants {
         }
         PushWaypoint(waypoint_buffer, actor_id, closest_waypoint);
       }
+    });
+
+    // Second pass, lane change assignment; kept serial since lane change
+    // evaluation inspects the waypoint buffers of neighbouring vehicles.
+    for (uint64_t i = 0u; i < number_of_actors; ++i) {
+
+      if (lod_hold_flags.at(i) == 1u) {
+        continue;
+      }
+
+      const Actor vehicle = actor_list.at(i);
+      const ActorId actor_id = vehicle->GetId();
+      const cg::Location vehicle_location = vehicle->GetLocation();
+      const float vehicle_velocity = GetVelocity(actor_id).Length();
+      Buffer &waypoint_buffer = buffer_list->at(actor_id);
 
       // Assign a lane change.
 
@@ -159,7 +241,10 @@ namespace LocalizationConstants {
 
       if (!force_lane_change) {
         float perc_keep_right = parameters.GetKeepRightPercentage(vehicle);
-        if (perc_keep_right >= 0.0f && perc_keep_right >= (rand() % 101)) {
+        const int dice_roll = deterministic_mode
+            ? RollDeterministicDice(random_seed, actor_id, dice_frame_counter, DICE_STREAM_KEEP_RIGHT)
+            : RollPercentageDice();
+        if (perc_keep_right >= 0.0f && perc_keep_right >= dice_roll) {
             force_lane_change = true;
             lane_change_direction = true;
         }
@@ -189,15 +274,50 @@ namespace LocalizationConstants {
           PushWaypoint(waypoint_buffer, actor_id, change_over_point);
         }
       }
+    }
+
+    // Third pass, extending buffers and generating the stage output;
+    // vehicles are independent again, so the pass is partitioned over
+    // the stage workers.
+    ParallelForEachIndex(number_of_actors, [&](uint64_t i) {
+
+      const Actor vehicle = actor_list.at(i);
+      const ActorId actor_id = vehicle->GetId();
+
+      // Reduced-rate hold; the output slots keep the data of the last
+      // full update and are only marked as held. Idle time is still
+      // updated so far vehicles are not mistaken for stuck ones.
+      if (lod_hold_flags.at(i) == 1u) {
+        current_planner_frame->at(i).lod_hold = true;
+        current_collision_frame->at(i).lod_hold = true;
+        current_traffic_light_frame->at(i).lod_hold = true;
+        UpdateIdleTime(vehicle);
+        return;
+      }
+
+      const cg::Location vehicle_location = vehicle->GetLocation();
+      const cg::Vector3D vehicle_velocity_vector = GetVelocity(actor_id);
+      const float vehicle_velocity = vehicle_velocity_vector.Length();
+
+      // Speed dependent waypoint horizon length.
+      const float horizon_square = std::min(std::pow(vehicle_velocity * HORIZON_RATE + MINIMUM_HORIZON_LENGTH, 2.0f),
+                                            std::pow(MAXIMUM_HORIZON_LENGTH, 2.0f));
+
+      Buffer &waypoint_buffer = buffer_list->at(actor_id);
 
       // Populating the buffer.
+      uint64_t path_draw_index = 0u;
       while (waypoint_buffer.back()->DistanceSquared(waypoint_buffer.front()) <= horizon_square) {
 
         std::vector<SimpleWaypointPtr> next_waypoints = waypoint_buffer.back()->GetNextWaypoint();
         uint64_t selection_index = 0u;
         // Pseudo-randomized path selection if found more than one choice.
         if (next_waypoints.size() > 1) {
-          selection_index = static_cast<uint64_t>(rand()) % next_waypoints.size();
+          const int dice_roll = deterministic_mode
+              ? RollDeterministicDice(random_seed, actor_id, dice_frame_counter,
+                                      DICE_STREAM_PATH_EXTENSION, path_draw_index++)
+              : RollPercentageDice();
+          selection_index = static_cast<uint64_t>(dice_roll) % next_waypoints.size();
         }
         SimpleWaypointPtr next_wp = next_waypoints.at(selection_index);
         if (next_wp == nullptr) {
@@ -363,6 +483,7 @@ namespace LocalizationConstants {
       planner_message.velocity = vehicle_velocity_vector;
       planner_message.position_window = std::move(position_window);
       planner_message.physics_enabled = IsPhysicsEnabled(actor_id);
+      planner_message.lod_hold = false;
 
       LocalizationToCollisionData &collision_message = current_collision_frame->at(i);
       collision_message.actor = vehicle;
@@ -372,15 +493,17 @@ namespace LocalizationConstants {
       collision_message.junction_look_ahead_waypoint = waypoint_buffer.at(look_ahead_index);
       collision_message.safe_point_after_junction = final_safe_points[actor_id];
       collision_message.velocity = vehicle_velocity_vector;
+      collision_message.lod_hold = false;
 
       LocalizationToTrafficLightData &traffic_light_message = current_traffic_light_frame->at(i);
       traffic_light_message.actor = vehicle;
       traffic_light_message.closest_waypoint = updated_front_waypoint;
       traffic_light_message.junction_look_ahead_waypoint = waypoint_buffer.at(look_ahead_index);
+      traffic_light_message.lod_hold = false;
 
       // Updating idle time when necessary.
       UpdateIdleTime(vehicle);
-    }
+    });
 
     if (IsVehicleStuck(maximum_idle_time.first)) {
       TryDestroyVehicle(maximum_idle_time.first);
@@ -416,6 +539,10 @@ namespace LocalizationConstants {
 
     hybrid_physics_mode = parameters.GetHybridPhysicsMode();
     hybrid_physics_radius = parameters.GetHybridPhysicsRadius();
+    distance_lod_mode = parameters.GetDistanceLODMode();
+    distance_lod_radius = parameters.GetDistanceLODRadius();
+    deterministic_mode = parameters.GetDeterministicMode();
+    random_seed = parameters.GetRandomSeed();
 
     bool is_deleted_actors_present = false;
     std::set<uint32_t> world_actor_id;
@@ -443,8 +570,9 @@ namespace LocalizationConstants {
     for (const auto &actor : vehicles) {
       world_actor_id.insert(actor.GetId());
 
-      // Identify hero vehicles if system is in hybrid physics mode.
-      if (hybrid_physics_mode) {
+      // Identify hero vehicles if system is in hybrid physics mode
+      // or distance LOD mode.
+      if (hybrid_physics_mode || distance_lod_mode) {
         Actor actor_ptr = actor.Get(episode_proxy_ls);
         ActorId hero_actor_id = actor_ptr->GetId();
         if (hero_actors.find(hero_actor_id) == hero_actors.end()) {
@@ -459,7 +587,7 @@ namespace LocalizationConstants {
 
     // Invalidate hero actor pointer if it is not alive anymore.
     ActorIdSet hero_actors_to_delete;
-    if (hybrid_physics_mode && hero_actors.size() != 0u) {
+    if ((hybrid_physics_mode || distance_lod_mode) && hero_actors.size() != 0u) {
       for (auto &hero_actor_info: hero_actors) {
         if(world_actor_id.find(hero_actor_info.first) == world_actor_id.end()) {
           hero_actors_to_delete.insert(hero_actor_info.first);
@@ -823,12 +951,17 @@ namespace LocalizationConstants {
 
     // If it hasn't been found, extend the buffer
     if(safe_point == nullptr){
+      uint64_t exit_draw_index = 0u;
       while (waypoint_buffer.back()->CheckJunction()) {
 
           std::vector<SimpleWaypointPtr> next_waypoints = waypoint_buffer.back()->GetNextWaypoint();
           uint64_t selection_index = 0u;
           if (next_waypoints.size() > 1) {
-            selection_index = static_cast<uint64_t>(rand()) % next_waypoints.size();
+            const int dice_roll = deterministic_mode
+                ? RollDeterministicDice(random_seed, actor_id, dice_frame_counter,
+                                        DICE_STREAM_JUNCTION_EXIT_SEARCH, exit_draw_index++)
+                : RollPercentageDice();
+            selection_index = static_cast<uint64_t>(dice_roll) % next_waypoints.size();
           }
 
           PushWaypoint(waypoint_buffer, actor_id, next_waypoints.at(selection_index));
@@ -854,6 +987,7 @@ namespace LocalizationConstants {
 
     // If it hasn't been found, extend the buffer
     if(final_point == nullptr){
+      uint64_t safe_draw_index = 0u;
       while (safe_point->Distance(waypoint_buffer.back()->GetLocation()) < safe_distance) {
 
         // Record the last point as a safe one and save it
@@ -861,7 +995,11 @@ namespace LocalizationConstants {
         uint64_t selection_index = 0u;
         // Pseudo-randomized path selection if found more than one choice.
         if (next_waypoints.size() > 1) {
-          selection_index = static_cast<uint64_t>(rand()) % next_waypoints.size();
+          const int dice_roll = deterministic_mode
+              ? RollDeterministicDice(random_seed, actor_id, dice_frame_counter,
+                                      DICE_STREAM_JUNCTION_SAFE_DISTANCE, safe_draw_index++)
+              : RollPercentageDice();
+          selection_index = static_cast<uint64_t>(dice_roll) % next_waypoints.size();
         }
 
         PushWaypoint(waypoint_buffer, actor_id, next_waypoints.at(selection_index));
@@ -884,6 +1022,7 @@ namespace LocalizationConstants {
     }
 
     // Checking maximum idle time.
+    std::lock_guard<std::mutex> lock(idle_time_mutex);
     if (maximum_idle_time.first == nullptr || maximum_idle_time.second > idle_time[actor->GetId()]) {
       maximum_idle_time = std::make_pair(actor, idle_time[actor->GetId()]);
     }
@@ -905,8 +1044,9 @@ namespace LocalizationConstants {
 
   void LocalizationStage::CleanActor(const ActorId actor_id) {
     track_traffic.DeleteActor(actor_id);
-    for (const auto& waypoint : buffer_list->at(actor_id)) {
-      track_traffic.RemovePassingVehicle(waypoint->GetId(), actor_id);
+    const Buffer &waypoint_buffer = buffer_list->at(actor_id);
+    for (uint64_t i = 0u; i < waypoint_buffer.size(); ++i) {
+      track_traffic.RemovePassingVehicle(waypoint_buffer.at(i)->GetId(), actor_id);
     }
 
     idle_time.erase(actor_id);
@@ -119,6 +119,9 @@ namespace traffic_manager {
     std::unordered_map<ActorId, double> idle_time;
     /// Structure to hold the actor with the maximum idle time at each iteration.
     std::pair<Actor, double> maximum_idle_time;
+    /// Mutex guarding the maximum idle time record, since idle times are
+    /// updated from parallel per-vehicle processing.
+    std::mutex idle_time_mutex;
     /// Variable to hold current timestamp from the world snapshot.
     cc::Timestamp current_timestamp;
     /// Simulated seconds since the beginning of the current episode when the last actor was destroyed.
@@ -138,6 +141,20 @@ namespace traffic_manager {
     bool hybrid_physics_mode {false};
     /// Switch indicating hybrid physics mode.
     float hybrid_physics_radius {70.0f};
+    /// Switch indicating distance LOD mode.
+    bool distance_lod_mode {false};
+    /// Distance to hero actors beyond which vehicles update at reduced rate.
+    float distance_lod_radius {300.0f};
+    /// Frame counter used to stagger reduced-rate LOD updates.
+    uint64_t lod_frame_counter {0u};
+    /// Per-vehicle hold decisions for the current frame.
+    std::vector<uint8_t> lod_hold_flags;
+    /// Switch indicating deterministic mode.
+    bool deterministic_mode {false};
+    /// Seed for the per-actor random streams in deterministic mode.
+    uint64_t random_seed {0u};
+    /// Frame counter advancing the per-actor random streams.
+    uint64_t dice_frame_counter {0u};
     /// Structure to hold previous state of physics-less vehicle.
     std::unordered_map<ActorId, KinematicState> kinematic_state_map;
     /// Time instance used to calculate dt in asynchronous mode.
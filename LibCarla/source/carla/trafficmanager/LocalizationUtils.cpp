@@ -52,6 +52,8 @@ namespace LocalizationConstants {
   void TrackTraffic::UpdateUnregisteredGridPosition(const ActorId actor_id,
                                                     const std::vector<SimpleWaypointPtr> waypoints) {
 
+    std::lock_guard<std::mutex> lock(track_traffic_mutex);
+
     // Add actor entry, if not present.
     if (actor_to_grids.find(actor_id) == actor_to_grids.end()) {
       actor_to_grids.insert({actor_id, {}});
@@ -93,6 +95,8 @@ namespace LocalizationConstants {
 
   void TrackTraffic::UpdateGridPosition(const ActorId actor_id, const Buffer& buffer) {
 
+    std::lock_guard<std::mutex> lock(track_traffic_mutex);
+
     if (!buffer.empty()) {
 
       // Add actor entry, if not present.
@@ -137,6 +141,8 @@ namespace LocalizationConstants {
 
   ActorIdSet TrackTraffic::GetOverlappingVehicles(ActorId actor_id) {
 
+    std::lock_guard<std::mutex> lock(track_traffic_mutex);
+
     ActorIdSet actor_id_set;
 
     if (actor_to_grids.find(actor_id) != actor_to_grids.end()) {
@@ -154,6 +160,8 @@ namespace LocalizationConstants {
 
   void TrackTraffic::DeleteActor(ActorId actor_id) {
 
+    std::lock_guard<std::mutex> lock(track_traffic_mutex);
+
     if (actor_to_grids.find(actor_id) != actor_to_grids.end()) {
       std::unordered_set<GeoGridId>& grid_ids = actor_to_grids.at(actor_id);
       for (auto& grid_id: grid_ids) {
@@ -170,6 +178,8 @@ namespace LocalizationConstants {
 
   std::unordered_set<GeoGridId> TrackTraffic::GetGridIds(ActorId actor_id) {
 
+    std::lock_guard<std::mutex> lock(track_traffic_mutex);
+
     std::unordered_set<GeoGridId> grid_ids;
 
     if (actor_to_grids.find(actor_id) != actor_to_grids.end()) {
@@ -180,11 +190,14 @@ namespace LocalizationConstants {
   }
 
   std::unordered_map<GeoGridId, ActorIdSet> TrackTraffic::GetGridActors() {
+    std::lock_guard<std::mutex> lock(track_traffic_mutex);
     return grid_to_actors;
   }
 
   void TrackTraffic::UpdatePassingVehicle(uint64_t waypoint_id, ActorId actor_id) {
 
+    std::lock_guard<std::mutex> lock(track_traffic_mutex);
+
     if (waypoint_overlap_tracker.find(waypoint_id) != waypoint_overlap_tracker.end()) {
 
       ActorIdSet& actor_id_set = waypoint_overlap_tracker.at(waypoint_id);
@@ -199,6 +212,8 @@ namespace LocalizationConstants {
 
   void TrackTraffic::RemovePassingVehicle(uint64_t waypoint_id, ActorId actor_id) {
 
+    std::lock_guard<std::mutex> lock(track_traffic_mutex);
+
     if (waypoint_overlap_tracker.find(waypoint_id) != waypoint_overlap_tracker.end()) {
 
       auto& actor_id_set = waypoint_overlap_tracker.at(waypoint_id);
@@ -214,6 +229,8 @@ namespace LocalizationConstants {
 
   ActorIdSet TrackTraffic::GetPassingVehicles(uint64_t waypoint_id) {
 
+    std::lock_guard<std::mutex> lock(track_traffic_mutex);
+
     if (waypoint_overlap_tracker.find(waypoint_id) != waypoint_overlap_tracker.end()) {
       return waypoint_overlap_tracker.at(waypoint_id);
     } else {
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "carla/client/Actor.h"
 #include "carla/client/ActorList.h"
 #include "carla/client/Vehicle.h"
@@ -15,6 +17,7 @@
 #include "carla/rpc/ActorId.h"
 
 #include "carla/trafficmanager/SimpleWaypoint.h"
+#include "carla/trafficmanager/WaypointBuffer.h"
 
 namespace carla {
 namespace traffic_manager {
@@ -25,7 +28,7 @@ namespace traffic_manager {
   using ActorId = carla::ActorId;
   using ActorIdSet = std::unordered_set<ActorId>;
   using SimpleWaypointPtr = std::shared_ptr<SimpleWaypoint>;
-  using Buffer = std::deque<SimpleWaypointPtr>;
+  using Buffer = WaypointBuffer;
   using GeoGridId = carla::road::JuncId;
 
   class TrackTraffic{
@@ -40,6 +43,9 @@ namespace traffic_manager {
     std::unordered_map<ActorId, std::unordered_set<GeoGridId>> actor_to_grids;
     /// Actors currently passing through grids.
     std::unordered_map<GeoGridId, ActorIdSet> grid_to_actors;
+    /// Mutex guarding the tracking structures, since vehicles are
+    /// processed in parallel inside the localization stage.
+    std::mutex track_traffic_mutex;
 
   public:
     TrackTraffic();
@@ -8,7 +8,6 @@
 
 #include <atomic>
 #include <chrono>
-#include <deque>
 #include <condition_variable>
 #include <mutex>
 
@@ -24,8 +23,13 @@ namespace traffic_manager {
 
     /// Flag used to wake up and join any waiting function calls on this object.
     std::atomic<bool> stop_messenger;
-    /// Member used to hold data sent by the sender.
-    std::deque<Data> d_queue;
+    /// Flag indicating whether the slot holds a frame not yet taken
+    /// by the receiver.
+    std::atomic<bool> frame_available;
+    /// Single slot exchanged between the sender and the receiver.
+    /// The stages double-buffer their frames, so handing over a pointer
+    /// to the current frame is enough; no queueing is needed.
+    Data data_slot;
     /// Mutex used to manage contention between the sender and receiver.
     std::mutex data_modification_mutex;
     /// Variable to conditionally block sender in case waiting for the receiver.
@@ -37,19 +41,21 @@ namespace traffic_manager {
 
     Messenger() {
       stop_messenger.store(false);
+      frame_available.store(false);
     }
     ~Messenger() {}
 
     void Push(Data data) {
 
       std::unique_lock<std::mutex> lock(data_modification_mutex);
-      while (!d_queue.empty() && !stop_messenger.load()) {
+      while (frame_available.load() && !stop_messenger.load()) {
         send_condition.wait_for(lock, 1ms, [=] {
-          return (d_queue.empty() && stop_messenger.load());
+          return (!frame_available.load() || stop_messenger.load());
         });
       }
       if(!stop_messenger.load()){
-        d_queue.push_front(data);
+        data_slot = std::move(data);
+        frame_available.store(true);
         receive_condition.notify_one();
       }
     }
@@ -57,14 +63,14 @@ namespace traffic_manager {
     Data Peek() {
 
       std::unique_lock<std::mutex> lock(data_modification_mutex);
-      while (d_queue.empty() && !stop_messenger.load()) {
+      while (!frame_available.load() && !stop_messenger.load()) {
         receive_condition.wait_for(lock, 1ms, [=] {
-          return (!d_queue.empty() && stop_messenger.load());
+          return (frame_available.load() || stop_messenger.load());
         });
       }
 
       if(!stop_messenger.load()) {
-        Data data = d_queue.back();
+        Data data = data_slot;
         return data;
       }
       return Data();
@@ -73,8 +79,10 @@ namespace traffic_manager {
     void Pop() {
 
       std::unique_lock<std::mutex> lock(data_modification_mutex);
-      if (!(d_queue.empty() && stop_messenger.load())) {
-        d_queue.pop_back();
+      if (frame_available.load()) {
+        // Only releasing the slot; the sender overwrites it on the next
+        // push, keeping the frame storage alive across cycles.
+        frame_available.store(false);
         send_condition.notify_one();
       }
     }
@@ -85,7 +93,11 @@ namespace traffic_manager {
 
     void Stop() {
       stop_messenger.store(true);
-      d_queue.clear();
+      {
+        std::unique_lock<std::mutex> lock(data_modification_mutex);
+        data_slot = Data();
+        frame_available.store(false);
+      }
       send_condition.notify_one();
       receive_condition.notify_one();
     }
@@ -19,6 +19,7 @@
 
 #include "carla/trafficmanager/Messenger.h"
 #include "carla/trafficmanager/SimpleWaypoint.h"
+#include "carla/trafficmanager/WaypointBuffer.h"
 
 namespace carla {
 namespace traffic_manager {
@@ -29,7 +30,7 @@ namespace traffic_manager {
   /// Convenience typing.
 
   /// Alias for waypoint buffer used in the localization stage.
-  using Buffer = std::deque<std::shared_ptr<SimpleWaypoint>>;
+  using Buffer = WaypointBuffer;
   /// Alias used for the list of buffers in the localization stage.
   using BufferList = std::unordered_map<carla::ActorId, Buffer>;
 
@@ -47,6 +48,9 @@ namespace traffic_manager {
     cg::Vector3D velocity;
     bool physics_enabled;
     std::vector<std::shared_ptr<SimpleWaypoint>> position_window;
+    /// True on reduced-rate LOD frames; the planner holds the previous
+    /// actuation instead of running the controller.
+    bool lod_hold = false;
   };
 
   /// Type of data sent by the motion planner stage to the batch control stage.
@@ -57,6 +61,9 @@ namespace traffic_manager {
     float steer;
     bool physics_enabled;
     cg::Transform transform;
+    /// True on reduced-rate LOD frames; batch control skips the command
+    /// so the simulator keeps applying the previous one.
+    bool lod_hold = false;
   };
 
   /// Type of data sent by the localization stage to the collision stage.
@@ -68,6 +75,9 @@ namespace traffic_manager {
     std::shared_ptr<SimpleWaypoint> closest_waypoint;
     std::shared_ptr<SimpleWaypoint> junction_look_ahead_waypoint;
     cg::Vector3D velocity;
+    /// True on reduced-rate LOD frames; the rest of the entry holds the
+    /// data of the vehicle's last full update.
+    bool lod_hold = false;
   };
 
   /// Type of data sent by the collision stage to the motion planner stage.
@@ -82,6 +92,8 @@ namespace traffic_manager {
     Actor actor;
     std::shared_ptr<SimpleWaypoint> closest_waypoint;
     std::shared_ptr<SimpleWaypoint> junction_look_ahead_waypoint;
+    /// True on reduced-rate LOD frames; the stage skips the vehicle.
+    bool lod_hold = false;
   };
 
   /// Type of data sent by the traffic light stage to the motion planner stage.
@@ -6,6 +6,8 @@
 
 #include "carla/trafficmanager/MotionPlannerStage.h"
 
+#include "carla/trafficmanager/StageParallelism.h"
+
 namespace carla {
 namespace traffic_manager {
 
@@ -57,24 +59,93 @@ namespace PlannerConstants {
 
   MotionPlannerStage::~MotionPlannerStage() {}
 
+  void MotionPlannerStage::PIDBatchBuffers::Resize(uint64_t count) {
+
+    actor_id.assign(count, 0u);
+    time.assign(count, TimeInstance());
+    active.assign(count, 0u);
+    emergency_stop.assign(count, 0u);
+    current_velocity.assign(count, 0.0f);
+    // Benign default so inactive lanes don't divide by zero in the kernel.
+    target_velocity.assign(count, 1.0f);
+    deviation.assign(count, 0.0f);
+    distance.assign(count, 0.0f);
+    previous_velocity.assign(count, 0.0f);
+    previous_deviation.assign(count, 0.0f);
+    previous_deviation_integral.assign(count, 0.0f);
+    previous_distance_integral.assign(count, 0.0f);
+    previous_velocity_integral.assign(count, 0.0f);
+    longitudinal_kp.assign(count, 0.0f);
+    longitudinal_ki.assign(count, 0.0f);
+    longitudinal_kd.assign(count, 0.0f);
+    lateral_kp.assign(count, 0.0f);
+    lateral_ki.assign(count, 0.0f);
+    lateral_kd.assign(count, 0.0f);
+    velocity.assign(count, 0.0f);
+    deviation_integral.assign(count, 0.0f);
+    distance_integral.assign(count, 0.0f);
+    velocity_integral.assign(count, 0.0f);
+    throttle.assign(count, 0.0f);
+    brake.assign(count, 0.0f);
+    steer.assign(count, 0.0f);
+  }
+
   void MotionPlannerStage::Action() {
 
     // Selecting an output frame.
     const auto current_control_frame = frame_selector ? control_frame_a : control_frame_b;
 
-    // Looping over all vehicles.
-    for (uint64_t i = 0u;
-         i < number_of_vehicles &&
-         localization_frame != nullptr &&
-         collision_frame != nullptr &&
-         traffic_light_frame != nullptr;
-         ++i) {
+    if (localization_frame == nullptr ||
+        collision_frame == nullptr ||
+        traffic_light_frame == nullptr) {
+      return;
+    }
+
+    // Initialize per-vehicle state entries up front; the parallel iterations
+    // below only read and write their own existing entries, never insert.
+    for (uint64_t i = 0u; i < number_of_vehicles; ++i) {
+      const LocalizationToPlannerData &localization_data = localization_frame->at(i);
+      if (!localization_data.actor->IsAlive()) {
+        continue;
+      }
+      const ActorId actor_id = localization_data.actor->GetId();
+      if (pid_state_map.find(actor_id) == pid_state_map.end()) {
+        const auto initial_state = StateEntry{0.0f, 0.0f, 0.0f, chr::system_clock::now(), 0.0f, 0.0f, 0.0f};
+        pid_state_map.insert({actor_id, initial_state});
+      }
+      if (hybrid_physics_mode && !localization_data.physics_enabled &&
+          teleportation_instance.find(actor_id) == teleportation_instance.end()) {
+        teleportation_instance.insert({actor_id, chr::system_clock::now()});
+      }
+    }
+
+    // Sizing the struct-of-arrays buffers for the batch PID kernels.
+    pid_batch.Resize(number_of_vehicles);
+
+    // First pass, gathering controller inputs into the fleet arrays; given
+    // the frame snapshot every vehicle is independent, so the loop is
+    // partitioned over the stage workers. Physics-less vehicles in hybrid
+    // mode are handled here entirely since they bypass the controller.
+    ParallelForEachIndex(number_of_vehicles, [&](uint64_t i) {
 
       const LocalizationToPlannerData &localization_data = localization_frame->at(i);
       const CollisionToPlannerData& collision_data = collision_frame->at(i);
 
       if (!localization_data.actor->IsAlive()) {
-        continue;
+        return;
+      }
+
+      // Reduced-rate LOD hold; skip the controller for this vehicle and
+      // tell batch control to keep the previously applied command.
+      if (localization_data.lod_hold) {
+        PlannerToControlData &held_message = current_control_frame->at(i);
+        held_message.actor = localization_data.actor;
+        held_message.throttle = 0.0f;
+        held_message.brake = 0.0f;
+        held_message.steer = 0.0f;
+        held_message.physics_enabled = true;
+        held_message.lod_hold = true;
+        return;
       }
 
       const Actor actor = localization_data.actor;
@@ -89,24 +160,18 @@ namespace PlannerConstants {
 
       const auto current_time = chr::system_clock::now();
 
-      // If previous state for vehicle not found, initialize state entry.
-      if (pid_state_map.find(actor_id) == pid_state_map.end()) {
-        const auto initial_state = StateEntry{0.0f, 0.0f, 0.0f, chr::system_clock::now(), 0.0f, 0.0f, 0.0f};
-        pid_state_map.insert({actor_id, initial_state});
-      }
-
-      // Retrieving the previous state.
+      // Retrieving the previous state, the entry was created in the
+      // initialization pass above.
       traffic_manager::StateEntry previous_state;
       previous_state = pid_state_map.at(actor_id);
 
-      // Change PID parameters if on highway.
-      if (current_velocity > HIGHWAY_SPEED) {
-        longitudinal_parameters = highway_longitudinal_parameters;
-        lateral_parameters = highway_lateral_parameters;
-      } else {
-        longitudinal_parameters = urban_longitudinal_parameters;
-        lateral_parameters = urban_lateral_parameters;
-      }
+      // Change PID parameters if on highway; selected locally, the
+      // iterations of this loop run concurrently.
+      const bool on_highway = current_velocity > HIGHWAY_SPEED;
+      const std::vector<float> &longitudinal_parameters =
+          on_highway ? highway_longitudinal_parameters : urban_longitudinal_parameters;
+      const std::vector<float> &lateral_parameters =
+          on_highway ? highway_lateral_parameters : urban_lateral_parameters;
 
       // Target velocity for vehicle.
       float max_target_velocity = parameters.GetVehicleTargetVelocity(actor) / 3.6f;
@@ -156,31 +221,32 @@ namespace PlannerConstants {
       }
 
       // Message items to be sent to batch control stage.
-      ActuationSignal actuation_signal {0.0f, 0.0f, 0.0f};
       bool physics_enabled = true;
       cg::Transform teleportation_transform;
 
-      // If physics is enabled for the vehicle, use PID controller.
-      StateEntry current_state;
+      // If physics is enabled for the vehicle, stage its inputs for the
+      // batch PID kernels; the scatter pass below writes the actuation.
       if (localization_data.physics_enabled) {
 
-        // State update for vehicle.
-        current_state = controller.StateUpdate(previous_state, current_velocity,
-                                               dynamic_target_velocity, current_deviation,
-                                               current_distance, current_time);
-
-        // Controller actuation.
-        actuation_signal = controller.RunStep(current_state, previous_state,
-                                              longitudinal_parameters, lateral_parameters);
-
-        if (emergency_stop) {
-
-          current_state.deviation_integral = 0.0f;
-          current_state.velocity_integral = 0.0f;
-          actuation_signal.throttle = 0.0f;
-          actuation_signal.brake = 1.0f;
-        }
-
+        pid_batch.actor_id.at(i) = actor_id;
+        pid_batch.time.at(i) = current_time;
+        pid_batch.active.at(i) = 1u;
+        pid_batch.emergency_stop.at(i) = emergency_stop ? 1u : 0u;
+        pid_batch.current_velocity.at(i) = current_velocity;
+        pid_batch.target_velocity.at(i) = dynamic_target_velocity;
+        pid_batch.deviation.at(i) = current_deviation;
+        pid_batch.distance.at(i) = current_distance;
+        pid_batch.previous_velocity.at(i) = previous_state.velocity;
+        pid_batch.previous_deviation.at(i) = previous_state.deviation;
+        pid_batch.previous_deviation_integral.at(i) = previous_state.deviation_integral;
+        pid_batch.previous_distance_integral.at(i) = previous_state.distance_integral;
+        pid_batch.previous_velocity_integral.at(i) = previous_state.velocity_integral;
+        pid_batch.longitudinal_kp.at(i) = longitudinal_parameters[0];
+        pid_batch.longitudinal_ki.at(i) = longitudinal_parameters[1];
+        pid_batch.longitudinal_kd.at(i) = longitudinal_parameters[2];
+        pid_batch.lateral_kp.at(i) = lateral_parameters[0];
+        pid_batch.lateral_ki.at(i) = lateral_parameters[1];
+        pid_batch.lateral_kd.at(i) = lateral_parameters[2];
       }
       // For physics-less vehicles, determine position and orientation for teleportation.
       else if (hybrid_physics_mode) {
@@ -188,16 +254,12 @@ namespace PlannerConstants {
         physics_enabled = false;
 
         // Flushing controller state for vehicle.
-        current_state = {0.0f, 0.0f, 0.0f,
-                         chr::system_clock::now(),
-                         0.0f, 0.0f, 0.0f};
+        pid_state_map.at(actor_id) = {0.0f, 0.0f, 0.0f,
+                                      chr::system_clock::now(),
+                                      0.0f, 0.0f, 0.0f};
 
-        // Add entry to teleportation duration clock table if not present.
-        if (teleportation_instance.find(actor_id) == teleportation_instance.end()) {
-          teleportation_instance.insert({actor_id, chr::system_clock::now()});
-        }
-
-        // Measuring time elapsed since last teleportation for the vehicle.
+        // Measuring time elapsed since last teleportation for the vehicle;
+        // the entry was created in the initialization pass above.
         chr::duration<float> elapsed_time = current_time - teleportation_instance.at(actor_id);
 
         // Find a location ahead of the vehicle for teleportation to achieve intended velocity.
@@ -261,19 +323,85 @@ namespace PlannerConstants {
 
       }
 
-      // Updating PID state.
-      StateEntry &state = pid_state_map.at(actor_id);
-      state = current_state;
-
-      // Constructing the actuation signal.
+      // Constructing the message; the actuation fields of active lanes are
+      // filled by the scatter pass after the kernels have run.
       PlannerToControlData &message = current_control_frame->at(i);
       message.actor = actor;
-      message.throttle = actuation_signal.throttle;
-      message.brake = actuation_signal.brake;
-      message.steer = actuation_signal.steer;
+      message.throttle = 0.0f;
+      message.brake = 0.0f;
+      message.steer = 0.0f;
       message.physics_enabled = physics_enabled;
       message.transform = teleportation_transform;
-    }
+      message.lod_hold = false;
+    });
+
+    // Evaluating the longitudinal and lateral PID updates as vectorized
+    // batch kernels over the fleet arrays.
+    controller.StateUpdateBatch(number_of_vehicles,
+                                pid_batch.current_velocity.data(),
+                                pid_batch.target_velocity.data(),
+                                pid_batch.deviation.data(),
+                                pid_batch.distance.data(),
+                                pid_batch.previous_deviation_integral.data(),
+                                pid_batch.previous_distance_integral.data(),
+                                pid_batch.previous_velocity_integral.data(),
+                                pid_batch.velocity.data(),
+                                pid_batch.deviation_integral.data(),
+                                pid_batch.distance_integral.data(),
+                                pid_batch.velocity_integral.data());
+    controller.RunStepBatch(number_of_vehicles,
+                            pid_batch.velocity.data(),
+                            pid_batch.velocity_integral.data(),
+                            pid_batch.previous_velocity.data(),
+                            pid_batch.deviation.data(),
+                            pid_batch.deviation_integral.data(),
+                            pid_batch.previous_deviation.data(),
+                            pid_batch.longitudinal_kp.data(),
+                            pid_batch.longitudinal_ki.data(),
+                            pid_batch.longitudinal_kd.data(),
+                            pid_batch.lateral_kp.data(),
+                            pid_batch.lateral_ki.data(),
+                            pid_batch.lateral_kd.data(),
+                            pid_batch.throttle.data(),
+                            pid_batch.brake.data(),
+                            pid_batch.steer.data());
+
+    // Second pass, scattering kernel results back into controller states
+    // and the output frame; each lane touches only its own entries.
+    ParallelForEachIndex(number_of_vehicles, [&](uint64_t i) {
+
+      if (pid_batch.active.at(i) == 0u) {
+        return;
+      }
+
+      StateEntry current_state = {pid_batch.deviation.at(i),
+                                  pid_batch.distance.at(i),
+                                  pid_batch.velocity.at(i),
+                                  pid_batch.time.at(i),
+                                  pid_batch.deviation_integral.at(i),
+                                  pid_batch.distance_integral.at(i),
+                                  pid_batch.velocity_integral.at(i)};
+      float throttle = pid_batch.throttle.at(i);
+      float brake = pid_batch.brake.at(i);
+      float steer = pid_batch.steer.at(i);
+
+      if (pid_batch.emergency_stop.at(i) == 1u) {
+
+        current_state.deviation_integral = 0.0f;
+        current_state.velocity_integral = 0.0f;
+        throttle = 0.0f;
+        brake = 1.0f;
+      }
+
+      // Updating PID state.
+      pid_state_map.at(pid_batch.actor_id.at(i)) = current_state;
+
+      // Constructing the actuation signal.
+      PlannerToControlData &message = current_control_frame->at(i);
+      message.throttle = throttle;
+      message.brake = brake;
+      message.steer = steer;
+    });
   }
 
   void MotionPlannerStage::DataReceiver() {
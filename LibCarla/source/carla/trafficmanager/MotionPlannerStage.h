@@ -56,6 +56,42 @@ namespace traffic_manager {
     /// Map to store states for integral and differential components
     /// of the PID controller for every vehicle
     std::unordered_map<ActorId, StateEntry> pid_state_map;
+    /// Struct-of-arrays buffers feeding the batch PID kernels. Sized to
+    /// the fleet every frame; the vectors keep their capacity across
+    /// frames.
+    struct PIDBatchBuffers {
+      /// Per-vehicle bookkeeping for the scatter pass.
+      std::vector<ActorId> actor_id;
+      std::vector<TimeInstance> time;
+      std::vector<uint8_t> active;
+      std::vector<uint8_t> emergency_stop;
+      /// Kernel inputs.
+      std::vector<float> current_velocity;
+      std::vector<float> target_velocity;
+      std::vector<float> deviation;
+      std::vector<float> distance;
+      std::vector<float> previous_velocity;
+      std::vector<float> previous_deviation;
+      std::vector<float> previous_deviation_integral;
+      std::vector<float> previous_distance_integral;
+      std::vector<float> previous_velocity_integral;
+      std::vector<float> longitudinal_kp;
+      std::vector<float> longitudinal_ki;
+      std::vector<float> longitudinal_kd;
+      std::vector<float> lateral_kp;
+      std::vector<float> lateral_ki;
+      std::vector<float> lateral_kd;
+      /// Kernel outputs.
+      std::vector<float> velocity;
+      std::vector<float> deviation_integral;
+      std::vector<float> distance_integral;
+      std::vector<float> velocity_integral;
+      std::vector<float> throttle;
+      std::vector<float> brake;
+      std::vector<float> steer;
+
+      void Resize(uint64_t count);
+    } pid_batch;
     /// Run time parameterization object.
     Parameters &parameters;
     /// Configuration parameters for the PID controller.
@@ -63,8 +99,6 @@ namespace traffic_manager {
     std::vector<float> highway_longitudinal_parameters;
     std::vector<float> urban_lateral_parameters;
     std::vector<float> highway_lateral_parameters;
-    std::vector<float> longitudinal_parameters;
-    std::vector<float> lateral_parameters;
     /// Controller object.
     PIDController controller;
     /// Number of vehicles registered with the traffic manager.
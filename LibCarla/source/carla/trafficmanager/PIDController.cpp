@@ -28,71 +28,76 @@ namespace PIDControllerConstants {
 
   PIDController::PIDController() {}
 
-  // Initializing present state.
-  StateEntry PIDController::StateUpdate(
-      StateEntry previous_state,
-      float current_velocity,
-      float target_velocity,
-      float angular_deviation,
-      float distance,
-      TimeInstance current_time) {
-
-    traffic_manager::StateEntry current_state = {
-      angular_deviation, distance,
-      (current_velocity - target_velocity) / target_velocity,
-      current_time,
-      0.0f,
-      0.0f,
-      0.0f
-    };
-
-    // Calculating integrals.
-    current_state.deviation_integral = angular_deviation * dt + previous_state.deviation_integral;
-    current_state.distance_integral = distance * dt + previous_state.distance_integral;
-    current_state.velocity_integral = dt * current_state.velocity + previous_state.velocity_integral;
-
-    // Clamp velocity integral to avoid accumulating over-compensation
-    // with time for vehicles that take a long time to reach target velocity.
-    current_state.velocity_integral = CLAMP(current_state.velocity_integral,
-                                            VELOCITY_INTEGRAL_MAX, VELOCITY_INTEGRAL_MIN);
-
-    return current_state;
+  void PIDController::StateUpdateBatch(
+      const uint64_t count,
+      const float *current_velocity,
+      const float *target_velocity,
+      const float *angular_deviation,
+      const float *distance,
+      const float *previous_deviation_integral,
+      const float *previous_distance_integral,
+      const float *previous_velocity_integral,
+      float *velocity,
+      float *deviation_integral,
+      float *distance_integral,
+      float *velocity_integral) const {
+
+    for (uint64_t i = 0u; i < count; ++i) {
+
+      const float relative_velocity = (current_velocity[i] - target_velocity[i]) / target_velocity[i];
+      velocity[i] = relative_velocity;
+
+      // Calculating integrals.
+      deviation_integral[i] = angular_deviation[i] * dt + previous_deviation_integral[i];
+      distance_integral[i] = distance[i] * dt + previous_distance_integral[i];
+      const float accumulated_velocity_integral = dt * relative_velocity + previous_velocity_integral[i];
+
+      // Clamp velocity integral to avoid accumulating over-compensation
+      // with time for vehicles that take a long time to reach target velocity.
+      velocity_integral[i] = CLAMP(accumulated_velocity_integral,
+                                   VELOCITY_INTEGRAL_MAX, VELOCITY_INTEGRAL_MIN);
+    }
   }
 
-  ActuationSignal PIDController::RunStep(
-      StateEntry present_state,
-      StateEntry previous_state,
-      const std::vector<float> &longitudinal_parameters,
-      const std::vector<float> &lateral_parameters) const {
-
-    // Longitudinal PID calculation.
-    const float expr_v =
-        longitudinal_parameters[0] * present_state.velocity +
-        longitudinal_parameters[1] * present_state.velocity_integral +
-        longitudinal_parameters[2] * (present_state.velocity -
-        previous_state.velocity) / dt;
-
-    float throttle;
-    float brake;
-
-    if (expr_v < 0.0f) {
-      throttle = std::min(std::abs(expr_v), MAX_THROTTLE);
-      brake = 0.0f;
-    } else {
-      throttle = 0.0f;
-      brake = std::min(expr_v, MAX_BRAKE);
+  void PIDController::RunStepBatch(
+      const uint64_t count,
+      const float *velocity,
+      const float *velocity_integral,
+      const float *previous_velocity,
+      const float *deviation,
+      const float *deviation_integral,
+      const float *previous_deviation,
+      const float *longitudinal_kp,
+      const float *longitudinal_ki,
+      const float *longitudinal_kd,
+      const float *lateral_kp,
+      const float *lateral_ki,
+      const float *lateral_kd,
+      float *throttle,
+      float *brake,
+      float *steer) const {
+
+    for (uint64_t i = 0u; i < count; ++i) {
+
+      // Longitudinal PID calculation.
+      const float expr_v =
+          longitudinal_kp[i] * velocity[i] +
+          longitudinal_ki[i] * velocity_integral[i] +
+          longitudinal_kd[i] * (velocity[i] - previous_velocity[i]) / dt;
+
+      // Branchless selects so the loop stays vectorizable.
+      const float expr_v_magnitude = expr_v < 0.0f ? -expr_v : expr_v;
+      throttle[i] = expr_v < 0.0f ? std::min(expr_v_magnitude, MAX_THROTTLE) : 0.0f;
+      brake[i] = expr_v < 0.0f ? 0.0f : std::min(expr_v, MAX_BRAKE);
+
+      // Lateral PID calculation.
+      const float expr_s =
+          lateral_kp[i] * deviation[i] +
+          lateral_ki[i] * deviation_integral[i] +
+          lateral_kd[i] * (deviation[i] - previous_deviation[i]) / dt;
+
+      steer[i] = CLAMP(expr_s, 0.8f, -0.8f);
     }
-
-    // Lateral PID calculation.
-    float steer =
-        lateral_parameters[0] * present_state.deviation +
-        lateral_parameters[1] * present_state.deviation_integral +
-        lateral_parameters[2] * (present_state.deviation -
-        previous_state.deviation) / dt;
-
-    steer = std::max(-0.8f, std::min(steer, 0.8f));
-
-    return ActuationSignal{throttle, brake, steer};
   }
 
 } // namespace traffic_manager
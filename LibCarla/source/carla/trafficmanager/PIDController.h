@@ -37,6 +37,10 @@ namespace traffic_manager {
   /// This class calculates PID actuation signals to control the vehicle
   /// such that the vehicle maintains a target velocity and aligns its
   /// orientation along its trajectory.
+  ///
+  /// The controller state is laid out as struct-of-arrays across the fleet
+  /// and the updates are evaluated as batch kernels of identical float
+  /// operations, letting the compiler vectorize them.
 
   class PIDController {
 
@@ -44,23 +48,44 @@ namespace traffic_manager {
 
     PIDController();
 
-    /// This method calculates the present state of the vehicle including
-    /// the accumulated integral component of the PID system.
-    StateEntry StateUpdate(
-        StateEntry previous_state,
-        float current_velocity,
-        float target_velocity,
-        float angular_deviation,
-        float distance,
-        TimeInstance current_time);
+    /// This method calculates the present state of all vehicles in the
+    /// batch, including the accumulated integral components of the PID
+    /// system. Inputs and outputs are parallel arrays of length count.
+    void StateUpdateBatch(
+        const uint64_t count,
+        const float *current_velocity,
+        const float *target_velocity,
+        const float *angular_deviation,
+        const float *distance,
+        const float *previous_deviation_integral,
+        const float *previous_distance_integral,
+        const float *previous_velocity_integral,
+        float *velocity,
+        float *deviation_integral,
+        float *distance_integral,
+        float *velocity_integral) const;
 
-    /// This method calculates the actuation signals based on the resent state
-    /// change of the vehicle to minimize PID error.
-    ActuationSignal RunStep(
-        StateEntry present_state,
-        StateEntry previous_state,
-        const std::vector<float> &longitudinal_parameters,
-        const std::vector<float> &lateral_parameters) const;
+    /// This method calculates the actuation signals for all vehicles in
+    /// the batch based on the recent state change to minimize PID error.
+    /// PID parameters are per-vehicle arrays since vehicles switch between
+    /// urban and highway parameter sets.
+    void RunStepBatch(
+        const uint64_t count,
+        const float *velocity,
+        const float *velocity_integral,
+        const float *previous_velocity,
+        const float *deviation,
+        const float *deviation_integral,
+        const float *previous_deviation,
+        const float *longitudinal_kp,
+        const float *longitudinal_ki,
+        const float *longitudinal_kd,
+        const float *lateral_kp,
+        const float *lateral_ki,
+        const float *lateral_kd,
+        float *throttle,
+        float *brake,
+        float *steer) const;
 
   };
 
@@ -0,0 +1,45 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "carla/rpc/Actor.h"
+
+namespace carla {
+namespace traffic_manager {
+
+  /// Identifiers of the per-actor parameters that can travel in a
+  /// batched parameter-set RPC.
+  enum class VehicleParameter : uint8_t {
+    PercentageSpeedDifference = 0u,
+    DistanceToLeadingVehicle = 1u,
+    PercentageIgnoreWalkers = 2u,
+    PercentageIgnoreVehicles = 3u,
+    PercentageRunningLight = 4u,
+    PercentageRunningSign = 5u,
+    KeepRightPercentage = 6u,
+    AutoLaneChange = 7u,
+    ForceLaneChange = 8u
+  };
+
+  /// One buffered per-actor parameter change. Boolean parameters travel
+  /// in the value field, zero meaning false.
+  struct ParameterSetting {
+
+    carla::rpc::Actor actor;
+
+    uint8_t parameter;
+
+    float value;
+
+    MSGPACK_DEFINE_ARRAY(actor, parameter, value);
+  };
+
+} // namespace traffic_manager
+} // namespace carla
@@ -199,6 +199,44 @@ void Parameters::SetHybridPhysicsRadius(const float radius) {
   hybrid_physics_radius.store(new_radius);
 }
 
+void Parameters::SetDistanceLODMode(const bool mode_switch) {
+
+  distance_lod_mode.store(mode_switch);
+}
+
+bool Parameters::GetDistanceLODMode() {
+
+  return distance_lod_mode.load();
+}
+
+float Parameters::GetDistanceLODRadius() {
+
+  return distance_lod_radius.load();
+}
+
+void Parameters::SetDistanceLODRadius(const float radius) {
+  float new_radius = std::max(radius, 0.0f);
+  distance_lod_radius.store(new_radius);
+}
+
+void Parameters::SetDeterministicMode(const bool mode_switch, const uint64_t seed) {
+
+  // Store the seed before raising the flag so stages never observe the
+  // mode without its seed.
+  random_seed.store(seed);
+  deterministic_mode.store(mode_switch);
+}
+
+bool Parameters::GetDeterministicMode() {
+
+  return deterministic_mode.load();
+}
+
+uint64_t Parameters::GetRandomSeed() {
+
+  return random_seed.load();
+}
+
 void Parameters::SetPercentageRunningLight(const ActorPtr &actor, const float perc) {
 
   float new_perc = cg::Math::Clamp(perc, 0.0f, 100.0f);
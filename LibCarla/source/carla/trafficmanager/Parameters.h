@@ -64,6 +64,14 @@ namespace traffic_manager {
     std::atomic<bool> hybrid_physics_mode {false};
     /// Hybrid physics radius.
     std::atomic<float> hybrid_physics_radius {70.0};
+    /// Distance LOD mode switch.
+    std::atomic<bool> distance_lod_mode {false};
+    /// Distance to hero actors beyond which vehicles update at reduced rate.
+    std::atomic<float> distance_lod_radius {300.0};
+    /// Deterministic mode switch.
+    std::atomic<bool> deterministic_mode {false};
+    /// Seed for the per-actor random streams in deterministic mode.
+    std::atomic<uint64_t> random_seed {0u};
 
   public:
     Parameters();
@@ -166,6 +174,28 @@ namespace traffic_manager {
     /// Method to retrieve hybrid physics radius.
     float GetHybridPhysicsRadius();
 
+    /// Method to set distance LOD mode.
+    void SetDistanceLODMode(const bool mode_switch);
+
+    /// Method to retrieve distance LOD mode.
+    bool GetDistanceLODMode();
+
+    /// Method to set distance LOD radius.
+    void SetDistanceLODRadius(const float radius);
+
+    /// Method to retrieve distance LOD radius.
+    float GetDistanceLODRadius();
+
+    /// Method to switch deterministic mode on/off, seeding the per-actor
+    /// random streams.
+    void SetDeterministicMode(const bool mode_switch, const uint64_t seed);
+
+    /// Method to retrieve deterministic mode.
+    bool GetDeterministicMode();
+
+    /// Method to retrieve the seed of the per-actor random streams.
+    uint64_t GetRandomSeed();
+
     /// Synchronous mode time out variable.
     std::chrono::duration<double, std::milli> synchronous_time_out;
 
@@ -4,32 +4,41 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <algorithm>
+
 #include "carla/trafficmanager/PerformanceDiagnostics.h"
 
 namespace carla {
 namespace traffic_manager {
 
+namespace DiagnosticsConstants {
+  static const uint64_t HISTOGRAM_BUCKET_COUNT = 200u;
+  static const float HISTOGRAM_BUCKET_WIDTH_MS = 0.5f;
+} // namespace DiagnosticsConstants
+  using namespace DiagnosticsConstants;
+
   PerformanceDiagnostics::PerformanceDiagnostics(std::string stage_name)
   : stage_name(stage_name) {
 
     throughput_clock = chr::system_clock::now();
     throughput_counter = 0u;
+    last_throughput = 0u;
     inter_update_clock = chr::system_clock::now();
     inter_update_duration = chr::duration<float>(0);
+    duration_histogram.assign(HISTOGRAM_BUCKET_COUNT, 0u);
+    histogram_sample_count = 0u;
   }
 
   void PerformanceDiagnostics::RegisterUpdate(bool begin_or_end) {
 
     const auto current_time = chr::system_clock::now();
+    std::lock_guard<std::mutex> lock(stats_mutex);
 
     if (begin_or_end) {
       const chr::duration<float> throughput_count_duration = current_time - throughput_clock;
       if (throughput_count_duration.count() > 1.0f) {
 
-      // std::cout << "Stage: " + stage_name + ", throughput: " << throughput_counter
-      //           << ", avg. cycle duration: " << 1000* inter_update_duration.count()
-      //           << " ms" << std::endl;
-
+        last_throughput = throughput_counter;
         throughput_clock = current_time;
         throughput_counter = 0u;
       } else {
@@ -41,7 +50,46 @@ namespace traffic_manager {
     } else {
       const chr::duration<float> last_update_duration = current_time - inter_update_clock;
       inter_update_duration = (inter_update_duration + last_update_duration) / 2.0f;
+
+      // Record the cycle duration in the latency histogram. Durations beyond
+      // the histogram's range are clamped into the last bucket.
+      const float duration_ms = 1000.0f * last_update_duration.count();
+      uint64_t bucket_index = static_cast<uint64_t>(std::max(duration_ms, 0.0f) / HISTOGRAM_BUCKET_WIDTH_MS);
+      bucket_index = std::min(bucket_index, HISTOGRAM_BUCKET_COUNT - 1u);
+      ++duration_histogram.at(bucket_index);
+      ++histogram_sample_count;
+    }
+  }
+
+  float PerformanceDiagnostics::GetPercentile(float fraction) const {
+
+    if (histogram_sample_count == 0u) {
+      return 0.0f;
+    }
+
+    const uint64_t target_rank = static_cast<uint64_t>(fraction * static_cast<float>(histogram_sample_count));
+    uint64_t cumulative_count = 0u;
+    for (uint64_t bucket_index = 0u; bucket_index < HISTOGRAM_BUCKET_COUNT; ++bucket_index) {
+      cumulative_count += duration_histogram.at(bucket_index);
+      if (cumulative_count > target_rank) {
+        // Report the bucket's midpoint as the percentile estimate.
+        return (static_cast<float>(bucket_index) + 0.5f) * HISTOGRAM_BUCKET_WIDTH_MS;
+      }
     }
+    return static_cast<float>(HISTOGRAM_BUCKET_COUNT) * HISTOGRAM_BUCKET_WIDTH_MS;
+  }
+
+  StageTimingStats PerformanceDiagnostics::GetTimingStats() const {
+
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    StageTimingStats stats;
+    stats.stage_name = stage_name;
+    stats.sample_count = histogram_sample_count;
+    stats.updates_per_second = last_throughput;
+    stats.p50_milliseconds = GetPercentile(0.50f);
+    stats.p95_milliseconds = GetPercentile(0.95f);
+    stats.p99_milliseconds = GetPercentile(0.99f);
+    return stats;
   }
 
 } // namespace traffic_manager
@@ -7,8 +7,10 @@
 #pragma once
 
 #include <chrono>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "carla/Logging.h"
 
@@ -19,6 +21,22 @@ namespace traffic_manager {
   using namespace chr;
   using TimePoint = chr::time_point<chr::system_clock, chr::nanoseconds>;
 
+  /// Structure to hold a snapshot of a stage's timing statistics.
+  struct StageTimingStats {
+    /// Name of the stage the statistics belong to.
+    std::string stage_name;
+    /// Number of update cycles accumulated in the latency histogram.
+    uint64_t sample_count;
+    /// Update cycles completed during the last full second.
+    uint64_t updates_per_second;
+    /// Median latency of the stage's update in milliseconds.
+    float p50_milliseconds;
+    /// 95th percentile latency of the stage's update in milliseconds.
+    float p95_milliseconds;
+    /// 99th percentile latency of the stage's update in milliseconds.
+    float p99_milliseconds;
+  };
+
   class PerformanceDiagnostics {
 
   private:
@@ -28,15 +46,30 @@ namespace traffic_manager {
     TimePoint throughput_clock;
     /// Throughput counter.
     uint64_t throughput_counter;
+    /// Throughput measured over the last full second.
+    uint64_t last_throughput;
     /// Inter-update clock.
     TimePoint inter_update_clock;
     /// Inter-update duration.
     chr::duration<float> inter_update_duration;
+    /// Histogram of update durations in fixed-width buckets.
+    std::vector<uint64_t> duration_histogram;
+    /// Number of samples accumulated in the histogram.
+    uint64_t histogram_sample_count;
+    /// Mutex guarding the counters against concurrent snapshot reads.
+    mutable std::mutex stats_mutex;
+
+    /// Returns the latency in milliseconds at the given fraction of the
+    /// histogram's cumulative distribution. Caller must hold stats_mutex.
+    float GetPercentile(float fraction) const;
 
   public:
     PerformanceDiagnostics(std::string name);
 
     void RegisterUpdate(bool begin_or_end);
+
+    /// Returns a snapshot of the stage's timing statistics.
+    StageTimingStats GetTimingStats() const;
   };
 
   class SnippetProfiler {
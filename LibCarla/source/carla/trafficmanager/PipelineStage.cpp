@@ -4,6 +4,8 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include "carla/profiler/TraceLog.h"
+#include "carla/profiler/Tracer.h"
 #include "carla/trafficmanager/PipelineStage.h"
 
 namespace carla {
@@ -12,7 +14,7 @@ namespace traffic_manager {
 PipelineStage::PipelineStage(
     const std::string &stage_name)
   : stage_name(stage_name),
-    performance_diagnostics(PerformanceDiagnostics(stage_name)) {
+    performance_diagnostics(stage_name) {
   run_stage.store(false);
 }
 
@@ -38,12 +40,18 @@ void PipelineStage::Stop() {
   }
 }
 
+StageTimingStats PipelineStage::GetTimingStats() const {
+  return performance_diagnostics.GetTimingStats();
+}
+
 void PipelineStage::Update() {
   while (run_stage.load()){
     // Receive data.
     DataReceiver();
 
     if(run_stage.load()){
+      CARLA_TRACE_SCOPE(traffic_manager, StageAction);
+      CARLA_TRACE_EVENT(traffic_manager, StageAction);
       performance_diagnostics.RegisterUpdate(true);
       Action();
       performance_diagnostics.RegisterUpdate(false);
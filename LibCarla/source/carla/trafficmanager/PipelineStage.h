@@ -71,6 +71,9 @@ namespace traffic_manager {
 
     void Stop();
 
+    /// Returns a snapshot of the stage's timing statistics.
+    StageTimingStats GetTimingStats() const;
+
   };
 
 } // namespace traffic_manager
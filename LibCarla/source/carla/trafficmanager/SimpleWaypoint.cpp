@@ -19,10 +19,16 @@ namespace traffic_manager {
   SimpleWaypoint::~SimpleWaypoint() {}
 
   std::vector<SimpleWaypointPtr> SimpleWaypoint::GetNextWaypoint() const {
+    if (next_span != nullptr) {
+      return std::vector<SimpleWaypointPtr>(next_span, next_span + next_span_size);
+    }
     return next_waypoints;
   }
 
   std::vector<SimpleWaypointPtr> SimpleWaypoint::GetPreviousWaypoint() const {
+    if (previous_span != nullptr) {
+      return std::vector<SimpleWaypointPtr>(previous_span, previous_span + previous_span_size);
+    }
     return previous_waypoints;
   }
 
@@ -64,6 +70,22 @@ namespace traffic_manager {
     return static_cast<uint64_t>(waypoints.size());
   }
 
+  void SimpleWaypoint::CompactAdjacency(std::vector<SimpleWaypointPtr> &adjacency_pool) {
+
+    next_span = adjacency_pool.data() + adjacency_pool.size();
+    next_span_size = static_cast<uint32_t>(next_waypoints.size());
+    adjacency_pool.insert(adjacency_pool.end(), next_waypoints.begin(), next_waypoints.end());
+
+    previous_span = adjacency_pool.data() + adjacency_pool.size();
+    previous_span_size = static_cast<uint32_t>(previous_waypoints.size());
+    adjacency_pool.insert(adjacency_pool.end(), previous_waypoints.begin(), previous_waypoints.end());
+
+    next_waypoints.clear();
+    next_waypoints.shrink_to_fit();
+    previous_waypoints.clear();
+    previous_waypoints.shrink_to_fit();
+  }
+
   void SimpleWaypoint::SetLeftWaypoint(SimpleWaypointPtr &_waypoint) {
 
     const cg::Vector3D heading_vector = waypoint->GetTransform().GetForwardVector();
@@ -107,7 +129,8 @@ namespace traffic_manager {
   }
 
   bool SimpleWaypoint::CheckIntersection() const {
-    return (next_waypoints.size() > 1);
+    const uint64_t next_count = (next_span != nullptr) ? next_span_size : next_waypoints.size();
+    return (next_count > 1);
   }
 
   void SimpleWaypoint::SetGeodesicGridId(GeoGridId _geodesic_grid_id) {
@@ -116,8 +139,8 @@ namespace traffic_manager {
 
   GeoGridId SimpleWaypoint::GetGeodesicGridId() {
     GeoGridId grid_id;
-    if (waypoint->IsJunction()) {
-      grid_id = waypoint->GetJunctionId();
+    if (is_raw_junction) {
+      grid_id = cached_junction_id;
     } else {
       grid_id = geodesic_grid_id;
     }
@@ -125,7 +148,12 @@ namespace traffic_manager {
   }
 
   GeoGridId SimpleWaypoint::GetJunctionId() const {
-    return waypoint->GetJunctionId();
+    return cached_junction_id;
+  }
+
+  void SimpleWaypoint::CacheStaticAttributes() {
+    cached_junction_id = waypoint->GetJunctionId();
+    is_raw_junction = waypoint->IsJunction();
   }
 
   cg::Transform SimpleWaypoint::GetTransform() const {
@@ -36,9 +36,16 @@ namespace traffic_manager {
     /// Pointer to Carla's waypoint object around which this class wraps around.
     WaypointPtr waypoint;
     /// List of pointers to next connecting waypoints.
+    /// Only used while the map is being built; emptied by CompactAdjacency.
     std::vector<SimpleWaypointPtr> next_waypoints;
     /// List of pointers to previous connecting waypoints.
+    /// Only used while the map is being built; emptied by CompactAdjacency.
     std::vector<SimpleWaypointPtr> previous_waypoints;
+    /// Spans over the pooled adjacency storage once the map is compacted.
+    const SimpleWaypointPtr *next_span = nullptr;
+    const SimpleWaypointPtr *previous_span = nullptr;
+    uint32_t next_span_size = 0u;
+    uint32_t previous_span_size = 0u;
     /// Pointer to left lane change waypoint.
     SimpleWaypointPtr next_left_waypoint;
     /// Pointer to right lane change waypoint.
@@ -47,6 +54,14 @@ namespace traffic_manager {
     GeoGridId geodesic_grid_id = 0;
     // Boolean to hold if the waypoint belongs to a junction
     bool _is_junction = false;
+    /// Junction id resolved once at map set-up; junction membership and
+    /// ids are static facts of the road map, so per-frame queries must not
+    /// go back to it.
+    GeoGridId cached_junction_id = -1;
+    /// Raw junction membership from the road map, resolved once at map
+    /// set-up. Unlike _is_junction this is unfiltered; the geodesic grid
+    /// assignment depends on the raw value.
+    bool is_raw_junction = false;
 
   public:
 
@@ -77,6 +92,12 @@ namespace traffic_manager {
     /// This method is used to set the previous waypoints.
     uint64_t SetPreviousWaypoint(const std::vector<SimpleWaypointPtr> &next_waypoints);
 
+    /// Moves this waypoint's adjacency lists into the shared pool and keeps
+    /// spans over them. Called once per waypoint after the map layout is
+    /// final; the pool must be reserved to its full size beforehand so the
+    /// spans stay valid.
+    void CompactAdjacency(std::vector<SimpleWaypointPtr> &adjacency_pool);
+
     /// This method is used to set the closest left waypoint for a lane change.
     void SetLeftWaypoint(SimpleWaypointPtr &waypoint);
 
@@ -96,6 +117,10 @@ namespace traffic_manager {
     /// Metod to retreive junction id of the waypoint.
     GeoGridId GetJunctionId() const;
 
+    /// Resolves and caches the static road facts (junction id and raw
+    /// junction membership) of this waypoint. Called once at map set-up.
+    void CacheStaticAttributes();
+
     /// Calculates the distance from the object's waypoint to the passed
     /// location.
     float Distance(const cg::Location &location) const;
@@ -0,0 +1,25 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/trafficmanager/StageParallelism.h"
+
+#include <thread>
+
+namespace carla {
+namespace traffic_manager {
+
+  TaskExecutor &GetStageExecutor() {
+    static TaskExecutor executor;
+    static const bool initialized = []() {
+      executor.AsyncRun(std::max(2u, std::thread::hardware_concurrency()));
+      return true;
+    }();
+    (void) initialized;
+    return executor;
+  }
+
+} // namespace traffic_manager
+} // namespace carla
@@ -0,0 +1,117 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/TaskExecutor.h"
+
+#include <algorithm>
+#include <future>
+#include <random>
+#include <vector>
+
+namespace carla {
+namespace traffic_manager {
+
+  /// Work-stealing executor shared by all pipeline stages for their
+  /// per-vehicle loops. Sharing one pool keeps the thread count bounded no
+  /// matter how many stages run; the stages themselves still execute in
+  /// pipeline order, each Action() only returns once its own chunks finish.
+  TaskExecutor &GetStageExecutor();
+
+  /// Run @a function over every index in [0, @a count), partitioned in
+  /// chunks over the stage executor; idle workers steal chunks from busy
+  /// ones. Blocks until every index has been processed. Iterations must be
+  /// independent: they run concurrently and in no particular order.
+  ///
+  /// Small loops run inline, the fork/join overhead would dominate.
+  template <typename Function>
+  static void ParallelForEachIndex(uint64_t count, Function function) {
+
+    constexpr uint64_t MINIMUM_PARALLEL_COUNT = 50u;
+    constexpr uint64_t CHUNKS_PER_WORKER = 4u;
+
+    if (count == 0u) {
+      return;
+    }
+    const uint64_t workers = std::max(2u, std::thread::hardware_concurrency());
+    if (count < MINIMUM_PARALLEL_COUNT) {
+      for (uint64_t i = 0u; i < count; ++i) {
+        function(i);
+      }
+      return;
+    }
+
+    auto &executor = GetStageExecutor();
+    const uint64_t chunk_count = std::min(count, workers * CHUNKS_PER_WORKER);
+    const uint64_t chunk_size = (count + chunk_count - 1u) / chunk_count;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunk_count);
+    for (uint64_t begin = chunk_size; begin < count; begin += chunk_size) {
+      const uint64_t end = std::min(begin + chunk_size, count);
+      futures.emplace_back(executor.Post([&function, begin, end]() {
+        for (uint64_t i = begin; i < end; ++i) {
+          function(i);
+        }
+      }));
+    }
+    // The calling stage thread takes the first chunk instead of idling.
+    for (uint64_t i = 0u; i < std::min(chunk_size, count); ++i) {
+      function(i);
+    }
+    for (auto &future : futures) {
+      future.get();
+    }
+  }
+
+  /// Thread-safe stand-in for the `rand() % 101` dice rolls scattered over
+  /// the stages; rand() shares hidden state between threads.
+  static inline int RollPercentageDice() {
+    thread_local std::mt19937 generator{std::random_device{}()};
+    thread_local std::uniform_int_distribution<int> distribution{0, 100};
+    return distribution(generator);
+  }
+
+  /// Identifiers separating the independent random streams a single actor
+  /// draws from within one frame in deterministic mode.
+  enum DiceStream : uint64_t {
+    DICE_STREAM_KEEP_RIGHT = 1u,
+    DICE_STREAM_PATH_EXTENSION = 2u,
+    DICE_STREAM_JUNCTION_EXIT_SEARCH = 3u,
+    DICE_STREAM_JUNCTION_SAFE_DISTANCE = 4u,
+    DICE_STREAM_RUN_TRAFFIC_LIGHT = 5u,
+    DICE_STREAM_RUN_TRAFFIC_SIGN = 6u,
+    DICE_STREAM_IGNORE_VEHICLES = 7u,
+    DICE_STREAM_IGNORE_WALKERS = 8u
+  };
+
+  /// Counter-based dice roll for the deterministic mode. The result is a
+  /// pure function of its inputs, mixed with the splitmix64 finalizer, so
+  /// a draw identified by (seed, actor, frame, stream, draw) is bitwise
+  /// identical on every run regardless of thread scheduling or iteration
+  /// order of the per-actor loops.
+  static inline int RollDeterministicDice(const uint64_t seed, const uint64_t actor_id,
+                                          const uint64_t frame, const uint64_t stream,
+                                          const uint64_t draw = 0u) {
+
+    auto mix_bits = [](uint64_t value) {
+      value ^= value >> 30u;
+      value *= 0xBF58476D1CE4E5B9u;
+      value ^= value >> 27u;
+      value *= 0x94D049BB133111EBu;
+      value ^= value >> 31u;
+      return value;
+    };
+    uint64_t hash = mix_bits(seed ^ mix_bits(actor_id));
+    hash = mix_bits(hash ^ frame);
+    hash = mix_bits(hash ^ stream);
+    hash = mix_bits(hash ^ draw);
+    return static_cast<int>(hash % 101u);
+  }
+
+} // namespace traffic_manager
+} // namespace carla
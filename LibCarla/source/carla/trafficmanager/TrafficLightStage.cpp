@@ -8,6 +8,8 @@
 
 #include "carla/trafficmanager/TrafficLightStage.h"
 
+#include "carla/trafficmanager/StageParallelism.h"
+
 namespace carla {
 namespace traffic_manager {
 
@@ -42,13 +44,28 @@ namespace traffic_manager {
     // Selecting the output frame based on the selection key.
     const auto current_planner_frame = frame_selector ? planner_frame_a : planner_frame_b;
 
-    // Looping over registered actors.
-    for (uint64_t i = 0u; i < number_of_vehicles && localization_frame != nullptr; ++i) {
+    if (localization_frame == nullptr) {
+      return;
+    }
+
+    ++dice_frame_counter;
+
+    // Looping over registered actors; vehicles are independent given the
+    // frame snapshot, the junction negotiation bookkeeping has its own
+    // mutex, so the loop is partitioned over the stage workers.
+    ParallelForEachIndex(number_of_vehicles, [&](uint64_t i) {
 
       bool traffic_light_hazard = false;
       const LocalizationToTrafficLightData &data = localization_frame->at(i);
       if (!data.actor->IsAlive()) {
-        continue;
+        return;
+      }
+
+      // Reduced-rate LOD hold; the planner ignores this slot, so no
+      // signal evaluation is needed for the vehicle this frame.
+      if (data.lod_hold) {
+        current_planner_frame->at(i).traffic_light_hazard = false;
+        return;
       }
 
       const Actor ego_actor = data.actor;
@@ -56,17 +73,24 @@ namespace traffic_manager {
       const SimpleWaypointPtr closest_waypoint = data.closest_waypoint;
       const SimpleWaypointPtr look_ahead_point = data.junction_look_ahead_waypoint;
 
-      const JunctionID junction_id = look_ahead_point->GetWaypoint()->GetJunctionId();
+      const JunctionID junction_id = look_ahead_point->GetJunctionId();
       const TimeInstance current_time = chr::system_clock::now();
 
       const auto ego_vehicle = boost::static_pointer_cast<cc::Vehicle>(ego_actor);
       TLS traffic_light_state = ego_vehicle->GetTrafficLightState();
 
+      const int running_light_dice = deterministic_mode
+          ? RollDeterministicDice(random_seed, ego_actor_id, dice_frame_counter, DICE_STREAM_RUN_TRAFFIC_LIGHT)
+          : RollPercentageDice();
+      const int running_sign_dice = deterministic_mode
+          ? RollDeterministicDice(random_seed, ego_actor_id, dice_frame_counter, DICE_STREAM_RUN_TRAFFIC_SIGN)
+          : RollPercentageDice();
+
       // We determine to stop if the current position of the vehicle is not a
       // junction and there is a red or yellow light.
       if (ego_vehicle->IsAtTrafficLight() &&
           traffic_light_state != TLS::Green &&
-          parameters.GetPercentageRunningLight(boost::shared_ptr<cc::Actor>(ego_actor)) <= (rand() % 101)) {
+          parameters.GetPercentageRunningLight(boost::shared_ptr<cc::Actor>(ego_actor)) <= running_light_dice) {
 
         traffic_light_hazard = true;
       }
@@ -75,7 +99,7 @@ namespace traffic_manager {
       else if (look_ahead_point->CheckJunction() &&
                !ego_vehicle->IsAtTrafficLight() &&
                traffic_light_state != TLS::Green &&
-               parameters.GetPercentageRunningSign(boost::shared_ptr<cc::Actor>(ego_actor)) <= (rand() % 101)) {
+               parameters.GetPercentageRunningSign(boost::shared_ptr<cc::Actor>(ego_actor)) <= running_sign_dice) {
 
         std::lock_guard<std::mutex> lock(no_signal_negotiation_mutex);
 
@@ -137,13 +161,16 @@ namespace traffic_manager {
 
       TrafficLightToPlannerData &message = current_planner_frame->at(i);
       message.traffic_light_hazard = traffic_light_hazard;
-    }
+    });
   }
 
   void TrafficLightStage::DataReceiver() {
 
     localization_frame = localization_messenger->Peek();
 
+    deterministic_mode = parameters.GetDeterministicMode();
+    random_seed = parameters.GetRandomSeed();
+
     // Allocating new containers for the changed number of registered vehicles.
     if (localization_frame != nullptr && number_of_vehicles != (*localization_frame.get()).size()) {
 
@@ -68,6 +68,12 @@ namespace traffic_manager {
     std::mutex no_signal_negotiation_mutex;
     /// Number of vehicles registered with the traffic manager.
     uint64_t number_of_vehicles;
+    /// Switch indicating deterministic mode.
+    bool deterministic_mode {false};
+    /// Seed for the per-actor random streams in deterministic mode.
+    uint64_t random_seed {0u};
+    /// Frame counter advancing the per-actor random streams.
+    uint64_t dice_frame_counter {0u};
 
 
     void DrawLight(TLS traffic_light_state, const Actor &ego_actor) const;
@@ -70,6 +70,58 @@ public:
     }
   }
 
+  /// This method switches distance-based LOD scheduling on/off.
+  void SetDistanceLODMode(const bool mode_switch) {
+    TrafficManagerBase* tm_ptr = GetTM(_port);
+    if(tm_ptr != nullptr){
+      tm_ptr->SetDistanceLODMode(mode_switch);
+    }
+  }
+
+  /// This method sets the distance LOD radius.
+  void SetDistanceLODRadius(const float radius) {
+    TrafficManagerBase* tm_ptr = GetTM(_port);
+    if(tm_ptr != nullptr){
+      tm_ptr->SetDistanceLODRadius(radius);
+    }
+  }
+
+  /// This method switches deterministic mode on/off, seeding the per-actor
+  /// random streams.
+  void SetDeterministicMode(const bool mode_switch, const uint64_t seed) {
+    TrafficManagerBase* tm_ptr = GetTM(_port);
+    if(tm_ptr != nullptr){
+      tm_ptr->SetDeterministicMode(mode_switch, seed);
+    }
+  }
+
+  /// This method enables/disables buffering of per-actor parameter
+  /// changes for remote traffic managers; disabling also flushes.
+  void SetParameterBatching(const bool mode_switch) {
+    TrafficManagerBase* tm_ptr = GetTM(_port);
+    if(tm_ptr != nullptr){
+      tm_ptr->SetParameterBatching(mode_switch);
+    }
+  }
+
+  /// This method applies all buffered per-actor parameter changes in one
+  /// batch.
+  void FlushParameterBuffer() {
+    TrafficManagerBase* tm_ptr = GetTM(_port);
+    if(tm_ptr != nullptr){
+      tm_ptr->FlushParameterBuffer();
+    }
+  }
+
+  /// This method retrieves per-stage timing statistics, one line per stage.
+  std::string GetStageTimingProfile() {
+    TrafficManagerBase* tm_ptr = GetTM(_port);
+    if(tm_ptr != nullptr){
+      return tm_ptr->GetStageTimingProfile();
+    }
+    return std::string();
+  }
+
   /// This method registers a vehicle with the traffic manager.
   void RegisterVehicles(const std::vector<ActorPtr> &actor_list) {
     TrafficManagerBase* tm_ptr = GetTM(_port);
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+
 #include "carla/client/Actor.h"
 
 #define MIN_TRY_COUNT       20
@@ -107,6 +109,27 @@ public:
   /// Method to set hybrid physics radius.
   virtual void SetHybridPhysicsRadius(const float radius) = 0;
 
+  /// Method to switch distance-based LOD scheduling on/off.
+  virtual void SetDistanceLODMode(const bool mode_switch) = 0;
+
+  /// Method to set distance LOD radius.
+  virtual void SetDistanceLODRadius(const float radius) = 0;
+
+  /// Method to switch deterministic mode on/off, seeding the per-actor
+  /// random streams.
+  virtual void SetDeterministicMode(const bool mode_switch, const uint64_t seed) = 0;
+
+  /// Method to enable/disable buffering of per-actor parameter changes so
+  /// they can travel to a remote traffic manager in one batch; disabling
+  /// also flushes pending changes.
+  virtual void SetParameterBatching(const bool mode_switch) = 0;
+
+  /// Method to apply all buffered per-actor parameter changes in one batch.
+  virtual void FlushParameterBuffer() = 0;
+
+  /// Method to retrieve per-stage timing statistics, one line per stage.
+  virtual std::string GetStageTimingProfile() = 0;
+
 protected:
 
 };
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/client/Actor.h"
+#include "carla/trafficmanager/ParameterBatch.h"
 #include <rpc/client.h>
 
 #define TM_TIMEOUT        2000 // In ms
@@ -191,6 +192,38 @@ public:
     _client->call("set_hybrid_physics_radius", radius);
   }
 
+  /// Method to switch distance-based LOD scheduling on/off.
+  void SetDistanceLODMode(const bool mode_switch) {
+    DEBUG_ASSERT(_client != nullptr);
+    _client->call("set_distance_lod_mode", mode_switch);
+  }
+
+  /// Method to set distance LOD radius.
+  void SetDistanceLODRadius(const float radius) {
+    DEBUG_ASSERT(_client != nullptr);
+    _client->call("set_distance_lod_radius", radius);
+  }
+
+  /// Method to apply a batch of buffered per-actor parameter changes in
+  /// a single call.
+  void ApplyParameterBatch(const std::vector<ParameterSetting> &batch) {
+    DEBUG_ASSERT(_client != nullptr);
+    _client->call("apply_parameter_batch", batch);
+  }
+
+  /// Method to switch deterministic mode on/off, seeding the per-actor
+  /// random streams.
+  void SetDeterministicMode(const bool mode_switch, const uint64_t seed) {
+    DEBUG_ASSERT(_client != nullptr);
+    _client->call("set_deterministic_mode", mode_switch, seed);
+  }
+
+  /// Method to retrieve per-stage timing statistics, one line per stage.
+  std::string GetStageTimingProfile() {
+    DEBUG_ASSERT(_client != nullptr);
+    return _client->call("get_stage_timing_profile").as<std::string>();
+  }
+
 private:
 
   /// RPC client.
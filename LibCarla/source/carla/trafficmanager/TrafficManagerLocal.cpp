@@ -4,6 +4,8 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <sstream>
+
 #include "carla/trafficmanager/TrafficManagerLocal.h"
 
 namespace carla {
@@ -86,6 +88,11 @@ void TrafficManagerLocal::Start() {
     episodeProxyTM,
     parameters);
 
+  // Re-attach the direct command sink across episode resets.
+  if (direct_command_sink) {
+    control_stage->SetCommandSink(direct_command_sink);
+  }
+
   localization_collision_messenger->Start();
   localization_traffic_light_messenger->Start();
   localization_planner_messenger->Start();
@@ -205,6 +212,58 @@ void TrafficManagerLocal::SetHybridPhysicsRadius(const float radius) {
   parameters.SetHybridPhysicsRadius(radius);
 }
 
+void TrafficManagerLocal::SetDistanceLODMode(const bool mode_switch) {
+  parameters.SetDistanceLODMode(mode_switch);
+}
+
+void TrafficManagerLocal::SetDistanceLODRadius(const float radius) {
+  parameters.SetDistanceLODRadius(radius);
+}
+
+void TrafficManagerLocal::SetDeterministicMode(const bool mode_switch, const uint64_t seed) {
+  parameters.SetDeterministicMode(mode_switch, seed);
+}
+
+void TrafficManagerLocal::SetParameterBatching(const bool /*mode_switch*/) {}
+
+void TrafficManagerLocal::FlushParameterBuffer() {}
+
+void TrafficManagerLocal::SetDirectCommandSink(CommandSink sink) {
+  direct_command_sink = std::move(sink);
+  if (control_stage != nullptr) {
+    control_stage->SetCommandSink(direct_command_sink);
+  }
+}
+
+std::string TrafficManagerLocal::GetStageTimingProfile() {
+
+  const uint64_t number_of_vehicles = static_cast<uint64_t>(registered_actors.Size());
+  std::ostringstream profile;
+
+  auto append_stage_stats = [&](const PipelineStage *stage) {
+    if (stage == nullptr) {
+      return;
+    }
+    const StageTimingStats stats = stage->GetTimingStats();
+    profile << "Stage: " << stats.stage_name
+            << ", updates/sec: " << stats.updates_per_second
+            << ", actors/sec: " << stats.updates_per_second * number_of_vehicles
+            << ", p50: " << stats.p50_milliseconds << " ms"
+            << ", p95: " << stats.p95_milliseconds << " ms"
+            << ", p99: " << stats.p99_milliseconds << " ms"
+            << ", samples: " << stats.sample_count
+            << std::endl;
+  };
+
+  append_stage_stats(localization_stage.get());
+  append_stage_stats(collision_stage.get());
+  append_stage_stats(traffic_light_stage.get());
+  append_stage_stats(planner_stage.get());
+  append_stage_stats(control_stage.get());
+
+  return profile.str();
+}
+
 bool TrafficManagerLocal::CheckAllFrozen(TLGroup tl_to_freeze) {
   for (auto& elem : tl_to_freeze) {
     if (!elem->IsFrozen() || elem->GetState() != TLS::Red) {
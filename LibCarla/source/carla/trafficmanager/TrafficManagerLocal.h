@@ -71,6 +71,10 @@ namespace traffic_manager {
     /// Parameterization object.
     Parameters parameters;
 
+    /// Direct in-process consumer for the per-frame control batch,
+    /// re-attached to the control stage across episode resets.
+    CommandSink direct_command_sink;
+
     /// Traffic manager server instance.
     TrafficManagerServer server;
 
@@ -175,6 +179,35 @@ namespace traffic_manager {
     /// Method to set hybrid physics radius.
     void SetHybridPhysicsRadius(const float radius);
 
+    /// Method to switch distance-based LOD scheduling on/off.
+    void SetDistanceLODMode(const bool mode_switch);
+
+    /// Method to set distance LOD radius.
+    void SetDistanceLODRadius(const float radius);
+
+    /// Method to switch deterministic mode on/off, seeding the per-actor
+    /// random streams.
+    void SetDeterministicMode(const bool mode_switch, const uint64_t seed);
+
+    /// Method to enable/disable buffering of per-actor parameter changes.
+    /// Local parameter changes apply in-process without round trips, so
+    /// this is a no-op.
+    void SetParameterBatching(const bool mode_switch);
+
+    /// Method to apply all buffered per-actor parameter changes; a no-op
+    /// for the same reason.
+    void FlushParameterBuffer();
+
+    /// Method to install a direct in-process consumer for the per-frame
+    /// control batch. When the simulator is co-located with the traffic
+    /// manager, the sink receives each batch by reference, bypassing
+    /// msgpack serialization and the RPC socket. Passing an empty sink
+    /// restores submission through the RPC client.
+    void SetDirectCommandSink(CommandSink sink);
+
+    /// Method to retrieve per-stage timing statistics, one line per stage.
+    std::string GetStageTimingProfile();
+
   };
 
 } // namespace traffic_manager
@@ -26,6 +26,11 @@ TrafficManagerRemote::TrafficManagerRemote(
 
 /// Destructor.
 TrafficManagerRemote::~TrafficManagerRemote() {
+  try {
+    FlushParameterBuffer();
+  } catch (...) {
+    /// Best effort; the server may already be gone.
+  }
   Release();
 }
 
@@ -109,6 +114,9 @@ void TrafficManagerRemote::UnregisterVehicles(const std::vector<ActorPtr> &_acto
 void TrafficManagerRemote::SetPercentageSpeedDifference(const ActorPtr &_actor, const float percentage) {
   carla::rpc::Actor actor(_actor->Serialize());
 
+  if (BufferParameterChange(actor, VehicleParameter::PercentageSpeedDifference, percentage)) {
+    return;
+  }
   client.SetPercentageSpeedDifference(actor, percentage);
 }
 
@@ -126,18 +134,27 @@ void TrafficManagerRemote::SetCollisionDetection(const ActorPtr &_reference_acto
 void TrafficManagerRemote::SetForceLaneChange(const ActorPtr &_actor, const bool direction) {
   carla::rpc::Actor actor(_actor->Serialize());
 
+  if (BufferParameterChange(actor, VehicleParameter::ForceLaneChange, direction ? 1.0f : 0.0f)) {
+    return;
+  }
   client.SetForceLaneChange(actor, direction);
 }
 
 void TrafficManagerRemote::SetAutoLaneChange(const ActorPtr &_actor, const bool enable) {
   carla::rpc::Actor actor(_actor->Serialize());
 
+  if (BufferParameterChange(actor, VehicleParameter::AutoLaneChange, enable ? 1.0f : 0.0f)) {
+    return;
+  }
   client.SetAutoLaneChange(actor, enable);
 }
 
 void TrafficManagerRemote::SetDistanceToLeadingVehicle(const ActorPtr &_actor, const float distance) {
   carla::rpc::Actor actor(_actor->Serialize());
 
+  if (BufferParameterChange(actor, VehicleParameter::DistanceToLeadingVehicle, distance)) {
+    return;
+  }
   client.SetDistanceToLeadingVehicle(actor, distance);
 }
 
@@ -149,30 +166,45 @@ void TrafficManagerRemote::SetGlobalDistanceToLeadingVehicle(const float distanc
 void TrafficManagerRemote::SetPercentageIgnoreWalkers(const ActorPtr &_actor, const float percentage) {
   carla::rpc::Actor actor(_actor->Serialize());
 
+  if (BufferParameterChange(actor, VehicleParameter::PercentageIgnoreWalkers, percentage)) {
+    return;
+  }
   client.SetPercentageIgnoreWalkers(actor, percentage);
 }
 
 void TrafficManagerRemote::SetPercentageIgnoreVehicles(const ActorPtr &_actor, const float percentage) {
   carla::rpc::Actor actor(_actor->Serialize());
 
+  if (BufferParameterChange(actor, VehicleParameter::PercentageIgnoreVehicles, percentage)) {
+    return;
+  }
   client.SetPercentageIgnoreVehicles(actor, percentage);
 }
 
 void TrafficManagerRemote::SetPercentageRunningLight(const ActorPtr &_actor, const float percentage) {
   carla::rpc::Actor actor(_actor->Serialize());
 
+  if (BufferParameterChange(actor, VehicleParameter::PercentageRunningLight, percentage)) {
+    return;
+  }
   client.SetPercentageRunningLight(actor, percentage);
 }
 
 void TrafficManagerRemote::SetPercentageRunningSign(const ActorPtr &_actor, const float percentage) {
   carla::rpc::Actor actor(_actor->Serialize());
 
+  if (BufferParameterChange(actor, VehicleParameter::PercentageRunningSign, percentage)) {
+    return;
+  }
   client.SetPercentageRunningSign(actor, percentage);
 }
 
 void TrafficManagerRemote::SetKeepRightPercentage(const ActorPtr &_actor, const float percentage) {
   carla::rpc::Actor actor(_actor->Serialize());
 
+  if (BufferParameterChange(actor, VehicleParameter::KeepRightPercentage, percentage)) {
+    return;
+  }
   client.SetKeepRightPercentage(actor, percentage);
 }
 
@@ -184,6 +216,52 @@ void TrafficManagerRemote::SetHybridPhysicsRadius(const float radius) {
   client.SetHybridPhysicsRadius(radius);
 }
 
+void TrafficManagerRemote::SetDistanceLODMode(const bool mode_switch) {
+  client.SetDistanceLODMode(mode_switch);
+}
+
+void TrafficManagerRemote::SetDistanceLODRadius(const float radius) {
+  client.SetDistanceLODRadius(radius);
+}
+
+void TrafficManagerRemote::SetDeterministicMode(const bool mode_switch, const uint64_t seed) {
+  client.SetDeterministicMode(mode_switch, seed);
+}
+
+bool TrafficManagerRemote::BufferParameterChange(const carla::rpc::Actor &actor, const VehicleParameter parameter, const float value) {
+  std::lock_guard<std::mutex> lock(parameter_buffer_mutex);
+  if (!parameter_batching) {
+    return false;
+  }
+  parameter_buffer.push_back({actor, static_cast<uint8_t>(parameter), value});
+  return true;
+}
+
+void TrafficManagerRemote::SetParameterBatching(const bool mode_switch) {
+  {
+    std::lock_guard<std::mutex> lock(parameter_buffer_mutex);
+    parameter_batching = mode_switch;
+  }
+  if (!mode_switch) {
+    FlushParameterBuffer();
+  }
+}
+
+void TrafficManagerRemote::FlushParameterBuffer() {
+  std::vector<ParameterSetting> batch;
+  {
+    std::lock_guard<std::mutex> lock(parameter_buffer_mutex);
+    batch.swap(parameter_buffer);
+  }
+  if (!batch.empty()) {
+    client.ApplyParameterBatch(batch);
+  }
+}
+
+std::string TrafficManagerRemote::GetStageTimingProfile() {
+  return client.GetStageTimingProfile();
+}
+
 void TrafficManagerRemote::ResetAllTrafficLights() {
   client.ResetAllTrafficLights();
 }
@@ -14,6 +14,7 @@
 #include "carla/client/Actor.h"
 #include "carla/client/detail/Simulator.h"
 #include "carla/client/detail/EpisodeProxy.h"
+#include "carla/trafficmanager/ParameterBatch.h"
 #include "carla/trafficmanager/TrafficManagerBase.h"
 #include "carla/trafficmanager/TrafficManagerClient.h"
 
@@ -106,6 +107,28 @@ public:
   /// Method to set hybrid physics radius.
   void SetHybridPhysicsRadius(const float radius);
 
+  /// Method to switch distance-based LOD scheduling on/off.
+  void SetDistanceLODMode(const bool mode_switch);
+
+  /// Method to set distance LOD radius.
+  void SetDistanceLODRadius(const float radius);
+
+  /// Method to switch deterministic mode on/off, seeding the per-actor
+  /// random streams.
+  void SetDeterministicMode(const bool mode_switch, const uint64_t seed);
+
+  /// Method to enable/disable buffering of per-actor parameter changes.
+  /// While enabled, eligible changes accumulate client-side instead of
+  /// making one RPC round trip each; disabling also flushes.
+  void SetParameterBatching(const bool mode_switch);
+
+  /// Method to send all buffered per-actor parameter changes to the
+  /// remote traffic manager in a single batched RPC.
+  void FlushParameterBuffer();
+
+  /// Method to retrieve per-stage timing statistics, one line per stage.
+  std::string GetStageTimingProfile();
+
   /// Method to provide synchronous tick
   bool SynchronousTick();
 
@@ -120,10 +143,23 @@ public:
 
 private:
 
+  /// Buffers a per-actor parameter change when batching is enabled.
+  /// Returns true if the change was buffered.
+  bool BufferParameterChange(const carla::rpc::Actor &actor, const VehicleParameter parameter, const float value);
+
   /// Remote client using the IP and port information it connects to
   /// as remote RPC traffic manager server.
   TrafficManagerClient client;
 
+  /// Flag enabling client-side buffering of per-actor parameter changes.
+  bool parameter_batching = false;
+
+  /// Buffered per-actor parameter changes awaiting a flush.
+  std::vector<ParameterSetting> parameter_buffer;
+
+  /// Mutex guarding the parameter buffer.
+  std::mutex parameter_buffer_mutex;
+
   /// CARLA client connection object.
   carla::client::detail::EpisodeProxy episodeProxyTM;
 
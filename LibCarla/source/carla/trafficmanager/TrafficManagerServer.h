@@ -12,6 +12,7 @@
 #include "carla/client/Actor.h"
 #include "carla/client/detail/ActorVariant.h"
 #include "carla/rpc/Server.h"
+#include "carla/trafficmanager/ParameterBatch.h"
 #include "carla/trafficmanager/TrafficManagerBase.h"
 
 namespace carla {
@@ -160,6 +161,66 @@ public:
         tm->SetHybridPhysicsRadius(radius);
       });
 
+      /// Method to switch distance-based LOD scheduling on/off.
+      server->bind("set_distance_lod_mode", [=](const bool mode_switch) {
+        tm->SetDistanceLODMode(mode_switch);
+      });
+
+      /// Method to set distance LOD radius.
+      server->bind("set_distance_lod_radius", [=](const float radius) {
+        tm->SetDistanceLODRadius(radius);
+      });
+
+      /// Method to apply a batch of per-actor parameter changes in a
+      /// single call, saving one round trip per change.
+      server->bind("apply_parameter_batch", [=](const std::vector<ParameterSetting> &batch) {
+        for (const ParameterSetting &setting : batch) {
+          const auto actor = carla::client::detail::ActorVariant(setting.actor).Get(tm->GetEpisodeProxy());
+          switch (static_cast<VehicleParameter>(setting.parameter)) {
+            case VehicleParameter::PercentageSpeedDifference:
+              tm->SetPercentageSpeedDifference(actor, setting.value);
+              break;
+            case VehicleParameter::DistanceToLeadingVehicle:
+              tm->SetDistanceToLeadingVehicle(actor, setting.value);
+              break;
+            case VehicleParameter::PercentageIgnoreWalkers:
+              tm->SetPercentageIgnoreWalkers(actor, setting.value);
+              break;
+            case VehicleParameter::PercentageIgnoreVehicles:
+              tm->SetPercentageIgnoreVehicles(actor, setting.value);
+              break;
+            case VehicleParameter::PercentageRunningLight:
+              tm->SetPercentageRunningLight(actor, setting.value);
+              break;
+            case VehicleParameter::PercentageRunningSign:
+              tm->SetPercentageRunningSign(actor, setting.value);
+              break;
+            case VehicleParameter::KeepRightPercentage:
+              tm->SetKeepRightPercentage(actor, setting.value);
+              break;
+            case VehicleParameter::AutoLaneChange:
+              tm->SetAutoLaneChange(actor, setting.value != 0.0f);
+              break;
+            case VehicleParameter::ForceLaneChange:
+              tm->SetForceLaneChange(actor, setting.value != 0.0f);
+              break;
+            default:
+              break;
+          }
+        }
+      });
+
+      /// Method to switch deterministic mode on/off, seeding the per-actor
+      /// random streams.
+      server->bind("set_deterministic_mode", [=](const bool mode_switch, const uint64_t seed) {
+        tm->SetDeterministicMode(mode_switch, seed);
+      });
+
+      /// Method to retrieve per-stage timing statistics, one line per stage.
+      server->bind("get_stage_timing_profile", [=]() -> std::string {
+        return tm->GetStageTimingProfile();
+      });
+
       /// Method to set synchronous mode.
       server->bind("set_synchronous_mode", [=](const bool mode) {
         tm->SetSynchronousMode(mode);
@@ -0,0 +1,62 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/trafficmanager/WaypointBuffer.h"
+
+namespace carla {
+namespace traffic_manager {
+
+namespace WaypointBufferConstants {
+  /// Ring capacity per vehicle. The buffer spans at most the maximum
+  /// horizon (60 m) over the dense topology sampled at 0.1 m, around
+  /// 600 waypoints; rounded up to a power of two with headroom for the
+  /// post-junction extension so the index wrap stays a bit mask.
+  static const uint64_t BUFFER_CAPACITY = 1024u;
+} // namespace WaypointBufferConstants
+
+  using namespace WaypointBufferConstants;
+
+  WaypointBuffer::WaypointBuffer() {
+    ring.resize(BUFFER_CAPACITY);
+  }
+
+  void WaypointBuffer::Grow() {
+    std::vector<SimpleWaypointPtr> larger_ring(ring.size() * 2u);
+    for (uint64_t i = 0u; i < element_count; ++i) {
+      larger_ring[i] = ring[SlotIndex(i)];
+    }
+    ring.swap(larger_ring);
+    head = 0u;
+  }
+
+  void WaypointBuffer::push_back(const SimpleWaypointPtr &waypoint) {
+    if (element_count == ring.size()) {
+      Grow();
+    }
+    ring[SlotIndex(element_count)] = waypoint;
+    ++element_count;
+  }
+
+  void WaypointBuffer::pop_front() {
+    ring[head] = nullptr;
+    head = (head + 1u) & (ring.size() - 1u);
+    --element_count;
+  }
+
+  void WaypointBuffer::pop_back() {
+    --element_count;
+    ring[SlotIndex(element_count)] = nullptr;
+  }
+
+  void WaypointBuffer::clear() {
+    while (element_count > 0u) {
+      pop_back();
+    }
+    head = 0u;
+  }
+
+} // namespace traffic_manager
+} // namespace carla
@@ -0,0 +1,96 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "carla/trafficmanager/SimpleWaypoint.h"
+
+namespace carla {
+namespace traffic_manager {
+
+  /// This class implements the per-vehicle waypoint buffer used by the
+  /// localization stage as a fixed-capacity ring over one contiguous
+  /// allocation. The std::deque it replaces allocated and freed chunks
+  /// continuously as the horizon was extended at the back and consumed
+  /// at the front; the ring is sized once from the horizon parameters
+  /// and reuses its slots for the lifetime of the vehicle.
+  /// It exposes the std::deque subset the stages actually use, so the
+  /// Buffer alias can point here without touching the call sites.
+  class WaypointBuffer {
+
+  private:
+
+    using SimpleWaypointPtr = std::shared_ptr<SimpleWaypoint>;
+
+    /// Contiguous ring storage, sized once at construction.
+    std::vector<SimpleWaypointPtr> ring;
+    /// Position of the front element inside the ring.
+    uint64_t head = 0u;
+    /// Number of live elements.
+    uint64_t element_count = 0u;
+
+    /// Maps a logical index (0 = front) to a ring slot. The capacity is
+    /// kept a power of two so this is a mask instead of a division.
+    uint64_t SlotIndex(const uint64_t index) const {
+      return (head + index) & (ring.size() - 1u);
+    }
+
+    /// Doubles the ring capacity, re-linearising the live elements.
+    /// Only hit when a junction exit extends the buffer well beyond
+    /// the horizon the capacity was sized for.
+    void Grow();
+
+  public:
+
+    WaypointBuffer();
+
+    bool empty() const {
+      return element_count == 0u;
+    }
+
+    uint64_t size() const {
+      return element_count;
+    }
+
+    SimpleWaypointPtr &front() {
+      return ring[head];
+    }
+
+    const SimpleWaypointPtr &front() const {
+      return ring[head];
+    }
+
+    SimpleWaypointPtr &back() {
+      return ring[SlotIndex(element_count - 1u)];
+    }
+
+    const SimpleWaypointPtr &back() const {
+      return ring[SlotIndex(element_count - 1u)];
+    }
+
+    SimpleWaypointPtr &at(const uint64_t index) {
+      return ring[SlotIndex(index)];
+    }
+
+    const SimpleWaypointPtr &at(const uint64_t index) const {
+      return ring[SlotIndex(index)];
+    }
+
+    void push_back(const SimpleWaypointPtr &waypoint);
+
+    void pop_front();
+
+    void pop_back();
+
+    void clear();
+  };
+
+} // namespace traffic_manager
+} // namespace carla
@@ -0,0 +1,114 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <carla/StopWatch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace util {
+
+  /// Keep @a value (and anything it depends on) observable so the optimizer
+  /// cannot delete the computation being measured.
+  template <typename T>
+  inline void DoNotOptimize(const T &value) {
+#ifdef _MSC_VER
+    volatile const T *sink = &value;
+    (void) sink;
+#else
+    asm volatile("" : : "g"(&value) : "memory");
+#endif
+  }
+
+  /// Runs a callable in a timed loop and reports nanoseconds per iteration.
+  ///
+  /// The iteration count is calibrated at run time so each measurement lasts
+  /// at least ~200 milliseconds, long enough to hide timer granularity and
+  /// frequency scaling ramp-up. Results are printed to stdout, and when the
+  /// LIBCARLA_BENCHMARK_JSON environment variable names a file, one JSON
+  /// object per result is appended to it (one object per line) so successive
+  /// runs can be compared for trends.
+  class Microbenchmark {
+  public:
+
+    /// Measure @a func, reporting under @a name. @a items_per_iteration
+    /// scales the derived throughput figure, e.g. the number of points
+    /// processed per call.
+    template <typename FuncT>
+    static void Run(
+        const std::string &name,
+        FuncT &&func,
+        const double items_per_iteration = 1.0) {
+      // One untimed call to warm caches and flush lazy initialization.
+      func();
+      uint64_t iterations = 1u;
+      double elapsed_ns = 0.0;
+      for (;;) {
+        carla::StopWatch timer;
+        for (uint64_t i = 0u; i < iterations; ++i) {
+          func();
+        }
+        timer.Stop();
+        elapsed_ns = static_cast<double>(
+            timer.GetElapsedTime<std::chrono::nanoseconds>());
+        if ((elapsed_ns >= MIN_RUN_TIME_NS) || (iterations >= MAX_ITERATIONS)) {
+          break;
+        }
+        // Scale towards the target run time, at least doubling each round.
+        auto next = iterations * 2u;
+        if (elapsed_ns > 0.0) {
+          const auto predicted = static_cast<uint64_t>(
+              1.4 * MIN_RUN_TIME_NS * static_cast<double>(iterations) / elapsed_ns);
+          next = std::max(next, predicted);
+        }
+        iterations = std::min(next, MAX_ITERATIONS);
+      }
+      const double ns_per_op = elapsed_ns / static_cast<double>(iterations);
+      Report(name, iterations, ns_per_op, items_per_iteration);
+    }
+
+  private:
+
+    static constexpr double MIN_RUN_TIME_NS = 2e8;
+
+    static constexpr uint64_t MAX_ITERATIONS = 1u << 30u;
+
+    static void Report(
+        const std::string &name,
+        const uint64_t iterations,
+        const double ns_per_op,
+        const double items_per_iteration) {
+      const double items_per_second =
+          (ns_per_op > 0.0) ? (items_per_iteration * 1e9 / ns_per_op) : 0.0;
+      std::cout << std::fixed
+          << "  " << std::left << std::setw(44) << name << std::right
+          << std::setprecision(1) << std::setw(14) << ns_per_op << " ns/op"
+          << std::setprecision(0) << std::setw(16) << items_per_second << " items/s"
+          << "   (" << iterations << " iterations)"
+          << std::endl;
+      const char *path = std::getenv("LIBCARLA_BENCHMARK_JSON");
+      if (path != nullptr) {
+        std::ofstream out(path, std::ios::app);
+        out << std::fixed << std::setprecision(3)
+            << "{\"name\":\"" << name << "\""
+            << ",\"iterations\":" << iterations
+            << ",\"ns_per_op\":" << ns_per_op
+            << ",\"items_per_second\":" << std::setprecision(1) << items_per_second
+            << "}\n";
+      }
+    }
+  };
+
+} // namespace util
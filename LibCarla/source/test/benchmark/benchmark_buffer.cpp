@@ -0,0 +1,67 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "Microbenchmark.h"
+
+#include <carla/Buffer.h>
+#include <carla/BufferPool.h>
+
+#include <memory>
+#include <vector>
+
+using namespace carla;
+
+TEST(benchmark_buffer, copy_and_growth) {
+  const std::vector<unsigned char> payload(1u << 20u, 42u);
+
+  // Steady-state sensor path: same-sized payload into a retained buffer,
+  // no allocation after the first iteration.
+  {
+    Buffer buffer;
+    util::Microbenchmark::Run("buffer.copy_from_1mb_reused", [&]() {
+      buffer.copy_from(payload);
+      util::DoNotOptimize(buffer.data());
+    }, static_cast<double>(payload.size()));
+  }
+
+  // Worst case: every payload lands in a cold buffer, paying allocation
+  // plus copy each time.
+  util::Microbenchmark::Run("buffer.copy_from_1mb_cold", [&]() {
+    Buffer buffer;
+    buffer.copy_from(payload);
+    util::DoNotOptimize(buffer.data());
+  }, static_cast<double>(payload.size()));
+
+  // Growth pattern of a buffer fed increasing sizes, as when a sensor's
+  // output grows frame over frame.
+  util::Microbenchmark::Run("buffer.growth_1kb_to_1mb", [&]() {
+    Buffer buffer;
+    for (auto size = 1024u; size <= payload.size(); size <<= 2u) {
+      buffer.copy_from(payload.data(), size);
+    }
+    util::DoNotOptimize(buffer.data());
+  });
+}
+
+TEST(benchmark_buffer, pool_round_trip) {
+  const std::vector<unsigned char> payload(1u << 20u, 42u);
+  auto pool = std::make_shared<BufferPool>();
+
+  // Prime the pool so the measured loop exercises reuse, not first
+  // allocation.
+  {
+    auto buffer = pool->Pop(payload.size());
+    buffer.copy_from(payload);
+  }
+
+  util::Microbenchmark::Run("buffer_pool.pop_copy_return_1mb", [&]() {
+    auto buffer = pool->Pop(payload.size());
+    buffer.copy_from(payload);
+    util::DoNotOptimize(buffer.data());
+    // going out of scope returns the buffer to the pool
+  }, static_cast<double>(payload.size()));
+}
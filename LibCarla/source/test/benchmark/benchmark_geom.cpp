@@ -0,0 +1,88 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "Microbenchmark.h"
+
+#include <carla/geom/Location.h>
+#include <carla/geom/Math.h>
+#include <carla/geom/Transform.h>
+
+#include <random>
+#include <vector>
+
+using namespace carla::geom;
+
+/// Deterministic batch of points spread over a town-sized volume.
+static std::vector<Location> MakePoints(const size_t count) {
+  std::mt19937 rng(42u);
+  std::uniform_real_distribution<float> dist(-500.0f, 500.0f);
+  std::vector<Location> points;
+  points.reserve(count);
+  for (auto i = 0u; i < count; ++i) {
+    points.emplace_back(dist(rng), dist(rng), dist(rng));
+  }
+  return points;
+}
+
+TEST(benchmark_geom, math_kernels) {
+  constexpr size_t BATCH = 4096u;
+  const auto points = MakePoints(BATCH + 1u);
+
+  util::Microbenchmark::Run("geom_math.distance", [&]() {
+    float acc = 0.0f;
+    for (auto i = 0u; i < BATCH; ++i) {
+      acc += Math::Distance(points[i], points[i + 1u]);
+    }
+    util::DoNotOptimize(acc);
+  }, static_cast<double>(BATCH));
+
+  util::Microbenchmark::Run("geom_math.dot", [&]() {
+    float acc = 0.0f;
+    for (auto i = 0u; i < BATCH; ++i) {
+      const auto &a = points[i];
+      const auto &b = points[i + 1u];
+      acc += Math::Dot(a, b) + Math::Dot2D(a, b);
+    }
+    util::DoNotOptimize(acc);
+  }, static_cast<double>(BATCH));
+
+  util::Microbenchmark::Run("geom_math.distance_segment_to_point", [&]() {
+    float acc = 0.0f;
+    const Vector3D v(-100.0f, -100.0f, 0.0f);
+    const Vector3D w(100.0f, 100.0f, 0.0f);
+    for (auto i = 0u; i < BATCH; ++i) {
+      acc += Math::DistanceSegmentToPoint(points[i], v, w).second;
+    }
+    util::DoNotOptimize(acc);
+  }, static_cast<double>(BATCH));
+
+  util::Microbenchmark::Run("geom_math.get_forward_vector", [&]() {
+    Vector3D acc;
+    for (auto i = 0u; i < BATCH; ++i) {
+      const auto &p = points[i];
+      acc += Math::GetForwardVector(Rotation(p.x, p.y, p.z));
+    }
+    util::DoNotOptimize(acc);
+  }, static_cast<double>(BATCH));
+}
+
+TEST(benchmark_geom, transform_point) {
+  constexpr size_t BATCH = 4096u;
+  const auto points = MakePoints(BATCH);
+  const Transform transform(
+      Location(10.0f, -5.0f, 2.0f),
+      Rotation(7.5f, 30.0f, -2.0f));
+
+  util::Microbenchmark::Run("geom_transform.transform_point", [&]() {
+    Vector3D acc;
+    for (auto point : points) {
+      transform.TransformPoint(point);
+      acc += point;
+    }
+    util::DoNotOptimize(acc);
+  }, static_cast<double>(BATCH));
+}
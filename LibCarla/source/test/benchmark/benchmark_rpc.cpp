@@ -0,0 +1,60 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "Microbenchmark.h"
+
+#include <carla/MsgPack.h>
+#include <carla/rpc/Command.h>
+#include <carla/rpc/VehicleControl.h>
+
+#include <vector>
+
+using namespace carla;
+
+/// A batch shaped like one ApplyBatch frame of a mid-size fleet: a control
+/// and a transform per vehicle.
+static std::vector<rpc::Command> MakeCommandBatch(const size_t num_vehicles) {
+  std::vector<rpc::Command> commands;
+  commands.reserve(2u * num_vehicles);
+  for (auto i = 0u; i < num_vehicles; ++i) {
+    rpc::VehicleControl control;
+    control.throttle = 0.5f;
+    control.steer = static_cast<float>(i) / static_cast<float>(num_vehicles);
+    commands.emplace_back(rpc::Command::ApplyVehicleControl(i, control));
+    commands.emplace_back(rpc::Command::ApplyTransform(i, geom::Transform(
+        geom::Location(1.0f * i, 2.0f * i, 0.0f),
+        geom::Rotation(0.0f, 90.0f, 0.0f))));
+  }
+  return commands;
+}
+
+TEST(benchmark_rpc, command_encode_decode) {
+  constexpr size_t NUM_VEHICLES = 100u;
+  const auto commands = MakeCommandBatch(NUM_VEHICLES);
+  const auto encoded = MsgPack::Pack(commands);
+  std::cout << "  batch of " << commands.size() << " commands encodes to "
+      << encoded.size() << " bytes" << std::endl;
+
+  util::Microbenchmark::Run("rpc_command.encode_batch_200", [&]() {
+    auto buffer = MsgPack::Pack(commands);
+    util::DoNotOptimize(buffer.data());
+  }, static_cast<double>(commands.size()));
+
+  util::Microbenchmark::Run("rpc_command.decode_batch_200", [&]() {
+    auto decoded = MsgPack::UnPack<std::vector<rpc::Command>>(encoded);
+    util::DoNotOptimize(decoded.size());
+  }, static_cast<double>(commands.size()));
+
+  // Round trip of a single command, the unit cost seen by walkers and
+  // one-off calls.
+  const rpc::Command single(rpc::Command::DestroyActor(42u));
+  util::Microbenchmark::Run("rpc_command.round_trip_single", [&]() {
+    auto buffer = MsgPack::Pack(single);
+    auto decoded = MsgPack::UnPack<rpc::Command>(buffer);
+    util::DoNotOptimize(decoded);
+  });
+}
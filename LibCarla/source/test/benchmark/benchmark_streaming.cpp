@@ -0,0 +1,154 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/StopWatch.h>
+#include <carla/streaming/Client.h>
+#include <carla/streaming/Server.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace carla::streaming;
+using namespace std::chrono_literals;
+
+/// End-to-end latencies of a benchmark run, in nanoseconds.
+class LatencyStats {
+public:
+
+  void Add(const int64_t nanoseconds) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _samples.push_back(nanoseconds);
+  }
+
+  size_t GetCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _samples.size();
+  }
+
+  /// Latency at @a ratio (e.g. 0.5 for p50) in milliseconds.
+  double GetPercentile(const double ratio) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_samples.empty()) {
+      return 0.0;
+    }
+    auto sorted = _samples;
+    std::sort(sorted.begin(), sorted.end());
+    const auto index = static_cast<size_t>(
+        ratio * static_cast<double>(sorted.size() - 1u));
+    return static_cast<double>(sorted[index]) * 1e-6;
+  }
+
+private:
+
+  mutable std::mutex _mutex;
+
+  std::vector<int64_t> _samples;
+};
+
+/// Measures end-to-end latency and throughput of a multi-subscriber stream
+/// for a given message size and number of clients. The send timestamp rides
+/// in the first bytes of each message.
+class LatencyBenchmark {
+  using clock = carla::StopWatch::clock;
+public:
+
+  LatencyBenchmark(const size_t message_size, const size_t number_of_clients)
+    : _message_size(std::max(message_size, sizeof(int64_t))),
+      _server(TESTING_PORT) {
+    _server.SetTimeout(10s);
+    _stream = std::make_unique<MultiStream>(_server.MakeMultiStream());
+    for (auto i = 0u; i < number_of_clients; ++i) {
+      _clients.emplace_back(std::make_unique<Client>());
+      _clients.back()->Subscribe(_stream->token(), [this](carla::Buffer message) {
+        const auto now = clock::now().time_since_epoch().count();
+        int64_t sent = 0;
+        std::memcpy(&sent, message.data(), sizeof(sent));
+        _stats.Add(now - sent);
+      });
+    }
+    _server.AsyncRun(2u);
+    for (auto &client : _clients) {
+      client->AsyncRun(2u);
+    }
+    std::this_thread::sleep_for(1s); // let the clients subscribe.
+  }
+
+  /// Send @a number_of_messages down the stream, paced at ~90FPS unless
+  /// @a flood, and print the resulting percentiles.
+  void Run(const size_t number_of_messages, const bool flood = false) {
+    const std::vector<unsigned char> payload(_message_size, 42u);
+    carla::StopWatch timer;
+    for (auto i = 0u; i < number_of_messages; ++i) {
+      if (!flood) {
+        std::this_thread::sleep_for(11ms);
+      }
+      auto buffer = _stream->MakeBuffer();
+      buffer.copy_from(payload);
+      const int64_t sent = clock::now().time_since_epoch().count();
+      std::memcpy(buffer.data(), &sent, sizeof(sent));
+      _stream->Write(std::move(buffer));
+    }
+    const auto expected = number_of_messages * _clients.size();
+    for (auto i = 0u; i < 10u && _stats.GetCount() < expected; ++i) {
+      std::this_thread::sleep_for(1s);
+    }
+    timer.Stop();
+    const auto received = _stats.GetCount();
+    const auto seconds = static_cast<double>(timer.GetElapsedTime<std::chrono::microseconds>()) * 1e-6;
+    const auto megabytes =
+        static_cast<double>(received * _message_size) / (1024.0 * 1024.0);
+    std::cout << std::fixed << std::setprecision(2)
+              << "  size " << std::setw(9) << _message_size
+              << "  clients " << std::setw(2) << _clients.size()
+              << (flood ? "  flood" : "  paced")
+              << "  received " << received << "/" << expected
+              << "  " << std::setw(8) << (megabytes / seconds) << " MB/s"
+              << "  p50 " << std::setw(7) << _stats.GetPercentile(0.5) << " ms"
+              << "  p99 " << std::setw(7) << _stats.GetPercentile(0.99) << " ms"
+              << std::endl;
+    // Allow a few losses, the default queue policy drops stale frames.
+    ASSERT_GE(received, (9u * expected) / 10u);
+  }
+
+private:
+
+  const size_t _message_size;
+
+  Server _server;
+
+  std::unique_ptr<MultiStream> _stream;
+
+  std::vector<std::unique_ptr<Client>> _clients;
+
+  LatencyStats _stats;
+};
+
+TEST(benchmark_streaming_latency, message_size_sweep) {
+  for (auto size : {1024u, 64u * 1024u, 1024u * 1024u, 8u * 1024u * 1024u, 32u * 1024u * 1024u}) {
+    const size_t messages = (size >= 8u * 1024u * 1024u) ? 30u : 100u;
+    LatencyBenchmark benchmark(size, 1u);
+    benchmark.Run(messages);
+  }
+}
+
+TEST(benchmark_streaming_latency, client_scaling) {
+  for (auto clients : {1u, 2u, 4u, 8u, 16u}) {
+    LatencyBenchmark benchmark(1024u * 1024u, clients);
+    benchmark.Run(50u);
+  }
+}
+
+TEST(benchmark_streaming_latency, flood_mode) {
+  LatencyBenchmark benchmark(1024u * 1024u, 1u);
+  benchmark.Run(200u, true);
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "../Microbenchmark.h"
+
+#include <carla/image/ColorConverter.h>
+#include <carla/image/ImageConverter.h>
+
+#include <random>
+#include <string>
+
+using namespace carla::image;
+
+/// An image shaped like the simulator's camera output: BGRA, 8 bits per
+/// channel. For the depth and palette converters only the encoding of the
+/// channels matters, not the actual scene.
+static boost::gil::bgra8_image_t MakeCameraImage(int width, int height) {
+  boost::gil::bgra8_image_t image(width, height);
+  auto view = boost::gil::view(image);
+  std::mt19937 rng(42u);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      view(x, y) = boost::gil::bgra8_pixel_t(
+          static_cast<uint8_t>(rng()),
+          static_cast<uint8_t>(rng()),
+          static_cast<uint8_t>(rng()),
+          255u);
+    }
+  }
+  return image;
+}
+
+TEST(benchmark_image, color_conversion) {
+  constexpr int WIDTH = 800;
+  constexpr int HEIGHT = 600;
+  const auto source = MakeCameraImage(WIDTH, HEIGHT);
+  boost::gil::bgra8_image_t working(WIDTH, HEIGHT);
+  auto working_view = boost::gil::view(working);
+  const double pixels = static_cast<double>(WIDTH) * HEIGHT;
+
+  // Each iteration restores the pristine source first; the copy is part of
+  // every measurement, so the figures compare converters, not absolutes.
+  util::Microbenchmark::Run("image_color.copy_only_800x600", [&]() {
+    ImageConverter::CopyPixels(boost::gil::const_view(source), working_view);
+    util::DoNotOptimize(working_view(0, 0));
+  }, pixels);
+
+  util::Microbenchmark::Run("image_color.depth_800x600", [&]() {
+    ImageConverter::CopyPixels(boost::gil::const_view(source), working_view);
+    ImageConverter::ConvertInPlace(working_view, ColorConverter::Depth());
+    util::DoNotOptimize(working_view(0, 0));
+  }, pixels);
+
+  util::Microbenchmark::Run("image_color.logarithmic_depth_800x600", [&]() {
+    ImageConverter::CopyPixels(boost::gil::const_view(source), working_view);
+    ImageConverter::ConvertInPlace(working_view, ColorConverter::LogarithmicDepth());
+    util::DoNotOptimize(working_view(0, 0));
+  }, pixels);
+
+  util::Microbenchmark::Run("image_color.cityscapes_palette_800x600", [&]() {
+    ImageConverter::CopyPixels(boost::gil::const_view(source), working_view);
+    ImageConverter::ConvertInPlace(working_view, ColorConverter::CityScapesPalette());
+    util::DoNotOptimize(working_view(0, 0));
+  }, pixels);
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+#include "../Microbenchmark.h"
+
+#include <carla/FileSystem.h>
+#include <carla/StopWatch.h>
+#include <carla/geom/Location.h>
+#include <carla/opendrive/OpenDriveParser.h>
+#include <carla/road/Map.h>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <streambuf>
+#include <vector>
+
+using carla::road::Map;
+using carla::geom::Location;
+
+/// Load an OpenDrive map from the test content, preferring a mid-size town.
+static boost::optional<Map> LoadTestMap() {
+  const std::string folder = LIBCARLA_TEST_CONTENT_FOLDER "/OpenDrive/";
+  auto files = carla::FileSystem::ListFolder(folder, "*.xodr");
+  EXPECT_FALSE(files.empty());
+  if (files.empty()) {
+    return boost::none;
+  }
+  std::string filename = files[0u];
+  if (std::find(files.begin(), files.end(), "Town03.xodr") != files.end()) {
+    filename = "Town03.xodr";
+  }
+  std::ifstream file(folder + filename);
+  const std::string xodr{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  carla::StopWatch timer;
+  auto map = carla::opendrive::OpenDriveParser::Load(xodr);
+  timer.Stop();
+  std::cout << std::fixed << std::setprecision(2)
+      << "  map " << filename
+      << "  parse " << (static_cast<double>(timer.GetElapsedTime<std::chrono::microseconds>()) * 1e-3) << " ms"
+      << std::endl;
+  return map;
+}
+
+/// Query points scattered around the drivable space: one slightly perturbed
+/// location per generated waypoint, shuffled so consecutive queries do not
+/// walk the same road.
+static std::vector<Location> MakeQueryPoints(const Map &map) {
+  const auto waypoints = map.GenerateWaypoints(10.0);
+  std::mt19937 rng(42u);
+  std::uniform_real_distribution<float> jitter(-4.0f, 4.0f);
+  std::vector<Location> points;
+  points.reserve(waypoints.size());
+  for (auto &wp : waypoints) {
+    auto location = map.ComputeTransform(wp).location;
+    location.x += jitter(rng);
+    location.y += jitter(rng);
+    points.push_back(location);
+  }
+  std::shuffle(points.begin(), points.end(), rng);
+  return points;
+}
+
+TEST(benchmark_map, get_waypoint) {
+  auto map = LoadTestMap();
+  ASSERT_TRUE(map.has_value());
+  const auto points = MakeQueryPoints(*map);
+  ASSERT_FALSE(points.empty());
+  std::cout << "  " << points.size() << " query points" << std::endl;
+
+  size_t next = 0u;
+  util::Microbenchmark::Run("road_map.get_closest_waypoint_on_road", [&]() {
+    auto wp = map->GetClosestWaypointOnRoad(points[next]);
+    util::DoNotOptimize(wp);
+    next = (next + 1u) % points.size();
+  });
+
+  next = 0u;
+  util::Microbenchmark::Run("road_map.get_waypoint", [&]() {
+    auto wp = map->GetWaypoint(points[next]);
+    util::DoNotOptimize(wp);
+    next = (next + 1u) % points.size();
+  });
+
+  // Batched resolution of many locations at once, as used by the episode
+  // state processing and the traffic manager.
+  constexpr size_t BATCH = 256u;
+  ASSERT_GE(points.size(), BATCH);
+  std::vector<boost::optional<carla::road::element::Waypoint>> results(BATCH);
+  next = 0u;
+  util::Microbenchmark::Run("road_map.get_closest_waypoints_batch_256", [&]() {
+    const auto offset = std::min(next, points.size() - BATCH);
+    map->GetClosestWaypoints(points.data() + offset, BATCH, results.data());
+    util::DoNotOptimize(results.data());
+    next = (next + BATCH) % (points.size() - BATCH);
+  }, static_cast<double>(BATCH));
+}
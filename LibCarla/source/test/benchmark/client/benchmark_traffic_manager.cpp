@@ -0,0 +1,230 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/FileSystem.h>
+#include <carla/StopWatch.h>
+#include <carla/client/Map.h>
+#include <carla/geom/Location.h>
+#include <carla/trafficmanager/InMemoryMap.h>
+#include <carla/trafficmanager/LocalizationUtils.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <streambuf>
+#include <vector>
+
+using namespace carla::traffic_manager;
+
+/// Simulation step driven per benchmark frame, in seconds.
+static constexpr float FRAME_DT = 0.05f;
+/// Waypoint horizon kept ahead of each vehicle, in meters.
+static constexpr float HORIZON = 60.0f;
+/// Look-ahead used for the target waypoint scan, in meters.
+static constexpr float TARGET_POINT_DISTANCE = 10.0f;
+
+/// Load an OpenDrive map from the test content and build the traffic
+/// manager's local map cache from it, no simulator involved.
+static std::unique_ptr<InMemoryMap> MakeLocalMap() {
+  const std::string folder = LIBCARLA_TEST_CONTENT_FOLDER "/OpenDrive/";
+  auto files = carla::FileSystem::ListFolder(folder, "*.xodr");
+  EXPECT_FALSE(files.empty());
+  if (files.empty()) {
+    return nullptr;
+  }
+  // prefer a mid-size town, fall back to whatever is available
+  std::string filename = files[0u];
+  if (std::find(files.begin(), files.end(), "Town03.xodr") != files.end()) {
+    filename = "Town03.xodr";
+  }
+  std::ifstream file(folder + filename);
+  const std::string xodr{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  auto world_map = carla::SharedPtr<carla::client::Map>(new carla::client::Map(filename, xodr));
+  carla::StopWatch timer;
+  auto local_map = std::make_unique<InMemoryMap>(world_map);
+  local_map->SetUp();
+  timer.Stop();
+  std::cout << std::fixed << std::setprecision(2)
+            << "  map " << filename
+            << "  waypoints " << local_map->GetDenseTopology().size()
+            << "  setup " << (static_cast<double>(timer.GetElapsedTime<std::chrono::microseconds>()) * 1e-3) << " ms"
+            << std::endl;
+  return local_map;
+}
+
+/// A scripted vehicle hopping along the dense topology; stands in for the
+/// actor snapshots the localization stage reads from the simulator.
+struct SyntheticVehicle {
+  ActorId id;
+  SimpleWaypointPtr waypoint;
+  Buffer buffer;
+  float speed;
+};
+
+/// Drives the localization hot paths (waypoint advance and buffer
+/// maintenance, traffic grids, overlap queries) for a synthetic fleet and
+/// reports per-stage throughput and end-to-end frame latency.
+class TrafficManagerBenchmark {
+public:
+
+  TrafficManagerBenchmark(InMemoryMap &local_map, const size_t number_of_vehicles)
+    : _local_map(local_map) {
+    std::mt19937 rng(42u);
+    std::uniform_real_distribution<float> speed_distribution(5.0f, 20.0f);
+    const NodeList &topology = _local_map.GetDenseTopology();
+    const size_t stride = std::max<size_t>(topology.size() / number_of_vehicles, 1u);
+    _vehicles.reserve(number_of_vehicles);
+    for (size_t i = 0u; i < number_of_vehicles; ++i) {
+      SyntheticVehicle vehicle;
+      vehicle.id = static_cast<ActorId>(i + 1u);
+      vehicle.waypoint = topology[(i * stride) % topology.size()];
+      vehicle.speed = speed_distribution(rng);
+      _vehicles.push_back(std::move(vehicle));
+    }
+  }
+
+  void Run(const size_t number_of_frames) {
+    std::mt19937 rng(117u);
+    int64_t localization_ns = 0;
+    int64_t grid_ns = 0;
+    int64_t overlap_ns = 0;
+    std::vector<int64_t> frame_ns;
+    frame_ns.reserve(number_of_frames);
+    size_t overlap_sink = 0u;
+
+    for (size_t frame = 0u; frame < number_of_frames; ++frame) {
+      carla::StopWatch frame_timer;
+
+      // localization: advance the scripted pose and keep the waypoint
+      // buffer covering the horizon, like LocalizationStage::Action
+      carla::StopWatch timer;
+      for (auto &vehicle : _vehicles) {
+        StepVehicle(vehicle, rng);
+      }
+      timer.Stop();
+      localization_ns += timer.GetElapsedTime<std::chrono::nanoseconds>();
+
+      // traffic grids: re-register each vehicle's path footprint
+      timer.Restart();
+      for (auto &vehicle : _vehicles) {
+        _track_traffic.UpdateGridPosition(vehicle.id, vehicle.buffer);
+      }
+      timer.Stop();
+      grid_ns += timer.GetElapsedTime<std::chrono::nanoseconds>();
+
+      // overlap queries: what the collision stage asks for per vehicle
+      timer.Restart();
+      for (auto &vehicle : _vehicles) {
+        overlap_sink += _track_traffic.GetOverlappingVehicles(vehicle.id).size();
+      }
+      timer.Stop();
+      overlap_ns += timer.GetElapsedTime<std::chrono::nanoseconds>();
+
+      frame_timer.Stop();
+      frame_ns.push_back(frame_timer.GetElapsedTime<std::chrono::nanoseconds>());
+    }
+
+    const auto total_actors = static_cast<double>(_vehicles.size() * number_of_frames);
+    auto actors_per_second = [total_actors](int64_t nanoseconds) {
+      return total_actors / (static_cast<double>(nanoseconds) * 1e-9);
+    };
+    std::sort(frame_ns.begin(), frame_ns.end());
+    auto percentile = [&frame_ns](double ratio) {
+      const auto index = static_cast<size_t>(ratio * static_cast<double>(frame_ns.size() - 1u));
+      return static_cast<double>(frame_ns[index]) * 1e-6;
+    };
+    std::cout << std::fixed << std::setprecision(2)
+              << "  vehicles " << std::setw(5) << _vehicles.size()
+              << "  loc " << std::setw(9) << std::setprecision(0) << actors_per_second(localization_ns)
+              << "  grid " << std::setw(9) << actors_per_second(grid_ns)
+              << "  overlap " << std::setw(9) << actors_per_second(overlap_ns)
+              << " actors/s" << std::setprecision(2)
+              << "  frame p50 " << std::setw(7) << percentile(0.5) << " ms"
+              << "  p99 " << std::setw(7) << percentile(0.99) << " ms"
+              << "  (" << overlap_sink << " overlaps)"
+              << std::endl;
+
+    // every vehicle must have kept a horizon going, otherwise the run
+    // measured nothing
+    for (auto &vehicle : _vehicles) {
+      ASSERT_FALSE(vehicle.buffer.empty());
+    }
+  }
+
+private:
+
+  /// Advance the vehicle along the dense topology by its per-frame travel
+  /// and slide its waypoint buffer accordingly.
+  void StepVehicle(SyntheticVehicle &vehicle, std::mt19937 &rng) {
+    // seed the buffer on first use or after a respawn
+    if (vehicle.buffer.empty()) {
+      vehicle.buffer.push_back(vehicle.waypoint);
+      _track_traffic.UpdatePassingVehicle(vehicle.waypoint->GetId(), vehicle.id);
+    }
+
+    // hop waypoints until the frame's travel distance is covered; the
+    // passed waypoints leave the front of the buffer
+    float remaining_squared = vehicle.speed * FRAME_DT * vehicle.speed * FRAME_DT;
+    while (remaining_squared > 0.0f) {
+      const auto &next_list = vehicle.waypoint->GetNextWaypoint();
+      if (next_list.empty()) {
+        Respawn(vehicle, rng);
+        break;
+      }
+      SimpleWaypointPtr next = next_list[vehicle.id % next_list.size()];
+      remaining_squared -= vehicle.waypoint->DistanceSquared(next);
+      vehicle.waypoint = next;
+      if (vehicle.buffer.size() > 1u) {
+        _track_traffic.RemovePassingVehicle(vehicle.buffer.front()->GetId(), vehicle.id);
+        vehicle.buffer.pop_front();
+      }
+    }
+
+    // extend the back of the buffer to cover the horizon again
+    const carla::geom::Location location = vehicle.waypoint->GetLocation();
+    while (vehicle.buffer.back()->DistanceSquared(location) < HORIZON * HORIZON) {
+      const auto &next_list = vehicle.buffer.back()->GetNextWaypoint();
+      if (next_list.empty()) {
+        break;
+      }
+      SimpleWaypointPtr next = next_list[vehicle.id % next_list.size()];
+      vehicle.buffer.push_back(next);
+      _track_traffic.UpdatePassingVehicle(next->GetId(), vehicle.id);
+    }
+
+    // the look-ahead scan the stage runs per vehicle
+    _track_traffic.GetTargetWaypoint(vehicle.buffer, TARGET_POINT_DISTANCE);
+  }
+
+  /// Put a vehicle that ran off a dead end back on a random waypoint.
+  void Respawn(SyntheticVehicle &vehicle, std::mt19937 &rng) {
+    for (uint64_t i = 0u; i < vehicle.buffer.size(); ++i) {
+      _track_traffic.RemovePassingVehicle(vehicle.buffer.at(i)->GetId(), vehicle.id);
+    }
+    vehicle.buffer.clear();
+    const NodeList &topology = _local_map.GetDenseTopology();
+    vehicle.waypoint = topology[rng() % topology.size()];
+  }
+
+  InMemoryMap &_local_map;
+
+  TrackTraffic _track_traffic;
+
+  std::vector<SyntheticVehicle> _vehicles;
+};
+
+TEST(benchmark_traffic_manager, fleet_size_sweep) {
+  auto local_map = MakeLocalMap();
+  ASSERT_NE(local_map, nullptr);
+  for (auto vehicles : {100u, 500u, 2000u}) {
+    TrafficManagerBenchmark benchmark(*local_map, vehicles);
+    benchmark.Run(100u);
+  }
+}
@@ -10,10 +10,12 @@
 
 #include <carla/StopWatch.h>
 #include <carla/ThreadPool.h>
+#include <carla/client/detail/MapDataCache.h>
 #include <carla/geom/Location.h>
 #include <carla/geom/Math.h>
 #include <carla/opendrive/OpenDriveParser.h>
 #include <carla/road/MapBuilder.h>
+#include <carla/road/MapSerializer.h>
 #include <carla/road/element/RoadInfoElevation.h>
 #include <carla/road/element/RoadInfoGeometry.h>
 #include <carla/road/element/RoadInfoMarkRecord.h>
@@ -21,8 +23,13 @@
 
 #include <pugixml/pugixml.hpp>
 
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
+#include <set>
+#include <sstream>
 #include <string>
+#include <tuple>
 
 using namespace carla::road;
 using namespace carla::road::element;
@@ -424,3 +431,86 @@ TEST(road, get_waypoint) {
     result.get();
   }
 }
+
+TEST(road, serialize_round_trip) {
+  for (const auto &file : util::OpenDrive::GetAvailableFiles()) {
+    const auto contents = util::OpenDrive::Load(file);
+    auto map = OpenDriveParser::Load(contents);
+    ASSERT_TRUE(map.has_value());
+
+    const auto hash = MapSerializer::Hash(contents);
+    std::stringstream buffer;
+    MapSerializer::Serialize(*map, buffer, hash);
+
+    // A different content hash must not load.
+    std::stringstream wrong_hash(buffer.str());
+    ASSERT_FALSE(MapSerializer::Deserialize(wrong_hash, hash + 1u).has_value());
+
+    // A truncated file must not load.
+    std::stringstream truncated(buffer.str().substr(0u, buffer.str().size() / 2u));
+    ASSERT_FALSE(MapSerializer::Deserialize(truncated, hash).has_value());
+
+    auto loaded = MapSerializer::Deserialize(buffer, hash);
+    ASSERT_TRUE(loaded.has_value());
+
+    ASSERT_EQ(map->GetGeoReference(), loaded->GetGeoReference());
+    ASSERT_EQ(map->GetSignals().size(), loaded->GetSignals().size());
+    ASSERT_EQ(map->GetControllers().size(), loaded->GetControllers().size());
+    ASSERT_EQ(map->GetAllSignalReferences().size(), loaded->GetAllSignalReferences().size());
+
+    // Topology must match; road iteration order is not deterministic across
+    // map instances, so compare as sets.
+    using TopologyKey = std::tuple<RoadId, LaneId, double, RoadId, LaneId, double>;
+    auto get_topology = [](const Map &m) {
+      std::set<TopologyKey> result;
+      for (const auto &pair : m.GenerateTopology()) {
+        result.emplace(
+            pair.first.road_id, pair.first.lane_id, pair.first.s,
+            pair.second.road_id, pair.second.lane_id, pair.second.s);
+      }
+      return result;
+    };
+    ASSERT_EQ(get_topology(*map), get_topology(*loaded));
+
+    // Spot-check waypoint transforms.
+    auto waypoints = map->GenerateWaypointsOnRoadEntries();
+    for (const auto &wp : waypoints) {
+      const auto expected = map->ComputeTransform(wp);
+      const auto actual = loaded->ComputeTransform(wp);
+      ASSERT_NEAR(expected.location.x, actual.location.x, 1e-4f);
+      ASSERT_NEAR(expected.location.y, actual.location.y, 1e-4f);
+      ASSERT_NEAR(expected.location.z, actual.location.z, 1e-4f);
+    }
+  }
+}
+
+TEST(road, map_data_cache_round_trip) {
+  using carla::client::detail::MapDataCache;
+  const std::string cache_dir = "_test_map_cache";
+  ASSERT_EQ(setenv("CARLA_MAP_CACHE_DIR", cache_dir.c_str(), 1), 0);
+
+  const std::string contents = util::OpenDrive::Load(
+      util::OpenDrive::GetAvailableFiles().front());
+  const auto hash = MapSerializer::Hash(contents);
+
+  // Nothing cached yet.
+  ASSERT_FALSE(MapDataCache::ReadOpenDrive(hash).has_value());
+
+  MapDataCache::WriteOpenDrive(hash, contents);
+  auto cached = MapDataCache::ReadOpenDrive(hash);
+  ASSERT_TRUE(cached.has_value());
+  ASSERT_EQ(*cached, contents);
+
+  // A stale file whose contents no longer match its hash is rejected.
+  ASSERT_FALSE(MapDataCache::ReadOpenDrive(hash + 1u).has_value());
+  {
+    std::ofstream corrupted(
+        MapDataCache::GetPath(hash, ".xodr"),
+        std::ios_base::binary | std::ios_base::trunc);
+    corrupted << "not the original contents";
+  }
+  ASSERT_FALSE(MapDataCache::ReadOpenDrive(hash).has_value());
+
+  std::remove(MapDataCache::GetPath(hash, ".xodr").c_str());
+  unsetenv("CARLA_MAP_CACHE_DIR");
+}
@@ -42,6 +42,41 @@ TEST(recurrent_shared_future, use_case) {
   ASSERT_EQ(count, number_of_openings * number_of_threads);
 }
 
+TEST(recurrent_shared_future, spin_budget) {
+  using namespace carla;
+  ThreadGroup threads;
+  RecurrentSharedFuture<int> future;
+  future.SetSpinBudget(500u);
+
+  constexpr size_t number_of_openings = 20u;
+
+  std::atomic_size_t count{0u};
+  std::atomic_bool done{false};
+
+  threads.CreateThread([&]() {
+    while (!done) {
+      auto result = future.WaitFor(1s);
+      ASSERT_TRUE(result.has_value());
+      ASSERT_EQ(*result, 42);
+      ++count;
+    }
+  });
+
+  std::this_thread::sleep_for(100ms);
+  for (auto i = 0u; i < number_of_openings - 1u; ++i) {
+    future.SetValue(42);
+    std::this_thread::sleep_for(1ms);
+  }
+  done = true;
+  future.SetValue(42);
+  threads.JoinAll();
+  ASSERT_EQ(count, number_of_openings);
+
+  future.SetSpinBudget(0u);
+  auto result = future.WaitFor(1ns);
+  ASSERT_FALSE(result.has_value());
+}
+
 TEST(recurrent_shared_future, timeout) {
   using namespace carla;
   RecurrentSharedFuture<int> future;
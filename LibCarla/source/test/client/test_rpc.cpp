@@ -26,6 +26,29 @@ TEST(rpc, compilation_tests) {
   server.BindSync("bind03", [](int, float, double, char) {});
 }
 
+TEST(rpc, call_slot_pool) {
+  using namespace carla::rpc::detail;
+  auto pool = std::make_shared<CallSlotPool<int>>();
+
+  auto slot = pool->Pop();
+  auto *first = slot.get();
+  {
+    CompletionGuard<int> guard(slot);
+    guard->Execute([](int x, int y) { return x + y; }, 2, 3);
+  }
+  ASSERT_EQ(slot->Wait(), 5);
+
+  // Slots return to the pool once released, and a dropped task abandons its
+  // slot instead of leaving the waiter blocked.
+  slot = nullptr;
+  slot = pool->Pop();
+  ASSERT_EQ(slot.get(), first);
+  {
+    CompletionGuard<int> guard(slot);
+  }
+  ASSERT_THROW(slot->Wait(), std::runtime_error);
+}
+
 TEST(rpc, server_bind_sync_run_on_game_thread) {
   const auto main_thread_id = std::this_thread::get_id();
 
@@ -134,3 +134,73 @@ TEST(buffer, buffer_pool) {
   // Now delete the pool to test the weak reference inside the buffers.
   pool.reset();
 }
+
+TEST(buffer, buffer_pool_size_classes) {
+  auto pool = std::make_shared<carla::BufferPool>();
+  {
+    auto big = pool->Pop();
+    big.reset(1024u * 1024u);
+  }
+  {
+    auto small = pool->Pop();
+    small.reset(64u);
+  }
+  // Asking for a small buffer should not hand back the megabyte one.
+  auto buff = pool->Pop(64u);
+  ASSERT_GE(buff.capacity(), 64u);
+  ASSERT_LT(buff.capacity(), 1024u * 1024u);
+}
+
+TEST(buffer, buffer_pool_trim) {
+  auto pool = std::make_shared<carla::BufferPool>();
+  {
+    auto big = pool->Pop();
+    big.reset(8u * 1024u * 1024u);
+  }
+  ASSERT_EQ(pool->GetRetainedBytes(), 8u * 1024u * 1024u);
+  pool->Trim(1024u);
+  ASSERT_EQ(pool->GetRetainedBytes(), 0u);
+}
+
+TEST(buffer, buffer_pool_global_accounting) {
+  const auto base_count = carla::BufferPool::GetTotalRetainedCount();
+  const auto base_bytes = carla::BufferPool::GetTotalRetainedBytes();
+  auto pool = std::make_shared<carla::BufferPool>();
+  {
+    auto buff = pool->Pop();
+    buff.reset(1024u);
+  } // returns to the pool.
+  ASSERT_EQ(carla::BufferPool::GetTotalRetainedCount(), base_count + 1u);
+  ASSERT_EQ(carla::BufferPool::GetTotalRetainedBytes(), base_bytes + pool->GetRetainedBytes());
+  // Destroying the pool releases the memory and the process-wide totals.
+  pool.reset();
+  ASSERT_EQ(carla::BufferPool::GetTotalRetainedCount(), base_count);
+  ASSERT_EQ(carla::BufferPool::GetTotalRetainedBytes(), base_bytes);
+}
+
+TEST(buffer, buffer_pool_stats) {
+  auto pool = std::make_shared<carla::BufferPool>("test pool");
+  {
+    auto buff = pool->Pop(); // nothing pooled yet, a miss.
+    buff.reset(4096u);
+  }
+  {
+    auto buff = pool->Pop(4096u); // served from the pool, a hit.
+    ASSERT_EQ(buff.capacity(), 4096u);
+  }
+  pool->Trim(0u); // discards the pooled buffer.
+  const auto stats = pool->GetStats();
+  ASSERT_EQ(stats.name, "test pool");
+  ASSERT_EQ(stats.hits, 1u);
+  ASSERT_EQ(stats.misses, 1u);
+  ASSERT_EQ(stats.discards, 1u);
+  ASSERT_EQ(stats.retained_count, 0u);
+  ASSERT_EQ(stats.retained_bytes, 0u);
+  ASSERT_EQ(stats.peak_retained_bytes, 4096u);
+  // The registry serves the same counters without a handle to the pool.
+  bool found = false;
+  for (const auto &entry : carla::BufferPool::GetAllStats()) {
+    found |= (entry.name == "test pool");
+  }
+  ASSERT_TRUE(found);
+}
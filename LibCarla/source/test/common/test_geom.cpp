@@ -11,6 +11,7 @@
 #include <carla/geom/BoundingBox.h>
 #include <carla/geom/Transform.h>
 #include <limits>
+#include <vector>
 
 namespace carla {
 namespace geom {
@@ -105,6 +106,52 @@ TEST(geom, bbox_get_local_vertices_get_world_vertices_coherence) {
 }
 
 
+TEST(geom, bbox_batch_contains_matches_scalar) {
+  const BoundingBox bbox(Location(1.5f, -2.0f, 0.5f), Vector3D(2.0f, 1.0f, 0.75f));
+  const Transform bbox_transform(Location(10.0f, -5.0f, 3.0f), Rotation(-20.0f, 45.0f, 10.0f));
+
+  std::vector<Location> points;
+  for (float x = -6.0f; x <= 6.0f; x += 1.5f) {
+    for (float y = -6.0f; y <= 6.0f; y += 1.5f) {
+      for (float z = -3.0f; z <= 3.0f; z += 1.5f) {
+        points.emplace_back(bbox_transform.location + Location(x, y, z));
+      }
+    }
+  }
+
+  std::vector<uint8_t> results(points.size());
+  bbox.ContainsPoints(points.data(), points.size(), results.data(), bbox_transform);
+  for (auto i = 0u; i < points.size(); ++i) {
+    ASSERT_EQ(results[i] != 0u, bbox.Contains(points[i], bbox_transform)) << "point " << i;
+  }
+}
+
+TEST(geom, bbox_batch_sphere_and_frustum_culling) {
+  const std::vector<BoundingBox> boxes = {
+      BoundingBox(Location(0.0f, 0.0f, 0.0f), Vector3D(1.0f, 1.0f, 1.0f)),
+      BoundingBox(Location(0.0f, 0.0f, 0.0f), Vector3D(0.5f, 0.5f, 0.5f))};
+  const std::vector<Transform> transforms = {
+      Transform(Location(0.0f, 0.0f, 0.0f), Rotation(0.0f, 30.0f, 0.0f)),
+      Transform(Location(100.0f, 0.0f, 0.0f))};
+
+  std::vector<uint8_t> results(boxes.size());
+
+  // Sphere around the origin reaches the first box only.
+  BoundingBox::IntersectSphere(
+      boxes.data(), transforms.data(), boxes.size(), Location(0.0f, 3.0f, 0.0f), 2.5f, results.data());
+  ASSERT_NE(results[0u], 0u);
+  ASSERT_EQ(results[1u], 0u);
+
+  // Half space x <= 50: the first box is inside, the second one behind.
+  const std::vector<Vector3D> plane_normals = {Vector3D(-1.0f, 0.0f, 0.0f)};
+  const std::vector<float> plane_offsets = {50.0f};
+  BoundingBox::IntersectFrustum(
+      boxes.data(), transforms.data(), boxes.size(),
+      plane_normals.data(), plane_offsets.data(), plane_normals.size(), results.data());
+  ASSERT_NE(results[0u], 0u);
+  ASSERT_EQ(results[1u], 0u);
+}
+
 TEST(geom, single_point_rotation) {
   constexpr double error = 0.001;
 
@@ -0,0 +1,95 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/image/ImageIO.h>
+#include <carla/image/ImageIOConfig.h>
+
+#if LIBCARLA_IMAGE_WITH_PNG_SUPPORT == true
+
+#include <boost/gil/extension/io/png.hpp>
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+using carla::image::io::detail::png_encoder;
+
+static boost::gil::rgba8_image_t MakeTestImage(int width, int height) {
+  boost::gil::rgba8_image_t image(width, height);
+  auto view = boost::gil::view(image);
+  std::mt19937 rng(42u);
+  for (int y = 0u; y < height; ++y) {
+    for (int x = 0u; x < width; ++x) {
+      view(x, y) = boost::gil::rgba8_pixel_t(
+          static_cast<uint8_t>(x + y),
+          static_cast<uint8_t>(rng()),
+          static_cast<uint8_t>(x ^ y),
+          255u);
+    }
+  }
+  return image;
+}
+
+TEST(image, png_parallel_encoder_roundtrip) {
+  const auto image = MakeTestImage(320, 512);
+  for (size_t num_threads : {2u, 3u, 8u}) {
+    const std::string path =
+        "test_image_" + std::to_string(num_threads) + ".png";
+    ASSERT_TRUE(png_encoder::WriteView(
+        path,
+        boost::gil::const_view(image),
+        num_threads));
+    boost::gil::rgba8_image_t result;
+    boost::gil::read_image(path, result, boost::gil::png_tag());
+    ASSERT_TRUE(boost::gil::equal_pixels(
+        boost::gil::const_view(result),
+        boost::gil::const_view(image)));
+    std::remove(path.c_str());
+  }
+}
+
+TEST(image, png_parallel_encoder_declines_small_images) {
+  const auto image = MakeTestImage(32, 32);
+  ASSERT_FALSE(png_encoder::WriteView(
+      "test_image_small.png",
+      boost::gil::const_view(image),
+      8u));
+}
+
+TEST(image, png_parallel_encoder_bgra) {
+  // The sensor image layout; channels must come out in semantic order.
+  boost::gil::bgra8_image_t image(64, 256);
+  auto view = boost::gil::view(image);
+  for (int y = 0u; y < 256; ++y) {
+    for (int x = 0u; x < 64; ++x) {
+      view(x, y) = boost::gil::bgra8_pixel_t(
+          static_cast<uint8_t>(x),
+          static_cast<uint8_t>(y),
+          static_cast<uint8_t>(x * y),
+          200u);
+    }
+  }
+  const std::string path = "test_image_bgra.png";
+  ASSERT_TRUE(png_encoder::WriteView(path, boost::gil::const_view(image), 2u));
+  boost::gil::rgba8_image_t result;
+  boost::gil::read_image(path, result, boost::gil::png_tag());
+  auto result_view = boost::gil::const_view(result);
+  for (int y = 0u; y < 256; ++y) {
+    for (int x = 0u; x < 64; ++x) {
+      const auto expected = view(x, y);
+      const auto actual = result_view(x, y);
+      ASSERT_EQ(boost::gil::semantic_at_c<0u>(expected), boost::gil::semantic_at_c<0u>(actual));
+      ASSERT_EQ(boost::gil::semantic_at_c<1u>(expected), boost::gil::semantic_at_c<1u>(actual));
+      ASSERT_EQ(boost::gil::semantic_at_c<2u>(expected), boost::gil::semantic_at_c<2u>(actual));
+      ASSERT_EQ(boost::gil::semantic_at_c<3u>(expected), boost::gil::semantic_at_c<3u>(actual));
+    }
+  }
+  std::remove(path.c_str());
+}
+
+#endif // LIBCARLA_IMAGE_WITH_PNG_SUPPORT
@@ -0,0 +1,53 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/profiler/LifetimeProfiled.h>
+
+#include <memory>
+
+using carla::profiler::LifetimeCensus;
+
+namespace {
+
+  class ProfiledWidget : private carla::profiler::LifetimeProfiled {
+  public:
+    ProfiledWidget() : LIBCARLA_INITIALIZE_LIFETIME_PROFILER("TestWidget", "test widget") {}
+  };
+
+  static LifetimeCensus::Entry FindEntry(const std::string &type_name) {
+    for (auto &entry : LifetimeCensus::GetInstance().GetEntries()) {
+      if (entry.type_name == type_name) {
+        return entry;
+      }
+    }
+    return {};
+  }
+
+} // namespace
+
+TEST(lifetime, census_counts) {
+  auto first = std::make_unique<ProfiledWidget>();
+  auto second = std::make_unique<ProfiledWidget>();
+  auto entry = FindEntry("TestWidget");
+  ASSERT_EQ(entry.live, 2u);
+  ASSERT_EQ(entry.peak, 2u);
+  ASSERT_EQ(entry.total, 2u);
+
+  first.reset();
+  entry = FindEntry("TestWidget");
+  ASSERT_EQ(entry.live, 1u);
+  ASSERT_EQ(entry.peak, 2u);
+  ASSERT_EQ(entry.total, 2u);
+
+  // The peak survives the dip.
+  auto third = std::make_unique<ProfiledWidget>();
+  entry = FindEntry("TestWidget");
+  ASSERT_EQ(entry.live, 2u);
+  ASSERT_EQ(entry.peak, 2u);
+  ASSERT_EQ(entry.total, 3u);
+}
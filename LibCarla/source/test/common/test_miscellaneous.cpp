@@ -7,7 +7,28 @@
 #include "test.h"
 
 #include <carla/Version.h>
+#include <carla/WildcardPattern.h>
 
 TEST(miscellaneous, version) {
   std::cout << "LibCarla " << carla::version() << std::endl;
 }
+
+TEST(miscellaneous, wildcard_pattern) {
+  carla::WildcardPattern literal{"vehicle.tesla.model3"};
+  ASSERT_TRUE(literal.IsLiteral());
+  ASSERT_TRUE(literal.Matches("vehicle.tesla.model3"));
+  ASSERT_FALSE(literal.Matches("vehicle.tesla.model3s"));
+
+  carla::WildcardPattern prefix{"vehicle.*"};
+  ASSERT_TRUE(prefix.IsPrefix());
+  ASSERT_EQ(prefix.GetPrefix(), "vehicle.");
+  ASSERT_TRUE(prefix.Matches("vehicle.tesla.model3"));
+  ASSERT_FALSE(prefix.Matches("vehicle"));
+  ASSERT_FALSE(prefix.Matches("walker.pedestrian.0001"));
+
+  carla::WildcardPattern generic{"*.tesla.*"};
+  ASSERT_FALSE(generic.IsLiteral());
+  ASSERT_FALSE(generic.IsPrefix());
+  ASSERT_TRUE(generic.Matches("vehicle.tesla.model3"));
+  ASSERT_FALSE(generic.Matches("vehicle.audi.tt"));
+}
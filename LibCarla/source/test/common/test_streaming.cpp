@@ -16,6 +16,7 @@
 #include <carla/streaming/low_level/Server.h>
 
 #include <atomic>
+#include <cstring>
 
 using namespace std::chrono_literals;
 
@@ -77,6 +78,48 @@ TEST(streaming, low_level_sending_strings) {
   ASSERT_GE(message_count, number_of_messages - 3u);
 }
 
+TEST(streaming, low_level_sending_gathered_buffers) {
+  using namespace util::buffer;
+  using namespace carla::streaming;
+  using namespace carla::streaming::detail;
+  using namespace carla::streaming::low_level;
+
+  constexpr auto number_of_messages = 100u;
+  const std::string chunk0 = "header";
+  const std::string chunk1 = "body of the message";
+  const std::string chunk2 = "trailing chunk";
+  const std::string message_text = chunk0 + chunk1 + chunk2;
+
+  std::atomic_size_t message_count{0u};
+
+  io_context_running io;
+
+  Server<tcp::Server> srv(io.service, TESTING_PORT);
+  srv.SetTimeout(1s);
+
+  auto stream = srv.MakeStream();
+
+  Client<tcp::Client> c;
+  c.Subscribe(io.service, stream.token(), [&](auto message) {
+    ++message_count;
+    // The chunks of a gathered write arrive as a single message.
+    ASSERT_EQ(message.size(), message_text.size());
+    const std::string msg = as_string(message);
+    ASSERT_EQ(msg, message_text);
+  });
+
+  for (auto i = 0u; i < number_of_messages; ++i) {
+    std::this_thread::sleep_for(2ms);
+    stream.Write(
+        carla::Buffer(chunk0),
+        carla::Buffer(chunk1),
+        carla::Buffer(chunk2));
+  }
+
+  std::this_thread::sleep_for(2ms);
+  ASSERT_GE(message_count, number_of_messages - 3u);
+}
+
 TEST(streaming, low_level_unsubscribing) {
   using namespace util::buffer;
   using namespace carla::streaming;
@@ -120,6 +163,148 @@ TEST(streaming, low_level_unsubscribing) {
   }
 }
 
+TEST(streaming, stream_id_namespaces) {
+  using namespace carla::streaming;
+  using namespace carla::streaming::detail;
+
+  Dispatcher dispatcher{make_endpoint<tcp::Client::protocol_type>(TESTING_PORT)};
+
+  // namespace zero preserves the original id sequence
+  auto stream1 = dispatcher.MakeStream();
+  ASSERT_EQ(stream1.get_stream_id(), 1u);
+
+  dispatcher.SetStreamIdNamespace(3u);
+  auto stream2 = dispatcher.MakeStream();
+  ASSERT_EQ(stream2.get_stream_id(), (3u << stream_id_namespace_shift) | 1u);
+  auto stream3 = dispatcher.MakeStream();
+  ASSERT_EQ(stream3.get_stream_id(), (3u << stream_id_namespace_shift) | 2u);
+
+  // each namespace keeps its own counter
+  dispatcher.SetStreamIdNamespace(0u);
+  auto stream4 = dispatcher.MakeStream();
+  ASSERT_EQ(stream4.get_stream_id(), 2u);
+}
+
+TEST(streaming, low_level_multiplexed_streams) {
+  using namespace util::buffer;
+  using namespace carla::streaming;
+  using namespace carla::streaming::detail;
+  using namespace carla::streaming::low_level;
+
+  constexpr auto number_of_messages = 50u;
+  const std::string message_text = "Hello client!";
+
+  io_context_running io;
+
+  Server<tcp::Server> srv(io.service, TESTING_PORT);
+  srv.SetTimeout(1s);
+
+  auto stream0 = srv.MakeMultiplexedStream();
+  auto stream1 = srv.MakeMultiplexedStream(stream0);
+
+  // one session on the wire, two streams at the API level
+  ASSERT_EQ(stream0.get_stream_id(), stream1.get_stream_id());
+  ASSERT_NE(stream0.get_sub_stream_id(), stream1.get_sub_stream_id());
+
+  // stand-in for the sensor header: each message starts with the sub id
+  auto write = [](carla::streaming::Stream &stream, const std::string &text) {
+    const uint64_t sub_stream_id = stream.get_sub_stream_id();
+    stream.Write(
+        carla::Buffer(std::string(
+            reinterpret_cast<const char *>(&sub_stream_id),
+            sizeof(sub_stream_id))),
+        carla::Buffer(text));
+  };
+
+  std::atomic_size_t message_count0{0u};
+  std::atomic_size_t message_count1{0u};
+
+  Client<tcp::Client> c;
+  c.SetSubStreamIdExtractor([](const carla::Buffer &message) {
+    uint64_t sub_stream_id = 0u;
+    std::memcpy(&sub_stream_id, message.data(), sizeof(sub_stream_id));
+    return sub_stream_id;
+  });
+  auto make_callback = [&](std::atomic_size_t &message_count) {
+    return [&](carla::Buffer message) {
+      ++message_count;
+      ASSERT_EQ(message.size(), sizeof(uint64_t) + message_text.size());
+      const std::string msg = as_string(message);
+      ASSERT_EQ(msg.substr(sizeof(uint64_t)), message_text);
+    };
+  };
+  c.Subscribe(io.service, stream0.token(), make_callback(message_count0));
+  c.Subscribe(io.service, stream1.token(), make_callback(message_count1));
+
+  for (auto i = 0u; i < number_of_messages; ++i) {
+    std::this_thread::sleep_for(2ms);
+    write(stream0, message_text);
+    write(stream1, message_text);
+  }
+
+  std::this_thread::sleep_for(4ms);
+  ASSERT_GE(message_count0, number_of_messages - 3u);
+  ASSERT_GE(message_count1, number_of_messages - 3u);
+
+  // dropping one sub-stream keeps the shared session alive for the other
+  c.UnSubscribe(stream0.token());
+  const auto count0_after_unsubscribe = message_count0.load();
+  const auto count1_before = message_count1.load();
+
+  for (auto i = 0u; i < number_of_messages; ++i) {
+    std::this_thread::sleep_for(2ms);
+    write(stream0, message_text);
+    write(stream1, message_text);
+  }
+
+  std::this_thread::sleep_for(4ms);
+  ASSERT_EQ(message_count0, count0_after_unsubscribe);
+  ASSERT_GE(message_count1, count1_before + number_of_messages - 3u);
+
+  c.UnSubscribe(stream1.token());
+}
+
+TEST(streaming, low_level_coalescing) {
+  using namespace util::buffer;
+  using namespace carla::streaming;
+  using namespace carla::streaming::detail;
+  using namespace carla::streaming::low_level;
+
+  constexpr auto number_of_messages = 200u;
+
+  std::atomic_size_t message_count{0u};
+
+  io_context_running io;
+
+  Server<tcp::Server> srv(io.service, TESTING_PORT);
+  srv.SetTimeout(1s);
+
+  auto stream = srv.MakeStream();
+  // Block so no message is discarded, and coalesce so the burst below goes
+  // out in a handful of gathered writes instead of one write per message.
+  stream.SetQueuePolicy(QueuePolicy::block, 0u);
+  stream.SetCoalescing(4096u, 2000u);
+
+  Client<tcp::Client> c;
+  c.Subscribe(io.service, stream.token(), [&](auto message) {
+    // Coalescing must preserve per-message framing and ordering.
+    const auto i = message_count++;
+    const std::string expected = "message-" + std::to_string(i);
+    ASSERT_EQ(message.size(), expected.size());
+    const std::string msg = as_string(message);
+    ASSERT_EQ(msg, expected);
+  });
+
+  // Give the subscription time to connect, then burst without pacing.
+  std::this_thread::sleep_for(100ms);
+  for (auto i = 0u; i < number_of_messages; ++i) {
+    stream << std::string("message-") + std::to_string(i);
+  }
+
+  std::this_thread::sleep_for(200ms);
+  ASSERT_EQ(message_count, number_of_messages);
+}
+
 TEST(streaming, low_level_tcp_small_message) {
   using namespace carla::streaming;
   using namespace carla::streaming::detail;
@@ -0,0 +1,54 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/profiler/TraceLog.h>
+
+using carla::profiler::TraceLog;
+
+TEST(tracelog, record_and_export) {
+  auto &log = TraceLog::GetInstance();
+  ASSERT_FALSE(log.IsEnabled());
+
+  // Disabled probes must not record.
+  {
+    CARLA_TRACE_EVENT(test, ignored_event);
+  }
+
+  log.Start(16u);
+  ASSERT_TRUE(log.IsEnabled());
+  {
+    CARLA_TRACE_EVENT(test, recorded_event);
+  }
+  log.Stop();
+  ASSERT_FALSE(log.IsEnabled());
+
+  const auto json = log.ExportToJson();
+  ASSERT_EQ(json.find("ignored_event"), std::string::npos);
+  ASSERT_NE(json.find("\"name\":\"test.recorded_event\""), std::string::npos);
+  ASSERT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+  ASSERT_NE(json.find("\"tid\":"), std::string::npos);
+}
+
+TEST(tracelog, ring_overwrites_oldest) {
+  auto &log = TraceLog::GetInstance();
+  log.Start(4u);
+  for (auto i = 0u; i < 100u; ++i) {
+    CARLA_TRACE_EVENT(test, wrapped_event);
+  }
+  log.Stop();
+
+  // Only the ring capacity survives.
+  const auto json = log.ExportToJson();
+  size_t count = 0u;
+  for (size_t pos = json.find("wrapped_event");
+      pos != std::string::npos;
+      pos = json.find("wrapped_event", pos + 1u)) {
+    ++count;
+  }
+  ASSERT_EQ(count, 4u);
+}
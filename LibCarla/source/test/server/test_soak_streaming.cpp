@@ -0,0 +1,272 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+/// Long-run soak of the streaming stack: a handful of persistent streams
+/// publish while clients and short-lived streams churn, and a sampler
+/// records RSS, buffer pool retention, dispatcher occupancy, and
+/// end-to-end latency as a CSV time series on stdout. At the end the run
+/// asserts that none of them drifted upwards, comparing the first third
+/// of the series against the last.
+///
+/// The duration defaults to a few seconds so the suite stays fast;
+/// export SOAK_DURATION_SECONDS (hours, if need be) to gate an upgrade
+/// before it rolls out:
+///
+///   SOAK_DURATION_SECONDS       total run time (default 8)
+///   SOAK_SAMPLE_PERIOD_SECONDS  sampling period (default 1)
+///   SOAK_STREAMS                persistent streams (default 4)
+///   SOAK_MESSAGE_SIZE           payload bytes (default 65536)
+///   SOAK_MAX_GROWTH             allowed last/first window ratio (default 1.5)
+
+#include "test.h"
+
+#include <carla/BufferPool.h>
+#include <carla/ThreadGroup.h>
+#include <carla/streaming/Client.h>
+#include <carla/streaming/Server.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(__linux__)
+#  include <unistd.h>
+#endif
+
+using namespace carla::streaming;
+using namespace std::chrono_literals;
+
+static double get_env_or(const char *name, double default_value) {
+  const char *value = std::getenv(name);
+  return value != nullptr ? std::atof(value) : default_value;
+}
+
+/// Resident set size in bytes, zero on platforms where we cannot read it.
+static size_t get_resident_set_size() {
+#if defined(__linux__)
+  std::ifstream statm("/proc/self/statm");
+  size_t size_pages = 0u;
+  size_t resident_pages = 0u;
+  statm >> size_pages >> resident_pages;
+  return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  return 0u;
+#endif
+}
+
+static int64_t steady_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+namespace {
+
+  struct Sample {
+    double time_seconds = 0.0;
+    double rss_mb = 0.0;
+    double pool_retained_mb = 0.0;
+    size_t pool_retained_count = 0u;
+    size_t alive_streams = 0u;
+    size_t map_entries = 0u;
+    double mean_latency_ms = 0.0;
+  };
+
+} // namespace
+
+TEST(soak_streaming, memory_stability) {
+  const auto duration =
+      std::chrono::duration<double>(get_env_or("SOAK_DURATION_SECONDS", 8.0));
+  const auto sample_period =
+      std::chrono::duration<double>(get_env_or("SOAK_SAMPLE_PERIOD_SECONDS", 1.0));
+  const auto number_of_streams =
+      static_cast<size_t>(get_env_or("SOAK_STREAMS", 4.0));
+  const auto message_size =
+      static_cast<size_t>(get_env_or("SOAK_MESSAGE_SIZE", 64.0 * 1024.0));
+  const double max_growth = get_env_or("SOAK_MAX_GROWTH", 1.5);
+
+  Server server(TESTING_PORT);
+  server.SetTimeout(1s);
+  server.AsyncRun(2u);
+
+  std::vector<Stream> streams;
+  for (auto i = 0u; i < number_of_streams; ++i) {
+    streams.push_back(server.MakeStream());
+  }
+
+  std::atomic_bool done{false};
+  std::atomic<uint64_t> latency_ns_sum{0u};
+  std::atomic<uint64_t> latency_count{0u};
+  std::atomic<uint64_t> messages_received{0u};
+  std::atomic<uint64_t> churn_cycles{0u};
+
+  // Persistent subscriber, measures end-to-end latency from the timestamp
+  // stamped at the front of each payload.
+  Client subscriber;
+  for (auto &stream : streams) {
+    subscriber.Subscribe(stream.token(), [&](carla::Buffer message) {
+      if (message.size() >= sizeof(int64_t)) {
+        int64_t sent_ns = 0;
+        std::memcpy(&sent_ns, message.data(), sizeof(sent_ns));
+        latency_ns_sum += static_cast<uint64_t>(
+            std::max<int64_t>(0, steady_now_ns() - sent_ns));
+        ++latency_count;
+      }
+      ++messages_received;
+    });
+  }
+  subscriber.AsyncRun(2u);
+
+  std::this_thread::sleep_for(1s); // let the subscriber connect.
+
+  carla::ThreadGroup threads;
+
+  // Writers, one per persistent stream at ~60FPS.
+  for (auto &stream : streams) {
+    threads.CreateThread([stream, &done, message_size]() mutable {
+      std::vector<unsigned char> payload(std::max(message_size, sizeof(int64_t)), 0u);
+      while (!done) {
+        const int64_t now_ns = steady_now_ns();
+        std::memcpy(payload.data(), &now_ns, sizeof(now_ns));
+        stream << payload;
+        std::this_thread::sleep_for(16ms);
+      }
+    });
+  }
+
+  // Client churn: subscribe to everything, listen for a while, drop the
+  // connections; exercises session (de)registration and reconnect paths.
+  threads.CreateThread([&]() {
+    while (!done) {
+      Client churn_client;
+      for (auto &stream : streams) {
+        churn_client.Subscribe(stream.token(), [](carla::Buffer) {});
+      }
+      churn_client.AsyncRun(1u);
+      std::this_thread::sleep_for(250ms);
+      ++churn_cycles;
+    }
+  });
+
+  // Stream churn: short-lived streams exercise the dispatcher map.
+  threads.CreateThread([&]() {
+    while (!done) {
+      auto stream = server.MakeStream();
+      stream << std::vector<unsigned char>(64u, 0u);
+      std::this_thread::sleep_for(50ms);
+    }
+  });
+
+  // Sampler, prints the time series and keeps it for the final checks.
+  std::vector<Sample> samples;
+  std::cout << "time_s,rss_mb,pool_mb,pool_buffers,alive_streams,map_entries,latency_ms"
+            << std::endl;
+  const auto start = std::chrono::steady_clock::now();
+  uint64_t previous_latency_sum = 0u;
+  uint64_t previous_latency_count = 0u;
+  while (std::chrono::steady_clock::now() - start < duration) {
+    std::this_thread::sleep_for(
+        std::chrono::duration_cast<std::chrono::milliseconds>(sample_period));
+
+    Sample sample;
+    sample.time_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sample.rss_mb = static_cast<double>(get_resident_set_size()) / (1024.0 * 1024.0);
+    sample.pool_retained_mb =
+        static_cast<double>(carla::BufferPool::GetTotalRetainedBytes()) / (1024.0 * 1024.0);
+    sample.pool_retained_count = carla::BufferPool::GetTotalRetainedCount();
+    const auto map_stats = server.CountStreams();
+    sample.alive_streams = map_stats.alive_streams;
+    sample.map_entries = map_stats.map_entries;
+
+    const auto sum = latency_ns_sum.load();
+    const auto count = latency_count.load();
+    if (count > previous_latency_count) {
+      sample.mean_latency_ms =
+          static_cast<double>(sum - previous_latency_sum) /
+          static_cast<double>(count - previous_latency_count) / 1e6;
+    }
+    previous_latency_sum = sum;
+    previous_latency_count = count;
+
+    std::cout << sample.time_seconds << ','
+              << sample.rss_mb << ','
+              << sample.pool_retained_mb << ','
+              << sample.pool_retained_count << ','
+              << sample.alive_streams << ','
+              << sample.map_entries << ','
+              << sample.mean_latency_ms << std::endl;
+    samples.push_back(sample);
+  }
+
+  done = true;
+  threads.JoinAll();
+
+  std::cout << "received " << messages_received
+            << " messages over " << churn_cycles
+            << " client churn cycles." << std::endl;
+
+  ASSERT_GE(samples.size(), 2u);
+  EXPECT_GT(messages_received, 0u);
+  EXPECT_GT(churn_cycles, 0u);
+
+  // Average of a metric over the first or last third of the series.
+  const auto window_average = [&samples](bool last, auto &&getter) {
+    const size_t window = std::max<size_t>(1u, samples.size() / 3u);
+    const size_t begin = last ? samples.size() - window : 0u;
+    double total = 0.0;
+    for (size_t i = begin; i < begin + window; ++i) {
+      total += static_cast<double>(getter(samples[i]));
+    }
+    return total / static_cast<double>(window);
+  };
+
+  // Growth checks with absolute slack so tiny first windows don't trip the
+  // ratio; only hard failures in release, debug builds are too noisy.
+  const auto check_bounded = [max_growth](
+      const char *name, double first, double last, double slack) {
+    const double limit = first * max_growth + slack;
+    std::cout << name << ": first window " << first
+              << ", last window " << last
+              << ", limit " << limit << std::endl;
+#ifdef NDEBUG
+    EXPECT_LE(last, limit) << name << " drifted upwards during the soak";
+#else
+    if (last > limit) {
+      carla::log_warning(name, "drifted upwards during the soak:", last, '>', limit);
+    }
+#endif // NDEBUG
+  };
+
+  if (get_resident_set_size() > 0u) {
+    check_bounded(
+        "rss_mb",
+        window_average(false, [](const Sample &s) { return s.rss_mb; }),
+        window_average(true, [](const Sample &s) { return s.rss_mb; }),
+        64.0); // MB
+  }
+  check_bounded(
+      "pool_mb",
+      window_average(false, [](const Sample &s) { return s.pool_retained_mb; }),
+      window_average(true, [](const Sample &s) { return s.pool_retained_mb; }),
+      16.0); // MB
+  check_bounded(
+      "map_entries",
+      window_average(false, [](const Sample &s) { return s.map_entries; }),
+      window_average(true, [](const Sample &s) { return s.map_entries; }),
+      16.0); // entries
+  check_bounded(
+      "latency_ms",
+      window_average(false, [](const Sample &s) { return s.mean_latency_ms; }),
+      window_average(true, [](const Sample &s) { return s.mean_latency_ms; }),
+      50.0); // ms
+
+  // The churned streams must have expired, only the persistent ones (and at
+  // most the churn stream in flight) may remain alive.
+  EXPECT_LE(samples.back().alive_streams, number_of_streams + 1u);
+}
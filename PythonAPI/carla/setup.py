@@ -88,6 +88,8 @@ def get_libcarla_extensions():
             else:
                 extra_link_args += ['-lpng', '-ljpeg', '-ltiff']
                 extra_compile_args += ['-DLIBCARLA_IMAGE_WITH_PNG_SUPPORT=true']
+            extra_link_args += ['-lz']
+            extra_compile_args += ['-DLIBCARLA_STREAMING_WITH_ZLIB_SUPPORT=true']
             # @todo Why would we need this?
             # include_dirs += ['/usr/lib/gcc/x86_64-linux-gnu/7/include']
             # library_dirs += ['/usr/lib/gcc/x86_64-linux-gnu/7']
@@ -123,7 +125,8 @@ def get_libcarla_extensions():
             '/experimental:external', '/external:I', 'dependencies/include/system',
             '/DBOOST_ALL_NO_LIB', '/DBOOST_PYTHON_STATIC_LIB',
             '/DBOOST_ERROR_CODE_HEADER_ONLY', '/D_WIN32_WINNT=0x0600', '/DHAVE_SNPRINTF',
-            '/DLIBCARLA_WITH_PYTHON_SUPPORT', '-DLIBCARLA_IMAGE_WITH_PNG_SUPPORT=true']
+            '/DLIBCARLA_WITH_PYTHON_SUPPORT', '-DLIBCARLA_IMAGE_WITH_PNG_SUPPORT=true',
+            '-DLIBCARLA_STREAMING_WITH_ZLIB_SUPPORT=true']
     else:
         raise NotImplementedError
 
@@ -50,6 +50,55 @@ static void ApplyControl(carla::client::Walker &self, const ControlT &control) {
   self.ApplyControl(control);
 }
 
+static void StartWalkerFleet(
+    const boost::python::list &controllers,
+    const boost::python::list &destinations,
+    const boost::python::list &speeds) {
+  namespace py = boost::python;
+  using ControllerPtr = carla::SharedPtr<carla::client::WalkerAIController>;
+  std::vector<ControllerPtr> fleet{
+      py::stl_input_iterator<ControllerPtr>(controllers),
+      py::stl_input_iterator<ControllerPtr>()};
+  std::vector<carla::geom::Location> fleet_destinations{
+      py::stl_input_iterator<carla::geom::Location>(destinations),
+      py::stl_input_iterator<carla::geom::Location>()};
+  std::vector<float> fleet_speeds{
+      py::stl_input_iterator<float>(speeds),
+      py::stl_input_iterator<float>()};
+  carla::PythonUtil::ReleaseGIL unlock;
+  carla::client::WalkerAIController::StartFleet(fleet, fleet_destinations, fleet_speeds);
+}
+
+static void WalkerFleetGoToLocations(const boost::python::list &requests) {
+  namespace py = boost::python;
+  using ControllerPtr = carla::SharedPtr<carla::client::WalkerAIController>;
+  std::vector<std::pair<ControllerPtr, carla::geom::Location>> result;
+  result.reserve(static_cast<size_t>(py::len(requests)));
+  for (py::ssize_t i = 0u; i < py::len(requests); ++i) {
+    py::object request = requests[i];
+    result.emplace_back(
+        py::extract<ControllerPtr>(request[0]),
+        py::extract<carla::geom::Location>(request[1]));
+  }
+  carla::PythonUtil::ReleaseGIL unlock;
+  carla::client::WalkerAIController::GoToLocations(result);
+}
+
+static void WalkerFleetSetMaxSpeeds(const boost::python::list &requests) {
+  namespace py = boost::python;
+  using ControllerPtr = carla::SharedPtr<carla::client::WalkerAIController>;
+  std::vector<std::pair<ControllerPtr, float>> result;
+  result.reserve(static_cast<size_t>(py::len(requests)));
+  for (py::ssize_t i = 0u; i < py::len(requests); ++i) {
+    py::object request = requests[i];
+    result.emplace_back(
+        py::extract<ControllerPtr>(request[0]),
+        py::extract<float>(request[1]));
+  }
+  carla::PythonUtil::ReleaseGIL unlock;
+  carla::client::WalkerAIController::SetMaxSpeeds(result);
+}
+
 void export_actor() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -138,6 +187,13 @@ void export_actor() {
     .def("stop", &cc::WalkerAIController::Stop)
     .def("go_to_location", &cc::WalkerAIController::GoToLocation, (arg("destination")))
     .def("set_max_speed", &cc::WalkerAIController::SetMaxSpeed, (arg("speed")))
+    .def("start_fleet", &StartWalkerFleet,
+        (arg("controllers"), arg("destinations") = boost::python::list(), arg("speeds") = boost::python::list()))
+    .staticmethod("start_fleet")
+    .def("go_to_locations", &WalkerFleetGoToLocations, (arg("requests")))
+    .staticmethod("go_to_locations")
+    .def("set_max_speeds", &WalkerFleetSetMaxSpeeds, (arg("requests")))
+    .staticmethod("set_max_speeds")
     .def(self_ns::str(self_ns::self))
   ;
 
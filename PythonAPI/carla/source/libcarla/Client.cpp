@@ -28,14 +28,78 @@ static auto GetAvailableMaps(const carla::client::Client &self) {
   return result;
 }
 
+static boost::python::object RedirectSensorStream(
+    carla::client::Client &self,
+    carla::rpc::ActorId actor_id,
+    std::string host,
+    uint16_t port) {
+  std::vector<uint8_t> token;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    token = self.RedirectSensorStream(actor_id, std::move(host), port);
+  }
+  return boost::python::object(boost::python::handle<>(PyBytes_FromStringAndSize(
+      reinterpret_cast<const char *>(token.data()),
+      static_cast<Py_ssize_t>(token.size()))));
+}
+
+static void AdoptSensorStream(
+    carla::client::Client &self,
+    carla::rpc::ActorId actor_id,
+    const boost::python::object &token) {
+  char *data = nullptr;
+  Py_ssize_t size = 0;
+  if (PyBytes_AsStringAndSize(token.ptr(), &data, &size) != 0) {
+    boost::python::throw_error_already_set();
+  }
+  std::vector<uint8_t> bytes(data, data + size);
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.AdoptSensorStream(actor_id, std::move(bytes));
+}
+
+static auto ExchangeActorStates(
+    const carla::client::Client &self,
+    const boost::python::object &updates,
+    const boost::python::object &query_ids) {
+  namespace rpc = carla::rpc;
+  std::vector<rpc::ActorTransformUpdate> ups{
+    boost::python::stl_input_iterator<rpc::ActorTransformUpdate>(updates),
+    boost::python::stl_input_iterator<rpc::ActorTransformUpdate>()};
+  std::vector<rpc::ActorId> ids{
+    boost::python::stl_input_iterator<rpc::ActorId>(query_ids),
+    boost::python::stl_input_iterator<rpc::ActorId>()};
+  std::vector<rpc::ActorSyncState> states;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    states = self.ExchangeActorStates(ups, ids);
+  }
+  boost::python::list result;
+  for (const auto &state : states) {
+    result.append(state);
+  }
+  return result;
+}
+
+// Extract a command list, either copying a natively built
+// command.CommandSequence or iterating a regular Python sequence.
+static std::vector<carla::rpc::Command> ExtractCommands(
+    const boost::python::object &commands) {
+  using CommandType = carla::rpc::Command;
+  boost::python::extract<const std::vector<CommandType> &> batch(commands);
+  if (batch.check()) {
+    return batch();
+  }
+  return {
+    boost::python::stl_input_iterator<CommandType>(commands),
+    boost::python::stl_input_iterator<CommandType>()};
+}
+
 static void ApplyBatchCommands(
     const carla::client::Client &self,
     const boost::python::object &commands,
     bool do_tick) {
-  using CommandType = carla::rpc::Command;
-  std::vector<CommandType> cmds{
-    boost::python::stl_input_iterator<CommandType>(commands),
-        boost::python::stl_input_iterator<CommandType>()};
+  auto cmds = ExtractCommands(commands);
+  carla::PythonUtil::ReleaseGIL unlock;
   self.ApplyBatch(std::move(cmds), do_tick);
 }
 
@@ -45,16 +109,13 @@ static auto ApplyBatchCommandsSync(
     bool do_tick) {
 
   using CommandType = carla::rpc::Command;
-  std::vector<CommandType> cmds {
-    boost::python::stl_input_iterator<CommandType>(commands),
-    boost::python::stl_input_iterator<CommandType>()
-  };
+  auto cmds = ExtractCommands(commands);
 
-  boost::python::list result;
+  // The batch RPC and the autopilot bookkeeping below are pure native work,
+  // run them with the GIL released so other Python threads are not stalled
+  // by our longest blocking call.
+  carla::PythonUtil::ReleaseGIL unlock;
   auto responses = self.ApplyBatchSync(cmds, do_tick);
-  for (auto &response : responses) {
-    result.append(std::move(response));
-  }
 
   // check for autopilot command
   std::vector<carla::traffic_manager::ActorPtr> vehicles_to_enable(cmds.size(), nullptr);
@@ -152,6 +213,13 @@ static auto ApplyBatchCommandsSync(
     self.GetInstanceTM(tm_port).UnregisterVehicles(vehicles_to_disable);
   }
 
+  // Building the result list needs the GIL back.
+  carla::PythonUtil::AcquireGIL lock;
+  boost::python::list result;
+  for (auto &response : responses) {
+    result.append(std::move(response));
+  }
+
   return result;
 }
 
@@ -170,25 +238,106 @@ void export_client() {
     .def_readwrite("enable_mesh_visibility", &rpc::OpendriveGenerationParameters::enable_mesh_visibility)
   ;
 
+  class_<rpc::ObjectCounter>("ObjectCounter", no_init)
+    .def_readonly("type_name", &rpc::ObjectCounter::type_name)
+    .def_readonly("live", &rpc::ObjectCounter::live)
+    .def_readonly("peak", &rpc::ObjectCounter::peak)
+    .def_readonly("total", &rpc::ObjectCounter::total)
+  ;
+
+  class_<rpc::ObjectCensus>("ObjectCensus", no_init)
+    .add_property("counters", +[](const rpc::ObjectCensus &self) {
+      boost::python::list result;
+      for (const auto &counter : self.counters) {
+        result.append(counter);
+      }
+      return result;
+    })
+    .def_readonly("pooled_buffer_count", &rpc::ObjectCensus::pooled_buffer_count)
+    .def_readonly("pooled_buffer_bytes", &rpc::ObjectCensus::pooled_buffer_bytes)
+  ;
+
+  class_<rpc::ActorTransformUpdate>("ActorTransformUpdate",
+      init<rpc::ActorId, carla::geom::Transform>((arg("actor_id"), arg("transform"))))
+    .def(init<rpc::ActorId, carla::geom::Transform, uint32_t>(
+        (arg("actor_id"), arg("transform"), arg("light_state"))))
+    .def_readwrite("actor_id", &rpc::ActorTransformUpdate::actor)
+    .def_readwrite("transform", &rpc::ActorTransformUpdate::transform)
+    .def_readwrite("has_light_state", &rpc::ActorTransformUpdate::has_light_state)
+    .def_readwrite("light_state", &rpc::ActorTransformUpdate::light_state)
+  ;
+
+  class_<rpc::ActorSyncState>("ActorSyncState", no_init)
+    .def_readonly("actor_id", &rpc::ActorSyncState::actor)
+    .def_readonly("transform", &rpc::ActorSyncState::transform)
+    .def_readonly("velocity", &rpc::ActorSyncState::velocity)
+    .def_readonly("light_state", &rpc::ActorSyncState::light_state)
+  ;
+
+  class_<rpc::BufferPoolStats>("BufferPoolStats", no_init)
+    .def_readonly("name", &rpc::BufferPoolStats::name)
+    .def_readonly("hits", &rpc::BufferPoolStats::hits)
+    .def_readonly("misses", &rpc::BufferPoolStats::misses)
+    .def_readonly("discards", &rpc::BufferPoolStats::discards)
+    .def_readonly("retained_count", &rpc::BufferPoolStats::retained_count)
+    .def_readonly("retained_bytes", &rpc::BufferPoolStats::retained_bytes)
+    .def_readonly("peak_retained_bytes", &rpc::BufferPoolStats::peak_retained_bytes)
+  ;
+
+  class_<rpc::FrameSectionStats>("FrameSectionStats", no_init)
+    .def_readonly("name", &rpc::FrameSectionStats::name)
+    .def_readonly("last_ms", &rpc::FrameSectionStats::last_ms)
+    .def_readonly("mean_ms", &rpc::FrameSectionStats::mean_ms)
+    .def_readonly("p50_ms", &rpc::FrameSectionStats::p50_ms)
+    .def_readonly("p90_ms", &rpc::FrameSectionStats::p90_ms)
+    .def_readonly("p99_ms", &rpc::FrameSectionStats::p99_ms)
+  ;
+
+  class_<rpc::FrameStats>("FrameStats", no_init)
+    .def_readonly("frame_count", &rpc::FrameStats::frame_count)
+    .def_readonly("window_size", &rpc::FrameStats::window_size)
+    .add_property("sections", +[](const rpc::FrameStats &self) {
+      boost::python::list result;
+      for (const auto &section : self.sections) {
+        result.append(section);
+      }
+      return result;
+    })
+  ;
+
   class_<cc::Client>("Client",
       init<std::string, uint16_t, size_t>((arg("host"), arg("port"), arg("worker_threads")=0u)))
     .def("set_timeout", &::SetTimeout, (arg("seconds")))
+    .def("set_rpc_lanes", CONST_CALL_WITHOUT_GIL_1(cc::Client, SetRpcLanes, size_t), (arg("count")))
+    .def("get_rpc_lanes", CONST_CALL_WITHOUT_GIL(cc::Client, GetRpcLanes))
     .def("get_client_version", &cc::Client::GetClientVersion)
     .def("get_server_version", CONST_CALL_WITHOUT_GIL(cc::Client, GetServerVersion))
-    .def("get_world", &cc::Client::GetWorld)
+    .def("get_world", CONST_CALL_WITHOUT_GIL(cc::Client, GetWorld))
     .def("get_available_maps", &GetAvailableMaps)
     .def("reload_world", CONST_CALL_WITHOUT_GIL(cc::Client, ReloadWorld))
+    .def("reset_world", CONST_CALL_WITHOUT_GIL_2(cc::Client, ResetWorld, bool, bool),
+        (arg("reset_settings")=true, arg("reset_weather")=true))
     .def("load_world", CONST_CALL_WITHOUT_GIL_1(cc::Client, LoadWorld, std::string), (arg("map_name")))
     .def("generate_opendrive_world", CONST_CALL_WITHOUT_GIL_2(cc::Client, GenerateOpenDriveWorld, std::string,
         rpc::OpendriveGenerationParameters), (arg("opendrive"), arg("parameters")=rpc::OpendriveGenerationParameters()))
-    .def("start_recorder", CALL_WITHOUT_GIL_1(cc::Client, StartRecorder, std::string), (arg("name")))
-    .def("stop_recorder", &cc::Client::StopRecorder)
+    .def("start_trace", CALL_WITHOUT_GIL_1(cc::Client, StartTrace, uint64_t), (arg("max_events")=1u << 20))
+    .def("stop_trace", CALL_WITHOUT_GIL(cc::Client, StopTrace))
+    .def("get_trace", CALL_WITHOUT_GIL(cc::Client, GetTrace))
+    .def("get_object_census", CONST_CALL_WITHOUT_GIL(cc::Client, GetObjectCensus))
+    .def("get_frame_stats", CONST_CALL_WITHOUT_GIL(cc::Client, GetFrameStats))
+    .def("get_buffer_pool_stats", CALL_RETURNING_LIST_WITHOUT_GIL(cc::Client, GetBufferPoolStats))
+    .def("exchange_actor_states", &ExchangeActorStates, (arg("updates"), arg("query_ids")))
+    .def("start_recorder", CALL_WITHOUT_GIL_2(cc::Client, StartRecorder, std::string, std::string), (arg("name"), arg("filter")=""))
+    .def("stop_recorder", CALL_WITHOUT_GIL(cc::Client, StopRecorder))
     .def("show_recorder_file_info", CALL_WITHOUT_GIL_2(cc::Client, ShowRecorderFileInfo, std::string, bool), (arg("name"), arg("show_all")))
     .def("show_recorder_collisions", CALL_WITHOUT_GIL_3(cc::Client, ShowRecorderCollisions, std::string, char, char), (arg("name"), arg("type1"), arg("type2")))
     .def("show_recorder_actors_blocked", CALL_WITHOUT_GIL_3(cc::Client, ShowRecorderActorsBlocked, std::string, double, double), (arg("name"), arg("min_time"), arg("min_distance")))
     .def("replay_file", CALL_WITHOUT_GIL_4(cc::Client, ReplayFile, std::string, double, double, uint32_t), (arg("name"), arg("time_start"), arg("duration"), arg("follow_id")))
-    .def("set_replayer_time_factor", &cc::Client::SetReplayerTimeFactor, (arg("time_factor")))
-    .def("set_replayer_ignore_hero", &cc::Client::SetReplayerIgnoreHero, (arg("ignore_hero")))
+    .def("set_replayer_time_factor", CALL_WITHOUT_GIL_1(cc::Client, SetReplayerTimeFactor, double), (arg("time_factor")))
+    .def("set_replayer_ignore_hero", CALL_WITHOUT_GIL_1(cc::Client, SetReplayerIgnoreHero, bool), (arg("ignore_hero")))
+    .def("fast_forward_replayer", CALL_WITHOUT_GIL_1(cc::Client, FastForwardReplayer, double), (arg("time")))
+    .def("redirect_sensor_stream", &RedirectSensorStream, (arg("actor_id"), arg("host"), arg("port")))
+    .def("adopt_sensor_stream", &AdoptSensorStream, (arg("actor_id"), arg("token")))
     .def("apply_batch", &ApplyBatchCommands, (arg("commands"), arg("do_tick")=false))
     .def("apply_batch_sync", &ApplyBatchCommandsSync, (arg("commands"), arg("do_tick")=false))
     .def("get_trafficmanager", CONST_CALL_WITHOUT_GIL_1(cc::Client, GetInstanceTM, uint16_t), (arg("port")=TM_DEFAULT_PORT))
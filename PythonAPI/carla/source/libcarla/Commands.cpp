@@ -8,10 +8,129 @@
 #include <carla/rpc/Command.h>
 #include <carla/rpc/CommandResponse.h>
 
+#include <memory>
+#include <stdexcept>
+
 #define TM_DEFAULT_PORT     8000
 
 namespace command_impl {
 
+  /// Lightweight view over a one-dimensional contiguous Python buffer (e.g.
+  /// a numpy array); keeps the buffer alive for the lifetime of the view.
+  class BufferColumn {
+  public:
+
+    explicit BufferColumn(const boost::python::object &obj)
+      : _view() {
+      if (PyObject_GetBuffer(obj.ptr(), &_view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) != 0) {
+        boost::python::throw_error_already_set();
+      }
+      _format = (_view.format != nullptr) ? _view.format : "B";
+      // Skip the byte-order prefix, native arrays may carry one.
+      if ((*_format == '@') || (*_format == '=') || (*_format == '<') ||
+          (*_format == '>') || (*_format == '!')) {
+        ++_format;
+      }
+    }
+
+    ~BufferColumn() {
+      PyBuffer_Release(&_view);
+    }
+
+    BufferColumn(const BufferColumn &) = delete;
+    BufferColumn &operator=(const BufferColumn &) = delete;
+
+    size_t size() const {
+      return (_view.itemsize > 0) ? static_cast<size_t>(_view.len / _view.itemsize) : 0u;
+    }
+
+    /// Read element @a i converted to T, whatever the element type of the
+    /// underlying buffer.
+    template <typename T>
+    T Get(size_t i) const {
+      const char *ptr = static_cast<const char *>(_view.buf) + i * _view.itemsize;
+      switch (*_format) {
+        case 'f': return static_cast<T>(*reinterpret_cast<const float *>(ptr));
+        case 'd': return static_cast<T>(*reinterpret_cast<const double *>(ptr));
+        case 'b': return static_cast<T>(*reinterpret_cast<const int8_t *>(ptr));
+        case '?':
+        case 'B': return static_cast<T>(*reinterpret_cast<const uint8_t *>(ptr));
+        case 'h': return static_cast<T>(*reinterpret_cast<const int16_t *>(ptr));
+        case 'H': return static_cast<T>(*reinterpret_cast<const uint16_t *>(ptr));
+        case 'i': return static_cast<T>(*reinterpret_cast<const int32_t *>(ptr));
+        case 'I': return static_cast<T>(*reinterpret_cast<const uint32_t *>(ptr));
+        case 'l':
+        case 'q': return (_view.itemsize == 8) ?
+            static_cast<T>(*reinterpret_cast<const int64_t *>(ptr)) :
+            static_cast<T>(*reinterpret_cast<const int32_t *>(ptr));
+        case 'L':
+        case 'Q': return (_view.itemsize == 8) ?
+            static_cast<T>(*reinterpret_cast<const uint64_t *>(ptr)) :
+            static_cast<T>(*reinterpret_cast<const uint32_t *>(ptr));
+        default:
+          throw std::invalid_argument(
+              std::string("unsupported buffer format '") + *_format + "'");
+      }
+    }
+
+  private:
+
+    Py_buffer _view;
+
+    const char *_format;
+  };
+
+  /// Build a whole batch of ApplyVehicleControl commands from parallel
+  /// columns in one native pass, skipping the per-command Python objects.
+  static std::vector<carla::rpc::Command> MakeVehicleControlBatch(
+      const boost::python::object &actor_ids,
+      const boost::python::object &throttle,
+      const boost::python::object &steer,
+      const boost::python::object &brake,
+      const boost::python::object &hand_brake,
+      const boost::python::object &reverse) {
+    const BufferColumn ids(actor_ids);
+    const BufferColumn throttles(throttle);
+    const BufferColumn steers(steer);
+    const BufferColumn brakes(brake);
+    std::unique_ptr<const BufferColumn> hand_brakes;
+    if (!hand_brake.is_none()) {
+      hand_brakes = std::make_unique<const BufferColumn>(hand_brake);
+    }
+    std::unique_ptr<const BufferColumn> reverses;
+    if (!reverse.is_none()) {
+      reverses = std::make_unique<const BufferColumn>(reverse);
+    }
+
+    const size_t count = ids.size();
+    if ((throttles.size() != count) ||
+        (steers.size() != count) ||
+        (brakes.size() != count) ||
+        ((hand_brakes != nullptr) && (hand_brakes->size() != count)) ||
+        ((reverses != nullptr) && (reverses->size() != count))) {
+      throw std::invalid_argument("ApplyVehicleControlBatch: columns have mismatching lengths");
+    }
+
+    std::vector<carla::rpc::Command> result;
+    result.reserve(count);
+    for (size_t i = 0u; i < count; ++i) {
+      carla::rpc::VehicleControl control;
+      control.throttle = throttles.Get<float>(i);
+      control.steer = steers.Get<float>(i);
+      control.brake = brakes.Get<float>(i);
+      if (hand_brakes != nullptr) {
+        control.hand_brake = hand_brakes->Get<bool>(i);
+      }
+      if (reverses != nullptr) {
+        control.reverse = reverses->Get<bool>(i);
+      }
+      result.emplace_back(carla::rpc::Command::ApplyVehicleControl{
+          ids.Get<carla::rpc::ActorId>(i),
+          control});
+    }
+    return result;
+  }
+
   template <typename T>
   const T &Convert(const T &in) {
     return in;
@@ -166,6 +285,22 @@ void export_commands() {
     .def_readwrite("enabled", &cr::Command::SetAutopilot::enabled)
   ;
 
+  // A command batch built natively, accepted directly by Client.apply_batch
+  // and Client.apply_batch_sync.
+  class_<std::vector<cr::Command>>("CommandSequence", no_init)
+    .def("__len__", +[](const std::vector<cr::Command> &self) {
+      return self.size();
+    })
+  ;
+
+  def("ApplyVehicleControlBatch", &command_impl::MakeVehicleControlBatch,
+      (arg("actor_ids"),
+       arg("throttle"),
+       arg("steer"),
+       arg("brake"),
+       arg("hand_brake") = object(),
+       arg("reverse") = object()));
+
   implicitly_convertible<cr::Command::SpawnActor, cr::Command>();
   implicitly_convertible<cr::Command::DestroyActor, cr::Command>();
   implicitly_convertible<cr::Command::ApplyVehicleControl, cr::Command>();
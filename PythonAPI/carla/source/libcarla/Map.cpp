@@ -13,8 +13,13 @@
 #include <carla/client/Landmark.h>
 #include <carla/road/SignalType.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
 #include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace carla {
 namespace client {
@@ -44,7 +49,10 @@ static void SaveOpenDriveToDisk(const carla::client::Map &self, std::string path
 
 static auto GetTopology(const carla::client::Map &self) {
   namespace py = boost::python;
-  auto topology = self.GetTopology();
+  auto topology = [&self]() {
+    carla::PythonUtil::ReleaseGIL unlock;
+    return self.GetTopology();
+  }();
   py::list result;
   for (auto &&pair : topology) {
     result.append(py::make_tuple(pair.first, pair.second));
@@ -78,6 +86,204 @@ static carla::geom::GeoLocation ToGeolocation(
   return self.GetGeoReference().Transform(location);
 }
 
+static auto ToGeolocationList(
+    const carla::client::Map &self,
+    const boost::python::list &locations) {
+  namespace py = boost::python;
+  std::vector<carla::geom::Location> input{
+      py::stl_input_iterator<carla::geom::Location>(locations),
+      py::stl_input_iterator<carla::geom::Location>()};
+  std::vector<carla::geom::GeoLocation> output(input.size());
+  self.GetGeoReference().Transform(input.data(), input.size(), output.data());
+  py::list result;
+  for (const auto &geo_location : output) {
+    result.append(geo_location);
+  }
+  return result;
+}
+
+/// Dense set of map waypoints kept as the road-layer PODs instead of one
+/// Python Waypoint object per element.
+///
+/// Attribute arrays (ids, transforms, lane widths) are resolved natively
+/// against road::Map in one batched pass on first access and cached, then
+/// exported zero-copy through "__array_interface__". Individual elements
+/// can still be materialized as full Waypoint objects with indexing.
+class WaypointCollection {
+public:
+
+  WaypointCollection(
+      carla::SharedPtr<const carla::client::Map> map,
+      std::vector<carla::road::element::Waypoint> waypoints)
+    : _map(std::move(map)),
+      _waypoints(std::move(waypoints)) {}
+
+  size_t size() const {
+    return _waypoints.size();
+  }
+
+  const carla::road::element::Waypoint &at(size_t pos) const {
+    return _waypoints.at(pos);
+  }
+
+  const carla::SharedPtr<const carla::client::Map> &GetParentMap() const {
+    return _map;
+  }
+
+  const std::vector<carla::road::element::Waypoint> &GetWaypoints() const {
+    return _waypoints;
+  }
+
+  /// @note The lazy caches below are not synchronized, the GIL already
+  /// serializes the property accesses that fill them.
+
+  const std::vector<uint64_t> &GetIds() const {
+    if (_ids.empty() && !_waypoints.empty()) {
+      std::hash<carla::road::element::Waypoint> hasher;
+      _ids.reserve(_waypoints.size());
+      for (const auto &waypoint : _waypoints) {
+        _ids.emplace_back(hasher(waypoint));
+      }
+    }
+    return _ids;
+  }
+
+  const std::vector<carla::geom::Transform> &GetTransforms() const {
+    if (_transforms.empty() && !_waypoints.empty()) {
+      _transforms.resize(_waypoints.size());
+      _map->GetMap().ComputeTransforms(
+          _waypoints.data(),
+          _waypoints.size(),
+          _transforms.data());
+    }
+    return _transforms;
+  }
+
+  const std::vector<double> &GetLaneWidths() const {
+    if (_lane_widths.empty() && !_waypoints.empty()) {
+      const auto &road_map = _map->GetMap();
+      _lane_widths.reserve(_waypoints.size());
+      for (const auto &waypoint : _waypoints) {
+        _lane_widths.emplace_back(road_map.GetLaneWidth(waypoint));
+      }
+    }
+    return _lane_widths;
+  }
+
+private:
+
+  carla::SharedPtr<const carla::client::Map> _map;
+
+  std::vector<carla::road::element::Waypoint> _waypoints;
+
+  mutable std::vector<uint64_t> _ids;
+
+  mutable std::vector<carla::geom::Transform> _transforms;
+
+  mutable std::vector<double> _lane_widths;
+};
+
+/// Structured dtype of one road::element::Waypoint record.
+static boost::python::list MakeWaypointDescr() {
+  namespace py = boost::python;
+  using carla::road::element::Waypoint;
+  py::list descr;
+  descr.append(py::make_tuple("road_id", "<u4"));
+  descr.append(py::make_tuple("section_id", "<u4"));
+  descr.append(py::make_tuple("lane_id", "<i4"));
+  AppendPaddingField(descr, offsetof(Waypoint, s) - (offsetof(Waypoint, lane_id) + sizeof(carla::road::LaneId)));
+  descr.append(py::make_tuple("s", "<f8"));
+  AppendPaddingField(descr, sizeof(Waypoint) - (offsetof(Waypoint, s) + sizeof(double)));
+  return descr;
+}
+
+static PyArrayExporter GetWaypointCollectionIds(boost::python::object self) {
+  auto &collection = boost::python::extract<WaypointCollection &>(self)();
+  const auto &ids = collection.GetIds();
+  return {self, MakeArrayInterface(ids.data(), "<u8", boost::python::make_tuple(ids.size()), true)};
+}
+
+static PyArrayExporter GetWaypointCollectionWaypoints(boost::python::object self) {
+  auto &collection = boost::python::extract<WaypointCollection &>(self)();
+  const auto &waypoints = collection.GetWaypoints();
+  auto interface = MakeArrayInterface(
+      waypoints.data(),
+      "|V" + std::to_string(sizeof(carla::road::element::Waypoint)),
+      boost::python::make_tuple(waypoints.size()),
+      true);
+  interface["descr"] = MakeWaypointDescr();
+  return {self, interface};
+}
+
+static PyArrayExporter GetWaypointCollectionTransforms(boost::python::object self) {
+  auto &collection = boost::python::extract<WaypointCollection &>(self)();
+  const auto &transforms = collection.GetTransforms();
+  static_assert(
+      sizeof(carla::geom::Transform) == 6u * sizeof(float),
+      "Invalid transform layout.");
+  // Row layout follows the transform: x, y, z, pitch, yaw, roll.
+  return {self, MakeArrayInterface(
+      transforms.data(),
+      "<f4",
+      boost::python::make_tuple(transforms.size(), 6u),
+      true)};
+}
+
+static PyArrayExporter GetWaypointCollectionLaneWidths(boost::python::object self) {
+  auto &collection = boost::python::extract<WaypointCollection &>(self)();
+  const auto &widths = collection.GetLaneWidths();
+  return {self, MakeArrayInterface(widths.data(), "<f8", boost::python::make_tuple(widths.size()), true)};
+}
+
+static carla::SharedPtr<carla::client::Waypoint> GetWaypointCollectionItem(
+    const WaypointCollection &self,
+    size_t pos) {
+  if (pos >= self.size()) {
+    PyErr_SetString(PyExc_IndexError, "waypoint index out of range");
+    boost::python::throw_error_already_set();
+  }
+  const auto &waypoint = self.at(pos);
+  return self.GetParentMap()->GetWaypointXODR(
+      waypoint.road_id,
+      waypoint.lane_id,
+      static_cast<float>(waypoint.s));
+}
+
+static boost::shared_ptr<WaypointCollection> GenerateWaypointCollection(
+    carla::SharedPtr<const carla::client::Map> self,
+    double distance) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return boost::shared_ptr<WaypointCollection>(
+      new WaypointCollection(self, self->GetMap().GenerateWaypoints(distance)));
+}
+
+static boost::shared_ptr<WaypointCollection> GenerateRoadWaypointCollection(
+    carla::SharedPtr<const carla::client::Map> self,
+    carla::road::RoadId road_id,
+    double distance) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return boost::shared_ptr<WaypointCollection>(
+      new WaypointCollection(self, self->GetMap().GenerateRoadWaypoints(road_id, distance)));
+}
+
+/// Topology edges as one (N, 2) structured array of waypoint records,
+/// zero-copy over the map's cached topology index.
+static PyArrayExporter GetTopologyArray(boost::python::object self) {
+  using Edge = std::pair<carla::road::element::Waypoint, carla::road::element::Waypoint>;
+  auto &map = boost::python::extract<carla::client::Map &>(self)();
+  auto span = map.GetTopologyEdges();
+  static_assert(
+      sizeof(Edge) == 2u * sizeof(carla::road::element::Waypoint),
+      "Invalid topology edge layout.");
+  auto interface = MakeArrayInterface(
+      span.begin(),
+      "|V" + std::to_string(sizeof(carla::road::element::Waypoint)),
+      boost::python::make_tuple(span.size(), 2u),
+      true);
+  interface["descr"] = MakeWaypointDescr();
+  return {self, interface};
+}
+
 void export_map() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -154,21 +360,38 @@ void export_map() {
   // -- Map --------------------------------------------------------------------
   // ===========================================================================
 
+  class_<WaypointCollection, boost::noncopyable, boost::shared_ptr<WaypointCollection>>("WaypointCollection", no_init)
+    .add_property("ids", &GetWaypointCollectionIds)
+    .add_property("waypoints", &GetWaypointCollectionWaypoints)
+    .add_property("transforms", &GetWaypointCollectionTransforms)
+    .add_property("lane_widths", &GetWaypointCollectionLaneWidths)
+    .def("__len__", &WaypointCollection::size)
+    .def("__getitem__", &GetWaypointCollectionItem, (arg("index")))
+  ;
+
   class_<cc::Map, boost::noncopyable, boost::shared_ptr<cc::Map>>("Map", no_init)
     .def(init<std::string, std::string>((arg("name"), arg("xodr_content"))))
     .add_property("name", CALL_RETURNING_COPY(cc::Map, GetName))
-    .def("get_spawn_points", CALL_RETURNING_LIST(cc::Map, GetRecommendedSpawnPoints))
-    .def("get_waypoint", &cc::Map::GetWaypoint, (arg("location"), arg("project_to_road")=true, arg("lane_type")=cr::Lane::LaneType::Driving))
+    .def("get_spawn_points", CALL_RETURNING_LIST_WITHOUT_GIL(cc::Map, GetRecommendedSpawnPoints))
+    .def("get_waypoint", CONST_CALL_WITHOUT_GIL_3(cc::Map, GetWaypoint, cg::Location, bool, uint32_t), (arg("location"), arg("project_to_road")=true, arg("lane_type")=cr::Lane::LaneType::Driving))
     .def("get_waypoint_xodr", &cc::Map::GetWaypointXODR, (arg("road_id"), arg("lane_id"), arg("s")))
     .def("get_topology", &GetTopology)
-    .def("generate_waypoints", CALL_RETURNING_LIST_1(cc::Map, GenerateWaypoints, double), (args("distance")))
+    .def("generate_waypoints", CALL_RETURNING_LIST_1_WITHOUT_GIL(cc::Map, GenerateWaypoints, double), (args("distance")))
+    .def("generate_waypoint_collection", &GenerateWaypointCollection, (arg("distance")))
+    .def("generate_road_waypoint_collection", &GenerateRoadWaypointCollection, (arg("road_id"), arg("distance")))
+    .def("get_topology_array", &GetTopologyArray)
+    .def("get_shortest_route", CALL_RETURNING_LIST_2_WITHOUT_GIL(cc::Map, GetShortestRoute, cg::Location, cg::Location), (arg("origin"), arg("destination")))
+    .def("get_route_distance", CONST_CALL_WITHOUT_GIL_2(cc::Map, GetRouteDistance, cg::Location, cg::Location), (arg("origin"), arg("destination")))
+    .def("get_road_ids", CALL_RETURNING_LIST(cc::Map, GetRoadIds))
+    .def("generate_road_waypoints", CALL_RETURNING_LIST_2_WITHOUT_GIL(cc::Map, GenerateRoadWaypoints, cr::RoadId, double), (args("road_id"), args("distance")))
     .def("transform_to_geolocation", &ToGeolocation, (arg("location")))
+    .def("transform_to_geolocations", &ToGeolocationList, (arg("locations")))
     .def("to_opendrive", CALL_RETURNING_COPY(cc::Map, GetOpenDrive))
     .def("save_to_disk", &SaveOpenDriveToDisk, (arg("path")=""))
-    .def("get_crosswalks", CALL_RETURNING_LIST(cc::Map, GetAllCrosswalkZones))
-    .def("get_all_landmarks", CALL_RETURNING_LIST(cc::Map, GetAllLandmarks))
-    .def("get_all_landmarks_from_id", CALL_RETURNING_LIST_1(cc::Map, GetLandmarksFromId, std::string), (args("opendrive_id")))
-    .def("get_all_landmarks_of_type", CALL_RETURNING_LIST_1(cc::Map, GetAllLandmarksOfType, std::string), (args("type")))
+    .def("get_crosswalks", CALL_RETURNING_LIST_WITHOUT_GIL(cc::Map, GetAllCrosswalkZones))
+    .def("get_all_landmarks", CALL_RETURNING_LIST_WITHOUT_GIL(cc::Map, GetAllLandmarks))
+    .def("get_all_landmarks_from_id", CALL_RETURNING_LIST_1_WITHOUT_GIL(cc::Map, GetLandmarksFromId, std::string), (args("opendrive_id")))
+    .def("get_all_landmarks_of_type", CALL_RETURNING_LIST_1_WITHOUT_GIL(cc::Map, GetAllLandmarksOfType, std::string), (args("type")))
     .def("get_landmark_group", CALL_RETURNING_LIST_1(cc::Map, GetLandmarkGroup, cc::Landmark), args("landmark"))
     .def(self_ns::str(self_ns::self))
   ;
@@ -211,10 +434,20 @@ void export_map() {
     .def(self_ns::str(self_ns::self))
   ;
 
+  class_<cr::Junction::LaneConflict>("LaneConflict", no_init)
+    .add_property("road_id", &cr::Junction::LaneConflict::road_id)
+    .add_property("lane_id", &cr::Junction::LaneConflict::lane_id)
+    .add_property("s", &cr::Junction::LaneConflict::s)
+    .add_property("other_road_id", &cr::Junction::LaneConflict::other_road_id)
+    .add_property("other_lane_id", &cr::Junction::LaneConflict::other_lane_id)
+    .add_property("other_s", &cr::Junction::LaneConflict::other_s)
+  ;
+
   class_<cc::Junction, boost::noncopyable, boost::shared_ptr<cc::Junction>>("Junction", no_init)
     .add_property("id", &cc::Junction::GetId)
     .add_property("bounding_box", &cc::Junction::GetBoundingBox)
     .def("get_waypoints", &GetJunctionWaypoints)
+    .def("get_lane_conflicts", CALL_RETURNING_LIST(cc::Junction, GetLaneConflicts))
   ;
 
   class_<cr::SignalType>("LandmarkType", no_init)
@@ -10,23 +10,187 @@
 #include <carla/client/Sensor.h>
 #include <carla/client/ServerSideSensor.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 static void SubscribeToStream(carla::client::Sensor &self, boost::python::object callback) {
   self.Listen(MakeCallback(std::move(callback)));
 }
 
+/// Bounded queue of sensor measurements fed straight from the sensor's
+/// worker thread, so frames can be pulled from Python without the
+/// callback-thread handoff that listen() requires.
+///
+/// When the queue is full the oldest frame is dropped, keeping a slow
+/// consumer from buffering an unbounded backlog of stale data.
+class SensorStream {
+public:
+
+  explicit SensorStream(size_t max_queue)
+    : _max_queue(max_queue == 0u ? 1u : max_queue) {}
+
+  /// Called from the sensor's worker thread, does not need the GIL.
+  void Push(carla::SharedPtr<carla::sensor::SensorData> data) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_queue.size() >= _max_queue) {
+      _queue.pop_front();
+      ++_dropped;
+    }
+    _queue.emplace_back(std::move(data));
+    _cv.notify_one();
+  }
+
+  /// Wake up every waiter; pending frames can still be drained.
+  void Stop() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopped = true;
+    _cv.notify_all();
+  }
+
+  /// Blocks until a frame is available, returns nullptr once the stream
+  /// is stopped and drained. Call with the GIL released.
+  carla::SharedPtr<carla::sensor::SensorData> WaitAndPop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait(lock, [this]() { return _stopped || !_queue.empty(); });
+    if (_queue.empty()) {
+      return nullptr;
+    }
+    auto data = std::move(_queue.front());
+    _queue.pop_front();
+    return data;
+  }
+
+  bool IsStopped() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stopped;
+  }
+
+  size_t GetDroppedCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _dropped;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queue.size();
+  }
+
+private:
+
+  mutable std::mutex _mutex;
+
+  std::condition_variable _cv;
+
+  std::deque<carla::SharedPtr<carla::sensor::SensorData>> _queue;
+
+  bool _stopped = false;
+
+  size_t _dropped = 0u;
+
+  const size_t _max_queue;
+};
+
+static carla::SharedPtr<carla::sensor::SensorData> StreamWaitAndPop(SensorStream &self) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.WaitAndPop();
+}
+
+static boost::python::object StreamNext(SensorStream &self) {
+  auto data = StreamWaitAndPop(self);
+  if (data == nullptr) {
+    PyErr_SetNone(PyExc_StopIteration);
+    boost::python::throw_error_already_set();
+  }
+  return boost::python::object(data);
+}
+
+static boost::python::object StreamNextAsync(SensorStream &self) {
+  auto data = StreamWaitAndPop(self);
+  if (data == nullptr) {
+#if PY_MAJOR_VERSION >= 3
+    PyErr_SetNone(PyExc_StopAsyncIteration);
+#else
+    PyErr_SetNone(PyExc_StopIteration);
+#endif
+    boost::python::throw_error_already_set();
+  }
+  return boost::python::object(data);
+}
+
+/// "async for" support: run the blocking wait on the loop's default
+/// executor and hand back the future, so the event loop keeps running
+/// while we wait for the next frame.
+static boost::python::object StreamAnext(boost::python::object self) {
+  auto asyncio = boost::python::import("asyncio");
+  auto loop = asyncio.attr("get_event_loop")();
+  return loop.attr("run_in_executor")(
+      boost::python::object(),
+      self.attr("_wait_next_async"));
+}
+
+static boost::shared_ptr<SensorStream> MakeSensorStream(
+    carla::client::Sensor &self,
+    size_t max_queue) {
+  auto stream = boost::shared_ptr<SensorStream>(new SensorStream(max_queue));
+  // The callback only holds a weak reference, dropping the stream on the
+  // Python side stops the queue from being fed.
+  boost::weak_ptr<SensorStream> weak_stream(stream);
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.Listen([weak_stream](carla::SharedPtr<carla::sensor::SensorData> data) {
+    auto pinned = weak_stream.lock();
+    if (pinned != nullptr) {
+      pinned->Push(std::move(data));
+    }
+  });
+  return stream;
+}
+
 void export_sensor() {
   using namespace boost::python;
   namespace cc = carla::client;
 
+  class_<SensorStream, boost::noncopyable, boost::shared_ptr<SensorStream>>("SensorStream", no_init)
+    .add_property("is_stopped", &SensorStream::IsStopped)
+    .add_property("dropped_frames", &SensorStream::GetDroppedCount)
+    .def("stop", &SensorStream::Stop)
+    .def("__len__", &SensorStream::size)
+    .def("__iter__", +[](object self) { return self; })
+    .def("__next__", &StreamNext)
+    .def("next", &StreamNext) // deprecated, Python 2.
+    .def("__aiter__", +[](object self) { return self; })
+    .def("__anext__", &StreamAnext)
+    .def("_wait_next_async", &StreamNextAsync)
+  ;
+
   class_<cc::Sensor, bases<cc::Actor>, boost::noncopyable, boost::shared_ptr<cc::Sensor>>("Sensor", no_init)
     .add_property("is_listening", &cc::Sensor::IsListening)
     .def("listen", &SubscribeToStream, (arg("callback")))
+    .def("stream", &MakeSensorStream, (arg("max_queue")=16u))
     .def("stop", &cc::Sensor::Stop)
     .def(self_ns::str(self_ns::self))
   ;
 
+  enum_<cc::SensorQueuePolicy>("SensorQueuePolicy")
+    .value("KeepLatest", cc::SensorQueuePolicy::keep_latest)
+    .value("DropOldest", cc::SensorQueuePolicy::drop_oldest)
+    .value("Block", cc::SensorQueuePolicy::block)
+  ;
+
+  class_<cc::detail::SensorCallbackQueue::Stats>("SensorQueueStats", no_init)
+    .def_readonly("received", &cc::detail::SensorCallbackQueue::Stats::received)
+    .def_readonly("delivered", &cc::detail::SensorCallbackQueue::Stats::delivered)
+    .def_readonly("dropped", &cc::detail::SensorCallbackQueue::Stats::dropped)
+    .def_readonly("blocked", &cc::detail::SensorCallbackQueue::Stats::blocked)
+    .def_readonly("depth", &cc::detail::SensorCallbackQueue::Stats::depth)
+    .def_readonly("peak_depth", &cc::detail::SensorCallbackQueue::Stats::peak_depth)
+  ;
+
   class_<cc::ServerSideSensor, bases<cc::Sensor>, boost::noncopyable, boost::shared_ptr<cc::ServerSideSensor>>
       ("ServerSideSensor", no_init)
+    .def("set_callback_queue", &cc::ServerSideSensor::SetCallbackQueue,
+        (arg("policy"), arg("max_queue_depth")=1u))
+    .def("get_callback_queue_stats", &cc::ServerSideSensor::GetCallbackQueueStats)
     .def(self_ns::str(self_ns::self))
   ;
 
@@ -8,6 +8,7 @@
 #include <carla/image/ImageConverter.h>
 #include <carla/image/ImageIO.h>
 #include <carla/image/ImageView.h>
+#include <carla/pointcloud/LidarAccumulator.h>
 #include <carla/pointcloud/PointCloudIO.h>
 #include <carla/sensor/SensorData.h>
 #include <carla/sensor/data/CollisionEvent.h>
@@ -24,8 +25,11 @@
 
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
 #include <iostream>
+#include <string>
 
 namespace carla {
 namespace sensor {
@@ -139,16 +143,85 @@ enum class EColorConverter {
   CityScapesPalette
 };
 
+/// Zero-copy view over the sensor's internal buffer. The returned
+/// memoryview owns a reference to @a self, so the buffer stays alive for
+/// as long as the view does even if the measurement itself is dropped.
 template <typename T>
-static auto GetRawDataAsBuffer(T &self) {
-  auto *data = reinterpret_cast<unsigned char *>(self.data());
-  auto size = static_cast<Py_ssize_t>(sizeof(typename T::value_type) * self.size());
+static boost::python::object GetRawDataAsBuffer(boost::python::object self) {
+  auto &data = boost::python::extract<T &>(self)();
+  auto *ptr = reinterpret_cast<char *>(data.data());
+  auto size = static_cast<Py_ssize_t>(sizeof(typename T::value_type) * data.size());
 #if PY_MAJOR_VERSION >= 3
-  auto *ptr = PyMemoryView_FromMemory(reinterpret_cast<char *>(data), size, PyBUF_READ);
+  Py_buffer view;
+  if (PyBuffer_FillInfo(&view, self.ptr(), ptr, size, /*readonly=*/0, PyBUF_FULL) != 0) {
+    boost::python::throw_error_already_set();
+  }
+  auto *memview = PyMemoryView_FromBuffer(&view);
+  if (memview == nullptr) {
+    PyBuffer_Release(&view);
+    boost::python::throw_error_already_set();
+  }
+  return boost::python::object(boost::python::handle<>(memview));
 #else
-  auto *ptr = PyBuffer_FromMemory(data, size);
+  // The old-style Python 2 buffer cannot hold a reference to its exporter.
+  auto *buffer = PyBuffer_FromReadWriteMemory(ptr, size);
+  return boost::python::object(boost::python::handle<>(buffer));
 #endif
-  return boost::python::object(boost::python::handle<>(ptr));
+}
+
+static boost::python::dict GetImageArrayInterface(const carla::sensor::data::Image &self) {
+  return MakeArrayInterface(
+      self.data(),
+      "|u1",
+      boost::python::make_tuple(self.GetHeight(), self.GetWidth(), 4u));
+}
+
+static boost::python::dict GetLidarArrayInterface(const carla::sensor::data::LidarMeasurement &self) {
+  return MakeArrayInterface(
+      self.data(),
+      "<f4",
+      boost::python::make_tuple(self.size(), 3u));
+}
+
+/// Zero-copy view of the semantic tag of each point, or None when the
+/// measurement carries no tags; numpy keeps @a self alive as the array base.
+static boost::python::object GetLidarSemanticTags(boost::python::object self) {
+  const auto &measurement =
+      boost::python::extract<const carla::sensor::data::LidarMeasurement &>(self)();
+  if (!measurement.HasSemanticTags()) {
+    return boost::python::object();
+  }
+  return boost::python::object(PyArrayExporter{
+      self,
+      MakeArrayInterface(
+          measurement.GetSemanticTags(),
+          "|u1",
+          boost::python::make_tuple(measurement.size()),
+          true)});
+}
+
+static boost::python::dict GetRadarArrayInterface(const carla::sensor::data::RadarMeasurement &self) {
+  return MakeArrayInterface(
+      self.data(),
+      "<f4",
+      boost::python::make_tuple(self.size(), 4u));
+}
+
+static boost::python::dict GetDVSArrayInterface(const carla::sensor::data::DVSEventArray &self) {
+  using carla::sensor::data::DVSEvent;
+  boost::python::list descr;
+  descr.append(boost::python::make_tuple("x", "<u2"));
+  descr.append(boost::python::make_tuple("y", "<u2"));
+  AppendPaddingField(descr, offsetof(DVSEvent, t) - (offsetof(DVSEvent, y) + sizeof(std::uint16_t)));
+  descr.append(boost::python::make_tuple("t", "<i8"));
+  descr.append(boost::python::make_tuple("pol", "|b1"));
+  AppendPaddingField(descr, sizeof(DVSEvent) - (offsetof(DVSEvent, pol) + sizeof(bool)));
+  auto interface = MakeArrayInterface(
+      self.data(),
+      "|V" + std::to_string(sizeof(DVSEvent)),
+      boost::python::make_tuple(self.size()));
+  interface["descr"] = descr;
+  return interface;
 }
 
 template <typename T>
@@ -206,6 +279,24 @@ static std::string SavePointCloudToDisk(T &self, std::string path) {
   return carla::pointcloud::PointCloudIO::SaveToDisk(std::move(path), self.begin(), self.end());
 }
 
+static void AddLidarSweep(
+    carla::pointcloud::LidarAccumulator &self,
+    const carla::sensor::data::LidarMeasurement &measurement) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.Add(measurement);
+}
+
+static std::string SaveAccumulatedCloudToDisk(
+    carla::pointcloud::LidarAccumulator &self,
+    std::string path) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  auto points = self.GetPoints();
+  return carla::pointcloud::PointCloudIO::SaveToDisk(
+      std::move(path),
+      points.data(),
+      points.data() + points.size());
+}
+
 void export_sensor_data() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -233,6 +324,7 @@ void export_sensor_data() {
     .add_property("height", &csd::Image::GetHeight)
     .add_property("fov", &csd::Image::GetFOVAngle)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::Image>)
+    .add_property("__array_interface__", &GetImageArrayInterface)
     .def("convert", &ConvertImage<csd::Image>, (arg("color_converter")))
     .def("save_to_disk", &SaveImageToDisk<csd::Image>, (arg("path"), arg("color_converter")=EColorConverter::Raw))
     .def("__len__", &csd::Image::size)
@@ -249,8 +341,18 @@ void export_sensor_data() {
   class_<csd::LidarMeasurement, bases<cs::SensorData>, boost::noncopyable, boost::shared_ptr<csd::LidarMeasurement>>("LidarMeasurement", no_init)
     .add_property("horizontal_angle", &csd::LidarMeasurement::GetHorizontalAngle)
     .add_property("channels", &csd::LidarMeasurement::GetChannelCount)
+    .add_property("sector_index", &csd::LidarMeasurement::GetSectorIndex)
+    .add_property("sector_count", &csd::LidarMeasurement::GetSectorCount)
+    .add_property("revolution", &csd::LidarMeasurement::GetRevolution)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::LidarMeasurement>)
+    .add_property("__array_interface__", &GetLidarArrayInterface)
+    .add_property("has_semantic_tags", &csd::LidarMeasurement::HasSemanticTags)
+    .add_property("semantic_tags", &GetLidarSemanticTags)
     .def("get_point_count", &csd::LidarMeasurement::GetPointCount, (arg("channel")))
+    .def("get_points_in_world", CALL_RETURNING_LIST(csd::LidarMeasurement, GetPointsInWorld))
+    .def("filter_by_tag_mask",
+        CALL_RETURNING_LIST_1_WITHOUT_GIL(csd::LidarMeasurement, FilterByTagMask, uint32_t),
+        (arg("tag_mask")))
     .def("save_to_disk", &SavePointCloudToDisk<csd::LidarMeasurement>, (arg("path")))
     .def("__len__", &csd::LidarMeasurement::size)
     .def("__iter__", iterator<csd::LidarMeasurement>())
@@ -299,6 +401,7 @@ void export_sensor_data() {
 
   class_<csd::RadarMeasurement, bases<cs::SensorData>, boost::noncopyable, boost::shared_ptr<csd::RadarMeasurement>>("RadarMeasurement", no_init)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::RadarMeasurement>)
+    .add_property("__array_interface__", &GetRadarArrayInterface)
     .def("get_detection_count", &csd::RadarMeasurement::GetDetectionAmount)
     .def("__len__", &csd::RadarMeasurement::size)
     .def("__iter__", iterator<csd::RadarMeasurement>())
@@ -332,6 +435,7 @@ void export_sensor_data() {
     .add_property("height", &csd::DVSEventArray::GetHeight)
     .add_property("fov", &csd::DVSEventArray::GetFOVAngle)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::DVSEventArray>)
+    .add_property("__array_interface__", &GetDVSArrayInterface)
     .def("__len__", &csd::DVSEventArray::size)
     .def("__iter__", iterator<csd::DVSEventArray>())
     .def("__getitem__", +[](const csd::DVSEventArray &self, size_t pos) -> csd::DVSEvent {
@@ -348,4 +452,14 @@ void export_sensor_data() {
     .def("to_array_pol", CALL_RETURNING_LIST(csd::DVSEventArray, ToArrayPol))
     .def(self_ns::str(self_ns::self))
   ;
+
+  class_<carla::pointcloud::LidarAccumulator, boost::noncopyable>("LidarAccumulator",
+      init<size_t>((arg("max_sweeps"))))
+    .add_property("sweep_count", &carla::pointcloud::LidarAccumulator::GetSweepCount)
+    .def("add", &AddLidarSweep, (arg("measurement")))
+    .def("get_points", CALL_RETURNING_LIST(carla::pointcloud::LidarAccumulator, GetPoints))
+    .def("save_to_disk", &SaveAccumulatedCloudToDisk, (arg("path")))
+    .def("clear", &carla::pointcloud::LidarAccumulator::Clear)
+    .def("__len__", &carla::pointcloud::LidarAccumulator::GetPointCount)
+  ;
 }
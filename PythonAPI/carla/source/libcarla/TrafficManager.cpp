@@ -33,5 +33,11 @@ void export_trafficmanager() {
       .def("set_percentage_keep_right_rule", &carla::traffic_manager::TrafficManager::SetKeepRightPercentage)
       .def("set_synchronous_mode", &carla::traffic_manager::TrafficManager::SetSynchronousMode)
       .def("set_hybrid_physics_mode", &carla::traffic_manager::TrafficManager::SetHybridPhysicsMode)
-      .def("set_hybrid_physics_radius", &carla::traffic_manager::TrafficManager::SetHybridPhysicsRadius);
+      .def("set_hybrid_physics_radius", &carla::traffic_manager::TrafficManager::SetHybridPhysicsRadius)
+      .def("set_distance_lod_mode", &carla::traffic_manager::TrafficManager::SetDistanceLODMode)
+      .def("set_distance_lod_radius", &carla::traffic_manager::TrafficManager::SetDistanceLODRadius)
+      .def("set_deterministic_mode", &carla::traffic_manager::TrafficManager::SetDeterministicMode)
+      .def("set_parameter_batching", &carla::traffic_manager::TrafficManager::SetParameterBatching)
+      .def("flush_parameter_buffer", &carla::traffic_manager::TrafficManager::FlushParameterBuffer)
+      .def("get_stage_timing_profile", &carla::traffic_manager::TrafficManager::GetStageTimingProfile);
 }
@@ -53,6 +53,66 @@ static auto Tick(carla::client::World &world, double seconds) {
   return world.Tick(TimeDurationFromSeconds(seconds));
 }
 
+static auto BeginTick(carla::client::World &world, double compute_budget_seconds) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return world.BeginTick(compute_budget_seconds);
+}
+
+static auto EndTick(carla::client::World &world, uint64_t frame, double seconds) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  return world.EndTick(frame, TimeDurationFromSeconds(seconds));
+}
+
+static auto GetSnapshotHistory(const carla::client::World &self, size_t max_frames) {
+  std::vector<carla::client::WorldSnapshot> history;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    history = self.GetSnapshotHistory(max_frames);
+  }
+  boost::python::list result;
+  for (auto &snapshot : history) {
+    result.append(snapshot);
+  }
+  return result;
+}
+
+static auto GetActorSnapshotHistory(
+    const carla::client::World &self,
+    carla::ActorId actor_id,
+    size_t max_frames) {
+  std::vector<std::pair<uint64_t, carla::client::ActorSnapshot>> history;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    history = self.GetActorSnapshotHistory(actor_id, max_frames);
+  }
+  boost::python::list result;
+  for (auto &entry : history) {
+    result.append(boost::python::make_tuple(entry.first, entry.second));
+  }
+  return result;
+}
+
+static void SetWeatherAnimation(carla::client::World &self, const boost::python::list &keyframes) {
+  std::vector<carla::rpc::WeatherKeyFrame> result;
+  result.reserve(static_cast<size_t>(boost::python::len(keyframes)));
+  for (boost::python::ssize_t i = 0u; i < boost::python::len(keyframes); ++i) {
+    boost::python::object keyframe = keyframes[i];
+    result.emplace_back(
+        boost::python::extract<double>(keyframe[0]),
+        boost::python::extract<carla::rpc::WeatherParameters>(keyframe[1]));
+  }
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.SetWeatherAnimation(result);
+}
+
+static void PrewarmActors(carla::client::World &self, const boost::python::list &blueprint_ids) {
+  std::vector<std::string> ids{
+      boost::python::stl_input_iterator<std::string>(blueprint_ids),
+      boost::python::stl_input_iterator<std::string>()};
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.PrewarmActors(ids);
+}
+
 static auto GetActorsById(carla::client::World &self, const boost::python::list &actor_ids) {
   std::vector<carla::ActorId> ids{
       boost::python::stl_input_iterator<carla::ActorId>(actor_ids),
@@ -61,6 +121,114 @@ static auto GetActorsById(carla::client::World &self, const boost::python::list
   return self.GetActors(ids);
 }
 
+/// State of every actor (or a filtered subset) at one frame, exposed as
+/// numpy arrays instead of per-actor Python objects.
+///
+/// Unfiltered, the arrays are zero-copy views over the snapshot's
+/// struct-of-arrays storage; filtered, the rows are compacted into owned
+/// vectors in a single pass. Either way row i of every array belongs to
+/// the actor ids[i].
+struct BulkActorState {
+
+  explicit BulkActorState(carla::client::WorldSnapshot snapshot)
+    : snapshot(std::move(snapshot)) {}
+
+  size_t size() const {
+    return filtered ? ids.size() : snapshot.size();
+  }
+
+  /// Keeps the episode state alive for the zero-copy spans.
+  carla::client::WorldSnapshot snapshot;
+
+  bool filtered = false;
+
+  std::vector<carla::ActorId> ids;
+  std::vector<carla::geom::Transform> transforms;
+  std::vector<carla::geom::Vector3D> velocities;
+  std::vector<carla::geom::Vector3D> angular_velocities;
+  std::vector<carla::geom::Vector3D> accelerations;
+};
+
+static PyArrayExporter MakeBulkActorArray(
+    boost::python::object owner,
+    const void *data,
+    std::string typestr,
+    boost::python::tuple shape) {
+  // Snapshot storage is immutable, always export read-only.
+  return {owner, MakeArrayInterface(data, std::move(typestr), shape, true)};
+}
+
+static PyArrayExporter GetBulkIds(boost::python::object self) {
+  auto &state = boost::python::extract<BulkActorState &>(self)();
+  auto span = state.snapshot.GetIds();
+  static_assert(sizeof(carla::ActorId) == 4u, "Invalid actor id layout.");
+  return MakeBulkActorArray(
+      self,
+      state.filtered ? state.ids.data() : span.begin(),
+      "<u4",
+      boost::python::make_tuple(state.size()));
+}
+
+static PyArrayExporter GetBulkTransforms(boost::python::object self) {
+  auto &state = boost::python::extract<BulkActorState &>(self)();
+  auto span = state.snapshot.GetTransforms();
+  static_assert(
+      sizeof(carla::geom::Transform) == 6u * sizeof(float),
+      "Invalid transform layout.");
+  // Row layout follows the transform: x, y, z, pitch, yaw, roll.
+  return MakeBulkActorArray(
+      self,
+      state.filtered ? state.transforms.data() : span.begin(),
+      "<f4",
+      boost::python::make_tuple(state.size(), 6u));
+}
+
+static PyArrayExporter GetBulkVector3Ds(
+    boost::python::object self,
+    const std::vector<carla::geom::Vector3D> &copies,
+    const carla::geom::Vector3D *span_data) {
+  auto &state = boost::python::extract<BulkActorState &>(self)();
+  static_assert(
+      sizeof(carla::geom::Vector3D) == 3u * sizeof(float),
+      "Invalid vector layout.");
+  return MakeBulkActorArray(
+      self,
+      state.filtered ? copies.data() : span_data,
+      "<f4",
+      boost::python::make_tuple(state.size(), 3u));
+}
+
+static BulkActorState GetBulkActorState(
+    const carla::client::World &self,
+    boost::python::object actor_ids) {
+  if (actor_ids.is_none()) {
+    carla::PythonUtil::ReleaseGIL unlock;
+    return BulkActorState{self.GetSnapshot()};
+  }
+  std::vector<carla::ActorId> ids{
+      boost::python::stl_input_iterator<carla::ActorId>(actor_ids),
+      boost::python::stl_input_iterator<carla::ActorId>()};
+  carla::PythonUtil::ReleaseGIL unlock;
+  BulkActorState state{self.GetSnapshot()};
+  state.filtered = true;
+  state.ids.reserve(ids.size());
+  state.transforms.reserve(ids.size());
+  state.velocities.reserve(ids.size());
+  state.angular_velocities.reserve(ids.size());
+  state.accelerations.reserve(ids.size());
+  for (auto id : ids) {
+    auto actor = state.snapshot.Find(id);
+    if (actor.has_value()) {
+      state.ids.emplace_back(actor->id);
+      state.transforms.emplace_back(actor->transform);
+      state.velocities.emplace_back(actor->velocity);
+      state.angular_velocities.emplace_back(actor->angular_velocity);
+      state.accelerations.emplace_back(actor->acceleration);
+    }
+  }
+  return state;
+}
+
 void export_world() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -117,6 +285,27 @@ void export_world() {
     .value("SpringArm", cr::AttachmentType::SpringArm)
   ;
 
+  class_<BulkActorState>("BulkActorState", no_init)
+    .add_property("frame", +[](const BulkActorState &self) {
+      return self.snapshot.GetTimestamp().frame;
+    })
+    .add_property("ids", &GetBulkIds)
+    .add_property("transforms", &GetBulkTransforms)
+    .add_property("velocities", +[](object self) {
+      auto &state = extract<BulkActorState &>(self)();
+      return GetBulkVector3Ds(self, state.velocities, state.snapshot.GetVelocities().begin());
+    })
+    .add_property("angular_velocities", +[](object self) {
+      auto &state = extract<BulkActorState &>(self)();
+      return GetBulkVector3Ds(self, state.angular_velocities, state.snapshot.GetAngularVelocities().begin());
+    })
+    .add_property("accelerations", +[](object self) {
+      auto &state = extract<BulkActorState &>(self)();
+      return GetBulkVector3Ds(self, state.accelerations, state.snapshot.GetAccelerations().begin());
+    })
+    .def("__len__", &BulkActorState::size)
+  ;
+
 #define SPAWN_ACTOR_WITHOUT_GIL(fn) +[]( \
         cc::World &self, \
         const cc::ActorBlueprint &blueprint, \
@@ -142,17 +331,26 @@ void export_world() {
     .def("get_settings", CONST_CALL_WITHOUT_GIL(cc::World, GetSettings))
     .def("apply_settings", CALL_WITHOUT_GIL_1(cc::World, ApplySettings, cr::EpisodeSettings), arg("settings"))
     .def("get_weather", CONST_CALL_WITHOUT_GIL(cc::World, GetWeather))
-    .def("set_weather", &cc::World::SetWeather)
+    .def("set_weather", CALL_WITHOUT_GIL_1(cc::World, SetWeather, cr::WeatherParameters), (arg("weather")))
+    .def("set_weather_animation", &SetWeatherAnimation, (arg("keyframes")))
     .def("get_snapshot", &cc::World::GetSnapshot)
     .def("get_actor", CONST_CALL_WITHOUT_GIL_1(cc::World, GetActor, carla::ActorId), (arg("actor_id")))
     .def("get_actors", CONST_CALL_WITHOUT_GIL(cc::World, GetActors))
     .def("get_actors", &GetActorsById, (arg("actor_ids")))
+    .def("get_bulk_actor_state", &GetBulkActorState, (arg("actor_ids")=object()))
+    .def("prewarm_actors", &PrewarmActors, (arg("blueprint_ids")))
     .def("spawn_actor", SPAWN_ACTOR_WITHOUT_GIL(SpawnActor))
     .def("try_spawn_actor", SPAWN_ACTOR_WITHOUT_GIL(TrySpawnActor))
+    .def("set_snapshot_history_depth", CALL_WITHOUT_GIL_1(cc::World, SetSnapshotHistoryDepth, size_t), (arg("depth")))
+    .def("get_snapshot_history_depth", CONST_CALL_WITHOUT_GIL(cc::World, GetSnapshotHistoryDepth))
+    .def("get_snapshot_history", &GetSnapshotHistory, (arg("max_frames")=0u))
+    .def("get_actor_snapshot_history", &GetActorSnapshotHistory, (arg("actor_id"), arg("max_frames")=0u))
     .def("wait_for_tick", &WaitForTick, (arg("seconds")=10.0))
     .def("on_tick", &OnTick, (arg("callback")))
     .def("remove_on_tick", &cc::World::RemoveOnTick, (arg("callback_id")))
     .def("tick", &Tick, (arg("seconds")=10.0))
+    .def("begin_tick", &BeginTick, (arg("compute_budget_seconds")=0.0))
+    .def("end_tick", &EndTick, (arg("frame"), arg("seconds")=10.0))
     .def("set_pedestrians_cross_factor", CALL_WITHOUT_GIL_1(cc::World, SetPedestriansCrossFactor, float), (arg("percentage")))
     .def("get_traffic_sign", CONST_CALL_WITHOUT_GIL_1(cc::World, GetTrafficSign, cc::Landmark), arg("landmark"))
     .def("get_traffic_light", CONST_CALL_WITHOUT_GIL_1(cc::World, GetTrafficLight, cc::Landmark), arg("landmark"))
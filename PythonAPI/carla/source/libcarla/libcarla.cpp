@@ -8,7 +8,10 @@
 #include <carla/PythonUtil.h>
 #include <carla/Time.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -51,6 +54,7 @@ static boost::python::object OptionalToPythonObject(OptionalT &optional) {
 #define CONST_CALL_WITHOUT_GIL(cls, fn) CALL_WITHOUT_GIL(const cls, fn)
 #define CONST_CALL_WITHOUT_GIL_1(cls, fn, T1_) CALL_WITHOUT_GIL_1(const cls, fn, T1_)
 #define CONST_CALL_WITHOUT_GIL_2(cls, fn, T1_, T2_) CALL_WITHOUT_GIL_2(const cls, fn, T1_, T2_)
+#define CONST_CALL_WITHOUT_GIL_3(cls, fn, T1_, T2_, T3_) CALL_WITHOUT_GIL_3(const cls, fn, T1_, T2_, T3_)
 #define CONST_CALL_WITHOUT_GIL_4(cls, fn, T1_, T2_, T3_, T4_) CALL_WITHOUT_GIL_4(const cls, fn, T1_, T2_, T3_, T4_)
 
 // Convenient for const requests that need to make a copy of the returned value.
@@ -101,6 +105,44 @@ static boost::python::object OptionalToPythonObject(OptionalT &optional) {
       return result; \
     }
 
+// Same as CALL_RETURNING_LIST, but the native call runs with the GIL
+// released so other Python threads keep going while we compute.
+#define CALL_RETURNING_LIST_WITHOUT_GIL(cls, fn) +[](const cls &self) { \
+      auto items = [&self]() { \
+        carla::PythonUtil::ReleaseGIL unlock; \
+        return self.fn(); \
+      }(); \
+      boost::python::list result; \
+      for (auto &&item : items) { \
+        result.append(item); \
+      } \
+      return result; \
+    }
+
+#define CALL_RETURNING_LIST_1_WITHOUT_GIL(cls, fn, T1_) +[](const cls &self, T1_ t1) { \
+      auto items = [&self, &t1]() { \
+        carla::PythonUtil::ReleaseGIL unlock; \
+        return self.fn(std::forward<T1_>(t1)); \
+      }(); \
+      boost::python::list result; \
+      for (auto &&item : items) { \
+        result.append(item); \
+      } \
+      return result; \
+    }
+
+#define CALL_RETURNING_LIST_2_WITHOUT_GIL(cls, fn, T1_, T2_) +[](const cls &self, T1_ t1, T2_ t2) { \
+      auto items = [&self, &t1, &t2]() { \
+        carla::PythonUtil::ReleaseGIL unlock; \
+        return self.fn(std::forward<T1_>(t1), std::forward<T2_>(t2)); \
+      }(); \
+      boost::python::list result; \
+      for (auto &&item : items) { \
+        result.append(item); \
+      } \
+      return result; \
+    }
+
 #define CALL_RETURNING_OPTIONAL(cls, fn) +[](const cls &self) { \
       auto optional = self.fn(); \
       return OptionalToPythonObject(optional); \
@@ -183,6 +225,50 @@ static auto MakeCallback(boost::python::object callback) {
   };
 }
 
+/// Build a numpy "__array_interface__" (version 3) dict. Numpy keeps the
+/// exporting object as the base of the resulting array, so np.asarray over
+/// an exporter is zero-copy and lifetime-safe.
+///
+/// @warning The type strings assume a little-endian host, same as
+/// pointcloud::PointCloudIO.
+static boost::python::dict MakeArrayInterface(
+    const void *data,
+    std::string typestr,
+    boost::python::tuple shape,
+    bool read_only = false) {
+  boost::python::dict interface;
+  interface["version"] = 3;
+  interface["typestr"] = std::move(typestr);
+  interface["shape"] = shape;
+  interface["data"] = boost::python::make_tuple(
+      reinterpret_cast<std::uintptr_t>(data), read_only);
+  return interface;
+}
+
+static void AppendPaddingField(boost::python::list &descr, size_t num_bytes) {
+  if (num_bytes > 0u) {
+    descr.append(boost::python::make_tuple("", "|V" + std::to_string(num_bytes)));
+  }
+}
+
+/// Exports one borrowed chunk of native memory through
+/// "__array_interface__"; holds the Python object owning the memory so it
+/// outlives any numpy array built over the exporter.
+struct PyArrayExporter {
+  boost::python::object owner;
+  boost::python::dict interface;
+};
+
+static void export_array_interface() {
+  using namespace boost::python;
+
+  class_<PyArrayExporter>("PyArrayExporter", no_init)
+    .add_property("__array_interface__", +[](const PyArrayExporter &self) {
+      return self.interface;
+    })
+  ;
+}
+
 #include "Geom.cpp"
 #include "Actor.cpp"
 #include "Blueprint.cpp"
@@ -207,6 +293,7 @@ BOOST_PYTHON_MODULE(libcarla) {
   using namespace boost::python;
   PyEval_InitThreads();
   scope().attr("__path__") = "libcarla";
+  export_array_interface();
   export_geom();
   export_control();
   export_blueprint();
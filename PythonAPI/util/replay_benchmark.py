@@ -0,0 +1,256 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma de
+# Barcelona (UAB).
+#
+# This work is licensed under the terms of the MIT license.
+# For a copy, see <https://opensource.org/licenses/MIT>.
+
+"""Replay-driven performance benchmark.
+
+Replays a recording (see start_recording.py) in synchronous mode while
+sampling the server's frame-time breakdown (get_frame_stats), and emits a
+per-phase report at the end. Because the actor activity comes from the
+recording, two builds can be A/B'd by running the same file against each
+and diffing the reports; run the server with -RenderOffScreen (or pass
+--no-rendering) to keep the comparison headless.
+
+Example:
+
+    ./replay_benchmark.py -f worst_frame.log -o baseline.json
+    # ... upgrade the server ...
+    ./replay_benchmark.py -f worst_frame.log -o candidate.json
+"""
+
+import glob
+import os
+import sys
+
+try:
+    sys.path.append(glob.glob('../carla/dist/carla-*%d.%d-%s.egg' % (
+        sys.version_info.major,
+        sys.version_info.minor,
+        'win-amd64' if os.name == 'nt' else 'linux-x86_64'))[0])
+except IndexError:
+    pass
+
+import carla
+
+import argparse
+import json
+import re
+import time
+
+
+def parse_recording_info(info):
+    """Extract the map name and duration from show_recorder_file_info output."""
+    map_match = re.search(r'^Map: (.*)$', info, re.MULTILINE)
+    duration_match = re.search(r'^Duration: ([0-9.]+)', info, re.MULTILINE)
+    map_name = map_match.group(1).strip() if map_match else None
+    duration = float(duration_match.group(1)) if duration_match else 0.0
+    return map_name, duration
+
+
+class SectionAggregator(object):
+    """Per-phase statistics accumulated across frame-stats samples.
+
+    The server keeps a rolling window of a few hundred frames, so long
+    replays are sampled repeatedly; means are weighted by the number of
+    frames each sample covers, percentiles keep the average and worst
+    sample.
+    """
+
+    def __init__(self, name):
+        self.name = name
+        self.frames = 0
+        self._mean_sum = 0.0
+        self._p50_sum = 0.0
+        self._p90_sum = 0.0
+        self._p99_sum = 0.0
+        self._samples = 0
+        self.worst_p99_ms = 0.0
+
+    def add(self, section, frames):
+        self.frames += frames
+        self._mean_sum += section.mean_ms * frames
+        self._p50_sum += section.p50_ms
+        self._p90_sum += section.p90_ms
+        self._p99_sum += section.p99_ms
+        self._samples += 1
+        self.worst_p99_ms = max(self.worst_p99_ms, section.p99_ms)
+
+    def report(self):
+        samples = max(self._samples, 1)
+        return {
+            'mean_ms': self._mean_sum / max(self.frames, 1),
+            'p50_ms': self._p50_sum / samples,
+            'p90_ms': self._p90_sum / samples,
+            'p99_ms': self._p99_sum / samples,
+            'worst_p99_ms': self.worst_p99_ms}
+
+
+def main():
+
+    argparser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    argparser.add_argument(
+        '--host',
+        metavar='H',
+        default='127.0.0.1',
+        help='IP of the host server (default: 127.0.0.1)')
+    argparser.add_argument(
+        '-p', '--port',
+        metavar='P',
+        default=2000,
+        type=int,
+        help='TCP port to listen to (default: 2000)')
+    argparser.add_argument(
+        '-f', '--recorder-filename',
+        metavar='F',
+        default='test1.log',
+        help='recorder filename (test1.log)')
+    argparser.add_argument(
+        '-s', '--start',
+        metavar='S',
+        default=0.0,
+        type=float,
+        help='replay starting time (default: 0.0)')
+    argparser.add_argument(
+        '-d', '--duration',
+        metavar='D',
+        default=0.0,
+        type=float,
+        help='replay duration, 0 for the whole recording (default: 0.0)')
+    argparser.add_argument(
+        '--fps',
+        metavar='N',
+        default=20,
+        type=int,
+        help='fixed simulation frame rate while replaying (default: 20)')
+    argparser.add_argument(
+        '--sample-every',
+        metavar='N',
+        default=256,
+        type=int,
+        help='frames between frame-stats samples (default: 256)')
+    argparser.add_argument(
+        '--warm-up',
+        metavar='N',
+        default=32,
+        type=int,
+        help='frames ticked before sampling starts (default: 32)')
+    argparser.add_argument(
+        '--no-rendering',
+        action='store_true',
+        help='enable no-rendering mode while replaying')
+    argparser.add_argument(
+        '-o', '--output',
+        metavar='FILE',
+        default=None,
+        help='write the report as JSON to FILE')
+    args = argparser.parse_args()
+
+    client = carla.Client(args.host, args.port)
+    client.set_timeout(120.0)
+
+    info = client.show_recorder_file_info(args.recorder_filename, False)
+    map_name, recording_duration = parse_recording_info(info)
+    if recording_duration <= 0.0:
+        print('cannot read recording "%s":' % args.recorder_filename)
+        print(info)
+        sys.exit(1)
+
+    duration = recording_duration - args.start
+    if args.duration > 0.0:
+        duration = min(duration, args.duration)
+    if duration <= 0.0:
+        print('nothing to replay: recording lasts %.2fs, start is %.2fs'
+              % (recording_duration, args.start))
+        sys.exit(1)
+
+    world = client.get_world()
+    if map_name is not None and not world.get_map().name.endswith(map_name):
+        print('loading map %s...' % map_name)
+        world = client.load_world(map_name)
+
+    original_settings = world.get_settings()
+    try:
+        settings = world.get_settings()
+        settings.synchronous_mode = True
+        settings.fixed_delta_seconds = 1.0 / args.fps
+        settings.no_rendering_mode = args.no_rendering
+        world.apply_settings(settings)
+
+        client.set_replayer_time_factor(1.0)
+        client.replay_file(args.recorder_filename, args.start, duration, 0)
+        # The replay starts on the next tick; spawn the recorded actors and
+        # let the simulation settle before sampling.
+        for _ in range(args.warm_up):
+            world.tick()
+
+        total_frames = int(duration * args.fps)
+        aggregators = {}
+        last_frame_count = client.get_frame_stats().frame_count
+        wall_start = time.time()
+
+        frame = 0
+        while frame < total_frames:
+            budget = min(args.sample_every, total_frames - frame)
+            for _ in range(budget):
+                world.tick()
+            frame += budget
+
+            stats = client.get_frame_stats()
+            covered = min(
+                stats.frame_count - last_frame_count, stats.window_size)
+            last_frame_count = stats.frame_count
+            if covered <= 0:
+                continue
+            for section in stats.sections:
+                if section.name not in aggregators:
+                    aggregators[section.name] = SectionAggregator(section.name)
+                aggregators[section.name].add(section, covered)
+            print('replayed %d/%d frames...' % (frame, total_frames))
+
+        wall_seconds = time.time() - wall_start
+
+        report = {
+            'recording': os.path.basename(args.recorder_filename),
+            'map': map_name,
+            'fps': args.fps,
+            'replay_seconds': duration,
+            'frames': total_frames,
+            'wall_seconds': wall_seconds,
+            'sections': {
+                name: aggregator.report()
+                for name, aggregator in sorted(aggregators.items())}}
+
+        print('')
+        print('replayed %d frames (%.1fs of recording) in %.1fs wall time'
+              % (total_frames, duration, wall_seconds))
+        print('%-20s %9s %9s %9s %9s %11s'
+              % ('section', 'mean_ms', 'p50_ms', 'p90_ms', 'p99_ms', 'worst_p99'))
+        for name, section in sorted(report['sections'].items()):
+            print('%-20s %9.3f %9.3f %9.3f %9.3f %11.3f'
+                  % (name, section['mean_ms'], section['p50_ms'],
+                     section['p90_ms'], section['p99_ms'],
+                     section['worst_p99_ms']))
+
+        if args.output is not None:
+            with open(args.output, 'w') as handle:
+                json.dump(report, handle, indent=2, sort_keys=True)
+            print('report written to %s' % args.output)
+
+    finally:
+        world.apply_settings(original_settings)
+
+
+if __name__ == '__main__':
+
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        print('done.')
@@ -323,6 +323,31 @@ void UActorBlueprintFunctionLibrary::MakeCameraDefinition(
   ResY.RecommendedValues = { TEXT("600") };
   ResY.bRestrictToRecommended = false;
 
+  // Region of interest, zero width or height streams the full frame.
+  FActorVariation ROIOffsetX;
+  ROIOffsetX.Id = TEXT("roi_offset_x");
+  ROIOffsetX.Type = EActorAttributeType::Int;
+  ROIOffsetX.RecommendedValues = { TEXT("0") };
+  ROIOffsetX.bRestrictToRecommended = false;
+
+  FActorVariation ROIOffsetY;
+  ROIOffsetY.Id = TEXT("roi_offset_y");
+  ROIOffsetY.Type = EActorAttributeType::Int;
+  ROIOffsetY.RecommendedValues = { TEXT("0") };
+  ROIOffsetY.bRestrictToRecommended = false;
+
+  FActorVariation ROIWidth;
+  ROIWidth.Id = TEXT("roi_width");
+  ROIWidth.Type = EActorAttributeType::Int;
+  ROIWidth.RecommendedValues = { TEXT("0") };
+  ROIWidth.bRestrictToRecommended = false;
+
+  FActorVariation ROIHeight;
+  ROIHeight.Id = TEXT("roi_height");
+  ROIHeight.Type = EActorAttributeType::Int;
+  ROIHeight.RecommendedValues = { TEXT("0") };
+  ROIHeight.bRestrictToRecommended = false;
+
   // Lens parameters
   FActorVariation LensCircleFalloff;
   LensCircleFalloff.Id = TEXT("lens_circle_falloff");
@@ -363,6 +388,10 @@ void UActorBlueprintFunctionLibrary::MakeCameraDefinition(
   Definition.Variations.Append({
       ResX,
       ResY,
+      ROIOffsetX,
+      ROIOffsetY,
+      ROIWidth,
+      ROIHeight,
       FOV,
       LensCircleFalloff,
       LensCircleMultiplier,
@@ -713,6 +742,18 @@ void UActorBlueprintFunctionLibrary::MakeIMUDefinition(
   BiasGyroZ.RecommendedValues = { TEXT("0.0") };
   BiasGyroZ.bRestrictToRecommended = false;
 
+  // - Batching ----------------------------------
+  FActorVariation BatchSize;
+  BatchSize.Id = TEXT("batch_size");
+  BatchSize.Type = EActorAttributeType::Int;
+  BatchSize.RecommendedValues = { TEXT("1") };
+  BatchSize.bRestrictToRecommended = false;
+  FActorVariation BatchInterval;
+  BatchInterval.Id = TEXT("batch_interval");
+  BatchInterval.Type = EActorAttributeType::Float;
+  BatchInterval.RecommendedValues = { TEXT("0.0") };
+  BatchInterval.bRestrictToRecommended = false;
+
   Definition.Variations.Append({
     NoiseSeed,
     StdDevAccelX,
@@ -723,7 +764,9 @@ void UActorBlueprintFunctionLibrary::MakeIMUDefinition(
     StdDevGyroZ,
     BiasGyroX,
     BiasGyroY,
-    BiasGyroZ});
+    BiasGyroZ,
+    BatchSize,
+    BatchInterval});
 
   Success = CheckActorDefinition(Definition);
 }
@@ -825,9 +868,29 @@ void UActorBlueprintFunctionLibrary::MakeLidarDefinition(
   LowerFOV.Id = TEXT("lower_fov");
   LowerFOV.Type = EActorAttributeType::Float;
   LowerFOV.RecommendedValues = { TEXT("-30.0") };
+  // Quantized wire format.
+  FActorVariation Quantized;
+  Quantized.Id = TEXT("quantized");
+  Quantized.Type = EActorAttributeType::Bool;
+  Quantized.RecommendedValues = { TEXT("false") };
+  // GPU ray casting from depth captures.
+  FActorVariation Gpu;
+  Gpu.Id = TEXT("gpu");
+  Gpu.Type = EActorAttributeType::Bool;
+  Gpu.RecommendedValues = { TEXT("false") };
+  // Per-point semantic tags.
+  FActorVariation Semantic;
+  Semantic.Id = TEXT("semantic");
+  Semantic.Type = EActorAttributeType::Bool;
+  Semantic.RecommendedValues = { TEXT("false") };
+  // Angular sectors streamed as they complete; zero disables.
+  FActorVariation SectorCount;
+  SectorCount.Id = TEXT("sector_count");
+  SectorCount.Type = EActorAttributeType::Int;
+  SectorCount.RecommendedValues = { TEXT("0") };
 
   Definition.Variations.Append(
-      {Channels, Range, PointsPerSecond, Frequency, UpperFOV, LowerFOV});
+      {Channels, Range, PointsPerSecond, Frequency, UpperFOV, LowerFOV, Quantized, Gpu, Semantic, SectorCount});
 
   Success = CheckActorDefinition(Definition);
 }
@@ -891,6 +954,18 @@ void UActorBlueprintFunctionLibrary::MakeGnssDefinition(
   BiasAlt.RecommendedValues = { TEXT("0.0") };
   BiasAlt.bRestrictToRecommended = false;
 
+  // - Batching ----------------------------------
+  FActorVariation BatchSize;
+  BatchSize.Id = TEXT("batch_size");
+  BatchSize.Type = EActorAttributeType::Int;
+  BatchSize.RecommendedValues = { TEXT("1") };
+  BatchSize.bRestrictToRecommended = false;
+  FActorVariation BatchInterval;
+  BatchInterval.Id = TEXT("batch_interval");
+  BatchInterval.Type = EActorAttributeType::Float;
+  BatchInterval.RecommendedValues = { TEXT("0.0") };
+  BatchInterval.bRestrictToRecommended = false;
+
   Definition.Variations.Append({
     NoiseSeed,
     StdDevLat,
@@ -898,7 +973,9 @@ void UActorBlueprintFunctionLibrary::MakeGnssDefinition(
     StdDevLong,
     BiasLong,
     StdDevAlt,
-    BiasAlt});
+    BiasAlt,
+    BatchSize,
+    BatchInterval});
 
   Success = CheckActorDefinition(Definition);
 }
@@ -1317,6 +1394,11 @@ void UActorBlueprintFunctionLibrary::SetCamera(
   Camera->SetImageSize(
       RetrieveActorAttributeToInt("image_size_x", Description.Variations, 800),
       RetrieveActorAttributeToInt("image_size_y", Description.Variations, 600));
+  Camera->SetROI(
+      RetrieveActorAttributeToInt("roi_offset_x", Description.Variations, 0),
+      RetrieveActorAttributeToInt("roi_offset_y", Description.Variations, 0),
+      RetrieveActorAttributeToInt("roi_width", Description.Variations, 0),
+      RetrieveActorAttributeToInt("roi_height", Description.Variations, 0));
   Camera->SetFOVAngle(
       RetrieveActorAttributeToFloat("fov", Description.Variations, 90.0f));
   if (Description.Variations.Contains("enable_postprocess_effects"))
@@ -1432,6 +1514,14 @@ void UActorBlueprintFunctionLibrary::SetLidar(
       RetrieveActorAttributeToFloat("upper_fov", Description.Variations, Lidar.UpperFovLimit);
   Lidar.LowerFovLimit =
       RetrieveActorAttributeToFloat("lower_fov", Description.Variations, Lidar.LowerFovLimit);
+  Lidar.Quantized =
+      RetrieveActorAttributeToBool("quantized", Description.Variations, Lidar.Quantized);
+  Lidar.GpuRayCast =
+      RetrieveActorAttributeToBool("gpu", Description.Variations, Lidar.GpuRayCast);
+  Lidar.Semantic =
+      RetrieveActorAttributeToBool("semantic", Description.Variations, Lidar.Semantic);
+  Lidar.SectorCount =
+      RetrieveActorAttributeToInt("sector_count", Description.Variations, Lidar.SectorCount);
 }
 
 void UActorBlueprintFunctionLibrary::SetGnss(
@@ -1461,6 +1551,11 @@ void UActorBlueprintFunctionLibrary::SetGnss(
       RetrieveActorAttributeToFloat("noise_lon_bias", Description.Variations, 0.0f));
   Gnss->SetAltitudeBias(
       RetrieveActorAttributeToFloat("noise_alt_bias", Description.Variations, 0.0f));
+
+  Gnss->SetBatchSize(
+      RetrieveActorAttributeToInt("batch_size", Description.Variations, 1));
+  Gnss->SetBatchInterval(
+      RetrieveActorAttributeToFloat("batch_interval", Description.Variations, 0.0f));
 }
 
 void UActorBlueprintFunctionLibrary::SetIMU(
@@ -1495,6 +1590,11 @@ void UActorBlueprintFunctionLibrary::SetIMU(
     RetrieveActorAttributeToFloat("noise_gyro_bias_y", Description.Variations, 0.0f),
     RetrieveActorAttributeToFloat("noise_gyro_bias_z", Description.Variations, 0.0f)
   });
+
+  IMU->SetBatchSize(
+      RetrieveActorAttributeToInt("batch_size", Description.Variations, 1));
+  IMU->SetBatchInterval(
+      RetrieveActorAttributeToFloat("batch_interval", Description.Variations, 0.0f));
 }
 
 void UActorBlueprintFunctionLibrary::SetRadar(
@@ -9,9 +9,24 @@
 
 #include "Carla/Actor/ActorBlueprintFunctionLibrary.h"
 #include "Carla/Actor/CarlaActorFactory.h"
+#include "Carla/Vehicle/CarlaWheeledVehicle.h"
 
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Character.h"
 #include "GameFramework/Controller.h"
 
+/// Deactivated actors kept per model; enough for scenario resets without
+/// hoarding a whole town of hidden actors.
+static constexpr int32 MaxPooledActorsPerModel = 32;
+
+static bool IsPoolableActor(AActor &Actor)
+{
+  // Only vehicles and walkers are pooled; sensors hold streams and the rest
+  // are cheap to spawn.
+  return (Cast<ACarlaWheeledVehicle>(&Actor) != nullptr) ||
+         (Cast<ACharacter>(&Actor) != nullptr);
+}
+
 void UActorDispatcher::Bind(FActorDefinition Definition, SpawnFunctionType Functor)
 {
   if (UActorBlueprintFunctionLibrary::CheckActorDefinition(Definition))
@@ -51,7 +66,19 @@ TPair<EActorSpawnResultStatus, FActorView> UActorDispatcher::SpawnActor(
   UE_LOG(LogCarla, Log, TEXT("Spawning actor '%s'"), *Description.Id);
 
   Description.Class = Classes[Description.UId - 1];
-  auto Result = SpawnFunctions[Description.UId - 1](Transform, Description);
+
+  FActorSpawnResult Result;
+  AActor *Reused = TryReuseActorFromPool(Description.Id, Transform);
+  if (Reused != nullptr)
+  {
+    UE_LOG(LogCarla, Log, TEXT("Reusing pooled actor for '%s'"), *Description.Id);
+    Result.Actor = Reused;
+    Result.Status = EActorSpawnResultStatus::Success;
+  }
+  else
+  {
+    Result = SpawnFunctions[Description.UId - 1](Transform, Description);
+  }
 
   if ((Result.Status == EActorSpawnResultStatus::Success) && (Result.Actor == nullptr))
   {
@@ -99,6 +126,15 @@ bool UActorDispatcher::DestroyActor(AActor *Actor)
     }
   }
 
+  // Recycle vehicles and walkers instead of destroying them; respawning the
+  // same model then skips both the asset load and most of the spawn cost.
+  if (TryPutActorInPool(*Actor, Id))
+  {
+    UE_LOG(LogCarla, Log, TEXT("Actor moved to the pool: '%s'"), *Id);
+    Registry.Deregister(Actor);
+    return true;
+  }
+
   // Destroy the actor.
   UE_LOG(LogCarla, Log, TEXT("Destroying actor: '%s'"), *Id);
   if (Actor->Destroy())
@@ -109,12 +145,131 @@ bool UActorDispatcher::DestroyActor(AActor *Actor)
   return false;
 }
 
+void UActorDispatcher::PrewarmActors(const TArray<FString> &Ids)
+{
+  for (const FString &Id : Ids)
+  {
+    const auto *Pool = ActorPool.Find(Id);
+    if ((Pool != nullptr) && (Pool->Num() > 0))
+    {
+      continue; // Already warm.
+    }
+    const FActorDefinition *Definition = Definitions.FindByPredicate(
+        [&Id](const FActorDefinition &Item) { return Item.Id == Id; });
+    if (Definition == nullptr)
+    {
+      UE_LOG(LogCarla, Warning, TEXT("Cannot prewarm unknown actor '%s'"), *Id);
+      continue;
+    }
+    FActorDescription Description;
+    Description.UId = Definition->UId;
+    Description.Id = Definition->Id;
+    Description.Class = Definition->Class;
+    // Spawn out of sight; the load of the meshes, textures, and physics
+    // assets happens here instead of at the first client spawn.
+    const FTransform Transform{FRotator::ZeroRotator, FVector(0.0f, 0.0f, -1e6f)};
+    auto Result = SpawnFunctions[Description.UId - 1u](Transform, Description);
+    if (!Result.IsValid())
+    {
+      UE_LOG(LogCarla, Warning, TEXT("Failed to prewarm actor '%s'"), *Id);
+      continue;
+    }
+    if (!TryPutActorInPool(*Result.Actor, Id))
+    {
+      // Not a poolable kind, the assets are loaded anyway.
+      Result.Actor->Destroy();
+    }
+  }
+}
+
+AActor *UActorDispatcher::TryReuseActorFromPool(const FString &Id, const FTransform &Transform)
+{
+  auto *Pool = ActorPool.Find(Id);
+  if ((Pool == nullptr) || (Pool->Num() == 0))
+  {
+    return nullptr;
+  }
+  const FPooledActor Entry = Pool->Pop(false);
+  AActor *Actor = Entry.Actor;
+  if ((Actor == nullptr) || Actor->IsPendingKill())
+  {
+    return nullptr;
+  }
+
+  Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+  Actor->SetActorHiddenInGame(false);
+  Actor->SetActorEnableCollision(true);
+  Actor->SetActorTickEnabled(true);
+  auto *Root = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+  if (Root != nullptr)
+  {
+    Root->SetSimulatePhysics(Entry.bSimulatePhysics);
+    if (Entry.bSimulatePhysics)
+    {
+      Root->SetPhysicsLinearVelocity(FVector::ZeroVector);
+      Root->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+    }
+  }
+  // The AI controller was destroyed when the actor entered the pool.
+  auto *Pawn = Cast<APawn>(Actor);
+  if ((Pawn != nullptr) && (Pawn->GetController() == nullptr))
+  {
+    Pawn->SpawnDefaultController();
+  }
+  return Actor;
+}
+
+bool UActorDispatcher::TryPutActorInPool(AActor &Actor, const FString &Id)
+{
+  if (!IsPoolableActor(Actor))
+  {
+    return false;
+  }
+  auto &Pool = ActorPool.FindOrAdd(Id);
+  if (Pool.Num() >= MaxPooledActorsPerModel)
+  {
+    return false;
+  }
+
+  FPooledActor Entry;
+  Entry.Actor = &Actor;
+  auto *Root = Cast<UPrimitiveComponent>(Actor.GetRootComponent());
+  Entry.bSimulatePhysics = (Root != nullptr) && Root->IsSimulatingPhysics();
+  if (Root != nullptr)
+  {
+    Root->SetSimulatePhysics(false);
+  }
+  Actor.SetActorHiddenInGame(true);
+  Actor.SetActorEnableCollision(false);
+  Actor.SetActorTickEnabled(false);
+  Pool.Add(Entry);
+  return true;
+}
+
+void UActorDispatcher::OnActorDestroyed(AActor *Actor)
+{
+  // Pooled actors are deregistered already; the world can still tear them
+  // down (e.g. on level unload), drop them from the pool in that case.
+  if (Registry.Find(Actor).IsValid())
+  {
+    Registry.Deregister(Actor);
+  }
+  for (auto &Item : ActorPool)
+  {
+    Item.Value.RemoveAllSwap([Actor](const FPooledActor &Entry)
+    {
+      return Entry.Actor == Actor;
+    });
+  }
+}
+
 FActorView UActorDispatcher::RegisterActor(AActor &Actor, FActorDescription Description, FActorRegistry::IdType DesiredId)
 {
   auto View = Registry.Register(Actor, std::move(Description), DesiredId);
   if (View.IsValid())
   {
-    Actor.OnDestroyed.AddDynamic(this, &UActorDispatcher::OnActorDestroyed);
+    // Unique, a recycled actor registers once per reuse.
+    Actor.OnDestroyed.AddUniqueDynamic(this, &UActorDispatcher::OnActorDestroyed);
   }
   return View;
 }
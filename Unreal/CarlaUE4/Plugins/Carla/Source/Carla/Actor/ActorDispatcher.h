@@ -61,6 +61,12 @@ public:
   /// that should be kept in the registry.
   FActorView RegisterActor(AActor &Actor, FActorDescription ActorDescription, FActorRegistry::IdType DesiredId = 0);
 
+  /// Spawn one pooled instance of each of the given actor definition ids so
+  /// their assets (meshes, textures, physics) are loaded before the first
+  /// real spawn asks for them. Ids without a matching definition are ignored
+  /// with a warning.
+  void PrewarmActors(const TArray<FString> &Ids);
+
   const TArray<FActorDefinition> &GetActorDefinitions() const
   {
     return Definitions;
@@ -74,10 +80,15 @@ public:
 private:
 
   UFUNCTION()
-  void OnActorDestroyed(AActor *Actor)
-  {
-    Registry.Deregister(Actor);
-  }
+  void OnActorDestroyed(AActor *Actor);
+
+  /// Take a deactivated actor of the same model out of the pool and
+  /// reactivate it at @a Transform; nullptr if the pool has none.
+  AActor *TryReuseActorFromPool(const FString &Id, const FTransform &Transform);
+
+  /// Deactivate the actor and keep it for reuse. Returns false if this kind
+  /// of actor is not pooled or the pool for this model is full.
+  bool TryPutActorInPool(AActor &Actor, const FString &Id);
 
   TArray<FActorDefinition> Definitions;
 
@@ -87,4 +98,18 @@ private:
 
   FActorRegistry Registry;
 
+  struct FPooledActor
+  {
+    AActor *Actor;
+
+    /// Whether the root component was simulating physics when pooled, so
+    /// reactivation restores it (vehicles do, walkers do not).
+    bool bSimulatePhysics;
+  };
+
+  /// Deactivated vehicles and walkers ready to be recycled, keyed by the
+  /// actor description id (the model). Recycled actors keep the cosmetic
+  /// attributes they were first spawned with.
+  TMap<FString, TArray<FPooledActor>> ActorPool;
+
 };
@@ -61,13 +61,12 @@ FActorView FActorRegistry::Register(AActor &Actor, FActorDescription Description
 
   if (DesiredId != 0 && Id != DesiredId) {
     // check if the desired Id is free, then use it instead
-    if (!Actors.Contains(DesiredId))
+    if (!Contains(DesiredId))
       Id = DesiredId;
       if (ID_COUNTER < Id)
         ID_COUNTER = Id;
   }
 
-  Actors.Emplace(Id, &Actor);
   if (Ids.Contains(&Actor))
   {
     UE_LOG(
@@ -81,21 +80,32 @@ FActorView FActorRegistry::Register(AActor &Actor, FActorDescription Description
 
   auto View = MakeView(Id, Actor, std::move(Description));
 
-  auto Result = ActorDatabase.emplace(Id, View);
+  auto Result = IndexById.emplace(Id, ActorViews.size());
   check(Result.second);
-  check(static_cast<size_t>(Actors.Num()) == ActorDatabase.size());
-  return Result.first->second;
+  ActorViews.emplace_back(std::move(View));
+  check(static_cast<size_t>(Ids.Num()) == ActorViews.size());
+  ++Version;
+  return ActorViews.back();
 }
 
 void FActorRegistry::Deregister(IdType Id)
 {
-  check(Contains(Id));
-  AActor *Actor = Find(Id).GetActor();
+  auto it = IndexById.find(Id);
+  check(it != IndexById.end());
+  const size_t Index = it->second;
+  AActor *Actor = ActorViews[Index].GetActor();
   check(Actor != nullptr);
-  ActorDatabase.erase(Id);
-  Actors.Remove(Id);
+  // move the last view into the freed slot so the array stays contiguous
+  if (Index + 1u != ActorViews.size())
+  {
+    ActorViews[Index] = std::move(ActorViews.back());
+    IndexById[ActorViews[Index].GetActorId()] = Index;
+  }
+  ActorViews.pop_back();
+  IndexById.erase(Id);
   Ids.Remove(Actor);
-  check(static_cast<size_t>(Actors.Num()) == ActorDatabase.size());
+  check(static_cast<size_t>(Ids.Num()) == ActorViews.size());
+  ++Version;
 }
 
 void FActorRegistry::Deregister(AActor *Actor)
@@ -106,6 +116,17 @@ void FActorRegistry::Deregister(AActor *Actor)
   Deregister(View.GetActorId());
 }
 
+std::vector<FActorView> FActorRegistry::FindMany(const std::vector<IdType> &InIds) const
+{
+  std::vector<FActorView> Result;
+  Result.reserve(InIds.size());
+  for (const auto Id : InIds)
+  {
+    Result.emplace_back(Find(Id));
+  }
+  return Result;
+}
+
 FActorView FActorRegistry::FindOrFake(AActor *Actor) const
 {
   auto View = Find(Actor);
@@ -10,22 +10,15 @@
 
 #include "Containers/Map.h"
 
-#include <compiler/disable-ue4-macros.h>
-#include <carla/Iterator.h>
-#include <compiler/enable-ue4-macros.h>
-
 #include <unordered_map>
+#include <vector>
 
 /// A registry of all the Carla actors.
 class FActorRegistry
 {
-private:
-
-  using DatabaseType = std::unordered_map<FActorView::IdType, FActorView>;
-
 public:
 
-  using IdType = DatabaseType::key_type;
+  using IdType = FActorView::IdType;
 
   // ===========================================================================
   /// @name Actor registry functions
@@ -51,23 +44,30 @@ public:
 
   int32 Num() const
   {
-    return Actors.Num();
+    return static_cast<int32>(ActorViews.size());
   }
 
   bool IsEmpty() const
   {
-    return ActorDatabase.empty();
+    return ActorViews.empty();
   }
 
   bool Contains(uint32 Id) const
   {
-    return ActorDatabase.find(Id) != ActorDatabase.end();
+    return IndexById.find(Id) != IndexById.end();
+  }
+
+  /// Incremented every time an actor is registered or deregistered, cached
+  /// copies of the registry can compare versions to detect changes cheaply.
+  uint64 GetVersion() const
+  {
+    return Version;
   }
 
   FActorView Find(IdType Id) const
   {
-    auto it = ActorDatabase.find(Id);
-    return it != ActorDatabase.end() ? it->second : FActorView();
+    auto it = IndexById.find(Id);
+    return it != IndexById.end() ? ActorViews[it->second] : FActorView();
   }
 
   FActorView Find(AActor *Actor) const
@@ -76,6 +76,10 @@ public:
     return PtrToId != nullptr ? Find(*PtrToId) : FActorView();
   }
 
+  /// Look up a batch of ids in one call, the returned views keep the order
+  /// of @a InIds and misses come back as invalid views.
+  std::vector<FActorView> FindMany(const std::vector<IdType> &InIds) const;
+
   /// If the actor is not found in the registry, create a fake actor view. The
   /// returned FActorView has some information about the @a Actor but will have
   /// an invalid id.
@@ -88,16 +92,16 @@ public:
   /// @{
 public:
 
-  using value_type = DatabaseType::mapped_type;
+  using value_type = FActorView;
 
   auto begin() const noexcept
   {
-    return carla::iterator::make_map_values_const_iterator(ActorDatabase.begin());
+    return ActorViews.begin();
   }
 
   auto end() const noexcept
   {
-    return carla::iterator::make_map_values_const_iterator(ActorDatabase.end());
+    return ActorViews.end();
   }
 
   /// @}
@@ -105,9 +109,14 @@ private:
 
   FActorView MakeView(IdType Id, AActor &Actor, FActorDescription Description) const;
 
-  TMap<IdType, AActor *> Actors;
+  /// Views stored contiguously for fast iteration, in registration order
+  /// except that a deregistration moves the last view into the freed slot.
+  std::vector<FActorView> ActorViews;
+
+  /// Position of each view in ActorViews.
+  std::unordered_map<IdType, size_t> IndexById;
 
   TMap<AActor *, IdType> Ids;
 
-  DatabaseType ActorDatabase;
+  uint64 Version = 0u;
 };
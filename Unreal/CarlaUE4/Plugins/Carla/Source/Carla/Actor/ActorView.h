@@ -30,6 +30,8 @@ public:
   FActorView() = default;
   FActorView(const FActorView &) = default;
   FActorView(FActorView &&) = default;
+  FActorView &operator=(const FActorView &) = default;
+  FActorView &operator=(FActorView &&) = default;
 
   bool IsValid() const
   {
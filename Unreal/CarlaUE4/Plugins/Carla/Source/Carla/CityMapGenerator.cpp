@@ -11,6 +11,7 @@
 #include "MapGen/RoadMap.h"
 #include "Game/Tagger.h"
 
+#include "Async/ParallelFor.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Engine/World.h"
 #include "Paths.h"
@@ -50,6 +51,10 @@ ACityMapGenerator::ACityMapGenerator(const FObjectInitializer& ObjectInitializer
   : Super(ObjectInitializer)
 {
   RoadMap = ObjectInitializer.CreateDefaultSubobject<URoadMap>(this, TEXT("RoadMap"));
+
+  // Only ticks while there are road pieces pending to spawn.
+  PrimaryActorTick.bCanEverTick = true;
+  PrimaryActorTick.bStartWithTickEnabled = false;
 }
 
 ACityMapGenerator::~ACityMapGenerator() {}
@@ -158,56 +163,82 @@ void ACityMapGenerator::GenerateRoads()
 
   FHalfEdgeCounter HalfEdgeCounter;
 
-  // For each edge add road segment.
+  // Collect one entry per undirected edge; the counter is not thread-safe so
+  // the de-duplication stays serial.
+  TArray<const Graph::HalfEdge *> Edges;
   for (auto &edge : graph.GetHalfEdges()) {
     if (HalfEdgeCounter.Insert(edge)) {
-      auto source = Graph::GetSource(edge).GetPosition();
-      auto target = Graph::GetTarget(edge).GetPosition();
-
-      if (source.x == target.x) {
-        // vertical
-        auto y = 1u + margin + std::min(source.y, target.y);
-        auto end = std::max(source.y, target.y) - margin;
-        for (; y < end; ++y) {
-          AddInstance(ECityMapMeshTag::RoadTwoLanes_LaneLeft,          source.x, y, HALF_PI);
-          AddInstance(ECityMapMeshTag::RoadTwoLanes_LaneRight,         source.x, y, HALF_PI);
-          AddInstance(ECityMapMeshTag::RoadTwoLanes_SidewalkLeft,      source.x, y, HALF_PI);
-          AddInstance(ECityMapMeshTag::RoadTwoLanes_SidewalkRight,     source.x, y, HALF_PI);
-          AddInstance(ECityMapMeshTag::RoadTwoLanes_LaneMarkingBroken, source.x, y, HALF_PI);
-        }
-      } else if (source.y == target.y) {
-        // horizontal
-        auto x = 1u + margin + std::min(source.x, target.x);
-        auto end = std::max(source.x, target.x) - margin;
-        for (; x < end; ++x) {
-          AddInstance(ECityMapMeshTag::RoadTwoLanes_LaneLeft,          x, source.y);
-          AddInstance(ECityMapMeshTag::RoadTwoLanes_LaneRight,         x, source.y);
-          AddInstance(ECityMapMeshTag::RoadTwoLanes_SidewalkLeft,      x, source.y);
-          AddInstance(ECityMapMeshTag::RoadTwoLanes_SidewalkRight,     x, source.y);
-          AddInstance(ECityMapMeshTag::RoadTwoLanes_LaneMarkingBroken, x, source.y);
-        }
-      } else {
-        UE_LOG(LogCarla, Warning, TEXT("Diagonal edge ignored"));
+      Edges.Add(&edge);
+    }
+  }
+
+  // Lay out the road segment of each edge in parallel, every edge is
+  // independent and only writes its own bucket. Spawning actors is not
+  // thread-safe so it is done afterwards on the game thread.
+  TArray<TArray<FRoadPiece>> EdgePieces;
+  EdgePieces.SetNum(Edges.Num());
+  ParallelFor(Edges.Num(), [&](int32 Index) {
+    auto &Pieces = EdgePieces[Index];
+    const auto &edge = *Edges[Index];
+    const auto source = Graph::GetSource(edge).GetPosition();
+    const auto target = Graph::GetTarget(edge).GetPosition();
+
+    const auto AddPiece = [&Pieces](ECityMapMeshTag Tag, uint32 X, uint32 Y, float Angle) {
+      Pieces.Add(FRoadPiece{Tag, X, Y, Angle});
+    };
+
+    if (source.x == target.x) {
+      // vertical
+      auto y = 1u + margin + std::min(source.y, target.y);
+      auto end = std::max(source.y, target.y) - margin;
+      for (; y < end; ++y) {
+        AddPiece(ECityMapMeshTag::RoadTwoLanes_LaneLeft,          source.x, y, HALF_PI);
+        AddPiece(ECityMapMeshTag::RoadTwoLanes_LaneRight,         source.x, y, HALF_PI);
+        AddPiece(ECityMapMeshTag::RoadTwoLanes_SidewalkLeft,      source.x, y, HALF_PI);
+        AddPiece(ECityMapMeshTag::RoadTwoLanes_SidewalkRight,     source.x, y, HALF_PI);
+        AddPiece(ECityMapMeshTag::RoadTwoLanes_LaneMarkingBroken, source.x, y, HALF_PI);
+      }
+    } else if (source.y == target.y) {
+      // horizontal
+      auto x = 1u + margin + std::min(source.x, target.x);
+      auto end = std::max(source.x, target.x) - margin;
+      for (; x < end; ++x) {
+        AddPiece(ECityMapMeshTag::RoadTwoLanes_LaneLeft,          x, source.y, 0.0f);
+        AddPiece(ECityMapMeshTag::RoadTwoLanes_LaneRight,         x, source.y, 0.0f);
+        AddPiece(ECityMapMeshTag::RoadTwoLanes_SidewalkLeft,      x, source.y, 0.0f);
+        AddPiece(ECityMapMeshTag::RoadTwoLanes_SidewalkRight,     x, source.y, 0.0f);
+        AddPiece(ECityMapMeshTag::RoadTwoLanes_LaneMarkingBroken, x, source.y, 0.0f);
       }
+    } else {
+      UE_LOG(LogCarla, Warning, TEXT("Diagonal edge ignored"));
     }
+  });
+
+  TArray<FRoadPiece> Pieces;
+  for (auto &Bucket : EdgePieces) {
+    Pieces.Append(MoveTemp(Bucket));
   }
 
+  const auto AddPiece = [&Pieces](ECityMapMeshTag Tag, uint32 X, uint32 Y, float Angle) {
+    Pieces.Add(FRoadPiece{Tag, X, Y, Angle});
+  };
+
 #define ADD_INTERSECTION(tag, x, y, angle) \
-    AddInstance(tag ##_Lane0, x, y, angle); \
-    AddInstance(tag ##_Lane1, x, y, angle); \
-    AddInstance(tag ##_Lane2, x, y, angle); \
-    AddInstance(tag ##_Lane3, x, y, angle); \
-    AddInstance(tag ##_Lane4, x, y, angle); \
-    AddInstance(tag ##_Lane5, x, y, angle); \
-    AddInstance(tag ##_Lane6, x, y, angle); \
-    AddInstance(tag ##_Lane7, x, y, angle); \
-    AddInstance(tag ##_Lane8, x, y, angle); \
-    AddInstance(tag ##_Lane9, x, y, angle); \
-    AddInstance(tag ##_Sidewalk0, x, y, angle); \
-    AddInstance(tag ##_Sidewalk1, x, y, angle); \
-    AddInstance(tag ##_Sidewalk2, x, y, angle); \
-    AddInstance(tag ##_Sidewalk3, x, y, angle); \
-    AddInstance(tag ##_LaneMarking, x, y, angle);
+    AddPiece(tag ##_Lane0, x, y, angle); \
+    AddPiece(tag ##_Lane1, x, y, angle); \
+    AddPiece(tag ##_Lane2, x, y, angle); \
+    AddPiece(tag ##_Lane3, x, y, angle); \
+    AddPiece(tag ##_Lane4, x, y, angle); \
+    AddPiece(tag ##_Lane5, x, y, angle); \
+    AddPiece(tag ##_Lane6, x, y, angle); \
+    AddPiece(tag ##_Lane7, x, y, angle); \
+    AddPiece(tag ##_Lane8, x, y, angle); \
+    AddPiece(tag ##_Lane9, x, y, angle); \
+    AddPiece(tag ##_Sidewalk0, x, y, angle); \
+    AddPiece(tag ##_Sidewalk1, x, y, angle); \
+    AddPiece(tag ##_Sidewalk2, x, y, angle); \
+    AddPiece(tag ##_Sidewalk3, x, y, angle); \
+    AddPiece(tag ##_LaneMarking, x, y, angle);
 
   // For each node add the intersection.
   for (auto &node : graph.GetNodes()) {
@@ -228,6 +259,43 @@ void ACityMapGenerator::GenerateRoads()
   }
 
 #undef ADD_INTERSECTION
+
+  PendingRoadPieces = MoveTemp(Pieces);
+
+  // In game, spread the spawning over the following frames; in the editor
+  // (and whenever the budget is disabled) spawn everything up front.
+  const bool bDeferSpawning =
+      (MaxRoadPiecesSpawnedPerFrame > 0) &&
+      (GetWorld() != nullptr) &&
+      GetWorld()->IsGameWorld();
+
+  if (bDeferSpawning) {
+    SetActorTickEnabled(true);
+  } else {
+    FlushPendingRoadPieces();
+  }
+}
+
+void ACityMapGenerator::SpawnPendingRoadPieces(int32 Count)
+{
+  while ((Count-- > 0) && (PendingRoadPieces.Num() > 0)) {
+    const FRoadPiece Piece = PendingRoadPieces.Pop(false);
+    AddInstance(Piece.Tag, Piece.X, Piece.Y, Piece.Angle);
+  }
+}
+
+void ACityMapGenerator::FlushPendingRoadPieces()
+{
+  SpawnPendingRoadPieces(PendingRoadPieces.Num());
+}
+
+void ACityMapGenerator::Tick(float DeltaTime)
+{
+  Super::Tick(DeltaTime);
+  SpawnPendingRoadPieces(MaxRoadPiecesSpawnedPerFrame);
+  if (PendingRoadPieces.Num() == 0) {
+    SetActorTickEnabled(false);
+  }
 }
 
 // Find first component of type road.
@@ -265,6 +333,9 @@ void ACityMapGenerator::GenerateRoadMap()
   check(GetWorld() != nullptr);
   check(RoadMap != nullptr);
 
+  // The ray casts below need every road piece in place.
+  FlushPendingRoadPieces();
+
   ATagger::TagActorsInLevel(*GetWorld(), bTagForSemanticSegmentation); // We need the tags.
 
   const float IntersectionSize = CityMapMeshTag::GetRoadIntersectionSize();
@@ -281,7 +352,10 @@ void ACityMapGenerator::GenerateRoadMap()
   const FVector MapOffset(-Offset, -Offset, 0.0f);
   RoadMap->Reset(SizeX, SizeY, 1.0f / CmPerPixel, ActorTransform.Inverse(), MapOffset);
 
-  for (uint32 PixelY = 0u; PixelY < SizeY; ++PixelY) {
+  // Trace the pixels row-parallel; the ray casts are read-only physics
+  // queries and every row writes a disjoint range of pixels.
+  ParallelFor(static_cast<int32>(SizeY), [&](int32 RowIndex) {
+    const uint32 PixelY = static_cast<uint32>(RowIndex);
     for (uint32 PixelX = 0u; PixelX < SizeX; ++PixelX) {
       const float X = static_cast<float>(PixelX) * CmPerPixel - Offset;
       const float Y = static_cast<float>(PixelY) * CmPerPixel - Offset;
@@ -304,7 +378,7 @@ void ACityMapGenerator::GenerateRoadMap()
         }
       }
     }
-  }
+  });
 
 #if WITH_EDITOR
   RoadMap->Log();
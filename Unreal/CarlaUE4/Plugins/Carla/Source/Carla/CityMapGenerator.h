@@ -42,6 +42,15 @@ public:
 
   virtual void PreSave(const ITargetPlatform *TargetPlatform) override;
 
+  /// @}
+  // ===========================================================================
+  /// @name Overriden from AActor
+  // ===========================================================================
+  /// @{
+public:
+
+  virtual void Tick(float DeltaTime) override;
+
   /// @}
   // ===========================================================================
   /// @name Overriden from ACityMapMeshHolder
@@ -77,9 +86,18 @@ private:
   /// Regenerate the DCEL.
   void GenerateGraph();
 
-  /// Add the road meshes to the scene based on the current DCEL.
+  /// Lay out the road meshes based on the current DCEL. The layout is
+  /// computed block-parallel; the pieces are then spawned on the game
+  /// thread, either up front or spread over the following frames (see
+  /// MaxRoadPiecesSpawnedPerFrame).
   void GenerateRoads();
 
+  /// Spawn up to @a Count pending road pieces.
+  void SpawnPendingRoadPieces(int32 Count);
+
+  /// Spawn every pending road piece, regardless of the per-frame budget.
+  void FlushPendingRoadPieces();
+
   /// Generate the road map image and save to disk if requested.
   void GenerateRoadMap();
 
@@ -116,6 +134,15 @@ private:
   UPROPERTY(Category = "Map Generation", EditAnywhere, meta = (EditCondition = bUseFixedSeed))
   int32 Seed = 123456789;
 
+  /** Maximum number of road pieces spawned per frame when the map is
+    * generated at play time; the rest are deferred to the following frames
+    * so generation does not block the loading frame. Set to 0 to spawn
+    * everything up front. Editor generation and the road map image always
+    * spawn everything, both need the whole level in place.
+    */
+  UPROPERTY(Category = "Map Generation", EditAnywhere, AdvancedDisplay, meta = (ClampMin = "0"))
+  int32 MaxRoadPiecesSpawnedPerFrame = 500;
+
   /// @}
   // ===========================================================================
   /// @name Road Map
@@ -176,6 +203,19 @@ private:
   /// @{
 private:
 
+  /// Placement of a single road piece; laid out in parallel, spawned on the
+  /// game thread.
+  struct FRoadPiece
+  {
+    ECityMapMeshTag Tag;
+    uint32 X;
+    uint32 Y;
+    float Angle;
+  };
+
+  /// Road pieces laid out but not yet spawned.
+  TArray<FRoadPiece> PendingRoadPieces;
+
   TUniquePtr<MapGen::DoublyConnectedEdgeList> Dcel;
 
   TUniquePtr<MapGen::GraphParser> DcelParser;
@@ -9,7 +9,6 @@
 
 #include "Carla/Game/CarlaEpisode.h"
 #include "Carla/Game/CarlaStaticDelegates.h"
-#include "Carla/Lights/CarlaLightSubsystem.h"
 #include "Carla/Settings/CarlaSettings.h"
 #include "Carla/Settings/EpisodeSettings.h"
 
@@ -60,6 +59,7 @@ void FCarlaEngine::NotifyInitGame(const UCarlaSettings &Settings)
     Server.AsyncRun(FCarlaEngine_GetNumberOfThreadsForRPCServer());
 
     WorldObserver.SetStream(BroadcastStream);
+    WorldObserver.SetFilteredStreams(Server.GetFilteredWorldStreams());
 
     OnPreTickHandle = FWorldDelegates::OnWorldTickStart.AddRaw(
         this,
@@ -95,31 +95,85 @@ void FCarlaEngine::OnPreTick(UWorld *World, ELevelTick TickType, float DeltaSeco
 {
   if ((TickType == ELevelTick::LEVELTICK_All) && (CurrentEpisode != nullptr))
   {
-    // Look for lightsubsystem
-    bool LightUpdatePending = false;
-    if(World)
+    using ESection = FFrameStatsRecorder::ESection;
+
+    // Close the previous frame of the time breakdown; its serialization
+    // ran on a worker thread overlapping this frame, so its duration is
+    // only known now.
+    const double PreTickSeconds = FPlatformTime::Seconds();
+    if (LastPreTickSeconds > 0.0)
     {
-      UCarlaLightSubsystem* CarlaLightSubsystem = World->GetSubsystem<UCarlaLightSubsystem>();
-      if(CarlaLightSubsystem)
-      {
-        LightUpdatePending = CarlaLightSubsystem->IsUpdatePending();
-      }
+      Server.RecordFrameSection(
+          ESection::Serialization,
+          WorldObserver.GetLastSerializationSeconds());
+      Server.RecordFrameSection(
+          ESection::FrameTotal,
+          PreTickSeconds - LastPreTickSeconds);
+      Server.CommitFrameStats();
     }
+    LastPreTickSeconds = PreTickSeconds;
+
+    // Physics mutations queued during the last server slice land here, in
+    // one coalesced pass before the world ticks.
+    Server.FlushPendingPhysicsUpdates();
+    const double PostFlushSeconds = FPlatformTime::Seconds();
+    Server.RecordFrameSection(
+        ESection::PhysicsFlush,
+        PostFlushSeconds - PreTickSeconds);
+
+    // The server tracks which clients still lag behind the light states
+    const bool LightUpdatePending = Server.IsLightUpdatePending();
 
     CurrentEpisode->TickTimers(DeltaSeconds);
     WorldObserver.BroadcastTick(*CurrentEpisode, DeltaSeconds, bMapChanged, LightUpdatePending);
+    Server.NotifyTickBroadcast(GFrameCounter);
+    Server.RecordFrameSection(
+        ESection::StateBroadcast,
+        FPlatformTime::Seconds() - PostFlushSeconds);
 
     ResetSimulationState();
+
+    WorldTickStartSeconds = FPlatformTime::Seconds();
   }
 }
 
 void FCarlaEngine::OnPostTick(UWorld *, ELevelTick, float)
 {
+  using ESection = FFrameStatsRecorder::ESection;
+
+  const double PostTickSeconds = FPlatformTime::Seconds();
+  if (WorldTickStartSeconds > 0.0)
+  {
+    Server.RecordFrameSection(
+        ESection::WorldTick,
+        PostTickSeconds - WorldTickStartSeconds);
+    WorldTickStartSeconds = 0.0;
+  }
+
+  // If the frame just computed was cued with tick_cue_deadline, the
+  // external co-simulator is stepping concurrently and will send the next
+  // cue around the declared deadline: take full slices while there is
+  // slack and switch to short ones near it, so under RPC load the next
+  // frame still starts on time.
+  const double FrameDeadlineSeconds = Server.ConsumeFrameDeadline();
   do
   {
-    Server.RunSome(10u);
+    uint32 SliceMilliseconds = 10u;
+    if (FrameDeadlineSeconds > 0.0)
+    {
+      const double SlackSeconds = FrameDeadlineSeconds - FPlatformTime::Seconds();
+      if (SlackSeconds < 10e-3)
+      {
+        SliceMilliseconds = 1u;
+      }
+    }
+    Server.RunSome(SliceMilliseconds);
   }
   while (bSynchronousMode && !Server.TickCueReceived());
+
+  Server.RecordFrameSection(
+      ESection::RpcDrain,
+      FPlatformTime::Seconds() - PostTickSeconds);
 }
 
 void FCarlaEngine::OnEpisodeSettingsChanged(const FEpisodeSettings &Settings)
@@ -53,6 +53,13 @@ private:
 
   bool bMapChanged = false;
 
+  /// Start of the last frame recorded in the server's time breakdown, zero
+  /// until the first tracked tick.
+  double LastPreTickSeconds = 0.0;
+
+  /// End of the last OnPreTick, start of the measured world tick.
+  double WorldTickStartSeconds = 0.0;
+
   FCarlaServer Server;
 
   FWorldObserver WorldObserver;
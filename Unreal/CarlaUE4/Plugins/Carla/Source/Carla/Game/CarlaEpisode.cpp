@@ -10,6 +10,7 @@
 #include <compiler/disable-ue4-macros.h>
 #include <carla/opendrive/OpenDriveParser.h>
 #include <carla/rpc/String.h>
+#include <carla/rpc/WeatherParameters.h>
 #include <compiler/enable-ue4-macros.h>
 
 #include "Carla/Sensor/Sensor.h"
@@ -211,6 +212,43 @@ bool UCarlaEpisode::LoadNewOpendriveEpisode(
   return true;
 }
 
+void UCarlaEpisode::ResetEpisode(bool bResetSettings, bool bResetWeather)
+{
+  // The replayer drives actors that are about to be destroyed.
+  if (Recorder != nullptr)
+  {
+    Recorder->Stop();
+    if (Recorder->GetReplayer()->IsEnabled())
+    {
+      Recorder->GetReplayer()->Stop();
+    }
+  }
+  // DestroyActor mutates the set, iterate over a copy.
+  const auto ActorIds = ApiSpawnedActorIds.Array();
+  for (const auto ActorId : ActorIds)
+  {
+    auto View = FindActor(ActorId);
+    if (View.IsValid())
+    {
+      DestroyActor(View.GetActor());
+    }
+  }
+  ApiSpawnedActorIds.Empty();
+  if (bResetSettings)
+  {
+    ApplySettings(FEpisodeSettings{});
+  }
+  if (bResetWeather && (Weather != nullptr))
+  {
+    Weather->ApplyWeather(carla::rpc::WeatherParameters::Default);
+  }
+  ElapsedGameTime = 0.0;
+  // A new id makes connected clients treat the next state broadcast as the
+  // start of a fresh episode.
+  Id = URandomEngine::GenerateRandomId();
+  UE_LOG(LogCarla, Log, TEXT("Episode reset in place, new id %llu"), Id);
+}
+
 void UCarlaEpisode::ApplySettings(const FEpisodeSettings &Settings)
 {
   FCarlaStaticDelegates::OnEpisodeSettingsChange.Broadcast(Settings);
@@ -227,6 +265,24 @@ TArray<FTransform> UCarlaEpisode::GetRecommendedSpawnPoints() const
   return SpawnPoints;
 }
 
+const TArray<FVector> &UCarlaEpisode::GetSensorLocations() const
+{
+  if (SensorLocationsFrame != GFrameCounter)
+  {
+    SensorLocationsFrame = GFrameCounter;
+    SensorLocations.Reset();
+    for (const FActorView &View : GetActorRegistry())
+    {
+      const auto *Sensor = Cast<ASensor>(View.GetActor());
+      if ((Sensor != nullptr) && !Sensor->IsPendingKill())
+      {
+        SensorLocations.Add(Sensor->GetActorLocation());
+      }
+    }
+  }
+  return SensorLocations;
+}
+
 carla::rpc::Actor UCarlaEpisode::SerializeActor(FActorView ActorView) const
 {
   carla::rpc::Actor Actor;
@@ -327,13 +383,16 @@ void UCarlaEpisode::EndPlay(void)
   }
 }
 
-std::string UCarlaEpisode::StartRecorder(std::string Name)
+std::string UCarlaEpisode::StartRecorder(
+    std::string Name,
+    std::string Filter,
+    boost::optional<carla::streaming::Stream> StreamSink)
 {
   std::string result;
 
   if (Recorder)
   {
-    result = Recorder->Start(Name, MapName);
+    result = Recorder->Start(Name, MapName, Filter, std::move(StreamSink));
   }
   else
   {
@@ -63,6 +63,16 @@ public:
       const FString &OpenDriveString,
       const carla::rpc::OpendriveGenerationParameters &Params);
 
+  /// Reset this episode in place, without reloading the level.
+  ///
+  /// Destroys every actor spawned through the API, keeping the world-placed
+  /// ones registered at begin play (spectator, traffic signs, props) as well
+  /// as the already-built navigation and tag data, and assigns a new episode
+  /// id so connected clients see a fresh episode. Orders of magnitude faster
+  /// than LoadNewEpisode when the map does not change.
+  UFUNCTION(BlueprintCallable)
+  void ResetEpisode(bool bResetSettings, bool bResetWeather);
+
   // ===========================================================================
   // -- Episode settings -------------------------------------------------------
   // ===========================================================================
@@ -103,6 +113,18 @@ public:
     return ElapsedGameTime;
   }
 
+  /// Revision of the vehicle physics controls, bumped whenever one changes;
+  /// it travels in the state stream header so clients can cache controls.
+  uint64 GetPhysicsControlRevision() const
+  {
+    return PhysicsControlRevision;
+  }
+
+  void BumpPhysicsControlRevision()
+  {
+    ++PhysicsControlRevision;
+  }
+
   /// Return the list of actor definitions that are available to be spawned this
   /// episode.
   UFUNCTION(BlueprintCallable)
@@ -144,6 +166,11 @@ public:
     return ActorDispatcher->GetActorRegistry();
   }
 
+  /// World locations of every registered sensor, rebuilt at most once per
+  /// frame. Used to drive level-of-detail decisions such as freezing the
+  /// animation of walkers no sensor can see.
+  const TArray<FVector> &GetSensorLocations() const;
+
   // ===========================================================================
   // -- Actor look up methods --------------------------------------------------
   // ===========================================================================
@@ -196,6 +223,10 @@ public:
       FActorView::IdType DesiredId = 0)
   {
     auto result = ActorDispatcher->SpawnActor(Transform, thisActorDescription, DesiredId);
+    if (result.Key == EActorSpawnResultStatus::Success)
+    {
+      ApiSpawnedActorIds.Add(result.Value.GetActorId());
+    }
     if (Recorder->IsEnabled())
     {
       if (result.Key == EActorSpawnResultStatus::Success)
@@ -235,20 +266,31 @@ public:
       AActor *Parent,
       EAttachmentType InAttachmentType = EAttachmentType::Rigid);
 
+  /// Preload the assets of the given actor definition ids by spawning one
+  /// pooled instance of each; done at episode start it moves the first-spawn
+  /// load hitches out of the simulation.
+  UFUNCTION(BlueprintCallable)
+  void PrewarmActors(const TArray<FString> &BlueprintIds)
+  {
+    ActorDispatcher->PrewarmActors(BlueprintIds);
+  }
+
   /// @copydoc FActorDispatcher::DestroyActor(AActor*)
   UFUNCTION(BlueprintCallable)
   bool DestroyActor(AActor *Actor)
   {
+      const auto ActorId = GetActorRegistry().Find(Actor).GetActorId();
       if (Recorder->IsEnabled())
       {
         // recorder event
         CarlaRecorderEventDel RecEvent
         {
-          GetActorRegistry().Find(Actor).GetActorId()
+          ActorId
         };
         Recorder->AddEvent(std::move(RecEvent));
       }
 
+    ApiSpawnedActorIds.Remove(ActorId);
     return ActorDispatcher->DestroyActor(Actor);
   }
 
@@ -280,7 +322,10 @@ public:
     return Recorder->GetReplayer();
   }
 
-  std::string StartRecorder(std::string name);
+  std::string StartRecorder(
+      std::string name,
+      std::string filter,
+      boost::optional<carla::streaming::Stream> StreamSink = boost::none);
 
 private:
 
@@ -309,10 +354,22 @@ private:
     ElapsedGameTime += DeltaSeconds;
   }
 
-  const uint64 Id = 0u;
+  /// Regenerated by ResetEpisode, constant otherwise.
+  uint64 Id = 0u;
 
   double ElapsedGameTime = 0.0;
 
+  /// Ids of the actors spawned through the API this episode, i.e. the ones
+  /// ResetEpisode has to destroy; world-placed actors registered at begin
+  /// play are not included.
+  TSet<FActorView::IdType> ApiSpawnedActorIds;
+
+  mutable TArray<FVector> SensorLocations;
+
+  mutable uint64 SensorLocationsFrame = 0u;
+
+  uint64 PhysicsControlRevision = 0u;
+
   UPROPERTY(VisibleAnywhere)
   FString MapName;
 
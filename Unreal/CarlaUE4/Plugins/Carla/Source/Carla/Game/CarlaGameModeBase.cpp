@@ -10,7 +10,6 @@
 
 #include <compiler/disable-ue4-macros.h>
 #include <carla/rpc/WeatherParameters.h>
-#include "carla/opendrive/OpenDriveParser.h"
 #include "carla/road/element/RoadInfoSignal.h"
 #include <compiler/enable-ue4-macros.h>
 
@@ -123,6 +122,7 @@ void ACarlaGameModeBase::BeginPlay()
 
   if (true) { /// @todo If semantic segmentation enabled.
     check(GetWorld() != nullptr);
+    ATagger::ResetAssetLabelCache();
     ATagger::TagActorsInLevel(*GetWorld(), true);
     TaggerDelegate->SetSemanticSegmentationEnabled();
   }
@@ -196,9 +196,8 @@ void ACarlaGameModeBase::ParseOpenDrive(const FString &MapName)
 {
   if(!UCarlaStatics::GetGameInstance(Episode->GetWorld())->IsLevelPendingLoad())
   {
-    std::string opendrive_xml = carla::rpc::FromFString(UOpenDrive::LoadXODR(MapName));
-    Map = carla::opendrive::OpenDriveParser::Load(opendrive_xml);
-    if (!Map.has_value()) {
+    Map = UOpenDrive::GetRoadMap(MapName);
+    if (Map == nullptr) {
       UE_LOG(LogCarla, Error, TEXT("Invalid Map"));
     } else {
       Episode->MapGeoReference = Map->GetGeoReference();
@@ -18,9 +18,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
 
-#include <compiler/disable-ue4-macros.h>
-#include <boost/optional.hpp>
-#include <compiler/enable-ue4-macros.h>
+#include <memory>
 
 #include "CarlaGameModeBase.generated.h"
 
@@ -40,7 +38,7 @@ public:
     return *Episode;
   }
 
-  const boost::optional<carla::road::Map>& GetMap() const {
+  const std::shared_ptr<const carla::road::Map>& GetMap() const {
     return Map;
   }
 
@@ -92,6 +90,7 @@ private:
   UPROPERTY()
   TArray<ACarlaActorFactory *> ActorFactoryInstances;
 
-  boost::optional<carla::road::Map> Map;
+  /// Shared with the process-wide UOpenDrive cache, never mutated.
+  std::shared_ptr<const carla::road::Map> Map;
 
 };
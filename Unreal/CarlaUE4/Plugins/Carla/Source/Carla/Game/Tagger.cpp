@@ -55,10 +55,33 @@ static void SetStencilValue(
       (Label != ECityObjectLabel::None));
 }
 
+/// Labels already resolved from asset paths, keyed weakly so an entry of a
+/// garbage-collected asset can never match a recycled address.
+static TMap<TWeakObjectPtr<const UObject>, ECityObjectLabel> AssetLabelCache;
+
 // =============================================================================
 // -- static ATagger functions -------------------------------------------------
 // =============================================================================
 
+ECityObjectLabel ATagger::GetLabelOfAsset(const UObject *Asset)
+{
+  if (Asset == nullptr) {
+    return ECityObjectLabel::None;
+  }
+  const TWeakObjectPtr<const UObject> Key(Asset);
+  if (const ECityObjectLabel *Cached = AssetLabelCache.Find(Key)) {
+    return *Cached;
+  }
+  const ECityObjectLabel Label = GetLabelByPath(Asset);
+  AssetLabelCache.Add(Key, Label);
+  return Label;
+}
+
+void ATagger::ResetAssetLabelCache()
+{
+  AssetLabelCache.Empty();
+}
+
 void ATagger::TagActor(const AActor &Actor, bool bTagForSemanticSegmentation)
 {
 #ifdef CARLA_TAGGER_EXTRA_LOG
@@ -69,7 +92,7 @@ void ATagger::TagActor(const AActor &Actor, bool bTagForSemanticSegmentation)
   TArray<UStaticMeshComponent *> StaticMeshComponents;
   Actor.GetComponents<UStaticMeshComponent>(StaticMeshComponents);
   for (UStaticMeshComponent *Component : StaticMeshComponents) {
-    const auto Label = GetLabelByPath(Component->GetStaticMesh());
+    const auto Label = GetLabelOfAsset(Component->GetStaticMesh());
     SetStencilValue(*Component, Label, bTagForSemanticSegmentation);
 #ifdef CARLA_TAGGER_EXTRA_LOG
     UE_LOG(LogCarla, Log, TEXT("  + StaticMeshComponent: %s"), *Component->GetName());
@@ -81,7 +104,7 @@ void ATagger::TagActor(const AActor &Actor, bool bTagForSemanticSegmentation)
   TArray<USkeletalMeshComponent *> SkeletalMeshComponents;
   Actor.GetComponents<USkeletalMeshComponent>(SkeletalMeshComponents);
   for (USkeletalMeshComponent *Component : SkeletalMeshComponents) {
-    const auto Label = GetLabelByPath(Component->GetPhysicsAsset());
+    const auto Label = GetLabelOfAsset(Component->GetPhysicsAsset());
     SetStencilValue(*Component, Label, bTagForSemanticSegmentation);
 #ifdef CARLA_TAGGER_EXTRA_LOG
     UE_LOG(LogCarla, Log, TEXT("  + SkeletalMeshComponent: %s"), *Component->GetName());
@@ -55,6 +55,15 @@ public:
   /// objects having this value active.
   static void TagActorsInLevel(UWorld &World, bool bTagForSemanticSegmentation);
 
+  /// Retrieve the label of a mesh asset. The label is resolved from the
+  /// asset's content folder the first time and cached, so tagging an
+  /// instance of an already seen asset is a table lookup.
+  static ECityObjectLabel GetLabelOfAsset(const UObject *Asset);
+
+  /// Drop the cached asset labels; entries of garbage-collected assets can
+  /// never match again anyway, this only trims the table on level loads.
+  static void ResetAssetLabelCache();
+
   /// Retrieve the tag of an already tagged component.
   static ECityObjectLabel GetTagOfTaggedComponent(const UPrimitiveComponent &Component)
   {
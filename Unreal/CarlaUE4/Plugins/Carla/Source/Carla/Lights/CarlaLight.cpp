@@ -40,10 +40,21 @@ void UCarlaLight::EndPlay(const EEndPlayReason::Type EndPlayReason)
   }
 }
 
+void UCarlaLight::RecordLightChange()
+{
+  UWorld *World = GetWorld();
+  if(World)
+  {
+    UCarlaLightSubsystem* CarlaLightSubsystem = World->GetSubsystem<UCarlaLightSubsystem>();
+    CarlaLightSubsystem->NotifyLightChange(*this);
+  }
+}
+
 void UCarlaLight::SetLightIntensity(float Intensity)
 {
   LightIntensity = Intensity;
   UpdateLights();
+  RecordLightChange();
 }
 
 float UCarlaLight::GetLightIntensity()
@@ -55,6 +66,7 @@ void UCarlaLight::SetLightColor(FLinearColor Color)
 {
   LightColor = Color;
   UpdateLights();
+  RecordLightChange();
 }
 
 FLinearColor UCarlaLight::GetLightColor()
@@ -66,6 +78,7 @@ void UCarlaLight::SetLightOn(bool bOn)
 {
   bLightOn = bOn;
   UpdateLights();
+  RecordLightChange();
 }
 
 bool UCarlaLight::GetLightOn()
@@ -105,6 +118,29 @@ void UCarlaLight::SetLightState(carla::rpc::LightState LightState)
   LightType = static_cast<ELightType>(LightState._group);
   bLightOn = LightState._active;
   UpdateLights();
+  RecordLightChange();
+}
+
+void UCarlaLight::ApplyLightStateDelta(const carla::rpc::LightStateDelta &Delta)
+{
+  using Field = carla::rpc::LightStateDelta;
+  if (Delta._fields & Field::IntensityField)
+  {
+    LightIntensity = Delta._intensity;
+  }
+  if (Delta._fields & Field::ColorField)
+  {
+    LightColor = Delta._color;
+  }
+  if (Delta._fields & Field::GroupField)
+  {
+    LightType = static_cast<ELightType>(Delta._group);
+  }
+  if (Delta._fields & Field::ActiveField)
+  {
+    bLightOn = Delta._active;
+  }
+  UpdateLights();
 }
 
 FVector UCarlaLight::GetLocation() const
@@ -76,12 +76,19 @@ public:
 
   void SetLightState(carla::rpc::LightState LightState);
 
+  // Applies only the fields flagged in the delta, the rest keep their value
+  void ApplyLightStateDelta(const carla::rpc::LightStateDelta &Delta);
+
   FVector GetLocation() const;
 
   uint32 GetId() const;
 
 protected:
 
+  // Stamp this light changed in the subsystem registry so the new state
+  // reaches the clients
+  void RecordLightChange();
+
   UPROPERTY(EditAnywhere, Category = "Carla Light")
   ELightType LightType = ELightType::Street;
 
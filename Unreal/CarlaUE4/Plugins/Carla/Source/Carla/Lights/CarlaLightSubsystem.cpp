@@ -20,79 +20,102 @@ void UCarlaLightSubsystem::Deinitialize()
 
 void UCarlaLightSubsystem::RegisterLight(UCarlaLight* CarlaLight)
 {
-  if(CarlaLight)
+  if(CarlaLight && !IdToIndex.Contains(CarlaLight->GetId()))
   {
-    Lights.Add(CarlaLight->GetId(), CarlaLight);
+    const int32 Index = LightArray.Add(CarlaLight);
+    IdToIndex.Add(CarlaLight->GetId(), Index);
+    // New lights have to reach every client
+    LightRevisions.Add(++CurrentRevision);
+    Snapshot.emplace_back();
+    DirtyFlags.Add(false);
+    MarkDirty(Index);
   }
 }
 
 void UCarlaLightSubsystem::UnregisterLight(UCarlaLight* CarlaLight)
 {
-  if(CarlaLight)
+  if(CarlaLight == nullptr)
   {
-    Lights.Remove(CarlaLight->GetId());
+    return;
   }
-}
-
-bool UCarlaLightSubsystem::IsUpdatePending() const
-{
-  for (auto ClientPair : ClientStates)
+  int32 Index;
+  if(!IdToIndex.RemoveAndCopyValue(CarlaLight->GetId(), Index))
   {
-    if(ClientPair.Value)
+    return;
+  }
+  // Swap-remove from the dense arrays and repoint the moved light
+  const int32 LastIndex = LightArray.Num() - 1;
+  if(Index != LastIndex)
+  {
+    LightArray[Index] = LightArray[LastIndex];
+    LightRevisions[Index] = LightRevisions[LastIndex];
+    Snapshot[Index] = Snapshot[LastIndex];
+    DirtyFlags[Index] = DirtyFlags[LastIndex];
+    IdToIndex[LightArray[Index]->GetId()] = Index;
+  }
+  LightArray.Pop(false);
+  LightRevisions.Pop(false);
+  Snapshot.pop_back();
+  DirtyFlags.Pop(false);
+  // The swap invalidated the stored indices, recompute the dirty list;
+  // lights only unregister on map unload so this is not a hot path
+  DirtyLights.Reset();
+  for(int32 i = 0; i < DirtyFlags.Num(); ++i)
+  {
+    if(DirtyFlags[i])
     {
-      return true;
+      DirtyLights.Add(i);
     }
   }
-  return false;
 }
 
-std::vector<carla::rpc::LightState> UCarlaLightSubsystem::GetLights(FString Client)
+void UCarlaLightSubsystem::NotifyLightChange(UCarlaLight &CarlaLight)
 {
-  std::vector<carla::rpc::LightState> result;
-
-  ClientStates.FindOrAdd(Client) = false;
-
-  for(auto& Light : Lights)
+  const int32* Index = IdToIndex.Find(CarlaLight.GetId());
+  if(Index != nullptr)
   {
-    UCarlaLight* CarlaLight = Light.Value;
+    LightRevisions[*Index] = ++CurrentRevision;
+    MarkDirty(*Index);
+  }
+}
 
-    result.push_back(CarlaLight->GetLightState());
+void UCarlaLightSubsystem::GetLightsSnapshot(
+    std::vector<std::pair<uint64, carla::rpc::LightState>> &OutLights)
+{
+  // Refresh only the stale rows, the others did not change since the last
+  // snapshot was taken
+  for(const int32 Index : DirtyLights)
+  {
+    Snapshot[Index].first = LightRevisions[Index];
+    Snapshot[Index].second = LightArray[Index]->GetLightState();
+    DirtyFlags[Index] = false;
   }
-  return result;
+  DirtyLights.Reset();
+  OutLights = Snapshot;
 }
 
 void UCarlaLightSubsystem::SetLights(
-  FString Client,
-  std::vector<carla::rpc::LightState> LightsToSet,
-  bool DiscardClient)
+    const std::vector<carla::rpc::LightStateDelta> &LightsToSet)
 {
-  bool* ClientState = ClientStates.Find(Client);
-
-  if(ClientState) {
-    for(auto& LightState : LightsToSet) {
-      UCarlaLight* CarlaLight = Lights.FindRef(LightState._id);
-      if(CarlaLight) {
-        CarlaLight->SetLightState(LightState);
-      }
-    }
-    *ClientState = true;
-
-    if(DiscardClient)
-    {
-      ClientStates.Remove(Client);
+  // A single revision covers the whole batch; every client has to be told,
+  // the sender included so its state stays in sync with what other clients
+  // may change this frame
+  const uint64 Revision = ++CurrentRevision;
+  for(auto& LightDelta : LightsToSet) {
+    const int32* Index = IdToIndex.Find(LightDelta._id);
+    if(Index != nullptr) {
+      LightArray[*Index]->ApplyLightStateDelta(LightDelta);
+      LightRevisions[*Index] = Revision;
+      MarkDirty(*Index);
     }
   }
-
 }
 
-void UCarlaLightSubsystem::SetClientStatesdirty(FString ClientThatUpdate)
+void UCarlaLightSubsystem::MarkDirty(const int32 Index)
 {
-  for(auto& Client : ClientStates)
+  if(!DirtyFlags[Index])
   {
-    if(Client.Key != ClientThatUpdate)
-    {
-      Client.Value = true;
-    }
-
+    DirtyFlags[Index] = true;
+    DirtyLights.Add(Index);
   }
 }
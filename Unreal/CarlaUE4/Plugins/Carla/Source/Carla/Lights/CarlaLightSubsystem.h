@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include <compiler/disable-ue4-macros.h>
@@ -40,30 +41,56 @@ public:
 
   void UnregisterLight(UCarlaLight* CarlaLight);
 
-  UFUNCTION(BlueprintCallable)
-  bool IsUpdatePending() const;
+  // Stamp a light changed on the server side (day/night scripts, blueprints)
+  // so the change reaches the clients
+  void NotifyLightChange(UCarlaLight &CarlaLight);
 
   UFUNCTION(BlueprintCallable)
   int32 NumLights() const {
-    return Lights.Num();
+    return LightArray.Num();
+  }
+
+  // Revision of the current light states, bumped whenever a light is
+  // registered or changed by a client; the server rebuilds its read-only
+  // snapshot when it advances
+  uint64 GetLightsRevision() const {
+    return CurrentRevision;
   }
 
-  std::vector<carla::rpc::LightState> GetLights(FString Client);
+  // Fills the state of every light paired with the revision it last changed
+  // at, to build the snapshot query_lights_state is served from. Only the
+  // lights marked dirty since the last call are visited, the rest come from
+  // the cached snapshot
+  void GetLightsSnapshot(std::vector<std::pair<uint64, carla::rpc::LightState>> &OutLights);
 
-  void SetLights(
-      FString Client,
-      std::vector<carla::rpc::LightState> LightsToSet,
-      bool DiscardClient = false);
+  void SetLights(const std::vector<carla::rpc::LightStateDelta> &LightsToSet);
 
 private:
 
-  void SetClientStatesdirty(FString ClientThatUpdate);
+  void MarkDirty(int32 Index);
+
+  // Registered lights packed in a dense array; the snapshot path walks
+  // contiguous memory instead of chasing a TMap
+  UPROPERTY()
+  TArray<UCarlaLight*> LightArray;
+
+  // Light id to index into the dense arrays
+  TMap<uint32, int32> IdToIndex;
+
+  // Revision each light last changed at, parallel to LightArray; which
+  // clients have seen which revision is tracked by the server, the subsystem
+  // only stamps the changes
+  TArray<uint64> LightRevisions;
+
+  // Cached per-light snapshot parallel to LightArray, refreshed row by row
+  // from the dirty list
+  std::vector<std::pair<uint64, carla::rpc::LightState>> Snapshot;
+
+  // Indices of the lights whose snapshot row is stale
+  TArray<int32> DirtyLights;
 
-  TMap<uint32, UCarlaLight* > Lights;
+  TArray<bool> DirtyFlags;
 
-  // Flag for each client to tell if an update needs to be done
-  TMap<FString, bool> ClientStates;
-  // Since the clients doesn't have a proper id on the simulation,
-  // I use the host : port pair.
+  uint64 CurrentRevision = 0;
 
 };
@@ -9,6 +9,34 @@
 
 #include "Runtime/Core/Public/HAL/FileManagerGeneric.h"
 
+#include <compiler/disable-ue4-macros.h>
+#include <carla/opendrive/OpenDriveParser.h>
+#include <carla/rpc/String.h>
+#include <compiler/enable-ue4-macros.h>
+
+namespace {
+
+  /// Process-wide cache of OpenDRIVE files, keyed by resolved file path.
+  /// Cycling episodes on the same map is the dominant usage pattern, and
+  /// every level restart used to hit the disk and re-parse the same file
+  /// several times over (game mode, traffic light manager, road generator).
+  struct FXODRCacheEntry
+  {
+    FString Content;
+
+    std::shared_ptr<const carla::road::Map> Map;
+  };
+
+  FCriticalSection XODRCacheMutex;
+
+  TMap<FString, FXODRCacheEntry> &GetXODRCache()
+  {
+    static TMap<FString, FXODRCacheEntry> Cache;
+    return Cache;
+  }
+
+} // namespace
+
 FString UOpenDrive::FindPathToXODRFile(const FString &InMapName)
 {
   FString MapName = InMapName;
@@ -59,10 +87,21 @@ FString UOpenDrive::LoadXODR(const FString &MapName)
   if (FilePath.IsEmpty())
   {
     UE_LOG(LogTemp, Error, TEXT("Failed to find OpenDrive file for map '%s'"), *MapName);
+    return Content;
   }
-  else if (FFileHelper::LoadFileToString(Content, *FilePath))
+
+  FScopeLock Lock(&XODRCacheMutex);
+  auto &Cache = GetXODRCache();
+
+  if (auto *Entry = Cache.Find(FilePath))
+  {
+    return Entry->Content;
+  }
+
+  if (FFileHelper::LoadFileToString(Content, *FilePath))
   {
     UE_LOG(LogTemp, Log, TEXT("Loaded OpenDrive file '%s'"), *FilePath);
+    Cache.Add(FilePath).Content = Content;
   }
   else
   {
@@ -72,6 +111,47 @@ FString UOpenDrive::LoadXODR(const FString &MapName)
   return Content;
 }
 
+std::shared_ptr<const carla::road::Map> UOpenDrive::GetRoadMap(const FString &MapName)
+{
+  const auto FilePath = FindPathToXODRFile(MapName);
+
+  if (FilePath.IsEmpty())
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to find OpenDrive file for map '%s'"), *MapName);
+    return nullptr;
+  }
+
+  FScopeLock Lock(&XODRCacheMutex);
+  auto &Cache = GetXODRCache();
+  auto &Entry = Cache.FindOrAdd(FilePath);
+
+  if (Entry.Map != nullptr)
+  {
+    return Entry.Map;
+  }
+
+  if (Entry.Content.IsEmpty() &&
+      !FFileHelper::LoadFileToString(Entry.Content, *FilePath))
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to load OpenDrive file '%s'"), *FilePath);
+    // Do not keep an empty entry around, a later call should retry the read.
+    Cache.Remove(FilePath);
+    return nullptr;
+  }
+
+  auto ParsedMap = carla::opendrive::OpenDriveParser::Load(
+      carla::rpc::FromFString(Entry.Content));
+
+  if (!ParsedMap.has_value())
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to parse OpenDrive file '%s'"), *FilePath);
+    return nullptr;
+  }
+
+  Entry.Map = std::make_shared<const carla::road::Map>(std::move(*ParsedMap));
+  return Entry.Map;
+}
+
 UOpenDriveMap *UOpenDrive::LoadOpenDriveMap(const FString &MapName)
 {
   UOpenDriveMap *Map = nullptr;
@@ -10,6 +10,8 @@
 
 #include "Kismet/BlueprintFunctionLibrary.h"
 
+#include <memory>
+
 #include "OpenDrive.generated.h"
 
 UCLASS()
@@ -24,10 +26,17 @@ public:
   static FString FindPathToXODRFile(const FString &MapName);
 
   /// Return the OpenDrive XML associated to @a MapName, or empty if the file
-  /// is not found.
+  /// is not found. The file contents are cached process-wide, so only the
+  /// first call for a given map hits the disk.
   UFUNCTION(BlueprintCallable, Category="CARLA|OpenDrive")
   static FString LoadXODR(const FString &MapName);
 
+  /// Return the carla::road::Map associated to @a MapName, or nullptr on
+  /// failure. The map is parsed once per process and shared immutable
+  /// between callers, so cycling episodes on the same map skips both the
+  /// disk read and the parse.
+  static std::shared_ptr<const carla::road::Map> GetRoadMap(const FString &MapName);
+
   /// Load OpenDriveMap associated to the given MapName. Return nullptr if no
   /// XODR can be found with same MapName.
   UFUNCTION(BlueprintCallable, Category="CARLA|OpenDrive")
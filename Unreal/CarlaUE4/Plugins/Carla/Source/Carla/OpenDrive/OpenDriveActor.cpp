@@ -11,9 +11,7 @@
 
 #include <compiler/disable-ue4-macros.h>
 #include <carla/geom/Math.h>
-#include <carla/opendrive/OpenDriveParser.h>
 #include <carla/road/element/Waypoint.h>
-#include <carla/rpc/String.h>
 #include <compiler/enable-ue4-macros.h>
 
 #include <algorithm>
@@ -134,13 +132,11 @@ void AOpenDriveActor::BuildRoutes(FString MapName)
 {
   using Waypoint = carla::road::element::Waypoint;
 
-  // As the OpenDrive file has the same name as level, build the path to the
-  // xodr file using the lavel name and the game content directory.
-  const FString XodrContent = UOpenDrive::LoadXODR(MapName);
+  // As the OpenDrive file has the same name as level, grab the parsed map
+  // from the process-wide cache using the level name.
+  auto map = UOpenDrive::GetRoadMap(MapName);
 
-  auto map = carla::opendrive::OpenDriveParser::Load(carla::rpc::FromFString(XodrContent));
-
-  if (!map.has_value())
+  if (map == nullptr)
   {
     UE_LOG(LogCarla, Error, TEXT("Failed to parse OpenDrive file."));
     return;
@@ -14,13 +14,15 @@
 #include <carla/rpc/String.h>
 #include <compiler/enable-ue4-macros.h>
 
+#include "Async/Async.h"
 #include "Engine/Classes/Interfaces/Interface_CollisionDataProvider.h"
 #include "PhysicsEngine/BodySetupEnums.h"
 
 AOpenDriveGenerator::AOpenDriveGenerator(const FObjectInitializer &ObjectInitializer)
   : Super(ObjectInitializer)
 {
-  PrimaryActorTick.bCanEverTick = false;
+  PrimaryActorTick.bCanEverTick = true;
+  PrimaryActorTick.bStartWithTickEnabled = false;
   RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneComponent"));
   SetRootComponent(RootComponent);
   RootComponent->Mobility = EComponentMobility::Static;
@@ -36,13 +38,14 @@ bool AOpenDriveGenerator::LoadOpenDrive(const FString &OpenDrive)
     return false;
   }
 
-  CarlaMap = OpenDriveLoader::Load(carla::rpc::FromFString(OpenDrive));
-  if (!CarlaMap.has_value())
+  auto ParsedMap = OpenDriveLoader::Load(carla::rpc::FromFString(OpenDrive));
+  if (!ParsedMap.has_value())
   {
     UE_LOG(LogCarla, Error, TEXT("The OpenDrive is invalid or not supported"));
     return false;
   }
 
+  CarlaMap = std::make_shared<const carla::road::Map>(std::move(*ParsedMap));
   OpenDriveData = OpenDrive;
   return true;
 }
@@ -54,7 +57,7 @@ const FString &AOpenDriveGenerator::GetOpenDrive() const
 
 bool AOpenDriveGenerator::IsOpenDriveValid() const
 {
-  return CarlaMap.has_value();
+  return CarlaMap != nullptr;
 }
 
 void AOpenDriveGenerator::GenerateRoadMesh()
@@ -76,42 +79,27 @@ void AOpenDriveGenerator::GenerateRoadMesh()
     carla::log_warning("Missing game instance");
   }
 
-  const auto Meshes = CarlaMap->GenerateChunkedMesh(
-      Parameters.vertex_distance,
-      Parameters.max_road_length,
-      Parameters.additional_width,
-      Parameters.smooth_junctions);
-  for (const auto &Mesh : Meshes) {
-    AActor *TempActor = GetWorld()->SpawnActor<AActor>();
-    UProceduralMeshComponent *TempPMC = NewObject<UProceduralMeshComponent>(TempActor);
-    TempPMC->RegisterComponent();
-    TempPMC->AttachToComponent(
-        TempActor->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
-    TempPMC->bUseAsyncCooking = true;
-    TempPMC->bUseComplexAsSimpleCollision = true;
-    TempPMC->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-
-    const FProceduralCustomMesh MeshData = *Mesh;
-    TempPMC->CreateMeshSection_LinearColor(
-        0,
-        MeshData.Vertices,
-        MeshData.Triangles,
-        MeshData.Normals,
-        TArray<FVector2D>(), // UV0
-        TArray<FLinearColor>(), // VertexColor
-        TArray<FProcMeshTangent>(), // Tangents
-        true); // Create collision
-
-    ActorMeshList.Add(TempActor);
-  }
-
-  if(!Parameters.enable_mesh_visibility)
-  {
-    for(AActor * actor : ActorMeshList)
-    {
-      actor->SetActorHiddenInGame(true);
+  bRoadMeshVisible = Parameters.enable_mesh_visibility;
+  bAllRoadSectionsEnqueued = false;
+  SetActorTickEnabled(true);
+
+  // Computing the mesh data takes tens of seconds on large maps, do it on a
+  // worker thread; Tick drains the finished sections into the level. The
+  // worker only reads CarlaMap, which is not touched again until EndPlay has
+  // waited for the task.
+  MeshGenerationTask = Async(EAsyncExecution::Thread, [this, Parameters]() {
+    const auto Meshes = CarlaMap->GenerateChunkedMesh(
+        Parameters.vertex_distance,
+        Parameters.max_road_length,
+        Parameters.additional_width,
+        Parameters.smooth_junctions);
+    for (const auto &Mesh : Meshes) {
+      RoadSections.Enqueue(
+          MakeShared<FProceduralCustomMesh, ESPMode::ThreadSafe>(
+              static_cast<FProceduralCustomMesh>(*Mesh)));
     }
-  }
+    bAllRoadSectionsEnqueued = true;
+  });
 
   // // Build collision data
   // FTriMeshCollisionData CollisitonData;
@@ -130,6 +118,57 @@ void AOpenDriveGenerator::GenerateRoadMesh()
   // }
 }
 
+void AOpenDriveGenerator::AddRoadMeshSection(const FProceduralCustomMesh &MeshData)
+{
+  AActor *TempActor = GetWorld()->SpawnActor<AActor>();
+  UProceduralMeshComponent *TempPMC = NewObject<UProceduralMeshComponent>(TempActor);
+  TempPMC->RegisterComponent();
+  TempPMC->AttachToComponent(
+      TempActor->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+  TempPMC->bUseAsyncCooking = true;
+  TempPMC->bUseComplexAsSimpleCollision = true;
+  TempPMC->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+  TempPMC->CreateMeshSection_LinearColor(
+      0,
+      MeshData.Vertices,
+      MeshData.Triangles,
+      MeshData.Normals,
+      TArray<FVector2D>(), // UV0
+      TArray<FLinearColor>(), // VertexColor
+      TArray<FProcMeshTangent>(), // Tangents
+      true); // Create collision
+
+  if (!bRoadMeshVisible)
+  {
+    TempActor->SetActorHiddenInGame(true);
+  }
+
+  ActorMeshList.Add(TempActor);
+}
+
+void AOpenDriveGenerator::Tick(float DeltaSeconds)
+{
+  Super::Tick(DeltaSeconds);
+
+  // Limit the sections registered per frame so the streaming does not cause
+  // the spike it is meant to avoid; each section cooks its collision
+  // asynchronously.
+  constexpr int32 MaxSectionsPerFrame = 4;
+  int32 Registered = 0;
+  TSharedPtr<FProceduralCustomMesh, ESPMode::ThreadSafe> Section;
+  while ((Registered < MaxSectionsPerFrame) && RoadSections.Dequeue(Section))
+  {
+    AddRoadMeshSection(*Section);
+    ++Registered;
+  }
+
+  if (RoadSections.IsEmpty() && bAllRoadSectionsEnqueued)
+  {
+    SetActorTickEnabled(false);
+  }
+}
+
 void AOpenDriveGenerator::GeneratePoles()
 {
   if (!IsOpenDriveValid())
@@ -170,9 +209,15 @@ void AOpenDriveGenerator::BeginPlay()
 {
   Super::BeginPlay();
 
-  // Search for "{project_content_folder}/Carla/Maps/OpenDrive/{current_map_name}.xodr"
-  const FString XodrContent = UOpenDrive::LoadXODR(GetWorld()->GetMapName());
-  LoadOpenDrive(XodrContent);
+  // Search for "{project_content_folder}/Carla/Maps/OpenDrive/{current_map_name}.xodr";
+  // both the contents and the parsed map come from the process-wide cache.
+  const FString MapName = GetWorld()->GetMapName();
+  OpenDriveData = UOpenDrive::LoadXODR(MapName);
+  CarlaMap = UOpenDrive::GetRoadMap(MapName);
+  if (CarlaMap == nullptr)
+  {
+    UE_LOG(LogCarla, Error, TEXT("The OpenDrive is invalid or not supported"));
+  }
 
   GenerateAll();
 
@@ -185,3 +230,13 @@ void AOpenDriveGenerator::BeginPlay()
     World->SpawnActor<ATrafficLightManager>();
   }
 }
+
+void AOpenDriveGenerator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+  // The worker reads CarlaMap, let it finish before the actor goes away.
+  if (MeshGenerationTask.IsValid())
+  {
+    MeshGenerationTask.Wait();
+  }
+  Super::EndPlay(EndPlayReason);
+}
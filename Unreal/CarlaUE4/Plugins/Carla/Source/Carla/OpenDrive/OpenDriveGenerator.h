@@ -5,12 +5,17 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 #pragma once
 
+#include "Async/Future.h"
+#include "Containers/Queue.h"
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "ProceduralMeshComponent.h"
+#include "Util/ProceduralCustomMesh.h"
+
+#include <atomic>
+#include <memory>
 
 #include <compiler/disable-ue4-macros.h>
-#include <boost/optional.hpp>
 #include "carla/road/Map.h"
 #include <compiler/enable-ue4-macros.h>
 
@@ -38,6 +43,9 @@ public:
   bool IsOpenDriveValid() const;
 
   /// Generates the road and sidewalk mesh based on the OpenDRIVE information.
+  /// The mesh data is computed on a background thread and the finished road
+  /// sections are streamed into the level a few per frame, so the server
+  /// accepts connections while distant geometry is still building.
   void GenerateRoadMesh();
 
   /// Generates pole meshes based on the OpenDRIVE information.
@@ -52,6 +60,16 @@ protected:
 
   virtual void BeginPlay() override;
 
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+  virtual void Tick(float DeltaSeconds) override;
+
+private:
+
+  /// Register one finished road section in the level; collision cooking is
+  /// asynchronous.
+  void AddRoadMeshSection(const FProceduralCustomMesh &MeshData);
+
   /// Determine the height where the spawners will be placed, relative to each
   /// RoutePlanner
   UPROPERTY(Category = "Spawners", EditAnywhere)
@@ -66,6 +84,17 @@ protected:
   UPROPERTY(EditAnywhere)
   TArray<AActor *> ActorMeshList;
 
-  boost::optional<carla::road::Map> CarlaMap;
+  /// Shared with the process-wide UOpenDrive cache when loaded from disk,
+  /// never mutated.
+  std::shared_ptr<const carla::road::Map> CarlaMap;
+
+  /// Road sections computed on the worker thread, drained by Tick.
+  TQueue<TSharedPtr<FProceduralCustomMesh, ESPMode::ThreadSafe>, EQueueMode::Spsc> RoadSections;
+
+  /// Set by the worker thread once every section has been enqueued.
+  std::atomic<bool> bAllRoadSectionsEnqueued{true};
+
+  TFuture<void> MeshGenerationTask;
 
+  bool bRoadMeshVisible = true;
 };
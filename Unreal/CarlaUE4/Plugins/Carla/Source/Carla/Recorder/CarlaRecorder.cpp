@@ -59,6 +59,11 @@ inline void ACarlaRecorder::SetReplayerIgnoreHero(bool IgnoreHero)
   Replayer.SetIgnoreHero(IgnoreHero);
 }
 
+double ACarlaRecorder::FastForwardReplayer(double Time)
+{
+  return Replayer.FastForwardTo(Time);
+}
+
 void ACarlaRecorder::Tick(float DeltaSeconds)
 {
   Super::Tick(DeltaSeconds);
@@ -71,6 +76,13 @@ void ACarlaRecorder::Tick(float DeltaSeconds)
   {
     const FActorRegistry &Registry = Episode->GetActorRegistry();
 
+    // hero locations for the radius option of the filter
+    Filter.UpdateHeroLocations(Registry);
+    const bool RecordPositions = Filter.ShouldRecordPositions(TickCounter);
+    const bool RecordStates = Filter.ShouldRecordStates(TickCounter);
+    const bool RecordAnimations = Filter.ShouldRecordAnimations(TickCounter);
+    ++TickCounter;
+
     // through all actors in registry
     for (auto It = Registry.begin(); It != Registry.end(); ++It)
     {
@@ -78,21 +90,32 @@ void ACarlaRecorder::Tick(float DeltaSeconds)
 
       switch (View.GetActorType())
       {
-        // save the transform of all vehicles
+        // save the transform of the selected vehicles
         case FActorView::ActorType::Vehicle:
-          AddActorPosition(View);
-          AddVehicleAnimation(View);
+          if (Filter.ShouldRecordActor(View))
+          {
+            if (RecordPositions)
+              AddActorPosition(View);
+            if (RecordAnimations)
+              AddVehicleAnimation(View);
+          }
           break;
 
-        // save the transform of all walkers
+        // save the transform of the selected walkers
         case FActorView::ActorType::Walker:
-          AddActorPosition(View);
-          AddWalkerAnimation(View);
+          if (Filter.ShouldRecordActor(View))
+          {
+            if (RecordPositions)
+              AddActorPosition(View);
+            if (RecordAnimations)
+              AddWalkerAnimation(View);
+          }
           break;
 
-        // save the state of each traffic light
+        // save the state of the selected traffic lights
         case FActorView::ActorType::TrafficLight:
-          AddTrafficLightState(View);
+          if (RecordStates && Filter.ShouldRecordActor(View))
+            AddTrafficLightState(View);
           break;
       }
     }
@@ -205,7 +228,11 @@ void ACarlaRecorder::AddTrafficLightState(FActorView &View)
   }
 }
 
-std::string ACarlaRecorder::Start(std::string Name, FString MapName)
+std::string ACarlaRecorder::Start(
+    std::string Name,
+    FString MapName,
+    std::string FilterSpec,
+    boost::optional<carla::streaming::Stream> StreamSink)
 {
   // stop replayer if any in course
   if (Replayer.IsEnabled())
@@ -217,24 +244,35 @@ std::string ACarlaRecorder::Start(std::string Name, FString MapName)
   // reset collisions Id
   NextCollisionId = 0;
 
+  // select what gets recorded
+  Filter.Parse(FilterSpec);
+  TickCounter = 0;
+
   // get the final path + filename
   std::string Filename = GetRecorderFilename(Name);
 
-  // binary file
-  File.open(Filename, std::ios::binary);
-  if (!File.is_open())
-  {
-    return "";
-  }
-
-  // save info
-  Info.Version = 1;
+  // save info (version 2 stores the packets as compressed blocks)
+  Info.Version = 2;
   Info.Magic = TEXT("CARLA_RECORDER");
   Info.Date = std::time(0);
   Info.Mapfile = MapName;
 
-  // write general info
-  Info.Write(File);
+  // serialize the general info, it goes uncompressed at the start of the
+  // file
+  std::ostringstream InfoHeader;
+  Info.Write(InfoHeader);
+  const std::string InfoData = InfoHeader.str();
+
+  // binary file or stream sink, written from its own thread
+  if (!FileWriter.Open(Filename, InfoData, std::move(StreamSink)))
+  {
+    return "";
+  }
+
+  // the first frame starts right after the info
+  StreamOffset = InfoData.size();
+  NextKeyframeTime = 0.0;
+  Index.Clear();
 
   Frames.Reset();
 
@@ -250,11 +288,24 @@ void ACarlaRecorder::Stop(void)
 {
   Disable();
 
-  if (File)
+  // the duration of the last frame is unknown, its record keeps the dummy
+  // marker
+  FileWriter.EnqueueFrame(std::move(PreviousFrameData));
+  PreviousFrameData.clear();
+
+  // append the keyframe index as the last packet so the replayer can seek
+  // without scanning the whole file
+  if (!Index.IsEmpty())
   {
-    File.close();
+    std::ostringstream IndexData;
+    Index.Write(IndexData);
+    FileWriter.EnqueueFrame(IndexData.str());
+    Index.Clear();
   }
 
+  // flushes the pending frames and joins the writer thread
+  FileWriter.Close();
+
   Clear();
 }
 
@@ -275,25 +326,52 @@ void ACarlaRecorder::Write(double DeltaSeconds)
   // update this frame data
   Frames.SetFrame(DeltaSeconds);
 
+  // now that the duration of the previous frame is known, patch it into its
+  // record and hand it over to the writer thread
+  Frames.BackPatchDuration(PreviousFrameData);
+  FileWriter.EnqueueFrame(std::move(PreviousFrameData));
+
+  // serialize this frame to memory, it is held back one tick so the next
+  // frame can patch in its duration; the buffer keeps its storage across
+  // ticks
+  FrameBuffer.Reset();
+  std::ostream &Buffer = FrameBuffer;
+
   // start
-  Frames.WriteStart(File);
+  Frames.WriteStart(Buffer);
+
+  // periodic full snapshot of the alive actors so the replayer can start
+  // from this frame, its offset goes to the keyframe index
+  if (Frames.GetElapsed() >= NextKeyframeTime)
+  {
+    AddKeyframeActors();
+    Keyframe.WriteKeyframe(Buffer);
+    KeyframeParents.WriteKeyframe(Buffer);
+    Keyframe.Clear();
+    KeyframeParents.Clear();
+    Index.Add(Frames.GetElapsed(), StreamOffset);
+    NextKeyframeTime = Frames.GetElapsed() + KeyframeInterval;
+  }
 
   // events
-  EventsAdd.Write(File);
-  EventsDel.Write(File);
-  EventsParent.Write(File);
-  Collisions.Write(File);
+  EventsAdd.Write(Buffer);
+  EventsDel.Write(Buffer);
+  EventsParent.Write(Buffer);
+  Collisions.Write(Buffer);
 
   // positions and states
-  Positions.Write(File);
-  States.Write(File);
+  Positions.Write(Buffer);
+  States.Write(Buffer);
 
   // animations
-  Vehicles.Write(File);
-  Walkers.Write(File);
+  Vehicles.Write(Buffer);
+  Walkers.Write(Buffer);
 
   // end
-  Frames.WriteEnd(File);
+  Frames.WriteEnd(Buffer);
+
+  PreviousFrameData.assign(FrameBuffer.GetData(), FrameBuffer.GetSize());
+  StreamOffset += PreviousFrameData.size();
 
   Clear();
 }
@@ -406,11 +484,11 @@ void ACarlaRecorder::AddExistingActors(void)
   }
 }
 
-void ACarlaRecorder::CreateRecorderEventAdd(
+CarlaRecorderEventAdd ACarlaRecorder::MakeEventAdd(
     uint32_t DatabaseId,
     uint8_t Type,
     const FTransform &Transform,
-    FActorDescription ActorDescription)
+    const FActorDescription &ActorDescription)
 {
   CarlaRecorderActorDescription Description;
   Description.UId = ActorDescription.UId;
@@ -432,7 +510,7 @@ void ACarlaRecorder::CreateRecorderEventAdd(
   }
 
   // recorder event
-  CarlaRecorderEventAdd RecEvent
+  return CarlaRecorderEventAdd
   {
     DatabaseId,
     Type,
@@ -440,5 +518,50 @@ void ACarlaRecorder::CreateRecorderEventAdd(
     Transform.GetRotation().Euler(),
     std::move(Description)
   };
-  AddEvent(std::move(RecEvent));
+}
+
+void ACarlaRecorder::CreateRecorderEventAdd(
+    uint32_t DatabaseId,
+    uint8_t Type,
+    const FTransform &Transform,
+    FActorDescription ActorDescription)
+{
+  AddEvent(MakeEventAdd(DatabaseId, Type, Transform, ActorDescription));
+}
+
+void ACarlaRecorder::AddKeyframeActors(void)
+{
+  // snapshot of all the alive actors, same records a sequential replay
+  // would have accumulated through the add and parent events
+  const FActorRegistry &Registry = Episode->GetActorRegistry();
+  for (auto It = Registry.begin(); It != Registry.end(); ++It)
+  {
+    FActorView View = *It;
+    AActor *Actor = View.GetActor();
+    if ((Actor == nullptr) || (View.GetActorInfo() == nullptr))
+    {
+      continue;
+    }
+
+    Keyframe.Add(MakeEventAdd(
+        View.GetActorId(),
+        static_cast<uint8_t>(View.GetActorType()),
+        Actor->GetActorTransform(),
+        View.GetActorInfo()->Description));
+
+    // record the attachment, if any
+    AActor *Parent = Actor->GetAttachParentActor();
+    if (Parent != nullptr)
+    {
+      FActorView ParentView = Registry.Find(Parent);
+      if (ParentView.GetActorInfo() != nullptr)
+      {
+        KeyframeParents.Add(CarlaRecorderEventParent
+        {
+          View.GetActorId(),
+          ParentView.GetActorId()
+        });
+      }
+    }
+  }
 }
@@ -7,7 +7,7 @@
 #pragma once
 
 // #include "GameFramework/Actor.h"
-#include <fstream>
+#include <sstream>
 
 #include "Carla/Actor/ActorDescription.h"
 
@@ -17,6 +17,10 @@
 #include "CarlaRecorderEventAdd.h"
 #include "CarlaRecorderEventDel.h"
 #include "CarlaRecorderEventParent.h"
+#include "CarlaRecorderFileWriter.h"
+#include "CarlaRecorderFilter.h"
+#include "CarlaRecorderHelpers.h"
+#include "CarlaRecorderFrameIndex.h"
 #include "CarlaRecorderFrames.h"
 #include "CarlaRecorderInfo.h"
 #include "CarlaRecorderPosition.h"
@@ -40,7 +44,14 @@ enum class CarlaRecorderPacketId : uint8_t
   Position,
   State,
   AnimVehicle,
-  AnimWalker
+  AnimWalker,
+  // full snapshot of the alive actors, written periodically so the
+  // replayer can start mid-file
+  Keyframe,
+  // attachments of the alive actors, written next to every keyframe
+  KeyframeParent,
+  // keyframe index, written as the last packet of the recording
+  FrameIndex
 };
 
 /// Recorder for the simulation
@@ -63,8 +74,16 @@ public:
 
   void Disable(void);
 
-  // start / stop
-  std::string Start(std::string Name, FString MapName);
+  // start / stop, the filter string selects which actors and packet
+  // categories are recorded (see CarlaRecorderFilter); with a stream sink
+  // the recording travels to a collector client instead of the local file,
+  // which only catches blocks produced while no collector is subscribed
+  // (see CarlaRecorderFileWriter)
+  std::string Start(
+      std::string Name,
+      FString MapName,
+      std::string FilterSpec = "",
+      boost::optional<carla::streaming::Stream> StreamSink = boost::none);
 
   void Stop(void);
 
@@ -117,6 +136,7 @@ public:
   std::string ReplayFile(std::string Name, double TimeStart, double Duration, uint32_t FollowId);
   void SetReplayerTimeFactor(double TimeFactor);
   void SetReplayerIgnoreHero(bool IgnoreHero);
+  double FastForwardReplayer(double Time);
 
   void Tick(float DeltaSeconds) final;
 
@@ -126,8 +146,31 @@ private:
 
   uint32_t NextCollisionId = 0;
 
-  // files
-  std::ofstream File;
+  // output file, written from its own thread
+  CarlaRecorderFileWriter FileWriter;
+
+  // serialized frame held back one tick so the next frame can patch in its
+  // duration before it travels to the writer thread
+  std::string PreviousFrameData;
+
+  // frame serialization buffer, its storage is reused every tick
+  CarlaRecorderBuffer FrameBuffer;
+
+  // offset the next serialized frame will have in the packet stream
+  uint64_t StreamOffset = 0;
+
+  // a keyframe snapshot is written at least once every this many seconds of
+  // simulation time, jumps of the replayer land on them
+  constexpr static double KeyframeInterval = 10.0;
+
+  // simulation time the next keyframe snapshot is due at
+  double NextKeyframeTime = 0.0;
+
+  // record-time filter, parsed from the filter string given to Start
+  CarlaRecorderFilter Filter;
+
+  // ticks recorded so far, drives the per-category record rates
+  uint64_t TickCounter = 0;
 
   UCarlaEpisode *Episode = nullptr;
 
@@ -142,6 +185,9 @@ private:
   CarlaRecorderStates States;
   CarlaRecorderAnimVehicles Vehicles;
   CarlaRecorderAnimWalkers Walkers;
+  CarlaRecorderEventsAdd Keyframe;
+  CarlaRecorderEventsParent KeyframeParents;
+  CarlaRecorderFrameIndex Index;
 
   // replayer
   CarlaReplayer Replayer;
@@ -150,6 +196,12 @@ private:
   CarlaRecorderQuery Query;
 
   void AddExistingActors(void);
+  void AddKeyframeActors(void);
+  CarlaRecorderEventAdd MakeEventAdd(
+      uint32_t DatabaseId,
+      uint8_t Type,
+      const FTransform &Transform,
+      const FActorDescription &ActorDescription);
   void AddActorPosition(FActorView &View);
   void AddWalkerAnimation(FActorView &View);
   void AddVehicleAnimation(FActorView &View);
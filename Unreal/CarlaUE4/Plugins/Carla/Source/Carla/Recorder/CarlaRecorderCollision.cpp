@@ -8,7 +8,9 @@
 #include "CarlaRecorderCollision.h"
 #include "CarlaRecorderHelpers.h"
 
-void CarlaRecorderCollision::Read(std::ifstream &InFile)
+#include <algorithm>
+
+void CarlaRecorderCollision::Read(std::istream &InFile)
 {
     // id
     ReadValue<uint32_t>(InFile, this->Id);
@@ -19,7 +21,7 @@ void CarlaRecorderCollision::Read(std::ifstream &InFile)
     ReadValue<bool>(InFile, this->IsActor1Hero);
     ReadValue<bool>(InFile, this->IsActor2Hero);
 }
-void CarlaRecorderCollision::Write(std::ofstream &OutFile) const
+void CarlaRecorderCollision::Write(std::ostream &OutFile) const
 {
     // id
     WriteValue<uint32_t>(OutFile, this->Id);
@@ -37,17 +39,70 @@ bool CarlaRecorderCollision::operator==(const CarlaRecorderCollision &Other) con
 }
 //---------------------------------------------
 
+uint64_t CarlaRecorderCollisions::HashPair(uint32_t Id1, uint32_t Id2)
+{
+    // 64-bit finalizer mix over both ids
+    uint64_t Key = (static_cast<uint64_t>(Id1) << 32) | Id2;
+    Key ^= Key >> 33;
+    Key *= 0xff51afd7ed558ccdULL;
+    Key ^= Key >> 33;
+    Key *= 0xc4ceb9fe1a85ec53ULL;
+    Key ^= Key >> 33;
+    return Key;
+}
+
+void CarlaRecorderCollisions::Rehash(size_t NewCapacity)
+{
+    Slots.assign(NewCapacity, Slot());
+    const uint64_t Mask = NewCapacity - 1u;
+    for (uint32_t Index = 0; Index < Collisions.size(); ++Index)
+    {
+        const CarlaRecorderCollision &Collision = Collisions[Index];
+        uint64_t Probe = HashPair(Collision.DatabaseId1, Collision.DatabaseId2) & Mask;
+        while (Slots[Probe].Generation == Generation)
+            Probe = (Probe + 1u) & Mask;
+        Slots[Probe].Generation = Generation;
+        Slots[Probe].Index = Index;
+    }
+}
+
 void CarlaRecorderCollisions::Clear(void)
 {
     Collisions.clear();
+    // bumping the generation empties every slot without touching them
+    ++Generation;
+    if (Generation == 0u)
+    {
+        // wrapped around, stale stamps could alias: reset the table once
+        Generation = 1u;
+        Slots.assign(Slots.size(), Slot());
+    }
 }
 
 void CarlaRecorderCollisions::Add(const CarlaRecorderCollision &Collision)
 {
-    Collisions.insert(std::move(Collision));
+    // grow at ~70% load so probe chains stay short during bursts
+    if ((Collisions.size() + 1u) * 10u > Slots.size() * 7u)
+    {
+        Rehash(std::max<size_t>(64u, Slots.size() * 2u));
+    }
+    const uint64_t Mask = Slots.size() - 1u;
+    uint64_t Probe = HashPair(Collision.DatabaseId1, Collision.DatabaseId2) & Mask;
+    while (Slots[Probe].Generation == Generation)
+    {
+        if (Collisions[Slots[Probe].Index] == Collision)
+        {
+            // this pair was already recorded this frame
+            return;
+        }
+        Probe = (Probe + 1u) & Mask;
+    }
+    Slots[Probe].Generation = Generation;
+    Slots[Probe].Index = static_cast<uint32_t>(Collisions.size());
+    Collisions.push_back(Collision);
 }
 
-void CarlaRecorderCollisions::Write(std::ofstream &OutFile)
+void CarlaRecorderCollisions::Write(std::ostream &OutFile)
 {
     // write the packet id
     WriteValue<char>(OutFile, static_cast<char>(CarlaRecorderPacketId::Collision));
@@ -6,9 +6,9 @@
 
 #pragma once
 
-#include <fstream>
+#include <cstdint>
+#include <sstream>
 #include <vector>
-#include <unordered_set>
 
 #pragma pack(push, 1)
 struct CarlaRecorderCollision
@@ -19,36 +19,45 @@ struct CarlaRecorderCollision
     bool IsActor1Hero;
     bool IsActor2Hero;
 
-    void Read(std::ifstream &InFile);
-    void Write(std::ofstream &OutFile) const;
-    // define operator == needed for the 'unordered_set'
+    void Read(std::istream &InFile);
+    void Write(std::ostream &OutFile) const;
+    // two collisions are the same if they involve the same pair of actors
     bool operator==(const CarlaRecorderCollision &Other) const;
 };
 #pragma pack(pop)
 
-// implement the hash function for the unordered_set of collisions
-namespace std
-{
-    template<>
-    struct hash<CarlaRecorderCollision>
-    {
-        std::size_t operator()(const CarlaRecorderCollision& P) const noexcept
-        {
-            std::size_t hash = P.DatabaseId1;
-            hash <<= 32;
-            hash += P.DatabaseId2;
-            return hash;
-        }
-    };
-}
-
+/// Collisions of the current frame, de-duplicated by actor pair. The pair
+/// set is an open-addressing table whose slots are stamped with a frame
+/// generation, so Clear is O(1) and no storage is released between frames:
+/// the collision bursts of crash scenarios only ever probe warm memory.
 class CarlaRecorderCollisions{
 
     public:
     void Add(const CarlaRecorderCollision &Collision);
     void Clear(void);
-    void Write(std::ofstream &OutFile);
+    void Write(std::ostream &OutFile);
 
     private:
-    std::unordered_set<CarlaRecorderCollision> Collisions;
+    struct Slot
+    {
+        // frame generation the slot was last claimed on, empty otherwise
+        uint32_t Generation = 0u;
+        // index of the claimed entry in the collision list
+        uint32_t Index = 0u;
+    };
+
+    static uint64_t HashPair(uint32_t Id1, uint32_t Id2);
+
+    // rebuild the slot table with the given power-of-two capacity,
+    // reinserting the entries of the current frame
+    void Rehash(size_t NewCapacity);
+
+    // collisions of the current frame, in insertion order
+    std::vector<CarlaRecorderCollision> Collisions;
+
+    // open-addressing slots, linear probing, power-of-two size
+    std::vector<Slot> Slots;
+
+    // generation Clear bumps to empty every slot at once
+    uint32_t Generation = 1u;
 };
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include <fstream>
+#include <sstream>
 #include <vector>
 
 struct CarlaRecorderActorAttribute
@@ -31,8 +31,8 @@ struct CarlaRecorderEventAdd
     FVector Rotation;
     CarlaRecorderActorDescription Description;
 
-    void Read(std::ifstream &InFile);
-    void Write(std::ofstream &OutFile) const;
+    void Read(std::istream &InFile);
+    void Write(std::ostream &OutFile) const;
 };
 
 class CarlaRecorderEventsAdd
@@ -41,8 +41,13 @@ class CarlaRecorderEventsAdd
     public:
     void Add(const CarlaRecorderEventAdd &Event);
     void Clear(void);
-    void Write(std::ofstream &OutFile);
+    void Write(std::ostream &OutFile);
+    // same payload under the keyframe packet id, the replayer only
+    // processes it after jumping over part of the stream
+    void WriteKeyframe(std::ostream &OutFile);
 
     private:
+    void Write(std::ostream &OutFile, char PacketId);
+
     std::vector<CarlaRecorderEventAdd> Events;
 };
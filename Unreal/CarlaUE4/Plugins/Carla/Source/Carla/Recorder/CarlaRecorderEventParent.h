@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include <fstream>
+#include <sstream>
 #include <vector>
 
 struct CarlaRecorderEventParent
@@ -14,8 +14,8 @@ struct CarlaRecorderEventParent
     uint32_t DatabaseId;
     uint32_t DatabaseIdParent;
 
-    void Read(std::ifstream &InFile);
-    void Write(std::ofstream &OutFile) const;
+    void Read(std::istream &InFile);
+    void Write(std::ostream &OutFile) const;
 };
 
 class CarlaRecorderEventsParent
@@ -24,8 +24,13 @@ class CarlaRecorderEventsParent
     public:
     void Add(const CarlaRecorderEventParent &Event);
     void Clear(void);
-    void Write(std::ofstream &OutFile);
+    void Write(std::ostream &OutFile);
+    // same payload under the keyframe parent packet id, the replayer only
+    // processes it after jumping over part of the stream
+    void WriteKeyframe(std::ostream &OutFile);
 
     private:
+    void Write(std::ostream &OutFile, char PacketId);
+
     std::vector<CarlaRecorderEventParent> Events;
 };
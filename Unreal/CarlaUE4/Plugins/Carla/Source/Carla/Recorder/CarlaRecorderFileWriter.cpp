@@ -0,0 +1,230 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "Carla.h"
+#include "CarlaRecorderFileWriter.h"
+#include "CarlaRecorderHelpers.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Compression.h"
+
+#include <cstring>
+
+// compressed blocks are closed once the pending frames reach this size
+static constexpr size_t kRecorderBlockTargetSize = 512u * 1024u;
+
+CarlaRecorderFileWriter::~CarlaRecorderFileWriter()
+{
+  Close();
+}
+
+bool CarlaRecorderFileWriter::Open(
+    const std::string &Filename,
+    const std::string &InfoHeader,
+    boost::optional<carla::streaming::Stream> StreamSink)
+{
+  Close();
+
+  Stream = std::move(StreamSink);
+  if (Stream.has_value())
+  {
+    // every block has to reach the collector, a slow one queues instead of
+    // dropping
+    (*Stream).SetQueuePolicy(carla::streaming::detail::QueuePolicy::block, 0u);
+    auto Message = (*Stream).MakeBuffer();
+    Message.copy_from(InfoHeader);
+    (*Stream).Write(std::move(Message));
+  }
+
+  File.open(Filename, std::ios::binary);
+  if (!File.is_open())
+  {
+    if (!Stream.has_value())
+    {
+      return false;
+    }
+    // diskless hosts record over the stream alone, but then blocks produced
+    // while no collector is subscribed have nowhere to go
+    UE_LOG(LogCarla, Warning,
+        TEXT("Recorder: cannot create fallback file \"%s\", recording to the stream only"),
+        *FString(Filename.c_str()));
+  }
+  else
+  {
+    // the info header stays uncompressed so readers can learn the version
+    // before touching any block
+    File.write(InfoHeader.data(), InfoHeader.size());
+  }
+
+  bLostBlocksWarned = false;
+  bStopRequested = false;
+  FrameAvailable = FPlatformProcess::GetSynchEventFromPool();
+  Thread = FRunnableThread::Create(this, TEXT("CarlaRecorderFileWriter"));
+
+  return true;
+}
+
+void CarlaRecorderFileWriter::EnqueueFrame(std::string &&Frame)
+{
+  if ((Thread == nullptr) || Frame.empty())
+  {
+    return;
+  }
+
+  Frames.Enqueue(std::move(Frame));
+  FrameAvailable->Trigger();
+}
+
+void CarlaRecorderFileWriter::Close()
+{
+  if (Thread == nullptr)
+  {
+    return;
+  }
+
+  // Stop is called from Kill, the thread drains the queue and flushes the
+  // last block before returning
+  Thread->Kill(true);
+  delete Thread;
+  Thread = nullptr;
+
+  FPlatformProcess::ReturnSynchEventToPool(FrameAvailable);
+  FrameAvailable = nullptr;
+
+  if (Stream.has_value())
+  {
+    if ((*Stream).AreClientsListening())
+    {
+      // end-of-stream marker, a block header with both sizes zeroed; the
+      // collector stops appending and unsubscribes when it arrives
+      auto Message = (*Stream).MakeBuffer();
+      Message.reset(2u * sizeof(uint32_t));
+      memset(Message.data(), 0, Message.size());
+      (*Stream).Write(std::move(Message));
+    }
+    // the session keeps draining the queued blocks after the stream is gone
+    Stream = boost::none;
+  }
+
+  File.close();
+}
+
+void CarlaRecorderFileWriter::Stop()
+{
+  bStopRequested = true;
+  FrameAvailable->Trigger();
+}
+
+uint32 CarlaRecorderFileWriter::Run()
+{
+  while (true)
+  {
+    std::string Frame;
+    while (Frames.Dequeue(Frame))
+    {
+      PendingBlock += Frame;
+      if (PendingBlock.size() >= kRecorderBlockTargetSize)
+      {
+        WriteBlock();
+      }
+    }
+
+    if (bStopRequested)
+    {
+      break;
+    }
+
+    FrameAvailable->Wait();
+  }
+
+  // flush whatever is left of the last block
+  WriteBlock();
+  PendingBlock.clear();
+  PendingBlock.shrink_to_fit();
+
+  return 0;
+}
+
+void CarlaRecorderFileWriter::WriteBlock()
+{
+  if (PendingBlock.empty())
+  {
+    return;
+  }
+
+  const int32 UncompressedSize = static_cast<int32>(PendingBlock.size());
+  int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+  constexpr size_t HeaderSize = 2u * sizeof(uint32_t);
+
+  if (Stream.has_value() && (*Stream).AreClientsListening())
+  {
+    // compress straight into a pooled buffer of the stream, the block is
+    // handed over to the streaming threads without another copy
+    auto Message = (*Stream).MakeBuffer();
+    Message.reset(HeaderSize + static_cast<size_t>(CompressedSize));
+    auto *Out = Message.data() + HeaderSize;
+
+    if (!FCompression::CompressMemory(
+        NAME_Zlib,
+        Out,
+        CompressedSize,
+        PendingBlock.data(),
+        UncompressedSize) ||
+        (CompressedSize >= UncompressedSize))
+    {
+      // store incompressible blocks raw, readers detect them by the equal
+      // sizes
+      CompressedSize = UncompressedSize;
+      memcpy(Out, PendingBlock.data(), UncompressedSize);
+    }
+
+    const uint32_t Sizes[2u] = {
+        static_cast<uint32_t>(CompressedSize),
+        static_cast<uint32_t>(UncompressedSize)};
+    memcpy(Message.data(), Sizes, sizeof(Sizes));
+    Message.resize(HeaderSize + static_cast<size_t>(CompressedSize));
+    (*Stream).Write(std::move(Message));
+
+    PendingBlock.clear();
+    return;
+  }
+
+  if (!File.is_open())
+  {
+    if (!bLostBlocksWarned)
+    {
+      UE_LOG(LogCarla, Warning,
+          TEXT("Recorder: no collector subscribed and no fallback file, blocks are lost"));
+      bLostBlocksWarned = true;
+    }
+    PendingBlock.clear();
+    return;
+  }
+
+  CompressedBuffer.resize(CompressedSize);
+
+  if (!FCompression::CompressMemory(
+      NAME_Zlib,
+      CompressedBuffer.data(),
+      CompressedSize,
+      PendingBlock.data(),
+      UncompressedSize) ||
+      (CompressedSize >= UncompressedSize))
+  {
+    // store incompressible blocks raw, readers detect them by the equal
+    // sizes
+    CompressedSize = UncompressedSize;
+    memcpy(CompressedBuffer.data(), PendingBlock.data(), UncompressedSize);
+  }
+
+  WriteValue<uint32_t>(File, static_cast<uint32_t>(CompressedSize));
+  WriteValue<uint32_t>(File, static_cast<uint32_t>(UncompressedSize));
+  File.write(CompressedBuffer.data(), CompressedSize);
+
+  PendingBlock.clear();
+}
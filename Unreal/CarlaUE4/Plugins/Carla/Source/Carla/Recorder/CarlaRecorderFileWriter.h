@@ -0,0 +1,91 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "Templates/Atomic.h"
+
+#include <compiler/disable-ue4-macros.h>
+#include <carla/streaming/Stream.h>
+#include <boost/optional.hpp>
+#include <compiler/enable-ue4-macros.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+class FRunnableThread;
+class FEvent;
+
+/// Writes the recorder output from its own thread so the game thread only
+/// pays for serializing the packets to memory. Frames are handed over
+/// through a lock-free queue, grouped into blocks and compressed before
+/// hitting the sink (see ReadRecorderFile for the block layout).
+///
+/// The sink is the local file, or optionally a streaming stream a collector
+/// client subscribes to: the info header travels as the first message and
+/// every block as one message, so appending the messages to a file in
+/// arrival order reproduces the recorder file byte by byte. Blocks are
+/// compressed straight into pooled stream buffers, recording then costs the
+/// simulation host no storage I/O. The file acts as fallback for blocks
+/// produced while no collector is subscribed.
+class CarlaRecorderFileWriter : public FRunnable
+{
+public:
+
+  ~CarlaRecorderFileWriter();
+
+  /// Create @a Filename, write the raw @a InfoHeader at its start and launch
+  /// the writer thread. When @a StreamSink is given the blocks go to the
+  /// stream instead while a collector is subscribed, and a missing file is
+  /// tolerated. Returns false if no sink can be opened.
+  bool Open(
+      const std::string &Filename,
+      const std::string &InfoHeader,
+      boost::optional<carla::streaming::Stream> StreamSink = boost::none);
+
+  /// Hand the serialized packets of one frame over to the writer thread.
+  void EnqueueFrame(std::string &&Frame);
+
+  /// Flush the pending frames, close the file and join the thread.
+  void Close();
+
+private:
+
+  // FRunnable interface, Run executes in the writer thread.
+  uint32 Run() override;
+  void Stop() override;
+
+  /// Compress the pending block and hand it to the stream sink or write it
+  /// to disk, writer thread only.
+  void WriteBlock();
+
+  /// Frames queued by the game thread, consumed by the writer thread.
+  TQueue<std::string, EQueueMode::Spsc> Frames;
+
+  FRunnableThread *Thread = nullptr;
+
+  /// Signaled whenever a frame is queued or the writer is asked to stop.
+  FEvent *FrameAvailable = nullptr;
+
+  TAtomic<bool> bStopRequested { false };
+
+  std::ofstream File;
+
+  /// Stream carrying the blocks to a collector client, if any.
+  boost::optional<carla::streaming::Stream> Stream;
+
+  /// Whether blocks lost for lack of any usable sink have been reported.
+  bool bLostBlocksWarned = false;
+
+  /// Serialized frames waiting to fill up a block.
+  std::string PendingBlock;
+
+  /// Scratch buffer for the compressed block, reused between blocks.
+  std::vector<char> CompressedBuffer;
+};
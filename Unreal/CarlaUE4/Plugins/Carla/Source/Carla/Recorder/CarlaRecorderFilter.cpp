@@ -0,0 +1,190 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "Carla.h"
+#include "Carla/Actor/ActorRegistry.h"
+#include "Carla/Actor/ActorView.h"
+
+#include "CarlaRecorderFilter.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+void CarlaRecorderFilter::Reset(void)
+{
+  bActive = false;
+  IncludePatterns.Reset();
+  ExcludePatterns.Reset();
+  IncludeIds.clear();
+  ExcludeIds.clear();
+  HeroRadius = 0.0f;
+  PositionRate = 1;
+  StateRate = 1;
+  AnimationRate = 1;
+  HeroLocations.Reset();
+}
+
+void CarlaRecorderFilter::Parse(const std::string &FilterSpec)
+{
+  Reset();
+
+  size_t Pos = 0;
+  while (Pos <= FilterSpec.size())
+  {
+    // take the next semicolon separated token
+    size_t End = FilterSpec.find(';', Pos);
+    if (End == std::string::npos)
+      End = FilterSpec.size();
+    std::string Token = FilterSpec.substr(Pos, End - Pos);
+    Pos = End + 1;
+
+    // trim surrounding spaces
+    const size_t First = Token.find_first_not_of(" \t");
+    if (First == std::string::npos)
+      continue;
+    const size_t Last = Token.find_last_not_of(" \t");
+    Token = Token.substr(First, Last - First + 1);
+
+    const size_t Eq = Token.find('=');
+    if (Eq == std::string::npos)
+    {
+      UE_LOG(LogCarla, Warning, TEXT("Recorder filter: ignoring malformed option '%s'"),
+          UTF8_TO_TCHAR(Token.c_str()));
+      continue;
+    }
+    const std::string Key = Token.substr(0, Eq);
+    const std::string Value = Token.substr(Eq + 1);
+
+    if (Key == "include")
+    {
+      IncludePatterns.Add(UTF8_TO_TCHAR(Value.c_str()));
+    }
+    else if (Key == "exclude")
+    {
+      ExcludePatterns.Add(UTF8_TO_TCHAR(Value.c_str()));
+    }
+    else if (Key == "include_id")
+    {
+      IncludeIds.insert(static_cast<uint32_t>(std::strtoul(Value.c_str(), nullptr, 10)));
+    }
+    else if (Key == "exclude_id")
+    {
+      ExcludeIds.insert(static_cast<uint32_t>(std::strtoul(Value.c_str(), nullptr, 10)));
+    }
+    else if (Key == "radius")
+    {
+      // meters to cm
+      HeroRadius = 100.0f * static_cast<float>(std::atof(Value.c_str()));
+    }
+    else if (Key == "rate.position")
+    {
+      PositionRate = std::max<uint64_t>(1u, std::strtoull(Value.c_str(), nullptr, 10));
+    }
+    else if (Key == "rate.state")
+    {
+      StateRate = std::max<uint64_t>(1u, std::strtoull(Value.c_str(), nullptr, 10));
+    }
+    else if (Key == "rate.animation")
+    {
+      AnimationRate = std::max<uint64_t>(1u, std::strtoull(Value.c_str(), nullptr, 10));
+    }
+    else
+    {
+      UE_LOG(LogCarla, Warning, TEXT("Recorder filter: ignoring unknown option '%s'"),
+          UTF8_TO_TCHAR(Key.c_str()));
+      continue;
+    }
+
+    bActive = true;
+  }
+}
+
+void CarlaRecorderFilter::UpdateHeroLocations(const FActorRegistry &Registry)
+{
+  HeroLocations.Reset();
+
+  // heroes are only needed by the radius option
+  if (HeroRadius <= 0.0f)
+    return;
+
+  for (auto It = Registry.begin(); It != Registry.end(); ++It)
+  {
+    FActorView View = *It;
+    if (!IsHero(View))
+      continue;
+    const AActor *Actor = View.GetActor();
+    if (Actor != nullptr)
+    {
+      HeroLocations.Add(Actor->GetActorLocation());
+    }
+  }
+}
+
+bool CarlaRecorderFilter::ShouldRecordActor(const FActorView &View) const
+{
+  if (!bActive)
+    return true;
+
+  // explicit ids first, they override the patterns and the radius
+  const uint32_t Id = View.GetActorId();
+  if (ExcludeIds.count(Id) > 0)
+    return false;
+  if (IncludeIds.count(Id) > 0)
+    return true;
+
+  const FActorInfo *Info = View.GetActorInfo();
+  if (Info != nullptr)
+  {
+    const FString &TypeId = Info->Description.Id;
+    for (const FString &Pattern : ExcludePatterns)
+    {
+      if (TypeId.MatchesWildcard(Pattern))
+        return false;
+    }
+    if (IncludePatterns.Num() > 0)
+    {
+      bool bMatches = false;
+      for (const FString &Pattern : IncludePatterns)
+      {
+        if (TypeId.MatchesWildcard(Pattern))
+        {
+          bMatches = true;
+          break;
+        }
+      }
+      if (!bMatches)
+        return false;
+    }
+  }
+
+  if (HeroRadius > 0.0f)
+  {
+    // heroes are always recorded
+    if (IsHero(View))
+      return true;
+    const AActor *Actor = View.GetActor();
+    if (Actor == nullptr)
+      return false;
+    const FVector Location = Actor->GetActorLocation();
+    for (const FVector &Hero : HeroLocations)
+    {
+      if (FVector::Distance(Hero, Location) <= HeroRadius)
+        return true;
+    }
+    return false;
+  }
+
+  return true;
+}
+
+bool CarlaRecorderFilter::IsHero(const FActorView &View)
+{
+  const FActorInfo *Info = View.GetActorInfo();
+  if (Info == nullptr)
+    return false;
+  const auto *Role = Info->Description.Variations.Find("role_name");
+  return (Role != nullptr) && (Role->Value == "hero");
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Math/Vector.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
+class FActorRegistry;
+class FActorView;
+
+/// Record-time filter of the recorder, parsed from the filter string handed
+/// to client.start_recorder. An empty string keeps the default behavior of
+/// recording everything every tick.
+///
+/// The filter string is a semicolon separated list of options:
+///
+///   include=<wildcard>    record only actors whose type id matches
+///   exclude=<wildcard>    drop actors whose type id matches
+///   include_id=<id>       record this actor id regardless of the patterns
+///   exclude_id=<id>       drop this actor id regardless of the patterns
+///   radius=<meters>       record only actors near a hero actor
+///   rate.position=<n>     write positions every n ticks
+///   rate.state=<n>        write traffic light states every n ticks
+///   rate.animation=<n>    write animations every n ticks
+///
+/// The filter only gates the per-tick packets (positions, states and
+/// animations), the lifecycle events (add, del, parent) and the collisions
+/// are always recorded so the replayed world stays consistent.
+class CarlaRecorderFilter
+{
+public:
+
+  // parse the filter string, unknown options are reported and ignored
+  void Parse(const std::string &FilterSpec);
+
+  void Reset(void);
+
+  bool IsActive(void) const
+  {
+    return bActive;
+  }
+
+  // gather the hero locations used by the radius option, call once per tick
+  // before testing the actors
+  void UpdateHeroLocations(const FActorRegistry &Registry);
+
+  // check if the per-tick packets of this actor should be recorded
+  bool ShouldRecordActor(const FActorView &View) const;
+
+  // per-category record rates, relative to the tick counter of the recorder
+  bool ShouldRecordPositions(uint64_t Tick) const
+  {
+    return (Tick % PositionRate) == 0;
+  }
+  bool ShouldRecordStates(uint64_t Tick) const
+  {
+    return (Tick % StateRate) == 0;
+  }
+  bool ShouldRecordAnimations(uint64_t Tick) const
+  {
+    return (Tick % AnimationRate) == 0;
+  }
+
+private:
+
+  // check the 'role_name' attribute of the actor
+  static bool IsHero(const FActorView &View);
+
+  bool bActive = false;
+
+  // wildcard patterns matched against the actor type id
+  TArray<FString> IncludePatterns;
+  TArray<FString> ExcludePatterns;
+
+  // explicit actor ids, they take precedence over the patterns
+  std::unordered_set<uint32_t> IncludeIds;
+  std::unordered_set<uint32_t> ExcludeIds;
+
+  // radius around the hero actors (in cm), zero disables the check
+  float HeroRadius = 0.0f;
+
+  uint64_t PositionRate = 1;
+  uint64_t StateRate = 1;
+  uint64_t AnimationRate = 1;
+
+  // hero locations of the current tick
+  TArray<FVector> HeroLocations;
+};
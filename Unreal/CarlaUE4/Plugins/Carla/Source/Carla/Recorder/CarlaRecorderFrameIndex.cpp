@@ -0,0 +1,81 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "CarlaRecorder.h"
+#include "CarlaRecorderFrameIndex.h"
+#include "CarlaRecorderHelpers.h"
+
+#include <algorithm>
+
+void CarlaRecorderFrameIndex::Add(double Elapsed, uint64_t Offset)
+{
+  Entries.push_back(CarlaRecorderFrameIndexEntry{Elapsed, Offset});
+}
+
+void CarlaRecorderFrameIndex::Clear(void)
+{
+  Entries.clear();
+}
+
+bool CarlaRecorderFrameIndex::IsEmpty(void) const
+{
+  return Entries.empty();
+}
+
+const CarlaRecorderFrameIndexEntry *CarlaRecorderFrameIndex::Lookup(double Time) const
+{
+  // first entry after Time
+  auto It = std::upper_bound(
+      Entries.begin(),
+      Entries.end(),
+      Time,
+      [](double Value, const CarlaRecorderFrameIndexEntry &Entry)
+      {
+        return Value < Entry.Elapsed;
+      });
+
+  if (It == Entries.begin())
+  {
+    return nullptr;
+  }
+
+  return &(*std::prev(It));
+}
+
+void CarlaRecorderFrameIndex::Write(std::ostream &OutFile)
+{
+  // write the packet id
+  WriteValue<char>(OutFile, static_cast<char>(CarlaRecorderPacketId::FrameIndex));
+
+  // write the packet size
+  uint16_t Total = Entries.size();
+  uint32_t Size = sizeof(uint16_t) + (Total * sizeof(CarlaRecorderFrameIndexEntry));
+  WriteValue<uint32_t>(OutFile, Size);
+
+  // write total records
+  WriteValue<uint16_t>(OutFile, Total);
+
+  for (uint16_t i = 0; i < Total; ++i)
+  {
+    WriteValue<CarlaRecorderFrameIndexEntry>(OutFile, Entries[i]);
+  }
+}
+
+void CarlaRecorderFrameIndex::Read(std::istream &InFile)
+{
+  uint16_t i, Total;
+
+  Entries.clear();
+
+  // read total records
+  ReadValue<uint16_t>(InFile, Total);
+  Entries.resize(Total);
+
+  for (i = 0; i < Total; ++i)
+  {
+    ReadValue<CarlaRecorderFrameIndexEntry>(InFile, Entries[i]);
+  }
+}
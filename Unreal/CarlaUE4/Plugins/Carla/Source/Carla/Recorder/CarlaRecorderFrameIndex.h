@@ -0,0 +1,45 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <sstream>
+#include <vector>
+
+#pragma pack(push, 1)
+struct CarlaRecorderFrameIndexEntry
+{
+  // simulation time of a frame holding a keyframe snapshot
+  double Elapsed;
+  // offset of its frame start packet in the packet stream
+  uint64_t Offset;
+};
+#pragma pack(pop)
+
+// index of the keyframe snapshots of a recording, written as the last
+// packet so the replayer can seek with a binary search instead of scanning
+// the whole file
+class CarlaRecorderFrameIndex
+{
+
+public:
+
+  void Add(double Elapsed, uint64_t Offset);
+  void Clear(void);
+
+  bool IsEmpty(void) const;
+
+  // last keyframe at or before Time, null if there is none
+  const CarlaRecorderFrameIndexEntry *Lookup(double Time) const;
+
+  void Write(std::ostream &OutFile);
+  // read the packet body, the header is expected to be consumed already
+  void Read(std::istream &InFile);
+
+private:
+
+  std::vector<CarlaRecorderFrameIndexEntry> Entries;
+};
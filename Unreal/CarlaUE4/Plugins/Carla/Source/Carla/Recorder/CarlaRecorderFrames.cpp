@@ -8,12 +8,14 @@
 #include "CarlaRecorderFrames.h"
 #include "CarlaRecorderHelpers.h"
 
-void CarlaRecorderFrame::Read(std::ifstream &InFile)
+#include <cstring>
+
+void CarlaRecorderFrame::Read(std::istream &InFile)
 {
   ReadValue<CarlaRecorderFrame>(InFile, *this);
 }
 
-void CarlaRecorderFrame::Write(std::ofstream &OutFile)
+void CarlaRecorderFrame::Write(std::ostream &OutFile)
 {
   WriteValue<CarlaRecorderFrame>(OutFile, *this);
 }
@@ -49,9 +51,8 @@ void CarlaRecorderFrames::SetFrame(double DeltaSeconds)
   ++Frame.Id;
 }
 
-void CarlaRecorderFrames::WriteStart(std::ofstream &OutFile)
+void CarlaRecorderFrames::WriteStart(std::ostream &OutFile)
 {
-  std::streampos Pos, Offset;
   double Dummy = -1.0f;
 
   // write the packet id
@@ -61,26 +62,31 @@ void CarlaRecorderFrames::WriteStart(std::ofstream &OutFile)
   uint32_t Total = sizeof(CarlaRecorderFrame);
   WriteValue<uint32_t>(OutFile, Total);
 
-  // write frame record
+  // write frame record, the duration is only known when the next frame
+  // arrives and is patched in through BackPatchDuration
   WriteValue<uint64_t>(OutFile, Frame.Id);
-  Offset = OutFile.tellp();
+
+  // save position for next actualization
+  OffsetPreviousFrame = OutFile.tellp();
+
   WriteValue<double>(OutFile, Dummy);
   WriteValue<double>(OutFile, Frame.Elapsed);
+}
+
+void CarlaRecorderFrames::BackPatchDuration(std::string &PreviousFrame) const
+{
+  auto Offset = static_cast<size_t>(OffsetPreviousFrame);
 
-  // we need to write this duration to previous frame
-  if (OffsetPreviousFrame > 0)
+  // nothing to patch on the very first frame
+  if (PreviousFrame.size() < (Offset + sizeof(double)))
   {
-    Pos = OutFile.tellp();
-    OutFile.seekp(OffsetPreviousFrame, std::ios::beg);
-    WriteValue<double>(OutFile, Frame.DurationThis);
-    OutFile.seekp(Pos, std::ios::beg);
+    return;
   }
 
-  // save position for next actualization
-  OffsetPreviousFrame = Offset;
+  memcpy(&PreviousFrame[Offset], &Frame.DurationThis, sizeof(double));
 }
 
-void CarlaRecorderFrames::WriteEnd(std::ofstream &OutFile)
+void CarlaRecorderFrames::WriteEnd(std::ostream &OutFile)
 {
   // write the packet id
   WriteValue<char>(OutFile, static_cast<char>(CarlaRecorderPacketId::FrameEnd));
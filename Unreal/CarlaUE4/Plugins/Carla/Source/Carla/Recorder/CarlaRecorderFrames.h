@@ -6,7 +6,8 @@
 
 #pragma once
 
-#include <fstream>
+#include <sstream>
+#include <string>
 
 #pragma pack(push, 1)
 struct CarlaRecorderFrame
@@ -15,9 +16,9 @@ struct CarlaRecorderFrame
   double DurationThis;
   double Elapsed;
 
-  void Read(std::ifstream &InFile);
+  void Read(std::istream &InFile);
 
-  void Write(std::ofstream &OutFile);
+  void Write(std::ostream &OutFile);
 
 };
 #pragma pack(pop)
@@ -32,11 +33,22 @@ public:
 
   void SetFrame(double DeltaSeconds);
 
-  void WriteStart(std::ofstream &OutFile);
-  void WriteEnd(std::ofstream &OutFile);
+  double GetElapsed(void) const
+  {
+    return Frame.Elapsed;
+  }
+
+  void WriteStart(std::ostream &OutFile);
+  void WriteEnd(std::ostream &OutFile);
+
+  // the duration of a frame is only known when the next one arrives, patch
+  // it into the already serialized record of the previous frame
+  void BackPatchDuration(std::string &PreviousFrame) const;
 
 private:
 
   CarlaRecorderFrame Frame;
+  // offset of the duration field inside the frame buffer of the last
+  // WriteStart call
   std::streampos OffsetPreviousFrame;
 };
@@ -4,10 +4,16 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <cstring>
+#include <fstream>
+#include <sstream>
 #include <vector>
 
 #include "UnrealString.h"
+#include "Misc/Compression.h"
+
 #include "CarlaRecorderHelpers.h"
+#include "CarlaRecorderInfo.h"
 
 // create a temporal buffer to convert from and to FString and bytes
 static std::vector<uint8_t> CarlaRecorderHelperBuffer;
@@ -29,12 +35,166 @@ std::string GetRecorderFilename(std::string Filename)
   return Filename2;
 }
 
+// load a recording to memory, expanding the compressed blocks of version 2
+// files
+bool ReadRecorderFile(const std::string &Filename, std::istringstream &Stream)
+{
+  std::ifstream File(Filename, std::ios::binary);
+  if (!File.is_open())
+  {
+    return false;
+  }
+
+  // the info header is always stored uncompressed, parse it to know the
+  // version and keep its bytes verbatim at the start of the stream
+  CarlaRecorderInfo Info;
+  Info.Read(File);
+  if (!File)
+  {
+    return false;
+  }
+  auto InfoSize = static_cast<size_t>(File.tellg());
+
+  File.seekg(0, std::ios::end);
+  auto FileSize = static_cast<size_t>(File.tellg());
+  File.seekg(0, std::ios::beg);
+
+  std::string Data;
+  Data.resize(InfoSize);
+  File.read(&Data[0], InfoSize);
+
+  if (Info.Version < 2)
+  {
+    // version 1 files store the packets as a plain stream after the info
+    Data.resize(FileSize);
+    File.read(&Data[InfoSize], FileSize - InfoSize);
+  }
+  else
+  {
+    // version 2 files store the packets as independent compressed blocks,
+    // each one preceded by its compressed and uncompressed sizes
+    std::vector<char> Compressed;
+    while (static_cast<size_t>(File.tellg()) < FileSize)
+    {
+      uint32_t CompressedSize;
+      uint32_t UncompressedSize;
+      ReadValue<uint32_t>(File, CompressedSize);
+      ReadValue<uint32_t>(File, UncompressedSize);
+      if (!File)
+      {
+        return false;
+      }
+      Compressed.resize(CompressedSize);
+      File.read(Compressed.data(), CompressedSize);
+      if (!File)
+      {
+        return false;
+      }
+      auto Offset = Data.size();
+      Data.resize(Offset + UncompressedSize);
+      if (CompressedSize == UncompressedSize)
+      {
+        // blocks the compressor could not shrink are stored raw
+        memcpy(&Data[Offset], Compressed.data(), UncompressedSize);
+      }
+      else if (!FCompression::UncompressMemory(
+          NAME_Zlib,
+          &Data[Offset],
+          static_cast<int32>(UncompressedSize),
+          Compressed.data(),
+          static_cast<int32>(CompressedSize)))
+      {
+        return false;
+      }
+    }
+  }
+
+  Stream.clear();
+  Stream.str(std::move(Data));
+  return true;
+}
+
+// --------
+// buffers
+// --------
+
+void CarlaRecorderBuffer::Reset()
+{
+  Pos = 0;
+  Size = 0;
+  clear();
+}
+
+std::streamsize CarlaRecorderBuffer::xsputn(const char *InData, std::streamsize Count)
+{
+  const size_t End = Pos + static_cast<size_t>(Count);
+  if (End > Data.size())
+  {
+    Data.resize(End);
+  }
+  memcpy(Data.data() + Pos, InData, static_cast<size_t>(Count));
+  Pos = End;
+  if (Pos > Size)
+  {
+    Size = Pos;
+  }
+  return Count;
+}
+
+CarlaRecorderBuffer::int_type CarlaRecorderBuffer::overflow(int_type Character)
+{
+  if (!traits_type::eq_int_type(Character, traits_type::eof()))
+  {
+    const char Byte = traits_type::to_char_type(Character);
+    xsputn(&Byte, 1);
+  }
+  return traits_type::not_eof(Character);
+}
+
+CarlaRecorderBuffer::pos_type CarlaRecorderBuffer::seekoff(
+    off_type Offset,
+    std::ios_base::seekdir Way,
+    std::ios_base::openmode Which)
+{
+  if (!(Which & std::ios_base::out))
+  {
+    return pos_type(off_type(-1));
+  }
+  off_type Base;
+  switch (Way)
+  {
+    case std::ios_base::beg:
+      Base = 0;
+      break;
+    case std::ios_base::cur:
+      Base = static_cast<off_type>(Pos);
+      break;
+    default:
+      Base = static_cast<off_type>(Size);
+      break;
+  }
+  const off_type Target = Base + Offset;
+  if (Target < 0 || static_cast<size_t>(Target) > Size)
+  {
+    return pos_type(off_type(-1));
+  }
+  Pos = static_cast<size_t>(Target);
+  return pos_type(Target);
+}
+
+CarlaRecorderBuffer::pos_type CarlaRecorderBuffer::seekpos(
+    pos_type Position,
+    std::ios_base::openmode Which)
+{
+  return seekoff(off_type(Position), std::ios_base::beg, Which);
+}
+
 // ------
 // write
 // ------
 
 // write binary data from FVector
-void WriteFVector(std::ofstream &OutFile, const FVector &InObj)
+void WriteFVector(std::ostream &OutFile, const FVector &InObj)
 {
   WriteValue<float>(OutFile, InObj.X);
   WriteValue<float>(OutFile, InObj.Y);
@@ -42,20 +202,20 @@ void WriteFVector(std::ofstream &OutFile, const FVector &InObj)
 }
 
 // write binary data from FTransform
-// void WriteFTransform(std::ofstream &OutFile, const FTransform &InObj){
+// void WriteFTransform(std::ostream &OutFile, const FTransform &InObj){
 // WriteFVector(OutFile, InObj.GetTranslation());
 // WriteFVector(OutFile, InObj.GetRotation().Euler());
 // }
 
 // write binary data from FString (length + text)
-void WriteFString(std::ofstream &OutFile, const FString &InObj)
+void WriteFString(std::ostream &OutFile, const FString &InObj)
 {
   // encode the string to UTF8 to know the final length
   FTCHARToUTF8 EncodedString(*InObj);
   int16_t Length = EncodedString.Length();
-  // write
+  // write, reusing the encoding above instead of converting a second time
   WriteValue<uint16_t>(OutFile, Length);
-  OutFile.write(reinterpret_cast<char *>(TCHAR_TO_UTF8(*InObj)), Length);
+  OutFile.write(EncodedString.Get(), Length);
 }
 
 // -----
@@ -63,7 +223,7 @@ void WriteFString(std::ofstream &OutFile, const FString &InObj)
 // -----
 
 // read binary data to FVector
-void ReadFVector(std::ifstream &InFile, FVector &OutObj)
+void ReadFVector(std::istream &InFile, FVector &OutObj)
 {
   ReadValue<float>(InFile, OutObj.X);
   ReadValue<float>(InFile, OutObj.Y);
@@ -71,7 +231,7 @@ void ReadFVector(std::ifstream &InFile, FVector &OutObj)
 }
 
 // read binary data to FTransform
-// void ReadFTransform(std::ifstream &InFile, FTransform &OutObj){
+// void ReadFTransform(std::istream &InFile, FTransform &OutObj){
 // FVector Vec;
 // ReadFVector(InFile, Vec);
 // OutObj.SetTranslation(Vec);
@@ -80,7 +240,7 @@ void ReadFVector(std::ifstream &InFile, FVector &OutObj)
 // }
 
 // read binary data to FString (length + text)
-void ReadFString(std::ifstream &InFile, FString &OutObj)
+void ReadFString(std::istream &InFile, FString &OutObj)
 {
   uint16_t Length;
   ReadValue<uint16_t>(InFile, Length);
@@ -6,29 +6,89 @@
 
 #pragma once
 
-#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 // get the final path + filename
 std::string GetRecorderFilename(std::string Filename);
 
+// load a recording to memory, expanding the compressed blocks of version 2
+// files so the resulting stream always has the packet layout of a version 1
+// file; returns false if the file is missing or corrupt
+bool ReadRecorderFile(const std::string &Filename, std::istringstream &Stream);
+
+// ---------
+// buffers
+// ---------
+
+// in-memory std::ostream whose storage survives across uses: Reset rewinds
+// the write position without releasing memory, so serializing a frame every
+// tick reuses the same allocation instead of rebuilding an ostringstream;
+// supports the seekp/tellp the packet writers use to back-patch sizes
+class CarlaRecorderBuffer : private std::streambuf, public std::ostream
+{
+public:
+
+  // both bases define these, pick one side to disambiguate
+  using traits_type = std::streambuf::traits_type;
+  using int_type = std::streambuf::int_type;
+  using pos_type = std::streambuf::pos_type;
+  using off_type = std::streambuf::off_type;
+
+  CarlaRecorderBuffer() : std::ostream(static_cast<std::streambuf *>(this)) {}
+
+  // rewind to an empty buffer, keeping the storage
+  void Reset();
+
+  const char *GetData() const
+  {
+    return Data.data();
+  }
+
+  size_t GetSize() const
+  {
+    return Size;
+  }
+
+private:
+
+  std::streamsize xsputn(const char *InData, std::streamsize Count) override;
+
+  int_type overflow(int_type Character) override;
+
+  pos_type seekoff(off_type Offset, std::ios_base::seekdir Way, std::ios_base::openmode Which) override;
+
+  pos_type seekpos(pos_type Position, std::ios_base::openmode Which) override;
+
+  // retained storage, only ever grows
+  std::vector<char> Data;
+
+  // current write position
+  size_t Pos = 0;
+
+  // bytes written so far (high-water mark of the write position)
+  size_t Size = 0;
+};
+
 // ---------
 // recorder
 // ---------
 
 // write binary data (using sizeof())
 template <typename T>
-void WriteValue(std::ofstream &OutFile, const T &InObj)
+void WriteValue(std::ostream &OutFile, const T &InObj)
 {
   OutFile.write(reinterpret_cast<const char *>(&InObj), sizeof(T));
 }
 
 // write binary data from FVector
-void WriteFVector(std::ofstream &OutFile, const FVector &InObj);
+void WriteFVector(std::ostream &OutFile, const FVector &InObj);
 
 // write binary data from FTransform
-// void WriteFTransform(std::ofstream &OutFile, const FTransform &InObj);
+// void WriteFTransform(std::ostream &OutFile, const FTransform &InObj);
 // write binary data from FString (length + text)
-void WriteFString(std::ofstream &OutFile, const FString &InObj);
+void WriteFString(std::ostream &OutFile, const FString &InObj);
 
 // ---------
 // replayer
@@ -36,15 +96,15 @@ void WriteFString(std::ofstream &OutFile, const FString &InObj);
 
 // read binary data (using sizeof())
 template <typename T>
-void ReadValue(std::ifstream &InFile, T &OutObj)
+void ReadValue(std::istream &InFile, T &OutObj)
 {
   InFile.read(reinterpret_cast<char *>(&OutObj), sizeof(T));
 }
 
 // read binary data from FVector
-void ReadFVector(std::ifstream &InFile, FVector &OutObj);
+void ReadFVector(std::istream &InFile, FVector &OutObj);
 
 // read binary data from FTransform
-// void ReadTransform(std::ifstream &InFile, FTransform &OutObj);
+// void ReadTransform(std::istream &InFile, FTransform &OutObj);
 // read binary data from FString (length + text)
-void ReadFString(std::ifstream &InFile, FString &OutObj);
+void ReadFString(std::istream &InFile, FString &OutObj);
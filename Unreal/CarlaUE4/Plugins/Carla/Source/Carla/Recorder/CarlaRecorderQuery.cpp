@@ -9,6 +9,92 @@
 #include <ctime>
 #include <sstream>
 
+bool CarlaRecorderQuery::LoadFile(const std::string &Filename)
+{
+  // reuse the expanded recording and its offset tables when the same file
+  // is queried repeatedly, batch analysis runs several queries per file
+  if ((Filename == LoadedFilename) && !File.str().empty())
+  {
+    File.clear();
+    File.seekg(0, std::ios::beg);
+    return true;
+  }
+
+  LoadedFilename.clear();
+  PacketOffsets.clear();
+
+  if (!ReadRecorderFile(Filename, File))
+  {
+    return false;
+  }
+
+  // build the per-packet-type offset tables with a single pass over the
+  // headers
+  RecInfo.Read(File);
+  while (File)
+  {
+    auto Offset = static_cast<uint64_t>(File.tellg());
+    if (!ReadHeader() || !File)
+    {
+      break;
+    }
+    PacketOffsets[Header.Id].push_back(Offset);
+    SkipPacket();
+  }
+
+  File.clear();
+  File.seekg(0, std::ios::beg);
+  LoadedFilename = Filename;
+  return true;
+}
+
+void CarlaRecorderQuery::ForEachPacketOfType(
+    const std::vector<char> &Types,
+    std::function<void(void)> Visitor)
+{
+  // gather the offset tables of the requested packet types
+  std::vector<const std::vector<uint64_t> *> Tables;
+  std::vector<size_t> Cursors;
+  for (auto Type : Types)
+  {
+    auto It = PacketOffsets.find(Type);
+    if (It != PacketOffsets.end())
+    {
+      Tables.push_back(&It->second);
+      Cursors.push_back(0);
+    }
+  }
+
+  // merge the tables in stream order so the visitor sees the packets
+  // exactly as a sequential read would
+  while (true)
+  {
+    size_t Best = Tables.size();
+    uint64_t BestOffset = 0;
+    for (size_t i = 0; i < Tables.size(); ++i)
+    {
+      if (Cursors[i] < Tables[i]->size())
+      {
+        uint64_t Offset = (*Tables[i])[Cursors[i]];
+        if ((Best == Tables.size()) || (Offset < BestOffset))
+        {
+          Best = i;
+          BestOffset = Offset;
+        }
+      }
+    }
+    if (Best == Tables.size())
+    {
+      break;
+    }
+    ++Cursors[Best];
+
+    File.clear();
+    File.seekg(static_cast<std::streampos>(BestOffset), std::ios::beg);
+    Visitor();
+  }
+}
+
 inline bool CarlaRecorderQuery::ReadHeader(void)
 {
   if (File.eof())
@@ -57,9 +143,8 @@ std::string CarlaRecorderQuery::QueryInfo(std::string Filename, bool bShowAll)
   // get the final path + filename
   std::string Filename2 = GetRecorderFilename(Filename);
 
-  // try to open
-  File.open(Filename2, std::ios::binary);
-  if (!File.is_open())
+  // try to load to memory
+  if (!LoadFile(Filename2))
   {
     Info << "File " << Filename2 << " not found on server\n";
     return Info.str();
@@ -77,17 +162,26 @@ std::string CarlaRecorderQuery::QueryInfo(std::string Filename, bool bShowAll)
   if (!CheckFileInfo(Info))
     return Info.str();
 
-  // parse only frames
-  while (File)
+  // visit only the packet types this query prints
+  std::vector<char> Types = {
+      static_cast<char>(CarlaRecorderPacketId::FrameStart),
+      static_cast<char>(CarlaRecorderPacketId::EventAdd),
+      static_cast<char>(CarlaRecorderPacketId::EventDel),
+      static_cast<char>(CarlaRecorderPacketId::EventParent),
+      static_cast<char>(CarlaRecorderPacketId::Collision)};
+  if (bShowAll)
+  {
+    Types.push_back(static_cast<char>(CarlaRecorderPacketId::Position));
+    Types.push_back(static_cast<char>(CarlaRecorderPacketId::State));
+    Types.push_back(static_cast<char>(CarlaRecorderPacketId::AnimVehicle));
+    Types.push_back(static_cast<char>(CarlaRecorderPacketId::AnimWalker));
+  }
+  ForEachPacketOfType(Types, [&](void)
   {
-
     // get header
-    if (!ReadHeader())
-    {
-      break;
-    }
+    ReadHeader();
 
-    // check for a frame packet
+    // check for the packet type
     switch (Header.Id)
     {
       // frame
@@ -262,22 +356,12 @@ std::string CarlaRecorderQuery::QueryInfo(std::string Filename, bool bShowAll)
           SkipPacket();
         break;
 
-      // frame end
-      case static_cast<char>(CarlaRecorderPacketId::FrameEnd):
-        // do nothing, it is empty
-        break;
-
-      default:
-        SkipPacket();
-        break;
     }
-  }
+  });
 
   Info << "\nFrames: " << Frame.Id << "\n";
   Info << "Duration: " << Frame.Elapsed << " seconds\n";
 
-  File.close();
-
   return Info.str();
 }
 
@@ -288,9 +372,8 @@ std::string CarlaRecorderQuery::QueryCollisions(std::string Filename, char Categ
   // get the final path + filename
   std::string Filename2 = GetRecorderFilename(Filename);
 
-  // try to open
-  File.open(Filename2, std::ios::binary);
-  if (!File.is_open())
+  // try to load to memory
+  if (!LoadFile(Filename2))
   {
     Info << "File " << Filename2 << " not found on server\n";
     return Info.str();
@@ -329,17 +412,18 @@ std::string CarlaRecorderQuery::QueryCollisions(std::string Filename, char Categ
   Info << " " << std::setw(35) << std::left << "Actor 2";
   Info << std::endl;
 
-  // parse only frames
-  while (File)
+  // visit only the packet types this query needs
+  ForEachPacketOfType(
+      {static_cast<char>(CarlaRecorderPacketId::FrameStart),
+       static_cast<char>(CarlaRecorderPacketId::EventAdd),
+       static_cast<char>(CarlaRecorderPacketId::EventDel),
+       static_cast<char>(CarlaRecorderPacketId::Collision)},
+      [&](void)
   {
-
     // get header
-    if (!ReadHeader())
-    {
-      break;
-    }
+    ReadHeader();
 
-    // check for a frame packet
+    // check for the packet type
     switch (Header.Id)
     {
       // frame
@@ -371,11 +455,6 @@ std::string CarlaRecorderQuery::QueryCollisions(std::string Filename, char Categ
         }
         break;
 
-      // events parenting
-      case static_cast<char>(CarlaRecorderPacketId::EventParent):
-        SkipPacket();
-        break;
-
       // collisions
       case static_cast<char>(CarlaRecorderPacketId::Collision):
         ReadValue<uint16_t>(File, Total);
@@ -425,30 +504,12 @@ std::string CarlaRecorderQuery::QueryCollisions(std::string Filename, char Categ
         }
         break;
 
-      case static_cast<char>(CarlaRecorderPacketId::Position):
-        SkipPacket();
-        break;
-
-      case static_cast<char>(CarlaRecorderPacketId::State):
-        SkipPacket();
-        break;
-
-      // frame end
-      case static_cast<char>(CarlaRecorderPacketId::FrameEnd):
-        // do nothing, it is empty
-        break;
-
-      default:
-        SkipPacket();
-        break;
     }
-  }
+  });
 
   Info << "\nFrames: " << Frame.Id << "\n";
   Info << "Duration: " << Frame.Elapsed << " seconds\n";
 
-  File.close();
-
   return Info.str();
 }
 
@@ -459,9 +520,8 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
   // get the final path + filename
   std::string Filename2 = GetRecorderFilename(Filename);
 
-  // try to open
-  File.open(Filename2, std::ios::binary);
-  if (!File.is_open())
+  // try to load to memory
+  if (!LoadFile(Filename2))
   {
     Info << "File " << Filename2 << " not found on server\n";
     return Info.str();
@@ -491,17 +551,18 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
   Info << " " << std::setw(10) << std::right << "Duration";
   Info << std::endl;
 
-  // parse only frames
-  while (File)
+  // visit only the packet types this query needs
+  ForEachPacketOfType(
+      {static_cast<char>(CarlaRecorderPacketId::FrameStart),
+       static_cast<char>(CarlaRecorderPacketId::EventAdd),
+       static_cast<char>(CarlaRecorderPacketId::EventDel),
+       static_cast<char>(CarlaRecorderPacketId::Position)},
+      [&](void)
   {
-
     // get header
-    if (!ReadHeader())
-    {
-      break;
-    }
+    ReadHeader();
 
-    // check for a frame packet
+    // check for the packet type
     switch (Header.Id)
     {
       // frame
@@ -530,16 +591,6 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
         }
         break;
 
-      // events parenting
-      case static_cast<char>(CarlaRecorderPacketId::EventParent):
-        SkipPacket();
-        break;
-
-      // collisions
-      case static_cast<char>(CarlaRecorderPacketId::Collision):
-        SkipPacket();
-        break;
-
       // positions
       case static_cast<char>(CarlaRecorderPacketId::Position):
         // read all positions
@@ -576,20 +627,8 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
         break;
 
       // traffic light
-      case static_cast<char>(CarlaRecorderPacketId::State):
-        SkipPacket();
-        break;
-
-      // frame end
-      case static_cast<char>(CarlaRecorderPacketId::FrameEnd):
-        // do nothing, it is empty
-        break;
-
-      default:
-        SkipPacket();
-        break;
     }
-  }
+  });
 
   // show actors stopped that were not moving again
   for (auto &Actor : Actors)
@@ -616,7 +655,5 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
   Info << "\nFrames: " << Frame.Id << "\n";
   Info << "Duration: " << Frame.Elapsed << " seconds\n";
 
-  File.close();
-
   return Info.str();
 }
@@ -6,7 +6,11 @@
 
 #pragma once
 
-#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "CarlaRecorderAnimWalker.h"
 #include "CarlaRecorderCollision.h"
@@ -40,7 +44,13 @@ public:
 
 private:
 
-  std::ifstream File;
+  // binary reader over the recording loaded to memory, see ReadRecorderFile
+  std::istringstream File;
+  // file the current load and offset tables belong to
+  std::string LoadedFilename;
+  // header offsets of every packet, one table per packet id, so queries
+  // only touch the packet types they care about
+  std::unordered_map<char, std::vector<uint64_t>> PacketOffsets;
   Header Header;
   CarlaRecorderInfo RecInfo;
   CarlaRecorderFrame Frame;
@@ -53,6 +63,16 @@ private:
   CarlaRecorderAnimVehicle Vehicle;
   CarlaRecorderAnimWalker Walker;
 
+  // load the recording to memory and build the offset tables, reusing the
+  // previous load when the same file is queried again
+  bool LoadFile(const std::string &Filename);
+
+  // visit the packets of the given ids in stream order, File is positioned
+  // at each packet header before calling the visitor
+  void ForEachPacketOfType(
+      const std::vector<char> &Types,
+      std::function<void(void)> Visitor);
+
   // read next header packet
   bool ReadHeader(void);
 
@@ -29,7 +29,8 @@ void CarlaReplayer::Stop(bool bKeepActors)
     Helper.ProcessReplayerFinish(bKeepActors, IgnoreHero, IsHeroMap);
   }
 
-  File.close();
+  // release the in-memory recording
+  File.str(std::string());
 }
 
 bool CarlaReplayer::ReadHeader()
@@ -63,6 +64,8 @@ void CarlaReplayer::Rewind(void)
   Frame.Elapsed = -1.0f;
   Frame.DurationThis = 0.0f;
 
+  bProcessNextKeyframe = false;
+
   MappedId.clear();
   IsHeroMap.clear();
 
@@ -70,14 +73,20 @@ void CarlaReplayer::Rewind(void)
   RecInfo.Read(File);
 }
 
-// read last frame in File and return the Total time recorded
+// read last frame in File and return the Total time recorded, collecting
+// the keyframe index on the way
 double CarlaReplayer::GetTotalTime(void)
 {
   std::streampos Current = File.tellg();
+  std::streampos LastFrameStart = Current;
+
+  KeyframeIndex.Clear();
 
   // parse only frames
   while (File)
   {
+    std::streampos PacketStart = File.tellg();
+
     // get header
     if (!ReadHeader())
     {
@@ -88,8 +97,21 @@ double CarlaReplayer::GetTotalTime(void)
     switch (Header.Id)
     {
       case static_cast<char>(CarlaRecorderPacketId::FrameStart):
+        LastFrameStart = PacketStart;
         Frame.Read(File);
         break;
+      // keyframe, index the frame holding it so seeks can land here even
+      // on recordings that were cut before writing their index
+      case static_cast<char>(CarlaRecorderPacketId::Keyframe):
+        KeyframeIndex.Add(Frame.Elapsed, static_cast<uint64_t>(LastFrameStart));
+        SkipPacket();
+        break;
+      // index written at the end of the recording, it supersedes the
+      // entries collected during this scan
+      case static_cast<char>(CarlaRecorderPacketId::FrameIndex):
+        KeyframeIndex.Clear();
+        KeyframeIndex.Read(File);
+        break;
       default:
         SkipPacket();
         break;
@@ -101,6 +123,23 @@ double CarlaReplayer::GetTotalTime(void)
   return Frame.Elapsed;
 }
 
+void CarlaReplayer::JumpToKeyframe(double Time)
+{
+  auto Entry = KeyframeIndex.Lookup(Time);
+
+  // keep the sequential behavior when there is no keyframe to gain from
+  if ((Entry == nullptr) || (Entry->Elapsed <= 0.0))
+  {
+    return;
+  }
+
+  // move the reader to the frame holding the keyframe, its snapshot
+  // recreates every actor alive at that point
+  File.clear();
+  File.seekg(static_cast<std::streampos>(Entry->Offset), std::ios::beg);
+  bProcessNextKeyframe = true;
+}
+
 std::string CarlaReplayer::ReplayFile(std::string Filename, double TimeStart, double Duration, uint32_t ThisFollowId)
 {
   std::stringstream Info;
@@ -117,9 +156,8 @@ std::string CarlaReplayer::ReplayFile(std::string Filename, double TimeStart, do
 
   Info << "Replaying File: " << Filename2 << std::endl;
 
-  // try to open
-  File.open(Filename2, std::ios::binary);
-  if (!File.is_open())
+  // try to load to memory
+  if (!ReadRecorderFile(Filename2, File))
   {
     Info << "File " << Filename2 << " not found on server\n";
     Stop();
@@ -178,6 +216,8 @@ std::string CarlaReplayer::ReplayFile(std::string Filename, double TimeStart, do
   // if we don't need to load a new map, then start
   if (!Autoplay.Enabled)
   {
+    // jump close to the target time using the keyframe index
+    JumpToKeyframe(TimeStart);
     // process all events until the time
     ProcessToTime(TimeStart, true);
     // mark as enabled
@@ -203,9 +243,8 @@ void CarlaReplayer::CheckPlayAfterMapLoaded(void)
     Stop();
   }
 
-  // try to open
-  File.open(Autoplay.Filename, std::ios::binary);
-  if (!File.is_open())
+  // try to load to memory
+  if (!ReadRecorderFile(Autoplay.Filename, File))
   {
     return;
   }
@@ -237,6 +276,9 @@ void CarlaReplayer::CheckPlayAfterMapLoaded(void)
   // apply time factor
   TimeFactor = Autoplay.TimeFactor;
 
+  // jump close to the target time using the keyframe index
+  JumpToKeyframe(TimeStart);
+
   // process all events until the time
   ProcessToTime(TimeStart, true);
 
@@ -296,6 +338,31 @@ void CarlaReplayer::ProcessToTime(double Time, bool IsFirstTime)
         ProcessEventsParent();
         break;
 
+      // keyframe snapshot, only needed right after a jump, a sequential
+      // replay already knows every actor in it
+      case static_cast<char>(CarlaRecorderPacketId::Keyframe):
+        if (bProcessNextKeyframe)
+          ProcessEventsAdd();
+        else
+          SkipPacket();
+        break;
+
+      // keyframe attachments, close the snapshot started by the keyframe
+      case static_cast<char>(CarlaRecorderPacketId::KeyframeParent):
+        if (bProcessNextKeyframe)
+        {
+          ProcessEventsParent();
+          bProcessNextKeyframe = false;
+        }
+        else
+          SkipPacket();
+        break;
+
+      // keyframe index, metadata for seeking only
+      case static_cast<char>(CarlaRecorderPacketId::FrameIndex):
+        SkipPacket();
+        break;
+
       // collisions
       case static_cast<char>(CarlaRecorderPacketId::Collision):
         SkipPacket();
@@ -624,3 +691,30 @@ void CarlaReplayer::Tick(float Delta)
     ProcessToTime(Delta * TimeFactor, false);
   }
 }
+
+double CarlaReplayer::FastForwardTo(double Time)
+{
+  if (Enabled)
+  {
+    // clamp to the end of the replay
+    double Target = Time;
+    if (Target > TimeToStop)
+      Target = TimeToStop;
+
+    // apply every packet up to the target in one batch, intermediate
+    // positions are skipped by ProcessToTime and nothing renders or
+    // simulates between the replayed frames because the whole batch runs
+    // within this game thread tick
+    if (Target > CurrentTime)
+    {
+      ProcessToTime(Target - CurrentTime, false);
+    }
+  }
+
+  if (FastForwardCallback)
+  {
+    FastForwardCallback(CurrentTime);
+  }
+
+  return CurrentTime;
+}
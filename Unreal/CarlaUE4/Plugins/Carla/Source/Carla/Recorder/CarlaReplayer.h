@@ -6,7 +6,6 @@
 
 #pragma once
 
-#include <fstream>
 #include <sstream>
 #include <unordered_map>
 
@@ -17,6 +16,7 @@
 #include "CarlaRecorderEventDel.h"
 #include "CarlaRecorderEventParent.h"
 #include "CarlaRecorderCollision.h"
+#include "CarlaRecorderFrameIndex.h"
 #include "CarlaRecorderPosition.h"
 #include "CarlaRecorderState.h"
 #include "CarlaRecorderHelpers.h"
@@ -84,6 +84,18 @@ public:
     IgnoreHero = InIgnoreHero;
   }
 
+  // process the replay up to the given time in one batch, as fast as the
+  // game thread allows and ignoring the time factor, then invoke the
+  // fast-forward callback, returns the replay time reached
+  double FastForwardTo(double Time);
+
+  // callback invoked with the replay time reached after a fast-forward,
+  // e.g. to trigger the sensor capture of the target frame
+  void SetFastForwardCallback(std::function<void(double)> InCallback)
+  {
+    FastForwardCallback = std::move(InCallback);
+  }
+
   // check if after a map is loaded, we need to replay
   void CheckPlayAfterMapLoaded(void);
 
@@ -94,11 +106,15 @@ private:
 
   bool Enabled;
   UCarlaEpisode *Episode = nullptr;
-  // binary file reader
-  std::ifstream File;
+  // binary reader over the recording loaded to memory, see ReadRecorderFile
+  std::istringstream File;
   Header Header;
   CarlaRecorderInfo RecInfo;
   CarlaRecorderFrame Frame;
+  // keyframe index, read from the recording or rebuilt while scanning it
+  CarlaRecorderFrameIndex KeyframeIndex;
+  // process the keyframe packets of the next frame, set after a jump
+  bool bProcessNextKeyframe { false };
   // positions (to be able to interpolate)
   std::vector<CarlaRecorderPosition> CurrPos;
   std::vector<CarlaRecorderPosition> PrevPos;
@@ -116,6 +132,8 @@ private:
   double TimeFactor { 1.0 };
   // ignore hero vehicles
   bool IgnoreHero { false };
+  // see SetFastForwardCallback
+  std::function<void(double)> FastForwardCallback;
   std::unordered_map<uint32_t, bool> IsHeroMap;
 
   // utils
@@ -127,6 +145,10 @@ private:
 
   void Rewind(void);
 
+  // move the reader to the last keyframe at or before Time, if the index
+  // knows one, so ProcessToTime does not need to scan from the start
+  void JumpToKeyframe(double Time);
+
   // processing packets
   void ProcessToTime(double Time, bool IsFirstTime = false);
 
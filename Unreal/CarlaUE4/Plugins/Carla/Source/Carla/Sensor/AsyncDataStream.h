@@ -8,9 +8,11 @@
 
 #include <compiler/disable-ue4-macros.h>
 #include <carla/Buffer.h>
+#include <carla/StopWatch.h>
 #include <carla/sensor/SensorRegistry.h>
 #include <carla/sensor/s11n/SensorHeaderSerializer.h>
 #include <carla/streaming/Stream.h>
+#include <carla/streaming/detail/StreamStats.h>
 #include <compiler/enable-ue4-macros.h>
 
 template <typename T>
@@ -68,9 +70,23 @@ private:
       double Timestamp,
       StreamType InStream);
 
+  /// Annotate @a StopWatch's elapsed time on @a Stage of this stream's entry
+  /// in the stream stats registry.
+  void Annotate(carla::streaming::detail::StreamStage Stage, const carla::StopWatch &StopWatch)
+  {
+    carla::streaming::detail::StreamStatsRegistry::GetInstance().Annotate(
+        Stream.get_stream_id(),
+        Stage,
+        1e-3 * static_cast<double>(StopWatch.GetElapsedTime<std::chrono::microseconds>()));
+  }
+
   StreamType Stream;
 
   carla::Buffer Header;
+
+  /// Started at stream creation on the game thread, its elapsed time at Send
+  /// covers render and pixel copy for camera sensors.
+  carla::StopWatch CaptureStopWatch;
 };
 
 // =============================================================================
@@ -89,9 +105,19 @@ template <typename T>
 template <typename SensorT, typename... ArgsT>
 inline void FAsyncDataStreamTmpl<T>::Send(SensorT &Sensor, ArgsT &&... Args)
 {
-  Stream.Write(
-      std::move(Header),
-      carla::sensor::SensorRegistry::Serialize(Sensor, std::forward<ArgsT>(Args)...));
+  using carla::streaming::detail::StreamStage;
+  CaptureStopWatch.Stop();
+  Annotate(StreamStage::capture, CaptureStopWatch);
+
+  carla::StopWatch SerializeStopWatch;
+  auto Buffer = carla::sensor::SensorRegistry::Serialize(Sensor, std::forward<ArgsT>(Args)...);
+  SerializeStopWatch.Stop();
+  Annotate(StreamStage::serialize, SerializeStopWatch);
+
+  carla::StopWatch EnqueueStopWatch;
+  Stream.Write(std::move(Header), std::move(Buffer));
+  EnqueueStopWatch.Stop();
+  Annotate(StreamStage::enqueue, EnqueueStopWatch);
 }
 
 template <typename T>
@@ -101,12 +127,13 @@ inline FAsyncDataStreamTmpl<T>::FAsyncDataStreamTmpl(
     double Timestamp,
     StreamType InStream)
   : Stream(std::move(InStream)),
-    Header([&Sensor, Timestamp]() {
+    Header([this, &Sensor, Timestamp]() {
       check(IsInGameThread());
       using Serializer = carla::sensor::s11n::SensorHeaderSerializer;
       return Serializer::Serialize(
           carla::sensor::SensorRegistry::template get<SensorT*>::index,
           GFrameCounter,
           Timestamp,
-          Sensor.GetActorTransform());
+          Sensor.GetActorTransform(),
+          Stream.get_sub_stream_id());
     }()) {}
@@ -21,9 +21,38 @@ ACollisionSensor::ACollisionSensor(const FObjectInitializer& ObjectInitializer)
 
 FActorDefinition ACollisionSensor::GetSensorDefinition()
 {
-  return UActorBlueprintFunctionLibrary::MakeGenericSensorDefinition(
+  auto Definition = UActorBlueprintFunctionLibrary::MakeGenericSensorDefinition(
       TEXT("other"),
       TEXT("collision"));
+
+  FActorVariation EventInterval;
+  EventInterval.Id = TEXT("event_interval");
+  EventInterval.Type = EActorAttributeType::Float;
+  EventInterval.RecommendedValues = { TEXT("0.0") };
+  EventInterval.bRestrictToRecommended = false;
+
+  FActorVariation PairDedup;
+  PairDedup.Id = TEXT("pair_dedup_window");
+  PairDedup.Type = EActorAttributeType::Float;
+  PairDedup.RecommendedValues = { TEXT("0.0") };
+  PairDedup.bRestrictToRecommended = false;
+
+  Definition.Variations.Append({ EventInterval, PairDedup });
+
+  return Definition;
+}
+
+void ACollisionSensor::Set(const FActorDescription &Description)
+{
+  Super::Set(Description);
+  MinEventInterval = UActorBlueprintFunctionLibrary::RetrieveActorAttributeToFloat(
+      "event_interval",
+      Description.Variations,
+      MinEventInterval);
+  PairDedupWindow = UActorBlueprintFunctionLibrary::RetrieveActorAttributeToFloat(
+      "pair_dedup_window",
+      Description.Variations,
+      PairDedupWindow);
 }
 
 void ACollisionSensor::SetOwner(AActor *NewOwner)
@@ -44,18 +73,63 @@ void ACollisionSensor::OnCollisionEvent(
     FVector NormalImpulse,
     const FHitResult &Hit)
 {
-  if ((Actor != nullptr) && (OtherActor != nullptr))
+  if ((Actor == nullptr) || (OtherActor == nullptr))
+  {
+    return;
+  }
+
+  const auto &Episode = GetEpisode();
+
+  // The recorder sees every contact, replays are unaffected by the
+  // client-facing filters below.
+  if (Episode.GetRecorder()->IsEnabled())
+    Episode.GetRecorder()->AddCollision(Actor, OtherActor);
+
+  const double Now = Episode.GetElapsedGameTime();
+  if ((MinEventInterval > 0.0f) &&
+      (LastEventTime >= 0.0) &&
+      (Now - LastEventTime < MinEventInterval))
+  {
+    return;
+  }
+  if (PairDedupWindow > 0.0f)
+  {
+    const double *LastPairTime = LastPairEventTime.Find(OtherActor);
+    if ((LastPairTime != nullptr) && (Now - *LastPairTime < PairDedupWindow))
+    {
+      return;
+    }
+    // Keep the map bounded, entries outside the window cannot suppress
+    // anything anymore.
+    if (LastPairEventTime.Num() > 256)
+    {
+      for (auto It = LastPairEventTime.CreateIterator(); It; ++It)
+      {
+        if (Now - It.Value() >= PairDedupWindow)
+        {
+          It.RemoveCurrent();
+        }
+      }
+    }
+    LastPairEventTime.Add(OtherActor, Now);
+  }
+  LastEventTime = Now;
+
+  constexpr float TO_METERS = 1e-2;
+  NormalImpulse *= TO_METERS;
+  const auto SelfView = Episode.FindOrFakeActor(Actor);
+  const auto OtherView = Episode.FindOrFakeActor(OtherActor);
+  // Unregistered level geometry has no id, ship its semantic type so the
+  // client can still tell what was hit.
+  std::string OtherType;
+  if (OtherView.GetActorId() == 0u)
   {
-    const auto &Episode = GetEpisode();
-    constexpr float TO_METERS = 1e-2;
-    NormalImpulse *= TO_METERS;
-    GetDataStream(*this).Send(
-        *this,
-        Episode.SerializeActor(Episode.FindOrFakeActor(Actor)),
-        Episode.SerializeActor(Episode.FindOrFakeActor(OtherActor)),
-        carla::geom::Vector3D{NormalImpulse.X, NormalImpulse.Y, NormalImpulse.Z});
-    // record the collision event
-    if (Episode.GetRecorder()->IsEnabled())
-      Episode.GetRecorder()->AddCollision(Actor, OtherActor);
+    OtherType = Episode.SerializeActor(OtherView).description.id;
   }
+  GetDataStream(*this).Send(
+      *this,
+      SelfView.GetActorId(),
+      OtherView.GetActorId(),
+      std::move(OtherType),
+      carla::geom::Vector3D{NormalImpulse.X, NormalImpulse.Y, NormalImpulse.Z});
 }
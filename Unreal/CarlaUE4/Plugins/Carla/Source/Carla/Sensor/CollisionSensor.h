@@ -26,6 +26,8 @@ public:
 
   ACollisionSensor(const FObjectInitializer& ObjectInitializer);
 
+  void Set(const FActorDescription &Description) override;
+
   void SetOwner(AActor *NewOwner) override;
 
 private:
@@ -36,4 +38,19 @@ private:
       AActor *OtherActor,
       FVector NormalImpulse,
       const FHitResult &Hit);
+
+  /// Minimum simulation time in seconds between two events sent to the
+  /// client, regardless of the actor hit. Zero disables the limit.
+  float MinEventInterval = 0.0f;
+
+  /// Minimum simulation time in seconds between two events against the same
+  /// other actor. Zero disables the deduplication.
+  float PairDedupWindow = 0.0f;
+
+  /// Simulation time of the last event sent to the client.
+  double LastEventTime = -1.0;
+
+  /// Simulation time of the last event sent per other actor. Keyed by
+  /// pointer since unregistered actors all share id zero.
+  TMap<const AActor *, double> LastPairEventTime;
 };
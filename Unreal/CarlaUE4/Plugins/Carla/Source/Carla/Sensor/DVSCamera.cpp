@@ -8,11 +8,18 @@
 #include <random>
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 #include "Carla.h"
 #include "Carla/Util/RandomEngine.h"
 #include "Carla/Sensor/DVSCamera.h"
 
+#include "Async/ParallelFor.h"
+
+/// Number of scanlines processed per block of the parallel event simulation.
+static constexpr uint32 kDVSRowsPerBlock = 16u;
+
 ADVSCamera::ADVSCamera(const FObjectInitializer &ObjectInitializer)
   : Super(ObjectInitializer)
 {
@@ -70,7 +77,13 @@ FActorDefinition ADVSCamera::GetSensorDefinition()
   Log_EPS.RecommendedValues = { TEXT("0.001") };
   Log_EPS.bRestrictToRecommended = false;
 
-  Definition.Variations.Append({ Cp, Cm, Sigma_Cp, Sigma_Cm, Refractory_Period, Use_Log, Log_EPS });
+  FActorVariation SoA;
+  SoA.Id = TEXT("soa_wire_format");
+  SoA.Type = EActorAttributeType::Bool;
+  SoA.RecommendedValues = { TEXT("false") };
+  SoA.bRestrictToRecommended = false;
+
+  Definition.Variations.Append({ Cp, Cm, Sigma_Cp, Sigma_Cm, Refractory_Period, Use_Log, Log_EPS, SoA });
 
   return Definition;
 }
@@ -113,6 +126,11 @@ void ADVSCamera::Set(const FActorDescription &Description)
       "log_eps",
       Description.Variations,
       1e-03);
+
+  this->config.soa_wire_format = UActorBlueprintFunctionLibrary::RetrieveActorAttributeToBool(
+      "soa_wire_format",
+      Description.Variations,
+      false);
 }
 
 void ADVSCamera::Tick(float DeltaTime)
@@ -155,11 +173,15 @@ void ADVSCamera::imageToGray(const TArray<FColor> &image, TArray<float> &gray)
   /** Reserve HxW elements **/
   gray.SetNumUninitialized(image.Num());
 
-  /** Convert image to gray raw image values **/
-  for (size_t i = 0; i<image.Num(); ++i)
+  /** Convert image to gray raw image values, one scanline per task **/
+  const int32 width = this->GetImageWidth();
+  ParallelFor(this->GetImageHeight(), [&](int32 y)
   {
-    gray[i] = 0.2989*image[i].R +  0.5870*image[i].G + 0.1140*image[i].B;
-  }
+    for (int32 i = y * width; i < (y + 1) * width; ++i)
+    {
+      gray[i] = 0.2989*image[i].R +  0.5870*image[i].G + 0.1140*image[i].B;
+    }
+  });
 }
 
 void ADVSCamera::imageToLogGray(const TArray<FColor> &image, TArray<float> &gray)
@@ -171,11 +193,16 @@ void ADVSCamera::imageToLogGray(const TArray<FColor> &image, TArray<float> &gray
   /** Reserve HxW elements **/
   gray.SetNumUninitialized(image.Num());
 
-  /** Convert image to gray raw image values **/
-  for (size_t i = 0; i<image.Num(); ++i)
+  /** Convert image to gray raw image values, one scanline per task **/
+  const int32 width = this->GetImageWidth();
+  const float log_eps = this->config.log_eps;
+  ParallelFor(this->GetImageHeight(), [&](int32 y)
   {
-    gray[i] = std::log(this->config.log_eps + ((0.2989*image[i].R +  0.5870*image[i].G + 0.1140*image[i].B)/255.0));
-  }
+    for (int32 i = y * width; i < (y + 1) * width; ++i)
+    {
+      gray[i] = std::log(log_eps + ((0.2989*image[i].R +  0.5870*image[i].G + 0.1140*image[i].B)/255.0));
+    }
+  });
 }
 
 ADVSCamera::DVSEventArray ADVSCamera::simulation (float DeltaTime)
@@ -209,72 +236,115 @@ ADVSCamera::DVSEventArray ADVSCamera::simulation (float DeltaTime)
   const std::uint64_t delta_t_ns = dvs::secToNanosec(
       this->GetEpisode().GetElapsedGameTime()) - this->current_time;
 
-  /** Loop along the image size **/
-  for (uint32 y = 0; y < this->GetImageHeight(); ++y)
+  const uint32 height = this->GetImageHeight();
+  const uint32 width = this->GetImageWidth();
+
+  /** The image is split in blocks of scanlines simulated in parallel. Each
+   * block owns its rows of the per-pixel state arrays and appends to its own
+   * event array, the blocks are merged afterwards. **/
+  const uint32 num_blocks = (height + kDVSRowsPerBlock - 1u) / kDVSRowsPerBlock;
+  std::vector<DVSEventArray> block_events(num_blocks);
+
+  /** The shared random engine is not thread-safe, when the thresholds are
+   * noisy each block gets its own stream seeded on the game thread. **/
+  const bool use_noisy_threshold = (this->config.sigma_Cp > 0) || (this->config.sigma_Cm > 0);
+  std::vector<std::mt19937> block_engines;
+  if (use_noisy_threshold)
   {
-    for (uint32 x = 0; x < this->GetImageWidth(); ++x)
+    block_engines.reserve(num_blocks);
+    for (uint32 block = 0u; block < num_blocks; ++block)
     {
-      const uint32 i = (this->GetImageWidth() * y) + x;
-      const float itdt = this->last_image[i];
-      const float it = this->prev_image[i];
-      const float prev_cross = this->ref_values[i];
+      block_engines.emplace_back(static_cast<uint32>(
+          RandomEngine->GetUniformIntInRange(0, std::numeric_limits<int32>::max())));
+    }
+  }
 
-      if (std::fabs (it - itdt) > tolerance)
+  ParallelFor(num_blocks, [&](int32 block)
+  {
+    auto &events_in_block = block_events[block];
+    const uint32 y_begin = block * kDVSRowsPerBlock;
+    const uint32 y_end = std::min(height, y_begin + kDVSRowsPerBlock);
+
+    for (uint32 y = y_begin; y < y_end; ++y)
+    {
+      for (uint32 x = 0; x < width; ++x)
       {
-        const float pol = (itdt >= it) ? +1.0 : -1.0;
-        float C = (pol > 0) ? this->config.Cp : this->config.Cm;
-        const float sigma_C = (pol > 0) ? this->config.sigma_Cp : this->config.sigma_Cm;
+        const uint32 i = (width * y) + x;
+        const float itdt = this->last_image[i];
+        const float it = this->prev_image[i];
+        const float prev_cross = this->ref_values[i];
 
-        if(sigma_C > 0)
+        if (std::fabs (it - itdt) > tolerance)
         {
-          C += RandomEngine->GetNormalDistribution(0, sigma_C);
-          constexpr float minimum_contrast_threshold = 0.01;
-          C = std::max(minimum_contrast_threshold, C);
-        }
-        float curr_cross = prev_cross;
-        bool all_crossings = false;
-
-        do
-        {
-          curr_cross += pol * C;
+          const float pol = (itdt >= it) ? +1.0 : -1.0;
+          float C = (pol > 0) ? this->config.Cp : this->config.Cm;
+          const float sigma_C = (pol > 0) ? this->config.sigma_Cp : this->config.sigma_Cm;
+
+          if(sigma_C > 0)
+          {
+            C += std::normal_distribution<float>(0, sigma_C)(block_engines[block]);
+            constexpr float minimum_contrast_threshold = 0.01;
+            C = std::max(minimum_contrast_threshold, C);
+          }
+          float curr_cross = prev_cross;
+          bool all_crossings = false;
 
-          if ((pol > 0 && curr_cross > it && curr_cross <= itdt)
-              || (pol < 0 && curr_cross < it && curr_cross >= itdt))
+          do
           {
-            const std::uint64_t edt = (curr_cross - it) * delta_t_ns / (itdt - it);
-            const std::int64_t t = this->current_time + edt;
+            curr_cross += pol * C;
 
-            // check that pixel (x,y) is not currently in a "refractory" state
-            // i.e. |t-that last_timestamp(x,y)| >= refractory_period
-            const std::int64_t last_stamp_at_xy = dvs::secToNanosec(this->last_event_timestamp[i]);
-            if (t >= last_stamp_at_xy)
+            if ((pol > 0 && curr_cross > it && curr_cross <= itdt)
+                || (pol < 0 && curr_cross < it && curr_cross >= itdt))
             {
-              const std::uint64_t dt = t - last_stamp_at_xy;
-              if(this->last_event_timestamp[i] == 0 || dt >= this->config.refractory_period_ns)
-              {
-                events.push_back(::carla::sensor::data::DVSEvent(x, y, t, pol > 0));
-                this->last_event_timestamp[i] = dvs::nanosecToSecTrunc(t);
-              }
-              else
+              const std::uint64_t edt = (curr_cross - it) * delta_t_ns / (itdt - it);
+              const std::int64_t t = this->current_time + edt;
+
+              // check that pixel (x,y) is not currently in a "refractory" state
+              // i.e. |t-that last_timestamp(x,y)| >= refractory_period
+              const std::int64_t last_stamp_at_xy = dvs::secToNanosec(this->last_event_timestamp[i]);
+              if (t >= last_stamp_at_xy)
               {
-                /** Dropping event because time since last event < refractory_period_ns **/
+                const std::uint64_t dt = t - last_stamp_at_xy;
+                if(this->last_event_timestamp[i] == 0 || dt >= this->config.refractory_period_ns)
+                {
+                  events_in_block.push_back(::carla::sensor::data::DVSEvent(x, y, t, pol > 0));
+                  this->last_event_timestamp[i] = dvs::nanosecToSecTrunc(t);
+                }
+                else
+                {
+                  /** Dropping event because time since last event < refractory_period_ns **/
+                }
+                this->ref_values[i] = curr_cross;
               }
-              this->ref_values[i] = curr_cross;
             }
-          }
-          else
-          {
-            all_crossings = true;
-          }
-        } while (!all_crossings);
-      } // end tolerance
-    } // end for each pixel
+            else
+            {
+              all_crossings = true;
+            }
+          } while (!all_crossings);
+        } // end tolerance
+      } // end for each pixel
+    }
+  });
+
+  /** Merge the per-block arrays, reserving the exact total up front **/
+  size_t num_events = 0u;
+  for (const auto &events_in_block : block_events)
+  {
+    num_events += events_in_block.size();
+  }
+  events.reserve(num_events);
+  for (const auto &events_in_block : block_events)
+  {
+    events.insert(events.end(), events_in_block.begin(), events_in_block.end());
   }
 
   /** Update current time **/
   this->current_time = dvs::secToNanosec(this->GetEpisode().GetElapsedGameTime());
 
-  this->prev_image = this->last_image;
+  /** The previous image is overwritten in full by the next conversion, swap
+   * instead of copying the whole frame **/
+  Swap(this->prev_image, this->last_image);
 
   // Sort the events by increasing timestamps, since this is what
   // most event processing algorithms expect
@@ -23,6 +23,7 @@ namespace dvs
     std::uint64_t refractory_period_ns;
     bool use_log;
     float log_eps;
+    bool soa_wire_format;
   };
 
   inline constexpr std::int64_t secToNanosec(double seconds)
@@ -49,6 +50,13 @@ public:
   static FActorDefinition GetSensorDefinition();
   void Set(const FActorDescription &ActorDescription) override;
 
+  /// Wether the events are serialized as struct-of-arrays planes, queried by
+  /// the serializer.
+  bool UsesSoAWireFormat() const
+  {
+    return config.soa_wire_format;
+  }
+
 protected:
   void Tick(float DeltaTime) override;
   void imageToGray(const TArray<FColor> &image, TArray<float> &gray);
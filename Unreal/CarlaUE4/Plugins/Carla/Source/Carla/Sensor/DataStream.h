@@ -50,6 +50,22 @@ public:
     return (*Stream).token();
   }
 
+  /// Whether any client is currently subscribed to this stream.
+  bool IsListening() const
+  {
+    check(Stream.has_value());
+    return (*Stream).AreClientsListening();
+  }
+
+  /// Whether a message sent now would be consumed by a client rather than
+  /// discarded: someone is subscribed and the previous message is not still
+  /// waiting in a keep-latest queue.
+  bool IsReadyForNextMessage() const
+  {
+    check(Stream.has_value());
+    return (*Stream).IsReadyForNextMessage();
+  }
+
 private:
 
   boost::optional<StreamType> Stream;
@@ -48,8 +48,19 @@ void AGnssSensor::Tick(float DeltaSeconds)
   double Longitude = CurrentLocation.longitude + LongitudeBias + LonError;
   double Altitude = CurrentLocation.altitude + AltitudeBias + AltError;
 
-  auto Stream = GetDataStream(*this);
-  Stream.Send(*this, carla::geom::GeoLocation{Latitude, Longitude, Altitude});
+  Batch.emplace_back(carla::sensor::s11n::GnssSerializer::Sample{
+      GetEpisode().GetElapsedGameTime(),
+      carla::geom::GeoLocation{Latitude, Longitude, Altitude}});
+  BatchElapsed += DeltaSeconds;
+
+  if ((Batch.size() >= static_cast<size_t>(BatchSize)) ||
+      ((BatchInterval > 0.0f) && (BatchElapsed >= BatchInterval)))
+  {
+    auto Stream = GetDataStream(*this);
+    Stream.Send(*this, Batch);
+    Batch.clear();
+    BatchElapsed = 0.0f;
+  }
 }
 
 void AGnssSensor::SetLatitudeDeviation(float Value)
@@ -82,6 +93,16 @@ void AGnssSensor::SetAltitudeBias(float Value)
   AltitudeBias = Value;
 }
 
+void AGnssSensor::SetBatchSize(int32 InBatchSize)
+{
+  BatchSize = FMath::Max(1, InBatchSize);
+}
+
+void AGnssSensor::SetBatchInterval(float InBatchInterval)
+{
+  BatchInterval = FMath::Max(0.0f, InBatchInterval);
+}
+
 float AGnssSensor::GetLatitudeDeviation() const
 {
   return LatitudeDeviation;
@@ -13,8 +13,11 @@
 
 #include <compiler/disable-ue4-macros.h>
 #include "carla/geom/GeoLocation.h"
+#include "carla/sensor/s11n/GnssSerializer.h"
 #include <compiler/enable-ue4-macros.h>
 
+#include <vector>
+
 #include "GnssSensor.generated.h"
 
 /// Gnss sensor representation
@@ -42,6 +45,9 @@ public:
   void SetLongitudeBias(float Value);
   void SetAltitudeBias(float Value);
 
+  void SetBatchSize(int32 InBatchSize);
+  void SetBatchInterval(float InBatchInterval);
+
   float GetLatitudeDeviation() const;
   float GetLongitudeDeviation() const;
   float GetAltitudeDeviation() const;
@@ -65,4 +71,17 @@ private:
   float LatitudeBias;
   float LongitudeBias;
   float AltitudeBias;
+
+  /// Number of samples to accumulate before flushing, 1 disables batching.
+  int32 BatchSize = 1;
+
+  /// Flush the batch after this many seconds even if incomplete, 0 disables
+  /// the time limit.
+  float BatchInterval = 0.0f;
+
+  /// Samples accumulated since the last flush.
+  std::vector<carla::sensor::s11n::GnssSerializer::Sample> Batch;
+
+  /// Seconds elapsed since the last flush.
+  float BatchElapsed = 0.0f;
 };
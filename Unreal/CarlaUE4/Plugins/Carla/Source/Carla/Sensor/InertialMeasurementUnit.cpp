@@ -175,12 +175,19 @@ void AInertialMeasurementUnit::Tick(float DeltaTime)
 {
   Super::Tick(DeltaTime);
 
-  auto Stream = GetDataStream(*this);
-  Stream.Send(
-      *this,
-      ComputeAccelerometer(DeltaTime),
-      ComputeGyroscope(),
-      ComputeCompass());
+  Batch.emplace_back(carla::sensor::s11n::IMUSerializer::Sample{
+      GetEpisode().GetElapsedGameTime(),
+      {ComputeAccelerometer(DeltaTime), ComputeGyroscope(), ComputeCompass()}});
+  BatchElapsed += DeltaTime;
+
+  if ((Batch.size() >= static_cast<size_t>(BatchSize)) ||
+      ((BatchInterval > 0.0f) && (BatchElapsed >= BatchInterval)))
+  {
+    auto Stream = GetDataStream(*this);
+    Stream.Send(*this, Batch);
+    Batch.clear();
+    BatchElapsed = 0.0f;
+  }
 }
 
 void AInertialMeasurementUnit::SetAccelerationStandardDeviation(const FVector &Vec)
@@ -198,6 +205,16 @@ void AInertialMeasurementUnit::SetGyroscopeBias(const FVector &Vec)
   BiasGyro = Vec;
 }
 
+void AInertialMeasurementUnit::SetBatchSize(int32 InBatchSize)
+{
+  BatchSize = FMath::Max(1, InBatchSize);
+}
+
+void AInertialMeasurementUnit::SetBatchInterval(float InBatchInterval)
+{
+  BatchInterval = FMath::Max(0.0f, InBatchInterval);
+}
+
 const FVector &AInertialMeasurementUnit::GetAccelerationStandardDeviation() const
 {
   return StdDevAccel;
@@ -13,9 +13,11 @@
 
 #include <compiler/disable-ue4-macros.h>
 #include "carla/geom/Vector3D.h"
+#include "carla/sensor/s11n/IMUSerializer.h"
 #include <compiler/enable-ue4-macros.h>
 
 #include <array>
+#include <vector>
 
 #include "InertialMeasurementUnit.generated.h"
 
@@ -57,6 +59,10 @@ public:
 
   void SetGyroscopeBias(const FVector &Vec);
 
+  void SetBatchSize(int32 InBatchSize);
+
+  void SetBatchInterval(float InBatchInterval);
+
   const FVector &GetAccelerationStandardDeviation() const;
 
   const FVector &GetGyroscopeStandardDeviation() const;
@@ -85,4 +91,17 @@ private:
   /// Used to compute the acceleration
   float PrevDeltaTime;
 
+  /// Number of samples to accumulate before flushing, 1 disables batching.
+  int32 BatchSize = 1;
+
+  /// Flush the batch after this many seconds even if incomplete, 0 disables
+  /// the time limit.
+  float BatchInterval = 0.0f;
+
+  /// Samples accumulated since the last flush.
+  std::vector<carla::sensor::s11n::IMUSerializer::Sample> Batch;
+
+  /// Seconds elapsed since the last flush.
+  float BatchElapsed = 0.0f;
+
 };
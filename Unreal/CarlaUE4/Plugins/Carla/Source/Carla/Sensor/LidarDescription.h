@@ -42,4 +42,25 @@ struct CARLA_API FLidarDescription
   /// Wether to show debug points of laser hits in simulator.
   UPROPERTY(EditAnywhere)
   bool ShowDebugPoints = false;
+
+  /// Wether to compute the points on the GPU, sampling rasterized depth
+  /// captures instead of shooting one physics line trace per point.
+  UPROPERTY(EditAnywhere)
+  bool GpuRayCast = false;
+
+  /// Wether to stream the points as 16-bit fixed point (centimeter
+  /// resolution) instead of floats, halving the bandwidth of the stream.
+  UPROPERTY(EditAnywhere)
+  bool Quantized = false;
+
+  /// Wether to attach the semantic tag of the hit actor (as assigned by the
+  /// tagger) to each point. Not available in GPU mode.
+  UPROPERTY(EditAnywhere)
+  bool Semantic = false;
+
+  /// Number of fixed angular sectors per revolution to stream as separate
+  /// measurements as they complete, lowering the latency of each point.
+  /// Zero keeps the classic one-measurement-per-tick behavior.
+  UPROPERTY(EditAnywhere)
+  uint32 SectorCount = 0u;
 };
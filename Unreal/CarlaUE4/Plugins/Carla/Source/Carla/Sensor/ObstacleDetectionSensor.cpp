@@ -58,8 +58,18 @@ void AObstacleDetectionSensor::Tick(float DeltaSeconds)
   const FVector &End = Start + (GetActorForwardVector() * Distance);
   UWorld* CurrentWorld = GetWorld();
 
-  // Struct in which the result of the scan will be saved
-  FHitResult HitOut = FHitResult();
+  // Collect the sweep queued last tick; the physics scene resolved it off
+  // the game thread in the meantime.
+  if (bSweepPending)
+  {
+    bSweepPending = false;
+    FTraceDatum Datum;
+    if (CurrentWorld->QueryTraceData(PendingSweep, Datum) && (Datum.OutHits.Num() > 0))
+    {
+      const FHitResult &HitOut = Datum.OutHits[0];
+      OnObstacleDetectionEvent(this, HitOut.Actor.Get(), HitOut.Distance, HitOut);
+    }
+  }
 
   // Initialization of Query Parameters
   FCollisionQueryParams TraceParams(FName(TEXT("ObstacleDetection Trace")), true, this);
@@ -89,7 +99,29 @@ void AObstacleDetectionSensor::Tick(float DeltaSeconds)
   if(Super::GetOwner()!=nullptr)
     TraceParams.AddIgnoredActor(Super::GetOwner());
 
-  bool isHitReturned;
+  // Sensors of the same fleet often sweep the same geometry (same owner,
+  // same parameters); queries issued this frame are shared through a
+  // per-frame cache instead of queued twice.
+  static uint64 SweepCacheFrame = 0u;
+  static TMap<uint32, FTraceHandle> SharedSweeps;
+  if (SweepCacheFrame != GFrameCounter)
+  {
+    SweepCacheFrame = GFrameCounter;
+    SharedSweeps.Reset();
+  }
+  uint32 SweepKey = PointerHash(CurrentWorld);
+  SweepKey = HashCombine(SweepKey, PointerHash(Super::GetOwner()));
+  SweepKey = HashCombine(SweepKey, GetTypeHash(Start));
+  SweepKey = HashCombine(SweepKey, GetTypeHash(End));
+  SweepKey = HashCombine(SweepKey, GetTypeHash(HitRadius));
+  SweepKey = HashCombine(SweepKey, bOnlyDynamics ? 1u : 0u);
+  if (const FTraceHandle *Shared = SharedSweeps.Find(SweepKey))
+  {
+    PendingSweep = *Shared;
+    bSweepPending = true;
+    return;
+  }
+
   // Choosing a type of sweep is a workaround until everything get properly
   // organized under correct collision channels and object types.
   if (bOnlyDynamics)
@@ -97,8 +129,8 @@ void AObstacleDetectionSensor::Tick(float DeltaSeconds)
     // If we go only for dynamics, we check the object type AllDynamicObjects
     FCollisionObjectQueryParams TraceChannel = FCollisionObjectQueryParams(
         FCollisionObjectQueryParams::AllDynamicObjects);
-    isHitReturned = CurrentWorld->SweepSingleByObjectType(
-        HitOut,
+    PendingSweep = CurrentWorld->AsyncSweepByObjectType(
+        EAsyncTraceType::Single,
         Start,
         End,
         FQuat(),
@@ -111,8 +143,8 @@ void AObstacleDetectionSensor::Tick(float DeltaSeconds)
     // Else, if we go for everything, we get everything that interacts with a
     // Pawn
     ECollisionChannel TraceChannel = ECC_WorldStatic;
-    isHitReturned = CurrentWorld->SweepSingleByChannel(
-        HitOut,
+    PendingSweep = CurrentWorld->AsyncSweepByChannel(
+        EAsyncTraceType::Single,
         Start,
         End,
         FQuat(),
@@ -120,11 +152,8 @@ void AObstacleDetectionSensor::Tick(float DeltaSeconds)
         FCollisionShape::MakeSphere(HitRadius),
         TraceParams);
   }
-
-  if (isHitReturned)
-  {
-    OnObstacleDetectionEvent(this, HitOut.Actor.Get(), HitOut.Distance, HitOut);
-  }
+  bSweepPending = true;
+  SharedSweeps.Add(SweepKey, PendingSweep);
 }
 
 void AObstacleDetectionSensor::OnObstacleDetectionEvent(
@@ -11,69 +11,58 @@
 #include "HighResScreenshot.h"
 #include "Runtime/ImageWriteQueue/Public/ImageWriteQueue.h"
 
-// For now we only support Vulkan on Windows.
-#if PLATFORM_WINDOWS
-#  define CARLA_WITH_VULKAN_SUPPORT 1
-#else
-#  define CARLA_WITH_VULKAN_SUPPORT 1
-#endif
-
 // =============================================================================
 // -- Local variables and types ------------------------------------------------
 // =============================================================================
 
-struct LockTexture
+/// Number of staging textures per sensor; two keeps one copy in flight on
+/// the GPU while the previous one is mapped and sent.
+static constexpr uint32 kNumReadbackSlots = 2u;
+
+/// One fenced copy of a render target into a staging texture.
+struct FReadbackSlot
 {
-  LockTexture(FRHITexture2D *InTexture, uint32 &Stride)
-    : Texture(InTexture),
-      Source(reinterpret_cast<const uint8 *>(
-            RHILockTexture2D(Texture, 0, RLM_ReadOnly, Stride, false))) {}
+  FTexture2DRHIRef StagingTexture;
 
-  ~LockTexture()
-  {
-    RHIUnlockTexture2D(Texture, 0, false);
-  }
+  FGPUFenceRHIRef Fence;
+
+  FPixelReader::FSendMappedPixels Send;
+
+  bool bInFlight = false;
+};
 
-  FRHITexture2D *Texture;
+/// Ring of fenced readbacks for one sensor.
+struct FSensorReadback
+{
+  FReadbackSlot Slots[kNumReadbackSlots];
 
-  const uint8 *Source;
+  uint32 NextSlot = 0u;
 };
 
+/// Readback state per sensor, only touched from the render thread.
+static TMap<const void *, TUniquePtr<FSensorReadback>> GReadbacks;
+
 // =============================================================================
 // -- Static local functions ---------------------------------------------------
 // =============================================================================
 
-#if CARLA_WITH_VULKAN_SUPPORT == 1
-
-static void WritePixelsToBuffer_Vulkan(
-    const UTextureRenderTarget2D &RenderTarget,
-    carla::Buffer &Buffer,
-    uint32 Offset,
-    FRHICommandListImmediate &InRHICmdList)
+/// Map the staging texture of a completed copy and hand it to the slot's
+/// send callback.
+static void SendReadbackSlot(FReadbackSlot &Slot, FRHICommandListImmediate &InRHICmdList)
 {
-  check(IsInRenderingThread());
-  auto RenderResource =
-      static_cast<const FTextureRenderTarget2DResource *>(RenderTarget.Resource);
-  FTexture2DRHIRef Texture = RenderResource->GetRenderTargetTexture();
-  if (!Texture)
+  void *MappedData = nullptr;
+  int32 MappedWidth = 0;
+  int32 MappedHeight = 0;
+  InRHICmdList.MapStagingSurface(Slot.StagingTexture, MappedData, MappedWidth, MappedHeight);
+  if (MappedData != nullptr)
   {
-    UE_LOG(LogCarla, Error, TEXT("FPixelReader: UTextureRenderTarget2D missing render target texture"));
-    return;
+    Slot.Send(MappedData, MappedWidth, MappedHeight);
+    InRHICmdList.UnmapStagingSurface(Slot.StagingTexture);
   }
-
-  // NS: Extra copy here, don't know how to avoid it.
-  TArray<FColor> Pixels;
-  InRHICmdList.ReadSurfaceData(
-      Texture,
-      FIntRect(0, 0, RenderResource->GetSizeXY().X, RenderResource->GetSizeXY().Y),
-      Pixels,
-      FReadSurfaceDataFlags(RCM_UNorm, CubeFace_MAX));
-
-  Buffer.copy_from(Offset, Pixels);
+  Slot.Send = nullptr;
+  Slot.bInFlight = false;
 }
 
-#endif // CARLA_WITH_VULKAN_SUPPORT
-
 // =============================================================================
 // -- FPixelReader -------------------------------------------------------------
 // =============================================================================
@@ -130,57 +119,126 @@ TFuture<bool> FPixelReader::SavePixelsToDisk(
   return HighResScreenshotConfig.ImageWriteQueue->Enqueue(MoveTemp(ImageTask));
 }
 
-void FPixelReader::WritePixelsToBuffer(
-    UTextureRenderTarget2D &RenderTarget,
+void FPixelReader::CopyMappedPixels(
     carla::Buffer &Buffer,
     uint32 Offset,
-    FRHICommandListImmediate &
-#if CARLA_WITH_VULKAN_SUPPORT == 1
-    InRHICmdList
-#endif // CARLA_WITH_VULKAN_SUPPORT
-    )
+    FIntRect ROI,
+    const void *MappedData,
+    int32 MappedWidth,
+    int32 MappedHeight)
 {
-  check(IsInRenderingThread());
+  const uint32 BytesPerPixel = 4u; // PF_R8G8B8A8
+  ROI.Clip(FIntRect(0, 0, MappedWidth, MappedHeight));
+  const uint32 SrcStride = static_cast<uint32>(MappedWidth) * BytesPerPixel;
+  const uint32 RowBytes = ROI.Width() * BytesPerPixel;
+  const uint8 *Source = reinterpret_cast<const uint8 *>(MappedData);
 
-#if CARLA_WITH_VULKAN_SUPPORT == 1
-  if (IsVulkanPlatform(GMaxRHIShaderPlatform))
+  if ((ROI.Min.X == 0) && (ROI.Min.Y == 0) && (RowBytes == SrcStride))
   {
-    WritePixelsToBuffer_Vulkan(RenderTarget, Buffer, Offset, InRHICmdList);
+    Buffer.copy_from(Offset, Source, SrcStride * ROI.Height());
     return;
   }
-#endif // CARLA_WITH_VULKAN_SUPPORT
 
-  FRHITexture2D *Texture = RenderTarget.GetRenderTargetResource()->GetRenderTargetTexture();
-  checkf(Texture != nullptr, TEXT("FPixelReader: UTextureRenderTarget2D missing render target texture"));
+  // Cropped region, or the RHI padding the rows of the staging texture
+  // (JB: D3D uses additional rows in the buffer, so we need to check the
+  // resulting stride of the mapping), copy row by row.
+  Buffer.reset(Offset + RowBytes * ROI.Height());
+  auto DstRow = Buffer.begin() + Offset;
+  const uint8 *SrcRow = Source + ROI.Min.Y * SrcStride + ROI.Min.X * BytesPerPixel;
+  for (int32 Row = 0; Row < ROI.Height(); ++Row)
+  {
+    FMemory::Memcpy(DstRow, SrcRow, RowBytes);
+    DstRow += RowBytes;
+    SrcRow += SrcStride;
+  }
+}
 
-  const uint32 BytesPerPixel = 4u; // PF_R8G8B8A8
-  const uint32 Width = Texture->GetSizeX();
-  const uint32 Height = Texture->GetSizeY();
-  const uint32 ExpectedStride = Width * BytesPerPixel;
+void FPixelReader::InvalidateReadback(const void *SensorKey)
+{
+  ENQUEUE_RENDER_COMMAND(FPixelReader_InvalidateReadback)
+  (
+    [SensorKey](FRHICommandListImmediate &)
+    {
+      // drop the pending sends too, the sensor reference captured inside
+      // them may not outlive this command
+      GReadbacks.Remove(SensorKey);
+    }
+  );
+}
 
-  uint32 SrcStride;
-  LockTexture Lock(Texture, SrcStride);
+void FPixelReader::WritePixelsToBufferAsync(
+    UTextureRenderTarget2D &RenderTarget,
+    FIntRect ROI,
+    FRHICommandListImmediate &InRHICmdList,
+    const void *SensorKey,
+    FSendMappedPixels &&Send)
+{
+  check(IsInRenderingThread());
 
-#ifdef PLATFORM_WINDOWS
-  // JB: Direct 3D uses additional rows in the buffer, so we need check the
-  // result stride from the lock:
-  if (IsD3DPlatform(GMaxRHIShaderPlatform, false) && (ExpectedStride != SrcStride))
+  auto RenderResource =
+      static_cast<const FTextureRenderTarget2DResource *>(RenderTarget.Resource);
+  FTexture2DRHIRef Texture = RenderResource->GetRenderTargetTexture();
+  if (!Texture)
   {
-    Buffer.reset(Offset + ExpectedStride * Height);
-    auto DstRow = Buffer.begin() + Offset;
-    const uint8 *SrcRow = Lock.Source;
-    for (uint32 Row = 0u; Row < Height; ++Row)
+    UE_LOG(LogCarla, Error, TEXT("FPixelReader: UTextureRenderTarget2D missing render target texture"));
+    return;
+  }
+
+  TUniquePtr<FSensorReadback> &Readback = GReadbacks.FindOrAdd(SensorKey);
+  if (!Readback.IsValid())
+  {
+    Readback = MakeUnique<FSensorReadback>();
+  }
+
+  // send every copy whose fence has signalled, normally the one enqueued
+  // one or two frames ago
+  for (FReadbackSlot &PendingSlot : Readback->Slots)
+  {
+    if (PendingSlot.bInFlight && PendingSlot.Fence->Poll())
     {
-      FMemory::Memcpy(DstRow, SrcRow, ExpectedStride);
-      DstRow += ExpectedStride;
-      SrcRow += SrcStride;
+      SendReadbackSlot(PendingSlot, InRHICmdList);
     }
   }
-  else
-#endif // PLATFORM_WINDOWS
+
+  // Copying only the region of interest saves the readback of the discarded
+  // rows and columns altogether.
+  ROI.Clip(FIntRect(0, 0, RenderResource->GetSizeXY().X, RenderResource->GetSizeXY().Y));
+
+  FReadbackSlot &Slot = Readback->Slots[Readback->NextSlot];
+  Readback->NextSlot = (Readback->NextSlot + 1u) % kNumReadbackSlots;
+
+  // if the oldest slot is still in flight after a whole round of the ring,
+  // flush it now rather than dropping its frame; this is the only place
+  // the readback may wait on the GPU
+  if (Slot.bInFlight)
+  {
+    SendReadbackSlot(Slot, InRHICmdList);
+  }
+
+  // (re)create the staging resources on first use or size change
+  if (!Slot.StagingTexture.IsValid() ||
+      (Slot.StagingTexture->GetSizeX() != Texture->GetSizeX()) ||
+      (Slot.StagingTexture->GetSizeY() != Texture->GetSizeY()))
   {
-    check(ExpectedStride == SrcStride);
-    const uint8 *Source = Lock.Source;
-    Buffer.copy_from(Offset, Source, ExpectedStride * Height);
+    FRHIResourceCreateInfo CreateInfo;
+    Slot.StagingTexture = RHICreateTexture2D(
+        Texture->GetSizeX(),
+        Texture->GetSizeY(),
+        Texture->GetFormat(),
+        1u,
+        1u,
+        TexCreate_CPUReadback,
+        CreateInfo);
+    Slot.Fence = RHICreateGPUFence(TEXT("CarlaPixelReadback"));
   }
+
+  // enqueue the copy and the fence write; the GPU signals the fence once
+  // the staging texture holds the frame
+  Slot.Send = MoveTemp(Send);
+  Slot.Fence->Clear();
+  FResolveParams ResolveParams;
+  ResolveParams.Rect = FResolveRect(ROI.Min.X, ROI.Min.Y, ROI.Max.X, ROI.Max.Y);
+  InRHICmdList.CopyToResolveTarget(Texture, Slot.StagingTexture, ResolveParams);
+  InRHICmdList.WriteGPUFence(Slot.Fence);
+  Slot.bInFlight = true;
 }
@@ -26,6 +26,11 @@ class FPixelReader
 {
 public:
 
+  /// Called with the mapped staging texture of a completed readback; the
+  /// mapped width is the row pitch in pixels, which may exceed the region
+  /// of interest on RHIs that pad staging rows.
+  using FSendMappedPixels = TUniqueFunction<void(const void *MappedData, int32 MappedWidth, int32 MappedHeight)>;
+
   /// Copy the pixels in @a RenderTarget into @a BitMap.
   ///
   /// @pre To be called from game-thread.
@@ -57,6 +62,19 @@ public:
   /// down the @a Sensor's data stream. It expects a sensor derived from
   /// ASceneCaptureSensor or compatible.
   ///
+  /// The readback is asynchronous: the render command enqueues a fenced GPU
+  /// copy into a staging texture and returns without waiting, the buffer is
+  /// sent when the fence signals, one or two frames later. The frame number
+  /// and timestamp in the header are those of the capture, so clients can
+  /// measure the added latency.
+  ///
+  /// The pixels are copied exactly once on the CPU: from the driver-mapped
+  /// staging memory (which must be released before unmapping) into a buffer
+  /// popped from the stream's pool, at the image serializer's header_offset.
+  /// The image header is then written in place and the sensor header is a
+  /// separate buffer gathered on the wire, so no further copy happens
+  /// between here and the socket.
+  ///
   /// Note that the serializer needs to define a "header_offset" that it's
   /// allocated in front of the buffer.
   ///
@@ -64,16 +82,34 @@ public:
   template <typename TSensor>
   static void SendPixelsInRenderThread(TSensor &Sensor);
 
+  /// Copy the pixels of @a ROI from a mapped staging texture into
+  /// @a Buffer, leaving @a Offset bytes in front for the header.
+  static void CopyMappedPixels(
+      carla::Buffer &Buffer,
+      uint32 Offset,
+      FIntRect ROI,
+      const void *MappedData,
+      int32 MappedWidth,
+      int32 MappedHeight);
+
+  /// Drop the readback state of @a SensorKey, releasing its staging
+  /// textures. To be called when the sensor ends play.
+  static void InvalidateReadback(const void *SensorKey);
+
 private:
 
-  /// Copy the pixels in @a RenderTarget into @a Buffer.
+  /// Enqueue a fenced GPU copy of @a ROI in @a RenderTarget into one of the
+  /// staging textures of @a SensorKey, and send every previously enqueued
+  /// copy whose fence has signalled through its @a Send callback. Never
+  /// blocks waiting for the GPU.
   ///
   /// @pre To be called from render-thread.
-  static void WritePixelsToBuffer(
+  static void WritePixelsToBufferAsync(
       UTextureRenderTarget2D &RenderTarget,
-      carla::Buffer &Buffer,
-      uint32 Offset,
-      FRHICommandListImmediate &InRHICmdList);
+      FIntRect ROI,
+      FRHICommandListImmediate &InRHICmdList,
+      const void *SensorKey,
+      FSendMappedPixels &&Send);
 
 };
 
@@ -86,9 +122,18 @@ void FPixelReader::SendPixelsInRenderThread(TSensor &Sensor)
 {
   check(Sensor.CaptureRenderTarget != nullptr);
 
-  // Enqueue a command in the render-thread that will write the image buffer to
-  // the data stream. The stream is created in the capture thus executed in the
-  // game-thread.
+  // The capture scheduler may have skipped the render of this frame, there
+  // are no pixels to read back.
+  if (!Sensor.IsCaptureScheduledThisFrame())
+  {
+    return;
+  }
+
+  // Enqueue a command in the render-thread that will start a fenced GPU copy
+  // of the image into a staging texture. The copy is polled and the buffer
+  // sent by a later command, so the render thread never stalls waiting for
+  // the GPU. The stream is created in the capture thus executed in the
+  // game-thread, its header keeps the frame number of the capture.
   ENQUEUE_RENDER_COMMAND(FWritePixels_SendPixelsInRenderThread)
   (
     [&Sensor, Stream=Sensor.GetDataStream(Sensor)](auto &InRHICmdList) mutable
@@ -96,13 +141,23 @@ void FPixelReader::SendPixelsInRenderThread(TSensor &Sensor)
       /// @todo Can we make sure the sensor is not going to be destroyed?
       if (!Sensor.IsPendingKill())
       {
-        auto Buffer = Stream.PopBufferFromPool();
-        WritePixelsToBuffer(
+        const uint32 Offset = carla::sensor::SensorRegistry::get<TSensor *>::type::header_offset;
+        const FIntRect ROI = Sensor.GetCaptureROI();
+        WritePixelsToBufferAsync(
             *Sensor.CaptureRenderTarget,
-            Buffer,
-            carla::sensor::SensorRegistry::get<TSensor *>::type::header_offset,
-            InRHICmdList);
-        Stream.Send(Sensor, std::move(Buffer));
+            ROI,
+            InRHICmdList,
+            &Sensor,
+            [&Sensor, Stream=MoveTemp(Stream), Offset, ROI](
+                const void *MappedData, int32 MappedWidth, int32 MappedHeight) mutable
+            {
+              if (!Sensor.IsPendingKill())
+              {
+                auto Buffer = Stream.PopBufferFromPool();
+                CopyMappedPixels(Buffer, Offset, ROI, MappedData, MappedWidth, MappedHeight);
+                Stream.Send(Sensor, std::move(Buffer));
+              }
+            });
       }
     }
   );
@@ -71,11 +71,11 @@ void ARadar::Tick(const float DeltaTime)
 
   CalculateCurrentVelocity(DeltaTime);
 
-  RadarData.Reset();
+  auto DataStream = GetDataStream(*this);
+  RadarData.Reset(DataStream.PopBufferFromPool());
   SendLineTraces(DeltaTime);
 
-  auto DataStream = GetDataStream(*this);
-  DataStream.Send(*this, RadarData, DataStream.PopBufferFromPool());
+  DataStream.Send(*this, std::move(RadarData));
 }
 
 void ARadar::CalculateCurrentVelocity(const float DeltaTime)
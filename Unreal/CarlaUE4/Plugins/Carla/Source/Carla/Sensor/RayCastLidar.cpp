@@ -7,15 +7,26 @@
 #include "Carla.h"
 #include "Carla/Sensor/RayCastLidar.h"
 #include "Carla/Actor/ActorBlueprintFunctionLibrary.h"
+#include "Carla/Game/Tagger.h"
 
 #include <compiler/disable-ue4-macros.h>
 #include "carla/geom/Math.h"
 #include <compiler/enable-ue4-macros.h>
 
+#include "Components/SceneCaptureComponent2D.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/CollisionProfile.h"
+#include "Engine/TextureRenderTarget2D.h"
 #include "Runtime/Engine/Classes/Kismet/KismetMathLibrary.h"
 
+/// Resolution of each depth capture face in GPU mode; at 512 pixels per 90
+/// degrees the angular resolution (~0.18 degree) exceeds the densest
+/// supported lidar configurations.
+static constexpr uint32 kDepthCaptureFaceSize = 512u;
+
+/// Number of 90-degree faces covering the full horizontal turn.
+static constexpr uint32 kDepthCaptureFaces = 4u;
+
 FActorDefinition ARayCastLidar::GetSensorDefinition()
 {
   return UActorBlueprintFunctionLibrary::MakeLidarDefinition(TEXT("ray_cast"));
@@ -38,7 +49,28 @@ void ARayCastLidar::Set(const FActorDescription &ActorDescription)
 void ARayCastLidar::Set(const FLidarDescription &LidarDescription)
 {
   Description = LidarDescription;
+  if (Description.Semantic && Description.GpuRayCast)
+  {
+    // the depth captures carry no stencil information to read the tags from
+    UE_LOG(
+        LogCarla,
+        Warning,
+        TEXT("%s: semantic tags are not available in GPU mode, falling back to CPU ray casting."),
+        *GetName());
+    Description.GpuRayCast = false;
+  }
   LidarMeasurement = FLidarMeasurement(Description.Channels);
+  LidarMeasurement.SetQuantized(Description.Quantized);
+  LidarMeasurement.SetSemantic(Description.Semantic);
+  SectorPoints.Empty();
+  SectorTags.Empty();
+  if (Description.SectorCount > 0u)
+  {
+    SectorPoints.SetNum(Description.Channels);
+    SectorTags.SetNum(Description.Channels);
+  }
+  CurrentSector = 0u;
+  RevolutionId = 0u;
   CreateLasers();
 }
 
@@ -58,14 +90,91 @@ void ARayCastLidar::CreateLasers()
   }
 }
 
+void ARayCastLidar::BeginPlay()
+{
+  Super::BeginPlay();
+
+  if (Description.GpuRayCast)
+  {
+    // the depth panorama covers 45 degrees above and below the horizon
+    if ((Description.UpperFovLimit > 45.0f) || (Description.LowerFovLimit < -45.0f))
+    {
+      UE_LOG(
+          LogCarla,
+          Warning,
+          TEXT("%s: vertical FOV out of reach of the depth captures, falling back to CPU ray casting."),
+          *GetName());
+      Description.GpuRayCast = false;
+    }
+    else
+    {
+      SetUpDepthCaptures();
+    }
+  }
+}
+
 void ARayCastLidar::Tick(const float DeltaTime)
 {
   Super::Tick(DeltaTime);
 
+  if (Description.GpuRayCast)
+  {
+    ReadDepthCaptures();
+  }
+
   ReadPoints(DeltaTime);
 
-  auto DataStream = GetDataStream(*this);
-  DataStream.Send(*this, LidarMeasurement, DataStream.PopBufferFromPool());
+  if (Description.SectorCount == 0u)
+  {
+    auto DataStream = GetDataStream(*this);
+    DataStream.Send(*this, LidarMeasurement, DataStream.PopBufferFromPool());
+  }
+  // in sector streaming mode ReadPoints sends each sector as the scan
+  // angle leaves it
+}
+
+void ARayCastLidar::SetUpDepthCaptures()
+{
+  DepthCaptureFaces.Empty(kDepthCaptureFaces);
+  DepthCaptureTargets.Empty(kDepthCaptureFaces);
+  DepthCaptureBuffers.Empty();
+  DepthCaptureBuffers.SetNum(kDepthCaptureFaces);
+
+  for (auto Face = 0u; Face < kDepthCaptureFaces; ++Face)
+  {
+    auto *RenderTarget = NewObject<UTextureRenderTarget2D>(this);
+    RenderTarget->InitCustomFormat(
+        kDepthCaptureFaceSize,
+        kDepthCaptureFaceSize,
+        PF_FloatRGBA,
+        true);
+    DepthCaptureTargets.Emplace(RenderTarget);
+
+    auto *Capture = NewObject<USceneCaptureComponent2D>(this);
+    Capture->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
+    Capture->SetRelativeRotation(FRotator(0.0f, 90.0f * Face, 0.0f));
+    Capture->RegisterComponent();
+    Capture->FOVAngle = 90.0f;
+    Capture->CaptureSource = ESceneCaptureSource::SCS_SceneDepth;
+    Capture->TextureTarget = RenderTarget;
+    Capture->MaxViewDistanceOverride = Description.Range;
+    Capture->bCaptureEveryFrame = true;
+    DepthCaptureFaces.Emplace(Capture);
+  }
+}
+
+void ARayCastLidar::ReadDepthCaptures()
+{
+  // a single readback per face replaces one line trace per point; reading
+  // synchronously here keeps the points of this tick's pose together
+  for (auto Face = 0u; Face < kDepthCaptureFaces; ++Face)
+  {
+    auto *RTResource = DepthCaptureTargets[Face]->GameThread_GetRenderTargetResource();
+    if (RTResource != nullptr)
+    {
+      RTResource->ReadFloat16Pixels(DepthCaptureBuffers[Face]);
+    }
+  }
 }
 
 void ARayCastLidar::ReadPoints(const float DeltaTime)
@@ -92,17 +201,63 @@ void ARayCastLidar::ReadPoints(const float DeltaTime)
   const float AngleDistanceOfTick = Description.RotationFrequency * 360.0f * DeltaTime;
   const float AngleDistanceOfLaserMeasure = AngleDistanceOfTick / PointsToScanWithOneLaser;
 
-  LidarMeasurement.Reset(ChannelCount * PointsToScanWithOneLaser);
+  if (Description.SectorCount == 0u)
+  {
+    LidarMeasurement.Reset(ChannelCount * PointsToScanWithOneLaser);
 
-  for (auto Channel = 0u; Channel < ChannelCount; ++Channel)
+    for (auto Channel = 0u; Channel < ChannelCount; ++Channel)
+    {
+      for (auto i = 0u; i < PointsToScanWithOneLaser; ++i)
+      {
+        FVector Point;
+        uint8 Tag = 0u;
+        const float Angle = CurrentHorizontalAngle + AngleDistanceOfLaserMeasure * i;
+        const bool bHit = Description.GpuRayCast
+            ? SampleDepthCaptures(Channel, Angle, Point)
+            : ShootLaser(Channel, Angle, Point, Tag);
+        if (bHit)
+        {
+          LidarMeasurement.WritePoint(Channel, Point, Tag);
+        }
+      }
+    }
+  }
+  else
   {
+    // sector streaming: scan angle-outer so the points of a sector complete
+    // together, flushing the sector as soon as the scan angle leaves it; a
+    // sector can span several ticks, the per-channel buffers carry it over
+    const float SectorSize = 360.0f / static_cast<float>(Description.SectorCount);
     for (auto i = 0u; i < PointsToScanWithOneLaser; ++i)
     {
-      FVector Point;
       const float Angle = CurrentHorizontalAngle + AngleDistanceOfLaserMeasure * i;
-      if (ShootLaser(Channel, Angle, Point))
+      const uint32 Sector = static_cast<uint32>(
+          std::fmod(Angle, 360.0f) / SectorSize) % Description.SectorCount;
+      if (Sector != CurrentSector)
+      {
+        SendSector();
+        if (Sector < CurrentSector)
+        {
+          // wrapped past 360 degrees
+          ++RevolutionId;
+        }
+        CurrentSector = Sector;
+      }
+      for (auto Channel = 0u; Channel < ChannelCount; ++Channel)
       {
-        LidarMeasurement.WritePoint(Channel, Point);
+        FVector Point;
+        uint8 Tag = 0u;
+        const bool bHit = Description.GpuRayCast
+            ? SampleDepthCaptures(Channel, Angle, Point)
+            : ShootLaser(Channel, Angle, Point, Tag);
+        if (bHit)
+        {
+          SectorPoints[Channel].Emplace(Point);
+          if (Description.Semantic)
+          {
+            SectorTags[Channel].Emplace(Tag);
+          }
+        }
       }
     }
   }
@@ -112,7 +267,38 @@ void ARayCastLidar::ReadPoints(const float DeltaTime)
   LidarMeasurement.SetHorizontalAngle(HorizontalAngle);
 }
 
-bool ARayCastLidar::ShootLaser(const uint32 Channel, const float HorizontalAngle, FVector &XYZ) const
+void ARayCastLidar::SendSector()
+{
+  uint32 TotalPointCount = 0u;
+  for (const auto &ChannelPoints : SectorPoints)
+  {
+    TotalPointCount += ChannelPoints.Num();
+  }
+  LidarMeasurement.Reset(TotalPointCount);
+  for (auto Channel = 0u; Channel < Description.Channels; ++Channel)
+  {
+    for (auto i = 0; i < SectorPoints[Channel].Num(); ++i)
+    {
+      LidarMeasurement.WritePoint(
+          Channel,
+          SectorPoints[Channel][i],
+          Description.Semantic ? SectorTags[Channel][i] : 0u);
+    }
+    SectorPoints[Channel].Reset();
+    SectorTags[Channel].Reset();
+  }
+  // the angle where the sector ends, i.e. where this measurement stops
+  const float SectorEnd = 360.0f * static_cast<float>(CurrentSector + 1u) /
+      static_cast<float>(Description.SectorCount);
+  LidarMeasurement.SetHorizontalAngle(
+      carla::geom::Math::ToRadians(std::fmod(SectorEnd, 360.0f)));
+  LidarMeasurement.SetSector(CurrentSector, Description.SectorCount, RevolutionId);
+
+  auto DataStream = GetDataStream(*this);
+  DataStream.Send(*this, LidarMeasurement, DataStream.PopBufferFromPool());
+}
+
+bool ARayCastLidar::ShootLaser(const uint32 Channel, const float HorizontalAngle, FVector &XYZ, uint8 &Tag) const
 {
   const float VerticalAngle = LaserAngles[Channel];
 
@@ -143,6 +329,16 @@ bool ARayCastLidar::ShootLaser(const uint32 Channel, const float HorizontalAngle
 
   if (HitInfo.bBlockingHit)
   {
+    if (Description.Semantic)
+    {
+      // the trace already paid for the hit, reading the tag is a single
+      // stencil value lookup on the component it returned
+      const UPrimitiveComponent *Component = HitInfo.Component.Get();
+      Tag = (Component != nullptr)
+          ? static_cast<uint8>(ATagger::GetTagOfTaggedComponent(*Component))
+          : 0u;
+    }
+
     if (Description.ShowDebugPoints)
     {
       DrawDebugPoint(
@@ -167,3 +363,75 @@ bool ARayCastLidar::ShootLaser(const uint32 Channel, const float HorizontalAngle
     return false;
   }
 }
+
+bool ARayCastLidar::SampleDepthCaptures(const uint32 Channel, const float HorizontalAngle, FVector &XYZ) const
+{
+  const float VerticalAngle = LaserAngles[Channel];
+
+  // select the face covering the laser's quadrant; the faces are attached
+  // to the sensor, so the sampling works in lidar-local angles
+  float LocalYaw = std::fmod(HorizontalAngle, 360.0f);
+  if (LocalYaw < 0.0f)
+  {
+    LocalYaw += 360.0f;
+  }
+  const uint32 Face =
+      static_cast<uint32>(std::fmod(LocalYaw + 45.0f, 360.0f) / 90.0f) % kDepthCaptureFaces;
+  const float FaceYaw = LocalYaw - 90.0f * Face;
+  const float FaceYawRad = carla::geom::Math::ToRadians(
+      (FaceYaw > 180.0f) ? FaceYaw - 360.0f : FaceYaw);
+  const float PitchRad = carla::geom::Math::ToRadians(VerticalAngle);
+
+  const TArray<FFloat16Color> &DepthMap = DepthCaptureBuffers[Face];
+  if (DepthMap.Num() != static_cast<int32>(kDepthCaptureFaceSize * kDepthCaptureFaceSize))
+  {
+    // the first frame has no rendered depth yet
+    return false;
+  }
+
+  // project the laser direction onto the 90-degree face plane
+  const float U = std::tan(FaceYawRad);
+  const float V = std::tan(PitchRad) / std::cos(FaceYawRad);
+  if ((U < -1.0f) || (U > 1.0f) || (V < -1.0f) || (V > 1.0f))
+  {
+    return false;
+  }
+  const auto PixelX = FMath::Clamp<int32>(
+      static_cast<int32>((U * 0.5f + 0.5f) * kDepthCaptureFaceSize),
+      0, kDepthCaptureFaceSize - 1u);
+  const auto PixelY = FMath::Clamp<int32>(
+      static_cast<int32>((0.5f - V * 0.5f) * kDepthCaptureFaceSize),
+      0, kDepthCaptureFaceSize - 1u);
+
+  // scene depth is the distance along the face's forward axis, in
+  // centimeters; recover the distance along the laser from it
+  const float SceneDepth = DepthMap[PixelY * kDepthCaptureFaceSize + PixelX].R.GetFloat();
+  const float ForwardDot = std::cos(FaceYawRad) * std::cos(PitchRad);
+  const float Distance = SceneDepth / ForwardDot;
+  if ((SceneDepth <= 0.0f) || (Distance >= Description.Range))
+  {
+    return false;
+  }
+
+  // reconstruct the impact point and convert it exactly like the CPU path
+  const FVector LidarBodyLoc = GetActorLocation();
+  const FRotator LidarBodyRot = GetActorRotation();
+  const FRotator LaserRot(VerticalAngle, HorizontalAngle, 0);
+  const FRotator ResultRot = UKismetMathLibrary::ComposeRotators(LaserRot, LidarBodyRot);
+  const FVector ImpactPoint =
+      Distance * UKismetMathLibrary::GetForwardVector(ResultRot) + LidarBodyLoc;
+
+  if (Description.ShowDebugPoints)
+  {
+    DrawDebugPoint(GetWorld(), ImpactPoint, 10, FColor(255, 0, 255), false, 0.1);
+  }
+
+  XYZ = LidarBodyLoc - ImpactPoint;
+  XYZ = UKismetMathLibrary::RotateAngleAxis(
+    XYZ,
+    - LidarBodyRot.Yaw + 90,
+    FVector(0, 0, 1)
+  );
+
+  return true;
+}
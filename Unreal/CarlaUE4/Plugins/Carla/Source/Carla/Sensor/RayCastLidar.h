@@ -17,7 +17,14 @@
 
 #include "RayCastLidar.generated.h"
 
+class USceneCaptureComponent2D;
+class UTextureRenderTarget2D;
+
 /// A ray-cast based Lidar sensor.
+///
+/// In GPU mode the points are sampled from a panorama of rasterized scene
+/// depth captures instead of shooting one physics line trace per point,
+/// trading per-point trace cost for four small render passes per frame.
 UCLASS()
 class CARLA_API ARayCastLidar : public ASensor
 {
@@ -37,6 +44,8 @@ public:
 
 protected:
 
+  virtual void BeginPlay() override;
+
   virtual void Tick(float DeltaTime) override;
 
 private:
@@ -47,8 +56,23 @@ private:
   /// Updates LidarMeasurement with the points read in DeltaTime.
   void ReadPoints(float DeltaTime);
 
-  /// Shoot a laser ray-trace, return whether the laser hit something.
-  bool ShootLaser(uint32 Channel, float HorizontalAngle, FVector &Point) const;
+  /// Send the points accumulated for the current sector and clear the
+  /// sector buffers; only used in sector streaming mode.
+  void SendSector();
+
+  /// Shoot a laser ray-trace, return whether the laser hit something. In
+  /// semantic mode @a Tag receives the tag of the hit component.
+  bool ShootLaser(uint32 Channel, float HorizontalAngle, FVector &Point, uint8 &Tag) const;
+
+  /// Create the four depth capture faces of the GPU mode panorama.
+  void SetUpDepthCaptures();
+
+  /// Copy the depth maps rendered by the capture faces to the CPU.
+  void ReadDepthCaptures();
+
+  /// Sample the depth panorama along a laser, return whether it hit
+  /// something within range.
+  bool SampleDepthCaptures(uint32 Channel, float HorizontalAngle, FVector &Point) const;
 
   UPROPERTY(EditAnywhere)
   FLidarDescription Description;
@@ -56,4 +80,28 @@ private:
   TArray<float> LaserAngles;
 
   FLidarMeasurement LidarMeasurement;
+
+  /// Points of the sector under scan, one buffer per channel so the sector
+  /// measurement comes out sorted by channel; only used in sector streaming
+  /// mode, where a sector can span several ticks.
+  TArray<TArray<FVector>> SectorPoints;
+
+  TArray<TArray<uint8>> SectorTags;
+
+  /// Sector the scan angle is currently inside.
+  uint32 CurrentSector = 0u;
+
+  /// Counts completed revolutions, so the client can reassemble sectors.
+  uint32 RevolutionId = 0u;
+
+  /// One 90-degree scene depth capture per quadrant, attached to the
+  /// sensor so they rotate with it; only used in GPU mode.
+  UPROPERTY()
+  TArray<USceneCaptureComponent2D *> DepthCaptureFaces;
+
+  UPROPERTY()
+  TArray<UTextureRenderTarget2D *> DepthCaptureTargets;
+
+  /// CPU copies of the face depth maps, refreshed every tick.
+  TArray<TArray<FFloat16Color>> DepthCaptureBuffers;
 };
@@ -37,6 +37,65 @@ namespace SceneCaptureSensor_local_ns {
     return Settings->GetQualityLevel();
   }
 
+  /// Pool of render targets shared by all the scene capture sensors, so that
+  /// a camera spawning with the resolution of a previously destroyed one
+  /// reuses its GPU allocation instead of creating and initializing a new
+  /// texture.
+  class FCaptureRenderTargetPool
+  {
+  public:
+
+    static FCaptureRenderTargetPool &Get()
+    {
+      static FCaptureRenderTargetPool Pool;
+      return Pool;
+    }
+
+    UTextureRenderTarget2D *Acquire(uint32 Width, uint32 Height, bool bForceLinearGamma)
+    {
+      auto *FreeList = FreeTargets.Find(MakeKey(Width, Height, bForceLinearGamma));
+      if ((FreeList != nullptr) && (FreeList->Num() > 0))
+      {
+        return FreeList->Pop();
+      }
+      auto *Target = NewObject<UTextureRenderTarget2D>(
+          GetTransientPackage(),
+          FName(*FString::Printf(TEXT("PooledCaptureRenderTarget_%d"), NumCreated++)));
+      Target->CompressionSettings = TextureCompressionSettings::TC_Default;
+      Target->SRGB = false;
+      Target->bAutoGenerateMips = false;
+      Target->AddressX = TextureAddress::TA_Clamp;
+      Target->AddressY = TextureAddress::TA_Clamp;
+      Target->InitCustomFormat(Width, Height, PF_B8G8R8A8, bForceLinearGamma);
+      // The pool outlives the sensors, keep the targets away from the
+      // garbage collector while they sit in the free lists.
+      Target->AddToRoot();
+      return Target;
+    }
+
+    void Release(UTextureRenderTarget2D *Target)
+    {
+      if (Target != nullptr)
+      {
+        FreeTargets.FindOrAdd(
+            MakeKey(Target->SizeX, Target->SizeY, Target->bForceLinearGamma)).Push(Target);
+      }
+    }
+
+  private:
+
+    static uint64 MakeKey(uint32 Width, uint32 Height, bool bForceLinearGamma)
+    {
+      return (static_cast<uint64>(Width) << 33) |
+          (static_cast<uint64>(Height) << 1) |
+          (bForceLinearGamma ? 1u : 0u);
+    }
+
+    TMap<uint64, TArray<UTextureRenderTarget2D *>> FreeTargets;
+
+    uint32 NumCreated = 0u;
+  };
+
 } // namespace SceneCaptureSensor_local_ns
 
 // =============================================================================
@@ -49,13 +108,8 @@ ASceneCaptureSensor::ASceneCaptureSensor(const FObjectInitializer &ObjectInitial
   PrimaryActorTick.bCanEverTick = true;
   PrimaryActorTick.TickGroup = TG_PrePhysics;
 
-  CaptureRenderTarget = CreateDefaultSubobject<UTextureRenderTarget2D>(
-      FName(*FString::Printf(TEXT("CaptureRenderTarget_d%d"), SCENE_CAPTURE_COUNTER)));
-  CaptureRenderTarget->CompressionSettings = TextureCompressionSettings::TC_Default;
-  CaptureRenderTarget->SRGB = false;
-  CaptureRenderTarget->bAutoGenerateMips = false;
-  CaptureRenderTarget->AddressX = TextureAddress::TA_Clamp;
-  CaptureRenderTarget->AddressY = TextureAddress::TA_Clamp;
+  // The render target is acquired from the shared pool at BeginPlay, once
+  // the image size is known.
 
   CaptureComponent2D = CreateDefaultSubobject<USceneCaptureComponent2D>(
       FName(*FString::Printf(TEXT("SceneCaptureComponent2D_%d"), SCENE_CAPTURE_COUNTER)));
@@ -78,6 +132,34 @@ void ASceneCaptureSensor::SetImageSize(uint32 InWidth, uint32 InHeight)
   ImageHeight = InHeight;
 }
 
+void ASceneCaptureSensor::SetROI(uint32 OffsetX, uint32 OffsetY, uint32 Width, uint32 Height)
+{
+  if ((Width == 0u) || (Height == 0u))
+  {
+    ROIOffsetX = 0u;
+    ROIOffsetY = 0u;
+    ROIWidth = 0u;
+    ROIHeight = 0u;
+    return;
+  }
+  ROIOffsetX = FMath::Min(OffsetX, ImageWidth - 1u);
+  ROIOffsetY = FMath::Min(OffsetY, ImageHeight - 1u);
+  ROIWidth = FMath::Min(Width, ImageWidth - ROIOffsetX);
+  ROIHeight = FMath::Min(Height, ImageHeight - ROIOffsetY);
+  if ((ROIOffsetX != OffsetX) || (ROIOffsetY != OffsetY) ||
+      (ROIWidth != Width) || (ROIHeight != Height))
+  {
+    UE_LOG(
+        LogCarla,
+        Warning,
+        TEXT("ASceneCaptureSensor: ROI clamped to %dx%d+%d+%d"),
+        ROIWidth,
+        ROIHeight,
+        ROIOffsetX,
+        ROIOffsetY);
+  }
+}
+
 void ASceneCaptureSensor::SetFOVAngle(const float FOVAngle)
 {
   check(CaptureComponent2D != nullptr);
@@ -424,12 +506,11 @@ void ASceneCaptureSensor::BeginPlay()
 
   const bool bInForceLinearGamma = !bEnablePostProcessingEffects;
 
-  CaptureRenderTarget->InitCustomFormat(ImageWidth, ImageHeight, PF_B8G8R8A8, bInForceLinearGamma);
+  CaptureRenderTarget = FCaptureRenderTargetPool::Get().Acquire(
+      ImageWidth, ImageHeight, bInForceLinearGamma);
 
-  if (bEnablePostProcessingEffects)
-  {
-    CaptureRenderTarget->TargetGamma = TargetGamma;
-  }
+  // Reused targets may carry the gamma of a previous owner.
+  CaptureRenderTarget->TargetGamma = bEnablePostProcessingEffects ? TargetGamma : 0.0f;
 
   check(IsValid(CaptureComponent2D) && !CaptureComponent2D->IsPendingKill());
 
@@ -471,6 +552,16 @@ void ASceneCaptureSensor::BeginPlay()
 void ASceneCaptureSensor::Tick(float DeltaTime)
 {
   Super::Tick(DeltaTime);
+  // Capture scheduler: skip the GPU capture entirely for frames no client
+  // will consume, either because nobody is subscribed to the stream, or
+  // because the previous frame is still parked in the outgoing queue and a
+  // keep-latest client would discard this one anyway.
+  bCaptureScheduledThisFrame = IsStreamReadyForNextMessage();
+  CaptureComponent2D->bCaptureEveryFrame = bCaptureScheduledThisFrame;
+  if (!bCaptureScheduledThisFrame)
+  {
+    return;
+  }
   // Add the view information every tick. Its only used for one tick and then
   // removed by the streamer.
   IStreamingManager::Get().AddViewInformation(
@@ -482,6 +573,15 @@ void ASceneCaptureSensor::Tick(float DeltaTime)
 void ASceneCaptureSensor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
   Super::EndPlay(EndPlayReason);
+  // release the staging textures of the asynchronous pixel readback
+  FPixelReader::InvalidateReadback(this);
+  // return the render target to the shared pool
+  if (CaptureComponent2D != nullptr)
+  {
+    CaptureComponent2D->TextureTarget = nullptr;
+  }
+  SceneCaptureSensor_local_ns::FCaptureRenderTargetPool::Get().Release(CaptureRenderTarget);
+  CaptureRenderTarget = nullptr;
   SCENE_CAPTURE_COUNTER = 0u;
 }
 
@@ -49,6 +49,52 @@ public:
     return ImageHeight;
   }
 
+  /// Restrict the data stream to a region of interest of the frame. The
+  /// full frame is still rendered, but only the requested rows and columns
+  /// are copied into the outgoing buffer. A zero @a Width or @a Height
+  /// disables the cropping.
+  UFUNCTION(BlueprintCallable)
+  void SetROI(uint32 OffsetX, uint32 OffsetY, uint32 Width, uint32 Height);
+
+  bool IsROIEnabled() const
+  {
+    return (ROIWidth > 0u) && (ROIHeight > 0u);
+  }
+
+  uint32 GetROIOffsetX() const
+  {
+    return ROIOffsetX;
+  }
+
+  uint32 GetROIOffsetY() const
+  {
+    return ROIOffsetY;
+  }
+
+  /// Width in pixels of the streamed image, i.e. of the region of interest
+  /// if one is set, of the full frame otherwise.
+  uint32 GetROIWidth() const
+  {
+    return IsROIEnabled() ? ROIWidth : ImageWidth;
+  }
+
+  /// Height in pixels of the streamed image.
+  uint32 GetROIHeight() const
+  {
+    return IsROIEnabled() ? ROIHeight : ImageHeight;
+  }
+
+  /// Region of the render target to be copied into the data stream, in
+  /// pixels of the full frame.
+  FIntRect GetCaptureROI() const
+  {
+    return FIntRect(
+        ROIOffsetX,
+        ROIOffsetY,
+        ROIOffsetX + GetROIWidth(),
+        ROIOffsetY + GetROIHeight());
+  }
+
   UFUNCTION(BlueprintCallable)
   void EnablePostProcessingEffects(bool Enable = true)
   {
@@ -241,6 +287,14 @@ public:
   UFUNCTION(BlueprintCallable)
   float GetChromAberrOffset() const;
 
+  /// Whether the capture scheduler decided to render this frame. When false
+  /// no client would consume the image and both the scene capture and the
+  /// pixel readback are skipped.
+  bool IsCaptureScheduledThisFrame() const
+  {
+    return bCaptureScheduledThisFrame;
+  }
+
   /// Use for debugging purposes only.
   UFUNCTION(BlueprintCallable)
   bool ReadPixels(TArray<FColor> &BitMap) const
@@ -277,6 +331,22 @@ private:
   UPROPERTY(EditAnywhere)
   uint32 ImageHeight = 600u;
 
+  /// Left column of the streamed region of interest.
+  UPROPERTY(EditAnywhere)
+  uint32 ROIOffsetX = 0u;
+
+  /// Top row of the streamed region of interest.
+  UPROPERTY(EditAnywhere)
+  uint32 ROIOffsetY = 0u;
+
+  /// Width of the streamed region of interest, zero streams the full frame.
+  UPROPERTY(EditAnywhere)
+  uint32 ROIWidth = 0u;
+
+  /// Height of the streamed region of interest, zero streams the full frame.
+  UPROPERTY(EditAnywhere)
+  uint32 ROIHeight = 0u;
+
   /// Whether to render the post-processing effects present in the scene.
   UPROPERTY(EditAnywhere)
   bool bEnablePostProcessingEffects = true;
@@ -284,7 +354,11 @@ private:
   UPROPERTY(EditAnywhere)
   float TargetGamma = 2.2f;
 
-  /// Render target necessary for scene capture.
+  /// Set every tick by the capture scheduler, see Tick.
+  bool bCaptureScheduledThisFrame = true;
+
+  /// Render target necessary for scene capture, acquired from the shared
+  /// pool at BeginPlay and returned at EndPlay.
   UPROPERTY(EditAnywhere)
   UTextureRenderTarget2D *CaptureRenderTarget = nullptr;
 
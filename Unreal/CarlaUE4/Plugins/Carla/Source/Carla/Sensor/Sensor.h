@@ -84,6 +84,13 @@ protected:
     return Stream.MakeAsyncDataStream(Self, GetEpisode().GetElapsedGameTime());
   }
 
+  /// Whether a measurement sent down the stream now would be consumed by a
+  /// client rather than discarded by the stream's queue.
+  bool IsStreamReadyForNextMessage() const
+  {
+    return Stream.IsReadyForNextMessage();
+  }
+
   /// Seed of the pseudo-random engine.
   UPROPERTY(Category = "Random Engine", EditAnywhere)
   int32 Seed = 123456789;
@@ -9,6 +9,49 @@
 
 #include "ConstructorHelpers.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace {
+
+  /// Material instances of one shader chain, kept alive so every sensor with
+  /// an identical chain can blend the same instances.
+  struct FSharedShaderChain
+  {
+    TArray<TStrongObjectPtr<UMaterialInstanceDynamic>> Instances;
+  };
+
+  /// Fused materials registered per chain, keyed by the chain's material
+  /// paths joined with '|'. Prepopulated with the chains of the stock
+  /// sensors; entries whose fused asset is not present in the content fall
+  /// back to the sequential chain when the sensor is set up.
+  TMap<FString, FString> &GetFusedChainRegistry()
+  {
+    static TMap<FString, FString> Registry = []() {
+      TMap<FString, FString> Map;
+      const FString LensDistortion =
+          TEXT("Material'/Carla/PostProcessingMaterials/PhysicLensDistortion.PhysicLensDistortion'");
+      Map.Add(
+          LensDistortion + TEXT("|") +
+          TEXT("Material'/Carla/PostProcessingMaterials/DepthEffectMaterial.DepthEffectMaterial'"),
+          TEXT("/Carla/PostProcessingMaterials/DepthEffectWithLensDistortion.DepthEffectWithLensDistortion"));
+      Map.Add(
+          LensDistortion + TEXT("|") +
+          TEXT("Material'/Carla/PostProcessingMaterials/DepthEffectMaterial_GLSL.DepthEffectMaterial_GLSL'"),
+          TEXT("/Carla/PostProcessingMaterials/DepthEffectWithLensDistortion_GLSL.DepthEffectWithLensDistortion_GLSL"));
+      Map.Add(
+          LensDistortion + TEXT("|") +
+          TEXT("Material'/Carla/PostProcessingMaterials/GTMaterial.GTMaterial'"),
+          TEXT("/Carla/PostProcessingMaterials/GTMaterialWithLensDistortion.GTMaterialWithLensDistortion"));
+      return Map;
+    }();
+    return Registry;
+  }
+
+  /// Chains already instanced, keyed by material paths plus parameter values.
+  TMap<FString, FSharedShaderChain> GSharedShaderChains;
+
+} // namespace
 
 bool AShaderBasedSensor::AddPostProcessingMaterial(const FString &Path)
 {
@@ -16,12 +59,101 @@ bool AShaderBasedSensor::AddPostProcessingMaterial(const FString &Path)
   if (Loader.Succeeded())
   {
     MaterialsFound.Add(Loader.Object);
+    MaterialPathsFound.Add(Path);
   }
   return Loader.Succeeded();
 }
 
+void AShaderBasedSensor::RegisterFusedShaderChain(
+    const TArray<FString> &ChainPaths,
+    const FString &FusedMaterialPath)
+{
+  GetFusedChainRegistry().Add(FString::Join(ChainPaths, TEXT("|")), FusedMaterialPath);
+}
+
+bool AShaderBasedSensor::SetUpSharedShaderChain(USceneCaptureComponent2D &SceneCapture)
+{
+  const FString ChainKey = FString::Join(MaterialPathsFound, TEXT("|"));
+
+  // identical chains are identical materials with identical parameter values
+  FString Signature = ChainKey;
+  for (const auto &ParameterValue : FloatShaderParams)
+  {
+    Signature += FString::Printf(
+        TEXT("|%d:%s=%f"),
+        ParameterValue.ShaderIndex,
+        *ParameterValue.ParameterName.ToString(),
+        ParameterValue.Value);
+  }
+
+  if (const FSharedShaderChain *Shared = GSharedShaderChains.Find(Signature))
+  {
+    for (const auto &Instance : Shared->Instances)
+    {
+      SceneCapture.PostProcessSettings.AddBlendable(Instance.Get(), 1.0f);
+    }
+    return true;
+  }
+
+  FSharedShaderChain Chain;
+
+  // a fused material collapses the whole chain into one full-screen pass
+  if (const FString *FusedPath = GetFusedChainRegistry().Find(ChainKey))
+  {
+    UMaterial *FusedMaterial = LoadObject<UMaterial>(nullptr, **FusedPath);
+    if (FusedMaterial != nullptr)
+    {
+      auto *Instance = UMaterialInstanceDynamic::Create(FusedMaterial, GetTransientPackage());
+      // the fused material exposes the parameters of every stage, apply them
+      // all to the single pass
+      for (const auto &ParameterValue : FloatShaderParams)
+      {
+        Instance->SetScalarParameterValue(ParameterValue.ParameterName, ParameterValue.Value);
+      }
+      Chain.Instances.Emplace(Instance);
+    }
+  }
+
+  if (Chain.Instances.Num() == 0)
+  {
+    // no fused material for this chain, share the sequential passes instead
+    for (auto *MaterialFound : MaterialsFound)
+    {
+      Chain.Instances.Emplace(
+          UMaterialInstanceDynamic::Create(MaterialFound, GetTransientPackage()));
+    }
+    for (const auto &ParameterValue : FloatShaderParams)
+    {
+      if (Chain.Instances.IsValidIndex(ParameterValue.ShaderIndex))
+      {
+        Chain.Instances[ParameterValue.ShaderIndex]->SetScalarParameterValue(
+            ParameterValue.ParameterName,
+            ParameterValue.Value);
+      }
+    }
+  }
+
+  for (const auto &Instance : Chain.Instances)
+  {
+    SceneCapture.PostProcessSettings.AddBlendable(Instance.Get(), 1.0f);
+  }
+  GSharedShaderChains.Add(Signature, MoveTemp(Chain));
+  return true;
+}
+
 void AShaderBasedSensor::SetUpSceneCaptureComponent(USceneCaptureComponent2D &SceneCapture)
 {
+  // only chains built exclusively with AddPostProcessingMaterial are eligible
+  // for fusion and sharing, sensors with externally added shaders keep their
+  // private instances
+  if (Shaders.Num() == 0 && MaterialsFound.Num() > 0)
+  {
+    if (SetUpSharedShaderChain(SceneCapture))
+    {
+      return;
+    }
+  }
+
   for (const auto &MaterialFound : MaterialsFound)
   {
     // Create a dynamic instance of the Material (Shader)
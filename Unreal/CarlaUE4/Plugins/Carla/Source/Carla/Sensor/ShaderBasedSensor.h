@@ -43,6 +43,11 @@ struct CARLA_API FSensorShader
 /// A sensor that produces data by applying post-process materials (shaders) to
 /// a scene capture image.
 ///
+/// Chains added with AddPostProcessingMaterial can be collapsed into a single
+/// full-screen pass when a fused material has been registered for them (see
+/// RegisterFusedShaderChain), and sensors whose chain and shader parameters
+/// are identical share the same material instances.
+///
 /// @warning Shaders must be added before BeginPlay.
 UCLASS(Abstract)
 class CARLA_API AShaderBasedSensor : public ASceneCaptureSensor
@@ -76,15 +81,32 @@ public:
 
   void SetFloatShaderParameter(uint8_t ShaderIndex, const FName &ParameterName, float Value);
 
+  /// Register a pre-authored material implementing the combined logic of the
+  /// whole post-process chain @a ChainPaths in one pass. Sensors whose chain
+  /// matches exactly apply the fused material as their only blendable, and
+  /// their float shader parameters are applied to it (the fused material must
+  /// expose the parameters of every stage). Chains whose fused material asset
+  /// cannot be loaded fall back to the sequential passes.
+  static void RegisterFusedShaderChain(const TArray<FString> &ChainPaths, const FString &FusedMaterialPath);
+
 protected:
 
   void SetUpSceneCaptureComponent(USceneCaptureComponent2D &SceneCapture) override;
 
 private:
 
+  /// Attach the fused or shared material instances of this sensor's chain,
+  /// creating and caching them if no identical chain exists yet. Only chains
+  /// built exclusively with AddPostProcessingMaterial are eligible.
+  bool SetUpSharedShaderChain(USceneCaptureComponent2D &SceneCapture);
+
   UPROPERTY()
   TArray<UMaterial*> MaterialsFound;
 
+  /// Asset paths of MaterialsFound, they key the fused and shared chains.
+  UPROPERTY()
+  TArray<FString> MaterialPathsFound;
+
   UPROPERTY()
   TArray<FSensorShader> Shaders;
 
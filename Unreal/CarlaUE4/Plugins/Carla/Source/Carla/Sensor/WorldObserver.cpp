@@ -15,6 +15,7 @@
 #include "Carla/Traffic/SignComponent.h"
 #include "Carla/Walker/WalkerController.h"
 
+#include "Components/SceneComponent.h"
 #include "CoreGlobals.h"
 
 #include <compiler/disable-ue4-macros.h>
@@ -23,6 +24,66 @@
 #include <carla/sensor/data/ActorDynamicState.h>
 #include <compiler/enable-ue4-macros.h>
 
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+FActorStateMirror::~FActorStateMirror()
+{
+  for (auto &Info : Infos)
+  {
+    if (Info.Root.IsValid())
+    {
+      Info.Root->TransformUpdated.Remove(Info.MovedHandle);
+    }
+  }
+}
+
+size_t FActorStateMirror::AddRow(carla::rpc::ActorId Id, USceneComponent *RootComponent)
+{
+  const size_t Index = Rows.size();
+  carla::sensor::data::ActorDynamicState Row{};
+  Row.id = Id;
+  Rows.emplace_back(Row);
+  FInfo Info;
+  if (RootComponent != nullptr)
+  {
+    Info.Root = RootComponent;
+    Info.MovedHandle = RootComponent->TransformUpdated.AddLambda(
+        [this, Id](USceneComponent *, EUpdateTransformFlags, ETeleportType)
+        {
+          auto it = IndexById.find(Id);
+          if (it != IndexById.end())
+          {
+            Infos[it->second].bDirty = true;
+          }
+        });
+  }
+  Infos.emplace_back(std::move(Info));
+  IndexById.emplace(Id, Index);
+  return Index;
+}
+
+void FActorStateMirror::RemoveRow(size_t Index)
+{
+  auto &Info = Infos[Index];
+  if (Info.Root.IsValid())
+  {
+    Info.Root->TransformUpdated.Remove(Info.MovedHandle);
+  }
+  IndexById.erase(Rows[Index].id);
+  const size_t Last = Rows.size() - 1u;
+  if (Index != Last)
+  {
+    Rows[Index] = Rows[Last];
+    Infos[Index] = std::move(Infos[Last]);
+    IndexById[Rows[Index].id] = Index;
+  }
+  Rows.pop_back();
+  Infos.pop_back();
+}
+
 static auto FWorldObserver_GetActorState(const FActorView &View, const FActorRegistry &Registry)
 {
   using AType = FActorView::ActorType;
@@ -65,90 +126,116 @@ static auto FWorldObserver_GetActorState(const FActorView &View, const FActorReg
       state.walker_control = carla::rpc::WalkerControl{Controller->GetWalkerControl()};
     }
   }
-  else if (AType::TrafficLight == View.GetActorType())
+  return state;
+}
+
+/// Write the sign id of @a SignComponent into the fixed-size field at
+/// @a dst, truncating and warning when it does not fit.
+static void FWorldObserver_WriteSignId(const USignComponent &SignComponent, char *dst, size_t max_size)
+{
+  const FString fstring_sign_id = SignComponent.GetSignId();
+  const std::string sign_id = carla::rpc::FromFString(fstring_sign_id);
+  size_t sign_id_length = sign_id.length();
+  if(max_size < sign_id_length)
   {
-    auto TrafficLight = Cast<ATrafficLightBase>(View.GetActor());
-    if (TrafficLight != nullptr)
-    {
-      UTrafficLightComponent* TrafficLightComponent =
-        Cast<UTrafficLightComponent>(TrafficLight->FindComponentByClass<UTrafficLightComponent>());
+    UE_LOG(LogCarla, Warning, TEXT("The max size of a signal id is 32. %s (%d)"), *fstring_sign_id, sign_id.length());
+    sign_id_length = max_size;
+  }
+  std::memset(dst, '\0', max_size);
+  std::memcpy(dst, sign_id.c_str(), sign_id_length);
+}
 
-      using TLS = carla::rpc::TrafficLightState;
+static void FWorldObserver_RefreshTrafficLightState(
+    const FActorView &View,
+    FActorStateMirror::FInfo &Info,
+    carla::sensor::data::ActorDynamicState &Row)
+{
+  auto TrafficLight = Cast<ATrafficLightBase>(View.GetActor());
+  if (TrafficLight == nullptr)
+  {
+    return;
+  }
 
-      if(TrafficLightComponent == nullptr)
-      {
-        // Old way: traffic lights are actors
-        state.traffic_light_data.sign_id[0] = '\0';
-        state.traffic_light_data.state = static_cast<TLS>(TrafficLight->GetTrafficLightState());
-        state.traffic_light_data.green_time = TrafficLight->GetGreenTime();
-        state.traffic_light_data.yellow_time = TrafficLight->GetYellowTime();
-        state.traffic_light_data.red_time = TrafficLight->GetRedTime();
-        state.traffic_light_data.elapsed_time = TrafficLight->GetElapsedTime();
-        state.traffic_light_data.time_is_frozen = TrafficLight->GetTimeIsFrozen();
-        state.traffic_light_data.pole_index = TrafficLight->GetPoleIndex();
-      }
-      else
-      {
-        UTrafficLightController* Controller =  TrafficLightComponent->GetController();
-        ATrafficLightGroup* Group = TrafficLightComponent->GetGroup();
+  using TLS = carla::rpc::TrafficLightState;
+  auto &Data = Row.state.traffic_light_data;
 
-        if (!Controller)
-        {
-          UE_LOG(LogCarla, Error, TEXT("TrafficLightComponent doesn't have any Controller assigned"));
-        }
-        else if (!Group)
-        {
-          UE_LOG(LogCarla, Error, TEXT("TrafficLightComponent doesn't have any Group assigned"));
-        }
-        else
-        {
-          const FString fstring_sign_id = TrafficLightComponent->GetSignId();
-          const std::string sign_id = carla::rpc::FromFString(fstring_sign_id);
-          constexpr size_t max_size = sizeof(state.traffic_light_data.sign_id);
-          size_t sign_id_length = sign_id.length();
-          if(max_size < sign_id_length)
-          {
-            UE_LOG(LogCarla, Warning, TEXT("The max size of a signal id is 32. %s (%d)"), *fstring_sign_id, sign_id.length());
-            sign_id_length = max_size;
-          }
-          std::memset(state.traffic_light_data.sign_id, '\0', max_size);
-          std::memcpy(state.traffic_light_data.sign_id, sign_id.c_str(), sign_id_length);
-          state.traffic_light_data.state = static_cast<TLS>(TrafficLightComponent->GetLightState());
-          state.traffic_light_data.green_time = Controller->GetGreenTime();
-          state.traffic_light_data.yellow_time = Controller->GetYellowTime();
-          state.traffic_light_data.red_time = Controller->GetRedTime();
-          state.traffic_light_data.elapsed_time = Group->GetElapsedTime();
-          state.traffic_light_data.time_is_frozen = Group->IsFrozen();
-          state.traffic_light_data.pole_index = TrafficLight->GetPoleIndex();
-        }
-      }
+  // Resolve the component and convert the sign id only once, they never
+  // change over the life of the light.
+  if (!Info.bSignComponentCached)
+  {
+    auto *Component = TrafficLight->FindComponentByClass<UTrafficLightComponent>();
+    Info.SignComponent = Component;
+    Info.bSignComponentCached = true;
+    if (Component != nullptr)
+    {
+      FWorldObserver_WriteSignId(*Component, Data.sign_id, sizeof(Data.sign_id));
+    }
+    else
+    {
+      // Old way: traffic lights are actors
+      Data.sign_id[0] = '\0';
     }
   }
-  else if (AType::TrafficSign == View.GetActorType())
+
+  auto *TrafficLightComponent = Cast<UTrafficLightComponent>(Info.SignComponent.Get());
+  if (TrafficLightComponent == nullptr)
   {
-    auto TrafficSign = Cast<ATrafficSignBase>(View.GetActor());
-    if (TrafficSign != nullptr)
-    {
-      USignComponent* TrafficSignComponent =
-        Cast<USignComponent>(TrafficSign->FindComponentByClass<USignComponent>());
+    Data.state = static_cast<TLS>(TrafficLight->GetTrafficLightState());
+    Data.green_time = TrafficLight->GetGreenTime();
+    Data.yellow_time = TrafficLight->GetYellowTime();
+    Data.red_time = TrafficLight->GetRedTime();
+    Data.elapsed_time = TrafficLight->GetElapsedTime();
+    Data.time_is_frozen = TrafficLight->GetTimeIsFrozen();
+    Data.pole_index = TrafficLight->GetPoleIndex();
+    return;
+  }
 
-      if(TrafficSignComponent)
-      {
-        const FString fstring_sign_id = TrafficSignComponent->GetSignId();
-        const std::string sign_id = carla::rpc::FromFString(fstring_sign_id);
-        constexpr size_t max_size = sizeof(state.traffic_sign_data.sign_id);
-        size_t sign_id_length = sign_id.length();
-        if(max_size < sign_id_length)
-        {
-          UE_LOG(LogCarla, Warning, TEXT("The max size of a signal id is 32. %s (%d)"), *fstring_sign_id, sign_id.length());
-          sign_id_length = max_size;
-        }
-        std::memset(state.traffic_light_data.sign_id, '\0', max_size);
-        std::memcpy(state.traffic_sign_data.sign_id, sign_id.c_str(), sign_id_length);
-      }
-    }
+  UTrafficLightController* Controller = TrafficLightComponent->GetController();
+  ATrafficLightGroup* Group = TrafficLightComponent->GetGroup();
+
+  if (!Controller)
+  {
+    UE_LOG(LogCarla, Error, TEXT("TrafficLightComponent doesn't have any Controller assigned"));
+  }
+  else if (!Group)
+  {
+    UE_LOG(LogCarla, Error, TEXT("TrafficLightComponent doesn't have any Group assigned"));
+  }
+  else
+  {
+    Data.state = static_cast<TLS>(TrafficLightComponent->GetLightState());
+    Data.green_time = Controller->GetGreenTime();
+    Data.yellow_time = Controller->GetYellowTime();
+    Data.red_time = Controller->GetRedTime();
+    Data.elapsed_time = Group->GetElapsedTime();
+    Data.time_is_frozen = Group->IsFrozen();
+    Data.pole_index = TrafficLight->GetPoleIndex();
+  }
+}
+
+static void FWorldObserver_RefreshTrafficSignState(
+    const FActorView &View,
+    FActorStateMirror::FInfo &Info,
+    carla::sensor::data::ActorDynamicState &Row)
+{
+  // Sign state is fully static, it is written once when the row is created.
+  if (Info.bSignComponentCached)
+  {
+    return;
+  }
+  auto TrafficSign = Cast<ATrafficSignBase>(View.GetActor());
+  if (TrafficSign == nullptr)
+  {
+    return;
+  }
+  auto *SignComponent = TrafficSign->FindComponentByClass<USignComponent>();
+  Info.SignComponent = SignComponent;
+  Info.bSignComponentCached = true;
+  if (SignComponent != nullptr)
+  {
+    auto &Data = Row.state.traffic_sign_data;
+    FWorldObserver_WriteSignId(*SignComponent, Data.sign_id, sizeof(Data.sign_id));
   }
-  return state;
 }
 
 static carla::geom::Vector3D FWorldObserver_GetAngularVelocity(const AActor &Actor)
@@ -172,22 +259,146 @@ static carla::geom::Vector3D FWorldObserver_GetAcceleration(
   return {Acceleration.X, Acceleration.Y, Acceleration.Z};
 }
 
-static carla::Buffer FWorldObserver_Serialize(
-    carla::Buffer &&buffer,
+static uint8_t FWorldObserver_GetChangedFields(
+    const carla::sensor::data::ActorDynamicState &current,
+    const carla::sensor::data::ActorDynamicState &keyframe)
+{
+  using Serializer = carla::sensor::s11n::EpisodeStateSerializer;
+
+  auto differs = [](const auto &lhs, const auto &rhs)
+  {
+    return std::memcmp(&lhs, &rhs, sizeof(lhs)) != 0;
+  };
+
+  uint8_t mask = 0u;
+  mask |= differs(current.transform, keyframe.transform) * Serializer::TransformField;
+  mask |= differs(current.velocity, keyframe.velocity) * Serializer::VelocityField;
+  mask |= differs(current.angular_velocity, keyframe.angular_velocity) * Serializer::AngularVelocityField;
+  mask |= differs(current.acceleration, keyframe.acceleration) * Serializer::AccelerationField;
+  mask |= differs(current.state, keyframe.state) * Serializer::TypeDependentField;
+  return mask;
+}
+
+static const std::vector<carla::sensor::data::ActorDynamicState> &FWorldObserver_GatherActorStates(
     const UCarlaEpisode &Episode,
     float DeltaSeconds,
+    FActorStateMirror &Mirror)
+{
+  using AType = FActorView::ActorType;
+
+  const auto &Registry = Episode.GetActorRegistry();
+
+  ++Mirror.TickStamp;
+
+  for (auto &&View : Registry)
+  {
+    check(View.IsValid());
+    auto *Actor = View.GetActor();
+
+    size_t Index;
+    bool bFirstTime = false;
+    const auto it = Mirror.IndexById.find(View.GetActorId());
+    if (it != Mirror.IndexById.end())
+    {
+      Index = it->second;
+    }
+    else
+    {
+      Index = Mirror.AddRow(View.GetActorId(), Actor->GetRootComponent());
+      bFirstTime = true;
+    }
+    auto &Info = Mirror.Infos[Index];
+    auto &Row = Mirror.Rows[Index];
+    Info.LastSeenTick = Mirror.TickStamp;
+
+    // Movement-dependent fields, refreshed only for the rows flagged by a
+    // movement event since the last refresh.
+    if (bFirstTime || Info.bDirty)
+    {
+      constexpr float TO_METERS = 1e-2;
+      const auto Velocity = TO_METERS * Actor->GetVelocity();
+      Row.transform = Actor->GetActorTransform();
+      Row.velocity = carla::geom::Vector3D{Velocity.X, Velocity.Y, Velocity.Z};
+      Row.angular_velocity = FWorldObserver_GetAngularVelocity(*Actor);
+      Row.acceleration = FWorldObserver_GetAcceleration(View, Velocity, DeltaSeconds);
+      // Keep refreshing until the actor settles, coming to rest needs one
+      // more pass to zero the acceleration.
+      constexpr float AT_REST_EPSILON = 1e-8f;
+      Info.bDirty = (Row.velocity.SquaredLength() > AT_REST_EPSILON)
+          || (Row.angular_velocity.SquaredLength() > AT_REST_EPSILON)
+          || (Row.acceleration.SquaredLength() > AT_REST_EPSILON);
+    }
+
+    // Type-dependent state, can change without the actor moving.
+    switch (View.GetActorType())
+    {
+      case AType::Vehicle:
+      case AType::Walker:
+        Row.state = FWorldObserver_GetActorState(View, Registry);
+        break;
+      case AType::TrafficLight:
+        FWorldObserver_RefreshTrafficLightState(View, Info, Row);
+        break;
+      case AType::TrafficSign:
+        FWorldObserver_RefreshTrafficSignState(View, Info, Row);
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Prune the rows of actors no longer registered.
+  for (size_t i = 0u; i < Mirror.Infos.size(); /* no increment */)
+  {
+    if (Mirror.Infos[i].LastSeenTick != Mirror.TickStamp)
+    {
+      Mirror.RemoveRow(i);
+    }
+    else
+    {
+      ++i;
+    }
+  }
+
+  return Mirror.Rows;
+}
+
+static carla::Buffer FWorldObserver_Serialize(
+    carla::Buffer &&buffer,
+    carla::sensor::s11n::EpisodeStateSerializer::Header header,
     bool MapChange,
-    bool PendingLightUpdates)
+    const std::vector<carla::sensor::data::ActorDynamicState> &current_states,
+    std::unordered_map<carla::rpc::ActorId, carla::sensor::data::ActorDynamicState> &KeyframeStates,
+    uint32 &TicksSinceKeyframe,
+    const uint32 KeyframeInterval)
 {
 
   using Serializer = carla::sensor::s11n::EpisodeStateSerializer;
   using SimulationState = carla::sensor::s11n::EpisodeStateSerializer::SimulationState;
   using ActorDynamicState = carla::sensor::data::ActorDynamicState;
 
+  // Deltas only make sense against a keyframe with the same actor set.
+  bool ActorSetChanged = (current_states.size() != KeyframeStates.size());
+  if (!ActorSetChanged)
+  {
+    for (auto &info : current_states)
+    {
+      if (KeyframeStates.find(info.id) == KeyframeStates.end())
+      {
+        ActorSetChanged = true;
+        break;
+      }
+    }
+  }
 
-  const auto &Registry = Episode.GetActorRegistry();
+  const bool SendKeyframe =
+      MapChange ||
+      ActorSetChanged ||
+      (TicksSinceKeyframe >= KeyframeInterval);
 
-  auto total_size = sizeof(Serializer::Header) + sizeof(ActorDynamicState) * Registry.Num();
+  // Worst-case size, a delta is never bigger than a keyframe plus the masks.
+  auto total_size = sizeof(Serializer::Header) + sizeof(uint32_t) +
+      (sizeof(ActorDynamicState) + sizeof(uint8_t)) * current_states.size();
   auto current_size = 0;
   // Set up buffer for writing.
   buffer.reset(total_size);
@@ -198,35 +409,72 @@ static carla::Buffer FWorldObserver_Serialize(
     current_size += sizeof(data);
   };
 
-  // Write header.
-  Serializer::Header header;
-  header.episode_id = Episode.GetId();
-  header.platform_timestamp = FPlatformTime::Seconds();
-  header.delta_seconds = DeltaSeconds;
-
-  uint8_t simulation_state = (SimulationState::MapChange * MapChange);
-  simulation_state |= (SimulationState::PendingLightUpdate * PendingLightUpdates);
-
+  // Write header, built on the game thread, only the delta flag is decided
+  // here.
+  uint8_t simulation_state = static_cast<uint8_t>(header.simulation_state);
+  simulation_state |= (SimulationState::DeltaFrame * !SendKeyframe);
   header.simulation_state = static_cast<SimulationState>(simulation_state);
 
   write_data(header);
 
-  // Write every actor.
-  for (auto &&View : Registry)
+  if (SendKeyframe)
   {
-    check(View.IsValid());
-    constexpr float TO_METERS = 1e-2;
-    const auto Velocity = TO_METERS * View.GetActor()->GetVelocity();
-
-    ActorDynamicState info = {
-      View.GetActorId(),
-      View.GetActor()->GetActorTransform(),
-      carla::geom::Vector3D{Velocity.X, Velocity.Y, Velocity.Z},
-      FWorldObserver_GetAngularVelocity(*View.GetActor()),
-      FWorldObserver_GetAcceleration(View, Velocity, DeltaSeconds),
-      FWorldObserver_GetActorState(View, Registry),
-    };
-    write_data(info);
+    // The mirror rows already have the wire layout, a keyframe is a single
+    // memcpy of the whole array.
+    if (!current_states.empty())
+    {
+      const auto rows_size = sizeof(ActorDynamicState) * current_states.size();
+      std::memcpy(buffer.begin() + current_size, current_states.data(), rows_size);
+      current_size += rows_size;
+    }
+    // Remember every state for the deltas to come.
+    KeyframeStates.clear();
+    KeyframeStates.reserve(current_states.size());
+    for (auto &info : current_states)
+    {
+      KeyframeStates.emplace(info.id, info);
+    }
+    TicksSinceKeyframe = 0u;
+  }
+  else
+  {
+    // Write only the fields that changed since the keyframe.
+    const auto entry_count_offset = current_size;
+    uint32_t entry_count = 0u;
+    write_data(entry_count);
+    for (auto &info : current_states)
+    {
+      const auto mask = FWorldObserver_GetChangedFields(info, KeyframeStates[info.id]);
+      if (mask == 0u)
+      {
+        continue;
+      }
+      write_data(info.id);
+      write_data(mask);
+      if (mask & Serializer::TransformField)
+      {
+        write_data(info.transform);
+      }
+      if (mask & Serializer::VelocityField)
+      {
+        write_data(info.velocity);
+      }
+      if (mask & Serializer::AngularVelocityField)
+      {
+        write_data(info.angular_velocity);
+      }
+      if (mask & Serializer::AccelerationField)
+      {
+        write_data(info.acceleration);
+      }
+      if (mask & Serializer::TypeDependentField)
+      {
+        write_data(info.state);
+      }
+      ++entry_count;
+    }
+    std::memcpy(buffer.begin() + entry_count_offset, &entry_count, sizeof(entry_count));
+    ++TicksSinceKeyframe;
   }
 
   // Shrink buffer
@@ -243,14 +491,189 @@ void FWorldObserver::BroadcastTick(
     bool MapChange,
     bool PendingLightUpdates)
 {
+  using Serializer = carla::sensor::s11n::EpisodeStateSerializer;
+  using SimulationState = carla::sensor::s11n::EpisodeStateSerializer::SimulationState;
+
+  // Fence the serialization of the previous tick before touching the mirror
+  // again; the task has had a whole frame to finish, so this wait is
+  // normally zero.
+  WaitForSerialization();
+
   auto AsyncStream = Stream.MakeAsyncDataStream(*this, Episode.GetElapsedGameTime());
 
-  auto buffer = FWorldObserver_Serialize(
-      AsyncStream.PopBufferFromPool(),
-      Episode,
-      DeltaSecond,
-      MapChange,
-      PendingLightUpdates);
+  const auto &CurrentStates = FWorldObserver_GatherActorStates(Episode, DeltaSecond, Mirror);
+
+  // The filtered per-client views are sent from here, their subscriptions
+  // are registered from RPCs that also run on the game thread.
+  if (FilteredStreams != nullptr)
+  {
+    FilteredStreams->Broadcast(
+        *this,
+        Episode,
+        DeltaSecond,
+        MapChange,
+        PendingLightUpdates,
+        CurrentStates);
+  }
+
+  // Everything the serializer needs from the episode, read while still on
+  // the game thread.
+  Serializer::Header Header;
+  Header.episode_id = Episode.GetId();
+  Header.platform_timestamp = FPlatformTime::Seconds();
+  Header.delta_seconds = DeltaSecond;
+  uint8_t StateFlags = (SimulationState::MapChange * MapChange);
+  StateFlags |= (SimulationState::PendingLightUpdate * PendingLightUpdates);
+  Header.simulation_state = static_cast<SimulationState>(StateFlags);
+  Header.physics_control_revision = Episode.GetPhysicsControlRevision();
+
+  // Serialize and enqueue on a worker thread so this frame's state message
+  // overlaps with the simulation of the next frame; the mirror and the
+  // keyframe cache are not touched again until the fence above.
+  SerializeTask = Async(EAsyncExecution::TaskGraph,
+      [this, OutStream = std::move(AsyncStream), Header, MapChange]() mutable
+      {
+        const double StartSeconds = FPlatformTime::Seconds();
+
+        auto buffer = FWorldObserver_Serialize(
+            OutStream.PopBufferFromPool(),
+            Header,
+            MapChange,
+            Mirror.Rows,
+            KeyframeStates,
+            TicksSinceKeyframe,
+            KeyframeInterval);
 
-  AsyncStream.Send(*this, std::move(buffer));
+        OutStream.Send(*this, std::move(buffer));
+
+        LastSerializationSeconds.store(
+            FPlatformTime::Seconds() - StartSeconds,
+            std::memory_order_relaxed);
+      });
+}
+
+void FFilteredWorldStreams::Add(
+    FDataMultiStream Stream,
+    carla::rpc::EpisodeStreamFilter Filter)
+{
+  FSubscription Subscription;
+  Subscription.Stream = std::move(Stream);
+  Subscription.Filter = std::move(Filter);
+  Subscriptions.emplace_back(std::move(Subscription));
+}
+
+void FFilteredWorldStreams::Broadcast(
+    FWorldObserver &Observer,
+    const UCarlaEpisode &Episode,
+    float DeltaSeconds,
+    bool MapChange,
+    bool PendingLightUpdate,
+    const std::vector<carla::sensor::data::ActorDynamicState> &ActorStates)
+{
+  using Serializer = carla::sensor::s11n::EpisodeStateSerializer;
+  using SimulationState = carla::sensor::s11n::EpisodeStateSerializer::SimulationState;
+  using ActorDynamicState = carla::sensor::data::ActorDynamicState;
+
+  for (auto It = Subscriptions.begin(); It != Subscriptions.end(); /* no increment */)
+  {
+    auto &Subscription = *It;
+
+    // Drop the subscription once its client disconnected; before the first
+    // client arrives the stream is kept even though nobody listens yet.
+    if (!Subscription.Stream.IsListening())
+    {
+      if (Subscription.bEverListened)
+      {
+        It = Subscriptions.erase(It);
+        continue;
+      }
+    }
+    else
+    {
+      Subscription.bEverListened = true;
+    }
+
+    const auto &Filter = Subscription.Filter;
+    const uint32 Divisor = std::max(1u, Filter.rate_divisor);
+    if ((Subscription.TickCounter++ % Divisor) != 0u)
+    {
+      ++It;
+      continue;
+    }
+
+    // Resolve the reference actor of the spatial filter on this tick's
+    // states; a dead or not-yet-spawned reference disables the radius.
+    const ActorDynamicState *Reference = nullptr;
+    if (Filter.reference_actor != 0u)
+    {
+      for (const auto &State : ActorStates)
+      {
+        if (State.id == Filter.reference_actor)
+        {
+          Reference = &State;
+          break;
+        }
+      }
+    }
+    const std::unordered_set<carla::rpc::ActorId> Interest(
+        Filter.actor_ids.begin(), Filter.actor_ids.end());
+    const float SquaredRadius = Filter.radius * Filter.radius;
+
+    auto IsSelected = [&](const ActorDynamicState &State)
+    {
+      if (!Filter.IsSelective())
+      {
+        return true;
+      }
+      if (Interest.count(State.id) != 0u)
+      {
+        return true;
+      }
+      if (Reference != nullptr)
+      {
+        if (State.id == Filter.reference_actor)
+        {
+          return true;
+        }
+        const auto Delta = State.transform.location - Reference->transform.location;
+        return Delta.SquaredLength() <= SquaredRadius;
+      }
+      return false;
+    };
+
+    auto AsyncStream = Subscription.Stream.MakeAsyncDataStream(
+        Observer, Episode.GetElapsedGameTime());
+    auto Buffer = AsyncStream.PopBufferFromPool();
+    Buffer.reset(sizeof(Serializer::Header) + sizeof(ActorDynamicState) * ActorStates.size());
+    auto CurrentSize = 0u;
+    auto WriteData = [&CurrentSize, &Buffer](const auto &Data)
+    {
+      std::memcpy(Buffer.begin() + CurrentSize, &Data, sizeof(Data));
+      CurrentSize += sizeof(Data);
+    };
+
+    // Filtered streams always carry keyframes: with a spatial filter the
+    // actor subset changes between ticks, a delta base would rarely hold.
+    Serializer::Header Header;
+    Header.episode_id = Episode.GetId();
+    Header.platform_timestamp = FPlatformTime::Seconds();
+    Header.delta_seconds = DeltaSeconds;
+    uint8_t StateFlags = (SimulationState::MapChange * MapChange);
+    StateFlags |= (SimulationState::PendingLightUpdate * PendingLightUpdate);
+    Header.simulation_state = static_cast<SimulationState>(StateFlags);
+    Header.physics_control_revision = Episode.GetPhysicsControlRevision();
+    WriteData(Header);
+
+    for (const auto &State : ActorStates)
+    {
+      if (IsSelected(State))
+      {
+        WriteData(State);
+      }
+    }
+    Buffer.resize(CurrentSize);
+
+    AsyncStream.Send(Observer, std::move(Buffer));
+    ++It;
+  }
 }
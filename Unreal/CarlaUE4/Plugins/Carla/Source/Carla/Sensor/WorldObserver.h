@@ -8,7 +8,112 @@
 
 #include "Carla/Sensor/DataStream.h"
 
+#include "Async/Async.h"
+#include "Delegates/IDelegateInstance.h"
+#include "UObject/WeakObjectPtr.h"
+
+#include <compiler/disable-ue4-macros.h>
+#include <carla/rpc/ActorId.h>
+#include <carla/rpc/EpisodeStreamFilter.h>
+#include <carla/sensor/data/ActorDynamicState.h>
+#include <compiler/enable-ue4-macros.h>
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class UActorComponent;
 class UCarlaEpisode;
+class USceneComponent;
+class FWorldObserver;
+
+/// Persistent mirror of the dynamic state of every registered actor, kept as
+/// contiguous rows laid out exactly as the serializer writes them, so a
+/// keyframe is a single memcpy. Rows are flagged dirty by their root
+/// component's TransformUpdated event and the movement-dependent fields of
+/// clean rows are skipped when gathering, so actors at rest cost a flag
+/// check per tick.
+class FActorStateMirror
+{
+public:
+
+  struct FInfo
+  {
+    /// Root component whose TransformUpdated event marks this row dirty.
+    TWeakObjectPtr<USceneComponent> Root;
+
+    FDelegateHandle MovedHandle;
+
+    /// Sign component of traffic lights and signs, resolved once instead of
+    /// a FindComponentByClass per tick.
+    TWeakObjectPtr<UActorComponent> SignComponent;
+
+    bool bSignComponentCached = false;
+
+    /// Whether the movement-dependent fields of the row need a refresh.
+    bool bDirty = true;
+
+    /// Stamp of the last tick this row's actor was seen in the registry.
+    uint32 LastSeenTick = 0u;
+  };
+
+  ~FActorStateMirror();
+
+  /// Append a row for @a Id, binding the movement event of @a RootComponent.
+  /// Returns the index of the new row.
+  size_t AddRow(carla::rpc::ActorId Id, USceneComponent *RootComponent);
+
+  /// Remove the row at @a Index, unbinding its movement event.
+  void RemoveRow(size_t Index);
+
+  std::vector<carla::sensor::data::ActorDynamicState> Rows;
+
+  /// Bookkeeping of each row, parallel to Rows.
+  std::vector<FInfo> Infos;
+
+  std::unordered_map<carla::rpc::ActorId, size_t> IndexById;
+
+  uint32 TickStamp = 0u;
+};
+
+/// Filtered views of the world-observer stream, one per client that
+/// negotiated a carla::rpc::EpisodeStreamFilter. Each entry owns its own
+/// stream carrying only the actors its filter selects, at a fraction of the
+/// simulation rate; the main broadcast stream is unaffected.
+///
+/// Subscriptions are added from the RPC bindings and broadcast from the
+/// world observer, both on the game thread.
+class FFilteredWorldStreams
+{
+public:
+
+  /// Register @a Filter on @a Stream. The stream is dropped once its client
+  /// disconnects.
+  void Add(FDataMultiStream Stream, carla::rpc::EpisodeStreamFilter Filter);
+
+  /// Send the states selected by each subscription, always as keyframes.
+  /// Expects the same state list the main stream serializes this tick.
+  void Broadcast(
+      FWorldObserver &Observer,
+      const UCarlaEpisode &Episode,
+      float DeltaSeconds,
+      bool MapChange,
+      bool PendingLightUpdate,
+      const std::vector<carla::sensor::data::ActorDynamicState> &ActorStates);
+
+private:
+
+  struct FSubscription
+  {
+    FDataMultiStream Stream;
+    carla::rpc::EpisodeStreamFilter Filter;
+    uint32 TickCounter = 0u;
+    bool bEverListened = false;
+  };
+
+  std::vector<FSubscription> Subscriptions;
+};
 
 /// Serializes and sends all the actors in the current UCarlaEpisode.
 class FWorldObserver
@@ -18,12 +123,24 @@ public:
   /// Prevent this sensor to be spawned by users.
   using not_spawnable = void;
 
+  ~FWorldObserver()
+  {
+    WaitForSerialization();
+  }
+
   /// Replace the Stream associated with this sensor.
   void SetStream(FDataMultiStream InStream)
   {
     Stream = std::move(InStream);
   }
 
+  /// Attach the per-client filtered subscriptions, shared with the server
+  /// that registers them.
+  void SetFilteredStreams(std::shared_ptr<FFilteredWorldStreams> InStreams)
+  {
+    FilteredStreams = std::move(InStreams);
+  }
+
   /// Return the token that allows subscribing to this sensor's stream.
   auto GetToken() const
   {
@@ -44,7 +161,48 @@ public:
     return {};
   }
 
+  /// Duration of the most recently finished serialization task, in seconds.
+  /// The task overlaps the next frame, so the value read at a frame
+  /// boundary usually belongs to the frame before it.
+  double GetLastSerializationSeconds() const
+  {
+    return LastSerializationSeconds.load(std::memory_order_relaxed);
+  }
+
 private:
 
+  /// Block until the serialization task of the last tick has sent its
+  /// message, no-op when none is in flight.
+  void WaitForSerialization()
+  {
+    if (SerializeTask.IsValid())
+    {
+      SerializeTask.Wait();
+    }
+  }
+
   FDataMultiStream Stream;
+
+  std::shared_ptr<FFilteredWorldStreams> FilteredStreams;
+
+  /// Serialization of the last tick, runs on a worker thread overlapping
+  /// the simulation of the next frame (see BroadcastTick).
+  TFuture<void> SerializeTask;
+
+  /// Written by the serialization task when it finishes, see
+  /// GetLastSerializationSeconds.
+  std::atomic<double> LastSerializationSeconds{0.0};
+
+  /// A keyframe with the full state of every actor is sent at least once
+  /// every this many ticks, in between only changed fields travel.
+  constexpr static uint32 KeyframeInterval = 10u;
+
+  /// State of every actor at the last keyframe, deltas are built against it.
+  std::unordered_map<carla::rpc::ActorId, carla::sensor::data::ActorDynamicState> KeyframeStates;
+
+  /// Ticks elapsed since the last keyframe.
+  uint32 TicksSinceKeyframe = 0u;
+
+  /// Persistent actor state rows serialized every tick.
+  FActorStateMirror Mirror;
 };
@@ -8,27 +8,43 @@
 #include "Carla/Server/CarlaServer.h"
 
 #include "Carla/OpenDrive/OpenDrive.h"
+#include "Carla/Sensor/Sensor.h"
+#include "CommandLine.h"
+#include "Carla/Sensor/WorldObserver.h"
 #include "Carla/Util/DebugShapeDrawer.h"
 #include "Carla/Util/NavigationMesh.h"
 #include "Carla/Vehicle/CarlaWheeledVehicle.h"
 #include "Carla/Walker/WalkerController.h"
 
 #include <compiler/disable-ue4-macros.h>
+#include <carla/AtomicSharedPtr.h>
 #include <carla/Functional.h>
 #include <carla/Version.h>
 #include <carla/rpc/Actor.h>
 #include <carla/rpc/ActorDefinition.h>
 #include <carla/rpc/ActorDescription.h>
 #include <carla/rpc/Command.h>
+#include <carla/rpc/CommandBatch.h>
 #include <carla/rpc/CommandResponse.h>
 #include <carla/rpc/DebugShape.h>
 #include <carla/rpc/EpisodeInfo.h>
 #include <carla/rpc/EpisodeSettings.h>
+#include <carla/rpc/EpisodeStreamFilter.h>
 #include <carla/rpc/LightState.h>
+#include <carla/BufferPool.h>
+#include <carla/profiler/LifetimeProfiled.h>
+#include <carla/profiler/TraceLog.h>
+#include <carla/rpc/ActorSync.h>
+#include <carla/rpc/BufferPoolStats.h>
+#include <carla/rpc/FrameStats.h>
+#include <carla/rpc/ObjectCensus.h>
+#include <carla/road/MapSerializer.h>
 #include <carla/rpc/MapInfo.h>
 #include <carla/rpc/Response.h>
 #include <carla/rpc/Server.h>
+#include <carla/rpc/StreamStats.h>
 #include <carla/rpc/String.h>
+#include <carla/rpc/TrafficLightSnapshot.h>
 #include <carla/rpc/Transform.h>
 #include <carla/rpc/Vector2D.h>
 #include <carla/rpc/Vector3D.h>
@@ -37,10 +53,20 @@
 #include <carla/rpc/VehicleLightState.h>
 #include <carla/rpc/WalkerBoneControl.h>
 #include <carla/rpc/WalkerControl.h>
+#include <carla/rpc/WeatherKeyFrame.h>
 #include <carla/rpc/WeatherParameters.h>
 #include <carla/streaming/Server.h>
 #include <compiler/enable-ue4-macros.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <map>
 
@@ -61,6 +87,22 @@ static std::vector<T> MakeVectorFromTArray(const TArray<Other> &Array)
 // -- FCarlaServer::FPimpl -----------------------------------------------
 // =============================================================================
 
+/// Episode slot assigned to this server process, taken from the
+/// -carla-episode-slot=N launch argument. Slots namespace the streaming ids
+/// a server hands out, so the tokens of episodes cooperating on one host
+/// (e.g. a fleet of RL environments behind a shared client) never collide.
+static uint8 ReadEpisodeSlot()
+{
+  uint32 Slot = 0u;
+  FParse::Value(FCommandLine::Get(), TEXT("-carla-episode-slot="), Slot);
+  if (Slot > carla::streaming::detail::stream_id_namespace_max)
+  {
+    UE_LOG(LogCarlaServer, Error, TEXT("Invalid episode slot %d, using 0"), Slot);
+    Slot = 0u;
+  }
+  return static_cast<uint8>(Slot);
+}
+
 class FCarlaServer::FPimpl
 {
 public:
@@ -68,7 +110,12 @@ public:
   FPimpl(uint16_t RPCPort, uint16_t StreamingPort)
     : Server(RPCPort),
       StreamingServer(StreamingPort),
-      BroadcastStream(StreamingServer.MakeMultiStream())
+      EpisodeSlot(ReadEpisodeSlot()),
+      BroadcastStream([this]() {
+        // before the first stream opens, so every token carries the slot
+        StreamingServer.SetStreamIdNamespace(EpisodeSlot);
+        return StreamingServer.MakeMultiStream();
+      }())
   {
     BindActions();
   }
@@ -80,11 +127,143 @@ public:
 
   carla::streaming::Server StreamingServer;
 
+  /// See ReadEpisodeSlot(); served to clients in the episode info.
+  const uint8 EpisodeSlot;
+
   carla::streaming::MultiStream BroadcastStream;
 
+  /// Per-client filtered views of the world-observer stream, shared with the
+  /// FWorldObserver that broadcasts them.
+  std::shared_ptr<FFilteredWorldStreams> FilteredWorldStreams =
+      std::make_shared<FFilteredWorldStreams>();
+
   UCarlaEpisode *Episode = nullptr;
 
-  size_t TickCuesReceived = 0u;
+  std::atomic_size_t TickCuesReceived{0u};
+
+  /// Deadline declared with the last tick_cue_deadline, when the external
+  /// co-simulator expects to rendezvous with the cued frame; consumed by the
+  /// engine to pace the RPC drain of that frame. Zero when the frame was
+  /// cued without a deadline.
+  std::atomic<double> PendingFrameDeadlineSeconds{0.0};
+
+  /// Rolling per-frame time breakdown fed by the engine from the game
+  /// thread, served by get_frame_stats (which also runs on the game thread).
+  FFrameStatsRecorder FrameStats;
+
+  /// Frame number of the last world-observer broadcast, published by the
+  /// game thread through FCarlaServer::NotifyTickBroadcast; worker threads
+  /// serving tick_cue_fused block on the condition until it reaches the
+  /// frame their cue triggers.
+  std::mutex SyncTickMutex;
+
+  std::condition_variable SyncTickCondition;
+
+  uint64_t LastBroadcastFrame = 0u;
+
+  std::atomic<bool> bShuttingDown{false};
+
+  /// A command batch committed over several server slices so a spawn-heavy
+  /// batch does not block the world for its whole duration; see
+  /// apply_batch_deferred.
+  struct FDeferredBatch
+  {
+    std::vector<carla::rpc::Command> Commands;
+
+    /// Error message per command filled by the off-thread validation, an
+    /// empty string means the command passed; failed commands are skipped
+    /// at commit time.
+    std::vector<std::string> PrevalidationErrors;
+
+    std::vector<carla::rpc::CommandResponse> Result;
+
+    size_t NextCommand = 0u;
+
+    bool bTickCueOnDone = false;
+
+    bool bDone = false;
+  };
+
+  std::mutex DeferredBatchMutex;
+
+  std::condition_variable DeferredBatchDone;
+
+  std::deque<std::shared_ptr<FDeferredBatch>> DeferredBatches;
+
+  /// Commits a slice of the pending deferred batches; bound in BindActions
+  /// so it can reuse the batch command visitor. Call from the game thread.
+  std::function<void(double BudgetSeconds)> ProcessDeferredBatches;
+
+  /// Immutable copy of the episode data served by the read-only handlers; it
+  /// is rebuilt on the game thread once per server slice and read
+  /// concurrently from the RPC worker threads.
+  struct FFrameSnapshot
+  {
+    using FActorMap = std::unordered_map<FActorView::IdType, carla::rpc::Actor>;
+
+    uint64 RegistryVersion = 0u;
+
+    carla::rpc::EpisodeInfo EpisodeInfo;
+
+    carla::rpc::EpisodeSettings Settings;
+
+    carla::rpc::WeatherParameters Weather;
+
+    /// Shared with the previous snapshot while the registry is unchanged.
+    std::shared_ptr<const FActorMap> Actors;
+
+    std::shared_ptr<const std::vector<carla::rpc::ActorDefinition>> ActorDefinitions;
+
+    carla::rpc::Actor Spectator;
+
+    bool HasSpectator = false;
+
+    /// Light states paired with the revision they last changed at, shared
+    /// with the previous snapshot while no light changed.
+    uint64 LightsRevision = 0u;
+
+    std::shared_ptr<const std::vector<std::pair<uint64, carla::rpc::LightState>>> Lights;
+  };
+
+  carla::AtomicSharedPtr<const FFrameSnapshot> FrameSnapshot;
+
+  /// Revision of the light states each client has been served up to, read
+  /// and updated by the worker threads serving query_lights_state.
+  std::mutex LightClientsMutex;
+
+  std::unordered_map<std::string, uint64> LightClientRevisions;
+
+  /// OpenDRIVE contents served in chunks by get_map_data_chunk; primed by
+  /// get_map_info on the game thread, read from the worker threads.
+  std::mutex MapDataMutex;
+
+  std::string MapData;
+
+  FString MapDataMapName;
+
+  uint64 MapDataHash = 0u;
+
+  /// Physics mutations received during the last server slice, coalesced per
+  /// actor (last write wins) and applied in one go at the next frame
+  /// boundary, so toggling physics on hundreds of actors costs one pass
+  /// instead of scattered PhysX body updates.
+  struct FPendingPhysicsUpdate
+  {
+    TOptional<bool> SimulatePhysics;
+
+    TOptional<carla::rpc::VehiclePhysicsControl> PhysicsControl;
+  };
+
+  std::unordered_map<carla::rpc::ActorId, FPendingPhysicsUpdate> PendingPhysicsUpdates;
+
+  /// Set when a sensor stream token is rewritten in place; forces the next
+  /// snapshot to reserialize the registry even though its version is
+  /// unchanged.
+  bool bActorInfoDirty = false;
+
+  /// Publish a fresh snapshot for the read-only handlers; call from the game
+  /// thread only.
+  void RefreshFrameSnapshot();
 
 private:
 
@@ -117,21 +296,32 @@ class ServerBinder
 {
 public:
 
-  constexpr ServerBinder(const char *name, carla::rpc::Server &srv, bool sync)
+  enum EBindMode
+  {
+    Sync,
+    Async,
+    Read
+  };
+
+  constexpr ServerBinder(const char *name, carla::rpc::Server &srv, EBindMode mode)
     : _name(name),
       _server(srv),
-      _sync(sync) {}
+      _mode(mode) {}
 
   template <typename FuncT>
   auto operator<<(FuncT func)
   {
-    if (_sync)
+    switch (_mode)
     {
-      _server.BindSync(_name, func);
-    }
-    else
-    {
-      _server.BindAsync(_name, func);
+      case Sync:
+        _server.BindSync(_name, func);
+        break;
+      case Async:
+        _server.BindAsync(_name, func);
+        break;
+      case Read:
+        _server.BindRead(_name, func);
+        break;
     }
     return func;
   }
@@ -142,11 +332,12 @@ private:
 
   carla::rpc::Server &_server;
 
-  bool _sync;
+  EBindMode _mode;
 };
 
-#define BIND_SYNC(name)   auto name = ServerBinder(# name, Server, true)
-#define BIND_ASYNC(name)  auto name = ServerBinder(# name, Server, false)
+#define BIND_SYNC(name)   auto name = ServerBinder(# name, Server, ServerBinder::Sync)
+#define BIND_ASYNC(name)  auto name = ServerBinder(# name, Server, ServerBinder::Async)
+#define BIND_READ(name)   auto name = ServerBinder(# name, Server, ServerBinder::Read)
 
 // =============================================================================
 // -- Bind Actions -------------------------------------------------------------
@@ -211,6 +402,40 @@ void FCarlaServer::FPimpl::BindActions()
     return GFrameCounter + 1u;
   };
 
+  BIND_ASYNC(tick_cue_fused) << [this]() -> R<uint64_t>
+  {
+    // Runs on a worker thread: signal the cue and hold the response back
+    // until the resulting frame's state broadcast is in flight, so a
+    // synchronous client pays a single rendezvous per simulated frame
+    // instead of a tick round trip plus a wait on the stream.
+    std::unique_lock<std::mutex> Lock(SyncTickMutex);
+    const auto Target = LastBroadcastFrame + 1u;
+    ++TickCuesReceived;
+    SyncTickCondition.wait(Lock, [this, Target]() {
+      return bShuttingDown || (LastBroadcastFrame >= Target);
+    });
+    if (bShuttingDown)
+    {
+      RESPOND_ERROR("server shutting down");
+    }
+    return LastBroadcastFrame;
+  };
+
+  BIND_SYNC(tick_cue_deadline) << [this](double BudgetSeconds) -> R<uint64_t>
+  {
+    // Co-simulation stepping: initiate the frame and return right away so
+    // the external simulator computes its own step while ours runs; the
+    // client rendezvouses on the state broadcast afterwards. The budget
+    // declares when the client expects to be back, letting the engine
+    // spend the concurrent window on background work and still poll for
+    // the next cue tightly around the deadline; see
+    // FCarlaEngine::OnPostTick.
+    PendingFrameDeadlineSeconds =
+        FPlatformTime::Seconds() + std::max(0.0, BudgetSeconds);
+    ++TickCuesReceived;
+    return GFrameCounter + 1u;
+  };
+
   // ~~ Load new episode ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
   BIND_ASYNC(get_available_maps) << [this]() -> R<std::vector<std::string>>
@@ -250,6 +475,16 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
+  BIND_SYNC(reset_episode) << [this](bool reset_settings, bool reset_weather) -> R<void>
+  {
+    REQUIRE_CARLA_EPISODE();
+    // In-place reset: the level is not reloaded, so navigation and tag data
+    // stay resident and the client is back in a fresh episode within a few
+    // frames instead of the seconds a full map load takes.
+    Episode->ResetEpisode(reset_settings, reset_weather);
+    return R<void>::Success();
+  };
+
   BIND_SYNC(check_intermediate_episode) << [this]() -> R<bool>
   {
     REQUIRE_CARLA_EPISODE();
@@ -268,21 +503,63 @@ void FCarlaServer::FPimpl::BindActions()
 
   // ~~ Episode settings and info ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(get_episode_info) << [this]() -> R<cr::EpisodeInfo>
+  BIND_READ(get_episode_info) << [this]() -> R<cr::EpisodeInfo>
+  {
+    auto Snapshot = FrameSnapshot.load();
+    if (Snapshot == nullptr)
+    {
+      RESPOND_ERROR("episode not ready");
+    }
+    return Snapshot->EpisodeInfo;
+  };
+
+  BIND_SYNC(subscribe_filtered_episode_state) << [this]
+    (cr::EpisodeStreamFilter filter) -> R<carla::streaming::Token>
   {
     REQUIRE_CARLA_EPISODE();
-    return cr::EpisodeInfo{Episode->GetId(), BroadcastStream.token()};
+    // The client keeps the broadcast stream token from get_episode_info; this
+    // mints a dedicated stream carrying only what the filter selects, see
+    // FFilteredWorldStreams.
+    auto Stream = StreamingServer.MakeMultiStream();
+    const auto Token = Stream.token();
+    FilteredWorldStreams->Add(FDataMultiStream(std::move(Stream)), std::move(filter));
+    return Token;
   };
 
   BIND_SYNC(get_map_info) << [this]() -> R<cr::MapInfo>
   {
     REQUIRE_CARLA_EPISODE();
-    auto FileContents = UOpenDrive::LoadXODR(Episode->GetMapName());
     const auto &SpawnPoints = Episode->GetRecommendedSpawnPoints();
-    return cr::MapInfo{
+    cr::MapInfo Info{
       cr::FromFString(Episode->GetMapName()),
-      cr::FromFString(FileContents),
+      std::string(), // the file is pulled in chunks, see get_map_data_chunk
       MakeVectorFromTArray<cg::Transform>(SpawnPoints)};
+    // Prime the chunk cache here on the game thread so the workers only ever
+    // read an immutable string.
+    std::lock_guard<std::mutex> Lock(MapDataMutex);
+    if (MapDataMapName != Episode->GetMapName())
+    {
+      MapData = cr::FromFString(UOpenDrive::LoadXODR(Episode->GetMapName()));
+      MapDataMapName = Episode->GetMapName();
+      MapDataHash = carla::road::MapSerializer::Hash(MapData);
+    }
+    Info.open_drive_size = MapData.size();
+    // Lets clients with a local copy of this exact content skip the download.
+    Info.open_drive_hash = MapDataHash;
+    return Info;
+  };
+
+  BIND_ASYNC(get_map_data_chunk) << [this](uint64_t offset) -> R<std::string>
+  {
+    // Big enough to keep the round trips few, small enough not to stall the
+    // RPC session while it serializes.
+    constexpr uint64_t ChunkSize = 4u * 1024u * 1024u;
+    std::lock_guard<std::mutex> Lock(MapDataMutex);
+    if (offset >= MapData.size())
+    {
+      RESPOND_ERROR("map data chunk out of range");
+    }
+    return MapData.substr(offset, ChunkSize);
   };
 
   BIND_SYNC(get_navigation_mesh) << [this]() -> R<std::vector<uint8_t>>
@@ -296,10 +573,14 @@ void FCarlaServer::FPimpl::BindActions()
   };
 
 
-  BIND_SYNC(get_episode_settings) << [this]() -> R<cr::EpisodeSettings>
+  BIND_READ(get_episode_settings) << [this]() -> R<cr::EpisodeSettings>
   {
-    REQUIRE_CARLA_EPISODE();
-    return cr::EpisodeSettings{Episode->GetSettings()};
+    auto Snapshot = FrameSnapshot.load();
+    if (Snapshot == nullptr)
+    {
+      RESPOND_ERROR("episode not ready");
+    }
+    return Snapshot->Settings;
   };
 
   BIND_SYNC(set_episode_settings) << [this](
@@ -310,26 +591,124 @@ void FCarlaServer::FPimpl::BindActions()
     return GFrameCounter;
   };
 
-  BIND_SYNC(get_actor_definitions) << [this]() -> R<std::vector<cr::ActorDefinition>>
+  BIND_ASYNC(get_sensor_stream_stats) << []() -> R<std::vector<cr::StreamStats>>
+  {
+    auto stats = carla::streaming::detail::StreamStatsRegistry::GetInstance().GetStats();
+    return std::vector<cr::StreamStats>(stats.begin(), stats.end());
+  };
+
+  BIND_SYNC(redirect_sensor_stream) << [this](
+      cr::ActorId ActorId,
+      std::string host,
+      uint16_t port) -> R<std::vector<uint8_t>>
   {
     REQUIRE_CARLA_EPISODE();
-    return MakeVectorFromTArray<cr::ActorDefinition>(Episode->GetActorDefinitions());
+    auto ActorView = Episode->FindActor(ActorId);
+    if (!ActorView.IsValid())
+    {
+      RESPOND_ERROR("unable to redirect sensor stream: actor not found");
+    }
+    auto *Sensor = Cast<ASensor>(ActorView.GetActor());
+    if (Sensor == nullptr)
+    {
+      RESPOND_ERROR("unable to redirect sensor stream: actor is not a sensor");
+    }
+    carla::streaming::detail::token_type Token(Sensor->GetToken());
+    if (!Token.protocol_is_tcp())
+    {
+      RESPOND_ERROR("unable to redirect sensor stream: only TCP streams can be redirected");
+    }
+    boost::system::error_code ec;
+    auto Address = boost::asio::ip::make_address(host, ec);
+    if (ec)
+    {
+      RESPOND_ERROR("unable to redirect sensor stream: invalid address, use a numeric IP");
+    }
+    Token.set_address(Address);
+    Token.set_port(port);
+    const carla::streaming::Token Serialized = Token;
+    // Rewrite the token published in the actor info so late subscribers are
+    // pointed at the secondary renderer; clients already subscribed to this
+    // server keep their sessions. The info is immutable everywhere else, and
+    // we are on the game thread, so no reader can observe a partial write.
+    auto *Info = const_cast<FActorInfo *>(ActorView.GetActorInfo());
+    check(Info != nullptr);
+    Info->SerializedData.stream_token = decltype(Info->SerializedData.stream_token)(
+        std::begin(Serialized.data),
+        std::end(Serialized.data));
+    bActorInfoDirty = true;
+    return std::vector<uint8_t>(std::begin(Serialized.data), std::end(Serialized.data));
   };
 
-  BIND_SYNC(get_spectator) << [this]() -> R<cr::Actor>
+  BIND_SYNC(adopt_sensor_stream) << [this](
+      cr::ActorId ActorId,
+      std::vector<uint8_t> token) -> R<void>
   {
     REQUIRE_CARLA_EPISODE();
-    auto ActorView = Episode->FindActor(Episode->GetSpectatorPawn());
+    auto ActorView = Episode->FindActor(ActorId);
     if (!ActorView.IsValid())
+    {
+      RESPOND_ERROR("unable to adopt sensor stream: actor not found");
+    }
+    auto *Sensor = Cast<ASensor>(ActorView.GetActor());
+    if (Sensor == nullptr)
+    {
+      RESPOND_ERROR("unable to adopt sensor stream: actor is not a sensor");
+    }
+    carla::streaming::Token Serialized;
+    if (token.size() != Serialized.data.size())
+    {
+      RESPOND_ERROR("unable to adopt sensor stream: invalid token");
+    }
+    std::copy(token.begin(), token.end(), Serialized.data.begin());
+    const carla::streaming::detail::token_type Typed(Serialized);
+    auto Stream = StreamingServer.MakeStream(Typed.get_stream_id());
+    if (!Stream.has_value())
+    {
+      RESPOND_ERROR("unable to adopt sensor stream: stream id already in use");
+    }
+    Sensor->SetDataStream(FDataStream(std::move(*Stream)));
+    return R<void>::Success();
+  };
+
+  BIND_READ(get_actor_definitions) << [this]() -> R<std::vector<cr::ActorDefinition>>
+  {
+    auto Snapshot = FrameSnapshot.load();
+    if (Snapshot == nullptr)
+    {
+      RESPOND_ERROR("episode not ready");
+    }
+    return *Snapshot->ActorDefinitions;
+  };
+
+  BIND_READ(get_spectator) << [this]() -> R<cr::Actor>
+  {
+    auto Snapshot = FrameSnapshot.load();
+    if (Snapshot == nullptr)
+    {
+      RESPOND_ERROR("episode not ready");
+    }
+    if (!Snapshot->HasSpectator)
     {
       RESPOND_ERROR("internal error: unable to find spectator");
     }
-    return Episode->SerializeActor(ActorView);
+    return Snapshot->Spectator;
   };
 
   // ~~ Weather ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(get_weather_parameters) << [this]() -> R<cr::WeatherParameters>
+  BIND_READ(get_weather_parameters) << [this]() -> R<cr::WeatherParameters>
+  {
+    auto Snapshot = FrameSnapshot.load();
+    if (Snapshot == nullptr)
+    {
+      RESPOND_ERROR("episode not ready");
+    }
+    return Snapshot->Weather;
+  };
+
+  BIND_SYNC(set_weather_parameters) << [this](
+      const cr::WeatherParameters &weather) -> R<void>
   {
     REQUIRE_CARLA_EPISODE();
     auto *Weather = Episode->GetWeather();
@@ -337,11 +716,12 @@ void FCarlaServer::FPimpl::BindActions()
     {
       RESPOND_ERROR("internal error: unable to find weather");
     }
-    return Weather->GetCurrentWeather();
+    Weather->ApplyWeather(weather);
+    return R<void>::Success();
   };
 
-  BIND_SYNC(set_weather_parameters) << [this](
-      const cr::WeatherParameters &weather) -> R<void>
+  BIND_SYNC(set_weather_animation) << [this](
+      const std::vector<cr::WeatherKeyFrame> &keyframes) -> R<void>
   {
     REQUIRE_CARLA_EPISODE();
     auto *Weather = Episode->GetWeather();
@@ -349,29 +729,58 @@ void FCarlaServer::FPimpl::BindActions()
     {
       RESPOND_ERROR("internal error: unable to find weather");
     }
-    Weather->ApplyWeather(weather);
+    TArray<FWeatherKeyFrame> KeyFrames;
+    KeyFrames.Reserve(keyframes.size());
+    for (const auto &keyframe : keyframes)
+    {
+      FWeatherKeyFrame KeyFrame;
+      KeyFrame.Time = static_cast<float>(keyframe.time);
+      KeyFrame.Parameters = keyframe.parameters;
+      KeyFrames.Add(KeyFrame);
+    }
+    Weather->SetAnimation(MoveTemp(KeyFrames));
     return R<void>::Success();
   };
 
   // ~~ Actor operations ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(get_actors_by_id) << [this](
+  BIND_READ(get_actors_by_id) << [this](
       const std::vector<FActorView::IdType> &ids) -> R<std::vector<cr::Actor>>
   {
-    REQUIRE_CARLA_EPISODE();
+    auto Snapshot = FrameSnapshot.load();
+    if (Snapshot == nullptr)
+    {
+      RESPOND_ERROR("episode not ready");
+    }
+    // Actors spawned since the last snapshot are simply not found yet, same
+    // as asking about an id that never existed; callers already skip them.
     std::vector<cr::Actor> Result;
     Result.reserve(ids.size());
     for (auto &&Id : ids)
     {
-      auto View = Episode->FindActor(Id);
-      if (View.IsValid())
+      auto it = Snapshot->Actors->find(Id);
+      if (it != Snapshot->Actors->end())
       {
-        Result.emplace_back(Episode->SerializeActor(View));
+        Result.emplace_back(it->second);
       }
     }
     return Result;
   };
 
+  BIND_SYNC(prewarm_actors) << [this](
+      const std::vector<std::string> &blueprint_ids) -> R<void>
+  {
+    REQUIRE_CARLA_EPISODE();
+    TArray<FString> BlueprintIds;
+    BlueprintIds.Reserve(blueprint_ids.size());
+    for (const auto &id : blueprint_ids)
+    {
+      BlueprintIds.Add(FString(id.c_str()));
+    }
+    Episode->PrewarmActors(BlueprintIds);
+    return R<void>::Success();
+  };
+
   BIND_SYNC(spawn_actor) << [this](
       cr::ActorDescription Description,
       const cr::Transform &Transform) -> R<cr::Actor>
@@ -470,6 +879,65 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
+  BIND_SYNC(exchange_actor_states) << [this](
+      std::vector<cr::ActorTransformUpdate> Updates,
+      std::vector<cr::ActorId> QueryIds) -> R<std::vector<cr::ActorSyncState>>
+  {
+    REQUIRE_CARLA_EPISODE();
+    // One co-simulation step's worth of externally-driven transforms;
+    // entries whose actor no longer exists are skipped, the external side
+    // learns about deaths from the actor registry.
+    for (const auto &Update : Updates)
+    {
+      auto ActorView = Episode->FindActor(Update.actor);
+      if (!ActorView.IsValid())
+      {
+        continue;
+      }
+      auto Actor = ActorView.GetActor();
+      Actor->SetActorRelativeTransform(
+          Update.transform,
+          false,
+          nullptr,
+          ETeleportType::TeleportPhysics);
+      if (Update.has_light_state)
+      {
+        auto Vehicle = Cast<ACarlaWheeledVehicle>(Actor);
+        if (Vehicle != nullptr)
+        {
+          Vehicle->SetVehicleLightState(
+              FVehicleLightState(cr::VehicleLightState(Update.light_state)));
+        }
+      }
+    }
+    // Read back the CARLA-driven actors in the same response, saving the
+    // bridge one round trip per queried actor.
+    constexpr float TO_METERS = 1e-2f;
+    std::vector<cr::ActorSyncState> Result;
+    Result.reserve(QueryIds.size());
+    for (const auto Id : QueryIds)
+    {
+      auto ActorView = Episode->FindActor(Id);
+      if (!ActorView.IsValid())
+      {
+        continue;
+      }
+      auto Actor = ActorView.GetActor();
+      cr::ActorSyncState State;
+      State.actor = Id;
+      State.transform = Actor->GetActorTransform();
+      State.velocity = TO_METERS * Actor->GetVelocity();
+      auto Vehicle = Cast<ACarlaWheeledVehicle>(Actor);
+      if (Vehicle != nullptr)
+      {
+        State.light_state =
+            cr::VehicleLightState(Vehicle->GetVehicleLightState()).light_state;
+      }
+      Result.emplace_back(std::move(State));
+    }
+    return Result;
+  };
+
   BIND_SYNC(set_walker_state) << [this] (
       cr::ActorId ActorId,
       cr::Transform Transform,
@@ -623,6 +1091,14 @@ void FCarlaServer::FPimpl::BindActions()
       RESPOND_ERROR("unable to get actor physics control: actor is not a vehicle");
     }
 
+    // A control applied this slice is still queued for the frame boundary,
+    // report it rather than the stale one on the vehicle.
+    auto It = PendingPhysicsUpdates.find(ActorId);
+    if ((It != PendingPhysicsUpdates.end()) && It->second.PhysicsControl.IsSet())
+    {
+      return It->second.PhysicsControl.GetValue();
+    }
+
     return cr::VehiclePhysicsControl(Vehicle->GetVehiclePhysicsControl());
   };
 
@@ -660,7 +1136,7 @@ void FCarlaServer::FPimpl::BindActions()
       RESPOND_ERROR("unable to apply actor physics control: actor is not a vehicle");
     }
 
-    Vehicle->ApplyVehiclePhysicsControl(FVehiclePhysicsControl(PhysicsControl));
+    PendingPhysicsUpdates[ActorId].PhysicsControl = std::move(PhysicsControl);
 
     return R<void>::Success();
   };
@@ -701,7 +1177,7 @@ void FCarlaServer::FPimpl::BindActions()
     {
       RESPOND_ERROR("unable to set actor simulate physics: not supported by actor");
     }
-    RootComponent->SetSimulatePhysics(bEnabled);
+    PendingPhysicsUpdates[ActorId].SimulatePhysics = bEnabled;
     return R<void>::Success();
   };
 
@@ -921,12 +1397,140 @@ void FCarlaServer::FPimpl::BindActions()
     return Result;
   };
 
+  BIND_SYNC(get_traffic_light_states) << [this]() -> R<std::vector<cr::TrafficLightSnapshot>>
+  {
+    REQUIRE_CARLA_EPISODE();
+    std::vector<cr::TrafficLightSnapshot> Result;
+    TMap<ATrafficLightBase *, uint32> GroupIds;
+    uint32 GroupCount = 0u;
+    for (const FActorView &View : Episode->GetActorRegistry())
+    {
+      if (!View.IsValid() || View.GetActor()->IsPendingKill())
+      {
+        continue;
+      }
+      auto TrafficLight = Cast<ATrafficLightBase>(View.GetActor());
+      if (TrafficLight == nullptr)
+      {
+        continue;
+      }
+      if (GroupIds.Find(TrafficLight) == nullptr)
+      {
+        ++GroupCount;
+        for (auto TLight : TrafficLight->GetGroupTrafficLights())
+        {
+          GroupIds.Add(TLight, GroupCount);
+        }
+        GroupIds.Add(TrafficLight, GroupCount);
+      }
+      cr::TrafficLightSnapshot Snapshot;
+      Snapshot.id = View.GetActorId();
+      Snapshot.state = static_cast<cr::TrafficLightState>(TrafficLight->GetTrafficLightState());
+      Snapshot.green_time = TrafficLight->GetGreenTime();
+      Snapshot.yellow_time = TrafficLight->GetYellowTime();
+      Snapshot.red_time = TrafficLight->GetRedTime();
+      Snapshot.elapsed_time = TrafficLight->GetElapsedTime();
+      Snapshot.frozen = TrafficLight->GetTimeIsFrozen();
+      Snapshot.pole_index = static_cast<uint32_t>(TrafficLight->GetPoleIndex());
+      Snapshot.group_id = GroupIds[TrafficLight];
+      Result.emplace_back(Snapshot);
+    }
+    return Result;
+  };
+
+  BIND_SYNC(set_traffic_light_states) << [this](
+      const std::vector<std::pair<cr::ActorId, cr::TrafficLightState>> &States) -> R<void>
+  {
+    REQUIRE_CARLA_EPISODE();
+    for (const auto &Entry : States)
+    {
+      auto ActorView = Episode->GetActorRegistry().Find(Entry.first);
+      if (!ActorView.IsValid() || ActorView.GetActor()->IsPendingKill())
+      {
+        continue;
+      }
+      auto TrafficLight = Cast<ATrafficLightBase>(ActorView.GetActor());
+      if (TrafficLight == nullptr)
+      {
+        continue;
+      }
+      TrafficLight->SetTrafficLightState(static_cast<ETrafficLightState>(Entry.second));
+    }
+    return R<void>::Success();
+  };
+
+  // ~~ Tracing ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+  BIND_SYNC(start_trace) << [](uint64_t max_events) -> R<void>
+  {
+    carla::profiler::TraceLog::GetInstance().Start(max_events);
+    return R<void>::Success();
+  };
+
+  BIND_SYNC(stop_trace) << []() -> R<void>
+  {
+    carla::profiler::TraceLog::GetInstance().Stop();
+    return R<void>::Success();
+  };
+
+  BIND_SYNC(get_trace) << []() -> R<std::string>
+  {
+    return R<std::string>(carla::profiler::TraceLog::GetInstance().ExportToJson());
+  };
+
+  BIND_SYNC(get_object_census) << []() -> R<carla::rpc::ObjectCensus>
+  {
+    carla::rpc::ObjectCensus Census;
+    for (const auto &Entry : carla::profiler::LifetimeCensus::GetInstance().GetEntries())
+    {
+      carla::rpc::ObjectCounter Counter;
+      Counter.type_name = Entry.type_name;
+      Counter.live = Entry.live;
+      Counter.peak = Entry.peak;
+      Counter.total = Entry.total;
+      Census.counters.emplace_back(std::move(Counter));
+    }
+    Census.pooled_buffer_count = carla::BufferPool::GetTotalRetainedCount();
+    Census.pooled_buffer_bytes = carla::BufferPool::GetTotalRetainedBytes();
+    return Census;
+  };
+
+  BIND_SYNC(get_frame_stats) << [this]() -> R<carla::rpc::FrameStats>
+  {
+    return R<carla::rpc::FrameStats>(FrameStats.GetStats());
+  };
+
+  BIND_ASYNC(get_buffer_pool_stats) << []() -> R<std::vector<carla::rpc::BufferPoolStats>>
+  {
+    std::vector<carla::rpc::BufferPoolStats> Result;
+    for (const auto &Stats : carla::BufferPool::GetAllStats())
+    {
+      Result.emplace_back(Stats);
+    }
+    return Result;
+  };
+
   // ~~ Logging and playback ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(start_recorder) << [this](std::string name) -> R<std::string>
+  BIND_SYNC(start_recorder) << [this](std::string name, std::string filter) -> R<std::string>
+  {
+    REQUIRE_CARLA_EPISODE();
+    return R<std::string>(Episode->StartRecorder(name, filter));
+  };
+
+  BIND_SYNC(start_recorder_stream) << [this](std::string name, std::string filter) -> R<carla::streaming::Token>
   {
     REQUIRE_CARLA_EPISODE();
-    return R<std::string>(Episode->StartRecorder(name));
+    // Recording over the network: the blocks travel to the collector client
+    // that subscribes to this stream, the file named here only catches
+    // blocks produced while no collector is subscribed.
+    auto Stream = StreamingServer.MakeStream();
+    const auto Token = Stream.token();
+    if (Episode->StartRecorder(name, filter, std::move(Stream)).empty())
+    {
+      RESPOND_ERROR("unable to start the recorder");
+    }
+    return Token;
   };
 
   BIND_SYNC(stop_recorder) << [this]() -> R<void>
@@ -991,6 +1595,12 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
+  BIND_SYNC(fast_forward_replayer) << [this](double time) -> R<double>
+  {
+    REQUIRE_CARLA_EPISODE();
+    return R<double>(Episode->GetRecorder()->FastForwardReplayer(time));
+  };
+
   BIND_SYNC(set_replayer_ignore_hero) << [this](bool ignore_hero) -> R<void>
   {
     REQUIRE_CARLA_EPISODE();
@@ -1036,6 +1646,8 @@ void FCarlaServer::FPimpl::BindActions()
           ActorId id = result.Get().id;
           auto set_id = carla::Functional::MakeOverload(
               [](C::SpawnActor &) {},
+              [](C::DrawDebugShapes &) {},
+              [](C::ApplyWalkerBatch &) {},
               [id](auto &s) { s.actor = id; });
           for (auto command : c.do_after)
           {
@@ -1057,18 +1669,95 @@ void FCarlaServer::FPimpl::BindActions()
       [=](auto, const C::SetSimulatePhysics &c) {   MAKE_RESULT(set_actor_simulate_physics(c.actor, c.enabled)); },
       // TODO: SetAutopilot should be removed. This is the old way to control the vehicles
       [=](auto, const C::SetAutopilot &c) {         MAKE_RESULT(set_actor_autopilot(c.actor, c.enabled)); },
-      [=](auto, const C::ApplyWalkerState &c) {     MAKE_RESULT(set_walker_state(c.actor, c.transform, c.speed)); });
+      [=](auto, const C::ApplyWalkerState &c) {     MAKE_RESULT(set_walker_state(c.actor, c.transform, c.speed)); },
+      [=](auto, const C::ApplyWalkerBatch &c) -> CR {
+        if (Episode == nullptr)
+        {
+          return CR{carla::rpc::ResponseError("episode not ready")};
+        }
+        // Crowd updates race against walker destruction, dead walkers are
+        // expected; one registry pass prefetches the whole crowd and skips
+        // them without going through the full handlers.
+        std::vector<ActorId> WalkerIds;
+        WalkerIds.reserve(c.updates.size());
+        for (const auto &Update : c.updates)
+        {
+          WalkerIds.push_back(Update.walker);
+        }
+        auto Views = Episode->GetActorRegistry().FindMany(WalkerIds);
+        for (auto i = 0u; i < c.updates.size(); ++i)
+        {
+          if (!Views[i].IsValid())
+          {
+            continue;
+          }
+          const auto &Update = c.updates[i];
+          set_walker_state(Update.walker, Update.transform, Update.speed);
+          if (!Update.bones.bone_transforms.empty())
+          {
+            apply_bone_control_to_walker(Update.walker, Update.bones);
+          }
+        }
+        return CR{ActorId(0u)};
+      },
+      [=](auto, const C::DrawDebugShapes &c) -> CR {
+        auto *World = Episode != nullptr ? Episode->GetWorld() : nullptr;
+        if (World == nullptr)
+        {
+          return CR{carla::rpc::ResponseError("unable to draw debug shapes: episode not ready")};
+        }
+        FDebugShapeDrawer Drawer(*World);
+        for (const auto &Shape : c.shapes)
+        {
+          Drawer.Draw(Shape);
+        }
+        return CR{ActorId(0u)};
+      });
 
 #undef MAKE_RESULT
 
+  // Substitute "result of command i" references (see C::FromBatchIndex)
+  // with the actor id that command produced; unresolved references make
+  // the command fail with an actor-not-found error.
+  auto resolve_references = [](const std::vector<CR> &result, cr::Command &command)
+  {
+    auto resolve_id = [&result](ActorId &id)
+    {
+      if (C::IsBatchIndex(id))
+      {
+        const auto index = C::GetBatchIndex(id);
+        if ((index < result.size()) && !result[index].HasError())
+        {
+          id = result[index].Get();
+        }
+      }
+    };
+    auto visitor = carla::Functional::MakeOverload(
+        [&](C::SpawnActor &c) { if (c.parent.has_value()) { resolve_id(*c.parent); } },
+        [](C::DrawDebugShapes &) {},
+        [](C::ApplyWalkerBatch &) {},
+        [&](auto &c) { resolve_id(c.actor); });
+    boost::apply_visitor(visitor, command.command);
+  };
+
+  // The batch arrives as a cr::CommandBatch view over the raw msgpack
+  // array: each command is decoded into reusable storage right before it is
+  // applied, instead of materializing (and then copying around) a full
+  // std::vector<cr::Command>. At 60 Hz traffic-manager batches with
+  // hundreds of vehicles that intermediate tree is a steady game-thread
+  // tax.
   BIND_SYNC(apply_batch) << [=](
-      const std::vector<cr::Command> &commands,
+      const cr::CommandBatch &commands,
       bool do_tick_cue)
   {
+    const auto count = commands.size();
     std::vector<CR> result;
-    result.reserve(commands.size());
-    for (const auto &command : commands)
+    result.reserve(count);
+    cr::Command command;
+    for (auto i = 0u; i < count; ++i)
     {
+      commands.DecodeInto(i, command);
+      resolve_references(result, command);
       result.emplace_back(boost::apply_visitor(command_visitor, command.command));
     }
     if (do_tick_cue)
@@ -1078,28 +1767,148 @@ void FCarlaServer::FPimpl::BindActions()
     return result;
   };
 
+  BIND_ASYNC(apply_batch_deferred) << [this](
+      const cr::CommandBatch &commands,
+      bool do_tick_cue)
+  {
+    // Runs on a worker thread: decode the batch straight into its commit
+    // storage (skipping the intermediate vector a typed argument would
+    // materialize), validate the spawn blueprints against the frame
+    // snapshot without touching the game thread, then hand the batch over
+    // to ProcessDeferredBatches and hold the response back until every
+    // command has been committed.
+    auto Batch = std::make_shared<FDeferredBatch>();
+    Batch->Commands.resize(commands.size());
+    for (auto i = 0u; i < commands.size(); ++i)
+    {
+      commands.DecodeInto(i, Batch->Commands[i]);
+    }
+    Batch->PrevalidationErrors.resize(commands.size());
+    Batch->Result.reserve(commands.size());
+    Batch->bTickCueOnDone = do_tick_cue;
+    auto Snapshot = FrameSnapshot.load();
+    if (Snapshot != nullptr)
+    {
+      std::unordered_set<std::string> Definitions;
+      Definitions.reserve(Snapshot->ActorDefinitions->size());
+      for (const auto &Definition : *Snapshot->ActorDefinitions)
+      {
+        Definitions.emplace(Definition.id);
+      }
+      auto get_description = carla::Functional::MakeOverload(
+          [](const cr::Command::SpawnActor &c) { return &c.description; },
+          [](const auto &) -> const cr::ActorDescription * { return nullptr; });
+      for (auto i = 0u; i < Batch->Commands.size(); ++i)
+      {
+        auto *Description = boost::apply_visitor(get_description, Batch->Commands[i].command);
+        if ((Description != nullptr) && (Definitions.count(Description->id) == 0u))
+        {
+          Batch->PrevalidationErrors[i] = "actor blueprint not found: " + Description->id;
+        }
+      }
+    }
+    std::unique_lock<std::mutex> Lock(DeferredBatchMutex);
+    DeferredBatches.emplace_back(Batch);
+    DeferredBatchDone.wait(Lock, [&]() {
+      return Batch->bDone || bShuttingDown.load();
+    });
+    return std::move(Batch->Result);
+  };
+
+  // Committed a slice at a time from FCarlaServer::RunSome, reusing the
+  // batch command visitor bound above; see apply_batch_deferred.
+  ProcessDeferredBatches = [=](double BudgetSeconds)
+  {
+    std::shared_ptr<FDeferredBatch> Batch;
+    {
+      std::lock_guard<std::mutex> Lock(DeferredBatchMutex);
+      if (DeferredBatches.empty())
+      {
+        return;
+      }
+      Batch = DeferredBatches.front();
+    }
+    const double StartTime = FPlatformTime::Seconds();
+    while (Batch->NextCommand < Batch->Commands.size())
+    {
+      const auto index = Batch->NextCommand++;
+      if (!Batch->PrevalidationErrors[index].empty())
+      {
+        Batch->Result.emplace_back(carla::rpc::ResponseError(Batch->PrevalidationErrors[index]));
+      }
+      else
+      {
+        auto patched = Batch->Commands[index];
+        resolve_references(Batch->Result, patched);
+        Batch->Result.emplace_back(boost::apply_visitor(command_visitor, patched.command));
+      }
+      if ((FPlatformTime::Seconds() - StartTime) > BudgetSeconds)
+      {
+        break;
+      }
+    }
+    if (Batch->NextCommand == Batch->Commands.size())
+    {
+      if (Batch->bTickCueOnDone)
+      {
+        tick_cue();
+      }
+      std::lock_guard<std::mutex> Lock(DeferredBatchMutex);
+      DeferredBatches.pop_front();
+      Batch->bDone = true;
+      DeferredBatchDone.notify_all();
+    }
+  };
+
   // ~~ Light Subsystem ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(query_lights_state) << [this](std::string client) -> R<std::vector<cr::LightState>>
+  BIND_READ(query_lights_state) << [this](std::string client) -> R<std::vector<cr::LightState>>
   {
-    REQUIRE_CARLA_EPISODE();
+    auto Snapshot = FrameSnapshot.load();
+    if (Snapshot == nullptr) { RESPOND_ERROR("episode not ready"); }
     std::vector<cr::LightState> result;
-    auto *World = Episode->GetWorld();
-    if(World) {
-      UCarlaLightSubsystem* CarlaLightSubsystem = World->GetSubsystem<UCarlaLightSubsystem>();
-      result = CarlaLightSubsystem->GetLights(FString(client.c_str()));
+    if (Snapshot->Lights != nullptr)
+    {
+      std::lock_guard<std::mutex> Lock(LightClientsMutex);
+      auto It = LightClientRevisions.find(client);
+      if (It == LightClientRevisions.end())
+      {
+        // First query of this client, ship the whole state
+        for (const auto &Light : *Snapshot->Lights)
+        {
+          result.push_back(Light.second);
+        }
+        LightClientRevisions.emplace(client, Snapshot->LightsRevision);
+      }
+      else
+      {
+        // Only the lights changed since the revision it was served last
+        for (const auto &Light : *Snapshot->Lights)
+        {
+          if (Light.first > It->second)
+          {
+            result.push_back(Light.second);
+          }
+        }
+        It->second = Snapshot->LightsRevision;
+      }
     }
     return result;
   };
 
   BIND_SYNC(update_lights_state) << [this]
-    (std::string client, const std::vector<cr::LightState>& lights, bool discard_client) -> R<void>
+    (std::string client, const std::vector<cr::LightStateDelta>& lights, bool discard_client) -> R<void>
   {
     REQUIRE_CARLA_EPISODE();
     auto *World = Episode->GetWorld();
     if(World) {
       UCarlaLightSubsystem* CarlaLightSubsystem = World->GetSubsystem<UCarlaLightSubsystem>();
-      CarlaLightSubsystem->SetLights(FString(client.c_str()), lights, discard_client);
+      CarlaLightSubsystem->SetLights(lights);
+    }
+    if (discard_client)
+    {
+      std::lock_guard<std::mutex> Lock(LightClientsMutex);
+      LightClientRevisions.erase(client);
     }
     return R<void>::Success();
   };
@@ -1118,6 +1927,89 @@ void FCarlaServer::FPimpl::BindActions()
 #undef RESPOND_ERROR
 #undef CARLA_ENSURE_GAME_THREAD
 
+// =============================================================================
+// -- Frame snapshot -----------------------------------------------------------
+// =============================================================================
+
+void FCarlaServer::FPimpl::RefreshFrameSnapshot()
+{
+  if (Episode == nullptr)
+  {
+    FrameSnapshot.reset();
+    return;
+  }
+  auto Previous = FrameSnapshot.load();
+  auto Snapshot = std::make_shared<FFrameSnapshot>();
+  Snapshot->EpisodeInfo.id = Episode->GetId();
+  Snapshot->EpisodeInfo.token = BroadcastStream.token();
+  Snapshot->EpisodeInfo.episode_slot = EpisodeSlot;
+  Snapshot->Settings = carla::rpc::EpisodeSettings{Episode->GetSettings()};
+  auto *Weather = Episode->GetWeather();
+  if (Weather != nullptr)
+  {
+    Snapshot->Weather = Weather->GetCurrentWeather();
+  }
+  const auto &Registry = Episode->GetActorRegistry();
+  Snapshot->RegistryVersion = Registry.GetVersion();
+  const bool bSameEpisode =
+      (Previous != nullptr) && (Previous->EpisodeInfo.id == Snapshot->EpisodeInfo.id);
+  // Serializing the registry is the expensive part, share the maps of the
+  // previous snapshot while nothing changed.
+  if (bSameEpisode && !bActorInfoDirty &&
+      (Previous->RegistryVersion == Snapshot->RegistryVersion))
+  {
+    Snapshot->Actors = Previous->Actors;
+  }
+  else
+  {
+    auto Actors = std::make_shared<FFrameSnapshot::FActorMap>();
+    Actors->reserve(static_cast<size_t>(Registry.Num()));
+    for (const FActorView &View : Registry)
+    {
+      if (View.IsValid())
+      {
+        Actors->emplace(View.GetActorId(), Episode->SerializeActor(View));
+      }
+    }
+    Snapshot->Actors = std::move(Actors);
+  }
+  bActorInfoDirty = false;
+  if (bSameEpisode)
+  {
+    Snapshot->ActorDefinitions = Previous->ActorDefinitions;
+  }
+  else
+  {
+    Snapshot->ActorDefinitions =
+        std::make_shared<const std::vector<carla::rpc::ActorDefinition>>(
+            MakeVectorFromTArray<carla::rpc::ActorDefinition>(Episode->GetActorDefinitions()));
+  }
+  auto SpectatorView = Episode->FindActor(Episode->GetSpectatorPawn());
+  if (SpectatorView.IsValid())
+  {
+    Snapshot->Spectator = Episode->SerializeActor(SpectatorView);
+    Snapshot->HasSpectator = true;
+  }
+  auto *World = Episode->GetWorld();
+  auto *LightSubsystem = (World != nullptr) ? World->GetSubsystem<UCarlaLightSubsystem>() : nullptr;
+  if (LightSubsystem != nullptr)
+  {
+    Snapshot->LightsRevision = LightSubsystem->GetLightsRevision();
+    if (bSameEpisode && (Previous->LightsRevision == Snapshot->LightsRevision) &&
+        (Previous->Lights != nullptr))
+    {
+      Snapshot->Lights = Previous->Lights;
+    }
+    else
+    {
+      auto Lights = std::make_shared<std::vector<std::pair<uint64, carla::rpc::LightState>>>();
+      LightSubsystem->GetLightsSnapshot(*Lights);
+      Snapshot->Lights = std::move(Lights);
+    }
+  }
+  FrameSnapshot = Snapshot;
+}
+
 // =============================================================================
 // -- FCarlaServer -------------------------------------------------------
 // =============================================================================
@@ -1139,6 +2031,56 @@ FDataMultiStream FCarlaServer::Start(uint16_t RPCPort, uint16_t StreamingPort)
   return Pimpl->BroadcastStream;
 }
 
+std::shared_ptr<FFilteredWorldStreams> FCarlaServer::GetFilteredWorldStreams() const
+{
+  check(Pimpl != nullptr);
+  return Pimpl->FilteredWorldStreams;
+}
+
+void FCarlaServer::FlushPendingPhysicsUpdates()
+{
+  check(Pimpl != nullptr);
+  if (Pimpl->PendingPhysicsUpdates.empty() || (Pimpl->Episode == nullptr))
+  {
+    Pimpl->PendingPhysicsUpdates.clear();
+    return;
+  }
+  auto Updates = std::move(Pimpl->PendingPhysicsUpdates);
+  Pimpl->PendingPhysicsUpdates.clear();
+  bool bPhysicsControlChanged = false;
+  for (auto &Pair : Updates)
+  {
+    auto ActorView = Pimpl->Episode->FindActor(Pair.first);
+    if (!ActorView.IsValid())
+    {
+      // The actor was destroyed after the update was queued.
+      continue;
+    }
+    if (Pair.second.SimulatePhysics.IsSet())
+    {
+      auto *RootComponent = Cast<UPrimitiveComponent>(ActorView.GetActor()->GetRootComponent());
+      if (RootComponent != nullptr)
+      {
+        RootComponent->SetSimulatePhysics(Pair.second.SimulatePhysics.GetValue());
+      }
+    }
+    if (Pair.second.PhysicsControl.IsSet())
+    {
+      auto *Vehicle = Cast<ACarlaWheeledVehicle>(ActorView.GetActor());
+      if (Vehicle != nullptr)
+      {
+        Vehicle->ApplyVehiclePhysicsControl(
+            FVehiclePhysicsControl(Pair.second.PhysicsControl.GetValue()));
+        bPhysicsControlChanged = true;
+      }
+    }
+  }
+  if (bPhysicsControlChanged)
+  {
+    Pimpl->Episode->BumpPhysicsControlRevision();
+  }
+}
+
 void FCarlaServer::NotifyBeginEpisode(UCarlaEpisode &Episode)
 {
   check(Pimpl != nullptr);
@@ -1150,6 +2092,49 @@ void FCarlaServer::NotifyEndEpisode()
 {
   check(Pimpl != nullptr);
   Pimpl->Episode = nullptr;
+  Pimpl->PendingPhysicsUpdates.clear();
+  // the revision counter restarts with the new episode's light subsystem
+  std::lock_guard<std::mutex> Lock(Pimpl->LightClientsMutex);
+  Pimpl->LightClientRevisions.clear();
+}
+
+bool FCarlaServer::IsLightUpdatePending() const
+{
+  check(Pimpl != nullptr);
+  auto Snapshot = Pimpl->FrameSnapshot.load();
+  if (Snapshot == nullptr)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> Lock(Pimpl->LightClientsMutex);
+  for (const auto &Client : Pimpl->LightClientRevisions)
+  {
+    if (Client.second < Snapshot->LightsRevision)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FCarlaServer::RecordFrameSection(FFrameStatsRecorder::ESection Section, double Seconds)
+{
+  check(Pimpl != nullptr);
+  Pimpl->FrameStats.Record(Section, Seconds);
+}
+
+void FCarlaServer::CommitFrameStats()
+{
+  check(Pimpl != nullptr);
+  Pimpl->FrameStats.CommitFrame();
+}
+
+void FCarlaServer::NotifyTickBroadcast(uint64 FrameNumber)
+{
+  check(Pimpl != nullptr);
+  std::lock_guard<std::mutex> Lock(Pimpl->SyncTickMutex);
+  Pimpl->LastBroadcastFrame = FrameNumber;
+  Pimpl->SyncTickCondition.notify_all();
 }
 
 void FCarlaServer::AsyncRun(uint32 NumberOfWorkerThreads)
@@ -1158,12 +2143,31 @@ void FCarlaServer::AsyncRun(uint32 NumberOfWorkerThreads)
   /// @todo Define better the number of threads each server gets.
   auto RPCThreads = NumberOfWorkerThreads / 2u;
   auto StreamingThreads = NumberOfWorkerThreads - RPCThreads;
+  // On multi-socket hosts the streaming workers should live on the node of
+  // the NIC, next to the render threads feeding them; otherwise every sensor
+  // buffer crosses the interconnect.
+  if (const char *NumaNode = std::getenv("CARLA_STREAMING_NUMA_NODE"))
+  {
+    const auto Node = std::atoll(NumaNode);
+    if (Node >= 0)
+    {
+      UE_LOG(LogCarlaServer, Log, TEXT("placing streaming workers on NUMA node %lld"), Node);
+      Pimpl->StreamingServer.SetNumaNode(static_cast<size_t>(Node));
+    }
+  }
   Pimpl->Server.AsyncRun(std::max(2u, RPCThreads));
   Pimpl->StreamingServer.AsyncRun(std::max(2u, StreamingThreads));
 }
 
 void FCarlaServer::RunSome(uint32 Milliseconds)
 {
+  // Budget per slice for committing deferred batches: enough for several
+  // actor spawns per frame so a big batch drains well within the client RPC
+  // timeout, while the world keeps ticking in between.
+  constexpr double DeferredBatchBudgetSeconds = 20e-3;
+  Pimpl->ProcessDeferredBatches(DeferredBatchBudgetSeconds);
+  // Refresh after committing so the new actors appear in the snapshot.
+  Pimpl->RefreshFrameSnapshot();
   Pimpl->Server.SyncRunFor(carla::time_duration::milliseconds(Milliseconds));
 }
 
@@ -1177,9 +2181,26 @@ bool FCarlaServer::TickCueReceived()
   return false;
 }
 
+double FCarlaServer::ConsumeFrameDeadline()
+{
+  return Pimpl->PendingFrameDeadlineSeconds.exchange(0.0);
+}
+
 void FCarlaServer::Stop()
 {
   check(Pimpl != nullptr);
+  // Release the worker threads blocked in tick_cue_fused and
+  // apply_batch_deferred before stopping the server, they hold rpclib
+  // sessions open.
+  Pimpl->bShuttingDown = true;
+  {
+    std::lock_guard<std::mutex> Lock(Pimpl->SyncTickMutex);
+    Pimpl->SyncTickCondition.notify_all();
+  }
+  {
+    std::lock_guard<std::mutex> Lock(Pimpl->DeferredBatchMutex);
+    Pimpl->DeferredBatchDone.notify_all();
+  }
   Pimpl->Server.Stop();
 }
 
@@ -8,10 +8,14 @@
 
 #include "Carla/Actor/ActorView.h"
 #include "Carla/Sensor/DataStream.h"
+#include "Carla/Util/FrameStatsRecorder.h"
 
 #include "CoreMinimal.h"
 
+#include <memory>
+
 class UCarlaEpisode;
+class FFilteredWorldStreams;
 
 class FCarlaServer
 {
@@ -27,16 +31,49 @@ public:
 
   void NotifyEndEpisode();
 
+  /// Tell the server that the state broadcast of @a FrameNumber has been
+  /// sent; releases the clients whose fused tick cue triggered that frame.
+  /// Call from the game thread after the world-observer broadcast.
+  void NotifyTickBroadcast(uint64 FrameNumber);
+
+  /// Whether any known client of the light subsystem still has to query the
+  /// light states it was last told about.
+  bool IsLightUpdatePending() const;
+
+  /// Apply the physics mutations queued by the handlers since the last call,
+  /// coalesced per actor. Call from the game thread at the frame boundary,
+  /// before the world ticks.
+  void FlushPendingPhysicsUpdates();
+
+  /// Record one section of the current frame's time breakdown. Call from
+  /// the game thread; clients read the result via the get_frame_stats RPC.
+  void RecordFrameSection(FFrameStatsRecorder::ESection Section, double Seconds);
+
+  /// Close the current frame of the time breakdown, pushing its samples
+  /// into the rolling window. Call from the game thread once per frame.
+  void CommitFrameStats();
+
   void AsyncRun(uint32 NumberOfWorkerThreads);
 
   void RunSome(uint32 Milliseconds);
 
   bool TickCueReceived();
 
+  /// Deadline declared by the client that initiated the current frame with
+  /// tick_cue_deadline, in FPlatformTime::Seconds terms, or 0.0 when the
+  /// frame was cued without one. Consuming resets it, so it is read at most
+  /// once per frame; see FCarlaEngine::OnPostTick.
+  double ConsumeFrameDeadline();
+
   void Stop();
 
   FDataStream OpenStream() const;
 
+  /// Per-client filtered views of the world-observer stream, registered by
+  /// the subscribe_filtered_episode_state binding; hand them to the
+  /// FWorldObserver so it broadcasts them every tick.
+  std::shared_ptr<FFilteredWorldStreams> GetFilteredWorldStreams() const;
+
 private:
 
   class FPimpl;
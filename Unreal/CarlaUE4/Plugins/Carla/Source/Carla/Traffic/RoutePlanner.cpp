@@ -9,10 +9,12 @@
 
 #include "Util/RandomEngine.h"
 #include "Vehicle/CarlaWheeledVehicle.h"
+#include "Vehicle/VehicleAIBatchUpdater.h"
 #include "Vehicle/WheeledVehicleAIController.h"
 
-#include "Engine/CollisionProfile.h"
 #include "DrawDebugHelpers.h"
+#include "Engine/CollisionProfile.h"
+#include "EngineUtils.h"
 
 static bool IsSplineValid(const USplineComponent *SplineComponent)
 {
@@ -20,14 +22,6 @@ static bool IsSplineValid(const USplineComponent *SplineComponent)
          (SplineComponent->GetNumberOfSplinePoints() > 1);
 }
 
-static AWheeledVehicleAIController *GetVehicleController(AActor *Actor)
-{
-  auto *Vehicle = (Actor->IsPendingKill() ? nullptr : Cast<ACarlaWheeledVehicle>(Actor));
-  return (Vehicle != nullptr ?
-         Cast<AWheeledVehicleAIController>(Vehicle->GetController()) :
-         nullptr);
-}
-
 static const USplineComponent *PickARoute(
     URandomEngine &RandomEngine,
     const TArray<USplineComponent *> &Routes,
@@ -56,8 +50,10 @@ ARoutePlanner::ARoutePlanner(const FObjectInitializer &ObjectInitializer)
   TriggerVolume->SetupAttachment(RootComponent);
   TriggerVolume->SetHiddenInGame(true);
   TriggerVolume->SetMobility(EComponentMobility::Static);
-  TriggerVolume->SetCollisionProfileName(FName("OverlapAll"));
-  TriggerVolume->SetGenerateOverlapEvents(true);
+  // The volume is matched against vehicle positions through the spatial
+  // index, keep it out of the physics broadphase.
+  TriggerVolume->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+  TriggerVolume->SetGenerateOverlapEvents(false);
 
   // Do not change default value here, our autopilot depends on this.
   TriggerVolume->SetBoxExtent(FVector{32.0f, 32.0f, 32.0f});
@@ -164,10 +160,11 @@ void ARoutePlanner::Init()
     }
   }
 
-  // Register delegate on begin overlap.
-  if (!TriggerVolume->OnComponentBeginOverlap.IsAlreadyBound(this, &ARoutePlanner::OnTriggerBeginOverlap))
+  // Register the trigger volume in the spatial index of the world.
+  if (!bRegisteredInIndex)
   {
-    TriggerVolume->OnComponentBeginOverlap.AddDynamic(this, &ARoutePlanner::OnTriggerBeginOverlap);
+    AVehicleAIBatchUpdater::GetOrCreate(*GetWorld()).GetRoutePlannerIndex().Add(*this);
+    bRegisteredInIndex = true;
   }
 }
 
@@ -179,30 +176,24 @@ void ARoutePlanner::BeginPlay()
 
 void ARoutePlanner::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-  // Deregister the delegate.
-  if (TriggerVolume->OnComponentBeginOverlap.IsAlreadyBound(this, &ARoutePlanner::OnTriggerBeginOverlap))
+  // Deregister from the spatial index.
+  if (bRegisteredInIndex)
   {
-    TriggerVolume->OnComponentBeginOverlap.RemoveDynamic(this, &ARoutePlanner::OnTriggerBeginOverlap);
+    auto *World = GetWorld();
+    if (World != nullptr)
+    {
+      TActorIterator<AVehicleAIBatchUpdater> It(World);
+      if (It)
+      {
+        It->GetRoutePlannerIndex().Remove(*this);
+      }
+    }
+    bRegisteredInIndex = false;
   }
 
   Super::EndPlay(EndPlayReason);
 }
 
-void ARoutePlanner::OnTriggerBeginOverlap(
-    UPrimitiveComponent * /*OverlappedComp*/,
-    AActor *OtherActor,
-    UPrimitiveComponent * /*OtherComp*/,
-    int32 /*OtherBodyIndex*/,
-    bool /*bFromSweep*/,
-    const FHitResult & /*SweepResult*/)
-{
-  auto *Controller = GetVehicleController(OtherActor);
-  if (Controller != nullptr)
-  {
-    AssignRandomRoute(*Controller);
-  }
-}
-
 void ARoutePlanner::DrawRoutes()
 {
 #if WITH_EDITOR
@@ -19,6 +19,10 @@ class AWheeledVehicleAIController;
 /// volume. Routes must be added in editor after placing this actor into the
 /// world. Spline tangents are ignored, only locations are taken into account
 /// for making the route.
+///
+/// The trigger volume is static and takes no part in the physics broadphase;
+/// it is registered in the FRoutePlannerIndex of the world and vehicles are
+/// matched against it in one batched pass per frame.
 UCLASS()
 class CARLA_API ARoutePlanner : public AActor
 {
@@ -56,15 +60,6 @@ protected:
 
   virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
-  UFUNCTION()
-  void OnTriggerBeginOverlap(
-      UPrimitiveComponent *OverlappedComp,
-      AActor *OtherActor,
-      UPrimitiveComponent *OtherComp,
-      int32 OtherBodyIndex,
-      bool bFromSweep,
-      const FHitResult &SweepResult);
-
 public:
 
   UPROPERTY(EditAnywhere)
@@ -78,4 +73,9 @@ public:
 
   UPROPERTY(BlueprintReadWrite, Category = "Traffic Routes", EditAnywhere, EditFixedSize)
   bool bIsIntersection = false;
+
+private:
+
+  /// Whether the trigger volume is already in the world's spatial index.
+  bool bRegisteredInIndex = false;
 };
@@ -0,0 +1,80 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "Carla.h"
+#include "RoutePlannerIndex.h"
+
+#include "Traffic/RoutePlanner.h"
+
+#include "Components/BoxComponent.h"
+
+/// Size of a grid cell in centimeters; trigger volumes are a few meters at
+/// most, so each volume lands in a handful of cells.
+static constexpr float GridCellSize = 1000.0f;
+
+static FIntPoint GetCell(const float X, const float Y)
+{
+  return FIntPoint(
+      FMath::FloorToInt(X / GridCellSize),
+      FMath::FloorToInt(Y / GridCellSize));
+}
+
+void FRoutePlannerIndex::Add(ARoutePlanner &Planner)
+{
+  check(Planner.TriggerVolume != nullptr);
+  const auto &Volume = *Planner.TriggerVolume;
+
+  FEntry Entry;
+  Entry.Planner = &Planner;
+  Entry.WorldToVolume = Volume.GetComponentTransform().Inverse();
+  Entry.Extent = Volume.GetUnscaledBoxExtent();
+
+  const FBoxSphereBounds Bounds = Volume.Bounds;
+  const FIntPoint Min = GetCell(
+      Bounds.Origin.X - Bounds.BoxExtent.X,
+      Bounds.Origin.Y - Bounds.BoxExtent.Y);
+  const FIntPoint Max = GetCell(
+      Bounds.Origin.X + Bounds.BoxExtent.X,
+      Bounds.Origin.Y + Bounds.BoxExtent.Y);
+  for (auto CellX = Min.X; CellX <= Max.X; ++CellX)
+  {
+    for (auto CellY = Min.Y; CellY <= Max.Y; ++CellY)
+    {
+      Grid.FindOrAdd(FIntPoint(CellX, CellY)).Add(Entry);
+    }
+  }
+}
+
+void FRoutePlannerIndex::Remove(ARoutePlanner &Planner)
+{
+  for (auto &Item : Grid)
+  {
+    Item.Value.RemoveAllSwap([&Planner](const FEntry &Entry)
+    {
+      return Entry.Planner == &Planner;
+    });
+  }
+}
+
+ARoutePlanner *FRoutePlannerIndex::QueryPoint(const FVector &Location) const
+{
+  const auto *Cell = Grid.Find(GetCell(Location.X, Location.Y));
+  if (Cell == nullptr)
+  {
+    return nullptr;
+  }
+  for (const auto &Entry : *Cell)
+  {
+    const FVector Local = Entry.WorldToVolume.TransformPosition(Location);
+    if ((FMath::Abs(Local.X) <= Entry.Extent.X) &&
+        (FMath::Abs(Local.Y) <= Entry.Extent.Y) &&
+        (FMath::Abs(Local.Z) <= Entry.Extent.Z))
+    {
+      return Entry.Planner;
+    }
+  }
+  return nullptr;
+}
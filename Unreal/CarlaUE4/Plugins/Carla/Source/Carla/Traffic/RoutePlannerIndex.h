@@ -0,0 +1,46 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "Containers/Map.h"
+#include "Math/Transform.h"
+
+class ARoutePlanner;
+
+/// Spatial hash of the route planners' trigger volumes. The volumes never
+/// move, so instead of paying for their overlap pairs in the physics
+/// broadphase every frame, the planners insert themselves here once and the
+/// vehicles query the grid directly with their position.
+class FRoutePlannerIndex
+{
+public:
+
+  void Add(ARoutePlanner &Planner);
+
+  void Remove(ARoutePlanner &Planner);
+
+  /// Return the planner whose trigger volume contains @a Location, or
+  /// nullptr if there is none.
+  ARoutePlanner *QueryPoint(const FVector &Location) const;
+
+private:
+
+  struct FEntry
+  {
+    ARoutePlanner *Planner;
+
+    /// Inverse of the trigger volume's world transform; the containment
+    /// test runs in the volume's local space so rotated boxes work too.
+    FTransform WorldToVolume;
+
+    FVector Extent;
+  };
+
+  /// Cells of the grid covered by each volume's world-space bounds; a
+  /// volume spanning several cells has one entry per cell.
+  TMap<FIntPoint, TArray<FEntry>> Grid;
+};
@@ -128,14 +128,13 @@ void ATrafficLightManager::RegisterLightComponent(UTrafficLightComponent * Traff
 
 }
 
-const boost::optional<carla::road::Map>& ATrafficLightManager::GetMap()
+const std::shared_ptr<const carla::road::Map>& ATrafficLightManager::GetMap()
 {
-  if (!Map.has_value())
+  if (Map == nullptr)
   {
     FString MapName = GetWorld()->GetName();
-    std::string opendrive_xml = carla::rpc::FromFString(UOpenDrive::LoadXODR(MapName));
-    Map = carla::opendrive::OpenDriveParser::Load(opendrive_xml);
-    if (!Map.has_value()) {
+    Map = UOpenDrive::GetRoadMap(MapName);
+    if (Map == nullptr) {
       UE_LOG(LogCarla, Error, TEXT("Invalid Map"));
     }
   }
@@ -331,7 +330,7 @@ void ATrafficLightManager::SpawnTrafficLights()
     }
 
     RegisterLightComponent(TrafficLightComponent);
-    TrafficLightComponent->InitializeSign(GetMap().get());
+    TrafficLightComponent->InitializeSign(*GetMap());
   }
 }
 
@@ -371,7 +370,7 @@ void ATrafficLightManager::SpawnSignals()
       SignComponent->AttachToComponent(
           TrafficSign->GetRootComponent(),
           FAttachmentTransformRules::KeepRelativeTransform);
-      SignComponent->InitializeSign(GetMap().get());
+      SignComponent->InitializeSign(*GetMap());
 
       auto ClosestWaypointToSignal =
           GetMap()->GetClosestWaypointOnRoad(CarlaTransform.location);
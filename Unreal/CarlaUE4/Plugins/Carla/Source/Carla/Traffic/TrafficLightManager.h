@@ -27,7 +27,7 @@ public:
   UFUNCTION(BlueprintCallable)
   void RegisterLightComponent(UTrafficLightComponent * TrafficLight);
 
-  const boost::optional<carla::road::Map> &GetMap();
+  const std::shared_ptr<const carla::road::Map> &GetMap();
 
   UFUNCTION(BlueprintCallable)
   ATrafficLightGroup* GetTrafficGroup(int JunctionId);
@@ -92,7 +92,8 @@ private:
   UPROPERTY(Category = "Traffic Light Manager", VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
   USceneComponent *SceneComponent;
 
-  boost::optional<carla::road::Map> Map;
+  /// Shared with the process-wide UOpenDrive cache, never mutated.
+  std::shared_ptr<const carla::road::Map> Map;
 
   UPROPERTY()
   bool TrafficLightsGenerated = false;
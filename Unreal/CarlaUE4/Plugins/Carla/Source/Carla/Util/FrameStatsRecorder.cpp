@@ -0,0 +1,78 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "Carla.h"
+#include "Carla/Util/FrameStatsRecorder.h"
+
+#include <algorithm>
+#include <vector>
+
+/// Stable section identifiers exposed over RPC, indexed by ESection.
+static const char *FrameStatsRecorder_SectionNames[] = {
+  "frame_total",
+  "physics_flush",
+  "state_broadcast",
+  "serialization",
+  "world_tick",
+  "rpc_drain"
+};
+
+static_assert(
+    sizeof(FrameStatsRecorder_SectionNames) / sizeof(const char *) ==
+        static_cast<uint32>(FFrameStatsRecorder::ESection::SIZE),
+    "One name per section, in enum order.");
+
+void FFrameStatsRecorder::CommitFrame()
+{
+  const auto Slot = static_cast<uint32>(FrameCount % WINDOW_SIZE);
+  for (auto Section = 0u; Section < NUM_SECTIONS; ++Section)
+  {
+    Samples[Section][Slot] = static_cast<float>(CurrentFrame[Section] * 1e3);
+    CurrentFrame[Section] = 0.0;
+  }
+  ++FrameCount;
+}
+
+carla::rpc::FrameStats FFrameStatsRecorder::GetStats() const
+{
+  carla::rpc::FrameStats Stats;
+  Stats.frame_count = FrameCount;
+  const auto Count = static_cast<uint32>(
+      std::min<uint64>(FrameCount, WINDOW_SIZE));
+  Stats.window_size = Count;
+  if (Count == 0u)
+  {
+    return Stats;
+  }
+  const auto LastSlot = static_cast<uint32>((FrameCount - 1u) % WINDOW_SIZE);
+  std::vector<float> Sorted(Count);
+  Stats.sections.reserve(NUM_SECTIONS);
+  for (auto Section = 0u; Section < NUM_SECTIONS; ++Section)
+  {
+    carla::rpc::FrameSectionStats SectionStats;
+    SectionStats.name = FrameStatsRecorder_SectionNames[Section];
+    SectionStats.last_ms = Samples[Section][LastSlot];
+    double Sum = 0.0;
+    for (auto i = 0u; i < Count; ++i)
+    {
+      Sorted[i] = Samples[Section][i];
+      Sum += Samples[Section][i];
+    }
+    std::sort(Sorted.begin(), Sorted.end());
+    auto Percentile = [&](double Ratio)
+    {
+      const auto Index = static_cast<uint32>(
+          Ratio * static_cast<double>(Count - 1u));
+      return static_cast<double>(Sorted[Index]);
+    };
+    SectionStats.mean_ms = Sum / static_cast<double>(Count);
+    SectionStats.p50_ms = Percentile(0.5);
+    SectionStats.p90_ms = Percentile(0.9);
+    SectionStats.p99_ms = Percentile(0.99);
+    Stats.sections.emplace_back(std::move(SectionStats));
+  }
+  return Stats;
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2026 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <compiler/disable-ue4-macros.h>
+#include <carla/rpc/FrameStats.h>
+#include <compiler/enable-ue4-macros.h>
+
+/// Rolling breakdown of the server frame time among the stages of the main
+/// loop. Each frame the engine records one sample per section and commits
+/// the frame; samples are kept in a fixed window over which GetStats
+/// computes mean and percentiles. Record, CommitFrame, and GetStats must
+/// all be called from the game thread (the RPC handlers run there).
+class FFrameStatsRecorder
+{
+public:
+
+  enum class ESection : uint8
+  {
+    /// Start of one frame to start of the next.
+    FrameTotal = 0,
+    /// Coalesced physics mutations queued by RPC handlers.
+    PhysicsFlush,
+    /// World-observer state gathering and broadcast enqueue.
+    StateBroadcast,
+    /// Episode state serialization and stream hand-off, measured on its
+    /// worker thread; attributed to the frame in which the result is read.
+    Serialization,
+    /// The world tick itself: physics, actors, and sensor capture.
+    WorldTick,
+    /// The RunSome loop draining RPC handlers after the tick.
+    RpcDrain,
+
+    SIZE
+  };
+
+  /// Record @a Seconds spent in @a Section of the current frame. Recording
+  /// the same section twice in one frame keeps the last sample.
+  void Record(ESection Section, double Seconds)
+  {
+    CurrentFrame[static_cast<uint32>(Section)] = Seconds;
+  }
+
+  /// Close the current frame, pushing its samples into the rolling window.
+  void CommitFrame();
+
+  /// Rolling statistics over the committed frames, most recent window only.
+  carla::rpc::FrameStats GetStats() const;
+
+private:
+
+  /// Frames covered by the rolling statistics.
+  static constexpr uint32 WINDOW_SIZE = 512u;
+
+  static constexpr uint32 NUM_SECTIONS = static_cast<uint32>(ESection::SIZE);
+
+  /// Sections of the frame being recorded, in seconds.
+  double CurrentFrame[NUM_SECTIONS] = {};
+
+  /// Committed samples per section, in milliseconds, ring-indexed by
+  /// FrameCount % WINDOW_SIZE.
+  float Samples[NUM_SECTIONS][WINDOW_SIZE] = {};
+
+  uint64 FrameCount = 0u;
+};
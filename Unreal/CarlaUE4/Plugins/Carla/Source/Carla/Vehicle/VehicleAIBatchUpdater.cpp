@@ -0,0 +1,160 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "Carla.h"
+#include "Carla/Vehicle/VehicleAIBatchUpdater.h"
+
+#include "Carla/Traffic/RoutePlanner.h"
+#include "Carla/Vehicle/CarlaWheeledVehicle.h"
+#include "Carla/Vehicle/WheeledVehicleAIController.h"
+
+#include "EngineUtils.h"
+
+#include <cmath>
+
+/// Convert the movement component's forward speed (cm/s) to km/h.
+static constexpr float CMS_TO_KMH = 0.036f;
+
+AVehicleAIBatchUpdater::AVehicleAIBatchUpdater(const FObjectInitializer &ObjectInitializer)
+  : Super(ObjectInitializer)
+{
+  PrimaryActorTick.bCanEverTick = true;
+  PrimaryActorTick.TickGroup = TG_PrePhysics;
+}
+
+AVehicleAIBatchUpdater &AVehicleAIBatchUpdater::GetOrCreate(UWorld &World)
+{
+  TActorIterator<AVehicleAIBatchUpdater> It(&World);
+  if (It)
+  {
+    return **It;
+  }
+  auto *Updater = World.SpawnActor<AVehicleAIBatchUpdater>();
+  check(Updater != nullptr);
+  return *Updater;
+}
+
+void AVehicleAIBatchUpdater::RegisterController(AWheeledVehicleAIController *Controller)
+{
+  check(Controller != nullptr);
+  Controllers.AddUnique(Controller);
+}
+
+void AVehicleAIBatchUpdater::UnregisterController(AWheeledVehicleAIController *Controller)
+{
+  Controllers.RemoveSwap(Controller);
+}
+
+void AVehicleAIBatchUpdater::Tick(const float DeltaTime)
+{
+  Super::Tick(DeltaTime);
+
+  // Route assignment pass: match every vehicle against the static index of
+  // route-planner volumes, assigning a new route on entry. This replaces the
+  // planners' physics begin-overlap events.
+  for (auto *Controller : Controllers)
+  {
+    if (!Controller->IsPossessingAVehicle())
+    {
+      continue;
+    }
+    auto *Planner = RoutePlannerIndex.QueryPoint(
+        Controller->GetPossessedVehicle()->GetActorLocation());
+    if (Planner != Controller->GetCurrentRoutePlanner())
+    {
+      Controller->SetCurrentRoutePlanner(Planner);
+      if (Planner != nullptr)
+      {
+        Planner->AssignRandomRoute(*Controller);
+      }
+    }
+  }
+
+  // First pass: gather pose, target, and limits of every controller with an
+  // active route into flat arrays. One row per vehicle, same index in every
+  // array.
+  ActiveControllers.Reset();
+  PosX.Reset();
+  PosY.Reset();
+  ForwardX.Reset();
+  ForwardY.Reset();
+  TargetX.Reset();
+  TargetY.Reset();
+  SpeedKmh.Reset();
+  SpeedLimitKmh.Reset();
+  MaxSteerRadians.Reset();
+  MustStop.Reset();
+  for (auto *Controller : Controllers)
+  {
+    if (!Controller->IsPossessingAVehicle() || !Controller->IsAutopilotEnabled())
+    {
+      continue;
+    }
+    auto *Vehicle = Controller->GetPossessedVehicle();
+    const FVector Location = Vehicle->GetActorLocation();
+    FVector Target;
+    if (!Controller->PeekNextTarget(Location, Target))
+    {
+      continue;
+    }
+    const FVector Forward = Vehicle->GetVehicleOrientation();
+    ActiveControllers.Add(Controller);
+    PosX.Add(Location.X);
+    PosY.Add(Location.Y);
+    ForwardX.Add(Forward.X);
+    ForwardY.Add(Forward.Y);
+    TargetX.Add(Target.X);
+    TargetY.Add(Target.Y);
+    SpeedKmh.Add(CMS_TO_KMH * Vehicle->GetVehicleForwardSpeed());
+    SpeedLimitKmh.Add(Controller->GetSpeedLimit());
+    MaxSteerRadians.Add(FMath::DegreesToRadians(Vehicle->GetMaximumSteerAngle()));
+    MustStop.Add(Controller->GetTrafficLightState() != ETrafficLightState::Green ? 1u : 0u);
+  }
+
+  // Second pass: the pure-pursuit kernel. A single branch-free loop over the
+  // flat arrays, no UObject access, so the compiler can vectorize it.
+  const int32 Num = ActiveControllers.Num();
+  OutSteer.SetNumUninitialized(Num, false);
+  OutThrottle.SetNumUninitialized(Num, false);
+  OutBrake.SetNumUninitialized(Num, false);
+  for (int32 i = 0; i < Num; ++i)
+  {
+    const float Dx = TargetX[i] - PosX[i];
+    const float Dy = TargetY[i] - PosY[i];
+    const float Along = ForwardX[i] * Dx + ForwardY[i] * Dy;
+    const float Across = ForwardX[i] * Dy - ForwardY[i] * Dx;
+    const float SteerAngle = std::atan2(Across, Along);
+    OutSteer[i] = FMath::Clamp(SteerAngle / MaxSteerRadians[i], -1.0f, 1.0f);
+    const bool bStop = (MustStop[i] != 0u);
+    OutThrottle[i] = (!bStop && (SpeedKmh[i] < SpeedLimitKmh[i])) ? 1.0f : 0.0f;
+    OutBrake[i] = bStop ? 1.0f : 0.0f;
+  }
+
+  // Third pass: apply the computed controls, and flush every possessed
+  // vehicle's control exactly once; the controllers themselves do not tick.
+  for (int32 i = 0; i < Num; ++i)
+  {
+    FVehicleControl Control;
+    Control.Steer = OutSteer[i];
+    Control.Throttle = OutThrottle[i];
+    Control.Brake = OutBrake[i];
+    ActiveControllers[i]->GetPossessedVehicle()->ApplyVehicleControl(
+        Control, EVehicleInputPriority::Autopilot);
+  }
+  for (auto *Controller : Controllers)
+  {
+    if (!Controller->IsPossessingAVehicle())
+    {
+      continue;
+    }
+    auto *Vehicle = Controller->GetPossessedVehicle();
+    if (!Controller->IsAutopilotEnabled() && !Controller->IsControlSticky())
+    {
+      Vehicle->ApplyVehicleControl(FVehicleControl{}, EVehicleInputPriority::Relaxation);
+    }
+    Vehicle->FlushVehicleControl();
+  }
+}
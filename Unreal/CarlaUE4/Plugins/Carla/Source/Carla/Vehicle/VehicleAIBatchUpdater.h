@@ -0,0 +1,83 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+
+#include "Traffic/RoutePlannerIndex.h"
+
+#include "VehicleAIBatchUpdater.generated.h"
+
+class AWheeledVehicleAIController;
+
+/// Updates every AWheeledVehicleAIController of the world in a single tick.
+///
+/// The controllers' poses and current route targets are gathered into
+/// struct-of-arrays buffers, steering and throttle are computed for all of
+/// them with one pure-pursuit kernel over those flat arrays, and the
+/// resulting controls are applied back through a single control-apply loop.
+/// This replaces one UObject tick per controller, whose dispatch overhead
+/// costs more than the steering math with hundreds of background vehicles.
+UCLASS()
+class CARLA_API AVehicleAIBatchUpdater : public AActor
+{
+  GENERATED_BODY()
+
+public:
+
+  AVehicleAIBatchUpdater(const FObjectInitializer &ObjectInitializer);
+
+  /// Return the batch updater of the world, spawning it on first use.
+  static AVehicleAIBatchUpdater &GetOrCreate(UWorld &World);
+
+  /// Controllers register themselves on possession; registered controllers
+  /// no longer tick on their own.
+  void RegisterController(AWheeledVehicleAIController *Controller);
+
+  void UnregisterController(AWheeledVehicleAIController *Controller);
+
+  /// Spatial index of the route planners' trigger volumes, queried with the
+  /// vehicles' positions instead of generating physics overlap events.
+  FRoutePlannerIndex &GetRoutePlannerIndex()
+  {
+    return RoutePlannerIndex;
+  }
+
+  virtual void Tick(float DeltaTime) override;
+
+private:
+
+  FRoutePlannerIndex RoutePlannerIndex;
+
+  UPROPERTY()
+  TArray<AWheeledVehicleAIController *> Controllers;
+
+  /// Controllers with an active autopilot route this tick, row i of the
+  /// batch arrays belongs to ActiveControllers[i].
+  TArray<AWheeledVehicleAIController *> ActiveControllers;
+
+  /// @name Struct-of-arrays buffers of the batch pass, kept allocated
+  /// between ticks.
+  /// @{
+
+  TArray<float> PosX;
+  TArray<float> PosY;
+  TArray<float> ForwardX;
+  TArray<float> ForwardY;
+  TArray<float> TargetX;
+  TArray<float> TargetY;
+  TArray<float> SpeedKmh;
+  TArray<float> SpeedLimitKmh;
+  TArray<float> MaxSteerRadians;
+  TArray<uint8> MustStop;
+
+  TArray<float> OutSteer;
+  TArray<float> OutThrottle;
+  TArray<float> OutBrake;
+
+  /// @}
+};
@@ -10,6 +10,7 @@
 #include "MapGen/RoadMap.h"
 #include "Traffic/RoutePlanner.h"
 #include "Vehicle/CarlaWheeledVehicle.h"
+#include "Vehicle/VehicleAIBatchUpdater.h"
 
 #include "EngineUtils.h"
 #include "GameFramework/Pawn.h"
@@ -87,8 +88,9 @@ AWheeledVehicleAIController::AWheeledVehicleAIController(const FObjectInitialize
 
   RandomEngine->Seed(RandomEngine->GenerateRandomSeed());
 
-  PrimaryActorTick.bCanEverTick = true;
-  PrimaryActorTick.TickGroup = TG_PrePhysics;
+  // These controllers do not tick on their own, AVehicleAIBatchUpdater
+  // updates all of them in a single pass.
+  PrimaryActorTick.bCanEverTick = false;
 }
 
 AWheeledVehicleAIController::~AWheeledVehicleAIController() {}
@@ -117,6 +119,8 @@ void AWheeledVehicleAIController::OnPossess(APawn *aPawn)
     TActorIterator<ACityMapGenerator> It(GetWorld());
     RoadMap = (It ? It->GetRoadMap() : nullptr);
   }
+
+  AVehicleAIBatchUpdater::GetOrCreate(*GetWorld()).RegisterController(this);
 }
 
 void AWheeledVehicleAIController::OnUnPossess()
@@ -124,23 +128,16 @@ void AWheeledVehicleAIController::OnUnPossess()
   Super::OnUnPossess();
 
   Vehicle = nullptr;
-}
-
-void AWheeledVehicleAIController::Tick(const float DeltaTime)
-{
-  Super::Tick(DeltaTime);
-
-  if (!IsPossessingAVehicle())
-  {
-    return;
-  }
 
-  if (!bAutopilotEnabled && !bControlIsSticky)
+  auto *World = GetWorld();
+  if (World != nullptr)
   {
-    Vehicle->ApplyVehicleControl(FVehicleControl{}, EVehicleInputPriority::Relaxation);
+    TActorIterator<AVehicleAIBatchUpdater> It(World);
+    if (It)
+    {
+      It->UnregisterController(this);
+    }
   }
-
-  Vehicle->FlushVehicleControl();
 }
 
 // =============================================================================
@@ -185,3 +182,21 @@ void AWheeledVehicleAIController::SetFixedRoute(
     TargetLocations.emplace(Location);
   }
 }
+
+bool AWheeledVehicleAIController::PeekNextTarget(
+    const FVector &CurrentLocation,
+    FVector &OutTarget)
+{
+  // Pop the targets already reached.
+  while (!TargetLocations.empty() &&
+         FVector::Dist2D(TargetLocations.front(), CurrentLocation) < 200.0f)
+  {
+    TargetLocations.pop();
+  }
+  if (TargetLocations.empty())
+  {
+    return false;
+  }
+  OutTarget = TargetLocations.front();
+  return true;
+}
@@ -16,6 +16,7 @@
 #include "WheeledVehicleAIController.generated.h"
 
 class ACarlaWheeledVehicle;
+class ARoutePlanner;
 class URandomEngine;
 class URoadMap;
 
@@ -48,8 +49,6 @@ public:
 
   void OnUnPossess() override;
 
-  void Tick(float DeltaTime) override;
-
   /// @}
   // ===========================================================================
   /// @name Possessed vehicle
@@ -87,6 +86,11 @@ public:
     bControlIsSticky = bEnabled;
   }
 
+  bool IsControlSticky() const
+  {
+    return bControlIsSticky;
+  }
+
   /// @}
   // ===========================================================================
   /// @name Road map
@@ -208,6 +212,25 @@ public:
   UFUNCTION(Category = "Wheeled Vehicle Controller", BlueprintCallable)
   void SetFixedRoute(const TArray<FVector> &Locations, bool bOverwriteCurrent = true);
 
+  /// Route planner whose trigger volume the vehicle is currently inside;
+  /// tracked by AVehicleAIBatchUpdater to emulate begin-overlap semantics
+  /// without the physics broadphase.
+  ARoutePlanner *GetCurrentRoutePlanner() const
+  {
+    return CurrentRoutePlanner;
+  }
+
+  void SetCurrentRoutePlanner(ARoutePlanner *InRoutePlanner)
+  {
+    CurrentRoutePlanner = InRoutePlanner;
+  }
+
+  /// Retrieve in @a OutTarget the next target of the fixed route, popping
+  /// the targets already reached from @a CurrentLocation. Returns false if
+  /// the route is exhausted. Called by AVehicleAIBatchUpdater, which ticks
+  /// all the AI controllers of the world in a single batch.
+  bool PeekNextTarget(const FVector &CurrentLocation, FVector &OutTarget);
+
   /// @}
 
 private:
@@ -239,5 +262,8 @@ private:
   UPROPERTY()
   ATrafficLightBase *TrafficLight;
 
+  UPROPERTY()
+  ARoutePlanner *CurrentRoutePlanner = nullptr;
+
   std::queue<FVector> TargetLocations;
 };
@@ -7,6 +7,8 @@
 #include "Carla.h"
 #include "Carla/Walker/WalkerController.h"
 
+#include "Carla/Game/CarlaStatics.h"
+
 #include "Components/PoseableMeshComponent.h"
 #include "Components/PrimitiveComponent.h"
 #include "Containers/Map.h"
@@ -142,9 +144,72 @@ void AWalkerController::ControlTickVisitor::operator()(FWalkerBoneControl &Walke
   }
 }
 
+void AWalkerController::UpdateAnimationLOD()
+{
+  auto *Character = GetCharacter();
+  if ((Character == nullptr) || (AnimationFreezeDistance <= 0.0f) || bManualBones)
+  {
+    return;
+  }
+
+  // A walker on the spectator's screen must keep animating even with no
+  // sensor nearby.
+  if (Character->WasRecentlyRendered(0.2f))
+  {
+    FreezeAnimation(false);
+    return;
+  }
+
+  const auto *Episode = UCarlaStatics::GetCurrentEpisode(GetWorld());
+  if (Episode == nullptr)
+  {
+    return;
+  }
+
+  const FVector Location = Character->GetActorLocation();
+  const float RangeSquared = AnimationFreezeDistance * AnimationFreezeDistance;
+  bool bObserved = false;
+  for (const FVector &SensorLocation : Episode->GetSensorLocations())
+  {
+    if (FVector::DistSquared(Location, SensorLocation) < RangeSquared)
+    {
+      bObserved = true;
+      break;
+    }
+  }
+  FreezeAnimation(!bObserved);
+}
+
+void AWalkerController::FreezeAnimation(bool bFreeze)
+{
+  if (bFreeze == bAnimationFrozen)
+  {
+    return;
+  }
+  bAnimationFrozen = bFreeze;
+
+  TArray<USkeletalMeshComponent *> SkeletalMeshes;
+  GetCharacter()->GetComponents<USkeletalMeshComponent>(SkeletalMeshes, false);
+  for (auto *SkeletalMesh : SkeletalMeshes)
+  {
+    SkeletalMesh->bPauseAnims = bFreeze;
+    SkeletalMesh->bNoSkeletonUpdate = bFreeze;
+  }
+}
+
 void AWalkerController::Tick(float DeltaSeconds)
 {
   Super::Tick(DeltaSeconds);
+
+  TimeToNextLODUpdate -= DeltaSeconds;
+  if (TimeToNextLODUpdate <= 0.0f)
+  {
+    UpdateAnimationLOD();
+    // Stagger the checks so the whole crowd does not evaluate in the same
+    // frame.
+    TimeToNextLODUpdate = FMath::FRandRange(0.4f, 0.6f);
+  }
+
   AWalkerController::ControlTickVisitor ControlTickVisitor(this);
   boost::apply_visitor(ControlTickVisitor, Control);
 }
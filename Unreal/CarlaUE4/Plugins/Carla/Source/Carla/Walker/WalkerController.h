@@ -78,7 +78,21 @@ public:
 
 private:
 
+  /// Freeze or resume the skeletal animation of walkers no sensor can see.
+  /// The character keeps moving, only the bones stop updating.
+  void UpdateAnimationLOD();
+
+  void FreezeAnimation(bool bFreeze);
+
   boost::variant<FWalkerControl, FWalkerBoneControl> Control;
 
   bool bManualBones;
+
+  /// Distance in centimetres to the closest sensor beyond which the
+  /// animation is frozen. Zero disables the optimization.
+  float AnimationFreezeDistance = 5000.0f;
+
+  float TimeToNextLODUpdate = 0.0f;
+
+  bool bAnimationFrozen = false;
 };
@@ -7,15 +7,39 @@
 #include "Carla.h"
 #include "Carla/Weather/Weather.h"
 
+/// Interpolate every weather parameter linearly; the sun azimuth takes the
+/// shortest way around the circle.
+static FWeatherParameters LerpWeather(
+    const FWeatherParameters &From,
+    const FWeatherParameters &To,
+    const float Alpha)
+{
+  FWeatherParameters Result;
+  Result.Cloudiness = FMath::Lerp(From.Cloudiness, To.Cloudiness, Alpha);
+  Result.Precipitation = FMath::Lerp(From.Precipitation, To.Precipitation, Alpha);
+  Result.PrecipitationDeposits =
+      FMath::Lerp(From.PrecipitationDeposits, To.PrecipitationDeposits, Alpha);
+  Result.WindIntensity = FMath::Lerp(From.WindIntensity, To.WindIntensity, Alpha);
+  Result.SunAzimuthAngle = From.SunAzimuthAngle +
+      Alpha * FMath::FindDeltaAngleDegrees(From.SunAzimuthAngle, To.SunAzimuthAngle);
+  Result.SunAltitudeAngle = FMath::Lerp(From.SunAltitudeAngle, To.SunAltitudeAngle, Alpha);
+  Result.FogDensity = FMath::Lerp(From.FogDensity, To.FogDensity, Alpha);
+  Result.FogDistance = FMath::Lerp(From.FogDistance, To.FogDistance, Alpha);
+  Result.Wetness = FMath::Lerp(From.Wetness, To.Wetness, Alpha);
+  return Result;
+}
+
 AWeather::AWeather(const FObjectInitializer& ObjectInitializer)
   : Super(ObjectInitializer)
 {
-  PrimaryActorTick.bCanEverTick = false;
+  PrimaryActorTick.bCanEverTick = true;
+  PrimaryActorTick.bStartWithTickEnabled = false;
   RootComponent = ObjectInitializer.CreateDefaultSubobject<USceneComponent>(this, TEXT("RootComponent"));
 }
 
 void AWeather::ApplyWeather(const FWeatherParameters &InWeather)
 {
+  ClearAnimation();
   SetWeather(InWeather);
 
 #ifdef CARLA_WEATHER_EXTRA_LOG
@@ -45,3 +69,67 @@ void AWeather::SetWeather(const FWeatherParameters &InWeather)
 {
   Weather = InWeather;
 }
+
+void AWeather::SetAnimation(TArray<FWeatherKeyFrame> InKeyFrames)
+{
+  if (InKeyFrames.Num() == 0)
+  {
+    ClearAnimation();
+    return;
+  }
+  KeyFrames = MoveTemp(InKeyFrames);
+  KeyFrames.Sort([](const FWeatherKeyFrame &Lhs, const FWeatherKeyFrame &Rhs)
+  {
+    return Lhs.Time < Rhs.Time;
+  });
+  AnimationTime = 0.0f;
+  SetActorTickEnabled(true);
+}
+
+void AWeather::Tick(const float DeltaSeconds)
+{
+  Super::Tick(DeltaSeconds);
+
+  if (KeyFrames.Num() == 0)
+  {
+    return;
+  }
+  AnimationTime += DeltaSeconds;
+
+  if (AnimationTime >= KeyFrames.Last().Time)
+  {
+    // the animation finished, leave the last keyframe applied
+    SetWeather(KeyFrames.Last().Parameters);
+    NotifyWeather();
+    ClearAnimation();
+    return;
+  }
+
+  // find the keyframes bracketing the current time
+  int32 Next = 0;
+  while (KeyFrames[Next].Time <= AnimationTime)
+  {
+    ++Next;
+  }
+  if (Next == 0)
+  {
+    // before the first keyframe: blend from the current weather towards it
+    const float Alpha = (KeyFrames[0].Time > 0.0f) ? DeltaSeconds / KeyFrames[0].Time : 1.0f;
+    SetWeather(LerpWeather(Weather, KeyFrames[0].Parameters, FMath::Min(Alpha, 1.0f)));
+  }
+  else
+  {
+    const auto &From = KeyFrames[Next - 1];
+    const auto &To = KeyFrames[Next];
+    const float Alpha = (AnimationTime - From.Time) / (To.Time - From.Time);
+    SetWeather(LerpWeather(From.Parameters, To.Parameters, Alpha));
+  }
+  NotifyWeather();
+}
+
+void AWeather::ClearAnimation()
+{
+  KeyFrames.Empty();
+  AnimationTime = 0.0f;
+  SetActorTickEnabled(false);
+}
@@ -12,6 +12,15 @@
 
 #include "Weather.generated.h"
 
+/// One keyframe of a weather animation; the time is in seconds of simulated
+/// time relative to the moment the animation was submitted.
+struct FWeatherKeyFrame
+{
+  float Time = 0.0f;
+
+  FWeatherParameters Parameters;
+};
+
 UCLASS(Abstract)
 class CARLA_API AWeather : public AActor
 {
@@ -21,10 +30,19 @@ public:
 
   AWeather(const FObjectInitializer& ObjectInitializer);
 
-  /// Update the weather parameters and notifies it to the blueprint's event
+  /// Update the weather parameters and notifies it to the blueprint's event.
+  /// Cancels a running weather animation.
   UFUNCTION(BlueprintCallable)
   void ApplyWeather(const FWeatherParameters &WeatherParameters);
 
+  /// Start a keyframed weather animation: every frame the weather is
+  /// interpolated between the keyframes and applied, so animating the
+  /// weather does not need a stream of discrete updates. An empty array
+  /// cancels a running animation.
+  void SetAnimation(TArray<FWeatherKeyFrame> InKeyFrames);
+
+  virtual void Tick(float DeltaSeconds) override;
+
   /// Notifing the weather to the blueprint's event
   void NotifyWeather();
 
@@ -46,6 +64,16 @@ protected:
 
 private:
 
+  /// Stop the animation and disable ticking.
+  void ClearAnimation();
+
   UPROPERTY(VisibleAnywhere)
   FWeatherParameters Weather;
+
+  /// Keyframes of the running animation, sorted by time; empty when no
+  /// animation is running.
+  TArray<FWeatherKeyFrame> KeyFrames;
+
+  /// Simulated seconds elapsed since the animation was submitted.
+  float AnimationTime = 0.0f;
 };
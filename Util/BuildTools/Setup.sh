@@ -442,6 +442,9 @@ endif ()
 # add_definitions(-DLIBCARLA_IMAGE_WITH_JPEG_SUPPORT)
 # add_definitions(-DLIBCARLA_IMAGE_WITH_TIFF_SUPPORT)
 
+# Compress sensor streams with zlib when requested (requires zlib installed).
+add_definitions(-DLIBCARLA_STREAMING_WITH_ZLIB_SUPPORT=true)
+
 add_definitions(-DLIBCARLA_TEST_CONTENT_FOLDER="${LIBCARLA_TEST_CONTENT_FOLDER}")
 
 set(BOOST_INCLUDE_PATH "${BOOST_INCLUDE}")